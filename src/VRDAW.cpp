@@ -185,6 +185,7 @@ void VRDAW::applyConfiguration() {
             synthesizer->setVolume(synthConfig.defaultVolume);
             synthesizer->setPan(synthConfig.defaultPan);
             synthesizer->setMaxVoices(synthConfig.maxVoices);
+            synthesizer->setVoiceStealPolicy(synthConfig.voiceStealing);
 
             // Oszillatoren konfigurieren
             for (size_t i = 0; i < synthConfig.oscillators.size(); ++i) {
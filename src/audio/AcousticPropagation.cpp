@@ -0,0 +1,393 @@
+#include "AcousticPropagation.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace VR_DAW {
+
+namespace {
+
+constexpr float kTwoPi = 6.28318531f;
+// Zeitkonstante, mit der Laufzeiten über Blöcke nachgeführt werden. Glättet
+// Tracking-Sprünge, eine gleichmäßige Bewegung behält ihre Steigung und
+// damit die richtige Doppler-Verschiebung
+constexpr float kDelaySmoothing = 0.02f;
+// Größte Laufzeitänderung pro Sample; begrenzt die Tonhöhe auf 0,5..1,5
+constexpr float kMaxDelaySlope = 0.5f;
+// Luftabsorption als Grenzfrequenz über der Entfernung, grob nach ISO 9613
+// bei 20 °C und 50 % Luftfeuchte: 20 kHz nah, ~10 kHz bei 40 m
+constexpr float kAirCutoff = 20000.0f;
+constexpr float kAirDistance = 40.0f;
+constexpr float kMinDistance = 1e-3f;
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// Koeffizient a des Tiefpasses y += (1 - a)(x - y)
+float onePoleCoefficient(float cutoff, float sampleRate) {
+    return std::exp(-kTwoPi * std::min(cutoff, 0.45f * sampleRate) / sampleRate);
+}
+
+// Spiegelbild von p an der Wand bei Koordinate wall
+float mirror(float p, float wall) {
+    return 2.0f * wall - p;
+}
+
+} // namespace
+
+struct AcousticPropagation::Impl {
+    size_t maxSources;
+    float sampleRate;
+    size_t maxFrames;
+    size_t ringLength;
+    size_t ringMask;
+    float maxDelay;
+    size_t writePos = 0;
+    std::vector<float> rings;
+
+    Room room;
+    float wallCoefficient = 0.0f;
+    std::array<float, kNumWalls> wallState{};
+
+    // Zustand je Quelle (SoA). wall*: kNumWalls Werte je Quelle
+    std::vector<float> gain, delay, air, airCoefficient;
+    std::vector<float> wallGain, wallDelay;
+    // Samples, die eine stumme Quelle noch ausklingt; 0 = ruht
+    std::vector<uint32_t> tail;
+    std::vector<uint8_t> primed;
+
+    // Zielwerte des aktuellen Blocks
+    std::vector<float> targetGain, targetDelay, targetWallGain, targetWallDelay;
+
+    Impl(size_t sources, float rate, size_t frames)
+        : maxSources(sources)
+        , sampleRate(rate)
+        , maxFrames(frames)
+        , ringLength(nextPowerOfTwo(static_cast<size_t>(kMaxDelaySeconds * rate) + frames + 2))
+        , ringMask(ringLength - 1)
+        , maxDelay(kMaxDelaySeconds * rate)
+        , rings(sources * ringLength, 0.0f)
+        , gain(sources, 0.0f)
+        , delay(sources, 1.0f)
+        , air(sources, 0.0f)
+        , airCoefficient(sources, 0.0f)
+        , wallGain(sources * kNumWalls, 0.0f)
+        , wallDelay(sources * kNumWalls, 1.0f)
+        , tail(sources, 0)
+        , primed(sources, 0)
+        , targetGain(sources, 0.0f)
+        , targetDelay(sources, 1.0f)
+        , targetWallGain(sources * kNumWalls, 0.0f)
+        , targetWallDelay(sources * kNumWalls, 1.0f)
+    {
+        updateRoom();
+    }
+
+    void updateRoom() {
+        // Wanddämpfung und HF-Anteil ergeben gemeinsam die Grenzfrequenz
+        const float damping = std::clamp(room.damping, 0.0f, 1.0f);
+        const float gainHF = std::clamp(room.gainHF, 0.0f, 1.0f);
+        wallCoefficient = onePoleCoefficient(1000.0f + 15000.0f * (1.0f - damping) * gainHF, sampleRate);
+    }
+
+    bool reflections() const {
+        return room.reflection > 0.0f && room.gain > 0.0f && room.width > 0.0f
+            && room.height > 0.0f && room.depth > 0.0f;
+    }
+
+    // Alle Quellen: Zielwerte des Blocks und Glättung der Laufzeiten
+    void evaluate(const float* const* inputs, const Source* sources, size_t numSources,
+                  float lx, float ly, float lz, size_t numFrames) {
+        const float toSamples = sampleRate / kSpeedOfSound;
+        const float smoothing = 1.0f - std::exp(-static_cast<float>(numFrames) / (kDelaySmoothing * sampleRate));
+        const float maxStep = kMaxDelaySlope * static_cast<float>(numFrames);
+        const bool withReflections = reflections();
+        const float reflectionGain = room.reflection * room.gain;
+        const float halfWidth = 0.5f * room.width, halfDepth = 0.5f * room.depth;
+
+        for (size_t i = 0; i < numSources; ++i) {
+            if (!inputs[i] && tail[i] == 0) continue;
+            const Source& source = sources[i];
+            float* targetWallGains = &targetWallGain[i * kNumWalls];
+            float* targetWallDelays = &targetWallDelay[i * kNumWalls];
+
+            if (!source.spatial) {
+                targetGain[i] = source.gain;
+                targetDelay[i] = 1.0f;
+                airCoefficient[i] = 0.0f;
+                std::fill(targetWallGains, targetWallGains + kNumWalls, 0.0f);
+                std::fill(targetWallDelays, targetWallDelays + kNumWalls, 1.0f);
+                continue;
+            }
+
+            const float dx = source.x - lx, dy = source.y - ly, dz = source.z - lz;
+            const float distance = std::max(std::sqrt(dx * dx + dy * dy + dz * dz), kMinDistance);
+            targetGain[i] = source.gain * distanceGain(source.model, distance, source.minDistance,
+                                                       source.maxDistance, source.rolloff);
+            const float direct = source.doppler ? std::clamp(distance * toSamples, 1.0f, maxDelay) : 1.0f;
+            targetDelay[i] = direct;
+            airCoefficient[i] = onePoleCoefficient(kAirCutoff / (1.0f + distance / kAirDistance), sampleRate);
+
+            if (!withReflections) {
+                std::fill(targetWallGains, targetWallGains + kNumWalls, 0.0f);
+                std::fill(targetWallDelays, targetWallDelays + kNumWalls, direct);
+                continue;
+            }
+            // Spiegelquellen erster Ordnung; Laufzeit relativ zum Direktschall,
+            // damit Reflexionen auch ohne Doppler hinter ihm bleiben
+            const std::array<float, kNumWalls> imageDistance = {
+                std::hypot(mirror(source.x, -halfWidth) - lx, dy, dz),
+                std::hypot(mirror(source.x, halfWidth) - lx, dy, dz),
+                std::hypot(dx, mirror(source.y, 0.0f) - ly, dz),
+                std::hypot(dx, mirror(source.y, room.height) - ly, dz),
+                std::hypot(dx, dy, mirror(source.z, -halfDepth) - lz),
+                std::hypot(dx, dy, mirror(source.z, halfDepth) - lz),
+            };
+            for (size_t w = 0; w < kNumWalls; ++w) {
+                const float image = std::max(imageDistance[w], distance);
+                targetWallGains[w] = source.gain * reflectionGain
+                    * distanceGain(source.model, image, source.minDistance, source.maxDistance, source.rolloff);
+                targetWallDelays[w] = std::clamp(direct + (image - distance) * toSamples, 1.0f, maxDelay);
+            }
+        }
+
+        // Laufzeiten glätten; beim ersten Block einer Quelle direkt setzen
+        for (size_t i = 0; i < numSources; ++i) {
+            if (!inputs[i] && tail[i] == 0) continue;
+            if (!primed[i]) {
+                gain[i] = targetGain[i];
+                delay[i] = targetDelay[i];
+                std::copy_n(&targetWallGain[i * kNumWalls], kNumWalls, &wallGain[i * kNumWalls]);
+                std::copy_n(&targetWallDelay[i * kNumWalls], kNumWalls, &wallDelay[i * kNumWalls]);
+                continue;
+            }
+            targetDelay[i] = delay[i] + std::clamp(smoothing * (targetDelay[i] - delay[i]), -maxStep, maxStep);
+            for (size_t w = i * kNumWalls; w < (i + 1) * kNumWalls; ++w) {
+                targetWallDelay[w] = wallDelay[w]
+                    + std::clamp(smoothing * (targetWallDelay[w] - wallDelay[w]), -maxStep, maxStep);
+            }
+        }
+    }
+
+    // Lesekopf der Verzögerungsleitung in Festkomma (16 Bit Bruchteil),
+    // Laufzeit und Pegel linear über den Block. Die Position läuft modulo
+    // 2^32 mit, ringLength teilt 2^16
+    struct Tap {
+        uint32_t position;
+        uint32_t step;
+        float gain;
+        float gainStep;
+    };
+
+    Tap makeTap(float from, float to, float gainFrom, float gainTo, size_t numFrames) const {
+        const float inverse = 1.0f / static_cast<float>(numFrames);
+        const float delayStep = (to - from) * inverse;
+        // Sample n liest bei writePos + n - (from + delayStep * (n + 1));
+        // Laufzeit >= 1, beide Stützstellen sind also schon geschrieben
+        Tap tap;
+        tap.position = static_cast<uint32_t>((writePos + ringLength) << 16)
+            - static_cast<uint32_t>(std::lround((from + delayStep) * 65536.0f));
+        tap.step = 65536u - static_cast<uint32_t>(static_cast<int32_t>(std::lround(delayStep * 65536.0f)));
+        tap.gain = gainFrom + (gainTo - gainFrom) * inverse;
+        tap.gainStep = (gainTo - gainFrom) * inverse;
+        return tap;
+    }
+
+    float read(const float* ring, Tap& tap) const {
+        const uint32_t index = tap.position >> 16;
+        const float fraction = static_cast<float>(tap.position & 0xffffu) * (1.0f / 65536.0f);
+        const float a = ring[index & ringMask];
+        const float b = ring[(index + 1) & ringMask];
+        const float value = (a + fraction * (b - a)) * tap.gain;
+        tap.position += tap.step;
+        tap.gain += tap.gainStep;
+        return value;
+    }
+
+    void process(const float* const* inputs, size_t numSources, float* const* outputs,
+                 const float** results, float* const* wallOutputs, size_t numFrames) {
+        for (size_t w = 0; w < kNumWalls; ++w) std::fill(wallOutputs[w], wallOutputs[w] + numFrames, 0.0f);
+        const uint32_t drain = static_cast<uint32_t>(ringLength);
+
+        bool anyReflection = false;
+        for (size_t i = 0; i < numSources; ++i) {
+            if (!inputs[i] && tail[i] == 0) {
+                results[i] = nullptr;
+                continue;
+            }
+
+            // Eingang in die Verzögerungsleitung; beim Ausklingen Nullen,
+            // nach ringLength Samples ist die Leitung leer und die Quelle ruht
+            float* ring = &rings[i * ringLength];
+            for (size_t n = 0; n < numFrames; ++n) {
+                ring[(writePos + n) & ringMask] = inputs[i] ? inputs[i][n] : 0.0f;
+            }
+            if (!primed[i]) air[i] = 0.0f;
+
+            // Direktschall mit Luftabsorption
+            float* out = outputs[i];
+            Tap direct = makeTap(delay[i], targetDelay[i], gain[i], targetGain[i], numFrames);
+            const float a = airCoefficient[i];
+            float state = air[i];
+            for (size_t n = 0; n < numFrames; ++n) {
+                state += (1.0f - a) * (read(ring, direct) - state);
+                out[n] = state;
+            }
+            air[i] = state;
+            gain[i] = targetGain[i];
+            delay[i] = targetDelay[i];
+
+            // Reflexionen: ein Lesekopf je Wand
+            const size_t first = i * kNumWalls;
+            bool reflected = false;
+            for (size_t w = first; w < first + kNumWalls; ++w) {
+                reflected = reflected || wallGain[w] != 0.0f || targetWallGain[w] != 0.0f;
+            }
+            if (reflected) {
+                for (size_t w = 0; w < kNumWalls; ++w) {
+                    Tap tap = makeTap(wallDelay[first + w], targetWallDelay[first + w],
+                                      wallGain[first + w], targetWallGain[first + w], numFrames);
+                    float* wallOut = wallOutputs[w];
+                    for (size_t n = 0; n < numFrames; ++n) wallOut[n] += read(ring, tap);
+                }
+                anyReflection = true;
+            }
+            std::copy_n(&targetWallGain[first], kNumWalls, &wallGain[first]);
+            std::copy_n(&targetWallDelay[first], kNumWalls, &wallDelay[first]);
+
+            results[i] = out;
+            primed[i] = 1;
+            if (inputs[i]) {
+                tail[i] = drain;
+            } else {
+                tail[i] = tail[i] > numFrames ? tail[i] - static_cast<uint32_t>(numFrames) : 0;
+                if (tail[i] == 0) primed[i] = 0;
+            }
+        }
+
+        // Wandabsorption einmal je Wand statt je Quelle
+        const float a = wallCoefficient;
+        for (size_t w = 0; w < kNumWalls; ++w) {
+            float state = wallState[w];
+            if (!anyReflection && state == 0.0f) continue;
+            float* out = wallOutputs[w];
+            for (size_t n = 0; n < numFrames; ++n) {
+                state += (1.0f - a) * (out[n] - state);
+                out[n] = state;
+            }
+            // Denormale vermeiden
+            wallState[w] = std::abs(state) < 1e-15f ? 0.0f : state;
+        }
+        writePos = (writePos + numFrames) & ringMask;
+    }
+};
+
+AcousticPropagation::AcousticPropagation(size_t maxSources, float sampleRate, size_t maxFrames) {
+    // Festkomma-Leseköpfe brauchen ringLength <= 2^16 (bis ~400 kHz)
+    if (maxSources == 0 || !(sampleRate > 0.0f) || maxFrames == 0
+        || kMaxDelaySeconds * sampleRate + static_cast<float>(maxFrames) + 2.0f > 65536.0f) {
+        throw std::invalid_argument("AcousticPropagation: ungültige Konfiguration");
+    }
+    pImpl = std::make_unique<Impl>(maxSources, sampleRate, maxFrames);
+}
+
+AcousticPropagation::~AcousticPropagation() = default;
+
+void AcousticPropagation::setRoom(const Room& room) {
+    pImpl->room = room;
+    pImpl->updateRoom();
+}
+
+const AcousticPropagation::Room& AcousticPropagation::getRoom() const {
+    return pImpl->room;
+}
+
+bool AcousticPropagation::hasReflections() const {
+    return pImpl->reflections();
+}
+
+void AcousticPropagation::process(const float* const* inputs, const Source* sources, size_t numSources,
+                                  float listenerX, float listenerY, float listenerZ,
+                                  float* const* outputs, const float** results, float* const* wallOutputs,
+                                  size_t numFrames) {
+    Impl& impl = *pImpl;
+    numSources = std::min(numSources, impl.maxSources);
+    if (numFrames == 0) return;
+    if (numFrames > impl.maxFrames) {
+        throw std::invalid_argument("AcousticPropagation: Block größer als maxFrames");
+    }
+    impl.evaluate(inputs, sources, numSources, listenerX, listenerY, listenerZ, numFrames);
+    impl.process(inputs, numSources, outputs, results, wallOutputs, numFrames);
+}
+
+void AcousticPropagation::getWallDirection(size_t wall, float listenerX, float listenerY, float listenerZ,
+                                           float& x, float& y, float& z) const {
+    const Room& room = pImpl->room;
+    x = y = z = 0.0f;
+    // Lot auf die Wand; steht der Hörer außerhalb, zeigt es von ihr weg
+    switch (wall) {
+    case Left: x = -0.5f * room.width - listenerX; break;
+    case Right: x = 0.5f * room.width - listenerX; break;
+    case Floor: y = -listenerY; break;
+    case Ceiling: y = room.height - listenerY; break;
+    case Front: z = -0.5f * room.depth - listenerZ; break;
+    case Back: z = 0.5f * room.depth - listenerZ; break;
+    default: break;
+    }
+    const float length = std::abs(x) + std::abs(y) + std::abs(z);
+    if (length > 0.0f) {
+        x /= length;
+        y /= length;
+        z /= length;
+    } else {
+        z = -1.0f;
+    }
+}
+
+void AcousticPropagation::resetSource(size_t slot) {
+    Impl& impl = *pImpl;
+    if (slot >= impl.maxSources) return;
+    std::fill_n(&impl.rings[slot * impl.ringLength], impl.ringLength, 0.0f);
+    impl.air[slot] = 0.0f;
+    impl.tail[slot] = 0;
+    impl.primed[slot] = 0;
+}
+
+void AcousticPropagation::reset() {
+    Impl& impl = *pImpl;
+    std::fill(impl.rings.begin(), impl.rings.end(), 0.0f);
+    std::fill(impl.air.begin(), impl.air.end(), 0.0f);
+    std::fill(impl.tail.begin(), impl.tail.end(), 0u);
+    std::fill(impl.primed.begin(), impl.primed.end(), uint8_t(0));
+    impl.wallState.fill(0.0f);
+    impl.writePos = 0;
+}
+
+size_t AcousticPropagation::getMaxSources() const {
+    return pImpl->maxSources;
+}
+
+float AcousticPropagation::distanceGain(DistanceModel model, float distance, float minDistance,
+                                        float maxDistance, float rolloff) {
+    if (model == DistanceModel::None || minDistance <= 0.0f) return 1.0f;
+    maxDistance = std::max(maxDistance, minDistance);
+    const float d = std::clamp(distance, minDistance, maxDistance);
+    switch (model) {
+    case DistanceModel::Inverse:
+        return minDistance / (minDistance + rolloff * (d - minDistance));
+    case DistanceModel::Linear:
+        if (maxDistance <= minDistance) return 1.0f;
+        return std::clamp(1.0f - rolloff * (d - minDistance) / (maxDistance - minDistance), 0.0f, 1.0f);
+    case DistanceModel::Exponential:
+        return std::pow(d / minDistance, -rolloff);
+    default:
+        return 1.0f;
+    }
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace VR_DAW {
+
+// Abstandsmodelle wie OpenAL (geklemmt auf minDistance..maxDistance)
+enum class DistanceModel : uint8_t {
+    Inverse,     // min / (min + rolloff * (d - min))
+    Linear,      // 1 - rolloff * (d - min) / (max - min)
+    Exponential, // (d / min)^-rolloff
+    None
+};
+
+// Schallausbreitung je Quelle vor der Richtungsdarstellung: Abstandspegel,
+// Laufzeit über eine fraktionale Verzögerungsleitung (daraus ergibt sich
+// der Doppler-Effekt), Luftabsorption als Tiefpass erster Ordnung und frühe
+// Reflexionen eines Quaderraums (Spiegelquellen erster Ordnung). Die
+// Reflexionen aller Quellen werden je Wand summiert und als sechs
+// zusätzliche Signale ausgegeben, die an den Wandrichtungen gerendert werden.
+//
+// Die Parameter aller Quellen werden einmal pro Block gemeinsam bestimmt,
+// über Blöcke geglättet und innerhalb des Blocks linear gerampt.
+// Allokationsfrei nach dem Konstruktor.
+class AcousticPropagation {
+public:
+    static constexpr size_t kNumWalls = 6;
+    static constexpr float kSpeedOfSound = 343.0f;
+    // Längste Laufzeit (~51 m); weiter entfernte Quellen werden geklemmt
+    static constexpr float kMaxDelaySeconds = 0.15f;
+
+    struct Source {
+        // Weltposition
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float gain = 1.0f;
+        float minDistance = 1.0f;
+        float maxDistance = 100.0f;
+        float rolloff = 1.0f;
+        DistanceModel model = DistanceModel::Inverse;
+        // false: nur gain, ohne Laufzeit, Filter und Reflexionen
+        bool spatial = true;
+        // false: Direktschall ohne Laufzeit und damit ohne Tonhöhenänderung
+        bool doppler = true;
+    };
+
+    // Achsparalleler Raum, Boden bei y = 0, in x und z um den Ursprung
+    struct Room {
+        float width = 8.0f;
+        float height = 3.0f;
+        float depth = 10.0f;
+        // Amplituden-Reflexionsfaktor der Wände, 0 schaltet Reflexionen ab
+        float reflection = 0.5f;
+        // Höhendämpfung der Wände, 0..1
+        float damping = 0.5f;
+        // Pegel und Höhenanteil des Reflexionsanteils
+        float gain = 0.32f;
+        float gainHF = 0.89f;
+    };
+
+    // Reihenfolge der Wand-Ausgänge
+    enum Wall { Left, Right, Floor, Ceiling, Front, Back };
+
+    AcousticPropagation(size_t maxSources, float sampleRate, size_t maxFrames);
+    ~AcousticPropagation();
+
+    void setRoom(const Room& room);
+    const Room& getRoom() const;
+    bool hasReflections() const;
+
+    // inputs[i] == nullptr: Quelle schweigt, ihre Verzögerungsleitung klingt
+    // noch aus. results[i] zeigt danach auf outputs[i] oder ist nullptr, wenn
+    // die Quelle nichts mehr beiträgt. wallOutputs (kNumWalls Puffer) werden
+    // überschrieben
+    void process(const float* const* inputs, const Source* sources, size_t numSources,
+                 float listenerX, float listenerY, float listenerZ,
+                 float* const* outputs, const float** results, float* const* wallOutputs,
+                 size_t numFrames);
+
+    // Richtung vom Hörer zur Wand (Lot), Weltachsen
+    void getWallDirection(size_t wall, float listenerX, float listenerY, float listenerZ,
+                          float& x, float& y, float& z) const;
+
+    void resetSource(size_t slot);
+    void reset();
+    size_t getMaxSources() const;
+
+    static float distanceGain(DistanceModel model, float distance, float minDistance,
+                              float maxDistance, float rolloff);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
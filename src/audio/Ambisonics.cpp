@@ -0,0 +1,821 @@
+#include "Ambisonics.hpp"
+#include "../dsp/FFT.hpp"
+#include "../dsp/kernels/DSPKernels.hpp"
+#include "../dsp/kernels/Lanes.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// Lanes werden nur zwischen geinlineten Funktionen übergeben
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VRDAW_AMBISONICS_AVX2 1
+#endif
+
+namespace VR_DAW {
+
+namespace {
+
+using dsp::Lanes;
+using dsp::LaneMask;
+using dsp::kLaneWidth;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr float kRadians = 3.14159265f / 180.0f;
+
+constexpr float kSqrt3 = 1.7320508f;
+constexpr float kSqrt15 = 3.8729833f;
+constexpr float kSqrt3_8 = 0.61237244f;
+constexpr float kSqrt5_8 = 0.79056942f;
+
+// Stützrichtungen für die Rotationsmatrizen und die virtuellen
+// Lautsprecher des Binauraldekoders
+constexpr size_t kFitDirections = 64;
+constexpr size_t kVirtualSpeakers = 64;
+constexpr size_t kNormalizationDirections = 512;
+// Blockteilung des Rotators (Kopie der Eingangskanäle)
+constexpr size_t kRotatorChunk = 256;
+
+constexpr size_t kEars = 2;
+
+int checkedOrder(int order) {
+    if (order < 1 || order > ambisonics::kMaxOrder) {
+        throw std::invalid_argument("Ambisonics-Ordnung muss zwischen 1 und 3 liegen");
+    }
+    return order;
+}
+
+// Ordnung l des ACN-Kanals
+int orderOfChannel(size_t channel) {
+    int l = 0;
+    while (static_cast<size_t>((l + 1) * (l + 1)) <= channel) ++l;
+    return l;
+}
+
+// SN3D/ACN in AmbiX-Achsen (X vorne, Y links, Z oben), Richtung normiert.
+// T ist float oder Lanes
+template <typename T>
+VRDAW_LANES_INLINE void sphericalHarmonics(int order, const T& x, const T& y, const T& z, T* out) {
+    out[0] = x * 0.0f + 1.0f;
+    out[1] = y;
+    out[2] = z;
+    out[3] = x;
+    if (order < 2) return;
+
+    const T x2 = x * x, y2 = y * y, z2 = z * z;
+    out[4] = kSqrt3 * x * y;
+    out[5] = kSqrt3 * y * z;
+    out[6] = 0.5f * (3.0f * z2 - 1.0f);
+    out[7] = kSqrt3 * x * z;
+    out[8] = 0.5f * kSqrt3 * (x2 - y2);
+    if (order < 3) return;
+
+    out[9] = kSqrt5_8 * y * (3.0f * x2 - y2);
+    out[10] = kSqrt15 * x * y * z;
+    out[11] = kSqrt3_8 * y * (5.0f * z2 - 1.0f);
+    out[12] = 0.5f * z * (5.0f * z2 - 3.0f);
+    out[13] = kSqrt3_8 * x * (5.0f * z2 - 1.0f);
+    out[14] = 0.5f * kSqrt15 * z * (x2 - y2);
+    out[15] = kSqrt5_8 * x * (x2 - 3.0f * y2);
+}
+
+VRDAW_LANES_INLINE void evaluateBody(int order, const float* x, const float* y, const float* z,
+                                     size_t count, float* const* coefficients) {
+    const size_t channels = ambisonics::channelsForOrder(order);
+    Lanes values[ambisonics::kMaxChannels];
+
+    for (size_t i = 0; i < count; i += kLaneWidth) {
+        const size_t n = std::min(kLaneWidth, count - i);
+        Lanes lx, ly, lz;
+        if (n == kLaneWidth) {
+            lx = dsp::loadLanes(x + i);
+            ly = dsp::loadLanes(y + i);
+            lz = dsp::loadLanes(z + i);
+        } else {
+            lx = dsp::splat(0.0f);
+            ly = dsp::splat(0.0f);
+            lz = dsp::splat(-1.0f);
+            for (size_t k = 0; k < n; ++k) {
+                lx[k] = x[i + k];
+                ly[k] = y[i + k];
+                lz[k] = z[i + k];
+            }
+        }
+
+        // Hörerraum -> AmbiX; Nullvektor zeigt nach vorne
+        const Lanes ax = -lz, ay = -lx, az = ly;
+        const Lanes length2 = ax * ax + ay * ay + az * az;
+        const LaneMask valid = length2 > 1e-12f;
+        const Lanes scale = dsp::fastInverseSqrt(dsp::select(valid, length2, dsp::splat(1.0f)));
+        sphericalHarmonics(order,
+                           dsp::select(valid, ax * scale, dsp::splat(1.0f)),
+                           dsp::select(valid, ay * scale, dsp::splat(0.0f)),
+                           dsp::select(valid, az * scale, dsp::splat(0.0f)),
+                           values);
+
+        for (size_t ch = 0; ch < channels; ++ch) {
+            if (n == kLaneWidth) {
+                dsp::storeLanes(coefficients[ch] + i, values[ch]);
+            } else {
+                for (size_t k = 0; k < n; ++k) coefficients[ch][i + k] = values[ch][k];
+            }
+        }
+    }
+}
+
+// out[o][n] (+)= sum_i (start[o][i] + step[o][i] * (n + 1)) * in[i][n].
+// Ein Kernel für Kodierer (1 Eingang), Rotator und Dekoder
+VRDAW_LANES_INLINE void mixRampedBody(const float* const* in, size_t numIn, float* const* out, size_t numOut,
+                                      const float* start, const float* step, size_t count, bool accumulate) {
+    Lanes ramp;
+    for (size_t k = 0; k < kLaneWidth; ++k) ramp[k] = static_cast<float>(k + 1);
+
+    size_t n = 0;
+    for (; n + kLaneWidth <= count; n += kLaneWidth) {
+        const Lanes position = ramp + static_cast<float>(n);
+        for (size_t o = 0; o < numOut; ++o) {
+            Lanes sum = accumulate ? dsp::loadLanes(out[o] + n) : dsp::splat(0.0f);
+            for (size_t i = 0; i < numIn; ++i) {
+                const Lanes gain = start[o * numIn + i] + step[o * numIn + i] * position;
+                sum += gain * dsp::loadLanes(in[i] + n);
+            }
+            dsp::storeLanes(out[o] + n, sum);
+        }
+    }
+    for (; n < count; ++n) {
+        const float position = static_cast<float>(n + 1);
+        for (size_t o = 0; o < numOut; ++o) {
+            float sum = accumulate ? out[o][n] : 0.0f;
+            for (size_t i = 0; i < numIn; ++i) {
+                sum += (start[o * numIn + i] + step[o * numIn + i] * position) * in[i][n];
+            }
+            out[o][n] = sum;
+        }
+    }
+}
+
+using EvaluateKernel = void (*)(int, const float*, const float*, const float*, size_t, float* const*);
+using MixRampedKernel = void (*)(const float* const*, size_t, float* const*, size_t,
+                                 const float*, const float*, size_t, bool);
+
+void evaluatePortable(int order, const float* x, const float* y, const float* z, size_t count,
+                      float* const* coefficients) {
+    evaluateBody(order, x, y, z, count, coefficients);
+}
+
+void mixRampedPortable(const float* const* in, size_t numIn, float* const* out, size_t numOut,
+                       const float* start, const float* step, size_t count, bool accumulate) {
+    mixRampedBody(in, numIn, out, numOut, start, step, count, accumulate);
+}
+
+#ifdef VRDAW_AMBISONICS_AVX2
+__attribute__((target("avx2,fma")))
+void evaluateAVX2(int order, const float* x, const float* y, const float* z, size_t count,
+                  float* const* coefficients) {
+    evaluateBody(order, x, y, z, count, coefficients);
+}
+
+__attribute__((target("avx2,fma")))
+void mixRampedAVX2(const float* const* in, size_t numIn, float* const* out, size_t numOut,
+                   const float* start, const float* step, size_t count, bool accumulate) {
+    mixRampedBody(in, numIn, out, numOut, start, step, count, accumulate);
+}
+#endif
+
+bool useAVX2() {
+#ifdef VRDAW_AMBISONICS_AVX2
+    return dsp::getKernels().variant >= dsp::KernelVariant::AVX2;
+#else
+    return false;
+#endif
+}
+
+void mixRamped(const float* const* in, size_t numIn, float* const* out, size_t numOut,
+               const float* start, const float* step, size_t count, bool accumulate) {
+#ifdef VRDAW_AMBISONICS_AVX2
+    static const MixRampedKernel kernel = useAVX2() ? mixRampedAVX2 : mixRampedPortable;
+#else
+    static const MixRampedKernel kernel = mixRampedPortable;
+#endif
+    kernel(in, numIn, out, numOut, start, step, count, accumulate);
+}
+
+// Einzelne Richtung (Aufbau, nicht zeitkritisch)
+void evaluateDirection(int order, float x, float y, float z, float* coefficients) {
+    float* columns[ambisonics::kMaxChannels];
+    for (size_t ch = 0; ch < ambisonics::kMaxChannels; ++ch) columns[ch] = coefficients + ch;
+    evaluatePortable(order, &x, &y, &z, 1, columns);
+}
+
+// Annähernd gleichmäßig verteilte Richtungen (Fibonacci-Gitter)
+void fibonacciSphere(size_t count, std::vector<float>& x, std::vector<float>& y, std::vector<float>& z) {
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    const double golden = kPi * (3.0 - std::sqrt(5.0));
+    for (size_t i = 0; i < count; ++i) {
+        const double height = 1.0 - (2.0 * i + 1.0) / static_cast<double>(count);
+        const double radius = std::sqrt(1.0 - height * height);
+        x[i] = static_cast<float>(radius * std::cos(golden * i));
+        y[i] = static_cast<float>(height);
+        z[i] = static_cast<float>(radius * std::sin(golden * i));
+    }
+}
+
+// Gauß-Jordan für die kleinen Normalgleichungen (höchstens 7x7)
+void invert(std::vector<double>& matrix, size_t size) {
+    std::vector<double> inverse(size * size, 0.0);
+    for (size_t i = 0; i < size; ++i) inverse[i * size + i] = 1.0;
+    for (size_t column = 0; column < size; ++column) {
+        size_t pivot = column;
+        for (size_t row = column + 1; row < size; ++row) {
+            if (std::fabs(matrix[row * size + column]) > std::fabs(matrix[pivot * size + column])) pivot = row;
+        }
+        for (size_t k = 0; k < size; ++k) {
+            std::swap(matrix[column * size + k], matrix[pivot * size + k]);
+            std::swap(inverse[column * size + k], inverse[pivot * size + k]);
+        }
+        const double scale = 1.0 / matrix[column * size + column];
+        for (size_t k = 0; k < size; ++k) {
+            matrix[column * size + k] *= scale;
+            inverse[column * size + k] *= scale;
+        }
+        for (size_t row = 0; row < size; ++row) {
+            if (row == column) continue;
+            const double factor = matrix[row * size + column];
+            for (size_t k = 0; k < size; ++k) {
+                matrix[row * size + k] -= factor * matrix[column * size + k];
+                inverse[row * size + k] -= factor * inverse[column * size + k];
+            }
+        }
+    }
+    matrix.swap(inverse);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ambisonics
+
+namespace ambisonics {
+
+void evaluate(int order, const float* x, const float* y, const float* z, size_t count,
+              float* const* coefficients) {
+#ifdef VRDAW_AMBISONICS_AVX2
+    static const EvaluateKernel kernel = useAVX2() ? evaluateAVX2 : evaluatePortable;
+#else
+    static const EvaluateKernel kernel = evaluatePortable;
+#endif
+    kernel(checkedOrder(order), x, y, z, count, coefficients);
+}
+
+float maxReWeight(int order, int l) {
+    // rE ~ cos(137.9° / (N + 1.51)), Gewicht P_l(rE)
+    const double rE = std::cos(2.4068 / (order + 1.51));
+    double previous = 1.0, current = rE;
+    if (l == 0) return 1.0f;
+    for (int k = 1; k < l; ++k) {
+        const double next = ((2.0 * k + 1.0) * rE * current - k * previous) / (k + 1.0);
+        previous = current;
+        current = next;
+    }
+    return static_cast<float>(current);
+}
+
+} // namespace ambisonics
+
+// ---------------------------------------------------------------------------
+// SpeakerLayout
+
+void SpeakerLayout::toVector(const Speaker& speaker, float& x, float& y, float& z) {
+    const float azimuth = speaker.azimuth * kRadians;
+    const float elevation = speaker.elevation * kRadians;
+    x = -std::sin(azimuth) * std::cos(elevation);
+    y = std::sin(elevation);
+    z = -std::cos(azimuth) * std::cos(elevation);
+}
+
+SpeakerLayout SpeakerLayout::stereo() {
+    return {{{30.0f, 0.0f, false}, {-30.0f, 0.0f, false}}};
+}
+
+SpeakerLayout SpeakerLayout::surround51() {
+    return {{{30.0f, 0.0f, false}, {-30.0f, 0.0f, false}, {0.0f, 0.0f, false},
+             {0.0f, 0.0f, true}, {110.0f, 0.0f, false}, {-110.0f, 0.0f, false}}};
+}
+
+SpeakerLayout SpeakerLayout::surround71() {
+    return {{{30.0f, 0.0f, false}, {-30.0f, 0.0f, false}, {0.0f, 0.0f, false},
+             {0.0f, 0.0f, true}, {90.0f, 0.0f, false}, {-90.0f, 0.0f, false},
+             {150.0f, 0.0f, false}, {-150.0f, 0.0f, false}}};
+}
+
+SpeakerLayout SpeakerLayout::surround714() {
+    SpeakerLayout layout = surround71();
+    layout.speakers.push_back({45.0f, 45.0f, false});
+    layout.speakers.push_back({-45.0f, 45.0f, false});
+    layout.speakers.push_back({135.0f, 45.0f, false});
+    layout.speakers.push_back({-135.0f, 45.0f, false});
+    return layout;
+}
+
+SpeakerLayout SpeakerLayout::forChannelCount(int channels) {
+    switch (channels) {
+        case 2: return stereo();
+        case 6: return surround51();
+        case 8: return surround71();
+        case 12: return surround714();
+        default: break;
+    }
+    SpeakerLayout layout;
+    for (int i = 0; i < std::max(channels, 1); ++i) {
+        layout.speakers.push_back({360.0f * i / std::max(channels, 1), 0.0f, false});
+    }
+    return layout;
+}
+
+// ---------------------------------------------------------------------------
+// AmbisonicBus
+
+AmbisonicBus::AmbisonicBus(int order, size_t maxFrames)
+    : order(checkedOrder(order))
+    , numChannels(ambisonics::channelsForOrder(order))
+    , maxFrames(maxFrames)
+    , data(numChannels * maxFrames, 0.0f)
+{
+}
+
+void AmbisonicBus::clear(size_t numFrames) {
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        std::fill(getChannel(ch), getChannel(ch) + std::min(numFrames, maxFrames), 0.0f);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AmbisonicEncoder
+
+struct AmbisonicEncoder::Impl {
+    int order;
+    size_t channels;
+    size_t maxSources;
+    // [Kanal][Slot], aus evaluate()
+    std::vector<float> target;
+    std::vector<float*> targetColumns;
+    // [Slot][Kanal], zuletzt verwendete Koeffizienten inkl. Pegel
+    std::vector<float> previous;
+    std::vector<uint8_t> active;
+    std::vector<float> start;
+    std::vector<float> step;
+    std::vector<int> channelOrder;
+    float* busChannels[ambisonics::kMaxChannels] = {};
+
+    Impl(int order, size_t sources)
+        : order(checkedOrder(order))
+        , channels(ambisonics::channelsForOrder(order))
+        , maxSources(sources)
+        , target(channels * sources, 0.0f)
+        , targetColumns(channels)
+        , previous(sources * channels, 0.0f)
+        , active(sources, 0)
+        , start(channels)
+        , step(channels)
+        , channelOrder(channels)
+    {
+        for (size_t ch = 0; ch < channels; ++ch) {
+            targetColumns[ch] = &target[ch * sources];
+            channelOrder[ch] = orderOfChannel(ch);
+        }
+    }
+};
+
+AmbisonicEncoder::AmbisonicEncoder(int order, size_t maxSources)
+    : pImpl(std::make_unique<Impl>(order, maxSources))
+{
+}
+
+AmbisonicEncoder::~AmbisonicEncoder() = default;
+
+void AmbisonicEncoder::process(const float* const* inputs, const float* x, const float* y, const float* z,
+                               const float* gains, size_t numSources, AmbisonicBus& bus, size_t numFrames,
+                               const float* spreads) {
+    Impl& impl = *pImpl;
+    numSources = std::min(numSources, impl.maxSources);
+    numFrames = std::min(numFrames, bus.getMaxFrames());
+    const size_t channels = std::min(impl.channels, bus.getNumChannels());
+    if (numSources == 0 || numFrames == 0) return;
+
+    // Koeffizienten aller Slots in einem Durchgang, danach je Quelle ein
+    // gerampter Mix in die Bus-Kanäle
+    ambisonics::evaluate(impl.order, x, y, z, numSources, impl.targetColumns.data());
+    for (size_t ch = 0; ch < channels; ++ch) impl.busChannels[ch] = bus.getChannel(ch);
+    const float inverseFrames = 1.0f / static_cast<float>(numFrames);
+
+    for (size_t i = 0; i < numSources; ++i) {
+        if (!inputs[i]) {
+            impl.active[i] = 0;
+            continue;
+        }
+        float* previous = &impl.previous[i * impl.channels];
+        float orderGain[ambisonics::kMaxOrder + 1] = {gains[i], gains[i], gains[i], gains[i]};
+        if (spreads && spreads[i] > 0.0f) {
+            const float focus = 1.0f - std::min(spreads[i], 1.0f);
+            for (int l = 1; l <= impl.order; ++l) orderGain[l] = orderGain[l - 1] * focus;
+        }
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const float value = impl.target[ch * impl.maxSources + i] * orderGain[impl.channelOrder[ch]];
+            if (!impl.active[i]) previous[ch] = value;
+            impl.start[ch] = previous[ch];
+            impl.step[ch] = (value - previous[ch]) * inverseFrames;
+            previous[ch] = value;
+        }
+        impl.active[i] = 1;
+        mixRamped(&inputs[i], 1, impl.busChannels, channels, impl.start.data(), impl.step.data(),
+                  numFrames, true);
+    }
+}
+
+void AmbisonicEncoder::resetSource(size_t slot) {
+    if (slot < pImpl->maxSources) pImpl->active[slot] = 0;
+}
+
+size_t AmbisonicEncoder::getMaxSources() const {
+    return pImpl->maxSources;
+}
+
+// ---------------------------------------------------------------------------
+// AmbisonicRotator
+
+struct AmbisonicRotator::Impl {
+    int order;
+    size_t channels;
+    std::vector<float> fitX, fitY, fitZ;
+    std::vector<float> rotatedX, rotatedY, rotatedZ;
+    // SH der gedrehten Stützrichtungen, [Kanal][Richtung]
+    std::vector<float> rotatedHarmonics;
+    float* rotatedColumns[ambisonics::kMaxChannels] = {};
+    // Je Ordnung l: Pseudoinverse (kFitDirections x (2l+1)) der SH an den
+    // Stützrichtungen
+    std::vector<float> pseudoInverse[ambisonics::kMaxOrder + 1];
+    // Je Ordnung (2l+1)^2 Matrixelemente, hintereinander
+    std::vector<float> current, target, step;
+    bool identity = true;
+    std::vector<float> scratch;
+
+    static size_t blockOffset(int l) {
+        size_t offset = 0;
+        for (int k = 0; k < l; ++k) offset += (2 * k + 1) * (2 * k + 1);
+        return offset;
+    }
+
+    explicit Impl(int order)
+        : order(checkedOrder(order))
+        , channels(ambisonics::channelsForOrder(order))
+        , rotatedX(kFitDirections)
+        , rotatedY(kFitDirections)
+        , rotatedZ(kFitDirections)
+        , rotatedHarmonics(channels * kFitDirections)
+        , scratch((2 * order + 1) * kRotatorChunk)
+    {
+        fibonacciSphere(kFitDirections, fitX, fitY, fitZ);
+        for (size_t ch = 0; ch < channels; ++ch) rotatedColumns[ch] = &rotatedHarmonics[ch * kFitDirections];
+        ambisonics::evaluate(order, fitX.data(), fitY.data(), fitZ.data(), kFitDirections, rotatedColumns);
+
+        for (int l = 0; l <= order; ++l) {
+            const size_t size = 2 * l + 1;
+            const size_t first = l * l;
+            // Normalgleichungen Y Y^T, dann Q = Y^T (Y Y^T)^-1
+            std::vector<double> gram(size * size, 0.0);
+            for (size_t i = 0; i < size; ++i) {
+                for (size_t j = 0; j < size; ++j) {
+                    for (size_t k = 0; k < kFitDirections; ++k) {
+                        gram[i * size + j] += static_cast<double>(rotatedColumns[first + i][k])
+                                            * rotatedColumns[first + j][k];
+                    }
+                }
+            }
+            invert(gram, size);
+            pseudoInverse[l].assign(kFitDirections * size, 0.0f);
+            for (size_t k = 0; k < kFitDirections; ++k) {
+                for (size_t j = 0; j < size; ++j) {
+                    double sum = 0.0;
+                    for (size_t i = 0; i < size; ++i) {
+                        sum += rotatedColumns[first + i][k] * gram[i * size + j];
+                    }
+                    pseudoInverse[l][k * size + j] = static_cast<float>(sum);
+                }
+            }
+        }
+
+        const size_t elements = blockOffset(order + 1);
+        current.assign(elements, 0.0f);
+        for (int l = 0; l <= order; ++l) {
+            const size_t size = 2 * l + 1;
+            for (size_t i = 0; i < size; ++i) current[blockOffset(l) + i * size + i] = 1.0f;
+        }
+        target = current;
+        step.assign(elements, 0.0f);
+    }
+};
+
+AmbisonicRotator::AmbisonicRotator(int order)
+    : pImpl(std::make_unique<Impl>(order))
+{
+}
+
+AmbisonicRotator::~AmbisonicRotator() = default;
+
+void AmbisonicRotator::setRotation(float w, float x, float y, float z) {
+    Impl& impl = *pImpl;
+    const float norm = std::sqrt(w * w + x * x + y * y + z * z);
+    if (norm < 1e-6f) return;
+    w /= norm; x /= norm; y /= norm; z /= norm;
+
+    const float r[3][3] = {
+        {1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y)},
+        {2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x)},
+        {2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)},
+    };
+    for (size_t k = 0; k < kFitDirections; ++k) {
+        const float px = impl.fitX[k], py = impl.fitY[k], pz = impl.fitZ[k];
+        impl.rotatedX[k] = r[0][0] * px + r[0][1] * py + r[0][2] * pz;
+        impl.rotatedY[k] = r[1][0] * px + r[1][1] * py + r[1][2] * pz;
+        impl.rotatedZ[k] = r[2][0] * px + r[2][1] * py + r[2][2] * pz;
+    }
+    ambisonics::evaluate(impl.order, impl.rotatedX.data(), impl.rotatedY.data(), impl.rotatedZ.data(),
+                         kFitDirections, impl.rotatedColumns);
+
+    // M_l = Y_l(R D) * Q_l
+    for (int l = 1; l <= impl.order; ++l) {
+        const size_t size = 2 * l + 1;
+        const size_t first = l * l;
+        float* block = &impl.target[Impl::blockOffset(l)];
+        const std::vector<float>& q = impl.pseudoInverse[l];
+        for (size_t i = 0; i < size; ++i) {
+            const float* row = impl.rotatedColumns[first + i];
+            for (size_t j = 0; j < size; ++j) {
+                float sum = 0.0f;
+                for (size_t k = 0; k < kFitDirections; ++k) sum += row[k] * q[k * size + j];
+                block[i * size + j] = sum;
+            }
+        }
+    }
+}
+
+void AmbisonicRotator::process(AmbisonicBus& bus, size_t numFrames) {
+    Impl& impl = *pImpl;
+    numFrames = std::min(numFrames, bus.getMaxFrames());
+    const bool changing = impl.target != impl.current;
+    if (!changing && impl.identity) return;
+    if (numFrames == 0) return;
+
+    const float inverseFrames = 1.0f / static_cast<float>(numFrames);
+    for (size_t e = 0; e < impl.current.size(); ++e) {
+        impl.step[e] = (impl.target[e] - impl.current[e]) * inverseFrames;
+    }
+
+    const int order = std::min(impl.order, bus.getOrder());
+    float start[7 * 7];
+    const float* inputs[7];
+    float* outputs[7];
+    for (int l = 1; l <= order; ++l) {
+        const size_t size = 2 * l + 1;
+        const size_t first = l * l;
+        const size_t offset = Impl::blockOffset(l);
+        for (size_t done = 0; done < numFrames; done += kRotatorChunk) {
+            const size_t chunk = std::min(kRotatorChunk, numFrames - done);
+            // Eingänge kopieren, die Matrix schreibt in dieselben Kanäle
+            for (size_t i = 0; i < size; ++i) {
+                float* copy = &impl.scratch[i * kRotatorChunk];
+                std::memcpy(copy, bus.getChannel(first + i) + done, chunk * sizeof(float));
+                inputs[i] = copy;
+                outputs[i] = bus.getChannel(first + i) + done;
+            }
+            for (size_t e = 0; e < size * size; ++e) {
+                start[e] = impl.current[offset + e] + impl.step[offset + e] * static_cast<float>(done);
+            }
+            mixRamped(inputs, size, outputs, size, start, &impl.step[offset], chunk, false);
+        }
+    }
+
+    impl.current = impl.target;
+    // Nahe Identität: Matrixmultiplikation sparen
+    float deviation = 0.0f;
+    for (int l = 0; l <= impl.order; ++l) {
+        const size_t size = 2 * l + 1;
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = 0; j < size; ++j) {
+                const float expected = i == j ? 1.0f : 0.0f;
+                deviation = std::max(deviation, std::fabs(impl.current[Impl::blockOffset(l) + i * size + j] - expected));
+            }
+        }
+    }
+    impl.identity = deviation < 1e-6f;
+}
+
+// ---------------------------------------------------------------------------
+// AmbisonicDecoder
+
+AmbisonicDecoder::AmbisonicDecoder(int order, const SpeakerLayout& speakerLayout)
+    : order(checkedOrder(order))
+    , layout(speakerLayout)
+{
+    const size_t channels = ambisonics::channelsForOrder(order);
+    const size_t speakers = layout.speakers.size();
+    const size_t fullRange = static_cast<size_t>(std::count_if(layout.speakers.begin(), layout.speakers.end(),
+        [](const SpeakerLayout::Speaker& speaker) { return !speaker.lfe; }));
+    matrix.assign(speakers * channels, 0.0f);
+    if (fullRange == 0) return;
+
+    // Projektion: (2l+1) g_l Y(Lautsprecher) / L
+    float harmonics[ambisonics::kMaxChannels];
+    for (size_t s = 0; s < speakers; ++s) {
+        const auto& speaker = layout.speakers[s];
+        if (speaker.lfe) continue;
+        float x, y, z;
+        SpeakerLayout::toVector(speaker, x, y, z);
+        evaluateDirection(order, x, y, z, harmonics);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const int l = orderOfChannel(ch);
+            matrix[s * channels + ch] = (2 * l + 1) * ambisonics::maxReWeight(order, l) * harmonics[ch]
+                                      / static_cast<float>(fullRange);
+        }
+    }
+
+    // Mittlere Energie über alle Richtungen auf 1 normieren
+    std::vector<float> px, py, pz;
+    fibonacciSphere(kNormalizationDirections, px, py, pz);
+    double energy = 0.0;
+    for (size_t k = 0; k < kNormalizationDirections; ++k) {
+        evaluateDirection(order, px[k], py[k], pz[k], harmonics);
+        for (size_t s = 0; s < speakers; ++s) {
+            double gain = 0.0;
+            for (size_t ch = 0; ch < channels; ++ch) gain += matrix[s * channels + ch] * harmonics[ch];
+            energy += gain * gain;
+        }
+    }
+    const float scale = static_cast<float>(1.0 / std::sqrt(energy / kNormalizationDirections));
+    for (float& value : matrix) value *= scale;
+}
+
+void AmbisonicDecoder::process(const AmbisonicBus& bus, float* const* outputs, size_t numFrames) const {
+    static const float kZeroStep[32 * ambisonics::kMaxChannels] = {};
+    const size_t channels = ambisonics::channelsForOrder(order);
+    const size_t inputs = std::min(channels, bus.getNumChannels());
+    numFrames = std::min(numFrames, bus.getMaxFrames());
+
+    const float* busChannels[ambisonics::kMaxChannels];
+    for (size_t ch = 0; ch < inputs; ++ch) busChannels[ch] = bus.getChannel(ch);
+
+    // Zeilenweise, damit beliebig viele Lautsprecher ohne Puffer gehen
+    for (size_t s = 0; s < layout.speakers.size(); ++s) {
+        float* output = outputs[s];
+        mixRamped(busChannels, inputs, &output, 1, &matrix[s * channels], kZeroStep, numFrames, false);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AmbisonicBinauralDecoder
+
+struct AmbisonicBinauralDecoder::Impl {
+    std::shared_ptr<const HRTFSet> hrtf;
+    size_t channels;
+    size_t blockSize;
+    size_t numBins;
+    dsp::RealFFT fft;
+    // [Kanal][Ohr][Bin], mit 1/FFT-Größe skaliert
+    std::vector<float> filterRe, filterIm;
+    // [Kanal][2 * blockSize]
+    std::vector<float> frames;
+    size_t fifoPosition = 0;
+    std::vector<float> sourceRe, sourceIm;
+    std::vector<float> accRe[kEars], accIm[kEars];
+    std::vector<float> time;
+    std::vector<float> output[kEars];
+
+    Impl(int order, std::shared_ptr<const HRTFSet> set)
+        : hrtf(std::move(set))
+        , channels(ambisonics::channelsForOrder(checkedOrder(order)))
+        , blockSize(hrtf->getBlockSize())
+        , numBins(hrtf->getNumBins())
+        , fft(blockSize * 2)
+        , filterRe(channels * kEars * numBins, 0.0f)
+        , filterIm(filterRe.size(), 0.0f)
+        , frames(channels * blockSize * 2, 0.0f)
+        , sourceRe(numBins)
+        , sourceIm(numBins)
+        , time(blockSize * 2)
+    {
+        for (size_t ear = 0; ear < kEars; ++ear) {
+            accRe[ear].assign(numBins, 0.0f);
+            accIm[ear].assign(numBins, 0.0f);
+            output[ear].assign(blockSize, 0.0f);
+        }
+
+        // Virtuelle Lautsprecher: Projektionsdekoder mit max-rE, dann je
+        // Kanal die gewichtete Summe ihrer HRIRs. Die Summe über alle
+        // Lautsprecher ergibt für W gerade 1 (Pegel wie eine Direktquelle)
+        std::vector<float> vx, vy, vz;
+        fibonacciSphere(kVirtualSpeakers, vx, vy, vz);
+        const size_t length = hrtf->getFilterLength();
+        std::vector<float> filters(channels * kEars * length, 0.0f);
+        float harmonics[ambisonics::kMaxChannels];
+        for (size_t k = 0; k < kVirtualSpeakers; ++k) {
+            evaluateDirection(order, vx[k], vy[k], vz[k], harmonics);
+            const size_t direction = hrtf->findNearest(vx[k], vy[k], vz[k]);
+            for (size_t ch = 0; ch < channels; ++ch) {
+                const int l = orderOfChannel(ch);
+                const float weight = (2 * l + 1) * ambisonics::maxReWeight(order, l) * harmonics[ch]
+                                   / static_cast<float>(kVirtualSpeakers);
+                for (size_t ear = 0; ear < kEars; ++ear) {
+                    const std::vector<float>& response = hrtf->getImpulseResponse(direction, ear);
+                    float* filter = &filters[(ch * kEars + ear) * length];
+                    for (size_t i = 0; i < length; ++i) filter[i] += weight * response[i];
+                }
+            }
+        }
+
+        std::vector<float> frame(blockSize * 2);
+        const float scale = 1.0f / static_cast<float>(blockSize * 2);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            for (size_t ear = 0; ear < kEars; ++ear) {
+                std::fill(frame.begin(), frame.end(), 0.0f);
+                const float* filter = &filters[(ch * kEars + ear) * length];
+                for (size_t i = 0; i < length; ++i) frame[i] = filter[i] * scale;
+                fft.forward(frame.data(), &filterRe[(ch * kEars + ear) * numBins],
+                            &filterIm[(ch * kEars + ear) * numBins]);
+            }
+        }
+    }
+
+    float* frame(size_t channel) { return &frames[channel * blockSize * 2]; }
+
+    void step() {
+        for (size_t ear = 0; ear < kEars; ++ear) {
+            std::fill(accRe[ear].begin(), accRe[ear].end(), 0.0f);
+            std::fill(accIm[ear].begin(), accIm[ear].end(), 0.0f);
+        }
+        for (size_t ch = 0; ch < channels; ++ch) {
+            float* data = frame(ch);
+            fft.forward(data, sourceRe.data(), sourceIm.data());
+            std::memcpy(data, data + blockSize, blockSize * sizeof(float));
+            for (size_t ear = 0; ear < kEars; ++ear) {
+                dsp::complexMultiplyAccumulate(accRe[ear].data(), accIm[ear].data(),
+                    sourceRe.data(), sourceIm.data(),
+                    &filterRe[(ch * kEars + ear) * numBins], &filterIm[(ch * kEars + ear) * numBins],
+                    numBins);
+            }
+        }
+        for (size_t ear = 0; ear < kEars; ++ear) {
+            fft.inverse(accRe[ear].data(), accIm[ear].data(), time.data());
+            std::memcpy(output[ear].data(), time.data() + blockSize, blockSize * sizeof(float));
+        }
+    }
+};
+
+AmbisonicBinauralDecoder::AmbisonicBinauralDecoder(int order, std::shared_ptr<const HRTFSet> hrtf)
+    : pImpl(std::make_unique<Impl>(order, std::move(hrtf)))
+{
+}
+
+AmbisonicBinauralDecoder::~AmbisonicBinauralDecoder() = default;
+
+void AmbisonicBinauralDecoder::process(const AmbisonicBus& bus, float* left, float* right, size_t numFrames) {
+    Impl& impl = *pImpl;
+    const size_t channels = std::min(impl.channels, bus.getNumChannels());
+    numFrames = std::min(numFrames, bus.getMaxFrames());
+
+    size_t done = 0;
+    while (done < numFrames) {
+        const size_t chunk = std::min(numFrames - done, impl.blockSize - impl.fifoPosition);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            std::memcpy(impl.frame(ch) + impl.blockSize + impl.fifoPosition, bus.getChannel(ch) + done,
+                        chunk * sizeof(float));
+        }
+        std::memcpy(left + done, impl.output[0].data() + impl.fifoPosition, chunk * sizeof(float));
+        std::memcpy(right + done, impl.output[1].data() + impl.fifoPosition, chunk * sizeof(float));
+        impl.fifoPosition += chunk;
+        done += chunk;
+
+        if (impl.fifoPosition == impl.blockSize) {
+            impl.step();
+            impl.fifoPosition = 0;
+        }
+    }
+}
+
+void AmbisonicBinauralDecoder::reset() {
+    Impl& impl = *pImpl;
+    std::fill(impl.frames.begin(), impl.frames.end(), 0.0f);
+    for (auto& output : impl.output) std::fill(output.begin(), output.end(), 0.0f);
+    impl.fifoPosition = 0;
+}
+
+size_t AmbisonicBinauralDecoder::getLatency() const {
+    return pImpl->blockSize;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "HRTFSet.hpp"
+
+namespace VR_DAW {
+
+// Ambisonics bis 3. Ordnung als Zwischenformat für räumliches Audio:
+// jedes Objekt wird einmal in den Bus kodiert, Kopfdrehung ist eine
+// Rotationsmatrix auf dem Bus, und genau ein Dekoder erzeugt Binaural oder
+// Lautsprechersignale. Der Aufwand je Objekt hängt damit nicht mehr vom
+// Ausgabeformat ab.
+//
+// Kanalreihenfolge ACN, Normierung SN3D (AmbiX). Richtungen werden wie
+// überall im Audio-Code im Hörerraum übergeben: +x rechts, +y oben, -z vorne.
+namespace ambisonics {
+
+constexpr int kMaxOrder = 3;
+constexpr size_t kMaxChannels = 16;
+
+constexpr size_t channelsForOrder(int order) {
+    return static_cast<size_t>((order + 1) * (order + 1));
+}
+
+// Kugelflächenfunktionen für count Richtungen (SoA, nicht normiert) in
+// coefficients[Kanal][Richtung]. Vektorisiert über die Richtungen
+void evaluate(int order, const float* x, const float* y, const float* z, size_t count,
+              float* const* coefficients);
+
+// max-rE-Gewicht je Ordnung l (Legendre-Polynom am größten rE)
+float maxReWeight(int order, int l);
+
+} // namespace ambisonics
+
+// Lautsprecheraufstellung; Azimut/Elevation in Grad wie HRTFSet
+// (Azimut 0 vorne, 90 links). LFE-Kanäle bekommen vom Dekoder nichts
+struct SpeakerLayout {
+    struct Speaker {
+        float azimuth = 0.0f;
+        float elevation = 0.0f;
+        bool lfe = false;
+    };
+    std::vector<Speaker> speakers;
+
+    // Einheitsvektor im Hörerraum zur Lautsprecherrichtung
+    static void toVector(const Speaker& speaker, float& x, float& y, float& z);
+
+    static SpeakerLayout stereo();
+    static SpeakerLayout surround51();
+    static SpeakerLayout surround71();
+    // L R C LFE Ls Rs Lrs Rrs Ltf Rtf Ltr Rtr
+    static SpeakerLayout surround714();
+    // Vorgabe zur Kanalzahl (2, 6, 8, 12), sonst gleichmäßig in der Ebene
+    static SpeakerLayout forChannelCount(int channels);
+};
+
+// Mehrkanal-Puffer des Busses, [Kanal][Sample], für höchstens maxFrames
+class AmbisonicBus {
+public:
+    AmbisonicBus(int order, size_t maxFrames);
+
+    int getOrder() const { return order; }
+    size_t getNumChannels() const { return numChannels; }
+    size_t getMaxFrames() const { return maxFrames; }
+
+    float* getChannel(size_t channel) { return &data[channel * maxFrames]; }
+    const float* getChannel(size_t channel) const { return &data[channel * maxFrames]; }
+    void clear(size_t numFrames);
+
+private:
+    int order;
+    size_t numChannels;
+    size_t maxFrames;
+    std::vector<float> data;
+};
+
+// Kodiert viele Mono-Quellen in den Bus (addierend). Die Koeffizienten je
+// Slot werden über den Block vom vorigen zum neuen Wert gerampt, damit
+// bewegte Objekte nicht knacken. Allokationsfrei nach dem Konstruktor
+class AmbisonicEncoder {
+public:
+    AmbisonicEncoder(int order, size_t maxSources);
+    ~AmbisonicEncoder();
+
+    // inputs[i] == nullptr: Slot stumm, nächster Einsatz ohne Rampe.
+    // x/y/z/gains: eine Richtung und ein Pegel je Slot. spreads (optional,
+    // 0..1) dämpft die höheren Ordnungen mit (1 - spread)^l; bei 1 bleibt
+    // nur W, die Quelle ist dann ungerichtet
+    void process(const float* const* inputs, const float* x, const float* y, const float* z,
+                 const float* gains, size_t numSources, AmbisonicBus& bus, size_t numFrames,
+                 const float* spreads = nullptr);
+
+    void resetSource(size_t slot);
+    size_t getMaxSources() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+// Dreht das Schallfeld auf dem Bus. Die Matrix wird je Ordnung einmal pro
+// Änderung bestimmt (Ausgleichsrechnung über feste Stützrichtungen, damit
+// sie exakt zur eigenen SH-Konvention passt) und über den Block
+// interpoliert
+class AmbisonicRotator {
+public:
+    explicit AmbisonicRotator(int order);
+    ~AmbisonicRotator();
+
+    // Drehung als Einheitsquaternion im Hörerraum. Für Head-Tracking die
+    // Inverse der Kopforientierung übergeben
+    void setRotation(float w, float x, float y, float z);
+    void process(AmbisonicBus& bus, size_t numFrames);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+// Projektionsdekoder mit max-rE-Gewichten, auf gleiche mittlere Energie
+// normiert. Ohne Latenz; überschreibt die Ausgänge
+class AmbisonicDecoder {
+public:
+    AmbisonicDecoder(int order, const SpeakerLayout& layout);
+
+    size_t getNumOutputs() const { return layout.speakers.size(); }
+    const SpeakerLayout& getLayout() const { return layout; }
+    void process(const AmbisonicBus& bus, float* const* outputs, size_t numFrames) const;
+
+private:
+    int order;
+    SpeakerLayout layout;
+    // [Lautsprecher][Kanal]
+    std::vector<float> matrix;
+};
+
+// Binauraler Dekoder über virtuelle Lautsprecher: deren HRIRs werden beim
+// Aufbau je Bus-Kanal zu einem Filterpaar zusammengefasst. Pro Block fallen
+// eine FFT je Kanal und eine inverse FFT je Ohr an, unabhängig von der
+// Objektzahl. Latenz: Blockgröße des HRTF-Satzes
+class AmbisonicBinauralDecoder {
+public:
+    AmbisonicBinauralDecoder(int order, std::shared_ptr<const HRTFSet> hrtf);
+    ~AmbisonicBinauralDecoder();
+
+    void process(const AmbisonicBus& bus, float* left, float* right, size_t numFrames);
+    void reset();
+    size_t getLatency() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
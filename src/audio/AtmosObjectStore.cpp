@@ -0,0 +1,133 @@
+#include "AtmosObjectStore.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace VR_DAW {
+
+namespace {
+
+AtmosObjectStore::Snapshot makeSnapshot(size_t capacity) {
+    AtmosObjectStore::Snapshot snapshot;
+    snapshot.generation.assign(capacity, 0);
+    snapshot.active.assign(capacity, 0);
+    snapshot.x.assign(capacity, 0.0f);
+    snapshot.y.assign(capacity, 0.0f);
+    snapshot.z.assign(capacity, -1.0f);
+    snapshot.gain.assign(capacity, 1.0f);
+    snapshot.spread.assign(capacity, 0.0f);
+    return snapshot;
+}
+
+} // namespace
+
+AtmosObjectStore::AtmosObjectStore(size_t capacity, size_t frames)
+    : maxFrames(frames)
+    , working(makeSnapshot(capacity))
+    , published(working)
+    , names(capacity)
+    , metadata(capacity)
+    , arena(capacity * frames, 0.0f)
+{
+    if (capacity == 0 || capacity > 0x10000) {
+        throw std::invalid_argument("AtmosObjectStore: Kapazität muss zwischen 1 und 65536 liegen");
+    }
+    // Niedrigste Slots zuerst vergeben
+    freeSlots.reserve(capacity);
+    for (size_t slot = capacity; slot-- > 0;) freeSlots.push_back(static_cast<uint32_t>(slot));
+}
+
+AtmosObjectStore::Handle AtmosObjectStore::create(const std::string& name, const std::string& data) {
+    if (freeSlots.empty()) return kInvalidHandle;
+    if (!name.empty() && handleOfName.count(name)) return kInvalidHandle;
+
+    const size_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    working.active[slot] = 1;
+    working.x[slot] = 0.0f;
+    working.y[slot] = 0.0f;
+    working.z[slot] = -1.0f;
+    working.gain[slot] = 1.0f;
+    working.spread[slot] = 0.0f;
+    working.slotCount = std::max(working.slotCount, slot + 1);
+    names[slot] = name;
+    metadata[slot] = data;
+    ++count;
+
+    const Handle handle = getHandle(slot);
+    if (!name.empty()) handleOfName[name] = handle;
+    return handle;
+}
+
+bool AtmosObjectStore::destroy(Handle handle) {
+    size_t slot;
+    if (!resolve(handle, slot)) return false;
+
+    // Neue Generation: alte Handles werden ungültig, der Audio-Thread
+    // erkennt die Neubelegung des Slots
+    working.active[slot] = 0;
+    ++working.generation[slot];
+    if (!names[slot].empty()) handleOfName.erase(names[slot]);
+    names[slot].clear();
+    metadata[slot].clear();
+    freeSlots.push_back(static_cast<uint32_t>(slot));
+    --count;
+    while (working.slotCount > 0 && !working.active[working.slotCount - 1]) --working.slotCount;
+    return true;
+}
+
+void AtmosObjectStore::clear() {
+    for (size_t slot = 0; slot < working.slotCount; ++slot) {
+        if (working.active[slot]) destroy(getHandle(slot));
+    }
+}
+
+bool AtmosObjectStore::isValid(Handle handle) const {
+    size_t slot;
+    return resolve(handle, slot);
+}
+
+AtmosObjectStore::Handle AtmosObjectStore::find(const std::string& name) const {
+    auto it = handleOfName.find(name);
+    return it != handleOfName.end() ? it->second : kInvalidHandle;
+}
+
+void AtmosObjectStore::setPosition(Handle handle, float x, float y, float z) {
+    size_t slot;
+    if (!resolve(handle, slot)) return;
+    working.x[slot] = x;
+    working.y[slot] = y;
+    working.z[slot] = z;
+}
+
+void AtmosObjectStore::setGain(Handle handle, float gain) {
+    size_t slot;
+    if (resolve(handle, slot)) working.gain[slot] = gain;
+}
+
+void AtmosObjectStore::setSpread(Handle handle, float spread) {
+    size_t slot;
+    if (resolve(handle, slot)) working.spread[slot] = std::clamp(spread, 0.0f, 1.0f);
+}
+
+void AtmosObjectStore::commit() {
+    // Gleich große Vektoren: Zuweisung kopiert nur, ohne Allokation
+    published.write() = working;
+    published.publish();
+}
+
+AtmosObjectStore::Handle AtmosObjectStore::getHandle(size_t slot) const {
+    return (static_cast<Handle>(working.generation[slot]) << 16) | static_cast<Handle>(slot);
+}
+
+void AtmosObjectStore::setMaxFrames(size_t frames) {
+    maxFrames = frames;
+    arena.assign(capacity() * frames, 0.0f);
+}
+
+bool AtmosObjectStore::resolve(Handle handle, size_t& slot) const {
+    slot = slotOf(handle);
+    return handle != kInvalidHandle && slot < capacity() && working.active[slot]
+        && working.generation[slot] == generationOf(handle);
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TripleBuffer.hpp"
+
+namespace VR_DAW {
+
+// Objektspeicher für Atmos-Objekte mit festen Slots. Ein Handle ist
+// Slot-Index plus Generation, freie Slots werden wiederverwendet, so bleiben
+// die Indizes dicht und veraltete Handles fallen auf. Heiße Daten (Position,
+// Pegel, Spread) liegen als SoA-Arrays je Slot, Name und Metadaten getrennt
+// davon; Objekt-Audio in einer einzigen Arena mit maxFrames Samples je Slot.
+//
+// Schreibseite (ein Thread, UI/Steuerung) ändert eine Arbeitskopie und
+// veröffentlicht sie mit commit() über einen Dreifachpuffer. Der
+// Audio-Thread liest mit acquire() ohne Lock und ohne Allokation.
+class AtmosObjectStore {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle kInvalidHandle = 0xffffffffu;
+
+    // Veröffentlichter Stand, Arrays je Slot bis slotCount
+    struct Snapshot {
+        size_t slotCount = 0;
+        std::vector<uint16_t> generation;
+        std::vector<uint8_t> active;
+        std::vector<float> x, y, z;
+        std::vector<float> gain;
+        std::vector<float> spread;
+    };
+
+    AtmosObjectStore(size_t capacity, size_t maxFrames);
+
+    size_t capacity() const { return names.size(); }
+    size_t size() const { return count; }
+
+    static size_t slotOf(Handle handle) { return handle & 0xffffu; }
+    static uint16_t generationOf(Handle handle) { return static_cast<uint16_t>(handle >> 16); }
+
+    // Schreibseite. create() liefert kInvalidHandle, wenn alle Slots belegt sind
+    Handle create(const std::string& name, const std::string& metadata = std::string());
+    bool destroy(Handle handle);
+    void clear();
+    bool isValid(Handle handle) const;
+    Handle find(const std::string& name) const;
+
+    void setPosition(Handle handle, float x, float y, float z);
+    void setGain(Handle handle, float gain);
+    // 0 = Punktquelle, 1 = ungerichtet
+    void setSpread(Handle handle, float spread);
+    void commit();
+
+    // Lesender Zugriff der Schreibseite (Arbeitskopie), je Slot
+    const Snapshot& getWorking() const { return working; }
+    Handle getHandle(size_t slot) const;
+    const std::string& getName(size_t slot) const { return names[slot]; }
+    const std::string& getMetadata(size_t slot) const { return metadata[slot]; }
+
+    // Audio-Thread
+    const Snapshot& acquire() { return published.read(); }
+    float* getAudio(size_t slot) { return &arena[slot * maxFrames]; }
+    const float* getAudio(size_t slot) const { return &arena[slot * maxFrames]; }
+    size_t getMaxFrames() const { return maxFrames; }
+
+    // Arena neu anlegen; nur wenn der Audio-Thread nicht läuft
+    void setMaxFrames(size_t frames);
+
+private:
+    size_t count = 0;
+    size_t maxFrames;
+    Snapshot working;
+    TripleBuffer<Snapshot> published;
+    std::vector<uint32_t> freeSlots;
+    std::vector<std::string> names;
+    std::vector<std::string> metadata;
+    std::unordered_map<std::string, Handle> handleOfName;
+    std::vector<float> arena;
+
+    bool resolve(Handle handle, size_t& slot) const;
+};
+
+} // namespace VR_DAW
@@ -1,15 +1,73 @@
 #include "AudioEngine.hpp"
+#include "RenderSnapshot.hpp"
+#include "AudioWorkerPool.hpp"
+#include "RealtimeGuard.hpp"
+#include "SubtractiveSynthesizer.hpp"
+#include "../dsp/kernels/DSPKernels.hpp"
 #include "../utils/Logger.hpp"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
-#include <immintrin.h> // Für SIMD-Instruktionen
 #include <thread>
 #include <chrono>
 #include <mutex>
 
 namespace VR_DAW {
 
+namespace {
+
+// Klang-Parameter übernehmen; Strings werden hier einmal zu Enums aufgelöst.
+// Nur auf Instanzen, die noch in keinem Render-Snapshot stehen
+void configureSynthesizer(SubtractiveSynthesizer* synth, const SynthesizerConfig& config) {
+    synth->setVoiceStealPolicy(config.voiceStealing);
+    synth->setVolume(config.defaultVolume);
+    synth->setPan(config.defaultPan);
+
+    if (!config.oscillators.empty()) {
+        const auto& osc = config.oscillators.front();
+        synth->setOscillatorType(osc.type);
+        synth->setOscillatorMix(osc.mix);
+        synth->setOscillatorDetune(osc.detune);
+        synth->setOscillatorPhase(osc.phase);
+    }
+
+    synth->setFilterType(config.filter.type);
+    synth->setFilterCutoff(config.filter.cutoff);
+    synth->setFilterResonance(config.filter.resonance);
+    synth->setFilterDrive(config.filter.drive);
+    synth->setFilterEnvelopeAmount(config.filter.envelopeAmount);
+    synth->setFilterEnvelopeAttack(config.filter.envelopeAttack);
+    synth->setFilterEnvelopeDecay(config.filter.envelopeDecay);
+
+    if (!config.lfos.empty()) {
+        const auto& lfo = config.lfos.front();
+        synth->setLFOWaveform(lfo.waveform);
+        synth->setLFORate(lfo.rate);
+        synth->setLFODepth(lfo.depth);
+        synth->setLFODestination(lfo.destination);
+    }
+
+    Synthesizer::Envelope envelope;
+    envelope.attack = config.amplitudeEnvelope.attack;
+    envelope.decay = config.amplitudeEnvelope.decay;
+    envelope.sustain = config.amplitudeEnvelope.sustain;
+    envelope.release = config.amplitudeEnvelope.release;
+    synth->setEnvelope(envelope);
+}
+
+// Polyphonie alloziert, daher vollständig im Kontroll-Thread, bevor die
+// Instanz über den Render-Snapshot sichtbar wird
+std::shared_ptr<SubtractiveSynthesizer> makeSynthesizer(const SynthesizerConfig& config, int sampleRate) {
+    auto synth = std::make_shared<SubtractiveSynthesizer>();
+    synth->setMaxVoices(static_cast<size_t>(std::max(1, config.maxVoices)));
+    synth->setSampleRate(static_cast<float>(sampleRate));
+    configureSynthesizer(synth.get(), config);
+    return synth;
+}
+
+} // namespace
+
 struct AudioEngine::Impl {
     std::vector<AudioTrack> tracks;
     std::vector<AudioPlugin> plugins;
@@ -21,9 +79,37 @@ struct AudioEngine::Impl {
     int sampleRate;
     int bufferSize;
     std::map<int, SynthesizerConfig> synthesizers;
+    std::map<int, std::shared_ptr<Synthesizer>> synthesizerInstances;
     AudioCallback audioCallback;
     bool initialized;
     std::mutex mutex;
+
+    // Render-Pfad: der Audio-Thread liest nur noch Snapshots
+    RenderSnapshotManager snapshots;
+
+    // Persistente Worker statt std::thread pro Buffer
+    AudioWorkerPool workerPool;
+    AudioTaskGraph chunkGraph;
+
+    // JACK: Ports werden einmalig registriert; pro Zyklus werden nur die
+    // jack_port_get_buffer-Zeiger in die vorallozierten Arrays geschrieben
+    int jackInputChannels = 2;
+    int jackOutputChannels = 2;
+    std::vector<jack_port_t*> jackInputPorts;
+    std::vector<jack_port_t*> jackOutputPorts;
+    std::vector<const float*> jackInputBuffers;
+    std::vector<float*> jackOutputBuffers;
+
+    // Xruns aus JACK bzw. PortAudio-Statusflags
+    std::atomic<uint64_t> xrunCount{0};
+
+    // MIDI: Ringe der MIDIEngine (Kontroll-Thread) und die sortierten
+    // Events des laufenden Callbacks (nur Audio-Thread)
+    std::vector<std::shared_ptr<MIDIEventQueue>> midiQueues;
+    MIDIBlockEvents midiEvents;
+
+    // Plugin-Parameter vom Kontroll-Thread (unter mutex) an den Audio-Thread
+    ParameterChangeQueue parameterChanges{1024};
 };
 
 AudioEngine& AudioEngine::getInstance() {
@@ -46,6 +132,8 @@ AudioEngine::AudioEngine()
     , processingMode(ProcessingMode::MultiThreaded)
     , shouldProcess(false)
 {
+    // SIMD-Variante einmalig per CPUID wählen, nicht im ersten Callback
+    dsp::initializeKernels();
 }
 
 AudioEngine::~AudioEngine() {
@@ -68,6 +156,9 @@ void AudioEngine::initialize() {
         if (!startAudioThread()) {
             throw AudioError("Fehler beim Starten des Audio-Threads");
         }
+
+        // Worker-Pool für die Track-Verarbeitung starten
+        initializeThreadPool();
         
         initialized = true;
     } catch (const AudioError& e) {
@@ -82,7 +173,9 @@ void AudioEngine::shutdown() {
     
     std::lock_guard<std::mutex> lock(pImpl->mutex);
     pImpl->synthesizers.clear();
+    pImpl->synthesizerInstances.clear();
     pImpl->initialized = false;
+    shutdownThreadPool();
     Logger::getInstance().log(LogLevel::Info, "AudioEngine heruntergefahren");
 
     if (stream) {
@@ -92,8 +185,11 @@ void AudioEngine::shutdown() {
     }
 
     if (jackClient) {
+        jack_deactivate(jackClient);
         jack_client_close(jackClient);
         jackClient = nullptr;
+        pImpl->jackInputPorts.clear();
+        pImpl->jackOutputPorts.clear();
     }
 
     Pa_Terminate();
@@ -101,9 +197,10 @@ void AudioEngine::shutdown() {
 
 void AudioEngine::update() {
     if (!pImpl || !pImpl->initialized) return;
-    
-    std::lock_guard<std::mutex> lock(pImpl->mutex);
-    // Hier könnte die Aktualisierung der Synthesizer-Parameter erfolgen
+    VRDAW_ASSERT_NOT_REALTIME("AudioEngine::update");
+
+    // Ausgetauschte Snapshots freigeben, sobald die Grace-Periode vorbei ist
+    pImpl->snapshots.collectRetired();
 }
 
 void AudioEngine::createSynthesizer(int trackId, const SynthesizerConfig& config) {
@@ -111,6 +208,10 @@ void AudioEngine::createSynthesizer(int trackId, const SynthesizerConfig& config
     
     std::lock_guard<std::mutex> lock(pImpl->mutex);
     pImpl->synthesizers[trackId] = config;
+
+    // Instanz im Kontroll-Thread anlegen; der Audio-Thread sieht sie über den Snapshot
+    pImpl->synthesizerInstances[trackId] = makeSynthesizer(config, sampleRate);
+    publishRenderSnapshot();
     Logger::getInstance().log(LogLevel::Info, "Synthesizer für Track " + std::to_string(trackId) + " erstellt");
 }
 
@@ -121,6 +222,11 @@ void AudioEngine::updateSynthesizer(int trackId, const SynthesizerConfig& config
     auto it = pImpl->synthesizers.find(trackId);
     if (it != pImpl->synthesizers.end()) {
         it->second = config;
+        // Immer eine neue Instanz: die veröffentlichte liest der Audio-Thread
+        // ohne Lock, ihre Setter dürfen nicht mehr laufen. Die alte lebt bis
+        // zur Freigabe ihres Snapshots weiter
+        pImpl->synthesizerInstances[trackId] = makeSynthesizer(config, sampleRate);
+        publishRenderSnapshot();
         Logger::getInstance().log(LogLevel::Info, "Synthesizer für Track " + std::to_string(trackId) + " aktualisiert");
     }
 }
@@ -130,6 +236,8 @@ void AudioEngine::deleteSynthesizer(int trackId) {
     
     std::lock_guard<std::mutex> lock(pImpl->mutex);
     pImpl->synthesizers.erase(trackId);
+    pImpl->synthesizerInstances.erase(trackId);
+    publishRenderSnapshot();
     Logger::getInstance().log(LogLevel::Info, "Synthesizer für Track " + std::to_string(trackId) + " gelöscht");
 }
 
@@ -237,7 +345,9 @@ void AudioEngine::reinitializeDevice(int deviceId) {
 
 void AudioEngine::handleAudioEvent(const AudioEvent& event) {
     if (!pImpl || !pImpl->initialized) return;
-    
+
+    // UI-Thread: Zuordnung aus dem Kontroll-Zustand, nicht aus dem Snapshot.
+    // acquire()/release() gehören allein dem Audio-Callback
     std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = pImpl->synthesizers.find(event.channel);
     if (it != pImpl->synthesizers.end()) {
@@ -267,24 +377,228 @@ void AudioEngine::setAudioCallback(AudioCallback callback) {
 }
 
 void AudioEngine::process(float* input, float* output, unsigned long frameCount) {
-    if (!initialized || !isPlaying) return;
+    // Ab hier weder Locks noch Allokationen (siehe RealtimeGuard)
+    RealtimeGuard::ScopedAudioThread audioThread;
 
-    // Audio-Verarbeitung für jeden Track
-    for (auto& track : pImpl->tracks) {
-        if (track.muted) continue;
-        
-        // Track-Buffer mit Effekten verarbeiten
-        applyEffects(track, output, frameCount);
-        
-        // Volume und Pan anwenden
-        for (unsigned long i = 0; i < frameCount; ++i) {
-            output[i] *= track.volume * masterVolume;
-            // TODO: Pan-Implementierung
+    const unsigned long numChannels = 2;
+    std::fill(output, output + frameCount * numChannels, 0.0f);
+    if (!initialized) return;
+
+    const RenderSnapshot* snapshot = pImpl->snapshots.acquire();
+    applyParameterChanges(*snapshot);
+    collectMIDIEvents(*snapshot, frameCount);
+    if (!isPlaying) {
+        pImpl->snapshots.release();
+        return;
+    }
+    const unsigned long blockFrames = snapshot->blockFrames;
+
+    // Interleavte Backends laufen über die planaren Scratch-Buffer des Snapshots
+    float* inLeft = snapshot->scratch->ioBuffers.data();
+    float* inRight = inLeft + blockFrames;
+    float* outLeft = inRight + blockFrames;
+    float* outRight = outLeft + blockFrames;
+
+    for (unsigned long offset = 0; offset < frameCount && blockFrames > 0; offset += blockFrames) {
+        const unsigned long frames = std::min(blockFrames, frameCount - offset);
+        if (input) {
+            dsp::deinterleave(input + offset * numChannels, inLeft, inRight, frames);
+        }
+        std::fill(outLeft, outLeft + frames, 0.0f);
+        std::fill(outRight, outRight + frames, 0.0f);
+
+        renderBlock(*snapshot, static_cast<uint32_t>(offset),
+                    input ? inLeft : nullptr, input ? inRight : nullptr,
+                    outLeft, outRight, frames);
+        dsp::interleave(outLeft, outRight, output + offset * numChannels, frames);
+    }
+
+    pImpl->snapshots.release();
+}
+
+void AudioEngine::processPlanar(const float* const* inputs, size_t numInputs,
+                                float* const* outputs, size_t numOutputs,
+                                unsigned long frameCount) {
+    RealtimeGuard::ScopedAudioThread audioThread;
+
+    for (size_t c = 0; c < numOutputs; ++c) {
+        std::fill(outputs[c], outputs[c] + frameCount, 0.0f);
+    }
+    if (!initialized || numOutputs == 0) return;
+
+    const RenderSnapshot* snapshot = pImpl->snapshots.acquire();
+    applyParameterChanges(*snapshot);
+    collectMIDIEvents(*snapshot, frameCount);
+    if (!isPlaying) {
+        pImpl->snapshots.release();
+        return;
+    }
+    const unsigned long blockFrames = snapshot->blockFrames;
+
+    // Master geht auf die ersten beiden Ausgänge; bei nur einem Ausgang
+    // landen beide Seiten im selben Buffer (Mono-Summe)
+    const float* inLeft = numInputs > 0 ? inputs[0] : nullptr;
+    const float* inRight = numInputs > 1 ? inputs[1] : inLeft;
+    float* outLeft = outputs[0];
+    float* outRight = numOutputs > 1 ? outputs[1] : outputs[0];
+
+    for (unsigned long offset = 0; offset < frameCount && blockFrames > 0; offset += blockFrames) {
+        const unsigned long frames = std::min(blockFrames, frameCount - offset);
+        renderBlock(*snapshot, static_cast<uint32_t>(offset),
+                    inLeft ? inLeft + offset : nullptr,
+                    inRight ? inRight + offset : nullptr,
+                    outLeft + offset, outRight + offset, frames);
+    }
+
+    pImpl->snapshots.release();
+}
+
+int AudioEngine::processJack(jack_nframes_t frameCount) {
+    // Direkt in die Port-Buffer rendern, ohne Zwischenpuffer
+    for (size_t c = 0; c < pImpl->jackInputPorts.size(); ++c) {
+        pImpl->jackInputBuffers[c] = static_cast<const float*>(
+            jack_port_get_buffer(pImpl->jackInputPorts[c], frameCount));
+    }
+    for (size_t c = 0; c < pImpl->jackOutputPorts.size(); ++c) {
+        pImpl->jackOutputBuffers[c] = static_cast<float*>(
+            jack_port_get_buffer(pImpl->jackOutputPorts[c], frameCount));
+    }
+
+    processPlanar(pImpl->jackInputBuffers.data(), pImpl->jackInputBuffers.size(),
+                  pImpl->jackOutputBuffers.data(), pImpl->jackOutputBuffers.size(),
+                  frameCount);
+    return 0;
+}
+
+void AudioEngine::collectMIDIEvents(const RenderSnapshot& snapshot, unsigned long frameCount) {
+    // Alle Eingänge bis jetzt leeren; Offsets beziehen sich auf den ganzen Callback
+    pImpl->midiEvents.clear();
+    const uint64_t callbackTime = MIDIEventQueue::now();
+    for (const auto& queue : snapshot.midiInputs) {
+        pImpl->midiEvents.collect(*queue, callbackTime, static_cast<uint32_t>(frameCount), sampleRate);
+    }
+}
+
+void AudioEngine::renderBlock(const RenderSnapshot& snapshot, uint32_t firstFrame,
+                              const float* inputLeft, const float* inputRight,
+                              float* outputLeft, float* outputRight,
+                              unsigned long frameCount) {
+    const size_t trackStride = static_cast<size_t>(snapshot.blockFrames) * 2;
+    RenderScratch& scratch = *snapshot.scratch;
+
+    // Tracks unabhängig voneinander auf allen Kernen rendern
+    auto renderTrack = [&](uint32_t node) {
+        const int trackIndex = scratch.graph.getNode(node).objectId;
+        const TrackRenderState& track = snapshot.tracks[trackIndex];
+        if (track.muted || (snapshot.anySolo && !track.soloed)) return;
+
+        float* left = scratch.trackBuffers.data() + trackIndex * trackStride;
+        float* right = left + snapshot.blockFrames;
+        if (track.synthesizerIndex >= 0) {
+            // Instrument-Track: Block wird an den MIDI-Event-Offsets geteilt
+            const SynthesizerRenderState& synth = snapshot.synthesizers[track.synthesizerIndex];
+            float* interleaved = scratch.synthBuffers.data() + track.synthesizerIndex * trackStride;
+            synth.instance->renderBlock(interleaved, frameCount, pImpl->midiEvents, firstFrame);
+            dsp::deinterleave(interleaved, left, right, frameCount);
+        } else if (inputLeft) {
+            std::copy(inputLeft, inputLeft + frameCount, left);
+            std::copy(inputRight, inputRight + frameCount, right);
+        } else {
+            std::fill(left, left + frameCount, 0.0f);
+            std::fill(right, right + frameCount, 0.0f);
+        }
+        applyEffects(snapshot, track, left, right, frameCount);
+    };
+    pImpl->workerPool.execute(scratch.graph, renderTrack);
+
+    // Join erfolgt: Master-Summe in fester Reihenfolge (deterministisch)
+    for (size_t t = 0; t < snapshot.tracks.size(); ++t) {
+        const TrackRenderState& track = snapshot.tracks[t];
+        if (track.muted || (snapshot.anySolo && !track.soloed)) continue;
+
+        const float* left = scratch.trackBuffers.data() + t * trackStride;
+        const float* right = left + snapshot.blockFrames;
+        dsp::multiplyAdd(outputLeft, left, frameCount, track.leftGain * snapshot.masterVolume);
+        dsp::multiplyAdd(outputRight, right, frameCount, track.rightGain * snapshot.masterVolume);
+    }
+}
+
+void AudioEngine::publishRenderSnapshot() {
+    VRDAW_ASSERT_NOT_REALTIME("AudioEngine::publishRenderSnapshot");
+
+    auto snapshot = std::make_unique<RenderSnapshot>();
+    snapshot->masterVolume = masterVolume;
+    snapshot->tracks.reserve(pImpl->tracks.size());
+
+    for (const auto& track : pImpl->tracks) {
+        TrackRenderState state;
+        state.id = track.id;
+        state.volume = track.volume;
+        state.pan = track.pan;
+        state.muted = track.muted;
+        state.soloed = track.soloed;
+
+        // Constant-Power-Panning einmal pro Änderung statt pro Sample
+        float leftGain, rightGain;
+        dsp::constantPowerPanGains(track.pan, leftGain, rightGain);
+        state.leftGain = track.volume * leftGain;
+        state.rightGain = track.volume * rightGain;
+
+        state.firstPlugin = static_cast<uint32_t>(snapshot->plugins.size());
+        for (const auto& pluginName : track.plugins) {
+            auto it = std::find_if(pImpl->plugins.begin(), pImpl->plugins.end(),
+                [&pluginName](const AudioPlugin& p) { return p.name == pluginName; });
+            if (it == pImpl->plugins.end()) continue;
+
+            PluginRenderState pluginState;
+            pluginState.id = it->id;
+            pluginState.firstParameter = static_cast<uint32_t>(snapshot->parameterValues.size());
+            snapshot->parameterValues.insert(snapshot->parameterValues.end(),
+                                             it->parameters.begin(), it->parameters.end());
+            pluginState.parameterCount = static_cast<uint32_t>(it->parameters.size());
+            snapshot->plugins.push_back(pluginState);
+        }
+        state.pluginCount = static_cast<uint32_t>(snapshot->plugins.size()) - state.firstPlugin;
+        state.synthesizerIndex = -1;
+
+        snapshot->anySolo = snapshot->anySolo || track.soloed;
+        snapshot->tracks.push_back(state);
+    }
+
+    snapshot->pluginsById.resize(snapshot->plugins.size());
+    for (uint32_t i = 0; i < snapshot->pluginsById.size(); ++i) snapshot->pluginsById[i] = i;
+    std::stable_sort(snapshot->pluginsById.begin(), snapshot->pluginsById.end(),
+        [&snapshot](uint32_t a, uint32_t b) { return snapshot->plugins[a].id < snapshot->plugins[b].id; });
+
+    snapshot->synthesizers.reserve(pImpl->synthesizers.size());
+    for (const auto& [trackId, config] : pImpl->synthesizers) {
+        snapshot->synthesizers.push_back({trackId, config, pImpl->synthesizerInstances[trackId]});
+    }
+    for (auto& state : snapshot->tracks) {
+        if (const SynthesizerRenderState* synth = snapshot->findSynthesizer(state.id)) {
+            state.synthesizerIndex = static_cast<int32_t>(synth - snapshot->synthesizers.data());
         }
     }
+    snapshot->midiInputs = pImpl->midiQueues;
+
+    // Tracks sind untereinander unabhängig; Busse/Sends hängen sich
+    // später als zusätzliche Knoten mit Abhängigkeiten an
+    for (size_t i = 0; i < snapshot->tracks.size(); ++i) {
+        snapshot->scratch->graph.addNode(AudioTaskGraph::NodeType::Track, static_cast<int>(i));
+    }
+    snapshot->scratch->graph.compile();
+
+    snapshot->blockFrames = static_cast<uint32_t>(bufferSize);
+    snapshot->scratch->trackBuffers.assign(snapshot->tracks.size() * bufferSize * 2, 0.0f);
+    snapshot->scratch->ioBuffers.assign(static_cast<size_t>(bufferSize) * 4, 0.0f);
+    snapshot->scratch->synthBuffers.assign(snapshot->synthesizers.size() * bufferSize * 2, 0.0f);
+
+    pImpl->snapshots.publish(std::move(snapshot));
 }
 
 AudioEngine::AudioTrack* AudioEngine::createTrack(const std::string& name) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
     AudioTrack track;
     track.id = pImpl->tracks.size();
     track.name = name;
@@ -294,57 +608,113 @@ AudioEngine::AudioTrack* AudioEngine::createTrack(const std::string& name) {
     track.soloed = false;
     
     pImpl->tracks.push_back(track);
+    publishRenderSnapshot();
     return &pImpl->tracks.back();
 }
 
 void AudioEngine::deleteTrack(int trackId) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
     auto it = std::find_if(pImpl->tracks.begin(), pImpl->tracks.end(),
         [trackId](const AudioTrack& t) { return t.id == trackId; });
     
     if (it != pImpl->tracks.end()) {
         pImpl->tracks.erase(it);
+        publishRenderSnapshot();
     }
 }
 
 void AudioEngine::updateTrack(AudioTrack* track) {
     if (!track) return;
-    
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = std::find_if(pImpl->tracks.begin(), pImpl->tracks.end(),
         [track](const AudioTrack& t) { return t.id == track->id; });
     
     if (it != pImpl->tracks.end()) {
         *it = *track;
+        publishRenderSnapshot();
     }
 }
 
 AudioEngine::AudioPlugin* AudioEngine::loadPlugin(const std::string& name, const std::string& type) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
     AudioPlugin plugin;
     plugin.id = pImpl->plugins.size();
     plugin.name = name;
     plugin.type = type;
     
     pImpl->plugins.push_back(plugin);
+    publishRenderSnapshot();
     return &pImpl->plugins.back();
 }
 
 void AudioEngine::unloadPlugin(int pluginId) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
     auto it = std::find_if(pImpl->plugins.begin(), pImpl->plugins.end(),
         [pluginId](const AudioPlugin& p) { return p.id == pluginId; });
     
     if (it != pImpl->plugins.end()) {
         pImpl->plugins.erase(it);
+        publishRenderSnapshot();
     }
 }
 
 void AudioEngine::setPluginParameter(int pluginId, const std::string& paramName, float value) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
     auto it = std::find_if(pImpl->plugins.begin(), pImpl->plugins.end(),
         [pluginId](const AudioPlugin& p) { return p.id == pluginId; });
-    
-    if (it != pImpl->plugins.end()) {
-        it->parameters[paramName] = value;
+    if (it == pImpl->plugins.end()) return;
+
+    ParameterId id = it->parameterInfo.find(paramName);
+    if (id == kInvalidParameterId) {
+        // Neuer Parameter: Layout im Snapshot ändert sich
+        ParameterInfo info;
+        info.name = paramName;
+        info.minimum = -std::numeric_limits<float>::max();
+        info.maximum = std::numeric_limits<float>::max();
+        it->parameterInfo.add(info);
+        it->parameters.push_back(value);
+        publishRenderSnapshot();
+        return;
+    }
+    setPluginParameterLocked(*it, id, value);
+}
+
+void AudioEngine::setPluginParameter(int pluginId, ParameterId parameterId, float value) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    auto it = std::find_if(pImpl->plugins.begin(), pImpl->plugins.end(),
+        [pluginId](const AudioPlugin& p) { return p.id == pluginId; });
+    if (it == pImpl->plugins.end() || !it->parameterInfo.contains(parameterId)) return;
+    setPluginParameterLocked(*it, parameterId, value);
+}
+
+ParameterId AudioEngine::getPluginParameterId(int pluginId, const std::string& paramName) const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    auto it = std::find_if(pImpl->plugins.begin(), pImpl->plugins.end(),
+        [pluginId](const AudioPlugin& p) { return p.id == pluginId; });
+    return it != pImpl->plugins.end() ? it->parameterInfo.find(paramName) : kInvalidParameterId;
+}
+
+void AudioEngine::setPluginParameterLocked(AudioPlugin& plugin, ParameterId id, float value) {
+    value = plugin.parameterInfo.clamp(id, value);
+    plugin.parameters[id] = value;
+    // Queue voll: dann doch ein neuer Snapshot, der alle Werte enthält
+    if (!pImpl->parameterChanges.push(ParameterChange{plugin.id, id, value})) {
+        publishRenderSnapshot();
     }
 }
 
+void AudioEngine::applyParameterChanges(const RenderSnapshot& snapshot) {
+    ParameterChange change;
+    while (pImpl->parameterChanges.pop(change)) snapshot.applyParameterChange(change);
+}
+
 void AudioEngine::startPlayback() {
     if (!initialized) return;
     
@@ -378,7 +748,9 @@ void AudioEngine::setPlaybackPosition(double position) {
 }
 
 void AudioEngine::setMasterVolume(float volume) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     masterVolume = std::max(0.0f, std::min(1.0f, volume));
+    publishRenderSnapshot();
 }
 
 void AudioEngine::setSampleRate(int rate) {
@@ -389,7 +761,11 @@ void AudioEngine::setSampleRate(int rate) {
 
 void AudioEngine::setBufferSize(int size) {
     if (size > 0) {
+        VRDAW_ASSERT_NOT_REALTIME("AudioEngine::setBufferSize");
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
         bufferSize = size;
+        // Neue Track-Buffer kommen mit dem nächsten Snapshot
+        publishRenderSnapshot();
     }
 }
 
@@ -418,14 +794,26 @@ void AudioEngine::initializePortAudio() {
         throw std::runtime_error("PortAudio initialization failed");
     }
 
+    // Nicht-interleavt: der Callback bekommt wie bei JACK Kanal-Zeiger
     err = Pa_OpenDefaultStream(&stream,
                              0,          // Keine Eingabekanäle
                              2,          // Stereo-Ausgabe
-                             paFloat32,  // 32-bit floating point
+                             paFloat32 | paNonInterleaved,
                              sampleRate,
                              bufferSize,
-                             nullptr,    // Kein Callback
-                             nullptr);   // Keine Callback-Daten
+                             [](const void* input, void* output, unsigned long frameCount,
+                                const PaStreamCallbackTimeInfo* timeInfo,
+                                PaStreamCallbackFlags statusFlags, void* userData) -> int {
+                                 auto* engine = static_cast<AudioEngine*>(userData);
+                                 if (statusFlags & (paOutputUnderflow | paInputOverflow)) {
+                                     engine->pImpl->xrunCount.fetch_add(1, std::memory_order_relaxed);
+                                 }
+                                 engine->processPlanar(static_cast<const float* const*>(input), 0,
+                                                       static_cast<float* const*>(output), 2,
+                                                       frameCount);
+                                 return paContinue;
+                             },
+                             this);
 
     if (err != paNoError) {
         throw std::runtime_error("Failed to open PortAudio stream");
@@ -438,23 +826,101 @@ void AudioEngine::initializeJack() {
         throw std::runtime_error("Failed to create JACK client");
     }
 
+    sampleRate = static_cast<int>(jack_get_sample_rate(jackClient));
+    setBufferSize(static_cast<int>(jack_get_buffer_size(jackClient)));
+
+    // Ports und Zeiger-Arrays für den Callback einmalig anlegen
+    pImpl->jackInputPorts.clear();
+    pImpl->jackOutputPorts.clear();
+    for (int i = 0; i < pImpl->jackInputChannels; ++i) {
+        const std::string name = "in_" + std::to_string(i + 1);
+        jack_port_t* port = jack_port_register(jackClient, name.c_str(),
+                                               JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
+        if (!port) {
+            throw std::runtime_error("Failed to register JACK port " + name);
+        }
+        pImpl->jackInputPorts.push_back(port);
+    }
+    for (int i = 0; i < pImpl->jackOutputChannels; ++i) {
+        const std::string name = "out_" + std::to_string(i + 1);
+        jack_port_t* port = jack_port_register(jackClient, name.c_str(),
+                                               JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+        if (!port) {
+            throw std::runtime_error("Failed to register JACK port " + name);
+        }
+        pImpl->jackOutputPorts.push_back(port);
+    }
+    pImpl->jackInputBuffers.assign(pImpl->jackInputPorts.size(), nullptr);
+    pImpl->jackOutputBuffers.assign(pImpl->jackOutputPorts.size(), nullptr);
+
     jack_set_process_callback(jackClient,
         [](jack_nframes_t nframes, void* arg) -> int {
-            auto* engine = static_cast<AudioEngine*>(arg);
-            // TODO: JACK-Audio-Verarbeitung
+            return static_cast<AudioEngine*>(arg)->processJack(nframes);
+        }, this);
+
+    // JACK ruft das nicht parallel zu process auf; neue Track-Buffer
+    // kommen über den nächsten Snapshot
+    jack_set_buffer_size_callback(jackClient,
+        [](jack_nframes_t nframes, void* arg) -> int {
+            static_cast<AudioEngine*>(arg)->setBufferSize(static_cast<int>(nframes));
+            return 0;
+        }, this);
+
+    jack_set_sample_rate_callback(jackClient,
+        [](jack_nframes_t nframes, void* arg) -> int {
+            static_cast<AudioEngine*>(arg)->setSampleRate(static_cast<int>(nframes));
+            return 0;
+        }, this);
+
+    jack_set_xrun_callback(jackClient,
+        [](void* arg) -> int {
+            static_cast<AudioEngine*>(arg)->pImpl->xrunCount.fetch_add(1, std::memory_order_relaxed);
             return 0;
         }, this);
 
     if (jack_activate(jackClient) != 0) {
         throw std::runtime_error("Failed to activate JACK client");
     }
+
+    // Master-Ausgänge mit den physischen Wiedergabe-Ports verbinden
+    const char** playbackPorts = jack_get_ports(jackClient, nullptr, JACK_DEFAULT_AUDIO_TYPE,
+                                                JackPortIsPhysical | JackPortIsInput);
+    if (playbackPorts) {
+        for (size_t i = 0; i < pImpl->jackOutputPorts.size() && i < 2 && playbackPorts[i]; ++i) {
+            jack_connect(jackClient, jack_port_name(pImpl->jackOutputPorts[i]), playbackPorts[i]);
+        }
+        jack_free(playbackPorts);
+    }
+}
+
+void AudioEngine::setJackChannelCount(int inputs, int outputs) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->jackInputChannels = std::max(0, inputs);
+    pImpl->jackOutputChannels = std::max(1, outputs);
+}
+
+AudioEngine::PerformanceMetrics AudioEngine::getPerformanceMetrics() const {
+    PerformanceMetrics metrics{};
+    if (jackClient) {
+        metrics.cpuUsage = jack_cpu_load(jackClient);
+    } else if (stream) {
+        metrics.cpuUsage = static_cast<float>(Pa_GetStreamCpuLoad(stream) * 100.0);
+    }
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    metrics.activePlugins = static_cast<int>(pImpl->plugins.size());
+    metrics.bufferUnderruns = static_cast<int>(pImpl->xrunCount.load(std::memory_order_relaxed));
+    return metrics;
 }
 
 void AudioEngine::processAudio(float* input, float* output, unsigned long frameCount) {
     // TODO: Implementierung der Audio-Verarbeitung
 }
 
-void AudioEngine::applyEffects(AudioTrack& track, float* buffer, unsigned long frameCount) {
+void AudioEngine::applyEffects(const RenderSnapshot& snapshot, const TrackRenderState& track,
+                               float* left, float* right, unsigned long frameCount) {
+    // Plugin-Parameter liegen flach im Snapshot:
+    // snapshot.parameterValues[plugin.firstParameter + i]
     // TODO: Implementierung der Effekt-Verarbeitung
 }
 
@@ -519,42 +985,30 @@ void AudioEngine::processAudioSIMD(AudioBuffer& buffer) {
         return;
     }
 
-    // SIMD-optimierte Audio-Verarbeitung
-    const int simdWidth = 8; // Für AVX2
-    const int numSamples = buffer.size;
-    const int numSIMDIterations = numSamples / simdWidth;
-
-    for (int i = 0; i < numSIMDIterations; ++i) {
-        __m256 input = _mm256_loadu_ps(&buffer.data[i * simdWidth]);
-        __m256 processed = _mm256_mul_ps(input, _mm256_set1_ps(masterVolume));
-        _mm256_storeu_ps(&buffer.data[i * simdWidth], processed);
-    }
-
-    // Restliche Samples verarbeiten
-    for (int i = numSIMDIterations * simdWidth; i < numSamples; ++i) {
-        buffer.data[i] *= masterVolume;
-    }
+    // SIMD-Variante (SSE2/AVX2/AVX-512) wurde beim Start per CPUID gewählt
+    dsp::applyGain(buffer.data, buffer.size, masterVolume);
 }
 
 void AudioEngine::processAudioMultiThreaded(AudioBuffer& buffer) {
-    const int numSamples = buffer.size;
-    const int samplesPerThread = numSamples / threadCount;
-
-    std::vector<std::thread> threads;
-    for (int i = 0; i < threadCount; ++i) {
-        const int start = i * samplesPerThread;
-        const int end = (i == threadCount - 1) ? numSamples : (i + 1) * samplesPerThread;
-
-        threads.emplace_back([this, &buffer, start, end]() {
-            for (int j = start; j < end; ++j) {
-                buffer.data[j] *= masterVolume;
-            }
-        });
+    const size_t numChunks = pImpl->chunkGraph.size();
+    if (numChunks == 0) {
+        processAudioSingleThreaded(buffer);
+        return;
     }
 
-    for (auto& thread : threads) {
-        thread.join();
-    }
+    const size_t numSamples = buffer.size;
+    const size_t samplesPerChunk = numSamples / numChunks;
+    const float gain = masterVolume;
+
+    // Persistente Worker statt threadCount neuer std::threads pro Buffer
+    auto processChunk = [&](uint32_t chunk) {
+        const size_t start = chunk * samplesPerChunk;
+        const size_t end = (chunk == numChunks - 1) ? numSamples : start + samplesPerChunk;
+        for (size_t j = start; j < end; ++j) {
+            buffer.data[j] *= gain;
+        }
+    };
+    pImpl->workerPool.execute(pImpl->chunkGraph, processChunk);
 }
 
 void AudioEngine::processAudioSingleThreaded(AudioBuffer& buffer) {
@@ -585,15 +1039,45 @@ void AudioEngine::optimizeBufferSize() {
 }
 
 void AudioEngine::setThreadCount(int count) {
-    if (count > 0) {
-        threadCount = count;
-        if (initialized) {
-            cleanupThreads();
-            initializeThreads();
-        }
+    VRDAW_ASSERT_NOT_REALTIME("AudioEngine::setThreadCount");
+    if (count <= 0) return;
+
+    // Pool und chunkGraph gehören während der Wiedergabe dem Audio-Callback;
+    // umgebaut wird nur im Stillstand
+    if (isPlaying) {
+        logError("Thread-Anzahl kann während der Wiedergabe nicht geändert werden");
+        return;
+    }
+
+    threadCount = count;
+    if (initialized) {
+        // Ein Callback, der isPlaying noch gesetzt gesehen hat, muss den
+        // Pool erst verlassen haben
+        pImpl->snapshots.synchronize();
+        cleanupThreads();
+        initializeThreads();
+        initializeThreadPool();
     }
 }
 
+void AudioEngine::initializeThreadPool() {
+    VRDAW_ASSERT_NOT_REALTIME("AudioEngine::initializeThreadPool");
+
+    // Der Audio-Thread arbeitet selbst mit, daher threadCount - 1 Worker
+    const size_t numWorkers = threadCount > 1 ? static_cast<size_t>(threadCount - 1) : 0;
+    pImpl->workerPool.start(numWorkers);
+
+    pImpl->chunkGraph.clear();
+    for (int i = 0; i < std::max(1, threadCount); ++i) {
+        pImpl->chunkGraph.addNode(AudioTaskGraph::NodeType::Track, i);
+    }
+    pImpl->chunkGraph.compile();
+}
+
+void AudioEngine::shutdownThreadPool() {
+    pImpl->workerPool.stop();
+}
+
 void AudioEngine::enableSIMD(bool enable) {
     simdEnabled = enable;
 }
@@ -611,6 +1095,12 @@ void AudioEngine::setMIDIEngine(std::shared_ptr<MIDIEngine> engine) {
             handleMIDIMessage(msg);
         });
     }
+
+    // Der Audio-Thread liest die Ringe direkt, ohne Umweg über diesen Thread
+    std::lock_guard<std::mutex> stateLock(pImpl->mutex);
+    pImpl->midiQueues = midiEngine ? midiEngine->getAudioQueues()
+                                   : std::vector<std::shared_ptr<MIDIEventQueue>>();
+    publishRenderSnapshot();
 }
 
 void AudioEngine::processMIDIInput() {
@@ -635,32 +1125,8 @@ void AudioEngine::handleMIDIMessage(const MIDIEngine::MIDIMessage& message) {
         midiCallback(message);
     }
 
-    // MIDI-Nachricht an aktive Tracks weiterleiten
-    for (auto& track : pImpl->tracks) {
-        if (track.isActive && track.midiEnabled) {
-            switch (message.type) {
-                case MIDIEngine::MIDIMessage::Type::NoteOn:
-                    // Note-On an Track senden
-                    track.processMIDINoteOn(message.channel, message.data1, message.data2);
-                    break;
-                case MIDIEngine::MIDIMessage::Type::NoteOff:
-                    // Note-Off an Track senden
-                    track.processMIDINoteOff(message.channel, message.data1, message.data2);
-                    break;
-                case MIDIEngine::MIDIMessage::Type::ControlChange:
-                    // Control Change an Track senden
-                    track.processMIDIControlChange(message.channel, message.data1, message.data2);
-                    break;
-                case MIDIEngine::MIDIMessage::Type::PitchBend:
-                    // Pitch Bend an Track senden
-                    track.processMIDIPitchBend(message.channel, 
-                        (message.data2 << 7) | message.data1);
-                    break;
-                default:
-                    break;
-            }
-        }
-    }
+    // Noten erreichen die Synthesizer nicht von hier aus, sondern
+    // sample-genau über die MIDI-Ringe im Audio-Thread (collectMIDIEvents)
 }
 
 void AudioEngine::startMIDIRecording() {
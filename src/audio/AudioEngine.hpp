@@ -12,28 +12,15 @@
 #include <jack/jack.h>
 #include <atomic>
 #include <functional>
-#include <immintrin.h>
 #include "../midi/MIDIEngine.hpp"
 #include "AudioEvent.hpp"
 #include "SynthesizerConfig.hpp"
+#include "ParameterRegistry.hpp"
 
 namespace VR_DAW {
 
-class ThreadPool {
-public:
-    ThreadPool(size_t numThreads);
-    ~ThreadPool();
-    
-    template<class F>
-    void enqueue(F&& f);
-    
-private:
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-    std::mutex queueMutex;
-    std::condition_variable condition;
-    bool stop;
-};
+struct RenderSnapshot;
+struct TrackRenderState;
 
 class GPUAccelerator {
 public:
@@ -107,7 +94,10 @@ public:
         int id;
         std::string name;
         std::string type;
-        std::map<std::string, float> parameters;
+        // Namen werden beim ersten Setzen registriert; die Werte liegen
+        // nach ParameterId, im Snapshot in derselben Reihenfolge
+        ParameterRegistry parameterInfo;
+        std::vector<float> parameters;
         std::atomic<bool> isProcessing;
         std::mutex parameterMutex;
     };
@@ -131,7 +121,12 @@ public:
     
     AudioPlugin* loadPlugin(const std::string& name, const std::string& type);
     void unloadPlugin(int pluginId);
+    // Bekannte Parameter gehen über eine lockfreie Queue an den Audio-Thread;
+    // ein neuer Name baut einmal den Render-Snapshot neu
     void setPluginParameter(int pluginId, const std::string& paramName, float value);
+    void setPluginParameter(int pluginId, ParameterId parameterId, float value);
+    // kInvalidParameterId, solange der Name nie gesetzt wurde
+    ParameterId getPluginParameterId(int pluginId, const std::string& paramName) const;
     
     void startPlayback();
     void stopPlayback();
@@ -315,6 +310,9 @@ public:
     // Audio-Buffering
     void setAudioBufferSize(int size);
     void setAudioBufferCount(int count);
+
+    // JACK-Ports (wirkt beim nächsten Verbindungsaufbau)
+    void setJackChannelCount(int inputs, int outputs);
     
     // Thread-Pool-Verwaltung
     void initializeThreadPool();
@@ -336,6 +334,7 @@ public:
     // Neue Methoden für optimierte Verarbeitung
     void processAudioBuffers();
     void optimizeBufferSize();
+    // Nur im Stillstand; während der Wiedergabe wird der Aufruf verworfen
     void setThreadCount(int count);
     void enableSIMD(bool enable);
     void setProcessingMode(ProcessingMode mode);
@@ -359,7 +358,7 @@ private:
     int sampleRate;
     int bufferSize;
     float masterVolume;
-    bool isPlaying;
+    std::atomic<bool> isPlaying;
     double playbackPosition;
     
     std::vector<AudioTrack> tracks;
@@ -386,7 +385,22 @@ private:
     void initializePortAudio();
     void initializeJack();
     void processAudio(float* input, float* output, unsigned long frameCount);
-    void applyEffects(AudioTrack& track, float* buffer, unsigned long frameCount);
+    int processJack(jack_nframes_t frameCount);
+    void processPlanar(const float* const* inputs, size_t numInputs,
+                       float* const* outputs, size_t numOutputs,
+                       unsigned long frameCount);
+    void collectMIDIEvents(const RenderSnapshot& snapshot, unsigned long frameCount);
+    void renderBlock(const RenderSnapshot& snapshot, uint32_t firstFrame,
+                     const float* inputLeft, const float* inputRight,
+                     float* outputLeft, float* outputRight,
+                     unsigned long frameCount);
+    void applyEffects(const RenderSnapshot& snapshot, const TrackRenderState& track,
+                      float* left, float* right, unsigned long frameCount);
+    void publishRenderSnapshot();
+    // Unter pImpl->mutex
+    void setPluginParameterLocked(AudioPlugin& plugin, ParameterId id, float value);
+    // Audio-Thread, direkt nach acquire()
+    void applyParameterChanges(const RenderSnapshot& snapshot);
     void processBuffer(AudioBuffer& buffer);
     void optimizeProcessing();
     void initializeThreads();
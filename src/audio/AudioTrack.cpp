@@ -1,5 +1,6 @@
 #include "AudioTrack.hpp"
 #include "SubtractiveSynthesizer.hpp"
+#include "../dsp/kernels/DSPKernels.hpp"
 #include <algorithm>
 #include <cmath>
 #include <stdexcept>
@@ -10,23 +11,43 @@ AudioTrack::AudioTrack()
     : midiEnabled(false)
     , midiChannel(0)
     , pitchBend(0.0f)
+    , subtractive(nullptr)
     , volume(1.0f)
     , pan(0.0f)
     , muted(false)
     , solo(false)
     , active(true)
     , name("Unnamed Track")
+    , volumeSmoother(1.0f)
+    , panSmoother(0.0f)
 {
     // Standard-Synthesizer-Parameter
-    synthesizerParameters["oscillator_type"] = 0.0f; // Sine
-    synthesizerParameters["filter_cutoff"] = 1000.0f;
-    synthesizerParameters["filter_resonance"] = 0.7f;
-    synthesizerParameters["envelope_attack"] = 0.1f;
-    synthesizerParameters["envelope_decay"] = 0.1f;
-    synthesizerParameters["envelope_sustain"] = 0.7f;
-    synthesizerParameters["envelope_release"] = 0.2f;
-    synthesizerParameters["lfo_rate"] = 5.0f;
-    synthesizerParameters["lfo_depth"] = 0.1f;
+    const ParameterRegistry& parameters = getSynthesizerParameters();
+    synthesizerValues.resize(parameters.size());
+    for (ParameterId id = 0; id < parameters.size(); ++id) {
+        synthesizerValues[id] = parameters.getInfo(id).defaultValue;
+    }
+}
+
+const ParameterRegistry& AudioTrack::getSynthesizerParameters() {
+    static const ParameterRegistry registry = [] {
+        ParameterRegistry r;
+        r.add({"oscillator_type", 0.0f, 4.0f, 0.0f, ParameterUnit::None, 0.0f, true, false}); // Sine
+        r.add({"oscillator_mix", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"oscillator_detune", -1.0f, 1.0f, 0.0f, ParameterUnit::Semitones});
+        r.add({"filter_type", 0.0f, 3.0f, 0.0f, ParameterUnit::None, 0.0f, true, false});
+        r.add({"filter_cutoff", 20.0f, 20000.0f, 1000.0f, ParameterUnit::Hertz});
+        r.add({"filter_resonance", 0.0f, 1.0f, 0.7f, ParameterUnit::Percent});
+        r.add({"envelope_attack", 0.0f, 10.0f, 0.1f, ParameterUnit::Seconds});
+        r.add({"envelope_decay", 0.0f, 10.0f, 0.1f, ParameterUnit::Seconds});
+        r.add({"envelope_sustain", 0.0f, 1.0f, 0.7f, ParameterUnit::Percent});
+        r.add({"envelope_release", 0.0f, 10.0f, 0.2f, ParameterUnit::Seconds});
+        r.add({"lfo_rate", 0.1f, 20.0f, 5.0f, ParameterUnit::Hertz});
+        r.add({"lfo_depth", 0.0f, 1.0f, 0.1f, ParameterUnit::Percent});
+        r.add({"lfo_waveform", 0.0f, 4.0f, 0.0f, ParameterUnit::None, 0.0f, true, false});
+        return r;
+    }();
+    return registry;
 }
 
 AudioTrack::~AudioTrack() {
@@ -95,6 +116,7 @@ uint8_t AudioTrack::getMIDIChannel() const {
 void AudioTrack::setSynthesizer(std::shared_ptr<Synthesizer> synth) {
     std::lock_guard<std::mutex> lock(synthMutex);
     synthesizer = synth;
+    subtractive = dynamic_cast<SubtractiveSynthesizer*>(synthesizer.get());
     updateSynthesizerParameters();
 }
 
@@ -108,7 +130,9 @@ void AudioTrack::setSynthesizerType(const std::string& type) {
 
     // Synthesizer-Typ erstellen
     if (type == "subtractive") {
-        synthesizer = std::make_shared<SubtractiveSynthesizer>();
+        auto synth = std::make_shared<SubtractiveSynthesizer>();
+        subtractive = synth.get();
+        synthesizer = std::move(synth);
         updateSynthesizerParameters();
     }
     // Weitere Synthesizer-Typen hier...
@@ -118,49 +142,64 @@ std::string AudioTrack::getSynthesizerType() const {
     return synthesizerType;
 }
 
-void AudioTrack::setSynthesizerParameter(const std::string& param, float value) {
+void AudioTrack::setSynthesizerParameter(ParameterId id, float value) {
+    const ParameterRegistry& parameters = getSynthesizerParameters();
+    if (!parameters.contains(id)) return;
+
     std::lock_guard<std::mutex> lock(synthMutex);
-    synthesizerParameters[param] = value;
+    synthesizerValues[id] = parameters.clamp(id, value);
+    applySynthesizerParameter(id);
+}
 
-    if (synthesizer) {
-        if (param == "oscillator_type") {
-            if (auto* subSynth = dynamic_cast<SubtractiveSynthesizer*>(synthesizer.get())) {
-                subSynth->setOscillatorType(static_cast<SubtractiveSynthesizer::OscillatorType>(
+float AudioTrack::getSynthesizerParameter(ParameterId id) const {
+    std::lock_guard<std::mutex> lock(synthMutex);
+    return id < synthesizerValues.size() ? synthesizerValues[id] : 0.0f;
+}
+
+void AudioTrack::setSynthesizerParameter(const std::string& param, float value) {
+    setSynthesizerParameter(getSynthesizerParameters().find(param), value);
+}
+
+float AudioTrack::getSynthesizerParameter(const std::string& param) const {
+    return getSynthesizerParameter(getSynthesizerParameters().find(param));
+}
+
+void AudioTrack::applySynthesizerParameter(ParameterId id) {
+    if (!synthesizer) return;
+
+    const float value = synthesizerValues[id];
+    switch (id) {
+        case kOscillatorType:
+            if (subtractive) {
+                subtractive->setOscillatorType(static_cast<SubtractiveSynthesizer::OscillatorType>(
                     static_cast<int>(value)));
             }
-        } else if (param == "filter_cutoff") {
+            break;
+        case kFilterCutoff:
             synthesizer->setFilterCutoff(value);
-        } else if (param == "filter_resonance") {
+            break;
+        case kFilterResonance:
             synthesizer->setFilterResonance(value);
-        } else if (param == "envelope_attack") {
-            Synthesizer::Envelope env = synthesizer->getEnvelope();
-            env.attack = value;
-            synthesizer->setEnvelope(env);
-        } else if (param == "envelope_decay") {
-            Synthesizer::Envelope env = synthesizer->getEnvelope();
-            env.decay = value;
-            synthesizer->setEnvelope(env);
-        } else if (param == "envelope_sustain") {
-            Synthesizer::Envelope env = synthesizer->getEnvelope();
-            env.sustain = value;
-            synthesizer->setEnvelope(env);
-        } else if (param == "envelope_release") {
-            Synthesizer::Envelope env = synthesizer->getEnvelope();
-            env.release = value;
-            synthesizer->setEnvelope(env);
-        } else if (param == "lfo_rate") {
+            break;
+        case kEnvelopeAttack:
+        case kEnvelopeDecay:
+        case kEnvelopeSustain:
+        case kEnvelopeRelease:
+            // Die Hüllkurve liegt vollständig hier, kein Lesen vom Synthesizer
+            synthesizer->setEnvelope({synthesizerValues[kEnvelopeAttack], synthesizerValues[kEnvelopeDecay],
+                                      synthesizerValues[kEnvelopeSustain], synthesizerValues[kEnvelopeRelease]});
+            break;
+        case kLfoRate:
             synthesizer->setLFORate(value);
-        } else if (param == "lfo_depth") {
+            break;
+        case kLfoDepth:
             synthesizer->setLFODepth(value);
-        }
+            break;
+        default:
+            break;
     }
 }
 
-float AudioTrack::getSynthesizerParameter(const std::string& param) const {
-    auto it = synthesizerParameters.find(param);
-    return it != synthesizerParameters.end() ? it->second : 0.0f;
-}
-
 void AudioTrack::processBlock(float* output, size_t numSamples) {
     if (!active || muted) return;
 
@@ -175,6 +214,31 @@ void AudioTrack::processBlock(float* output, size_t numSamples) {
     applyAudioProcessing(output, numSamples);
 }
 
+void AudioTrack::processBlock(float* output, size_t numSamples, const MIDIBlockEvents& events) {
+    if (!active || muted) return;
+
+    if (synthesizer) {
+        synthesizer->renderBlock(output, numSamples / 2, events);
+    }
+
+    applyAudioProcessing(output, numSamples);
+}
+
+void AudioTrack::processBlock(float* output, size_t numSamples, const MIDIBlockEvents& events, int64_t position) {
+    if (!active || muted) return;
+
+    if (synthesizer) {
+        synthesizer->renderBlock(output, numSamples / 2, events);
+    }
+
+    applyAudioProcessing(output, numSamples, position);
+}
+
+void AudioTrack::setSampleRate(float sampleRate) {
+    volumeSmoother.prepare(sampleRate);
+    panSmoother.prepare(sampleRate);
+}
+
 void AudioTrack::setVolume(float vol) {
     volume = std::max(0.0f, std::min(1.0f, vol));
 }
@@ -207,6 +271,17 @@ bool AudioTrack::isSolo() const {
     return solo;
 }
 
+void AudioTrack::setAutomation(Parameter parameter, const AutomationLane& lane) {
+    std::lock_guard<std::mutex> lock(automationMutex);
+    TripleBuffer<AutomationLane>& buffer = automation[static_cast<size_t>(parameter)];
+    buffer.write() = lane;
+    buffer.publish();
+}
+
+void AudioTrack::clearAutomation(Parameter parameter) {
+    setAutomation(parameter, AutomationLane());
+}
+
 bool AudioTrack::isActive() const {
     return active;
 }
@@ -226,29 +301,93 @@ void AudioTrack::setName(const std::string& n) {
 void AudioTrack::updateSynthesizerParameters() {
     if (!synthesizer) return;
 
-    for (const auto& [param, value] : synthesizerParameters) {
-        setSynthesizerParameter(param, value);
+    // Hüllkurve einmal statt viermal setzen
+    for (ParameterId id = 0; id < synthesizerValues.size(); ++id) {
+        if (id == kEnvelopeDecay || id == kEnvelopeSustain || id == kEnvelopeRelease) continue;
+        applySynthesizerParameter(id);
     }
 }
 
-void AudioTrack::applyAudioProcessing(float* output, size_t numSamples) {
-    // Volume und Pan anwenden
-    for (size_t i = 0; i < numSamples; i += 2) {
-        float leftSample = output[i];
-        float rightSample = output[i + 1];
+namespace {
 
-        // Volume
-        leftSample *= volume;
-        rightSample *= volume;
+// Balance: pan < 0 dämpft rechts, pan > 0 links
+inline float balanceLeft(float volume, float pan) {
+    return std::max(0.0f, volume) * (1.0f - std::max(0.0f, std::min(1.0f, pan)));
+}
 
-        // Pan
-        float leftGain = 1.0f - std::max(0.0f, pan);
-        float rightGain = 1.0f + std::min(0.0f, pan);
-        leftSample *= leftGain;
-        rightSample *= rightGain;
+inline float balanceRight(float volume, float pan) {
+    return std::max(0.0f, volume) * (1.0f + std::min(0.0f, std::max(-1.0f, pan)));
+}
+
+inline float rampValue(const ParameterRamp& ramp, size_t offset) {
+    return ramp.start + (ramp.end - ramp.start) * static_cast<float>(offset) / static_cast<float>(ramp.length);
+}
 
-        output[i] = leftSample;
-        output[i + 1] = rightSample;
+} // namespace
+
+void AudioTrack::applyAudioProcessing(float* output, size_t numSamples, int64_t position) {
+    // Zielwerte einmal pro Block laden; die Glätter liefern Rampen für den
+    // SIMD-Kernel statt Sprüngen
+    const size_t numFrames = numSamples / 2;
+    if (numFrames == 0) return;
+    volumeSmoother.setTarget(volume.load(std::memory_order_relaxed));
+    panSmoother.setTarget(pan.load(std::memory_order_relaxed));
+    const ParameterRamp volumeRamp = volumeSmoother.next(numFrames);
+    const ParameterRamp panRamp = panSmoother.next(numFrames);
+
+    const AutomationLane& volumeLane = automation[static_cast<size_t>(Parameter::Volume)].read();
+    const AutomationLane& panLane = automation[static_cast<size_t>(Parameter::Pan)].read();
+    const bool automateVolume = position >= 0 && !volumeLane.empty();
+    const bool automatePan = position >= 0 && !panLane.empty();
+
+    if (!automateVolume && !automatePan) {
+        if (volumeRamp.start == volumeRamp.end && panRamp.start == panRamp.end) {
+            dsp::applyStereoGain(output, numFrames, balanceLeft(volumeRamp.start, panRamp.start),
+                                 balanceRight(volumeRamp.start, panRamp.start));
+        } else {
+            dsp::applyStereoGainRamp(output, numFrames,
+                                     balanceLeft(volumeRamp.start, panRamp.start),
+                                     balanceLeft(volumeRamp.end, panRamp.end),
+                                     balanceRight(volumeRamp.start, panRamp.start),
+                                     balanceRight(volumeRamp.end, panRamp.end));
+        }
+        return;
+    }
+
+    // Sampelgenau: Stücke enden an jedem Stützpunkt beider Spuren
+    AutomationLane::Cursor& volumeCursor = automationCursors[static_cast<size_t>(Parameter::Volume)];
+    AutomationLane::Cursor& panCursor = automationCursors[static_cast<size_t>(Parameter::Pan)];
+    float lastVolume = volumeRamp.end;
+    float lastPan = panRamp.end;
+    for (size_t done = 0; done < numFrames;) {
+        const size_t rest = numFrames - done;
+        const int64_t at = position + static_cast<int64_t>(done);
+        const ParameterRamp v = automateVolume ? volumeLane.nextRamp(at, rest, volumeCursor) : volumeRamp;
+        const ParameterRamp p = automatePan ? panLane.nextRamp(at, rest, panCursor) : panRamp;
+        const size_t length = std::min({rest, automateVolume ? v.length : rest, automatePan ? p.length : rest});
+
+        // Ungeglättete Spur: Ausschnitt aus der Block-Rampe
+        const float volumeStart = automateVolume ? v.start : rampValue(v, done);
+        const float volumeEnd = automateVolume ? rampValue(v, length) : rampValue(v, done + length);
+        const float panStart = automatePan ? p.start : rampValue(p, done);
+        const float panEnd = automatePan ? rampValue(p, length) : rampValue(p, done + length);
+
+        dsp::applyStereoGainRamp(output + done * 2, length,
+                                 balanceLeft(volumeStart, panStart), balanceLeft(volumeEnd, panEnd),
+                                 balanceRight(volumeStart, panStart), balanceRight(volumeEnd, panEnd));
+        lastVolume = volumeEnd;
+        lastPan = panEnd;
+        done += length;
+    }
+
+    // Endet die Automation, gleitet der Wert von hier zum manuellen Wert
+    if (automateVolume) {
+        volumeSmoother.snap(lastVolume);
+        volumeSmoother.setTarget(volume.load(std::memory_order_relaxed));
+    }
+    if (automatePan) {
+        panSmoother.snap(lastPan);
+        panSmoother.setTarget(pan.load(std::memory_order_relaxed));
     }
 }
 
@@ -8,11 +8,40 @@
 #include <map>
 #include "../midi/MIDIEngine.hpp"
 #include "Synthesizer.hpp"
+#include "Automation.hpp"
+#include "ParameterRegistry.hpp"
+#include "TripleBuffer.hpp"
 
 namespace VR_DAW {
 
+class SubtractiveSynthesizer;
+
 class AudioTrack {
 public:
+    // Automatisierbare Parameter
+    enum class Parameter : uint8_t {
+        Volume,
+        Pan
+    };
+
+    // Synthesizer-Parameter, Reihenfolge wie in getSynthesizerParameters().
+    // Die mit * werden nur gespeichert (für UI und Projektdateien)
+    enum SynthesizerParameter : ParameterId {
+        kOscillatorType,
+        kOscillatorMix,      // *
+        kOscillatorDetune,   // *
+        kFilterType,         // *
+        kFilterCutoff,
+        kFilterResonance,
+        kEnvelopeAttack,
+        kEnvelopeDecay,
+        kEnvelopeSustain,
+        kEnvelopeRelease,
+        kLfoRate,
+        kLfoDepth,
+        kLfoWaveform         // *
+    };
+
     AudioTrack();
     ~AudioTrack();
 
@@ -31,11 +60,22 @@ public:
     std::shared_ptr<Synthesizer> getSynthesizer() const;
     void setSynthesizerType(const std::string& type);
     std::string getSynthesizerType() const;
+    void setSynthesizerParameter(ParameterId id, float value);
+    float getSynthesizerParameter(ParameterId id) const;
+    // Namens-Varianten für UI und Scripting; unbekannte Namen werden ignoriert
     void setSynthesizerParameter(const std::string& param, float value);
     float getSynthesizerParameter(const std::string& param) const;
+    static const ParameterRegistry& getSynthesizerParameters();
 
     // Audio-Verarbeitung
     void processBlock(float* output, size_t numSamples);
+    // Audio-Thread: MIDI sample-genau aus dem Block, ohne midiMutex
+    void processBlock(float* output, size_t numSamples, const MIDIBlockEvents& events);
+    // Wie oben, zusätzlich sampelgenaue Automation ab position (Samples ab
+    // Projektstart); ohne Position nur geglättete Volume/Pan-Werte
+    void processBlock(float* output, size_t numSamples, const MIDIBlockEvents& events, int64_t position);
+    // Rampenlänge der Glättung; vor dem Abspielen aufrufen
+    void setSampleRate(float sampleRate);
     void setVolume(float volume);
     float getVolume() const;
     void setPan(float pan);
@@ -45,6 +85,11 @@ public:
     void setSolo(bool solo);
     bool isSolo() const;
 
+    // Kontroll-Thread: die Spur wird kopiert und lockfrei an den
+    // Audio-Thread übergeben. Eine leere Spur schaltet die Automation ab
+    void setAutomation(Parameter parameter, const AutomationLane& lane);
+    void clearAutomation(Parameter parameter);
+
     // Status
     bool isActive() const;
     void setActive(bool active);
@@ -63,8 +108,10 @@ private:
     // Synthesizer-bezogene Member
     std::shared_ptr<Synthesizer> synthesizer;
     std::string synthesizerType;
-    std::map<std::string, float> synthesizerParameters;
-    std::mutex synthMutex;
+    // Gecastet in setSynthesizer, nicht bei jedem Parameter
+    SubtractiveSynthesizer* subtractive;
+    std::vector<float> synthesizerValues; // nach ParameterId
+    mutable std::mutex synthMutex;
 
     // Audio-bezogene Member
     std::atomic<float> volume;
@@ -75,9 +122,21 @@ private:
     std::string name;
     std::mutex audioMutex;
 
+    // Automation: Spuren pro Parameter, Glätter und Cursor gehören dem
+    // Audio-Thread
+    static constexpr size_t kNumParameters = 2;
+    TripleBuffer<AutomationLane> automation[kNumParameters];
+    std::mutex automationMutex; // nur Schreiber
+    AutomationLane::Cursor automationCursors[kNumParameters];
+    ParameterSmoother volumeSmoother;
+    ParameterSmoother panSmoother;
+
     // Hilfsfunktionen
     void updateSynthesizerParameters();
-    void applyAudioProcessing(float* output, size_t numSamples);
+    // Unter synthMutex
+    void applySynthesizerParameter(ParameterId id);
+    // position < 0: ohne Automation
+    void applyAudioProcessing(float* output, size_t numSamples, int64_t position = -1);
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -0,0 +1,428 @@
+#include "AudioWorkerPool.hpp"
+#include "RealtimeGuard.hpp"
+#include <algorithm>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace VR_DAW {
+
+namespace {
+    inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    // Oberstes Bit von activeWorkers: Periode geschlossen, kein Beitritt mehr
+    constexpr uint32_t kPeriodClosed = 1u << 31;
+
+    size_t nextPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AudioTaskGraph
+
+AudioTaskGraph::AudioTaskGraph()
+    : compiled(false)
+{
+}
+
+AudioTaskGraph::~AudioTaskGraph() = default;
+
+AudioTaskGraph::AudioTaskGraph(AudioTaskGraph&& other) noexcept = default;
+AudioTaskGraph& AudioTaskGraph::operator=(AudioTaskGraph&& other) noexcept = default;
+
+uint32_t AudioTaskGraph::addNode(NodeType type, int objectId) {
+    compiled = false;
+    nodes.push_back({type, objectId});
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void AudioTaskGraph::addDependency(uint32_t before, uint32_t after) {
+    if (before >= nodes.size() || after >= nodes.size() || before == after) return;
+    compiled = false;
+    edges.emplace_back(before, after);
+}
+
+void AudioTaskGraph::clear() {
+    nodes.clear();
+    edges.clear();
+    successorOffsets.clear();
+    successors.clear();
+    initialDependencies.clear();
+    roots.clear();
+    topologicalOrder.clear();
+    remainingDependencies.reset();
+    compiled = false;
+}
+
+bool AudioTaskGraph::compile() {
+    const size_t n = nodes.size();
+
+    // Doppelte Kanten entfernen, damit die Zähler stimmen
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    successorOffsets.assign(n + 1, 0);
+    initialDependencies.assign(n, 0);
+    for (const auto& [from, to] : edges) {
+        ++successorOffsets[from + 1];
+        ++initialDependencies[to];
+    }
+    for (size_t i = 0; i < n; ++i) {
+        successorOffsets[i + 1] += successorOffsets[i];
+    }
+
+    successors.assign(edges.size(), 0);
+    std::vector<uint32_t> fill(successorOffsets.begin(), successorOffsets.end() - 1);
+    for (const auto& [from, to] : edges) {
+        successors[fill[from]++] = to;
+    }
+
+    // Kahn-Algorithmus: liefert Wurzeln, Reihenfolge und Zykluserkennung
+    roots.clear();
+    topologicalOrder.clear();
+    topologicalOrder.reserve(n);
+    std::vector<uint32_t> remaining(initialDependencies);
+    for (uint32_t i = 0; i < n; ++i) {
+        if (remaining[i] == 0) {
+            roots.push_back(i);
+            topologicalOrder.push_back(i);
+        }
+    }
+    for (size_t head = 0; head < topologicalOrder.size(); ++head) {
+        const uint32_t node = topologicalOrder[head];
+        for (uint32_t s = successorOffsets[node]; s < successorOffsets[node + 1]; ++s) {
+            if (--remaining[successors[s]] == 0) {
+                topologicalOrder.push_back(successors[s]);
+            }
+        }
+    }
+
+    remainingDependencies.reset(n > 0 ? new std::atomic<uint32_t>[n] : nullptr);
+    compiled = topologicalOrder.size() == n;
+    return compiled;
+}
+
+// ---------------------------------------------------------------------------
+// AudioWorkerPool::WorkQueue
+
+AudioWorkerPool::WorkQueue::WorkQueue(size_t capacity)
+    : items(new std::atomic<uint32_t>[nextPowerOfTwo(std::max<size_t>(capacity, 2))])
+    , mask(static_cast<int64_t>(nextPowerOfTwo(std::max<size_t>(capacity, 2))) - 1)
+    , top(0)
+    , bottom(0)
+{
+}
+
+bool AudioWorkerPool::WorkQueue::push(uint32_t value) {
+    const int64_t b = bottom.load(std::memory_order_relaxed);
+    const int64_t t = top.load(std::memory_order_acquire);
+    if (b - t > mask) return false;
+
+    items[b & mask].store(value, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AudioWorkerPool::WorkQueue::pop(uint32_t& value) {
+    const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    value = items[b & mask].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Letztes Element: gegen Diebe absichern
+        const bool won = top.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+bool AudioWorkerPool::WorkQueue::steal(uint32_t& value) {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) return false;
+
+    value = items[t & mask].load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1,
+        std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+void AudioWorkerPool::WorkQueue::reset() {
+    top.store(0, std::memory_order_relaxed);
+    bottom.store(0, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// AudioWorkerPool
+
+AudioWorkerPool::AudioWorkerPool()
+    : capacity(0)
+    , currentGraph(nullptr)
+    , currentFunction(nullptr)
+    , currentContext(nullptr)
+    , pendingNodes(0)
+    , period(0)
+    , activeWorkers(kPeriodClosed)
+    , running(false)
+    , sleepingWorkers(0)
+    , spinIterations(20000)
+    , realtimePriority(true)
+    , periods(0)
+    , steals(0)
+    , lastPeriodNanoseconds(0)
+    , maxPeriodNanoseconds(0)
+{
+}
+
+AudioWorkerPool::~AudioWorkerPool() {
+    stop();
+}
+
+void AudioWorkerPool::start(size_t numWorkers, size_t maxNodes) {
+    VRDAW_ASSERT_NOT_REALTIME("AudioWorkerPool::start");
+    stop();
+
+    capacity = maxNodes;
+    queues.clear();
+    for (size_t i = 0; i <= numWorkers; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>(capacity));
+    }
+
+    running = true;
+    const uint64_t startPeriod = period.load(std::memory_order_acquire);
+    for (size_t i = 1; i <= numWorkers; ++i) {
+        workers.emplace_back([this, i, startPeriod]() { workerLoop(i, startPeriod); });
+    }
+}
+
+void AudioWorkerPool::stop() {
+    if (!running.exchange(false)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        period.fetch_add(1, std::memory_order_release);
+    }
+    sleepCondition.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+}
+
+bool AudioWorkerPool::isRunning() const {
+    return running;
+}
+
+size_t AudioWorkerPool::getWorkerCount() const {
+    return workers.size();
+}
+
+void AudioWorkerPool::setSpinIterations(uint32_t iterations) {
+    spinIterations = iterations;
+}
+
+void AudioWorkerPool::setRealtimePriority(bool enable) {
+    realtimePriority = enable;
+}
+
+void AudioWorkerPool::execute(AudioTaskGraph& graph, NodeFunction function, void* context) {
+    const size_t numNodes = graph.size();
+    if (numNodes == 0 || !function || !graph.isCompiled()) return;
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // Nur ein Aufrufer darf die Worker gleichzeitig belegen; weitere
+    // Aufrufer (z.B. Buffer-Queue-Threads) rechnen seriell
+    const bool poolBusy = executing.test_and_set(std::memory_order_acquire);
+
+    if (poolBusy || workers.empty() || numNodes > capacity) {
+        executeSerial(graph, function, context);
+    } else {
+        for (size_t i = 0; i < numNodes; ++i) {
+            graph.remainingDependencies[i].store(graph.initialDependencies[i], std::memory_order_relaxed);
+        }
+
+        // Zwischen zwei Perioden greift kein Worker auf die Queues zu,
+        // daher darf der Audio-Thread die Wurzeln direkt verteilen.
+        for (auto& queue : queues) {
+            queue->reset();
+        }
+        const auto& roots = graph.getRoots();
+        for (size_t i = 0; i < roots.size(); ++i) {
+            queues[i % queues.size()]->push(roots[i]);
+        }
+
+        currentGraph = &graph;
+        currentFunction = function;
+        currentContext = context;
+        pendingNodes.store(static_cast<int64_t>(numNodes), std::memory_order_relaxed);
+        // Periode öffnen: Worker treten erst beim Aufwachen bei
+        activeWorkers.store(0, std::memory_order_release);
+        period.fetch_add(1, std::memory_order_release);
+
+        if (sleepingWorkers.load(std::memory_order_acquire) > 0) {
+            sleepCondition.notify_all();
+        }
+
+        runUntilDone(0);
+
+        // Join: Periode schließen und nur auf die beigetretenen Worker warten.
+        // Die finden pendingNodes == 0 vor und steigen sofort aus; wer noch
+        // schläft oder zu spät aufwacht, wird nicht abgewartet
+        activeWorkers.fetch_or(kPeriodClosed, std::memory_order_acq_rel);
+        while ((activeWorkers.load(std::memory_order_acquire) & ~kPeriodClosed) > 0) {
+            cpuRelax();
+        }
+
+        currentGraph = nullptr;
+    }
+
+    if (!poolBusy) {
+        executing.clear(std::memory_order_release);
+    }
+
+    const uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count());
+    lastPeriodNanoseconds.store(elapsed, std::memory_order_relaxed);
+    if (elapsed > maxPeriodNanoseconds.load(std::memory_order_relaxed)) {
+        maxPeriodNanoseconds.store(elapsed, std::memory_order_relaxed);
+    }
+    periods.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioWorkerPool::executeSerial(AudioTaskGraph& graph, NodeFunction function, void* context) {
+    for (uint32_t node : graph.getTopologicalOrder()) {
+        function(context, node);
+    }
+}
+
+AudioWorkerPool::Statistics AudioWorkerPool::getStatistics() const {
+    Statistics stats;
+    stats.periods = periods.load(std::memory_order_relaxed);
+    stats.steals = steals.load(std::memory_order_relaxed);
+    stats.lastPeriodNanoseconds = lastPeriodNanoseconds.load(std::memory_order_relaxed);
+    stats.maxPeriodNanoseconds = maxPeriodNanoseconds.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AudioWorkerPool::workerLoop(size_t workerIndex, uint64_t startPeriod) {
+#if defined(__linux__) || defined(__APPLE__)
+    if (realtimePriority) {
+        // Best effort: ohne Rechte bleibt die normale Priorität
+        sched_param param{};
+        param.sched_priority = std::max(1, sched_get_priority_max(SCHED_FIFO) - 2);
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+#endif
+
+    uint64_t seenPeriod = startPeriod;
+
+    while (true) {
+        // Erst spinnen, dann schlafen
+        uint32_t spins = 0;
+        while (period.load(std::memory_order_acquire) == seenPeriod && spins < spinIterations) {
+            cpuRelax();
+            ++spins;
+        }
+        if (period.load(std::memory_order_acquire) == seenPeriod) {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepingWorkers.fetch_add(1, std::memory_order_acq_rel);
+            while (period.load(std::memory_order_acquire) == seenPeriod) {
+                // Timeout fängt ein verlorenes notify ohne Lock ab
+                sleepCondition.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            sleepingWorkers.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        seenPeriod = period.load(std::memory_order_acquire);
+        if (!running) break;
+
+        // Beitreten, solange der Audio-Thread die Periode nicht geschlossen hat
+        uint32_t state = activeWorkers.load(std::memory_order_acquire);
+        bool joined = false;
+        while ((state & kPeriodClosed) == 0) {
+            if (activeWorkers.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)) {
+                joined = true;
+                break;
+            }
+        }
+        if (!joined) continue;
+
+        {
+            RealtimeGuard::ScopedAudioThread audioThread;
+            runUntilDone(workerIndex);
+        }
+        activeWorkers.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void AudioWorkerPool::runUntilDone(size_t workerIndex) {
+    WorkQueue& own = *queues[workerIndex];
+    while (pendingNodes.load(std::memory_order_acquire) > 0) {
+        uint32_t node;
+        if (own.pop(node) || trySteal(workerIndex, node)) {
+            runNode(node, workerIndex);
+        } else {
+            cpuRelax();
+        }
+    }
+}
+
+void AudioWorkerPool::runNode(uint32_t node, size_t workerIndex) {
+    AudioTaskGraph& graph = *currentGraph;
+    currentFunction(currentContext, node);
+
+    // Nachfolger freischalten, sobald ihre letzte Abhängigkeit fertig ist
+    for (uint32_t s = graph.successorOffsets[node]; s < graph.successorOffsets[node + 1]; ++s) {
+        const uint32_t successor = graph.successors[s];
+        if (graph.remainingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            queues[workerIndex]->push(successor);
+        }
+    }
+    pendingNodes.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool AudioWorkerPool::trySteal(size_t thiefIndex, uint32_t& node) {
+    const size_t numQueues = queues.size();
+    for (size_t offset = 1; offset < numQueues; ++offset) {
+        if (queues[(thiefIndex + offset) % numQueues]->steal(node)) {
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VR_DAW {
+
+// Abhängigkeitsgraph einer Audio-Periode (Tracks, Busse, Sends).
+// Wird im Kontroll-Thread aufgebaut und kompiliert; pro Periode werden
+// nur noch die atomaren Zähler zurückgesetzt.
+class AudioTaskGraph {
+public:
+    enum class NodeType {
+        Track,
+        Bus,
+        Send,
+        Master
+    };
+
+    struct Node {
+        NodeType type;
+        int objectId;
+    };
+
+    AudioTaskGraph();
+    ~AudioTaskGraph();
+
+    AudioTaskGraph(AudioTaskGraph&& other) noexcept;
+    AudioTaskGraph& operator=(AudioTaskGraph&& other) noexcept;
+
+    uint32_t addNode(NodeType type, int objectId);
+    // 'before' muss vollständig verarbeitet sein, bevor 'after' startet
+    void addDependency(uint32_t before, uint32_t after);
+    void clear();
+
+    // Baut die Nachfolgerlisten auf; false bei Zyklen
+    bool compile();
+    bool isCompiled() const { return compiled; }
+
+    size_t size() const { return nodes.size(); }
+    const Node& getNode(uint32_t index) const { return nodes[index]; }
+    const std::vector<uint32_t>& getRoots() const { return roots; }
+    const std::vector<uint32_t>& getTopologicalOrder() const { return topologicalOrder; }
+
+private:
+    friend class AudioWorkerPool;
+
+    std::vector<Node> nodes;
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+
+    // Kompilierte Form (CSR)
+    std::vector<uint32_t> successorOffsets;
+    std::vector<uint32_t> successors;
+    std::vector<uint32_t> initialDependencies;
+    std::vector<uint32_t> roots;
+    std::vector<uint32_t> topologicalOrder;
+    std::unique_ptr<std::atomic<uint32_t>[]> remainingDependencies;
+    bool compiled;
+};
+
+// Persistenter Work-Stealing-Pool für den Audio-Thread. Der aufrufende
+// Audio-Thread arbeitet selbst als Worker 0 mit und kehrt erst zurück,
+// wenn alle Knoten des Graphen verarbeitet sind. execute() lockt und
+// alloziert nicht.
+class AudioWorkerPool {
+public:
+    using NodeFunction = void (*)(void* context, uint32_t nodeIndex);
+
+    struct Statistics {
+        uint64_t periods;
+        uint64_t steals;
+        uint64_t lastPeriodNanoseconds;
+        uint64_t maxPeriodNanoseconds;
+    };
+
+    AudioWorkerPool();
+    ~AudioWorkerPool();
+
+    AudioWorkerPool(const AudioWorkerPool&) = delete;
+    AudioWorkerPool& operator=(const AudioWorkerPool&) = delete;
+
+    // Kontroll-Thread
+    void start(size_t numWorkers, size_t maxNodes = 4096);
+    void stop();
+    bool isRunning() const;
+    size_t getWorkerCount() const;
+    void setSpinIterations(uint32_t iterations);
+    void setRealtimePriority(bool enable);
+
+    // Audio-Thread
+    void execute(AudioTaskGraph& graph, NodeFunction function, void* context);
+
+    template<typename Fn>
+    void execute(AudioTaskGraph& graph, Fn& fn) {
+        execute(graph, [](void* ctx, uint32_t node) { (*static_cast<Fn*>(ctx))(node); }, &fn);
+    }
+
+    Statistics getStatistics() const;
+
+private:
+    // Chase-Lev-Deque mit fester Kapazität
+    class WorkQueue {
+    public:
+        explicit WorkQueue(size_t capacity);
+        bool push(uint32_t value);
+        bool pop(uint32_t& value);
+        bool steal(uint32_t& value);
+        void reset();
+
+    private:
+        std::unique_ptr<std::atomic<uint32_t>[]> items;
+        int64_t mask;
+        alignas(64) std::atomic<int64_t> top;
+        alignas(64) std::atomic<int64_t> bottom;
+    };
+
+    void workerLoop(size_t workerIndex, uint64_t startPeriod);
+    void runUntilDone(size_t workerIndex);
+    void runNode(uint32_t node, size_t workerIndex);
+    bool trySteal(size_t thiefIndex, uint32_t& node);
+    void executeSerial(AudioTaskGraph& graph, NodeFunction function, void* context);
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues; // Index 0 = Audio-Thread
+    size_t capacity;
+
+    // Zustand der laufenden Periode
+    AudioTaskGraph* currentGraph;
+    NodeFunction currentFunction;
+    void* currentContext;
+    alignas(64) std::atomic<int64_t> pendingNodes;
+    alignas(64) std::atomic<uint64_t> period;
+    // Beigetretene Worker der laufenden Periode, plus Bit für 'geschlossen'
+    alignas(64) std::atomic<uint32_t> activeWorkers;
+    std::atomic<bool> running;
+    std::atomic_flag executing = ATOMIC_FLAG_INIT;
+
+    // Schlafende Worker werden per notify geweckt (ohne Lock im Audio-Thread)
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    std::atomic<uint32_t> sleepingWorkers;
+    uint32_t spinIterations;
+    bool realtimePriority;
+
+    std::atomic<uint64_t> periods;
+    std::atomic<uint64_t> steals;
+    std::atomic<uint64_t> lastPeriodNanoseconds;
+    std::atomic<uint64_t> maxPeriodNanoseconds;
+};
+
+} // namespace VR_DAW
@@ -1,23 +1,247 @@
 #include "Automation.hpp"
-#include <vector>
-#include <string>
+#include "Effects.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace VR_DAW {
 
+// ---------------------------------------------------------------------------
+// ParameterSmoother
+
+ParameterSmoother::ParameterSmoother(float initial)
+    : current(initial)
+    , target(initial)
+    , step(0.0f)
+    , remaining(0)
+    , rampSamples(static_cast<size_t>(kDefaultRampTime * 44100.0f))
+{
+}
+
+void ParameterSmoother::prepare(float sampleRate, float rampSeconds) {
+    rampSamples = static_cast<size_t>(std::lround(std::max(0.0f, rampSeconds) * sampleRate));
+    if (remaining > rampSamples) {
+        // Laufende Rampe in der neuen Länge zu Ende führen
+        remaining = rampSamples;
+        step = remaining > 0 ? (target - current) / static_cast<float>(remaining) : 0.0f;
+        if (remaining == 0) current = target;
+    }
+}
+
+void ParameterSmoother::setTarget(float value) {
+    if (value == target) return;
+    target = value;
+    if (rampSamples == 0) {
+        snap(value);
+        return;
+    }
+    step = (target - current) / static_cast<float>(rampSamples);
+    remaining = rampSamples;
+}
+
+void ParameterSmoother::snap(float value) {
+    current = value;
+    target = value;
+    step = 0.0f;
+    remaining = 0;
+}
+
+ParameterRamp ParameterSmoother::next(size_t numFrames) {
+    const float start = current;
+    if (remaining > 0) {
+        const size_t frames = std::min(numFrames, remaining);
+        remaining -= frames;
+        current = remaining > 0 ? current + step * static_cast<float>(frames) : target;
+    }
+    return {start, current, numFrames};
+}
+
+// ---------------------------------------------------------------------------
+// AutomationLane
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+// Wert zwischen a und b; t in [0, 1]
+float interpolate(const AutomationPoint& a, const AutomationPoint& b, double t) {
+    switch (a.curve) {
+        case AutomationCurve::Step:
+            return a.value;
+        case AutomationCurve::Exponential:
+            if (a.value * b.value > 0.0f) {
+                return a.value * static_cast<float>(std::pow(static_cast<double>(b.value) / a.value, t));
+            }
+            break;
+        case AutomationCurve::SCurve:
+            t = 0.5 - 0.5 * std::cos(kPi * t);
+            break;
+        case AutomationCurve::Linear:
+            break;
+    }
+    return a.value + static_cast<float>(t) * (b.value - a.value);
+}
+
+} // namespace
+
+void AutomationLane::addPoint(int64_t position, float value, AutomationCurve curve) {
+    auto it = std::lower_bound(points.begin(), points.end(), position,
+                               [](const AutomationPoint& point, int64_t p) { return point.position < p; });
+    if (it != points.end() && it->position == position) {
+        it->value = value;
+        it->curve = curve;
+    } else {
+        points.insert(it, AutomationPoint{position, value, curve});
+    }
+    ++version;
+}
+
+bool AutomationLane::removePoint(int64_t position) {
+    auto it = std::lower_bound(points.begin(), points.end(), position,
+                               [](const AutomationPoint& point, int64_t p) { return point.position < p; });
+    if (it == points.end() || it->position != position) return false;
+    points.erase(it);
+    ++version;
+    return true;
+}
+
+void AutomationLane::clear() {
+    points.clear();
+    ++version;
+}
+
+// Segment s liegt zwischen points[s - 1] und points[s]; 0 ist vor dem
+// ersten, points.size() nach dem letzten Punkt
+size_t AutomationLane::findSegment(int64_t position) const {
+    auto it = std::upper_bound(points.begin(), points.end(), position,
+                               [](int64_t p, const AutomationPoint& point) { return p < point.position; });
+    return static_cast<size_t>(it - points.begin());
+}
+
+size_t AutomationLane::findSegment(int64_t position, Cursor& cursor) const {
+    const size_t count = points.size();
+    size_t segment = cursor.segment;
+    if (cursor.version == version && segment <= count
+        && (segment == 0 || points[segment - 1].position <= position)) {
+        // Vorwärts: höchstens ein paar Punkte überspringen, sonst suchen
+        for (int hops = 0; hops < 4; ++hops) {
+            if (segment == count || position < points[segment].position) {
+                cursor.segment = segment;
+                return segment;
+            }
+            ++segment;
+        }
+    }
+    cursor.version = version;
+    cursor.segment = findSegment(position);
+    return cursor.segment;
+}
+
+float AutomationLane::valueInSegment(size_t segment, int64_t position) const {
+    if (segment == 0) return points.front().value;
+    if (segment == points.size()) return points.back().value;
+    const AutomationPoint& a = points[segment - 1];
+    const AutomationPoint& b = points[segment];
+    const double t = static_cast<double>(position - a.position) / static_cast<double>(b.position - a.position);
+    return interpolate(a, b, t);
+}
+
+float AutomationLane::getValue(int64_t position) const {
+    if (points.empty()) return 0.0f;
+    return valueInSegment(findSegment(position), position);
+}
+
+float AutomationLane::getValue(int64_t position, Cursor& cursor) const {
+    if (points.empty()) return 0.0f;
+    return valueInSegment(findSegment(position, cursor), position);
+}
+
+ParameterRamp AutomationLane::nextRamp(int64_t position, size_t maxFrames, Cursor& cursor) const {
+    if (points.empty()) return {0.0f, 0.0f, maxFrames};
+
+    const size_t segment = findSegment(position, cursor);
+    if (segment == points.size()) {
+        const float value = points.back().value;
+        return {value, value, maxFrames};
+    }
+    if (segment == 0) {
+        const float value = points.front().value;
+        const size_t untilFirst = static_cast<size_t>(points.front().position - position);
+        return {value, value, std::min(maxFrames, untilFirst)};
+    }
+
+    const AutomationPoint& a = points[segment - 1];
+    const AutomationPoint& b = points[segment];
+    size_t length = std::min(maxFrames, static_cast<size_t>(b.position - position));
+    if (a.curve == AutomationCurve::Step) return {a.value, a.value, length};
+    if (a.curve != AutomationCurve::Linear) length = std::min(length, kMaxRampLength);
+
+    // Das Ende ist der Wert am ersten Sample des nächsten Stücks, damit
+    // aneinandergereihte Rampen stetig bleiben
+    const double span = static_cast<double>(b.position - a.position);
+    const float start = interpolate(a, b, static_cast<double>(position - a.position) / span);
+    const float end = interpolate(a, b, static_cast<double>(position + static_cast<int64_t>(length) - a.position) / span);
+    return {start, end, length};
+}
+
+// ---------------------------------------------------------------------------
+// Automation
+
 Automation::Automation() = default;
 Automation::~Automation() = default;
 
-void Automation::initialize() {}
-void Automation::shutdown() {}
+void Automation::initialize() {
+    position = 0;
+}
+
+void Automation::shutdown() {
+    lanes.clear();
+}
+
 void Automation::processBlock(std::vector<float>& buffer) {
-    // Dummy: keine echte Verarbeitung
+    advance(buffer.size() / 2);
 }
+
 void Automation::setParameter(const std::string& name, float value) {
     if (name == "automationValue") automationValue = value;
 }
+
 float Automation::getParameter(const std::string& name) const {
     if (name == "automationValue") return automationValue;
+    auto it = lanes.find(name);
+    if (it != lanes.end() && !it->second.lane.empty()) return it->second.lane.getValue(position);
     return 0.0f;
 }
 
-} // namespace VR_DAW 
\ No newline at end of file
+AutomationLane& Automation::getLane(const std::string& parameter) {
+    return lanes[parameter].lane;
+}
+
+void Automation::removeLane(const std::string& parameter) {
+    lanes.erase(parameter);
+}
+
+bool Automation::hasLane(const std::string& parameter) const {
+    return lanes.count(parameter) > 0;
+}
+
+void Automation::setPosition(int64_t newPosition) {
+    position = newPosition;
+}
+
+void Automation::apply(Effects& effect) {
+    for (auto& entry : lanes) {
+        Binding& binding = entry.second;
+        if (binding.lane.empty()) continue;
+        if (binding.resolved != &effect) {
+            binding.id = effect.getParameterId(entry.first);
+            binding.resolved = &effect;
+        }
+        effect.automateParameter(binding.id, binding.lane.getValue(position, binding.cursor));
+    }
+}
+
+void Automation::advance(size_t numFrames) {
+    position += static_cast<int64_t>(numFrames);
+}
+
+} // namespace VR_DAW
@@ -1,10 +1,118 @@
 #pragma once
 
-#include <vector>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "ParameterRegistry.hpp"
 
 namespace VR_DAW {
 
+class Effects;
+
+// Linearer Verlauf über length Frames: Sample i bekommt
+// start + (end - start) * i / length, wie dsp::applyGainRamp
+struct ParameterRamp {
+    float start;
+    float end;
+    size_t length;
+};
+
+// Glättet Sprünge eines Parameters linear über eine feste Zeit. Nur vom
+// Audio-Thread benutzen: der Besitzer liest seinen Zielwert einmal pro
+// Block, setTarget() und next() liefern den Verlauf für die SIMD-Kernels.
+// Endet die Rampe mitten im Block, wird sie bis zum Blockende gestreckt
+class ParameterSmoother {
+public:
+    static constexpr float kDefaultRampTime = 0.02f; // Sekunden
+
+    explicit ParameterSmoother(float initial = 0.0f);
+
+    void prepare(float sampleRate, float rampSeconds = kDefaultRampTime);
+    // Neue Rampe ab dem aktuellen Wert; gleicher Zielwert ist ein No-op
+    void setTarget(float target);
+    // Springt ohne Rampe (Initialisierung, Transport-Sprung)
+    void snap(float value);
+
+    ParameterRamp next(size_t numFrames);
+    float getCurrent() const { return current; }
+    float getTarget() const { return target; }
+    bool isSmoothing() const { return remaining > 0; }
+
+private:
+    float current;
+    float target;
+    float step;
+    size_t remaining;
+    size_t rampSamples;
+};
+
+enum class AutomationCurve : uint8_t {
+    Linear,
+    // Gleichmäßig im Verhältnis (z.B. Frequenzen); bei Vorzeichenwechsel
+    // oder 0 linear
+    Exponential,
+    // Hält den Wert bis zum nächsten Punkt
+    Step,
+    // Weicher Cosinus-Übergang
+    SCurve
+};
+
+struct AutomationPoint {
+    int64_t position;   // Samples ab Projektstart
+    float value;
+    AutomationCurve curve = AutomationCurve::Linear; // Verlauf bis zum nächsten Punkt
+};
+
+// Automationsspur aus Stützpunkten. Vor dem ersten und nach dem letzten
+// Punkt gilt dessen Wert. Bearbeiten alloziert; Auswerten nicht, damit
+// eine Kopie (z.B. über TripleBuffer) im Audio-Thread gelesen werden kann.
+class AutomationLane {
+public:
+    // Lesezustand des Audio-Threads: merkt sich das letzte Segment, damit
+    // lineares Abspielen ohne Suche auskommt
+    struct Cursor {
+        size_t segment = 0;
+        uint64_t version = ~uint64_t(0);
+    };
+
+    // Gekrümmte Segmente werden in lineare Stücke dieser Länge zerlegt
+    static constexpr size_t kMaxRampLength = 64;
+
+    // Ersetzt einen Punkt an derselben Position
+    void addPoint(int64_t position, float value, AutomationCurve curve = AutomationCurve::Linear);
+    bool removePoint(int64_t position);
+    void clear();
+
+    const std::vector<AutomationPoint>& getPoints() const { return points; }
+    bool empty() const { return points.empty(); }
+    // Ändert sich mit jeder Bearbeitung; ungültig gewordene Cursor suchen neu
+    uint64_t getVersion() const { return version; }
+
+    // Binäre Suche, O(log n)
+    float getValue(int64_t position) const;
+    // Mit Cursor: O(1) beim Vorwärtslaufen, sonst O(log n)
+    float getValue(int64_t position, Cursor& cursor) const;
+
+    // Nächstes lineares Stück ab position, höchstens maxFrames lang. Endet
+    // an Stützpunkten, damit Knicke und Sprünge sampelgenau liegen:
+    //   for (done = 0; done < n; done += ramp.length)
+    //       ramp = lane.nextRamp(position + done, n - done, cursor);
+    ParameterRamp nextRamp(int64_t position, size_t maxFrames, Cursor& cursor) const;
+
+private:
+    std::vector<AutomationPoint> points;
+    uint64_t version = 0;
+
+    // Anzahl der Punkte <= position (Segment-Index)
+    size_t findSegment(int64_t position) const;
+    size_t findSegment(int64_t position, Cursor& cursor) const;
+    float valueInSegment(size_t segment, int64_t position) const;
+};
+
+// Automation nach Parametername, z.B. für Effekt-Parameter. Die Werte
+// werden pro Block gesetzt, Effekte glätten Sprünge selbst
 class Automation {
 public:
     Automation();
@@ -12,12 +120,34 @@ public:
 
     void initialize();
     void shutdown();
+    // Rückt um einen interleavten Stereo-Block vor
     void processBlock(std::vector<float>& buffer);
     void setParameter(const std::string& name, float value);
     float getParameter(const std::string& name) const;
 
+    AutomationLane& getLane(const std::string& parameter);
+    void removeLane(const std::string& parameter);
+    bool hasLane(const std::string& parameter) const;
+
+    void setPosition(int64_t position);
+    int64_t getPosition() const { return position; }
+    // Setzt alle automatisierten Parameter des Effekts auf ihren Wert an
+    // der aktuellen Position (Audio-Thread); advance() rückt danach einmal
+    // pro Block vor. Die Namen werden einmal je Effekt in IDs aufgelöst
+    void apply(Effects& effect);
+    void advance(size_t numFrames);
+
 private:
+    struct Binding {
+        AutomationLane lane;
+        AutomationLane::Cursor cursor;
+        const Effects* resolved = nullptr;
+        ParameterId id = kInvalidParameterId;
+    };
+
     float automationValue = 0.0f;
+    int64_t position = 0;
+    std::unordered_map<std::string, Binding> lanes;
 };
 
-} // namespace VR_DAW 
\ No newline at end of file
+} // namespace VR_DAW
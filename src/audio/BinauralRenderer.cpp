@@ -0,0 +1,228 @@
+#include "BinauralRenderer.hpp"
+#include "../dsp/FFT.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace VR_DAW {
+
+namespace {
+
+constexpr size_t kEars = 2;
+
+} // namespace
+
+struct BinauralRenderer::Impl {
+    struct Slot {
+        bool active = false;
+        // Nach dem Verstummen noch ein Block für den Nachhall der HRIR
+        bool draining = false;
+        // Erster Block nach resetSource: Filter ohne Überblendung übernehmen
+        bool fresh = true;
+        size_t filter = 0;
+        float gain = 0.0f;
+    };
+
+    std::shared_ptr<const HRTFSet> hrtf;
+    size_t blockSize;
+    size_t numBins;
+    dsp::RealFFT fft;
+
+    std::vector<Slot> slots;
+    // [Slot][2 * blockSize]: vorheriger + aktueller Block (Overlap-Save)
+    std::vector<float> frames;
+    size_t fifoPosition = 0;
+
+    std::vector<float> sourceRe, sourceIm;
+    // Je Ohr: unveränderte Quellen, alte und neue Filter überblendender Quellen
+    std::vector<float> steadyRe[kEars], steadyIm[kEars];
+    std::vector<float> fadeOutRe[kEars], fadeOutIm[kEars];
+    std::vector<float> fadeInRe[kEars], fadeInIm[kEars];
+    std::vector<float> time;
+    std::vector<float> output[kEars];
+    std::vector<float> fadeRamp;
+
+    Impl(std::shared_ptr<const HRTFSet> set, size_t maxSources)
+        : hrtf(std::move(set))
+        , blockSize(hrtf->getBlockSize())
+        , numBins(hrtf->getNumBins())
+        , fft(blockSize * 2)
+        , slots(maxSources)
+        , frames(maxSources * blockSize * 2, 0.0f)
+        , sourceRe(numBins)
+        , sourceIm(numBins)
+        , time(blockSize * 2)
+        , fadeRamp(blockSize)
+    {
+        for (size_t ear = 0; ear < kEars; ++ear) {
+            for (auto* spectrum : {&steadyRe[ear], &steadyIm[ear], &fadeOutRe[ear],
+                                   &fadeOutIm[ear], &fadeInRe[ear], &fadeInIm[ear]}) {
+                spectrum->assign(numBins, 0.0f);
+            }
+            output[ear].assign(blockSize, 0.0f);
+        }
+        for (size_t i = 0; i < blockSize; ++i) {
+            fadeRamp[i] = static_cast<float>(i + 1) / static_cast<float>(blockSize);
+        }
+    }
+
+    float* frame(size_t slot) { return &frames[slot * blockSize * 2]; }
+
+    void accumulate(std::vector<float>* re, std::vector<float>* im, size_t filter, float gain) {
+        for (size_t ear = 0; ear < kEars; ++ear) {
+            dsp::complexMultiplyAccumulate(re[ear].data(), im[ear].data(),
+                sourceRe.data(), sourceIm.data(),
+                hrtf->getSpectrumRe(filter, ear), hrtf->getSpectrumIm(filter, ear),
+                numBins, gain);
+        }
+    }
+
+    static void clear(std::vector<float>* spectra) {
+        for (size_t ear = 0; ear < kEars; ++ear) {
+            std::fill(spectra[ear].begin(), spectra[ear].end(), 0.0f);
+        }
+    }
+
+    // Ein Block: Slot-Rahmen -> output
+    void step(const SourceState* states, size_t numSources) {
+        clear(steadyRe);
+        clear(steadyIm);
+        bool fading = false;
+
+        for (size_t i = 0; i < numSources; ++i) {
+            Slot& slot = slots[i];
+            if (!slot.active) continue;
+
+            float* data = frame(i);
+            fft.forward(data, sourceRe.data(), sourceIm.data());
+            std::memcpy(data, data + blockSize, blockSize * sizeof(float));
+
+            const SourceState& state = states[i];
+            const size_t filter = state.spatial ? hrtf->findNearest(state.x, state.y, state.z)
+                                                : hrtf->getBypassIndex();
+            if (slot.fresh) {
+                slot.filter = filter;
+                slot.gain = state.gain;
+                slot.fresh = false;
+            }
+
+            if (filter == slot.filter && state.gain == slot.gain) {
+                accumulate(steadyRe, steadyIm, filter, state.gain);
+            } else {
+                if (!fading) {
+                    clear(fadeOutRe);
+                    clear(fadeOutIm);
+                    clear(fadeInRe);
+                    clear(fadeInIm);
+                    fading = true;
+                }
+                accumulate(fadeOutRe, fadeOutIm, slot.filter, slot.gain);
+                accumulate(fadeInRe, fadeInIm, filter, state.gain);
+                slot.filter = filter;
+                slot.gain = state.gain;
+            }
+
+            if (slot.draining) {
+                slot.active = false;
+                slot.draining = false;
+            }
+        }
+
+        // Gültig ist jeweils die zweite Hälfte der inversen Transformation
+        for (size_t ear = 0; ear < kEars; ++ear) {
+            float* out = output[ear].data();
+            fft.inverse(steadyRe[ear].data(), steadyIm[ear].data(), time.data());
+            std::memcpy(out, time.data() + blockSize, blockSize * sizeof(float));
+            if (!fading) continue;
+
+            fft.inverse(fadeOutRe[ear].data(), fadeOutIm[ear].data(), time.data());
+            for (size_t n = 0; n < blockSize; ++n) {
+                out[n] += (1.0f - fadeRamp[n]) * time[blockSize + n];
+            }
+            fft.inverse(fadeInRe[ear].data(), fadeInIm[ear].data(), time.data());
+            for (size_t n = 0; n < blockSize; ++n) {
+                out[n] += fadeRamp[n] * time[blockSize + n];
+            }
+        }
+    }
+};
+
+BinauralRenderer::BinauralRenderer(std::shared_ptr<const HRTFSet> hrtf, size_t maxSources)
+    : pImpl(std::make_unique<Impl>(std::move(hrtf), maxSources))
+{
+}
+
+BinauralRenderer::~BinauralRenderer() = default;
+
+void BinauralRenderer::process(const float* const* inputs, const SourceState* states, size_t numSources,
+                               float* outLeft, float* outRight, size_t numFrames) {
+    Impl& impl = *pImpl;
+    numSources = std::min(numSources, impl.slots.size());
+
+    size_t done = 0;
+    while (done < numFrames) {
+        const size_t chunk = std::min(numFrames - done, impl.blockSize - impl.fifoPosition);
+
+        for (size_t i = 0; i < numSources; ++i) {
+            Impl::Slot& slot = impl.slots[i];
+            float* destination = impl.frame(i) + impl.blockSize + impl.fifoPosition;
+            if (inputs[i]) {
+                if (!slot.active) {
+                    // Wieder aktiv: Rahmen vor der aktuellen Position leeren,
+                    // alter Filter ist ohne Nachhall bedeutungslos
+                    std::fill(impl.frame(i), destination, 0.0f);
+                    slot.fresh = true;
+                }
+                slot.active = true;
+                slot.draining = false;
+                std::memcpy(destination, inputs[i] + done, chunk * sizeof(float));
+            } else if (slot.active) {
+                slot.draining = true;
+                std::fill(destination, destination + chunk, 0.0f);
+            }
+        }
+        std::memcpy(outLeft + done, impl.output[0].data() + impl.fifoPosition, chunk * sizeof(float));
+        std::memcpy(outRight + done, impl.output[1].data() + impl.fifoPosition, chunk * sizeof(float));
+        impl.fifoPosition += chunk;
+        done += chunk;
+
+        if (impl.fifoPosition == impl.blockSize) {
+            impl.step(states, numSources);
+            impl.fifoPosition = 0;
+        }
+    }
+}
+
+void BinauralRenderer::resetSource(size_t slot) {
+    Impl& impl = *pImpl;
+    if (slot >= impl.slots.size()) return;
+    impl.slots[slot] = Impl::Slot();
+    std::fill(impl.frame(slot), impl.frame(slot) + impl.blockSize * 2, 0.0f);
+}
+
+void BinauralRenderer::reset() {
+    Impl& impl = *pImpl;
+    std::fill(impl.slots.begin(), impl.slots.end(), Impl::Slot());
+    std::fill(impl.frames.begin(), impl.frames.end(), 0.0f);
+    for (auto& output : impl.output) std::fill(output.begin(), output.end(), 0.0f);
+    impl.fifoPosition = 0;
+}
+
+size_t BinauralRenderer::getMaxSources() const {
+    return pImpl->slots.size();
+}
+
+size_t BinauralRenderer::getActiveSources() const {
+    return static_cast<size_t>(std::count_if(pImpl->slots.begin(), pImpl->slots.end(),
+                                             [](const Impl::Slot& slot) { return slot.active; }));
+}
+
+size_t BinauralRenderer::getLatency() const {
+    return pImpl->blockSize;
+}
+
+const std::shared_ptr<const HRTFSet>& BinauralRenderer::getHRTF() const {
+    return pImpl->hrtf;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include "HRTFSet.hpp"
+
+namespace VR_DAW {
+
+// Binauraler Renderer für viele Mono-Quellen. Jede Quelle wird einmal pro
+// Block transformiert und mit dem HRTF-Paar ihrer Richtung multipliziert;
+// die Produkte aller Quellen werden im Frequenzbereich summiert, sodass
+// pro Block und Ohr nur eine inverse FFT anfällt (drei, wenn Quellen
+// überblenden). Ändert sich Richtung oder Pegel einer Quelle, wird über
+// den Block vom alten zum neuen Filter linear übergeblendet.
+//
+// Slots sind fest vorallokiert; process() alloziert nicht und ist für den
+// Audio-Thread geeignet. Latenz: eine Blockgröße des HRTF-Satzes.
+class BinauralRenderer {
+public:
+    struct SourceState {
+        // Richtung im Hörerraum (+x rechts, +y oben, -z vorne), nicht normiert
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = -1.0f;
+        float gain = 1.0f;
+        // false: ohne HRTF auf beide Ohren (Musik, Sprache aus dem Off)
+        bool spatial = true;
+    };
+
+    BinauralRenderer(std::shared_ptr<const HRTFSet> hrtf, size_t maxSources);
+    ~BinauralRenderer();
+
+    BinauralRenderer(const BinauralRenderer&) = delete;
+    BinauralRenderer& operator=(const BinauralRenderer&) = delete;
+
+    // inputs[i]/states[i] gehören zu Slot i (i < numSources <= maxSources).
+    // inputs[i] == nullptr: Slot stumm; sein Nachhall wird noch einen Block
+    // ausgegeben, danach kostet er nichts. Ausgabe wird überschrieben
+    void process(const float* const* inputs, const SourceState* states, size_t numSources,
+                 float* outLeft, float* outRight, size_t numFrames);
+
+    // Slot neu belegt: Verlauf verwerfen, nächster Block ohne Überblendung
+    void resetSource(size_t slot);
+    void reset();
+
+    size_t getMaxSources() const;
+    size_t getActiveSources() const;
+    size_t getLatency() const;
+    const std::shared_ptr<const HRTFSet>& getHRTF() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,439 @@
+#include "ConvolutionEngine.hpp"
+#include "../dsp/FFT.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace VR_DAW {
+
+namespace {
+
+constexpr size_t kEngineChannels = 2;
+
+size_t divideRoundingUp(size_t value, size_t divisor) {
+    return (value + divisor - 1) / divisor;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ConvolutionIR
+
+std::shared_ptr<const ConvolutionIR> ConvolutionIR::create(const std::vector<std::vector<float>>& channels,
+                                                           size_t blockSize) {
+    if (channels.empty()) {
+        throw std::invalid_argument("Impulsantwort ohne Kanäle");
+    }
+    if (blockSize < 2 || (blockSize & (blockSize - 1)) != 0) {
+        throw std::invalid_argument("Faltungs-Blockgröße muss eine Zweierpotenz sein");
+    }
+
+    std::shared_ptr<ConvolutionIR> ir(new ConvolutionIR());
+    ir->numChannels = std::min(channels.size(), kEngineChannels);
+    for (size_t c = 0; c < ir->numChannels; ++c) {
+        ir->length = std::max(ir->length, channels[c].size());
+    }
+    ir->length = std::max<size_t>(ir->length, 1);
+
+    // Kopf deckt [0, tailBlock) ab, der Rest beginnt genau dort. Damit ist
+    // das Ergebnis eines großen Blocks fertig, bevor es gebraucht wird
+    const size_t tailBlock = blockSize * kTailRatio;
+    ir->head.blockSize = blockSize;
+    ir->head.partitions = std::min(kTailRatio, divideRoundingUp(ir->length, blockSize));
+    ir->tail.blockSize = tailBlock;
+    ir->tail.partitions = ir->length > tailBlock ? divideRoundingUp(ir->length - tailBlock, tailBlock) : 0;
+
+    auto buildStage = [&](Stage& stage, size_t offset) {
+        stage.numBins = stage.blockSize + 1;
+        stage.re.assign(ir->numChannels * stage.partitions * stage.numBins, 0.0f);
+        stage.im.assign(stage.re.size(), 0.0f);
+        if (stage.partitions == 0) return;
+
+        dsp::RealFFT fft(stage.blockSize * 2);
+        const float scale = 1.0f / static_cast<float>(stage.blockSize * 2);
+        std::vector<float> frame(stage.blockSize * 2);
+
+        for (size_t c = 0; c < ir->numChannels; ++c) {
+            const std::vector<float>& source = channels[c];
+            for (size_t p = 0; p < stage.partitions; ++p) {
+                // Partition in der ersten Hälfte, Rest Nullen (Overlap-Save)
+                std::fill(frame.begin(), frame.end(), 0.0f);
+                const size_t start = offset + p * stage.blockSize;
+                for (size_t i = 0; i < stage.blockSize && start + i < source.size(); ++i) {
+                    frame[i] = source[start + i] * scale;
+                }
+                float* re = &stage.re[(c * stage.partitions + p) * stage.numBins];
+                float* im = &stage.im[(c * stage.partitions + p) * stage.numBins];
+                fft.forward(frame.data(), re, im);
+            }
+        }
+    };
+
+    buildStage(ir->head, 0);
+    buildStage(ir->tail, tailBlock);
+    return ir;
+}
+
+size_t ConvolutionIR::getMemoryBytes() const {
+    return (head.re.size() + head.im.size() + tail.re.size() + tail.im.size()) * sizeof(float);
+}
+
+// ---------------------------------------------------------------------------
+// ConvolutionIRCache
+
+ConvolutionIRCache& ConvolutionIRCache::get() {
+    static ConvolutionIRCache cache;
+    return cache;
+}
+
+std::shared_ptr<const ConvolutionIR> ConvolutionIRCache::acquire(const std::string& key, size_t blockSize,
+                                                                 const Builder& build) {
+    const std::string entryKey = key + "#" + std::to_string(blockSize);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto existing = entries[entryKey].lock()) {
+            return existing;
+        }
+    }
+
+    // Aufbau ohne Lock; bauen zwei Threads gleichzeitig, gewinnt der erste
+    auto ir = ConvolutionIR::create(build(), blockSize);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = entries[entryKey];
+    if (auto existing = entry.lock()) {
+        return existing;
+    }
+    entry = ir;
+
+    // Verwaiste Einträge bei der Gelegenheit entfernen
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.expired()) it = entries.erase(it); else ++it;
+    }
+    return ir;
+}
+
+size_t ConvolutionIRCache::getCachedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t count = 0;
+    for (const auto& entry : entries) {
+        if (!entry.second.expired()) ++count;
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+// ConvolutionEngine
+
+struct ConvolutionEngine::Impl {
+    // Eine Partitionsstufe: Eingangsrahmen (vorheriger + aktueller Block),
+    // Frequenzbereichs-Verzögerungsleitung und Akkumulator je Kanal
+    struct Stage {
+        const ConvolutionIR::Stage* ir = nullptr;
+        std::unique_ptr<dsp::RealFFT> fft;
+        size_t newest = 0;
+        std::vector<float> frame[kEngineChannels];
+        std::vector<float> fdlRe[kEngineChannels];
+        std::vector<float> fdlIm[kEngineChannels];
+        std::vector<float> accRe[kEngineChannels];
+        std::vector<float> accIm[kEngineChannels];
+        std::vector<float> time;
+
+        void allocate(const ConvolutionIR::Stage& source) {
+            ir = &source;
+            if (source.partitions == 0) return;
+            fft = std::make_unique<dsp::RealFFT>(source.blockSize * 2);
+            for (size_t c = 0; c < kEngineChannels; ++c) {
+                frame[c].assign(source.blockSize * 2, 0.0f);
+                fdlRe[c].assign(source.partitions * source.numBins, 0.0f);
+                fdlIm[c].assign(fdlRe[c].size(), 0.0f);
+                accRe[c].assign(source.numBins, 0.0f);
+                accIm[c].assign(source.numBins, 0.0f);
+            }
+            time.assign(source.blockSize * 2, 0.0f);
+        }
+
+        void clear() {
+            newest = 0;
+            for (size_t c = 0; c < kEngineChannels; ++c) {
+                std::fill(frame[c].begin(), frame[c].end(), 0.0f);
+                std::fill(fdlRe[c].begin(), fdlRe[c].end(), 0.0f);
+                std::fill(fdlIm[c].begin(), fdlIm[c].end(), 0.0f);
+                std::fill(accRe[c].begin(), accRe[c].end(), 0.0f);
+                std::fill(accIm[c].begin(), accIm[c].end(), 0.0f);
+            }
+        }
+
+        float* slotRe(size_t c, size_t slot) { return &fdlRe[c][slot * ir->numBins]; }
+        float* slotIm(size_t c, size_t slot) { return &fdlIm[c][slot * ir->numBins]; }
+
+        // Eingangsspektrum des vollen Rahmens in die Leitung schreiben
+        void pushFrame(size_t c) {
+            fft->forward(frame[c].data(), slotRe(c, newest), slotIm(c, newest));
+        }
+
+        // Partitionen [first, last) gegen die Spektren ab slotOffset zurück
+        void accumulate(size_t c, size_t irChannel,
+                        size_t first, size_t last, size_t slotOffset) {
+            const size_t partitions = ir->partitions;
+            for (size_t p = first; p < last; ++p) {
+                const size_t slot = (newest + partitions + slotOffset - p) % partitions;
+                dsp::complexMultiplyAccumulate(accRe[c].data(), accIm[c].data(),
+                    ir->partitionRe(irChannel, p), ir->partitionIm(irChannel, p),
+                    slotRe(c, slot), slotIm(c, slot), ir->numBins);
+            }
+        }
+
+        // Akkumulator zurück in den Zeitbereich; gültig ist die zweite Hälfte
+        const float* finish(size_t c) {
+            fft->inverse(accRe[c].data(), accIm[c].data(), time.data());
+            std::fill(accRe[c].begin(), accRe[c].end(), 0.0f);
+            std::fill(accIm[c].begin(), accIm[c].end(), 0.0f);
+            return time.data() + ir->blockSize;
+        }
+
+        void shiftFrame(size_t c) {
+            const size_t block = ir->blockSize;
+            std::memcpy(frame[c].data(), frame[c].data() + block, block * sizeof(float));
+        }
+    };
+
+    std::shared_ptr<const ConvolutionIR> ir;
+    size_t blockSize;
+
+    Stage head;
+    Stage tail;
+    // Fortschritt im großen Block: Anzahl kleiner Blöcke und nächste Partition
+    size_t tailStep = 0;
+    size_t tailNextPartition = 1;
+    size_t tailPartitionsPerStep = 0;
+    std::vector<float> tailOutput[kEngineChannels];
+
+    // FIFO zwischen Host-Blöcken und festen Faltungsblöcken
+    std::vector<float> inputFifo[kEngineChannels];
+    std::vector<float> outputFifo[kEngineChannels];
+    size_t fifoPosition = 0;
+
+    explicit Impl(std::shared_ptr<const ConvolutionIR> source)
+        : ir(std::move(source))
+        , blockSize(ir->head.blockSize)
+    {
+        head.allocate(ir->head);
+        tail.allocate(ir->tail);
+        if (ir->tail.partitions > 0) {
+            tailPartitionsPerStep = divideRoundingUp(ir->tail.partitions - 1, ConvolutionIR::kTailRatio);
+            for (auto& output : tailOutput) output.assign(ir->tail.blockSize, 0.0f);
+        }
+        for (size_t c = 0; c < kEngineChannels; ++c) {
+            inputFifo[c].assign(blockSize, 0.0f);
+            outputFifo[c].assign(blockSize, 0.0f);
+        }
+    }
+
+    size_t irChannel(size_t c) const {
+        return std::min(c, ir->numChannels - 1);
+    }
+
+    // Ein Faltungsblock: inputFifo -> outputFifo
+    void step() {
+        const size_t hp = ir->head.partitions;
+        head.newest = (head.newest + 1) % hp;
+        for (size_t c = 0; c < kEngineChannels; ++c) {
+            head.shiftFrame(c);
+            std::memcpy(head.frame[c].data() + blockSize, inputFifo[c].data(), blockSize * sizeof(float));
+            head.pushFrame(c);
+            head.accumulate(c, irChannel(c), 0, hp, 0);
+            std::memcpy(outputFifo[c].data(), head.finish(c), blockSize * sizeof(float));
+        }
+
+        if (ir->tail.partitions == 0) return;
+
+        const size_t tp = ir->tail.partitions;
+        const size_t tailBlock = ir->tail.blockSize;
+        const size_t offset = tailStep * blockSize;
+
+        // Partitionen >= 1 hängen nur an vergangenen großen Blöcken und
+        // werden gleichmäßig über die kleinen Blöcke verteilt
+        const size_t last = std::min(tp, tailNextPartition + tailPartitionsPerStep);
+        for (size_t c = 0; c < kEngineChannels; ++c) {
+            std::memcpy(tail.frame[c].data() + tailBlock + offset, inputFifo[c].data(),
+                        blockSize * sizeof(float));
+            tail.accumulate(c, irChannel(c), tailNextPartition, last, 1);
+
+            // Ergebnis des vorigen großen Blocks, um tailBlock verschoben
+            const float* delayed = tailOutput[c].data() + offset;
+            float* output = outputFifo[c].data();
+            for (size_t i = 0; i < blockSize; ++i) output[i] += delayed[i];
+        }
+        tailNextPartition = last;
+
+        if (++tailStep < ConvolutionIR::kTailRatio) return;
+
+        tail.newest = (tail.newest + 1) % tp;
+        for (size_t c = 0; c < kEngineChannels; ++c) {
+            tail.pushFrame(c);
+            tail.accumulate(c, irChannel(c), 0, 1, 0);
+            std::memcpy(tailOutput[c].data(), tail.finish(c), tailBlock * sizeof(float));
+            tail.shiftFrame(c);
+        }
+        tailStep = 0;
+        tailNextPartition = 1;
+    }
+
+    void clear() {
+        head.clear();
+        tail.clear();
+        tailStep = 0;
+        tailNextPartition = 1;
+        for (size_t c = 0; c < kEngineChannels; ++c) {
+            std::fill(tailOutput[c].begin(), tailOutput[c].end(), 0.0f);
+            std::fill(inputFifo[c].begin(), inputFifo[c].end(), 0.0f);
+            std::fill(outputFifo[c].begin(), outputFifo[c].end(), 0.0f);
+        }
+        fifoPosition = 0;
+    }
+};
+
+ConvolutionEngine::ConvolutionEngine(std::shared_ptr<const ConvolutionIR> ir)
+    : pImpl(std::make_unique<Impl>(std::move(ir)))
+{
+}
+
+ConvolutionEngine::~ConvolutionEngine() = default;
+
+void ConvolutionEngine::process(const float* inLeft, const float* inRight,
+                                float* outLeft, float* outRight, size_t numFrames) {
+    Impl& impl = *pImpl;
+    const float* inputs[kEngineChannels] = {inLeft, inRight};
+    float* outputs[kEngineChannels] = {outLeft, outRight};
+
+    size_t done = 0;
+    while (done < numFrames) {
+        const size_t chunk = std::min(numFrames - done, impl.blockSize - impl.fifoPosition);
+        for (size_t c = 0; c < kEngineChannels; ++c) {
+            // Erst lesen, dann schreiben: in == out ist erlaubt
+            std::memcpy(impl.inputFifo[c].data() + impl.fifoPosition, inputs[c] + done, chunk * sizeof(float));
+            std::memcpy(outputs[c] + done, impl.outputFifo[c].data() + impl.fifoPosition, chunk * sizeof(float));
+        }
+        impl.fifoPosition += chunk;
+        done += chunk;
+
+        if (impl.fifoPosition == impl.blockSize) {
+            impl.step();
+            impl.fifoPosition = 0;
+        }
+    }
+}
+
+void ConvolutionEngine::reset() {
+    pImpl->clear();
+}
+
+size_t ConvolutionEngine::getLatency() const {
+    return pImpl->blockSize;
+}
+
+size_t ConvolutionEngine::getMemoryBytes() const {
+    size_t floats = 0;
+    for (const Impl::Stage* stage : {&pImpl->head, &pImpl->tail}) {
+        for (size_t c = 0; c < kEngineChannels; ++c) {
+            floats += stage->frame[c].size() + stage->fdlRe[c].size() + stage->fdlIm[c].size()
+                    + stage->accRe[c].size() + stage->accIm[c].size();
+        }
+        floats += stage->time.size();
+    }
+    for (size_t c = 0; c < kEngineChannels; ++c) {
+        floats += pImpl->tailOutput[c].size() + pImpl->inputFifo[c].size() + pImpl->outputFifo[c].size();
+    }
+    return floats * sizeof(float);
+}
+
+const std::shared_ptr<const ConvolutionIR>& ConvolutionEngine::getIR() const {
+    return pImpl->ir;
+}
+
+// ---------------------------------------------------------------------------
+// ConvolutionLoader
+
+ConvolutionLoader::ConvolutionLoader()
+    : busy(false)
+    , running(true)
+    , ready(nullptr)
+    , retired(nullptr)
+{
+    worker = std::thread(&ConvolutionLoader::run, this);
+}
+
+ConvolutionLoader::~ConvolutionLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+
+    delete ready.exchange(nullptr);
+    delete retired.exchange(nullptr);
+}
+
+void ConvolutionLoader::request(Builder builder) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingBuilder = std::move(builder);
+    }
+    wake.notify_one();
+}
+
+ConvolutionEngine* ConvolutionLoader::takeReady() {
+    // Nur übernehmen, wenn der Platz für die alte Engine frei ist
+    if (retired.load(std::memory_order_acquire) != nullptr) return nullptr;
+    return ready.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void ConvolutionLoader::retire(ConvolutionEngine* engine) {
+    retired.store(engine, std::memory_order_release);
+}
+
+void ConvolutionLoader::waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !busy && !pendingBuilder; });
+}
+
+void ConvolutionLoader::collectRetired() {
+    delete retired.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void ConvolutionLoader::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        // Regelmäßig aufwachen, um ausgemusterte Engines zu löschen; der
+        // Audio-Thread darf dafür nicht signalisieren
+        wake.wait_for(lock, std::chrono::milliseconds(100),
+                      [this] { return !running || pendingBuilder; });
+        collectRetired();
+        if (!running || !pendingBuilder) continue;
+
+        Builder builder = std::move(pendingBuilder);
+        pendingBuilder = nullptr;
+        busy = true;
+        lock.unlock();
+
+        ConvolutionEngine* engine = nullptr;
+        try {
+            if (auto ir = builder()) {
+                engine = new ConvolutionEngine(std::move(ir));
+            }
+        } catch (const std::exception&) {
+            // Ungültige Antwort: die bisherige Engine bleibt aktiv
+        }
+        // Eine noch nicht übernommene Engine ist überholt
+        delete ready.exchange(engine, std::memory_order_acq_rel);
+
+        lock.lock();
+        busy = false;
+        idle.notify_all();
+    }
+}
+
+} // namespace VR_DAW
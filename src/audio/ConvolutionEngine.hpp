@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace VR_DAW {
+
+// Impulsantwort im Frequenzbereich, in Partitionen zerlegt. Unveränderlich
+// nach dem Aufbau; beliebig viele ConvolutionEngines teilen sich eine
+// Instanz über shared_ptr. Zwei Stufen: der Kopf (erste kTailRatio
+// Partitionen) mit kleinen Blöcken für niedrige Latenz, der Rest der
+// Antwort mit kTailRatio-fach größeren Blöcken für wenig Rechenaufwand.
+class ConvolutionIR {
+public:
+    static constexpr size_t kDefaultBlockSize = 128;
+    static constexpr size_t kTailRatio = 16;
+
+    // Zeitbereich: ein Kanal (für beide Seiten) oder zwei Kanäle.
+    // Teuer (FFT über die ganze Antwort), nicht im Audio-Thread aufrufen
+    static std::shared_ptr<const ConvolutionIR> create(const std::vector<std::vector<float>>& channels,
+                                                       size_t blockSize = kDefaultBlockSize);
+
+    size_t getBlockSize() const { return head.blockSize; }
+    size_t getTailBlockSize() const { return tail.blockSize; }
+    size_t getNumChannels() const { return numChannels; }
+    size_t getLength() const { return length; }
+    size_t getMemoryBytes() const;
+
+private:
+    friend class ConvolutionEngine;
+
+    struct Stage {
+        size_t blockSize = 0;
+        size_t numBins = 0;
+        size_t partitions = 0;
+        // [Kanal][Partition][Bin], bereits mit 1/FFT-Größe skaliert
+        std::vector<float> re;
+        std::vector<float> im;
+
+        const float* partitionRe(size_t channel, size_t partition) const {
+            return &re[(channel * partitions + partition) * numBins];
+        }
+        const float* partitionIm(size_t channel, size_t partition) const {
+            return &im[(channel * partitions + partition) * numBins];
+        }
+    };
+
+    ConvolutionIR() = default;
+
+    size_t numChannels = 0;
+    size_t length = 0;
+    Stage head;
+    Stage tail;
+};
+
+// Prozessweiter Cache, damit mehrere Instanzen derselben Impulsantwort nur
+// eine Frequenzbereichs-Kopie halten. Einträge leben, solange eine Engine
+// sie referenziert (weak_ptr), und werden sonst neu aufgebaut.
+class ConvolutionIRCache {
+public:
+    using Builder = std::function<std::vector<std::vector<float>>()>;
+
+    static ConvolutionIRCache& get();
+
+    // Baut die Antwort beim ersten Zugriff auf dem aufrufenden Thread
+    std::shared_ptr<const ConvolutionIR> acquire(const std::string& key, size_t blockSize,
+                                                 const Builder& build);
+    size_t getCachedCount() const;
+
+private:
+    ConvolutionIRCache() = default;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<const ConvolutionIR>> entries;
+};
+
+// Partitionierte Faltung (Overlap-Save, Frequenzbereichs-Verzögerungsleitung)
+// für zwei Kanäle. Latenz ist die Kopf-Blockgröße, unabhängig von der
+// Host-Blockgröße. Die Multiplikationen der großen Partitionen werden über
+// die kleinen Blöcke verteilt; pro großem Block bleibt nur eine FFT-Spitze.
+class ConvolutionEngine {
+public:
+    // Alloziert alle Puffer, nicht im Audio-Thread aufrufen
+    explicit ConvolutionEngine(std::shared_ptr<const ConvolutionIR> ir);
+    ~ConvolutionEngine();
+
+    ConvolutionEngine(const ConvolutionEngine&) = delete;
+    ConvolutionEngine& operator=(const ConvolutionEngine&) = delete;
+
+    // Audio-Thread; beliebige numFrames, in == out ist erlaubt
+    void process(const float* inLeft, const float* inRight,
+                 float* outLeft, float* outRight, size_t numFrames);
+    void reset();
+
+    size_t getLatency() const;
+    size_t getMemoryBytes() const;
+    const std::shared_ptr<const ConvolutionIR>& getIR() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+// Baut Impulsantworten und Engines auf einem Hintergrund-Thread und reicht
+// sie lockfrei an den Audio-Thread weiter. Alte Engines gibt der Audio-Thread
+// über retire() zurück; gelöscht wird auf dem Lade-Thread.
+class ConvolutionLoader {
+public:
+    using Builder = std::function<std::shared_ptr<const ConvolutionIR>()>;
+
+    ConvolutionLoader();
+    ~ConvolutionLoader();
+
+    // Kontroll-Thread; ein noch nicht begonnener Auftrag wird ersetzt
+    void request(Builder builder);
+
+    // Audio-Thread: fertige Engine übernehmen, sonst nullptr. Liefert nur
+    // dann eine Engine, wenn danach ein retire() garantiert Platz hat
+    ConvolutionEngine* takeReady();
+    void retire(ConvolutionEngine* engine);
+
+    // Kontroll-Thread: wartet, bis alle Aufträge gebaut sind (Tests, Export)
+    void waitUntilIdle();
+
+private:
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    Builder pendingBuilder;
+    bool busy;
+    bool running;
+
+    std::atomic<ConvolutionEngine*> ready;
+    std::atomic<ConvolutionEngine*> retired;
+
+    void run();
+    void collectRetired();
+};
+
+} // namespace VR_DAW
@@ -1,4 +1,5 @@
 #include "DolbyAtmosManager.hpp"
+#include "Ambisonics.hpp"
 #include <dolby/dolby_atmos.h>
 #include <algorithm>
 
@@ -21,22 +22,14 @@ bool DolbyAtmosManager::initialize() {
             return false;
         }
         
-        // Standard-Bedienfeld-Konfiguration
-        currentBedConfig.numSpeakers = 7;  // 7.1.4 Setup
-        
-        // Standard-Lautsprecherpositionen (in Metern)
-        float defaultPositions[7][3] = {
-            {0.0f, 0.0f, 0.0f},      // Center
-            {-1.0f, 0.0f, 0.0f},     // Left
-            {1.0f, 0.0f, 0.0f},      // Right
-            {-0.7f, 0.0f, 0.7f},     // Left Surround
-            {0.7f, 0.0f, 0.7f},      // Right Surround
-            {0.0f, 0.0f, 1.0f},      // Rear Center
-            {0.0f, 0.0f, -1.0f}      // LFE
-        };
-        
-        std::copy(&defaultPositions[0][0], &defaultPositions[0][0] + 21,
-                 &currentBedConfig.speakerPositions[0][0]);
+        // Standard-Bett: 7.1.4 (L R C LFE Ls Rs Lrs Rrs Ltf Rtf Ltr Rtr),
+        // Einheitsvektoren mit x rechts, y oben, z hinten wie der Ambisonics-Bus
+        const SpeakerLayout bed = SpeakerLayout::surround714();
+        currentBedConfig.numSpeakers = static_cast<int>(bed.speakers.size());
+        for (size_t i = 0; i < bed.speakers.size(); ++i) {
+            float* position = currentBedConfig.speakerPositions[i];
+            SpeakerLayout::toVector(bed.speakers[i], position[0], position[1], position[2]);
+        }
         
         // Standard-Lautsprecherverstärkungen
         std::fill(currentBedConfig.speakerGains,
@@ -105,19 +98,23 @@ DolbyAtmosManager::RenderMode DolbyAtmosManager::getRenderMode() const {
     return currentMode;
 }
 
-void DolbyAtmosManager::addAudioObject(const AudioObject& object) {
+DolbyAtmosManager::ObjectHandle DolbyAtmosManager::addAudioObject(const AudioObject& object) {
     if (!initialized) {
-        return;
+        return AtmosObjectStore::kInvalidHandle;
     }
     
-    auto it = std::find_if(audioObjects.begin(), audioObjects.end(),
-        [&object](const auto& obj) {
-            return obj.id == object.id;
-        });
+    const ObjectHandle existing = objectStore.find(object.id);
+    if (existing != AtmosObjectStore::kInvalidHandle) {
+        return existing;
+    }
     
-    if (it == audioObjects.end()) {
-        audioObjects.push_back(object);
+    const ObjectHandle handle = objectStore.create(object.id);
+    if (handle == AtmosObjectStore::kInvalidHandle) {
+        lastError = "Maximale Anzahl an Audio-Objekten erreicht";
+        return handle;
     }
+    storeObject(handle, object);
+    return handle;
 }
 
 void DolbyAtmosManager::removeAudioObject(const std::string& objectId) {
@@ -125,14 +122,7 @@ void DolbyAtmosManager::removeAudioObject(const std::string& objectId) {
         return;
     }
     
-    auto it = std::find_if(audioObjects.begin(), audioObjects.end(),
-        [&objectId](const auto& obj) {
-            return obj.id == objectId;
-        });
-    
-    if (it != audioObjects.end()) {
-        audioObjects.erase(it);
-    }
+    objectStore.destroy(objectStore.find(objectId));
 }
 
 void DolbyAtmosManager::updateAudioObject(const AudioObject& object) {
@@ -140,18 +130,30 @@ void DolbyAtmosManager::updateAudioObject(const AudioObject& object) {
         return;
     }
     
-    auto it = std::find_if(audioObjects.begin(), audioObjects.end(),
-        [&object](const auto& obj) {
-            return obj.id == object.id;
-        });
-    
-    if (it != audioObjects.end()) {
-        *it = object;
+    const ObjectHandle handle = objectStore.find(object.id);
+    if (handle != AtmosObjectStore::kInvalidHandle) {
+        storeObject(handle, object);
+    }
+}
+
+void DolbyAtmosManager::updateAudioObjectPosition(ObjectHandle object, const float position[3]) {
+    if (!initialized) {
+        return;
     }
+    
+    objectStore.setPosition(object, position[0], position[1], position[2]);
 }
 
 std::vector<DolbyAtmosManager::AudioObject> DolbyAtmosManager::getAudioObjects() const {
-    return audioObjects;
+    std::vector<AudioObject> objects;
+    objects.reserve(objectStore.size());
+    const auto& state = objectStore.getWorking();
+    for (size_t slot = 0; slot < state.slotCount; ++slot) {
+        if (state.active[slot]) {
+            objects.push_back(loadObject(slot));
+        }
+    }
+    return objects;
 }
 
 void DolbyAtmosManager::setBedConfig(const BedConfig& config) {
@@ -196,21 +198,18 @@ void DolbyAtmosManager::processAudioObject(const std::string& objectId, juce::Au
         return;
     }
     
-    auto it = std::find_if(audioObjects.begin(), audioObjects.end(),
-        [&objectId](const auto& obj) {
-            return obj.id == objectId;
-        });
-    
-    if (it != audioObjects.end()) {
+    const ObjectHandle handle = objectStore.find(objectId);
+    if (handle != AtmosObjectStore::kInvalidHandle) {
         // Objekt-basierte Verarbeitung
+        const AudioObject object = loadObject(AtmosObjectStore::slotOf(handle));
         dolby_atmos_process_object(
             objectId.c_str(),
             buffer.getReadPointer(0),
             buffer.getReadPointer(1),
             buffer.getNumSamples(),
-            it->position,
-            it->size,
-            it->spread
+            object.position,
+            object.size,
+            object.spread
         );
     }
 }
@@ -260,18 +259,42 @@ void DolbyAtmosManager::initializeObjectRenderer() {
 }
 
 void DolbyAtmosManager::updateObjectPositions() {
-    for (const auto& object : audioObjects) {
-        if (object.isDynamic) {
-            dolby_atmos_update_object_position(
-                object.id.c_str(),
-                object.position,
-                object.size,
-                object.spread
-            );
+    const auto& state = objectStore.getWorking();
+    for (size_t slot = 0; slot < state.slotCount; ++slot) {
+        if (!state.active[slot] || !objectDynamic[slot]) {
+            continue;
         }
+        const float position[3] = {state.x[slot], state.y[slot], state.z[slot]};
+        dolby_atmos_update_object_position(
+            objectStore.getName(slot).c_str(),
+            position,
+            objectSizes[slot],
+            state.spread[slot]
+        );
     }
 }
 
+void DolbyAtmosManager::storeObject(ObjectHandle handle, const AudioObject& object) {
+    const size_t slot = AtmosObjectStore::slotOf(handle);
+    objectStore.setPosition(handle, object.position[0], object.position[1], object.position[2]);
+    objectStore.setSpread(handle, object.spread);
+    objectSizes[slot] = object.size;
+    objectDynamic[slot] = object.isDynamic ? 1 : 0;
+}
+
+DolbyAtmosManager::AudioObject DolbyAtmosManager::loadObject(size_t slot) const {
+    const auto& state = objectStore.getWorking();
+    AudioObject object;
+    object.id = objectStore.getName(slot);
+    object.position[0] = state.x[slot];
+    object.position[1] = state.y[slot];
+    object.position[2] = state.z[slot];
+    object.size = objectSizes[slot];
+    object.spread = state.spread[slot];
+    object.isDynamic = objectDynamic[slot] != 0;
+    return object;
+}
+
 void DolbyAtmosManager::processBinaural(juce::AudioBuffer<float>& buffer) {
     // Binaurale Verarbeitung
     dolby_atmos_process_binaural(
@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <juce_audio_basics/juce_audio_basics.h>
+#include "AtmosObjectStore.hpp"
 
 namespace VR_DAW {
 
@@ -26,7 +27,10 @@ public:
     void setRenderMode(RenderMode mode);
     RenderMode getRenderMode() const;
     
-    // Objekt-basierte Audio-Verwaltung
+    // Objekt-basierte Audio-Verwaltung. Objekte liegen im AtmosObjectStore;
+    // die string-IDs werden über eine Hash-Tabelle aufgelöst, Handles direkt
+    using ObjectHandle = AtmosObjectStore::Handle;
+
     struct AudioObject {
         std::string id;
         float position[3];  // x, y, z
@@ -35,9 +39,11 @@ public:
         bool isDynamic;    // Dynamische Positionierung
     };
     
-    void addAudioObject(const AudioObject& object);
+    // Liefert das Handle, bei vorhandener ID das bestehende (unverändert)
+    ObjectHandle addAudioObject(const AudioObject& object);
     void removeAudioObject(const std::string& objectId);
     void updateAudioObject(const AudioObject& object);
+    void updateAudioObjectPosition(ObjectHandle object, const float position[3]);
     std::vector<AudioObject> getAudioObjects() const;
     
     // Bedienfeld-Konfiguration
@@ -79,7 +85,11 @@ private:
     // Interne Zustandsvariablen
     bool initialized = false;
     RenderMode currentMode = RenderMode::Binaural;
-    std::vector<AudioObject> audioObjects;
+    static constexpr size_t kMaxObjects = 128;
+    AtmosObjectStore objectStore{kMaxObjects, 0};
+    // Kalte Objektdaten je Slot, neben dem SoA-Zustand des Stores
+    std::vector<float> objectSizes = std::vector<float>(kMaxObjects, 0.0f);
+    std::vector<uint8_t> objectDynamic = std::vector<uint8_t>(kMaxObjects, 0);
     BedConfig currentBedConfig;
     AtmosMetadata currentMetadata;
     
@@ -87,6 +97,8 @@ private:
     std::string lastError;
     
     // Interne Hilfsfunktionen
+    void storeObject(ObjectHandle handle, const AudioObject& object);
+    AudioObject loadObject(size_t slot) const;
     void initializeBinauralRenderer();
     void initializeObjectRenderer();
     void updateObjectPositions();
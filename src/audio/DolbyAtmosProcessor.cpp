@@ -1,27 +1,51 @@
 #include "DolbyAtmosProcessor.hpp"
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_audio_utils/juce_audio_utils.h>
+#include <algorithm>
 
 namespace VR_DAW {
 
+namespace {
+
+int orderForQuality(const std::string& quality) {
+    if (quality == "Low") return 1;
+    if (quality == "Medium") return 2;
+    return 3;
+}
+
+} // namespace
+
 DolbyAtmosProcessor& DolbyAtmosProcessor::getInstance() {
     static DolbyAtmosProcessor instance;
     return instance;
 }
 
 void DolbyAtmosProcessor::initialize() {
-    initializeRenderer();
-    initializeMixer();
-    initializeSpatializer();
+    ambisonicOrder = orderForQuality(currentQuality);
+    initializeBus();
+    initializeDecoders();
     enabled = true;
 }
 
 void DolbyAtmosProcessor::shutdown() {
     enabled = false;
-    renderer.reset();
-    mixer.reset();
-    spatializer.reset();
-    objects.clear();
+    bus.reset();
+    bedEncoder.reset();
+    objectEncoder.reset();
+    speakerDecoder.reset();
+    binauralDecoder.reset();
+    objectStore->clear();
+    objectStore->commit();
+}
+
+void DolbyAtmosProcessor::prepare(double newSampleRate, int newMaxBlockSize) {
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : sampleRate;
+    maxBlockSize = std::max(newMaxBlockSize, 1);
+    objectStore->setMaxFrames(static_cast<size_t>(maxBlockSize));
+    if (bus) {
+        initializeBus();
+        initializeDecoders();
+    }
 }
 
 void DolbyAtmosProcessor::configure(const std::string& config) {
@@ -31,80 +55,112 @@ void DolbyAtmosProcessor::configure(const std::string& config) {
 
 void DolbyAtmosProcessor::setChannelCount(int count) {
     channelCount = count;
-    if (mixer) {
-        mixer->setChannelCount(count);
+    if (bus) {
+        initializeBus();
+        initializeDecoders();
     }
 }
 
 void DolbyAtmosProcessor::setObjectCount(int count) {
-    objectCount = count;
-    objects.resize(count);
+    objectCount = std::clamp(count, 1, 0x10000);
+    objectStore = std::make_unique<AtmosObjectStore>(static_cast<size_t>(objectCount),
+                                                     static_cast<size_t>(maxBlockSize));
+    if (bus) {
+        initializeBus();
+    }
 }
 
 void DolbyAtmosProcessor::processBuffer(juce::AudioBuffer<float>& buffer) {
-    if (!enabled) return;
-    
-    // Verarbeite den Haupt-Audio-Buffer
-    if (mixer) {
-        mixer->process(buffer);
-    }
-    
-    // Verarbeite alle Objekte
-    processObjects();
-    
-    // Rendere das Ergebnis
-    if (currentMode == "Binaural") {
-        renderToBinaural(buffer);
-    } else if (currentMode == "Multichannel") {
-        renderToMultichannel(buffer);
+    if (!enabled || !bus) return;
+
+    // In Bus-Blöcken: kodieren, dann genau einmal dekodieren. Die Kodierung
+    // eines Blocks ist fertig, bevor die Ausgabe die Bett-Kanäle überschreibt
+    const AtmosObjectStore::Snapshot& snapshot = objectStore->acquire();
+    const int numSamples = buffer.getNumSamples();
+    const int chunkSize = static_cast<int>(bus->getMaxFrames());
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        const int chunk = std::min(chunkSize, numSamples - start);
+        bus->clear(static_cast<size_t>(chunk));
+        encodeBed(buffer, start, chunk);
+        encodeObjects(snapshot, start, chunk);
+        encodedFrames = static_cast<size_t>(chunk);
+
+        if (currentMode == "Binaural") {
+            decodeBinaural(buffer, start, chunk);
+        } else if (currentMode == "Multichannel") {
+            decodeMultichannel(buffer, start, chunk);
+        }
     }
+
+    // Objekt-Audio gilt nur für einen Block
+    std::fill(objectFrames.begin(), objectFrames.begin() + snapshot.slotCount, 0u);
 }
 
-void DolbyAtmosProcessor::processObject(const std::string& objectId, const juce::AudioBuffer<float>& buffer) {
-    auto it = std::find_if(objects.begin(), objects.end(),
-        [&objectId](const AtmosObject& obj) { return obj.id == objectId; });
-    
-    if (it != objects.end()) {
-        it->buffer = buffer;
+void DolbyAtmosProcessor::processObject(ObjectHandle object, const juce::AudioBuffer<float>& buffer) {
+    if (!bus || buffer.getNumChannels() == 0) return;
+    const AtmosObjectStore::Snapshot& snapshot = objectStore->acquire();
+    const size_t slot = AtmosObjectStore::slotOf(object);
+    if (slot >= snapshot.slotCount || !snapshot.active[slot]
+        || snapshot.generation[slot] != AtmosObjectStore::generationOf(object)) {
+        return;
     }
+
+    const size_t frames = std::min(static_cast<size_t>(buffer.getNumSamples()), objectStore->getMaxFrames());
+    std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + frames, objectStore->getAudio(slot));
+    objectFrames[slot] = static_cast<uint32_t>(frames);
 }
 
 void DolbyAtmosProcessor::renderToBinaural(juce::AudioBuffer<float>& output) {
-    if (renderer) {
-        renderer->renderBinaural(output);
-    }
+    if (!bus) return;
+    decodeBinaural(output, 0, std::min(output.getNumSamples(), static_cast<int>(encodedFrames)));
 }
 
 void DolbyAtmosProcessor::renderToMultichannel(juce::AudioBuffer<float>& output) {
-    if (renderer) {
-        renderer->renderMultichannel(output);
+    if (!bus) return;
+    decodeMultichannel(output, 0, std::min(output.getNumSamples(), static_cast<int>(encodedFrames)));
+}
+
+DolbyAtmosProcessor::ObjectHandle DolbyAtmosProcessor::addObject(const std::string& objectId,
+                                                                const std::string& metadata) {
+    const ObjectHandle object = objectStore->create(objectId, metadata);
+    if (object != AtmosObjectStore::kInvalidHandle) {
+        objectStore->commit();
+    }
+    return object;
+}
+
+void DolbyAtmosProcessor::removeObject(ObjectHandle object) {
+    // Der Audio-Thread erkennt die neue Generation und setzt den
+    // Encoder-Slot bei der nächsten Belegung zurück
+    if (objectStore->destroy(object)) {
+        objectStore->commit();
     }
 }
 
-void DolbyAtmosProcessor::addObject(const std::string& objectId, const std::string& metadata) {
-    AtmosObject obj;
-    obj.id = objectId;
-    obj.metadata = metadata;
-    obj.position[0] = obj.position[1] = obj.position[2] = 0.0f;
-    objects.push_back(obj);
+DolbyAtmosProcessor::ObjectHandle DolbyAtmosProcessor::findObject(const std::string& objectId) const {
+    return objectStore->find(objectId);
 }
 
-void DolbyAtmosProcessor::removeObject(const std::string& objectId) {
-    objects.erase(
-        std::remove_if(objects.begin(), objects.end(),
-            [&objectId](const AtmosObject& obj) { return obj.id == objectId; }),
-        objects.end());
+void DolbyAtmosProcessor::updateObjectPosition(ObjectHandle object, float x, float y, float z) {
+    objectStore->setPosition(object, x, y, z);
+    objectStore->commit();
 }
 
-void DolbyAtmosProcessor::updateObjectPosition(const std::string& objectId, float x, float y, float z) {
-    auto it = std::find_if(objects.begin(), objects.end(),
-        [&objectId](const AtmosObject& obj) { return obj.id == objectId; });
-    
-    if (it != objects.end()) {
-        it->position[0] = x;
-        it->position[1] = y;
-        it->position[2] = z;
+void DolbyAtmosProcessor::updateObjectPositions(const ObjectHandle* objects, const float* positions, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        objectStore->setPosition(objects[i], positions[3 * i], positions[3 * i + 1], positions[3 * i + 2]);
     }
+    objectStore->commit();
+}
+
+void DolbyAtmosProcessor::setObjectGain(ObjectHandle object, float gain) {
+    objectStore->setGain(object, gain);
+    objectStore->commit();
+}
+
+void DolbyAtmosProcessor::setObjectSpread(ObjectHandle object, float spread) {
+    objectStore->setSpread(object, spread);
+    objectStore->commit();
 }
 
 void DolbyAtmosProcessor::enable(bool enable) {
@@ -113,51 +169,107 @@ void DolbyAtmosProcessor::enable(bool enable) {
 
 void DolbyAtmosProcessor::setMode(const std::string& mode) {
     currentMode = mode;
-    if (renderer) {
-        renderer->setMode(mode);
-    }
 }
 
 void DolbyAtmosProcessor::setQuality(const std::string& quality) {
     currentQuality = quality;
-    if (renderer) {
-        renderer->setQuality(quality);
+    const int order = orderForQuality(quality);
+    if (order == ambisonicOrder) return;
+    ambisonicOrder = order;
+    if (bus) {
+        initializeBus();
+        initializeDecoders();
     }
 }
 
-void DolbyAtmosProcessor::initializeRenderer() {
-    renderer = std::make_unique<AtmosRenderer>();
-    renderer->initialize();
-    renderer->setMode(currentMode);
-    renderer->setQuality(currentQuality);
+void DolbyAtmosProcessor::initializeBus() {
+    bedLayout = SpeakerLayout::forChannelCount(channelCount);
+    const size_t bedChannels = bedLayout.speakers.size();
+
+    bus = std::make_unique<AmbisonicBus>(ambisonicOrder, static_cast<size_t>(maxBlockSize));
+    bedEncoder = std::make_unique<AmbisonicEncoder>(ambisonicOrder, bedChannels);
+    objectEncoder = std::make_unique<AmbisonicEncoder>(ambisonicOrder, objectStore->capacity());
+    encodedFrames = 0;
+
+    // Bett-Kanäle sind feste Objekte an den Lautsprecherrichtungen
+    bedInputs.assign(bedChannels, nullptr);
+    bedX.assign(bedChannels, 0.0f);
+    bedY.assign(bedChannels, 0.0f);
+    bedZ.assign(bedChannels, -1.0f);
+    bedGains.assign(bedChannels, 1.0f);
+    for (size_t i = 0; i < bedChannels; ++i) {
+        SpeakerLayout::toVector(bedLayout.speakers[i], bedX[i], bedY[i], bedZ[i]);
+    }
+
+    objectInputs.assign(objectStore->capacity(), nullptr);
+    objectFrames.assign(objectStore->capacity(), 0);
+    encodedGeneration.assign(objectStore->capacity(), 0);
+    outputs.assign(bedChannels, nullptr);
+    lfeScratch.assign(static_cast<size_t>(maxBlockSize), 0.0f);
 }
 
-void DolbyAtmosProcessor::initializeMixer() {
-    mixer = std::make_unique<AtmosMixer>();
-    mixer->initialize();
-    mixer->setChannelCount(channelCount);
+void DolbyAtmosProcessor::initializeDecoders() {
+    speakerDecoder = std::make_unique<AmbisonicDecoder>(ambisonicOrder, bedLayout);
+    binauralDecoder = std::make_unique<AmbisonicBinauralDecoder>(
+        ambisonicOrder, HRTFSet::createSphericalHead(static_cast<float>(sampleRate)));
 }
 
-void DolbyAtmosProcessor::initializeSpatializer() {
-    spatializer = std::make_unique<AtmosSpatializer>();
-    spatializer->initialize();
+void DolbyAtmosProcessor::encodeBed(const juce::AudioBuffer<float>& buffer, int start, int numFrames) {
+    const size_t bedChannels = std::min(bedLayout.speakers.size(), static_cast<size_t>(buffer.getNumChannels()));
+    for (size_t i = 0; i < bedInputs.size(); ++i) {
+        // LFE hat keine Richtung und läuft am Bus vorbei
+        const bool encoded = i < bedChannels && !bedLayout.speakers[i].lfe;
+        bedInputs[i] = encoded ? buffer.getReadPointer(static_cast<int>(i), start) : nullptr;
+    }
+    bedEncoder->process(bedInputs.data(), bedX.data(), bedY.data(), bedZ.data(), bedGains.data(),
+                        bedInputs.size(), *bus, static_cast<size_t>(numFrames));
 }
 
-void DolbyAtmosProcessor::updateObjectBuffers() {
-    for (auto& obj : objects) {
-        if (spatializer) {
-            spatializer->processObject(obj.buffer, obj.position);
+void DolbyAtmosProcessor::encodeObjects(const AtmosObjectStore::Snapshot& snapshot, int start, int numFrames) {
+    // Positionen, Pegel und Spread kommen als SoA direkt aus dem Snapshot;
+    // der Encoder bestimmt die Koeffizienten aller Slots in einem SIMD-Durchgang
+    const size_t slots = snapshot.slotCount;
+    for (size_t slot = 0; slot < slots; ++slot) {
+        if (snapshot.generation[slot] != encodedGeneration[slot]) {
+            objectEncoder->resetSource(slot);
+            encodedGeneration[slot] = snapshot.generation[slot];
         }
+        const bool hasAudio = snapshot.active[slot] && objectFrames[slot] >= static_cast<uint32_t>(start + numFrames);
+        objectInputs[slot] = hasAudio ? objectStore->getAudio(slot) + start : nullptr;
     }
+    objectEncoder->process(objectInputs.data(), snapshot.x.data(), snapshot.y.data(), snapshot.z.data(),
+                           snapshot.gain.data(), slots, *bus, static_cast<size_t>(numFrames),
+                           snapshot.spread.data());
 }
 
-void DolbyAtmosProcessor::processObjects() {
-    updateObjectBuffers();
-    if (mixer) {
-        for (const auto& obj : objects) {
-            mixer->addObject(obj.buffer, obj.position);
-        }
+void DolbyAtmosProcessor::decodeBinaural(juce::AudioBuffer<float>& output, int start, int numFrames) {
+    if (output.getNumChannels() < 2 || numFrames <= 0) return;
+    // LFE entfällt auf Kopfhörern
+    binauralDecoder->process(*bus, output.getWritePointer(0, start), output.getWritePointer(1, start),
+                             static_cast<size_t>(numFrames));
+    for (int channel = 2; channel < output.getNumChannels(); ++channel) {
+        output.clear(channel, start, numFrames);
+    }
+}
+
+void DolbyAtmosProcessor::decodeMultichannel(juce::AudioBuffer<float>& output, int start, int numFrames) {
+    if (numFrames <= 0) return;
+    const size_t speakers = std::min(bedLayout.speakers.size(), static_cast<size_t>(output.getNumChannels()));
+    if (speakers < bedLayout.speakers.size()) return;
+
+    // Der Dekoder schreibt LFE als Null; das Bett-LFE wird durchgereicht
+    const size_t frames = static_cast<size_t>(numFrames);
+    for (size_t i = 0; i < speakers; ++i) {
+        outputs[i] = output.getWritePointer(static_cast<int>(i), start);
+    }
+    for (size_t i = 0; i < speakers; ++i) {
+        if (!bedLayout.speakers[i].lfe) continue;
+        std::copy(outputs[i], outputs[i] + frames, lfeScratch.begin());
+        speakerDecoder->process(*bus, outputs.data(), frames);
+        std::copy(lfeScratch.begin(), lfeScratch.begin() + frames, outputs[i]);
+        return;
     }
+    speakerDecoder->process(*bus, outputs.data(), frames);
 }
 
-} // namespace VR_DAW 
\ No newline at end of file
+} // namespace VR_DAW
@@ -4,39 +4,56 @@
 #include <vector>
 #include <string>
 #include <juce_audio_basics/juce_audio_basics.h>
+#include "Ambisonics.hpp"
+#include "AtmosObjectStore.hpp"
 
 namespace VR_DAW {
 
 class DolbyAtmosProcessor {
 public:
+    using ObjectHandle = AtmosObjectStore::Handle;
+
     static DolbyAtmosProcessor& getInstance();
     
     // Initialisierung
     void initialize();
     void shutdown();
+    // Abtastrate und größte Blockgröße; baut Bus und Dekoder neu auf
+    void prepare(double sampleRate, int maxBlockSize);
     
     // Konfiguration
     void configure(const std::string& config);
     void setChannelCount(int count);
+    // Höchstzahl gleichzeitiger Objekte; verwirft vorhandene Objekte
     void setObjectCount(int count);
     
-    // Verarbeitung
+    // Verarbeitung. buffer enthält die Bett-Kanäle im Layout zu
+    // channelCount und wird durch die Ausgabe des Modus ersetzt
     void processBuffer(juce::AudioBuffer<float>& buffer);
-    void processObject(const std::string& objectId, const juce::AudioBuffer<float>& buffer);
+    // Audio-Thread, vor processBuffer: Kanal 0 wird Audio des Objekts für
+    // diesen Block (Kopie in die Objekt-Arena, höchstens maxBlockSize)
+    void processObject(ObjectHandle object, const juce::AudioBuffer<float>& buffer);
     
-    // Rendering
+    // Rendering: dekodiert den zuletzt kodierten Bus
     void renderToBinaural(juce::AudioBuffer<float>& output);
     void renderToMultichannel(juce::AudioBuffer<float>& output);
     
-    // Objekt-Management
-    void addObject(const std::string& objectId, const std::string& metadata);
-    void removeObject(const std::string& objectId);
-    void updateObjectPosition(const std::string& objectId, float x, float y, float z);
+    // Objekt-Management (Steuer-/UI-Thread). Änderungen erreichen den
+    // Audio-Thread lock-frei über den Dreifachpuffer des Objektspeichers.
+    // Positionen im Hörerraum (x rechts, y oben, z hinten)
+    ObjectHandle addObject(const std::string& objectId, const std::string& metadata);
+    void removeObject(ObjectHandle object);
+    ObjectHandle findObject(const std::string& objectId) const;
+    void updateObjectPosition(ObjectHandle object, float x, float y, float z);
+    // Viele Objekte, einmal veröffentlicht; positions: x, y, z je Objekt
+    void updateObjectPositions(const ObjectHandle* objects, const float* positions, size_t count);
+    void setObjectGain(ObjectHandle object, float gain);
+    void setObjectSpread(ObjectHandle object, float spread);
     
     // Bedienung
     void enable(bool enable);
     void setMode(const std::string& mode); // "Binaural", "Multichannel", "Hybrid"
-    void setQuality(const std::string& quality); // "Low", "Medium", "High"
+    void setQuality(const std::string& quality); // "Low", "Medium", "High" = Ambisonics-Ordnung 1-3
     
 private:
     DolbyAtmosProcessor() = default;
@@ -45,33 +62,49 @@ private:
     DolbyAtmosProcessor(const DolbyAtmosProcessor&) = delete;
     DolbyAtmosProcessor& operator=(const DolbyAtmosProcessor&) = delete;
     
+    static constexpr int kDefaultObjectCount = 128;
+
     // Interne Zustandsvariablen
     bool enabled = false;
+    double sampleRate = 48000.0;
+    int maxBlockSize = 512;
     int channelCount = 2;
-    int objectCount = 0;
+    int objectCount = kDefaultObjectCount;
     std::string currentMode = "Binaural";
     std::string currentQuality = "High";
     
-    // Objekt-Speicher
-    struct AtmosObject {
-        std::string id;
-        std::string metadata;
-        float position[3];
-        juce::AudioBuffer<float> buffer;
-    };
-    std::vector<AtmosObject> objects;
-    
-    // Verarbeitungs-Komponenten
-    std::unique_ptr<class AtmosRenderer> renderer;
-    std::unique_ptr<class AtmosMixer> mixer;
-    std::unique_ptr<class AtmosSpatializer> spatializer;
+    // Objekt-Speicher: Handles, SoA-Zustand und Audio-Arena
+    std::unique_ptr<AtmosObjectStore> objectStore =
+        std::make_unique<AtmosObjectStore>(kDefaultObjectCount, 512);
     
+    // Ambisonics-Bus: Bett-Kanäle und Objekte werden je einmal kodiert,
+    // danach genau ein Dekoder für das Ausgabeformat
+    int ambisonicOrder = 3;
+    SpeakerLayout bedLayout;
+    std::unique_ptr<AmbisonicBus> bus;
+    std::unique_ptr<AmbisonicEncoder> bedEncoder;
+    std::unique_ptr<AmbisonicEncoder> objectEncoder;
+    std::unique_ptr<AmbisonicDecoder> speakerDecoder;
+    std::unique_ptr<AmbisonicBinauralDecoder> binauralDecoder;
+    size_t encodedFrames = 0;
+
+    // Vorab allozierte Arbeitsdaten (SoA je Bett-Kanal bzw. Objekt-Slot)
+    std::vector<const float*> bedInputs, objectInputs;
+    std::vector<float> bedX, bedY, bedZ, bedGains;
+    // Audio-Thread: gültige Samples je Slot in diesem Block und die
+    // Generation, mit der der Encoder-Slot zuletzt belegt war
+    std::vector<uint32_t> objectFrames;
+    std::vector<uint16_t> encodedGeneration;
+    std::vector<float*> outputs;
+    std::vector<float> lfeScratch;
+
     // Interne Hilfsfunktionen
-    void initializeRenderer();
-    void initializeMixer();
-    void initializeSpatializer();
-    void updateObjectBuffers();
-    void processObjects();
+    void initializeBus();
+    void initializeDecoders();
+    void encodeBed(const juce::AudioBuffer<float>& buffer, int start, int numFrames);
+    void encodeObjects(const AtmosObjectStore::Snapshot& snapshot, int start, int numFrames);
+    void decodeBinaural(juce::AudioBuffer<float>& output, int start, int numFrames);
+    void decodeMultichannel(juce::AudioBuffer<float>& output, int start, int numFrames);
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
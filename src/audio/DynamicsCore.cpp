@@ -0,0 +1,366 @@
+#include "DynamicsCore.hpp"
+#include "../dsp/kernels/Lanes.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+// Lanes werden nur zwischen geinlineten Funktionen übergeben
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace VR_DAW {
+
+using dsp::Lanes;
+using dsp::kLaneWidth;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Polyphasen-Interpolator für True-Peak (4x, 48 Taps gesamt). Lane p und
+// p + 4 halten Phase p für links und rechts, damit ein Vektor je Tap beide
+// Kanäle und alle Zwischenwerte auf einmal rechnet.
+constexpr size_t kTapsPerPhase = 12;
+// Gruppenlaufzeit des Filters in Eingangs-Samples
+constexpr size_t kTruePeakDelay = kTapsPerPhase / 2;
+
+struct TruePeakFilter {
+    Lanes taps[kTapsPerPhase];
+
+    // Gefensterter Sinc, auf ein Eingangs-Sample zentriert: Phase p liefert
+    // den Wert bei n - kTruePeakDelay + p/4, Phase 0 ist das Sample selbst
+    TruePeakFilter() {
+        constexpr size_t oversampling = DynamicsCore::kOversampling;
+        constexpr double span = 2.0 * kTruePeakDelay * oversampling;
+        for (size_t t = 0; t < kTapsPerPhase; ++t) {
+            for (size_t phase = 0; phase < oversampling; ++phase) {
+                const double k = static_cast<double>(t * oversampling + phase);
+                const double x = k / oversampling - static_cast<double>(kTruePeakDelay);
+                const double sinc = std::fabs(x) < 1e-9 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+                const double window = 0.42 - 0.5 * std::cos(2.0 * kPi * k / span)
+                                    + 0.08 * std::cos(4.0 * kPi * k / span);
+                taps[t][phase] = static_cast<float>(sinc * window);
+                taps[t][phase + oversampling] = taps[t][phase];
+            }
+        }
+    }
+};
+
+const TruePeakFilter& truePeakFilter() {
+    static const TruePeakFilter filter;
+    return filter;
+}
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// Kennlinie im dB-Bereich für acht Pegel auf einmal
+VRDAW_LANES_INLINE Lanes gainReductionLanes(const Lanes& levelDb, bool limiter, float threshold,
+                                            float slope, float knee) {
+    const Lanes over = levelDb - threshold;
+    if (limiter) {
+        return dsp::minLanes(-over, dsp::splat(0.0f));
+    }
+    const float halfKnee = knee * 0.5f;
+    const Lanes above = slope * over;
+    if (knee <= 0.0f) {
+        return dsp::select(over > 0.0f, above, dsp::splat(0.0f));
+    }
+    const Lanes inKnee = over + halfKnee;
+    const Lanes soft = slope * inKnee * inKnee * (0.5f / knee);
+    return dsp::select(over >= halfKnee, above, dsp::select(over > -halfKnee, soft, dsp::splat(0.0f)));
+}
+
+} // namespace
+
+bool DynamicsCore::Parameters::operator==(const Parameters& other) const {
+    return mode == other.mode && threshold == other.threshold && ratio == other.ratio
+        && knee == other.knee && attack == other.attack && release == other.release
+        && makeup == other.makeup && lookahead == other.lookahead && truePeak == other.truePeak;
+}
+
+struct DynamicsCore::Impl {
+    static constexpr size_t kChunk = 256;
+
+    Parameters parameters;
+    bool dirty = true;
+    float sampleRate = 44100.0f;
+
+    // Abgeleitete Werte, nur in updateCoefficients() geschrieben
+    float attackCoefficient = 0.0f;
+    float releaseCoefficient = 0.0f;
+    float slope = 0.0f;
+    float knee = 0.0f;
+    size_t lookaheadSamples = 0;
+    size_t window = 1;
+    size_t latency = 0;
+    double inverseWindow = 1.0;
+
+    // Geglättete Pegelreduktion in dB
+    float gainDb = 0.0f;
+    std::atomic<float> meter{0.0f};
+
+    std::vector<float> delay[2];
+    size_t delayMask = 0;
+    size_t writePosition = 0;
+
+    // Eingangsverlauf des True-Peak-Filters je Kanal
+    std::vector<float> history[2];
+
+    // Gleitendes Minimum (monotone Warteschlange) und Rechteck-Glättung
+    std::vector<uint64_t> minimumIndex;
+    std::vector<float> minimumValue;
+    size_t minimumMask = 0;
+    size_t minimumHead = 0;
+    size_t minimumTail = 0;
+    std::vector<float> boxValues;
+    size_t boxPosition = 0;
+    double boxSum = 0.0;
+    uint64_t sampleIndex = 0;
+
+    alignas(32) float level[kChunk] = {};
+    alignas(32) float gain[kChunk] = {};
+
+    void prepare(float rate) {
+        sampleRate = rate;
+        const size_t maxLookahead = static_cast<size_t>(std::ceil(kMaxLookahead * rate));
+        const size_t delaySize = nextPowerOfTwo(maxLookahead + kTruePeakDelay + 1);
+        for (auto& line : delay) line.assign(delaySize, 0.0f);
+        delayMask = delaySize - 1;
+        for (auto& channel : history) channel.assign(kTapsPerPhase - 1 + kChunk, 0.0f);
+
+        const size_t queueSize = nextPowerOfTwo(maxLookahead + 2);
+        minimumIndex.assign(queueSize, 0);
+        minimumValue.assign(queueSize, 0.0f);
+        minimumMask = queueSize - 1;
+        boxValues.assign(maxLookahead + 1, 0.0f);
+        dirty = true;
+        clear();
+    }
+
+    void clear() {
+        gainDb = 0.0f;
+        meter.store(0.0f, std::memory_order_relaxed);
+        for (auto& line : delay) std::fill(line.begin(), line.end(), 0.0f);
+        for (auto& channel : history) std::fill(channel.begin(), channel.end(), 0.0f);
+        writePosition = 0;
+        minimumHead = minimumTail = 0;
+        std::fill(boxValues.begin(), boxValues.end(), 0.0f);
+        boxPosition = 0;
+        boxSum = 0.0;
+        sampleIndex = 0;
+    }
+
+    void updateCoefficients() {
+        dirty = false;
+        const Parameters& p = parameters;
+        auto coefficient = [this](float seconds) {
+            return seconds > 0.0f ? std::exp(-1.0f / (seconds * sampleRate)) : 0.0f;
+        };
+        attackCoefficient = coefficient(p.attack);
+        releaseCoefficient = coefficient(p.release);
+        slope = 1.0f / std::max(1.0f, p.ratio) - 1.0f;
+        knee = std::max(0.0f, p.knee);
+
+        const size_t newLookahead = static_cast<size_t>(
+            std::lround(std::min(std::max(p.lookahead, 0.0f), kMaxLookahead) * sampleRate));
+        const size_t newWindow = p.mode == Mode::Limiter ? newLookahead + 1 : 1;
+        const size_t newLatency = newLookahead + (p.truePeak ? kTruePeakDelay : 0);
+
+        // Geänderte Fenster oder Verzögerung: alter Zustand passt nicht mehr
+        if (newWindow != window || newLatency != latency) {
+            lookaheadSamples = newLookahead;
+            window = newWindow;
+            latency = newLatency;
+            inverseWindow = 1.0 / static_cast<double>(window);
+            clear();
+        }
+    }
+
+    void detectLevels(const float* left, const float* right, size_t numFrames) {
+        if (!parameters.truePeak) {
+            for (size_t i = 0; i < numFrames; ++i) {
+                level[i] = std::max(std::fabs(left[i]), std::fabs(right[i]));
+            }
+            return;
+        }
+
+        // Verlauf plus neuer Block, damit jeder Tap zusammenhängend liest
+        constexpr size_t past = kTapsPerPhase - 1;
+        std::copy(left, left + numFrames, history[0].begin() + past);
+        std::copy(right, right + numFrames, history[1].begin() + past);
+        const float* l = history[0].data();
+        const float* r = history[1].data();
+        const Lanes* taps = truePeakFilter().taps;
+
+        for (size_t i = 0; i < numFrames; ++i) {
+            Lanes sum = dsp::splat(0.0f);
+            for (size_t t = 0; t < kTapsPerPhase; ++t) {
+                const float a = l[i + past - t], b = r[i + past - t];
+                const Lanes x = {a, a, a, a, b, b, b, b};
+                sum += taps[t] * x;
+            }
+            const Lanes magnitude = dsp::absLanes(sum);
+            float peak = 0.0f;
+            for (size_t lane = 0; lane < kLaneWidth; ++lane) peak = std::max(peak, magnitude[lane]);
+            level[i] = peak;
+        }
+
+        for (auto& channel : history) {
+            std::copy(channel.begin() + numFrames, channel.begin() + numFrames + past, channel.begin());
+        }
+    }
+
+    void smoothCompressor(size_t numFrames) {
+        float state = gainDb;
+        for (size_t i = 0; i < numFrames; ++i) {
+            const float target = level[i];
+            const float coefficient = target < state ? attackCoefficient : releaseCoefficient;
+            state = target + coefficient * (state - target);
+            gain[i] = state;
+        }
+        gainDb = state;
+    }
+
+    // Minimum über das Lookahead-Fenster, dann Rechteck-Mittel derselben
+    // Länge: erreicht die Zielreduktion genau, wenn die Spitze ausgegeben wird
+    void smoothLimiter(size_t numFrames) {
+        float state = gainDb;
+        for (size_t i = 0; i < numFrames; ++i, ++sampleIndex) {
+            const float target = level[i];
+            while (minimumTail != minimumHead && minimumValue[(minimumTail - 1) & minimumMask] >= target) {
+                --minimumTail;
+            }
+            minimumIndex[minimumTail & minimumMask] = sampleIndex;
+            minimumValue[minimumTail & minimumMask] = target;
+            ++minimumTail;
+            while (minimumIndex[minimumHead & minimumMask] + window <= sampleIndex) ++minimumHead;
+            const float held = minimumValue[minimumHead & minimumMask];
+
+            boxSum += held - boxValues[boxPosition];
+            boxValues[boxPosition] = held;
+            if (++boxPosition == window) boxPosition = 0;
+            const float averaged = static_cast<float>(boxSum * inverseWindow);
+
+            state = averaged < state ? averaged : averaged + releaseCoefficient * (state - averaged);
+            gain[i] = state;
+        }
+        gainDb = state;
+    }
+
+    void processChunk(float* left, float* right, const float* keyLeft, const float* keyRight, size_t numFrames) {
+        float* channels[2] = {left, right ? right : left};
+        const size_t numChannels = right ? 2 : 1;
+
+        if (keyLeft) {
+            detectLevels(keyLeft, keyRight ? keyRight : keyLeft, numFrames);
+        } else {
+            detectLevels(channels[0], channels[1], numFrames);
+        }
+
+        const bool limiter = parameters.mode == Mode::Limiter;
+        const float threshold = parameters.threshold;
+        const size_t padded = (numFrames + kLaneWidth - 1) / kLaneWidth * kLaneWidth;
+        for (size_t i = 0; i < padded; i += kLaneWidth) {
+            const Lanes levelDb = dsp::gainToDecibels(dsp::loadLanes(level + i));
+            dsp::storeLanes(level + i, gainReductionLanes(levelDb, limiter, threshold, slope, knee));
+        }
+
+        if (limiter) smoothLimiter(numFrames); else smoothCompressor(numFrames);
+        meter.store(gainDb, std::memory_order_relaxed);
+
+        const float makeup = parameters.makeup;
+        for (size_t i = 0; i < padded; i += kLaneWidth) {
+            dsp::storeLanes(gain + i, dsp::decibelsToGain(dsp::loadLanes(gain + i) + makeup));
+        }
+
+        for (size_t c = 0; c < numChannels; ++c) {
+            float* data = channels[c];
+            float* line = delay[c].data();
+            size_t position = writePosition;
+            for (size_t i = 0; i < numFrames; ++i, ++position) {
+                line[position & delayMask] = data[i];
+                data[i] = line[(position - latency) & delayMask] * gain[i];
+            }
+        }
+        writePosition = (writePosition + numFrames) & delayMask;
+    }
+};
+
+DynamicsCore::DynamicsCore()
+    : pImpl(std::make_unique<Impl>())
+{
+    pImpl->prepare(pImpl->sampleRate);
+}
+
+DynamicsCore::~DynamicsCore() = default;
+
+void DynamicsCore::prepare(float sampleRate) {
+    pImpl->prepare(sampleRate);
+}
+
+void DynamicsCore::setParameters(const Parameters& parameters) {
+    if (parameters != pImpl->parameters) {
+        pImpl->parameters = parameters;
+        pImpl->dirty = true;
+    }
+}
+
+const DynamicsCore::Parameters& DynamicsCore::getParameters() const {
+    return pImpl->parameters;
+}
+
+void DynamicsCore::process(float* left, float* right, size_t numFrames) {
+    process(left, right, numFrames, nullptr, nullptr);
+}
+
+void DynamicsCore::process(float* left, float* right, size_t numFrames, const float* keyLeft,
+                           const float* keyRight) {
+    Impl& impl = *pImpl;
+    if (impl.dirty) impl.updateCoefficients();
+
+    for (size_t done = 0; done < numFrames;) {
+        const size_t chunk = std::min(Impl::kChunk, numFrames - done);
+        impl.processChunk(left + done, right ? right + done : nullptr, keyLeft ? keyLeft + done : nullptr,
+                          keyRight ? keyRight + done : nullptr, chunk);
+        done += chunk;
+    }
+}
+
+void DynamicsCore::reset() {
+    pImpl->clear();
+}
+
+size_t DynamicsCore::getLatency() const {
+    // Aus den Parametern statt aus dem Audio-Zustand, damit der Wert schon
+    // vor dem nächsten Block stimmt
+    return getLatency(pImpl->parameters, pImpl->sampleRate);
+}
+
+size_t DynamicsCore::getLatency(const Parameters& parameters, float sampleRate) {
+    const float lookahead = std::min(std::max(parameters.lookahead, 0.0f), kMaxLookahead);
+    return static_cast<size_t>(std::lround(lookahead * sampleRate)) + (parameters.truePeak ? kTruePeakDelay : 0);
+}
+
+float DynamicsCore::getGainReduction() const {
+    return pImpl->meter.load(std::memory_order_relaxed);
+}
+
+float DynamicsCore::computeGainReduction(float levelDb, const Parameters& parameters) {
+    const float over = levelDb - parameters.threshold;
+    if (parameters.mode == Mode::Limiter) return std::min(0.0f, -over);
+
+    const float slope = 1.0f / std::max(1.0f, parameters.ratio) - 1.0f;
+    const float knee = std::max(0.0f, parameters.knee);
+    if (over >= knee * 0.5f) return slope * over;
+    if (knee <= 0.0f || over <= -knee * 0.5f) return 0.0f;
+    const float inKnee = over + knee * 0.5f;
+    return slope * inKnee * inKnee * (0.5f / knee);
+}
+
+} // namespace VR_DAW
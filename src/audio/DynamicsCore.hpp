@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace VR_DAW {
+
+// Gemeinsamer Kern für Kompressor und Limiter. Die Kennlinie rechnet im
+// dB-Bereich (vektorisiertes log2/exp2), Attack/Release glätten die
+// Pegelreduktion in dB. Optional: Lookahead über eine Verzögerungsleitung
+// und True-Peak-Erkennung mit 4-fachem Oversampling (Polyphasen-FIR).
+// Koeffizienten werden nur neu berechnet, wenn sich Parameter ändern.
+class DynamicsCore {
+public:
+    enum class Mode : uint8_t {
+        Compressor,
+        // Ratio unendlich, threshold ist die Decke; mit Lookahead wird die
+        // Decke garantiert (gleitendes Minimum plus Rechteck-Glättung)
+        Limiter
+    };
+
+    static constexpr size_t kOversampling = 4;
+    static constexpr float kMaxLookahead = 0.02f; // Sekunden
+
+    struct Parameters {
+        Mode mode = Mode::Compressor;
+        float threshold = -20.0f; // dBFS
+        float ratio = 4.0f;
+        float knee = 6.0f;        // dB, Breite des weichen Knies
+        float attack = 0.01f;     // Sekunden; im Limiter durch lookahead ersetzt
+        float release = 0.1f;     // Sekunden
+        float makeup = 0.0f;      // dB
+        float lookahead = 0.0f;   // Sekunden, höchstens kMaxLookahead
+        bool truePeak = false;
+
+        bool operator==(const Parameters& other) const;
+        bool operator!=(const Parameters& other) const { return !(*this == other); }
+    };
+
+    DynamicsCore();
+    ~DynamicsCore();
+
+    // Alloziert die Verzögerungsleitungen, nicht im Audio-Thread aufrufen
+    void prepare(float sampleRate);
+    // Günstig bei unveränderten Werten; Koeffizienten folgen im nächsten Block
+    void setParameters(const Parameters& parameters);
+    const Parameters& getParameters() const;
+
+    // Planar, in-place; right darf nullptr sein (Mono)
+    void process(float* left, float* right, size_t numFrames);
+    // Sidechain: Pegel aus keyLeft/keyRight statt aus dem Signal (z.B. aus
+    // einem Mixer-Sidechain-Tap); keyRight darf nullptr sein
+    void process(float* left, float* right, size_t numFrames, const float* keyLeft, const float* keyRight);
+    void reset();
+
+    // Verzögerung durch Lookahead und True-Peak-Filter in Samples
+    size_t getLatency() const;
+    static size_t getLatency(const Parameters& parameters, float sampleRate);
+    // Aktuelle Pegelreduktion in dB (<= 0), für Meter
+    float getGainReduction() const;
+
+    // Statische Kennlinie: Pegelreduktion in dB für einen Eingangspegel in dB
+    static float computeGainReduction(float levelDb, const Parameters& parameters);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -1,4 +1,5 @@
 #include "DynamicsProcessor.hpp"
+#include "DynamicsCore.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -114,17 +115,9 @@ void DynamicsProcessor::prepareToPlay(double newSampleRate, int newBlockSize) {
         }
     }
 
-    // Lookahead-Delays initialisieren
-    if (compressorParams.lookahead) {
-        const float maxLookahead = 10.0f; // ms
-        const int maxDelaySamples = static_cast<int>(maxLookahead * sampleRate / 1000.0f);
-        lookaheadDelays.resize(2, juce::dsp::Delay<float>(maxDelaySamples));
-    }
-
-    // Oversampling initialisieren
-    if (limiterParams.oversampling) {
-        oversampling.initProcessing(static_cast<size_t>(blockSize));
-    }
+    // Dynamik-Kerne: Verzögerungsleitungen und Koeffizienten
+    compressorCore.prepare(static_cast<float>(sampleRate));
+    limiterCore.prepare(static_cast<float>(sampleRate));
 }
 
 void DynamicsProcessor::releaseResources() {
@@ -132,7 +125,6 @@ void DynamicsProcessor::releaseResources() {
     gainReduction.clear();
     bandBuffers.clear();
     crossoverFilters.clear();
-    lookaheadDelays.clear();
 }
 
 void DynamicsProcessor::processBlock(juce::AudioBuffer<float>& buffer) {
@@ -176,33 +168,21 @@ void DynamicsProcessor::processStandardCompressor(juce::AudioBuffer<float>& buff
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
-    // Envelope-Follower berechnen
-    for (int i = 0; i < numSamples; ++i) {
-        float maxLevel = 0.0f;
-        for (int ch = 0; ch < numChannels; ++ch) {
-            maxLevel = std::max(maxLevel, std::abs(buffer.getSample(ch, i)));
-        }
-        envelopeFollower[i] = maxLevel;
-    }
-
-    // Gain-Reduction berechnen
-    for (int i = 0; i < numSamples; ++i) {
-        gainReduction[i] = calculateGainReduction(envelopeFollower[i], compressorParams);
-    }
-
-    // Gain-Reduction anwenden
-    for (int ch = 0; ch < numChannels; ++ch) {
-        float* channelData = buffer.getWritePointer(ch);
-        for (int i = 0; i < numSamples; ++i) {
-            channelData[i] *= gainReduction[i];
-        }
-    }
-
-    // Makeup-Gain anwenden
-    if (compressorParams.autoGain) {
-        const float makeupGain = std::pow(10.0f, compressorParams.makeupGain / 20.0f);
-        buffer.applyGain(makeupGain);
-    }
+    // Der Kern vergleicht die Parameter und rechnet Koeffizienten nur bei
+    // Änderungen neu; Kennlinie, Hüllkurve und Lookahead laufen blockweise
+    DynamicsCore::Parameters core;
+    core.threshold = compressorParams.threshold;
+    core.ratio = compressorParams.ratio;
+    core.knee = compressorParams.softKnee ? compressorParams.kneeWidth : 0.0f;
+    core.attack = compressorParams.attackTime;
+    core.release = compressorParams.releaseTime;
+    core.makeup = compressorParams.autoGain ? compressorParams.makeupGain : 0.0f;
+    core.lookahead = compressorParams.lookahead ? 0.005f : 0.0f;
+    compressorCore.setParameters(core);
+
+    float* left = buffer.getWritePointer(0);
+    float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    compressorCore.process(left, right, static_cast<size_t>(numSamples));
 }
 
 void DynamicsProcessor::processMultibandCompressor(juce::AudioBuffer<float>& buffer) {
@@ -400,34 +380,19 @@ void DynamicsProcessor::processLimiter(juce::AudioBuffer<float>& buffer) {
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
-    // Oversampling aktivieren
-    if (limiterParams.oversampling) {
-        juce::dsp::AudioBlock<float> block(buffer);
-        auto oversampledBlock = oversampling.processSamplesUp(block);
-        
-        // Limiter auf oversampled Daten anwenden
-        for (int ch = 0; ch < numChannels; ++ch) {
-            float* channelData = oversampledBlock.getChannelPointer(ch);
-            for (int i = 0; i < oversampledBlock.getNumSamples(); ++i) {
-                const float inputLevel = std::abs(channelData[i]);
-                const float gainReduction = calculateLimiterGainReduction(inputLevel, limiterParams);
-                channelData[i] *= gainReduction;
-            }
-        }
-        
-        // Zurück zu Original-Sample-Rate
-        oversampling.processSamplesDown(block);
-    } else {
-        // Limiter auf Original-Daten anwenden
-        for (int ch = 0; ch < numChannels; ++ch) {
-            float* channelData = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i) {
-                const float inputLevel = std::abs(channelData[i]);
-                const float gainReduction = calculateLimiterGainReduction(inputLevel, limiterParams);
-                channelData[i] *= gainReduction;
-            }
-        }
-    }
+    // True-Peak (4x Polyphasen-Oversampling) nur in der Erkennung; das
+    // Signal selbst bleibt auf der Original-Rate
+    DynamicsCore::Parameters core;
+    core.mode = DynamicsCore::Mode::Limiter;
+    core.threshold = limiterParams.ceiling;
+    core.release = limiterParams.releaseTime;
+    core.lookahead = limiterParams.lookahead / 1000.0f;
+    core.truePeak = limiterParams.truePeak || limiterParams.oversampling;
+    limiterCore.setParameters(core);
+
+    float* left = buffer.getWritePointer(0);
+    float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    limiterCore.process(left, right, static_cast<size_t>(numSamples));
 
     // Dither hinzufügen
     if (limiterParams.ditherAmount > 0.0f) {
@@ -442,31 +407,15 @@ void DynamicsProcessor::processLimiter(juce::AudioBuffer<float>& buffer) {
 }
 
 float DynamicsProcessor::calculateGainReduction(float inputLevel, const CompressorParameters& params) {
-    const float threshold = std::pow(10.0f, params.threshold / 20.0f);
-    const float ratio = params.ratio;
-    
-    if (inputLevel <= threshold) return 1.0f;
-    
-    float gainReduction;
-    if (params.softKnee) {
-        const float kneeWidth = params.kneeWidth;
-        const float kneeStart = threshold - kneeWidth / 2.0f;
-        const float kneeEnd = threshold + kneeWidth / 2.0f;
-        
-        if (inputLevel <= kneeStart) {
-            gainReduction = 1.0f;
-        } else if (inputLevel >= kneeEnd) {
-            gainReduction = std::pow(inputLevel / threshold, 1.0f / ratio - 1.0f);
-        } else {
-            const float kneeFactor = (inputLevel - kneeStart) / kneeWidth;
-            const float softRatio = 1.0f + (ratio - 1.0f) * kneeFactor;
-            gainReduction = std::pow(inputLevel / threshold, 1.0f / softRatio - 1.0f);
-        }
-    } else {
-        gainReduction = std::pow(inputLevel / threshold, 1.0f / ratio - 1.0f);
-    }
-    
-    return std::max(0.0f, std::min(1.0f, gainReduction));
+    // Kennlinie im dB-Bereich wie im Dynamik-Kern (Knie ebenfalls in dB)
+    DynamicsCore::Parameters curve;
+    curve.threshold = params.threshold;
+    curve.ratio = params.ratio;
+    curve.knee = params.softKnee ? params.kneeWidth : 0.0f;
+
+    const float levelDb = 20.0f * std::log10(std::max(inputLevel, 1e-10f));
+    const float reductionDb = DynamicsCore::computeGainReduction(levelDb, curve);
+    return std::pow(10.0f, reductionDb / 20.0f);
 }
 
 float DynamicsProcessor::calculateVintageGainReduction(float inputLevel, const VintageParameters& params) {
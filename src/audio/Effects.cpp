@@ -1,68 +1,246 @@
 #include "Effects.hpp"
+#include "ConvolutionEngine.hpp"
+#include "../dsp/kernels/DSPKernels.hpp"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 
 namespace VR_DAW {
 
 // Basis-Effekt-Klasse
-Effects::Effects() : bypass(false), sampleRate(44100.0f) {}
+Effects::Effects() : bypass(false), sampleRate(44100.0f), resync(false) {
+    for (auto& value : values) value.store(0.0f, std::memory_order_relaxed);
+}
+
+ParameterId Effects::addParameter(ParameterInfo info) {
+    if (registry.size() >= kMaxParameters) {
+        throw std::length_error("Zu viele Parameter: " + info.name);
+    }
+    const float initial = info.defaultValue;
+    const ParameterId id = registry.add(std::move(info));
+    values[id].store(initial, std::memory_order_relaxed);
+    return id;
+}
+
+void Effects::setParameter(ParameterId id, float value) {
+    if (!registry.contains(id)) return;
+    value = registry.clamp(id, value);
+    values[id].store(value, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(producerMutex);
+        if (!changes.push(ParameterChange{0, id, value})) {
+            resync.store(true, std::memory_order_release);
+        }
+    }
+    onParameterChanged(id, value);
+}
+
+void Effects::setParameter(const std::string& name, float value) {
+    setParameter(registry.find(name), value);
+}
+
+float Effects::getParameter(ParameterId id) const {
+    return registry.contains(id) ? values[id].load(std::memory_order_relaxed) : 0.0f;
+}
+
+float Effects::getParameter(const std::string& name) const {
+    return getParameter(registry.find(name));
+}
+
+ParameterId Effects::getParameterId(const std::string& name) const {
+    return registry.find(name);
+}
+
+std::vector<std::string> Effects::getParameterNames() const {
+    return registry.getNames();
+}
+
+void Effects::automateParameter(ParameterId id, float value) {
+    if (!registry.contains(id) || !registry.getInfo(id).automatable) return;
+    value = registry.clamp(id, value);
+    values[id].store(value, std::memory_order_relaxed);
+    applyParameter(id, value);
+}
+
+void Effects::applyParameterChanges() {
+    ParameterChange change;
+    while (changes.pop(change)) applyParameter(change.id, change.value);
+
+    // Verworfene Änderungen: alle Werte neu übernehmen
+    if (resync.exchange(false, std::memory_order_acquire)) {
+        for (ParameterId id = 0; id < registry.size(); ++id) {
+            applyParameter(id, values[id].load(std::memory_order_relaxed));
+        }
+    }
+}
 
 // Reverb-Effekt
+namespace {
+
+// Synthetischer Raum: dichtes, abklingendes Rauschen je Kanal (dekorreliert),
+// das mit der Zeit dunkler wird. Die ersten skip Samples (Vorverzögerung)
+// entfallen und gleichen so die Latenz der Faltung aus.
+std::vector<std::vector<float>> makeRoomResponse(float time, float damping, float sampleRate, size_t skip) {
+    const size_t predelay = std::max(skip, static_cast<size_t>(0.012f * sampleRate));
+    const size_t decayLength = static_cast<size_t>(time * sampleRate);
+    const size_t fadeIn = static_cast<size_t>(0.005f * sampleRate) + 1;
+
+    std::vector<std::vector<float>> channels(2, std::vector<float>(predelay - skip + decayLength, 0.0f));
+    for (size_t c = 0; c < channels.size(); ++c) {
+        uint32_t noise = 0x9E3779B9u * static_cast<uint32_t>(c + 1);
+        float lowpass = 0.0f;
+        double energy = 0.0;
+        std::vector<float>& response = channels[c];
+
+        for (size_t i = 0; i < decayLength; ++i) {
+            noise ^= noise << 13;
+            noise ^= noise >> 17;
+            noise ^= noise << 5;
+            const float white = static_cast<float>(noise) * (2.0f / 4294967296.0f) - 1.0f;
+
+            // -60 dB nach time Sekunden, Höhen klingen mit damping schneller ab
+            const float position = static_cast<float>(i) / static_cast<float>(decayLength);
+            const float coefficient = damping * (0.3f + 0.65f * position);
+            lowpass += (1.0f - coefficient) * (white - lowpass);
+            const float envelope = std::exp(-6.9078f * position)
+                                 * std::min(1.0f, static_cast<float>(i) / static_cast<float>(fadeIn));
+
+            const float sample = lowpass * envelope;
+            response[predelay - skip + i] = sample;
+            energy += static_cast<double>(sample) * sample;
+        }
+
+        // Energie 1: der Hall ist etwa so laut wie das trockene Signal
+        const float gain = energy > 0.0 ? static_cast<float>(1.0 / std::sqrt(energy)) : 0.0f;
+        for (float& sample : response) sample *= gain;
+    }
+    return channels;
+}
+
+} // namespace
+
 ReverbEffect::ReverbEffect()
     : mix(0.5f)
-    , time(2.0f)
-    , damping(0.5f)
-    , writePos(0)
+    , roomResponse(true)
+    , mixSmoother(0.5f)
+    , loader(std::make_unique<ConvolutionLoader>())
+    , fadePosition(0)
+    , fadeLength(1)
+    , dryLeft(kMaxChunk), dryRight(kMaxChunk)
+    , wetLeft(kMaxChunk), wetRight(kMaxChunk)
+    , fadeLeft(kMaxChunk), fadeRight(kMaxChunk)
 {
-    delayBuffer.resize(static_cast<size_t>(sampleRate * time * 2));
+    // Zeit und Dämpfung bauen eine neue Raumantwort und laufen daher nur
+    // über den Kontroll-Thread
+    addParameter({"mix", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent, ParameterSmoother::kDefaultRampTime});
+    addParameter({"time", 0.1f, 10.0f, 2.0f, ParameterUnit::Seconds, 0.0f, false, false});
+    addParameter({"damping", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent, 0.0f, false, false});
+    requestRoomResponse();
+}
+
+ReverbEffect::~ReverbEffect() = default;
+
+void ReverbEffect::requestRoomResponse() {
+    roomResponse = true;
+    const float roomTime = getParameter(kTime);
+    const float roomDamping = getParameter(kDamping);
+    const float rate = sampleRate;
+    loader->request([roomTime, roomDamping, rate] {
+        const size_t blockSize = ConvolutionIR::kDefaultBlockSize;
+        const std::string key = "room:" + std::to_string(static_cast<int>(roomTime * 1000.0f))
+                              + ":" + std::to_string(static_cast<int>(roomDamping * 1000.0f))
+                              + ":" + std::to_string(static_cast<int>(rate));
+        return ConvolutionIRCache::get().acquire(key, blockSize, [=] {
+            return makeRoomResponse(roomTime, roomDamping, rate, blockSize);
+        });
+    });
+}
+
+void ReverbEffect::setImpulseResponse(const std::string& name, std::vector<std::vector<float>> channels) {
+    roomResponse = false;
+    auto shared = std::make_shared<std::vector<std::vector<float>>>(std::move(channels));
+    loader->request([name, shared] {
+        return ConvolutionIRCache::get().acquire("file:" + name, ConvolutionIR::kDefaultBlockSize,
+                                                 [shared] { return *shared; });
+    });
+}
+
+void ReverbEffect::waitUntilLoaded() {
+    loader->waitUntilIdle();
+}
+
+void ReverbEffect::setSampleRate(float rate) {
+    if (rate == sampleRate) return;
+    sampleRate = rate;
+    mixSmoother.prepare(rate, getParameterRegistry().getInfo(kMix).smoothingTime);
+    if (roomResponse) requestRoomResponse();
 }
 
 void ReverbEffect::process(float* buffer, unsigned long framesPerBuffer) {
+    applyParameterChanges();
     if (bypass) return;
 
-    float feedback = std::pow(0.001f, 1.0f / (time * sampleRate));
-    
-    for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-        float left = buffer[i * 2];
-        float right = buffer[i * 2 + 1];
-        
-        // Delay-Line
-        size_t delayPos = (writePos + static_cast<size_t>(time * sampleRate)) % delayBuffer.size();
-        float delayedLeft = delayBuffer[delayPos];
-        float delayedRight = delayBuffer[delayPos + 1];
-        
-        // Feedback mit Dämpfung
-        delayBuffer[writePos] = left + delayedLeft * feedback * (1.0f - damping);
-        delayBuffer[writePos + 1] = right + delayedRight * feedback * (1.0f - damping);
-        
-        // Mix
-        buffer[i * 2] = left * (1.0f - mix) + delayedLeft * mix;
-        buffer[i * 2 + 1] = right * (1.0f - mix) + delayedRight * mix;
-        
-        writePos = (writePos + 2) % delayBuffer.size();
+    // Neue Engine übernehmen und die alte kurz überblenden
+    if (!fadingEngine) {
+        if (ConvolutionEngine* next = loader->takeReady()) {
+            fadingEngine = std::move(engine);
+            engine.reset(next);
+            fadePosition = 0;
+            fadeLength = static_cast<size_t>(0.05f * sampleRate) + 1;
+        }
     }
-}
+    if (!engine) return;
+
+    // Mix-Sprünge über ParameterSmoother::kDefaultRampTime glätten
+    mixSmoother.setTarget(mix);
+    for (unsigned long done = 0; done < framesPerBuffer;) {
+        const size_t chunk = std::min<size_t>(kMaxChunk, framesPerBuffer - done);
+        float* frames = buffer + done * 2;
+
+        dsp::deinterleave(frames, dryLeft.data(), dryRight.data(), chunk);
+        engine->process(dryLeft.data(), dryRight.data(), wetLeft.data(), wetRight.data(), chunk);
 
-void ReverbEffect::setParameter(const std::string& name, float value) {
-    if (name == "mix") mix = std::max(0.0f, std::min(1.0f, value));
-    else if (name == "time") time = std::max(0.1f, std::min(10.0f, value));
-    else if (name == "damping") damping = std::max(0.0f, std::min(1.0f, value));
+        if (fadingEngine) {
+            fadingEngine->process(dryLeft.data(), dryRight.data(), fadeLeft.data(), fadeRight.data(), chunk);
+            for (size_t i = 0; i < chunk; ++i) {
+                const float gain = std::min(1.0f, static_cast<float>(fadePosition + i) / fadeLength);
+                wetLeft[i] = fadeLeft[i] + gain * (wetLeft[i] - fadeLeft[i]);
+                wetRight[i] = fadeRight[i] + gain * (wetRight[i] - fadeRight[i]);
+            }
+            fadePosition += chunk;
+            if (fadePosition >= fadeLength) {
+                // Gelöscht wird auf dem Lade-Thread
+                loader->retire(fadingEngine.release());
+            }
+        }
+
+        const ParameterRamp ramp = mixSmoother.next(chunk);
+        const float step = (ramp.end - ramp.start) / static_cast<float>(chunk);
+        for (size_t i = 0; i < chunk; ++i) {
+            const float wet = ramp.start + step * static_cast<float>(i);
+            frames[i * 2] = dryLeft[i] + (wetLeft[i] - dryLeft[i]) * wet;
+            frames[i * 2 + 1] = dryRight[i] + (wetRight[i] - dryRight[i]) * wet;
+        }
+        done += chunk;
+    }
 }
 
-float ReverbEffect::getParameter(const std::string& name) const {
-    if (name == "mix") return mix;
-    if (name == "time") return time;
-    if (name == "damping") return damping;
-    return 0.0f;
+void ReverbEffect::applyParameter(ParameterId id, float value) {
+    if (id == kMix) mix = value;
 }
 
-std::vector<std::string> ReverbEffect::getParameterNames() const {
-    return {"mix", "time", "damping"};
+void ReverbEffect::onParameterChanged(ParameterId id, float) {
+    if (id == kTime || id == kDamping) requestRoomResponse();
 }
 
 void ReverbEffect::reset() {
-    std::fill(delayBuffer.begin(), delayBuffer.end(), 0.0f);
-    writePos = 0;
+    if (engine) engine->reset();
+}
+
+size_t ReverbEffect::getLatency() const {
+    // Der synthetische Raum gleicht die Latenz über seine Vorverzögerung aus
+    return roomResponse ? 0 : ConvolutionIR::kDefaultBlockSize;
 }
 
 // Delay-Effekt
@@ -70,17 +248,39 @@ DelayEffect::DelayEffect()
     : time(0.5f)
     , feedback(0.3f)
     , mix(0.5f)
+    , feedbackSmoother(0.3f)
+    , mixSmoother(0.5f)
     , writePos(0)
 {
+    addParameter({"time", 0.0f, 2.0f, 0.5f, ParameterUnit::Seconds});
+    addParameter({"feedback", 0.0f, 0.99f, 0.3f, ParameterUnit::Percent, ParameterSmoother::kDefaultRampTime});
+    addParameter({"mix", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent, ParameterSmoother::kDefaultRampTime});
     delayBuffer.resize(static_cast<size_t>(sampleRate * 2.0f * 2));
 }
 
+void DelayEffect::setSampleRate(float rate) {
+    Effects::setSampleRate(rate);
+    feedbackSmoother.prepare(rate, getParameterRegistry().getInfo(kFeedback).smoothingTime);
+    mixSmoother.prepare(rate, getParameterRegistry().getInfo(kMix).smoothingTime);
+}
+
 void DelayEffect::process(float* buffer, unsigned long framesPerBuffer) {
+    applyParameterChanges();
     if (bypass) return;
 
     size_t delaySamples = static_cast<size_t>(time * sampleRate);
-    
+
+    // Feedback und Mix als Rampe über den Block statt in Sprüngen
+    feedbackSmoother.setTarget(feedback);
+    mixSmoother.setTarget(mix);
+    const ParameterRamp feedbackRamp = feedbackSmoother.next(framesPerBuffer);
+    const ParameterRamp mixRamp = mixSmoother.next(framesPerBuffer);
+    const float feedbackStep = framesPerBuffer > 0 ? (feedbackRamp.end - feedbackRamp.start) / framesPerBuffer : 0.0f;
+    const float mixStep = framesPerBuffer > 0 ? (mixRamp.end - mixRamp.start) / framesPerBuffer : 0.0f;
+
     for (unsigned long i = 0; i < framesPerBuffer; ++i) {
+        const float feedbackGain = feedbackRamp.start + feedbackStep * static_cast<float>(i);
+        const float wet = mixRamp.start + mixStep * static_cast<float>(i);
         float left = buffer[i * 2];
         float right = buffer[i * 2 + 1];
         
@@ -90,32 +290,23 @@ void DelayEffect::process(float* buffer, unsigned long framesPerBuffer) {
         float delayedRight = delayBuffer[delayPos + 1];
         
         // Feedback
-        delayBuffer[writePos] = left + delayedLeft * feedback;
-        delayBuffer[writePos + 1] = right + delayedRight * feedback;
+        delayBuffer[writePos] = left + delayedLeft * feedbackGain;
+        delayBuffer[writePos + 1] = right + delayedRight * feedbackGain;
         
         // Mix
-        buffer[i * 2] = left * (1.0f - mix) + delayedLeft * mix;
-        buffer[i * 2 + 1] = right * (1.0f - mix) + delayedRight * mix;
+        buffer[i * 2] = left * (1.0f - wet) + delayedLeft * wet;
+        buffer[i * 2 + 1] = right * (1.0f - wet) + delayedRight * wet;
         
         writePos = (writePos + 2) % delayBuffer.size();
     }
 }
 
-void DelayEffect::setParameter(const std::string& name, float value) {
-    if (name == "time") time = std::max(0.0f, std::min(2.0f, value));
-    else if (name == "feedback") feedback = std::max(0.0f, std::min(0.99f, value));
-    else if (name == "mix") mix = std::max(0.0f, std::min(1.0f, value));
-}
-
-float DelayEffect::getParameter(const std::string& name) const {
-    if (name == "time") return time;
-    if (name == "feedback") return feedback;
-    if (name == "mix") return mix;
-    return 0.0f;
-}
-
-std::vector<std::string> DelayEffect::getParameterNames() const {
-    return {"time", "feedback", "mix"};
+void DelayEffect::applyParameter(ParameterId id, float value) {
+    switch (id) {
+        case kTime: time = value; break;
+        case kFeedback: feedback = value; break;
+        case kMix: mix = value; break;
+    }
 }
 
 void DelayEffect::reset() {
@@ -125,59 +316,126 @@ void DelayEffect::reset() {
 
 // Compressor-Effekt
 CompressorEffect::CompressorEffect()
-    : threshold(-20.0f)
-    , ratio(4.0f)
-    , attack(0.003f)
-    , release(0.25f)
-    , envelope(0.0f)
+    : left(kMaxChunk)
+    , right(kMaxChunk)
 {
+    parameters.threshold = -20.0f;
+    parameters.ratio = 4.0f;
+    parameters.attack = 0.003f;
+    parameters.release = 0.25f;
+    addParameter({"threshold", -60.0f, 0.0f, parameters.threshold, ParameterUnit::Decibels});
+    addParameter({"ratio", 1.0f, 20.0f, parameters.ratio, ParameterUnit::Ratio});
+    addParameter({"attack", 0.001f, 1.0f, parameters.attack, ParameterUnit::Seconds});
+    addParameter({"release", 0.001f, 1.0f, parameters.release, ParameterUnit::Seconds});
+    addParameter({"knee", 0.0f, 24.0f, parameters.knee, ParameterUnit::Decibels});
+    addParameter({"makeup", 0.0f, 24.0f, parameters.makeup, ParameterUnit::Decibels});
+    addParameter({"lookahead", 0.0f, DynamicsCore::kMaxLookahead, parameters.lookahead, ParameterUnit::Seconds});
+    core.prepare(sampleRate);
+    core.setParameters(parameters);
 }
 
 void CompressorEffect::process(float* buffer, unsigned long framesPerBuffer) {
+    applyParameterChanges();
     if (bypass) return;
 
-    float attackCoeff = std::exp(-1.0f / (attack * sampleRate));
-    float releaseCoeff = std::exp(-1.0f / (release * sampleRate));
-    
-    for (unsigned long i = 0; i < framesPerBuffer * 2; ++i) {
-        float input = std::abs(buffer[i]);
-        
-        // Hüllkurve
-        if (input > envelope) {
-            envelope = attackCoeff * envelope + (1.0f - attackCoeff) * input;
-        } else {
-            envelope = releaseCoeff * envelope + (1.0f - releaseCoeff) * input;
-        }
-        
-        // Kompression
-        if (envelope > threshold) {
-            float gain = threshold + (envelope - threshold) / ratio;
-            buffer[i] *= gain / envelope;
-        }
+    for (unsigned long done = 0; done < framesPerBuffer;) {
+        const size_t chunk = std::min<size_t>(kMaxChunk, framesPerBuffer - done);
+        float* frames = buffer + done * 2;
+        dsp::deinterleave(frames, left.data(), right.data(), chunk);
+        core.process(left.data(), right.data(), chunk);
+        dsp::interleave(left.data(), right.data(), frames, chunk);
+        done += chunk;
     }
 }
 
-void CompressorEffect::setParameter(const std::string& name, float value) {
-    if (name == "threshold") threshold = std::max(-60.0f, std::min(0.0f, value));
-    else if (name == "ratio") ratio = std::max(1.0f, std::min(20.0f, value));
-    else if (name == "attack") attack = std::max(0.001f, std::min(1.0f, value));
-    else if (name == "release") release = std::max(0.001f, std::min(1.0f, value));
+void CompressorEffect::applyParameter(ParameterId id, float value) {
+    switch (id) {
+        case kThreshold: parameters.threshold = value; break;
+        case kRatio: parameters.ratio = value; break;
+        case kAttack: parameters.attack = value; break;
+        case kRelease: parameters.release = value; break;
+        case kKnee: parameters.knee = value; break;
+        case kMakeup: parameters.makeup = value; break;
+        case kLookahead: parameters.lookahead = value; break;
+        default: return;
+    }
+    core.setParameters(parameters);
 }
 
-float CompressorEffect::getParameter(const std::string& name) const {
-    if (name == "threshold") return threshold;
-    if (name == "ratio") return ratio;
-    if (name == "attack") return attack;
-    if (name == "release") return release;
-    return 0.0f;
+size_t CompressorEffect::getLatency() const {
+    // Aus den gesetzten Werten statt aus dem Kern, damit die Latenz schon
+    // vor dem nächsten Block stimmt
+    DynamicsCore::Parameters latest;
+    latest.lookahead = getParameter(kLookahead);
+    return DynamicsCore::getLatency(latest, sampleRate);
 }
 
-std::vector<std::string> CompressorEffect::getParameterNames() const {
-    return {"threshold", "ratio", "attack", "release"};
+void CompressorEffect::reset() {
+    core.reset();
 }
 
-void CompressorEffect::reset() {
-    envelope = 0.0f;
+void CompressorEffect::setSampleRate(float rate) {
+    sampleRate = rate;
+    core.prepare(rate);
+}
+
+// Limiter-Effekt
+LimiterEffect::LimiterEffect()
+    : left(kMaxChunk)
+    , right(kMaxChunk)
+{
+    parameters.mode = DynamicsCore::Mode::Limiter;
+    parameters.threshold = -1.0f;
+    parameters.release = 0.05f;
+    parameters.lookahead = 0.005f;
+    parameters.truePeak = true;
+    addParameter({"ceiling", -24.0f, 0.0f, parameters.threshold, ParameterUnit::Decibels});
+    addParameter({"release", 0.001f, 1.0f, parameters.release, ParameterUnit::Seconds});
+    addParameter({"lookahead", 0.0f, DynamicsCore::kMaxLookahead, parameters.lookahead, ParameterUnit::Seconds});
+    addParameter({"truePeak", 0.0f, 1.0f, 1.0f, ParameterUnit::Boolean, 0.0f, true});
+    core.prepare(sampleRate);
+    core.setParameters(parameters);
+}
+
+void LimiterEffect::process(float* buffer, unsigned long framesPerBuffer) {
+    applyParameterChanges();
+    if (bypass) return;
+
+    for (unsigned long done = 0; done < framesPerBuffer;) {
+        const size_t chunk = std::min<size_t>(kMaxChunk, framesPerBuffer - done);
+        float* frames = buffer + done * 2;
+        dsp::deinterleave(frames, left.data(), right.data(), chunk);
+        core.process(left.data(), right.data(), chunk);
+        dsp::interleave(left.data(), right.data(), frames, chunk);
+        done += chunk;
+    }
+}
+
+void LimiterEffect::applyParameter(ParameterId id, float value) {
+    switch (id) {
+        case kCeiling: parameters.threshold = value; break;
+        case kRelease: parameters.release = value; break;
+        case kLookahead: parameters.lookahead = value; break;
+        case kTruePeak: parameters.truePeak = value >= 0.5f; break;
+        default: return;
+    }
+    core.setParameters(parameters);
+}
+
+size_t LimiterEffect::getLatency() const {
+    DynamicsCore::Parameters latest;
+    latest.lookahead = getParameter(kLookahead);
+    latest.truePeak = getParameter(kTruePeak) >= 0.5f;
+    return DynamicsCore::getLatency(latest, sampleRate);
+}
+
+void LimiterEffect::reset() {
+    core.reset();
+}
+
+void LimiterEffect::setSampleRate(float rate) {
+    sampleRate = rate;
+    core.prepare(rate);
 }
 
 } // namespace VR_DAW 
\ No newline at end of file
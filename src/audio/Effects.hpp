@@ -1,26 +1,50 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include "DynamicsCore.hpp"
+#include "Automation.hpp"
+#include "ParameterRegistry.hpp"
 
 namespace VR_DAW {
 
+class ConvolutionEngine;
+class ConvolutionLoader;
+
 class Effects {
 public:
+    static constexpr size_t kMaxParameters = 32;
+
     Effects();
     virtual ~Effects() = default;
 
     // Basis-Funktionen
     virtual void process(float* buffer, unsigned long framesPerBuffer) = 0;
-    virtual void setParameter(const std::string& name, float value) = 0;
-    virtual float getParameter(const std::string& name) const = 0;
-    virtual std::vector<std::string> getParameterNames() const = 0;
+
+    // Parameter (Kontroll-Thread): begrenzt, gespeichert und über eine
+    // lockfreie Queue an den Audio-Thread gegeben, der sie zu Beginn von
+    // process() übernimmt. Die Namens-Varianten sind für UI und Scripting
+    void setParameter(ParameterId id, float value);
+    void setParameter(const std::string& name, float value);
+    float getParameter(ParameterId id) const;
+    float getParameter(const std::string& name) const;
+    ParameterId getParameterId(const std::string& name) const;
+    std::vector<std::string> getParameterNames() const;
+    const ParameterRegistry& getParameterRegistry() const { return registry; }
+    // Audio-Thread (Automation): sofort, ohne Queue; nur automatable Parameter
+    void automateParameter(ParameterId id, float value);
     
     // Effekt-spezifische Funktionen
     virtual void reset() = 0;
     virtual void setBypass(bool bypass) { this->bypass = bypass; }
     virtual bool isBypassed() const { return bypass; }
+    virtual void setSampleRate(float rate) { sampleRate = rate; }
+    // Verzögerung des Effekts in Samples, für den Laufzeitausgleich
+    virtual size_t getLatency() const { return 0; }
     
     // Effekt-Typ
     virtual std::string getType() const = 0;
@@ -29,36 +53,83 @@ public:
 protected:
     bool bypass;
     float sampleRate;
+
+    // Im Konstruktor in der Reihenfolge des ID-enums der Klasse aufrufen;
+    // die Member müssen mit defaultValue starten
+    ParameterId addParameter(ParameterInfo info);
+    // Audio-Thread, am Anfang von process()
+    void applyParameterChanges();
+    // Audio-Thread: begrenzten Wert übernehmen
+    virtual void applyParameter(ParameterId id, float value) = 0;
+    // Kontroll-Thread, nach jeder Änderung (z.B. für Arbeit, die allozieren muss)
+    virtual void onParameterChanged(ParameterId id, float value) { (void)id; (void)value; }
+
+private:
+    ParameterRegistry registry;
+    std::array<std::atomic<float>, kMaxParameters> values;
+    ParameterChangeQueue changes;
+    std::mutex producerMutex;
+    // Queue war voll: der Audio-Thread übernimmt alle Werte
+    std::atomic<bool> resync;
 };
 
 // Konkrete Effekt-Klassen
+
+// Faltungshall über partitionierte FFT-Faltung. Ohne geladene Antwort wird
+// aus time (RT60) und damping ein synthetischer Raum erzeugt. Impulsantworten
+// werden auf einem Hintergrund-Thread transformiert und gecacht; Instanzen
+// mit derselben Antwort teilen sich die Frequenzbereichs-Kopie.
 class ReverbEffect : public Effects {
 public:
+    enum : ParameterId { kMix, kTime, kDamping };
+
     ReverbEffect();
+    ~ReverbEffect() override;
     void process(float* buffer, unsigned long framesPerBuffer) override;
-    void setParameter(const std::string& name, float value) override;
-    float getParameter(const std::string& name) const override;
-    std::vector<std::string> getParameterNames() const override;
     void reset() override;
+    size_t getLatency() const override;
     std::string getType() const override { return "Reverb"; }
     std::string getName() const override { return "Reverb"; }
 
+    void setSampleRate(float rate) override;
+    // Eigene Antwort (ein oder zwei Kanäle, Abtastrate wie der Effekt);
+    // name identifiziert sie im Cache. time/damping schalten zurück auf den
+    // synthetischen Raum
+    void setImpulseResponse(const std::string& name, std::vector<std::vector<float>> channels);
+    // Kontroll-Thread: blockiert, bis die angeforderte Antwort gebaut ist
+    void waitUntilLoaded();
+
 private:
+    static constexpr size_t kMaxChunk = 256;
+
     float mix;
-    float time;
-    float damping;
-    std::vector<float> delayBuffer;
-    size_t writePos;
+    bool roomResponse;
+    ParameterSmoother mixSmoother;
+
+    std::unique_ptr<ConvolutionLoader> loader;
+    std::unique_ptr<ConvolutionEngine> engine;
+    // Vorherige Engine während der Überblendung nach einem Wechsel
+    std::unique_ptr<ConvolutionEngine> fadingEngine;
+    size_t fadePosition;
+    size_t fadeLength;
+
+    std::vector<float> dryLeft, dryRight;
+    std::vector<float> wetLeft, wetRight;
+    std::vector<float> fadeLeft, fadeRight;
+
+    void requestRoomResponse();
+    void applyParameter(ParameterId id, float value) override;
+    void onParameterChanged(ParameterId id, float value) override;
 };
 
 class DelayEffect : public Effects {
 public:
+    enum : ParameterId { kTime, kFeedback, kMix };
+
     DelayEffect();
     void process(float* buffer, unsigned long framesPerBuffer) override;
-    void setParameter(const std::string& name, float value) override;
-    float getParameter(const std::string& name) const override;
-    std::vector<std::string> getParameterNames() const override;
     void reset() override;
+    void setSampleRate(float rate) override;
     std::string getType() const override { return "Delay"; }
     std::string getName() const override { return "Delay"; }
 
@@ -66,27 +137,64 @@ private:
     float time;
     float feedback;
     float mix;
+    ParameterSmoother feedbackSmoother;
+    ParameterSmoother mixSmoother;
     std::vector<float> delayBuffer;
     size_t writePos;
+
+    void applyParameter(ParameterId id, float value) override;
 };
 
+// Kompressor auf dem gemeinsamen Dynamik-Kern: threshold in dBFS, Knie,
+// Make-up und optionaler Lookahead (Sekunden)
 class CompressorEffect : public Effects {
 public:
+    enum : ParameterId { kThreshold, kRatio, kAttack, kRelease, kKnee, kMakeup, kLookahead };
+
     CompressorEffect();
     void process(float* buffer, unsigned long framesPerBuffer) override;
-    void setParameter(const std::string& name, float value) override;
-    float getParameter(const std::string& name) const override;
-    std::vector<std::string> getParameterNames() const override;
     void reset() override;
+    void setSampleRate(float rate) override;
+    size_t getLatency() const override;
     std::string getType() const override { return "Compressor"; }
     std::string getName() const override { return "Compressor"; }
 
+    float getGainReduction() const { return core.getGainReduction(); }
+
+private:
+    static constexpr size_t kMaxChunk = 256;
+
+    DynamicsCore::Parameters parameters;
+    DynamicsCore core;
+    std::vector<float> left, right;
+
+    void applyParameter(ParameterId id, float value) override;
+};
+
+// Brickwall-Limiter: ceiling in dBFS, standardmäßig True-Peak mit 5 ms
+// Lookahead, damit auch Zwischen-Sample-Spitzen unter der Decke bleiben
+class LimiterEffect : public Effects {
+public:
+    enum : ParameterId { kCeiling, kRelease, kLookahead, kTruePeak };
+
+    LimiterEffect();
+    void process(float* buffer, unsigned long framesPerBuffer) override;
+    void reset() override;
+    void setSampleRate(float rate) override;
+    size_t getLatency() const override;
+    std::string getType() const override { return "Limiter"; }
+    std::string getName() const override { return "Limiter"; }
+
+    float getGainReduction() const { return core.getGainReduction(); }
+
 private:
-    float threshold;
-    float ratio;
-    float attack;
-    float release;
-    float envelope;
+    static constexpr size_t kMaxChunk = 256;
+
+    DynamicsCore::Parameters parameters;
+    DynamicsCore core;
+    std::vector<float> left, right;
+
+    void applyParameter(ParameterId id, float value) override;
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include "HRTFSet.hpp"
+#include "../dsp/FFT.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace VR_DAW {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr float kDegrees = 180.0f / 3.14159265f;
+constexpr float kRadians = 3.14159265f / 180.0f;
+
+// Auflösung der Richtungstabelle in Grad
+constexpr float kLookupStep = 2.0f;
+constexpr size_t kLookupColumns = static_cast<size_t>(360.0f / kLookupStep);
+constexpr size_t kLookupRows = static_cast<size_t>(180.0f / kLookupStep) + 1;
+
+constexpr char kRawMagic[4] = {'H', 'R', 'I', 'R'};
+constexpr uint32_t kRawVersion = 1;
+
+constexpr float kSpeedOfSound = 343.0f;
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+void directionToVector(float azimuth, float elevation, float& x, float& y, float& z) {
+    const float az = azimuth * kRadians;
+    const float el = elevation * kRadians;
+    x = -std::sin(az) * std::cos(el);
+    y = std::sin(el);
+    z = -std::cos(az) * std::cos(el);
+}
+
+template <typename T>
+void readValue(std::ifstream& file, T& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!file) {
+        throw std::runtime_error("HRIR-Datei ist unvollständig");
+    }
+}
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+} // namespace
+
+std::shared_ptr<const HRTFSet> HRTFSet::create(const std::vector<Measurement>& measurements,
+                                               float sampleRate) {
+    if (measurements.empty()) {
+        throw std::invalid_argument("HRTF-Satz ohne Messrichtungen");
+    }
+    if (!(sampleRate > 0.0f)) {
+        throw std::invalid_argument("HRTF-Satz ohne gültige Abtastrate");
+    }
+
+    std::shared_ptr<HRTFSet> set(new HRTFSet());
+    set->sampleRate = sampleRate;
+    for (const auto& m : measurements) {
+        set->filterLength = std::max({set->filterLength, m.left.size(), m.right.size()});
+    }
+    if (set->filterLength == 0 || set->filterLength > kMaxFilterLength) {
+        throw std::invalid_argument("HRIR-Länge muss zwischen 1 und 1024 Taps liegen");
+    }
+    set->blockSize = std::max<size_t>(nextPowerOfTwo(set->filterLength), 16);
+
+    const size_t directions = measurements.size();
+    const size_t numBins = set->getNumBins();
+    set->azimuths.reserve(directions);
+    set->elevations.reserve(directions);
+    set->impulseResponses.reserve(directions * 2);
+    set->spectraRe.assign((directions + 1) * 2 * numBins, 0.0f);
+    set->spectraIm.assign(set->spectraRe.size(), 0.0f);
+
+    dsp::RealFFT fft(set->blockSize * 2);
+    const float scale = 1.0f / static_cast<float>(set->blockSize * 2);
+    std::vector<float> frame(set->blockSize * 2);
+
+    auto transform = [&](size_t direction, size_t ear, const std::vector<float>& response) {
+        // HRIR in der ersten Hälfte, Rest Nullen (Overlap-Save)
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        for (size_t i = 0; i < response.size(); ++i) {
+            frame[i] = response[i] * scale;
+        }
+        fft.forward(frame.data(),
+                    &set->spectraRe[(direction * 2 + ear) * numBins],
+                    &set->spectraIm[(direction * 2 + ear) * numBins]);
+    };
+
+    for (size_t d = 0; d < directions; ++d) {
+        const Measurement& m = measurements[d];
+        float azimuth = std::fmod(m.azimuth, 360.0f);
+        if (azimuth < 0.0f) azimuth += 360.0f;
+        set->azimuths.push_back(azimuth);
+        set->elevations.push_back(std::clamp(m.elevation, -90.0f, 90.0f));
+
+        for (size_t ear = 0; ear < 2; ++ear) {
+            std::vector<float> padded(ear == 0 ? m.left : m.right);
+            padded.resize(set->filterLength, 0.0f);
+            transform(d, ear, padded);
+            set->impulseResponses.push_back(std::move(padded));
+        }
+    }
+
+    // Bypass: Einheitsimpuls auf beiden Ohren
+    const std::vector<float> unit{1.0f};
+    transform(directions, 0, unit);
+    transform(directions, 1, unit);
+
+    // Richtungstabelle: für jede Zelle die Messrichtung mit dem kleinsten
+    // Winkelabstand (größtes Skalarprodukt)
+    std::vector<float> vx(directions), vy(directions), vz(directions);
+    for (size_t d = 0; d < directions; ++d) {
+        directionToVector(set->azimuths[d], set->elevations[d], vx[d], vy[d], vz[d]);
+    }
+    set->lookup.resize(kLookupRows * kLookupColumns);
+    for (size_t row = 0; row < kLookupRows; ++row) {
+        for (size_t column = 0; column < kLookupColumns; ++column) {
+            float x, y, z;
+            directionToVector(column * kLookupStep, row * kLookupStep - 90.0f, x, y, z);
+            size_t best = 0;
+            float bestDot = -2.0f;
+            for (size_t d = 0; d < directions; ++d) {
+                const float dot = x * vx[d] + y * vy[d] + z * vz[d];
+                if (dot > bestDot) {
+                    bestDot = dot;
+                    best = d;
+                }
+            }
+            set->lookup[row * kLookupColumns + column] = static_cast<uint32_t>(best);
+        }
+    }
+
+    return set;
+}
+
+size_t HRTFSet::findNearest(float x, float y, float z) const {
+    const float length = std::sqrt(x * x + y * y + z * z);
+    if (length < 1e-6f) {
+        return lookup[(kLookupRows / 2) * kLookupColumns];
+    }
+    float azimuth = std::atan2(-x, -z) * kDegrees;
+    if (azimuth < 0.0f) azimuth += 360.0f;
+    const float elevation = std::asin(std::clamp(y / length, -1.0f, 1.0f)) * kDegrees;
+
+    const size_t column = static_cast<size_t>(azimuth / kLookupStep + 0.5f) % kLookupColumns;
+    const size_t row = std::min(static_cast<size_t>((elevation + 90.0f) / kLookupStep + 0.5f),
+                                kLookupRows - 1);
+    return lookup[row * kLookupColumns + column];
+}
+
+size_t HRTFSet::getMemoryBytes() const {
+    size_t bytes = (spectraRe.size() + spectraIm.size()) * sizeof(float)
+                 + lookup.size() * sizeof(uint32_t);
+    for (const auto& response : impulseResponses) {
+        bytes += response.size() * sizeof(float);
+    }
+    return bytes;
+}
+
+std::shared_ptr<const HRTFSet> HRTFSet::loadRaw(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("HRIR-Datei nicht lesbar: " + path);
+    }
+
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    uint32_t version = 0, directions = 0, taps = 0;
+    float sampleRate = 0.0f;
+    if (!file || std::memcmp(magic, kRawMagic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Keine HRIR-Rohdatei: " + path);
+    }
+    readValue(file, version);
+    readValue(file, directions);
+    readValue(file, taps);
+    readValue(file, sampleRate);
+    if (version != kRawVersion) {
+        throw std::runtime_error("Nicht unterstützte HRIR-Version " + std::to_string(version));
+    }
+    if (directions == 0 || taps == 0 || taps > kMaxFilterLength) {
+        throw std::runtime_error("Ungültiger HRIR-Kopf in " + path);
+    }
+
+    std::vector<Measurement> measurements(directions);
+    for (auto& m : measurements) {
+        readValue(file, m.azimuth);
+        readValue(file, m.elevation);
+        m.left.resize(taps);
+        m.right.resize(taps);
+        file.read(reinterpret_cast<char*>(m.left.data()), taps * sizeof(float));
+        file.read(reinterpret_cast<char*>(m.right.data()), taps * sizeof(float));
+        if (!file) {
+            throw std::runtime_error("HRIR-Datei ist unvollständig");
+        }
+    }
+    return create(measurements, sampleRate);
+}
+
+void HRTFSet::saveRaw(const std::string& path, const std::vector<Measurement>& measurements,
+                      float sampleRate) {
+    size_t taps = 0;
+    for (const auto& m : measurements) {
+        taps = std::max({taps, m.left.size(), m.right.size()});
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("HRIR-Datei nicht schreibbar: " + path);
+    }
+    file.write(kRawMagic, sizeof(kRawMagic));
+    writeValue(file, kRawVersion);
+    writeValue(file, static_cast<uint32_t>(measurements.size()));
+    writeValue(file, static_cast<uint32_t>(taps));
+    writeValue(file, sampleRate);
+
+    std::vector<float> padded(taps);
+    for (const auto& m : measurements) {
+        writeValue(file, m.azimuth);
+        writeValue(file, m.elevation);
+        for (const std::vector<float>* response : {&m.left, &m.right}) {
+            std::fill(padded.begin(), padded.end(), 0.0f);
+            std::copy(response->begin(), response->end(), padded.begin());
+            file.write(reinterpret_cast<const char*>(padded.data()), taps * sizeof(float));
+        }
+    }
+    if (!file) {
+        throw std::runtime_error("HRIR-Datei konnte nicht geschrieben werden: " + path);
+    }
+}
+
+std::shared_ptr<const HRTFSet> HRTFSet::createSphericalHead(float sampleRate, float headRadius) {
+    // Kopfabschattung nach Brown/Duda: Hochpass-Shelf mit Eckfrequenz c/a,
+    // alpha(theta) von 2 (Schall direkt aufs Ohr) bis 0.1 (Schattenseite)
+    constexpr double kAlphaMin = 0.1;
+    constexpr double kThetaMin = 150.0 * kPi / 180.0;
+    // Vorlauf, damit die Einschwinger der gebrochenen Verzögerung kausal sind
+    constexpr double kBulkDelay = 8.0;
+    constexpr size_t kFadeLength = 16;
+
+    const size_t length = sampleRate > 50000.0f ? 256 : 128;
+    const size_t fftSize = length * 2;
+    const double radiusTime = headRadius / kSpeedOfSound;
+    const double cornerFrequency = kSpeedOfSound / headRadius;
+
+    dsp::RealFFT fft(fftSize);
+    const size_t numBins = fft.getNumBins();
+    std::vector<float> re(numBins), im(numBins), time(fftSize);
+
+    auto design = [&](double theta, std::vector<float>& response) {
+        const double alpha = (1.0 + kAlphaMin / 2.0)
+                           + (1.0 - kAlphaMin / 2.0) * std::cos(theta / kThetaMin * kPi);
+        // Woodworth: Laufzeit relativ zum Kopfmittelpunkt, um a/c verschoben
+        const double delay = theta < kPi / 2.0
+            ? radiusTime - radiusTime * std::cos(theta)
+            : radiusTime + radiusTime * (theta - kPi / 2.0);
+        const double delaySamples = kBulkDelay + delay * sampleRate;
+
+        for (size_t k = 0; k < numBins; ++k) {
+            const double omega = 2.0 * kPi * k * sampleRate / fftSize;
+            const std::complex<double> shadow(1.0, alpha * omega / (2.0 * cornerFrequency));
+            const std::complex<double> pole(1.0, omega / (2.0 * cornerFrequency));
+            const double phase = -2.0 * kPi * k * delaySamples / fftSize;
+            std::complex<double> value = shadow / pole * std::polar(1.0, phase);
+            if (k == numBins - 1) value = std::complex<double>(value.real(), 0.0);
+            re[k] = static_cast<float>(value.real());
+            im[k] = static_cast<float>(value.imag());
+        }
+        fft.inverse(re.data(), im.data(), time.data());
+
+        response.resize(length);
+        for (size_t i = 0; i < length; ++i) {
+            response[i] = time[i] / static_cast<float>(fftSize);
+        }
+        for (size_t i = 0; i < kFadeLength; ++i) {
+            const double fade = 0.5 + 0.5 * std::cos(kPi * (i + 1) / kFadeLength);
+            response[length - kFadeLength + i] *= static_cast<float>(fade);
+        }
+    };
+
+    // 5°-Raster am Äquator, zu den Polen hin ausgedünnt
+    std::vector<Measurement> measurements;
+    for (int elevation = -40; elevation <= 90; elevation += 10) {
+        const double ring = std::cos(elevation * kPi / 180.0);
+        const int count = std::max(1, static_cast<int>(std::lround(72.0 * ring)));
+        for (int i = 0; i < count; ++i) {
+            Measurement m;
+            m.azimuth = 360.0f * i / count;
+            m.elevation = static_cast<float>(elevation);
+
+            float x, y, z;
+            directionToVector(m.azimuth, m.elevation, x, y, z);
+            // Winkel zur linken (-x) bzw. rechten (+x) Ohrachse
+            design(std::acos(std::clamp(-static_cast<double>(x), -1.0, 1.0)), m.left);
+            design(std::acos(std::clamp(static_cast<double>(x), -1.0, 1.0)), m.right);
+            measurements.push_back(std::move(m));
+        }
+    }
+    return create(measurements, sampleRate);
+}
+
+} // namespace VR_DAW
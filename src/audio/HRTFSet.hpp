@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VR_DAW {
+
+// Kopfbezogene Impulsantworten (ein HRIR-Paar je Messrichtung), vorab in
+// den Frequenzbereich transformiert. Unveränderlich nach dem Aufbau; alle
+// BinauralRenderer teilen sich eine Instanz über shared_ptr.
+//
+// Richtungen im Hörerraum wie in glm/OpenGL: +x rechts, +y oben, -z vorne.
+// Azimut/Elevation in Grad nach SOFA-Konvention: Azimut 0 vorne, 90 links,
+// Elevation 90 oben.
+class HRTFSet {
+public:
+    static constexpr size_t kMaxFilterLength = 1024;
+    static constexpr float kDefaultHeadRadius = 0.0875f;
+
+    struct Measurement {
+        float azimuth = 0.0f;
+        float elevation = 0.0f;
+        std::vector<float> left;
+        std::vector<float> right;
+    };
+
+    // Teuer (FFT je Richtung, Richtungstabelle), nicht im Audio-Thread
+    // aufrufen. Wirft std::invalid_argument bei leeren oder zu langen Sätzen
+    static std::shared_ptr<const HRTFSet> create(const std::vector<Measurement>& measurements,
+                                                 float sampleRate);
+
+    // Rohformat (little-endian): "HRIR", uint32 Version (1), uint32
+    // Richtungen, uint32 Taps, float32 Abtastrate, dann je Richtung float32
+    // Azimut, float32 Elevation, Taps x float32 links, Taps x float32 rechts.
+    // SOFA-Dateien (netCDF/HDF5) lassen sich damit nach einer Konvertierung
+    // laden. Wirft std::runtime_error bei Lese- oder Formatfehlern
+    static std::shared_ptr<const HRTFSet> loadRaw(const std::string& path);
+    static void saveRaw(const std::string& path, const std::vector<Measurement>& measurements,
+                        float sampleRate);
+
+    // Eingebauter Satz aus dem Kugelkopfmodell (Brown/Duda): Laufzeit nach
+    // Woodworth plus Kopfabschattung erster Ordnung. Ohne Ohrmuschel-Anteil,
+    // Elevation wirkt daher nur über den Winkel zur Ohrachse
+    static std::shared_ptr<const HRTFSet> createSphericalHead(float sampleRate,
+                                                              float headRadius = kDefaultHeadRadius);
+
+    float getSampleRate() const { return sampleRate; }
+    size_t getFilterLength() const { return filterLength; }
+    // Renderer-Blockgröße = Filterlänge als Zweierpotenz (eine Partition)
+    size_t getBlockSize() const { return blockSize; }
+    size_t getNumBins() const { return blockSize + 1; }
+    size_t getNumDirections() const { return azimuths.size(); }
+    size_t getMemoryBytes() const;
+
+    float getAzimuth(size_t direction) const { return azimuths[direction]; }
+    float getElevation(size_t direction) const { return elevations[direction]; }
+
+    // Nächste Messrichtung über eine vorberechnete 2°-Tabelle; Richtung
+    // muss nicht normiert sein. Allokationsfrei, für den Audio-Thread
+    size_t findNearest(float x, float y, float z) const;
+
+    // Index hinter der letzten Messrichtung: flacher Filter für nicht
+    // räumliche Quellen (gleiche Latenz wie die HRIRs)
+    size_t getBypassIndex() const { return azimuths.size(); }
+
+    // ear: 0 links, 1 rechts. Zeitbereich ohne, Spektren mit 1/FFT-Größe
+    const std::vector<float>& getImpulseResponse(size_t direction, size_t ear) const {
+        return impulseResponses[direction * 2 + ear];
+    }
+    const float* getSpectrumRe(size_t direction, size_t ear) const {
+        return &spectraRe[(direction * 2 + ear) * getNumBins()];
+    }
+    const float* getSpectrumIm(size_t direction, size_t ear) const {
+        return &spectraIm[(direction * 2 + ear) * getNumBins()];
+    }
+
+private:
+    HRTFSet() = default;
+
+    float sampleRate = 0.0f;
+    size_t filterLength = 0;
+    size_t blockSize = 0;
+    std::vector<float> azimuths;
+    std::vector<float> elevations;
+    std::vector<std::vector<float>> impulseResponses;
+    // [Richtung inkl. Bypass][Ohr][Bin]
+    std::vector<float> spectraRe;
+    std::vector<float> spectraIm;
+    // [Elevationszelle][Azimutzelle] -> Richtung
+    std::vector<uint32_t> lookup;
+};
+
+} // namespace VR_DAW
@@ -1,10 +1,158 @@
 #include "Mixer.hpp"
+#include "AudioWorkerPool.hpp"
+#include "Automation.hpp"
+#include "../dsp/kernels/DSPKernels.hpp"
 #include <algorithm>
 #include <stdexcept>
 
 namespace VR_DAW {
 
-Mixer::Mixer() : nextTrackId(0) {}
+namespace {
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+template <typename Channel>
+Channel* findChannel(std::vector<Channel>& channels, int id) {
+    auto it = std::find_if(channels.begin(), channels.end(),
+                           [id](const Channel& channel) { return channel.id == id; });
+    return it != channels.end() ? &(*it) : nullptr;
+}
+
+} // namespace
+
+// Kompilierter Routing-Graph. Knotenpuffer halten das Signal hinter den
+// Inserts, vor dem Fader; Fader, Pan und Mute wirken beim Abholen über
+// die Kanten, geglättet als Rampe pro Block. Jede Kante gehört ihrem Ziel,
+// das sie als Einziges liest und schreibt (Glätter, Verzögerungsleitung)
+struct Mixer::Plan {
+    enum class Kind : uint8_t { Track, Bus, Master };
+    enum class EdgeKind : uint8_t { Output, Send, Sidechain };
+
+    struct Node {
+        Kind kind = Kind::Master;
+        int id = kMasterBusId;
+        size_t index = 0;             // in tracks bzw. buses
+        InsertProcessor insert;
+        size_t insertLatency = 0;
+        size_t inputLatency = 0;
+        size_t outputLatency = 0;
+        bool hasSidechain = false;
+        uint32_t firstInput = 0;
+        uint32_t inputCount = 0;
+        std::vector<float> left, right, sideLeft, sideRight;
+    };
+
+    struct Edge {
+        EdgeKind kind = EdgeKind::Output;
+        uint32_t from = 0;
+        uint32_t to = 0;
+        size_t send = 0;              // Index in sends (EdgeKind::Send)
+        int routingId = -1;           // Send- bzw. Tap-ID
+        bool preFader = false;
+        // Wirksamer Pegel je Kanal inkl. Fader, Pan, Mute und Solo
+        ParameterSmoother leftSmoother;
+        ParameterSmoother rightSmoother;
+        bool fresh = true;            // erster Zielwert ohne Rampe
+        size_t delay = 0;
+        std::vector<float> delayLeft, delayRight;
+        size_t delayMask = 0;
+        size_t delayPosition = 0;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;          // nach Ziel sortiert
+    std::unordered_map<int, uint32_t> nodeOfChannel;
+    AudioTaskGraph graph;
+    uint32_t master = 0;
+    size_t maxFrames = 0;
+
+    // Aktueller Durchlauf
+    const std::vector<Track>* tracks = nullptr;
+    size_t offset = 0;
+    size_t frames = 0;
+
+    static void mixChannel(float* dst, const float* src, const ParameterRamp& ramp, size_t numFrames) {
+        if (ramp.start != ramp.end) {
+            dsp::multiplyAddRamp(dst, src, numFrames, ramp.start, ramp.end);
+        } else if (ramp.start != 0.0f) {
+            dsp::multiplyAdd(dst, src, numFrames, ramp.start);
+        }
+    }
+
+    static void mixEdge(Edge& edge, const Node& source, float* left, float* right, size_t numFrames) {
+        const ParameterRamp leftRamp = edge.leftSmoother.next(numFrames);
+        const ParameterRamp rightRamp = edge.rightSmoother.next(numFrames);
+        if (edge.delay == 0) {
+            mixChannel(left, source.left.data(), leftRamp, numFrames);
+            mixChannel(right, source.right.data(), rightRamp, numFrames);
+            return;
+        }
+        // Auch bei Pegel 0 durchlaufen, damit die Leitung leer läuft
+        const float leftStep = (leftRamp.end - leftRamp.start) / static_cast<float>(numFrames);
+        const float rightStep = (rightRamp.end - rightRamp.start) / static_cast<float>(numFrames);
+        float* lineLeft = edge.delayLeft.data();
+        float* lineRight = edge.delayRight.data();
+        size_t position = edge.delayPosition;
+        for (size_t i = 0; i < numFrames; ++i, ++position) {
+            const size_t write = position & edge.delayMask;
+            const size_t read = (position - edge.delay) & edge.delayMask;
+            lineLeft[write] = source.left[i] * (leftRamp.start + leftStep * static_cast<float>(i));
+            lineRight[write] = source.right[i] * (rightRamp.start + rightStep * static_cast<float>(i));
+            left[i] += lineLeft[read];
+            right[i] += lineRight[read];
+        }
+        edge.delayPosition = position & edge.delayMask;
+    }
+
+    void processNode(uint32_t index) {
+        Node& node = nodes[index];
+        float* left = node.left.data();
+        float* right = node.right.data();
+
+        size_t count = 0;
+        if (node.kind == Kind::Track) {
+            const std::vector<float>& buffer = (*tracks)[node.index].buffer;
+            const size_t available = buffer.size() / 2;
+            count = offset < available ? std::min(frames, available - offset) : 0;
+            dsp::deinterleave(buffer.data() + offset * 2, left, right, count);
+        }
+        std::fill(left + count, left + frames, 0.0f);
+        std::fill(right + count, right + frames, 0.0f);
+        if (node.hasSidechain) {
+            std::fill(node.sideLeft.begin(), node.sideLeft.begin() + frames, 0.0f);
+            std::fill(node.sideRight.begin(), node.sideRight.begin() + frames, 0.0f);
+        }
+
+        for (uint32_t e = node.firstInput; e < node.firstInput + node.inputCount; ++e) {
+            Edge& edge = edges[e];
+            const Node& source = nodes[edge.from];
+            if (edge.kind == EdgeKind::Sidechain) {
+                mixEdge(edge, source, node.sideLeft.data(), node.sideRight.data(), frames);
+            } else {
+                mixEdge(edge, source, left, right, frames);
+            }
+        }
+
+        if (node.kind != Kind::Master && node.insert) {
+            node.insert(left, right, node.hasSidechain ? node.sideLeft.data() : nullptr,
+                        node.hasSidechain ? node.sideRight.data() : nullptr, frames);
+        }
+    }
+};
+
+Mixer::Mixer()
+    : nextTrackId(0)
+    , nextRoutingId(0)
+    , maxBlockSize(kDefaultMaxBlockSize)
+    , sampleRate(44100.0f)
+    , workerPool(nullptr)
+{
+    rebuildPlan();
+}
 
 Mixer::~Mixer() = default;
 
@@ -17,8 +165,9 @@ int Mixer::createTrack(const std::string& name) {
     track.muted = false;
     track.solo = false;
     track.buffer.resize(4096); // Standard-Buffer-Größe
-    
+
     tracks.push_back(track);
+    rebuildPlan();
     return track.id;
 }
 
@@ -27,23 +176,209 @@ void Mixer::deleteTrack(int trackId) {
                           [trackId](const Track& track) { return track.id == trackId; });
     if (it != tracks.end()) {
         tracks.erase(it);
+        sends.erase(std::remove_if(sends.begin(), sends.end(),
+                                   [trackId](const Send& send) { return send.source == trackId; }),
+                    sends.end());
+        sidechains.erase(std::remove_if(sidechains.begin(), sidechains.end(),
+                                        [trackId](const SidechainTap& tap) {
+                                            return tap.source == trackId || tap.destination == trackId;
+                                        }),
+                         sidechains.end());
+        inserts.erase(trackId);
+        rebuildPlan();
     }
 }
 
 Track* Mixer::getTrack(int trackId) {
-    auto it = std::find_if(tracks.begin(), tracks.end(),
-                          [trackId](const Track& track) { return track.id == trackId; });
-    return it != tracks.end() ? &(*it) : nullptr;
+    return findChannel(tracks, trackId);
 }
 
 std::vector<Track>& Mixer::getTracks() {
     return tracks;
 }
 
+int Mixer::createBus(const std::string& name) {
+    Bus bus;
+    bus.id = nextTrackId++;
+    bus.name = name;
+    buses.push_back(bus);
+    rebuildPlan();
+    return bus.id;
+}
+
+void Mixer::deleteBus(int busId) {
+    auto it = std::find_if(buses.begin(), buses.end(), [busId](const Bus& bus) { return bus.id == busId; });
+    if (it == buses.end()) return;
+    buses.erase(it);
+
+    for (auto& track : tracks) {
+        if (track.output == busId) track.output = kMasterBusId;
+    }
+    for (auto& bus : buses) {
+        if (bus.output == busId) bus.output = kMasterBusId;
+    }
+    sends.erase(std::remove_if(sends.begin(), sends.end(),
+                               [busId](const Send& send) {
+                                   return send.source == busId || send.destination == busId;
+                               }),
+                sends.end());
+    sidechains.erase(std::remove_if(sidechains.begin(), sidechains.end(),
+                                    [busId](const SidechainTap& tap) {
+                                        return tap.source == busId || tap.destination == busId;
+                                    }),
+                     sidechains.end());
+    inserts.erase(busId);
+    rebuildPlan();
+}
+
+Bus* Mixer::getBus(int busId) {
+    return findChannel(buses, busId);
+}
+
+const std::vector<Bus>& Mixer::getBuses() const {
+    return buses;
+}
+
+bool Mixer::setOutput(int channelId, int destination) {
+    if (destination != kMasterBusId && !findChannel(buses, destination)) return false;
+
+    int* output = nullptr;
+    if (Track* track = getTrack(channelId)) output = &track->output;
+    if (Bus* bus = getBus(channelId)) output = &bus->output;
+    if (!output) return false;
+
+    const int previous = *output;
+    *output = destination;
+    if (!rebuildPlan()) {
+        *output = previous;
+        rebuildPlan();
+        return false;
+    }
+    return true;
+}
+
+int Mixer::addSend(int source, int destination, float gain, bool preFader) {
+    if (!exists(source) || !findChannel(buses, destination)) return -1;
+
+    Send send;
+    send.id = nextRoutingId++;
+    send.source = source;
+    send.destination = destination;
+    send.gain = std::max(0.0f, gain);
+    send.preFader = preFader;
+    sends.push_back(send);
+    if (!rebuildPlan()) {
+        sends.pop_back();
+        rebuildPlan();
+        return -1;
+    }
+    return send.id;
+}
+
+void Mixer::removeSend(int sendId) {
+    auto it = std::find_if(sends.begin(), sends.end(), [sendId](const Send& send) { return send.id == sendId; });
+    if (it != sends.end()) {
+        sends.erase(it);
+        rebuildPlan();
+    }
+}
+
+void Mixer::setSendGain(int sendId, float gain) {
+    Send* send = findChannel(sends, sendId);
+    if (send) {
+        send->gain = std::max(0.0f, gain);
+        updateTrackStates();
+    }
+}
+
+const std::vector<Send>& Mixer::getSends() const {
+    return sends;
+}
+
+int Mixer::addSidechain(int source, int destination, bool preFader) {
+    if (!exists(source) || !exists(destination)) return -1;
+
+    SidechainTap tap;
+    tap.id = nextRoutingId++;
+    tap.source = source;
+    tap.destination = destination;
+    tap.preFader = preFader;
+    sidechains.push_back(tap);
+    if (!rebuildPlan()) {
+        sidechains.pop_back();
+        rebuildPlan();
+        return -1;
+    }
+    return tap.id;
+}
+
+void Mixer::removeSidechain(int tapId) {
+    auto it = std::find_if(sidechains.begin(), sidechains.end(),
+                           [tapId](const SidechainTap& tap) { return tap.id == tapId; });
+    if (it != sidechains.end()) {
+        sidechains.erase(it);
+        rebuildPlan();
+    }
+}
+
+const std::vector<SidechainTap>& Mixer::getSidechains() const {
+    return sidechains;
+}
+
+void Mixer::setInsert(int channelId, InsertProcessor processor, size_t latency) {
+    if (!exists(channelId)) return;
+    inserts[channelId] = Insert{std::move(processor), latency};
+    rebuildPlan();
+}
+
+void Mixer::setInsertLatency(int channelId, size_t latency) {
+    auto it = inserts.find(channelId);
+    if (it != inserts.end() && it->second.latency != latency) {
+        it->second.latency = latency;
+        rebuildPlan();
+    }
+}
+
+void Mixer::removeInsert(int channelId) {
+    if (inserts.erase(channelId)) rebuildPlan();
+}
+
+size_t Mixer::getLatency() const {
+    return plan->nodes[plan->master].inputLatency;
+}
+
+size_t Mixer::getCompensation(int channelId) const {
+    auto it = plan->nodeOfChannel.find(channelId);
+    if (it == plan->nodeOfChannel.end()) return 0;
+    for (const auto& edge : plan->edges) {
+        if (edge.from == it->second && edge.kind == Plan::EdgeKind::Output) return edge.delay;
+    }
+    return 0;
+}
+
+void Mixer::setMaxBlockSize(size_t frames) {
+    if (frames > 0 && frames != maxBlockSize) {
+        maxBlockSize = frames;
+        rebuildPlan();
+    }
+}
+
+void Mixer::setSampleRate(float rate) {
+    if (rate > 0.0f && rate != sampleRate) {
+        sampleRate = rate;
+        rebuildPlan();
+    }
+}
+
+void Mixer::setWorkerPool(AudioWorkerPool* pool) {
+    workerPool = pool;
+}
+
 void Mixer::setTrackVolume(int trackId, float volume) {
     Track* track = getTrack(trackId);
     if (track) {
         track->volume = std::max(0.0f, std::min(1.0f, volume));
+        updateTrackStates();
     }
 }
 
@@ -51,6 +386,7 @@ void Mixer::setTrackPan(int trackId, float pan) {
     Track* track = getTrack(trackId);
     if (track) {
         track->pan = std::max(-1.0f, std::min(1.0f, pan));
+        updateTrackStates();
     }
 }
 
@@ -58,6 +394,7 @@ void Mixer::muteTrack(int trackId) {
     Track* track = getTrack(trackId);
     if (track) {
         track->muted = true;
+        updateTrackStates();
     }
 }
 
@@ -73,6 +410,7 @@ void Mixer::unmuteTrack(int trackId) {
     Track* track = getTrack(trackId);
     if (track) {
         track->muted = false;
+        updateTrackStates();
     }
 }
 
@@ -84,53 +422,286 @@ void Mixer::unsoloTrack(int trackId) {
     }
 }
 
+void Mixer::setBusVolume(int busId, float volume) {
+    Bus* bus = getBus(busId);
+    if (bus) {
+        bus->volume = std::max(0.0f, std::min(1.0f, volume));
+        updateTrackStates();
+    }
+}
+
+void Mixer::setBusPan(int busId, float pan) {
+    Bus* bus = getBus(busId);
+    if (bus) {
+        bus->pan = std::max(-1.0f, std::min(1.0f, pan));
+        updateTrackStates();
+    }
+}
+
+void Mixer::muteBus(int busId, bool mute) {
+    Bus* bus = getBus(busId);
+    if (bus) {
+        bus->muted = mute;
+        updateTrackStates();
+    }
+}
+
+void Mixer::soloBus(int busId, bool solo) {
+    Bus* bus = getBus(busId);
+    if (bus) {
+        bus->solo = solo;
+        updateTrackStates();
+    }
+}
+
 void Mixer::process(float* output, unsigned long framesPerBuffer) {
     // Buffer löschen
     std::fill(output, output + framesPerBuffer * 2, 0.0f);
-    
-    // Tracks mischen
-    mixTracks(output, framesPerBuffer);
+
+    // Graph in Blöcken bis maxBlockSize abarbeiten
+    for (size_t done = 0; done < framesPerBuffer;) {
+        const size_t chunk = std::min<size_t>(maxBlockSize, framesPerBuffer - done);
+        plan->offset = done;
+        mixTracks(output + done * 2, chunk);
+        done += chunk;
+    }
 }
 
 void Mixer::clear() {
     tracks.clear();
+    buses.clear();
+    sends.clear();
+    sidechains.clear();
+    inserts.clear();
     nextTrackId = 0;
+    nextRoutingId = 0;
+    rebuildPlan();
+}
+
+bool Mixer::exists(int channelId) const {
+    return std::any_of(tracks.begin(), tracks.end(), [channelId](const Track& t) { return t.id == channelId; })
+        || std::any_of(buses.begin(), buses.end(), [channelId](const Bus& b) { return b.id == channelId; });
+}
+
+bool Mixer::rebuildPlan() {
+    auto next = std::make_unique<Plan>();
+    Plan& p = *next;
+    p.maxFrames = maxBlockSize;
+
+    auto addNode = [&p](Plan::Kind kind, int id, size_t index) {
+        Plan::Node node;
+        node.kind = kind;
+        node.id = id;
+        node.index = index;
+        p.nodeOfChannel[id] = static_cast<uint32_t>(p.nodes.size());
+        p.nodes.push_back(std::move(node));
+    };
+    for (size_t i = 0; i < tracks.size(); ++i) addNode(Plan::Kind::Track, tracks[i].id, i);
+    for (size_t i = 0; i < buses.size(); ++i) addNode(Plan::Kind::Bus, buses[i].id, i);
+    addNode(Plan::Kind::Master, kMasterBusId, 0);
+    p.master = static_cast<uint32_t>(p.nodes.size() - 1);
+
+    auto addEdge = [&p](Plan::EdgeKind kind, int from, int to) -> Plan::Edge* {
+        auto source = p.nodeOfChannel.find(from);
+        auto destination = p.nodeOfChannel.find(to);
+        if (source == p.nodeOfChannel.end() || destination == p.nodeOfChannel.end()) return nullptr;
+        Plan::Edge edge;
+        edge.kind = kind;
+        edge.from = source->second;
+        edge.to = destination->second;
+        p.edges.push_back(std::move(edge));
+        return &p.edges.back();
+    };
+    auto outputOf = [&p](int output) { return p.nodeOfChannel.count(output) ? output : kMasterBusId; };
+    for (const auto& track : tracks) addEdge(Plan::EdgeKind::Output, track.id, outputOf(track.output));
+    for (const auto& bus : buses) addEdge(Plan::EdgeKind::Output, bus.id, outputOf(bus.output));
+    for (size_t s = 0; s < sends.size(); ++s) {
+        if (Plan::Edge* edge = addEdge(Plan::EdgeKind::Send, sends[s].source, sends[s].destination)) {
+            edge->send = s;
+            edge->routingId = sends[s].id;
+            edge->preFader = sends[s].preFader;
+        }
+    }
+    for (const auto& tap : sidechains) {
+        if (Plan::Edge* edge = addEdge(Plan::EdgeKind::Sidechain, tap.source, tap.destination)) {
+            edge->routingId = tap.id;
+            edge->preFader = tap.preFader;
+            p.nodes[edge->to].hasSidechain = true;
+        }
+    }
+
+    // Abhängigkeiten für den Pool; Zyklen lehnen die Änderung ab
+    for (const auto& node : p.nodes) {
+        const auto type = node.kind == Plan::Kind::Track ? AudioTaskGraph::NodeType::Track
+                        : node.kind == Plan::Kind::Bus ? AudioTaskGraph::NodeType::Bus
+                        : AudioTaskGraph::NodeType::Master;
+        p.graph.addNode(type, node.id);
+    }
+    for (const auto& edge : p.edges) p.graph.addDependency(edge.from, edge.to);
+    if (!p.graph.compile()) return false;
+
+    // Kanten nach Ziel gruppieren
+    std::stable_sort(p.edges.begin(), p.edges.end(),
+                     [](const Plan::Edge& a, const Plan::Edge& b) { return a.to < b.to; });
+    for (uint32_t e = 0; e < p.edges.size(); ++e) {
+        Plan::Node& node = p.nodes[p.edges[e].to];
+        if (node.inputCount++ == 0) node.firstInput = e;
+    }
+
+    // Laufzeitausgleich in topologischer Reihenfolge: ein Knoten wartet auf
+    // seinen spätesten Eingang, jede frühere Kante wird um die Differenz
+    // verzögert
+    for (auto& node : p.nodes) {
+        auto it = inserts.find(node.id);
+        if (node.kind != Plan::Kind::Master && it != inserts.end()) {
+            node.insert = it->second.processor;
+            node.insertLatency = it->second.latency;
+        }
+    }
+    for (uint32_t index : p.graph.getTopologicalOrder()) {
+        Plan::Node& node = p.nodes[index];
+        for (uint32_t e = node.firstInput; e < node.firstInput + node.inputCount; ++e) {
+            node.inputLatency = std::max(node.inputLatency, p.nodes[p.edges[e].from].outputLatency);
+        }
+        node.outputLatency = node.inputLatency + node.insertLatency;
+    }
+    for (auto& edge : p.edges) {
+        edge.delay = p.nodes[edge.to].inputLatency - p.nodes[edge.from].outputLatency;
+        if (edge.delay > 0) {
+            const size_t length = nextPowerOfTwo(edge.delay + 1);
+            edge.delayLeft.assign(length, 0.0f);
+            edge.delayRight.assign(length, 0.0f);
+            edge.delayMask = length - 1;
+        }
+    }
+
+    // Glätter bestehender Kanten übernehmen, damit ein Umbau nicht knackt
+    for (auto& edge : p.edges) {
+        edge.leftSmoother.prepare(sampleRate);
+        edge.rightSmoother.prepare(sampleRate);
+        if (!plan) continue;
+        const int from = p.nodes[edge.from].id;
+        const int to = p.nodes[edge.to].id;
+        for (const auto& old : plan->edges) {
+            if (old.kind == edge.kind && old.routingId == edge.routingId
+                && plan->nodes[old.from].id == from && plan->nodes[old.to].id == to) {
+                edge.leftSmoother = old.leftSmoother;
+                edge.rightSmoother = old.rightSmoother;
+                edge.fresh = false;
+                break;
+            }
+        }
+    }
+
+    for (auto& node : p.nodes) {
+        node.left.assign(p.maxFrames, 0.0f);
+        node.right.assign(p.maxFrames, 0.0f);
+        if (node.hasSidechain) {
+            node.sideLeft.assign(p.maxFrames, 0.0f);
+            node.sideRight.assign(p.maxFrames, 0.0f);
+        }
+    }
+
+    plan = std::move(next);
+    updateTrackStates();
+    return true;
 }
 
 void Mixer::updateTrackStates() {
+    Plan& p = *plan;
+    const size_t numNodes = p.nodes.size();
+
+    // Fader und Pan einmal hier statt pro Block
+    std::vector<uint8_t> muted(numNodes, 0), soloed(numNodes, 0);
+    std::vector<float> leftGain(numNodes, 1.0f), rightGain(numNodes, 1.0f);
     bool anySolo = false;
-    for (const auto& track : tracks) {
-        if (track.solo) {
-            anySolo = true;
-            break;
+    for (size_t i = 0; i < numNodes; ++i) {
+        const Plan::Node& node = p.nodes[i];
+        float volume = 1.0f, pan = 0.0f;
+        if (node.kind == Plan::Kind::Track) {
+            const Track& track = tracks[node.index];
+            volume = track.volume;
+            pan = track.pan;
+            muted[i] = track.muted;
+            soloed[i] = track.solo;
+        } else if (node.kind == Plan::Kind::Bus) {
+            const Bus& bus = buses[node.index];
+            volume = bus.volume;
+            pan = bus.pan;
+            muted[i] = bus.muted;
+            soloed[i] = bus.solo;
+        }
+        if (node.kind != Plan::Kind::Master) {
+            // Constant-Power-Panning
+            dsp::constantPowerPanGains(pan, leftGain[i], rightGain[i]);
+            leftGain[i] *= volume;
+            rightGain[i] *= volume;
         }
+        anySolo = anySolo || soloed[i];
     }
-    
+
+    // Solo: hörbar sind Solo-Kanäle, alles hinter ihnen (Busse auf dem Weg
+    // zum Master) und alles vor ihnen (Quellen eines Solo-Busses).
+    // Sidechains zählen nicht als Signalweg
+    std::vector<uint8_t> downstream(soloed), upstream(soloed);
     if (anySolo) {
-        for (auto& track : tracks) {
-            if (!track.solo) {
-                track.muted = true;
+        const auto& order = p.graph.getTopologicalOrder();
+        for (uint32_t index : order) {
+            const Plan::Node& node = p.nodes[index];
+            for (uint32_t e = node.firstInput; e < node.firstInput + node.inputCount; ++e) {
+                const Plan::Edge& edge = p.edges[e];
+                if (edge.kind != Plan::EdgeKind::Sidechain && downstream[edge.from]) downstream[index] = 1;
+            }
+        }
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            const Plan::Node& node = p.nodes[*it];
+            if (!upstream[*it]) continue;
+            for (uint32_t e = node.firstInput; e < node.firstInput + node.inputCount; ++e) {
+                const Plan::Edge& edge = p.edges[e];
+                if (edge.kind != Plan::EdgeKind::Sidechain) upstream[edge.from] = 1;
             }
         }
     }
+
+    // Zielpegel der Kanten; die Rampen dorthin laufen im Audio-Pfad.
+    // Sidechains wirken auch bei stummer Quelle
+    for (auto& edge : p.edges) {
+        const uint32_t source = edge.from;
+        const bool audible = !muted[source] && (!anySolo || downstream[source] || upstream[source]);
+        float left = 1.0f, right = 1.0f;
+        if (edge.kind != Plan::EdgeKind::Sidechain) {
+            const float gain = edge.kind == Plan::EdgeKind::Send ? sends[edge.send].gain : 1.0f;
+            left = right = audible ? gain : 0.0f;
+        }
+        if (!edge.preFader) {
+            left *= leftGain[source];
+            right *= rightGain[source];
+        }
+        if (edge.fresh) {
+            edge.leftSmoother.snap(left);
+            edge.rightSmoother.snap(right);
+            edge.fresh = false;
+        } else {
+            edge.leftSmoother.setTarget(left);
+            edge.rightSmoother.setTarget(right);
+        }
+    }
 }
 
 void Mixer::mixTracks(float* output, unsigned long framesPerBuffer) {
-    for (const auto& track : tracks) {
-        if (track.muted) continue;
-        
-        // Stereo-Panning
-        float leftGain = std::sqrt(2.0f) / 2.0f * (1.0f - track.pan);
-        float rightGain = std::sqrt(2.0f) / 2.0f * (1.0f + track.pan);
-        
-        // Track zum Mix hinzufügen
-        for (unsigned long i = 0; i < framesPerBuffer; ++i) {
-            if (i < track.buffer.size() / 2) {
-                output[i * 2] += track.buffer[i * 2] * track.volume * leftGain;
-                output[i * 2 + 1] += track.buffer[i * 2 + 1] * track.volume * rightGain;
-            }
-        }
+    Plan& p = *plan;
+    p.tracks = &tracks;
+    p.frames = framesPerBuffer;
+
+    if (workerPool) {
+        auto processNode = [&p](uint32_t node) { p.processNode(node); };
+        workerPool->execute(p.graph, processNode);
+    } else {
+        for (uint32_t node : p.graph.getTopologicalOrder()) p.processNode(node);
     }
+
+    const Plan::Node& master = p.nodes[p.master];
+    dsp::interleave(master.left.data(), master.right.data(), output, framesPerBuffer);
 }
 
-} // namespace VR_DAW 
\ No newline at end of file
+} // namespace VR_DAW
@@ -1,11 +1,19 @@
 #pragma once
 
-#include <vector>
-#include <string>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace VR_DAW {
 
+class AudioWorkerPool;
+
+// Ziel-ID der Master-Summe
+constexpr int kMasterBusId = -1;
+
 struct Track {
     int id;
     std::string name;
@@ -13,11 +21,60 @@ struct Track {
     float pan;
     bool muted;
     bool solo;
-    std::vector<float> buffer;
+    std::vector<float> buffer;   // Stereo, interleavt
+    // Ausgang: kMasterBusId oder ein Bus (nur über Mixer::setOutput ändern)
+    int output = kMasterBusId;
+};
+
+// Summiert Tracks, Busse und Sends; hat keine eigene Audioquelle
+struct Bus {
+    int id;
+    std::string name;
+    float volume = 1.0f;
+    float pan = 0.0f;
+    bool muted = false;
+    bool solo = false;
+    int output = kMasterBusId;
+};
+
+// Aux-Send auf einen Bus. Pre-Fader greift hinter den Inserts, vor
+// Volume/Pan ab; Mute und Solo der Quelle gelten für beide Varianten
+struct Send {
+    int id;
+    int source;
+    int destination;
+    float gain = 1.0f;
+    bool preFader = false;
 };
 
+// Steuersignal für die Inserts des Ziels (z.B. Ducking-Kompressor). Wirkt
+// auch bei stummgeschalteter Quelle
+struct SidechainTap {
+    int id;
+    int source;
+    int destination;
+    bool preFader = true;
+};
+
+// Mixer als Routing-Graph: Tracks und Busse sind Knoten, Ausgänge, Sends
+// und Sidechains Kanten. Jede Routing-Änderung kompiliert einen Plan:
+// topologisch sortierte Knoten, ein AudioTaskGraph für den AudioWorkerPool
+// und der Laufzeitausgleich. Jede Kante wird so verzögert, dass alle
+// Eingänge eines Knotens (auch Sidechains) sampelgenau zusammentreffen.
+// Ein Knoten holt seine Eingänge selbst ab und schreibt nur eigene Puffer,
+// daher können unabhängige Zweige parallel laufen.
+//
+// Nicht thread-sicher: Konfiguration und process() müssen wie bisher vom
+// Aufrufer serialisiert werden. Nur Routing-Änderungen allozieren.
 class Mixer {
 public:
+    // Inserts eines Tracks/Busses: planar, in-place. sideLeft/sideRight ist
+    // die Summe seiner Sidechain-Taps oder nullptr
+    using InsertProcessor = std::function<void(float* left, float* right, const float* sideLeft,
+                                               const float* sideRight, size_t numFrames)>;
+
+    static constexpr size_t kDefaultMaxBlockSize = 2048;
+
     Mixer();
     ~Mixer();
 
@@ -27,24 +84,83 @@ public:
     Track* getTrack(int trackId);
     std::vector<Track>& getTracks();
 
-    // Track-Kontrolle
+    // Busse; IDs teilen sich den Raum mit den Tracks. Beim Löschen gehen
+    // die zugeführten Kanäle auf den Master
+    int createBus(const std::string& name);
+    void deleteBus(int busId);
+    Bus* getBus(int busId);
+    const std::vector<Bus>& getBuses() const;
+
+    // Routing. false bzw. -1, wenn ein Ziel fehlt oder ein Zyklus entstünde
+    bool setOutput(int channelId, int destination);
+    int addSend(int source, int destination, float gain = 1.0f, bool preFader = false);
+    void removeSend(int sendId);
+    void setSendGain(int sendId, float gain);
+    const std::vector<Send>& getSends() const;
+    int addSidechain(int source, int destination, bool preFader = true);
+    void removeSidechain(int tapId);
+    const std::vector<SidechainTap>& getSidechains() const;
+
+    // Inserts mit ihrer Latenz in Samples; der Prozessor wird in den Plan
+    // kopiert, Zustand daher über geteilte Objekte halten
+    void setInsert(int channelId, InsertProcessor processor, size_t latency = 0);
+    void setInsertLatency(int channelId, size_t latency);
+    void removeInsert(int channelId);
+
+    // Laufzeitausgleich: Latenz bis zur Master-Summe und die Verzögerung,
+    // mit der der Ausgang eines Kanals ausgeglichen wird
+    size_t getLatency() const;
+    size_t getCompensation(int channelId) const;
+
+    // Größter Block pro Durchlauf; größere Aufrufe werden geteilt
+    void setMaxBlockSize(size_t frames);
+    // Bestimmt die Rampenlänge, mit der Volume, Pan, Mute, Solo und
+    // Send-Pegel geglättet werden (ParameterSmoother::kDefaultRampTime)
+    void setSampleRate(float sampleRate);
+    // Unabhängige Kanäle parallel auf dem Pool; nullptr = seriell
+    void setWorkerPool(AudioWorkerPool* pool);
+
+    // Track- und Bus-Kontrolle. Solo überschreibt muted nicht mehr; Busse
+    // auf dem Weg eines Solo-Kanals und Quellen eines Solo-Busses bleiben hörbar
     void setTrackVolume(int trackId, float volume);
     void setTrackPan(int trackId, float pan);
     void muteTrack(int trackId);
     void soloTrack(int trackId);
     void unmuteTrack(int trackId);
     void unsoloTrack(int trackId);
+    void setBusVolume(int busId, float volume);
+    void setBusPan(int busId, float pan);
+    void muteBus(int busId, bool mute);
+    void soloBus(int busId, bool solo);
 
     // Mixer-Verarbeitung
     void process(float* output, unsigned long framesPerBuffer);
     void clear();
 
 private:
+    struct Plan;
+
+    struct Insert {
+        InsertProcessor processor;
+        size_t latency = 0;
+    };
+
     std::vector<Track> tracks;
+    std::vector<Bus> buses;
+    std::vector<Send> sends;
+    std::vector<SidechainTap> sidechains;
+    std::unordered_map<int, Insert> inserts;
     int nextTrackId;
-    
+    int nextRoutingId;
+    size_t maxBlockSize;
+    float sampleRate;
+    AudioWorkerPool* workerPool;
+    std::unique_ptr<Plan> plan;
+
+    bool exists(int channelId) const;
+    bool rebuildPlan();
     void updateTrackStates();
     void mixTracks(float* output, unsigned long framesPerBuffer);
 };
 
-} // namespace VR_DAW 
\ No newline at end of file
+} // namespace VR_DAW
@@ -0,0 +1,95 @@
+#include "OscillatorTables.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VR_DAW {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr size_t kWaveformCount = 3;
+
+} // namespace
+
+const OscillatorTables& OscillatorTables::get() {
+    // Thread-sichere Initialisierung beim ersten Aufruf (C++11 Magic Statics)
+    static const OscillatorTables tables;
+    return tables;
+}
+
+OscillatorTables::OscillatorTables()
+    : sineTable(kTableSize + 1)
+    , mipTables(kWaveformCount * kMipLevels * (kTableSize + 1))
+{
+    // Sinus in double als Basis für die additive Synthese
+    std::vector<double> sine(kTableSize);
+    for (size_t i = 0; i < kTableSize; ++i) {
+        sine[i] = std::sin(2.0 * kPi * static_cast<double>(i) / kTableSize);
+        sineTable[i] = static_cast<float>(sine[i]);
+    }
+    sineTable[kTableSize] = sineTable[0];
+
+    // Fourier-Reihen bis zur Harmonischen-Grenze der Stufe; Index h * i
+    // modulo Tabellengröße statt std::sin pro Term
+    std::vector<double> accumulator(kTableSize);
+    for (size_t w = 0; w < kWaveformCount; ++w) {
+        const auto waveform = static_cast<Waveform>(w);
+        for (size_t level = 0; level < kMipLevels; ++level) {
+            const size_t harmonics = (kTableSize / 2) >> level;
+            std::fill(accumulator.begin(), accumulator.end(), 0.0);
+
+            for (size_t h = 1; h <= harmonics; ++h) {
+                double gain = 0.0;
+                size_t offset = 0; // Viertelperiode verschoben = Kosinus
+                switch (waveform) {
+                    case Waveform::Saw:
+                        gain = -2.0 / (kPi * h);
+                        break;
+                    case Waveform::Square:
+                        gain = (h % 2) ? 4.0 / (kPi * h) : 0.0;
+                        break;
+                    case Waveform::Triangle:
+                        gain = (h % 2) ? -8.0 / (kPi * kPi * h * h) : 0.0;
+                        offset = kTableSize / 4;
+                        break;
+                }
+                if (gain == 0.0) continue;
+
+                for (size_t i = 0; i < kTableSize; ++i) {
+                    accumulator[i] += gain * sine[(h * i + offset) & kTableMask];
+                }
+            }
+
+            float* row = &mipTables[(w * kMipLevels + level) * (kTableSize + 1)];
+            for (size_t i = 0; i < kTableSize; ++i) {
+                row[i] = static_cast<float>(accumulator[i]);
+            }
+            row[kTableSize] = row[0];
+        }
+    }
+}
+
+const float* OscillatorTables::table(Waveform waveform, size_t level) const {
+    level = std::min(level, kMipLevels - 1);
+    return &mipTables[(static_cast<size_t>(waveform) * kMipLevels + level) * (kTableSize + 1)];
+}
+
+size_t OscillatorTables::levelForIncrement(float increment) {
+    // Stufe l hat kTableSize/2 >> l Harmonische; gesucht ist das kleinste l
+    // mit (kTableSize/2 >> l) * increment <= 0.5, also ceil(log2(N * inc))
+    const float scaled = increment * static_cast<float>(kTableSize);
+    if (scaled <= 1.0f) return 0;
+    int exponent = 0;
+    const float mantissa = std::frexp(scaled, &exponent);
+    const size_t level = static_cast<size_t>(mantissa > 0.5f ? exponent : exponent - 1);
+    return std::min(level, kMipLevels - 1);
+}
+
+float OscillatorTables::lookupSine(float phase) const {
+    const float position = phase * static_cast<float>(kTableSize);
+    const size_t index = static_cast<size_t>(position) & kTableMask;
+    const float frac = position - std::floor(position);
+    return sineTable[index] + frac * (sineTable[index + 1] - sineTable[index]);
+}
+
+} // namespace VR_DAW
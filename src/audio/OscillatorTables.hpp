@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VR_DAW {
+
+// Bandbegrenzte Oszillator-Tabellen: eine Sinustabelle und Mip-Map-
+// Wavetables (eine Stufe pro Oktave) für Saw, Square und Triangle.
+// Einmal beim ersten Zugriff gebaut und danach nur noch gelesen, daher von
+// allen Stimmen und Threads ohne Synchronisation nutzbar. Der erste Zugriff
+// gehört in den Kontroll-Thread (der SubtractiveSynthesizer-Konstruktor).
+class OscillatorTables {
+public:
+    enum class Waveform : uint8_t {
+        Saw,
+        Square,
+        Triangle
+    };
+
+    static constexpr size_t kTableSize = 2048;
+    static constexpr size_t kTableMask = kTableSize - 1;
+    // Stufe l enthält kTableSize / 2 >> l Harmonische, die letzte nur die Grundwelle
+    static constexpr size_t kMipLevels = 11;
+
+    static const OscillatorTables& get();
+
+    // kTableSize + 1 Werte (Guard-Sample für die Interpolation)
+    const float* sine() const { return sineTable.data(); }
+    const float* table(Waveform waveform, size_t level) const;
+
+    // Höchste Stufe, deren Harmonische bei diesem Phaseninkrement
+    // (Frequenz / Samplerate) noch unter Nyquist liegen
+    static size_t levelForIncrement(float increment);
+
+    float lookupSine(float phase) const;
+
+private:
+    OscillatorTables();
+
+    std::vector<float> sineTable;
+    std::vector<float> mipTables; // [Waveform][Stufe][kTableSize + 1]
+};
+
+namespace osc {
+
+// PolyBLEP-Restglied für einen Sprung der Höhe 2 bei Phase 0
+inline float polyBlep(float t, float dt) {
+    if (t < dt) {
+        const float x = t / dt;
+        return x + x - x * x - 1.0f;
+    }
+    if (t > 1.0f - dt) {
+        const float x = (t - 1.0f) / dt;
+        return x * x + x + x + 1.0f;
+    }
+    return 0.0f;
+}
+
+// PolyBLAMP-Restglied für einen Knick bei Phase 0, in Samples der Steigung
+inline float polyBlamp(float t, float dt) {
+    if (t < dt) {
+        const float x = t / dt - 1.0f;
+        return -x * x * x * (1.0f / 3.0f);
+    }
+    if (t > 1.0f - dt) {
+        const float x = (t - 1.0f) / dt + 1.0f;
+        return x * x * x * (1.0f / 3.0f);
+    }
+    return 0.0f;
+}
+
+inline float wrap(float phase) {
+    return phase >= 1.0f ? phase - 1.0f : phase;
+}
+
+inline float blepSaw(float t, float dt) {
+    return 2.0f * t - 1.0f - polyBlep(t, dt);
+}
+
+inline float blepSquare(float t, float dt) {
+    const float naive = t < 0.5f ? 1.0f : -1.0f;
+    return naive + polyBlep(t, dt) - polyBlep(wrap(t + 0.5f), dt);
+}
+
+// Knicke mit Steigungsänderung ±8 (pro Phaseneinheit) bei 0 und 0.5
+inline float blampTriangle(float t, float dt) {
+    const float naive = t < 0.5f ? 4.0f * t - 1.0f : 3.0f - 4.0f * t;
+    return naive + 8.0f * dt * (polyBlamp(t, dt) - polyBlamp(wrap(t + 0.5f), dt));
+}
+
+// xorshift32, Zustand pro Stimme; Ergebnis in [-1, 1)
+inline float xorshiftNoise(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<int32_t>(state) * (1.0f / 2147483648.0f);
+}
+
+} // namespace osc
+} // namespace VR_DAW
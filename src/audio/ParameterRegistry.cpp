@@ -0,0 +1,77 @@
+#include "ParameterRegistry.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace VR_DAW {
+
+ParameterId ParameterRegistry::add(ParameterInfo info) {
+    if (ids.count(info.name)) {
+        throw std::invalid_argument("Parameter bereits registriert: " + info.name);
+    }
+    const ParameterId id = static_cast<ParameterId>(infos.size());
+    ids.emplace(info.name, id);
+    infos.push_back(std::move(info));
+    return id;
+}
+
+ParameterId ParameterRegistry::find(const std::string& name) const {
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : kInvalidParameterId;
+}
+
+std::vector<std::string> ParameterRegistry::getNames() const {
+    std::vector<std::string> names;
+    names.reserve(infos.size());
+    for (const auto& info : infos) names.push_back(info.name);
+    return names;
+}
+
+float ParameterRegistry::clamp(ParameterId id, float value) const {
+    const ParameterInfo& info = infos[id];
+    if (info.integer) value = std::round(value);
+    return std::max(info.minimum, std::min(info.maximum, value));
+}
+
+ParameterChangeQueue::ParameterChangeQueue(size_t capacity)
+    : mask(0)
+    , head(0)
+    , tail(0)
+    , dropped(0)
+{
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    changes = std::make_unique<ParameterChange[]>(size);
+    mask = size - 1;
+}
+
+bool ParameterChangeQueue::push(const ParameterChange& change) {
+    const size_t currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail - head.load(std::memory_order_acquire) > mask) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    changes[currentTail & mask] = change;
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+}
+
+bool ParameterChangeQueue::pop(ParameterChange& change) {
+    const size_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == tail.load(std::memory_order_acquire)) return false;
+
+    change = changes[currentHead & mask];
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+}
+
+bool ParameterChangeQueue::empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
+
+uint64_t ParameterChangeQueue::getDroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace VR_DAW
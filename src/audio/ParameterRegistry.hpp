@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VR_DAW {
+
+// Kompakte Parameter-ID, fortlaufend ab 0 in Registrierungsreihenfolge.
+// Klassen mit festen Parametern spiegeln die Reihenfolge in einem enum
+using ParameterId = uint32_t;
+constexpr ParameterId kInvalidParameterId = 0xFFFFFFFFu;
+
+enum class ParameterUnit : uint8_t {
+    None,
+    Decibels,
+    Seconds,
+    Hertz,
+    Percent,    // 0..1
+    Semitones,
+    Ratio,
+    Boolean     // >= 0.5 ist an
+};
+
+struct ParameterInfo {
+    std::string name;
+    float minimum = 0.0f;
+    float maximum = 1.0f;
+    float defaultValue = 0.0f;
+    ParameterUnit unit = ParameterUnit::None;
+    float smoothingTime = 0.0f; // Sekunden, 0 = Wert springt
+    bool integer = false;       // auf ganze Zahlen runden (z.B. Anzahl Bänder)
+    // false: die Änderung braucht Arbeit im Kontroll-Thread (z.B. neue
+    // Impulsantwort) und darf nicht aus dem Audio-Thread gesetzt werden
+    bool automatable = true;
+};
+
+// Parameter-Tabelle, beim Konstruieren des Besitzers einmal aufgebaut.
+// Namen werden nur an der API-Kante (UI, Scripting, Projektdateien) in
+// IDs übersetzt; Verarbeitung und Audio-Thread kennen nur IDs.
+class ParameterRegistry {
+public:
+    ParameterId add(ParameterInfo info);
+
+    // kInvalidParameterId für unbekannte Namen
+    ParameterId find(const std::string& name) const;
+    bool contains(ParameterId id) const { return id < infos.size(); }
+    const ParameterInfo& getInfo(ParameterId id) const { return infos[id]; }
+    size_t size() const { return infos.size(); }
+    std::vector<std::string> getNames() const;
+
+    // Auf den Bereich begrenzen, ganzzahlige Parameter runden
+    float clamp(ParameterId id, float value) const;
+
+private:
+    std::vector<ParameterInfo> infos;
+    std::unordered_map<std::string, ParameterId> ids;
+};
+
+// Parameteränderung für den Audio-Thread; target unterscheidet mehrere
+// Besitzer an einer Queue (z.B. Plugin-ID), sonst 0
+struct ParameterChange {
+    int32_t target;
+    ParameterId id;
+    float value;
+};
+
+// Wait-freier Single-Producer/Single-Consumer-Ring vom Kontroll-Thread zum
+// Audio-Thread (wie MIDIEventQueue). Mehrere Kontroll-Threads serialisiert
+// der Besitzer. Ist der Ring voll, wird verworfen und gezählt; der
+// Besitzer gleicht dann über seine vollständigen Werte ab.
+class ParameterChangeQueue {
+public:
+    explicit ParameterChangeQueue(size_t capacity = 256);
+
+    // Producer
+    bool push(const ParameterChange& change);
+
+    // Consumer
+    bool pop(ParameterChange& change);
+    bool empty() const;
+
+    uint64_t getDroppedCount() const;
+
+private:
+    std::unique_ptr<ParameterChange[]> changes;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head; // nur Consumer schreibt
+    alignas(64) std::atomic<size_t> tail; // nur Producer schreibt
+    std::atomic<uint64_t> dropped;
+};
+
+} // namespace VR_DAW
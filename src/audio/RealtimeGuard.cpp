@@ -0,0 +1,171 @@
+#include "RealtimeGuard.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef VRDAW_REALTIME_CHECKS
+#include <unistd.h>
+#if defined(__linux__)
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+#endif
+
+namespace VR_DAW {
+
+namespace {
+    thread_local int audioThreadDepth = 0;
+    thread_local bool reportingViolation = false;
+
+    std::atomic<RealtimeGuard::Action> guardAction{RealtimeGuard::Action::Log};
+    std::atomic<uint64_t> allocationViolations{0};
+    std::atomic<uint64_t> lockViolations{0};
+    std::atomic<uint64_t> nonRealtimeCallViolations{0};
+
+    // Darf selbst weder allozieren noch locken
+    void writeRaw(const char* text) {
+#ifdef VRDAW_REALTIME_CHECKS
+        ssize_t ignored = ::write(2, text, std::strlen(text));
+        (void)ignored;
+#else
+        (void)text;
+#endif
+    }
+}
+
+RealtimeGuard::ScopedAudioThread::ScopedAudioThread() {
+    ++audioThreadDepth;
+}
+
+RealtimeGuard::ScopedAudioThread::~ScopedAudioThread() {
+    --audioThreadDepth;
+}
+
+void RealtimeGuard::setAction(Action action) {
+    guardAction.store(action, std::memory_order_relaxed);
+}
+
+RealtimeGuard::Action RealtimeGuard::getAction() {
+    return guardAction.load(std::memory_order_relaxed);
+}
+
+bool RealtimeGuard::isAudioThread() {
+    return audioThreadDepth > 0 && !reportingViolation;
+}
+
+void RealtimeGuard::reportViolation(Violation kind, const char* what) {
+    if (reportingViolation) return;
+    reportingViolation = true;
+
+    const char* label = "";
+    switch (kind) {
+        case Violation::Allocation:
+            allocationViolations.fetch_add(1, std::memory_order_relaxed);
+            label = "Allokation in ";
+            break;
+        case Violation::Lock:
+            lockViolations.fetch_add(1, std::memory_order_relaxed);
+            label = "Lock in ";
+            break;
+        case Violation::NonRealtimeCall:
+            nonRealtimeCallViolations.fetch_add(1, std::memory_order_relaxed);
+            label = "Aufruf von ";
+            break;
+    }
+
+    const Action action = getAction();
+    if (action != Action::Count) {
+        writeRaw("[RealtimeGuard] Verletzung im Audio-Thread: ");
+        writeRaw(label);
+        writeRaw(what ? what : "unbekannt");
+        writeRaw("\n");
+    }
+
+    reportingViolation = false;
+
+    if (action == Action::Trap) {
+        std::abort();
+    }
+}
+
+uint64_t RealtimeGuard::getAllocationViolations() {
+    return allocationViolations.load(std::memory_order_relaxed);
+}
+
+uint64_t RealtimeGuard::getLockViolations() {
+    return lockViolations.load(std::memory_order_relaxed);
+}
+
+uint64_t RealtimeGuard::getNonRealtimeCallViolations() {
+    return nonRealtimeCallViolations.load(std::memory_order_relaxed);
+}
+
+void RealtimeGuard::resetViolations() {
+    allocationViolations.store(0, std::memory_order_relaxed);
+    lockViolations.store(0, std::memory_order_relaxed);
+    nonRealtimeCallViolations.store(0, std::memory_order_relaxed);
+}
+
+} // namespace VR_DAW
+
+#ifdef VRDAW_REALTIME_CHECKS
+
+// Globale Allokations-Hooks: jede Allokation im Audio-Thread ist ein Fehler
+namespace {
+    void* checkedAllocate(std::size_t size) {
+        if (VR_DAW::RealtimeGuard::isAudioThread()) {
+            VR_DAW::RealtimeGuard::reportViolation(
+                VR_DAW::RealtimeGuard::Violation::Allocation, "operator new");
+        }
+        void* ptr = std::malloc(size ? size : 1);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+
+    void checkedFree(void* ptr) noexcept {
+        if (ptr && VR_DAW::RealtimeGuard::isAudioThread()) {
+            VR_DAW::RealtimeGuard::reportViolation(
+                VR_DAW::RealtimeGuard::Violation::Allocation, "operator delete");
+        }
+        std::free(ptr);
+    }
+}
+
+void* operator new(std::size_t size) { return checkedAllocate(size); }
+void* operator new[](std::size_t size) { return checkedAllocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return checkedAllocate(size); } catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return checkedAllocate(size); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* ptr) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr) noexcept { checkedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { checkedFree(ptr); }
+
+#if defined(__linux__)
+// pthread_mutex_lock abfangen, damit auch std::mutex erfasst wird
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex) {
+    using LockFunction = int (*)(pthread_mutex_t*);
+    static std::atomic<LockFunction> realLock{nullptr};
+
+    LockFunction fn = realLock.load(std::memory_order_acquire);
+    if (!fn) {
+        fn = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        realLock.store(fn, std::memory_order_release);
+    }
+
+    if (VR_DAW::RealtimeGuard::isAudioThread()) {
+        VR_DAW::RealtimeGuard::reportViolation(
+            VR_DAW::RealtimeGuard::Violation::Lock, "pthread_mutex_lock");
+    }
+    return fn(mutex);
+}
+#endif
+
+#endif // VRDAW_REALTIME_CHECKS
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+namespace VR_DAW {
+
+// Debug-Modus zum Aufspüren von Allokationen und Mutex-Locks im
+// Audio-Thread. VRDAW_ASSERT_NOT_REALTIME markiert zusätzlich Funktionen,
+// die nie aus dem Audio-Thread aufgerufen werden dürfen. Mit VRDAW_REALTIME_CHECKS kompiliert werden
+// operator new/delete sowie pthread_mutex_lock (Linux) überwacht;
+// ohne das Flag sind alle Prüfungen leere Inline-Funktionen.
+class RealtimeGuard {
+public:
+    enum class Action {
+        Count,  // Verletzungen nur zählen
+        Log,    // zusätzlich auf stderr melden
+        Trap    // Prozess sofort abbrechen
+    };
+
+    enum class Violation {
+        Allocation,
+        Lock,
+        NonRealtimeCall   // Setup-/Kontroll-Funktion aus dem Audio-Thread
+    };
+
+    // Markiert den aktuellen Thread für die Dauer des Scopes als Audio-Thread
+    class ScopedAudioThread {
+    public:
+        ScopedAudioThread();
+        ~ScopedAudioThread();
+
+        ScopedAudioThread(const ScopedAudioThread&) = delete;
+        ScopedAudioThread& operator=(const ScopedAudioThread&) = delete;
+    };
+
+    static void setAction(Action action);
+    static Action getAction();
+
+    static bool isAudioThread();
+    static void reportViolation(Violation kind, const char* what);
+
+    static uint64_t getAllocationViolations();
+    static uint64_t getLockViolations();
+    static uint64_t getNonRealtimeCallViolations();
+    static void resetViolations();
+};
+
+#ifdef VRDAW_REALTIME_CHECKS
+#define VRDAW_ASSERT_NOT_REALTIME(what) \
+    do { \
+        if (VR_DAW::RealtimeGuard::isAudioThread()) { \
+            VR_DAW::RealtimeGuard::reportViolation( \
+                VR_DAW::RealtimeGuard::Violation::NonRealtimeCall, what); \
+        } \
+    } while (0)
+#else
+#define VRDAW_ASSERT_NOT_REALTIME(what) do {} while (0)
+#endif
+
+} // namespace VR_DAW
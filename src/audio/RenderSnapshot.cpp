@@ -0,0 +1,91 @@
+#include "RenderSnapshot.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace VR_DAW {
+
+const SynthesizerRenderState* RenderSnapshot::findSynthesizer(int trackId) const {
+    auto it = std::lower_bound(synthesizers.begin(), synthesizers.end(), trackId,
+        [](const SynthesizerRenderState& s, int id) { return s.trackId < id; });
+    if (it != synthesizers.end() && it->trackId == trackId) {
+        return &(*it);
+    }
+    return nullptr;
+}
+
+void RenderSnapshot::applyParameterChange(const ParameterChange& change) const {
+    auto it = std::lower_bound(pluginsById.begin(), pluginsById.end(), change.target,
+        [this](uint32_t index, int id) { return plugins[index].id < id; });
+    for (; it != pluginsById.end() && plugins[*it].id == change.target; ++it) {
+        const PluginRenderState& plugin = plugins[*it];
+        if (change.id < plugin.parameterCount) {
+            parameterValues[plugin.firstParameter + change.id] = change.value;
+        }
+    }
+}
+
+RenderSnapshotManager::RenderSnapshotManager()
+    : current(new RenderSnapshot())
+    , audioEpoch(0)
+    , nextVersion(1)
+{
+}
+
+RenderSnapshotManager::~RenderSnapshotManager() {
+    delete current.exchange(nullptr);
+    retired.clear();
+}
+
+void RenderSnapshotManager::publish(std::unique_ptr<RenderSnapshot> snapshot) {
+    if (!snapshot) return;
+
+    std::lock_guard<std::mutex> lock(controlMutex);
+    snapshot->version = nextVersion++;
+
+    RenderSnapshot* previous = current.exchange(snapshot.release(), std::memory_order_seq_cst);
+
+    // Epoche nach dem Austausch lesen: Ist sie gerade, kann kein laufender
+    // Callback den alten Zeiger mehr halten.
+    const uint64_t epoch = audioEpoch.load(std::memory_order_seq_cst);
+    retired.push_back({std::unique_ptr<RenderSnapshot>(previous), epoch});
+
+    collectRetiredLocked();
+}
+
+void RenderSnapshotManager::collectRetired() {
+    std::lock_guard<std::mutex> lock(controlMutex);
+    collectRetiredLocked();
+}
+
+void RenderSnapshotManager::collectRetiredLocked() {
+    const uint64_t now = audioEpoch.load(std::memory_order_acquire);
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+        [now](const RetiredSnapshot& r) {
+            return (r.retireEpoch & 1) == 0 || now > r.retireEpoch;
+        }), retired.end());
+}
+
+size_t RenderSnapshotManager::getRetiredCount() const {
+    std::lock_guard<std::mutex> lock(controlMutex);
+    return retired.size();
+}
+
+void RenderSnapshotManager::synchronize() const {
+    const uint64_t epoch = audioEpoch.load(std::memory_order_seq_cst);
+    if ((epoch & 1) == 0) return;
+    while (audioEpoch.load(std::memory_order_acquire) == epoch) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+const RenderSnapshot* RenderSnapshotManager::acquire() {
+    audioEpoch.fetch_add(1, std::memory_order_seq_cst);
+    return current.load(std::memory_order_seq_cst);
+}
+
+void RenderSnapshotManager::release() {
+    audioEpoch.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace VR_DAW
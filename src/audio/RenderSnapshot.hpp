@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "AudioWorkerPool.hpp"
+#include "ParameterRegistry.hpp"
+#include "Synthesizer.hpp"
+#include "SynthesizerConfig.hpp"
+#include "../midi/MIDIEventQueue.hpp"
+
+namespace VR_DAW {
+
+// Unveränderlicher Track-Zustand, wie ihn der Audio-Thread sieht.
+// Gains werden beim Veröffentlichen vorberechnet, nicht im Callback.
+struct TrackRenderState {
+    int id;
+    float volume;
+    float pan;
+    float leftGain;
+    float rightGain;
+    bool muted;
+    bool soloed;
+    uint32_t firstPlugin;   // Index in RenderSnapshot::plugins
+    uint32_t pluginCount;
+    int32_t synthesizerIndex; // Index in RenderSnapshot::synthesizers, -1 ohne Synth
+};
+
+struct PluginRenderState {
+    int id;
+    uint32_t firstParameter; // Index in RenderSnapshot::parameterValues
+    uint32_t parameterCount;
+};
+
+struct SynthesizerRenderState {
+    int trackId;
+    SynthesizerConfig config;
+    // Stimmenzustand überlebt Snapshot-Wechsel; freigegeben wird erst
+    // mit dem letzten Snapshot im Kontroll-Thread
+    std::shared_ptr<Synthesizer> instance;
+};
+
+// Arbeitsspeicher einer Periode, passend zu genau einem Snapshot.
+// Der Kontroll-Thread legt ihn beim Bauen des Snapshots an; danach gehört
+// er exklusiv dem Audio-Callback, der diesen Snapshot gerade hält (es gibt
+// nur einen, siehe RenderSnapshotManager), und seinen Workern innerhalb
+// von AudioWorkerPool::execute(). Freigegeben wird er mit dem Snapshot
+// nach der Grace-Periode.
+struct RenderScratch {
+    // Ein Knoten pro Track (objectId = Index in RenderSnapshot::tracks);
+    // die Topologie steht fest, execute() schreibt die Abhängigkeitszähler
+    AudioTaskGraph graph;
+    // Render-Buffer pro Track (planar: blockFrames links, dann rechts)
+    std::vector<float> trackBuffers;
+    // Planare Ein-/Ausgangs-Buffer (4 × blockFrames) für interleavte Backends
+    std::vector<float> ioBuffers;
+    // Interleavte Synth-Ausgabe pro Synthesizer (2 × blockFrames)
+    std::vector<float> synthBuffers;
+};
+
+// Ein vollständiger Stand aller Render-Daten. Wird ausschließlich vom
+// Kontroll-Thread erzeugt und nach dem Veröffentlichen nicht mehr
+// verändert; Ausnahmen sind parameterValues und der Arbeitsspeicher
+// hinter scratch.
+struct RenderSnapshot {
+    std::vector<TrackRenderState> tracks;
+    std::vector<PluginRenderState> plugins;
+    // Indizes in plugins, nach PluginRenderState::id sortiert (ein Plugin
+    // kann auf mehreren Tracks liegen)
+    std::vector<uint32_t> pluginsById;
+    // Einzige Ausnahme von der Unveränderlichkeit: der Audio-Thread trägt
+    // hier Parameteränderungen aus der ParameterChangeQueue ein, statt für
+    // jede Änderung einen neuen Snapshot zu bauen
+    mutable std::vector<float> parameterValues;
+    std::vector<SynthesizerRenderState> synthesizers; // nach trackId sortiert
+    std::vector<std::shared_ptr<MIDIEventQueue>> midiInputs;
+    float masterVolume = 1.0f;
+    bool anySolo = false;
+    uint64_t version = 0;
+
+    uint32_t blockFrames = 0;
+    // Der Zeiger ist Teil des Snapshots, der Inhalt nicht (siehe RenderScratch)
+    const std::unique_ptr<RenderScratch> scratch = std::make_unique<RenderScratch>();
+
+    const SynthesizerRenderState* findSynthesizer(int trackId) const;
+    // Audio-Thread; change.target ist die Plugin-ID. Parameter, die der
+    // Snapshot noch nicht kennt, stehen im nächsten schon drin
+    void applyParameterChange(const ParameterChange& change) const;
+};
+
+// Veröffentlicht RenderSnapshots atomar vom Kontroll-Thread an den
+// Audio-Thread. Alte Snapshots werden erst nach einer Grace-Periode
+// freigegeben, d.h. sobald der Audio-Thread den Callback verlassen hat,
+// in dem er sie noch sehen konnte. Der Audio-Thread lockt und
+// alloziert dabei nie.
+class RenderSnapshotManager {
+public:
+    RenderSnapshotManager();
+    ~RenderSnapshotManager();
+
+    RenderSnapshotManager(const RenderSnapshotManager&) = delete;
+    RenderSnapshotManager& operator=(const RenderSnapshotManager&) = delete;
+
+    // Kontroll-Thread
+    void publish(std::unique_ptr<RenderSnapshot> snapshot);
+    void collectRetired();
+    size_t getRetiredCount() const;
+    // Wartet, bis ein gerade laufender Callback fertig ist. Danach sieht
+    // jeder weitere Callback alles, was vor dem Aufruf geschrieben wurde
+    void synchronize() const;
+
+    // Audio-Thread: acquire()/release() klammern genau einen Callback.
+    // Nur der Audio-Callback darf sie aufrufen: die Epoche kennt genau einen
+    // Leser, ein zweiter Thread macht ihre Parität bedeutungslos
+    const RenderSnapshot* acquire();
+    void release();
+
+private:
+    struct RetiredSnapshot {
+        std::unique_ptr<RenderSnapshot> snapshot;
+        uint64_t retireEpoch;
+    };
+
+    std::atomic<RenderSnapshot*> current;
+    // Ungerade = Audio-Thread befindet sich in einem Callback
+    std::atomic<uint64_t> audioEpoch;
+
+    void collectRetiredLocked();
+
+    std::vector<RetiredSnapshot> retired;
+    mutable std::mutex controlMutex; // nur Kontroll-Thread
+    uint64_t nextVersion;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,508 @@
+#include "SampleDatabase.hpp"
+#include <sqlite3.h>
+#include <algorithm>
+#include <ctime>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace VR_DAW {
+
+namespace {
+
+// Aktuelle Schema-Version in PRAGMA user_version; 0 ist das alte Schema
+// mit den Metadaten als JSON-Text
+constexpr int kSchemaVersion = 1;
+
+// Metadaten-Spalten in Bind- und Lesereihenfolge. In Statements ist ?1 der
+// Name, ?2 der Pfad, die Spalten folgen ab ?3
+const char* const kColumns[] = {
+    "description", "source", "license", "format", "duration", "bpm", "key", "tags",
+    "is_free", "download_url", "preview_url", "author", "country", "culture",
+    "instrument", "technique", "mood", "genre", "style", "era", "quality",
+    "bit_depth", "sample_rate", "channels", "size", "hash", "version", "last_updated"
+};
+constexpr int kColumnCount = static_cast<int>(sizeof(kColumns) / sizeof(kColumns[0]));
+
+const char* const kSchema = R"(
+    CREATE TABLE IF NOT EXISTS samples (
+        id INTEGER PRIMARY KEY,
+        name TEXT NOT NULL UNIQUE,
+        path TEXT,
+        description TEXT,
+        source TEXT,
+        license TEXT,
+        format TEXT,
+        duration REAL,
+        bpm REAL,
+        key TEXT,
+        tags TEXT,
+        is_free INTEGER,
+        download_url TEXT,
+        preview_url TEXT,
+        author TEXT,
+        country TEXT,
+        culture TEXT,
+        instrument TEXT,
+        technique TEXT,
+        mood TEXT,
+        genre TEXT,
+        style TEXT,
+        era TEXT,
+        quality TEXT,
+        bit_depth TEXT,
+        sample_rate TEXT,
+        channels TEXT,
+        size TEXT,
+        hash TEXT,
+        version TEXT,
+        last_updated INTEGER,
+        download_count INTEGER DEFAULT 0,
+        rating REAL
+    );
+
+    CREATE INDEX IF NOT EXISTS samples_last_updated ON samples (last_updated);
+
+    -- Suchindex über die Tabelle, von Triggern aktuell gehalten
+    CREATE VIRTUAL TABLE IF NOT EXISTS samples_fts USING fts5 (
+        name, tags, instrument, genre, mood,
+        content = 'samples', content_rowid = 'id',
+        tokenize = 'unicode61 remove_diacritics 2', prefix = '2 3'
+    );
+
+    CREATE TRIGGER IF NOT EXISTS samples_fts_insert AFTER INSERT ON samples BEGIN
+        INSERT INTO samples_fts (rowid, name, tags, instrument, genre, mood)
+        VALUES (new.id, new.name, new.tags, new.instrument, new.genre, new.mood);
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS samples_fts_delete AFTER DELETE ON samples BEGIN
+        INSERT INTO samples_fts (samples_fts, rowid, name, tags, instrument, genre, mood)
+        VALUES ('delete', old.id, old.name, old.tags, old.instrument, old.genre, old.mood);
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS samples_fts_update
+    AFTER UPDATE OF name, tags, instrument, genre, mood ON samples BEGIN
+        INSERT INTO samples_fts (samples_fts, rowid, name, tags, instrument, genre, mood)
+        VALUES ('delete', old.id, old.name, old.tags, old.instrument, old.genre, old.mood);
+        INSERT INTO samples_fts (rowid, name, tags, instrument, genre, mood)
+        VALUES (new.id, new.name, new.tags, new.instrument, new.genre, new.mood);
+    END;
+
+    CREATE TABLE IF NOT EXISTS categories (
+        name TEXT,
+        category TEXT,
+        PRIMARY KEY (name, category)
+    );
+
+    CREATE TABLE IF NOT EXISTS updates (
+        id INTEGER PRIMARY KEY,
+        timestamp TIMESTAMP,
+        status TEXT,
+        details TEXT
+    );
+)";
+
+// Übernimmt das alte Schema; läuft nach kSchema auf der umbenannten Tabelle
+const char* const kMigrateLegacy = R"(
+    INSERT OR IGNORE INTO samples (
+        name, path, description, source, license, format, duration, bpm, key, tags,
+        is_free, download_url, preview_url, author, country, culture, instrument,
+        technique, mood, genre, style, era, quality, bit_depth, sample_rate, channels,
+        size, hash, version, last_updated, download_count, rating)
+    SELECT
+        name, path,
+        json_extract(metadata, '$.description'), json_extract(metadata, '$.source'),
+        json_extract(metadata, '$.license'), json_extract(metadata, '$.format'),
+        json_extract(metadata, '$.duration'), json_extract(metadata, '$.bpm'),
+        json_extract(metadata, '$.key'),
+        (SELECT group_concat(value, char(10)) FROM json_each(metadata, '$.tags')),
+        is_free,
+        json_extract(metadata, '$.downloadUrl'), json_extract(metadata, '$.previewUrl'),
+        json_extract(metadata, '$.author'), json_extract(metadata, '$.country'),
+        json_extract(metadata, '$.culture'), json_extract(metadata, '$.instrument'),
+        json_extract(metadata, '$.technique'), json_extract(metadata, '$.mood'),
+        json_extract(metadata, '$.genre'), json_extract(metadata, '$.style'),
+        json_extract(metadata, '$.era'), json_extract(metadata, '$.quality'),
+        json_extract(metadata, '$.bitDepth'), json_extract(metadata, '$.sampleRate'),
+        json_extract(metadata, '$.channels'), json_extract(metadata, '$.size'),
+        json_extract(metadata, '$.hash'), json_extract(metadata, '$.version'),
+        last_updated, COALESCE(download_count, 0), rating
+    FROM samples_legacy
+    WHERE json_valid(metadata);
+
+    DROP TABLE samples_legacy;
+)";
+
+// Tags einzeln pro Zeile; der Zeilenumbruch trennt für FTS5 auch die Wörter
+constexpr char kTagSeparator = '\n';
+
+std::string joinTags(const std::vector<std::string>& tags) {
+    std::string joined;
+    for (const auto& tag : tags) {
+        if (!joined.empty()) joined += kTagSeparator;
+        joined += tag;
+    }
+    return joined;
+}
+
+std::vector<std::string> splitTags(const std::string& joined) {
+    std::vector<std::string> tags;
+    size_t begin = 0;
+    while (begin < joined.size()) {
+        size_t end = joined.find(kTagSeparator, begin);
+        if (end == std::string::npos) end = joined.size();
+        if (end > begin) tags.push_back(joined.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return tags;
+}
+
+// Freitext in einen FTS5-Ausdruck: alle Wörter müssen vorkommen, mit
+// prefix das letzte auch als Wortanfang (Suche beim Tippen). Satzzeichen
+// trennen wie im Tokenizer, damit Eingaben wie "hi-hat" oder
+// Anführungszeichen keine Syntaxfehler auslösen
+std::string buildMatch(const std::string& query, bool prefix) {
+    std::vector<std::string> terms(1);
+    for (unsigned char c : query) {
+        const bool ascii = c < 0x80;
+        if (!ascii || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+            terms.back() += static_cast<char>(c);
+        } else if (!terms.back().empty()) {
+            terms.emplace_back();
+        }
+    }
+    if (terms.back().empty()) terms.pop_back();
+
+    std::string match;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        if (!match.empty()) match += ' ';
+        match += '"' + terms[i] + '"';
+        if (prefix && i + 1 == terms.size()) match += '*';
+    }
+    return match;
+}
+
+std::string columnText(sqlite3_stmt* stmt, int column) {
+    const unsigned char* text = sqlite3_column_text(stmt, column);
+    return text ? reinterpret_cast<const char*>(text) : std::string();
+}
+
+} // namespace
+
+class SampleDatabase::Impl {
+public:
+    sqlite3* db = nullptr;
+    mutable std::mutex mutex;
+    mutable std::unordered_map<std::string, sqlite3_stmt*> statements;
+    int batchDepth = 0;
+
+    std::string upsertSql;
+    std::string updateSql;
+    std::string selectColumns;
+
+    ~Impl() {
+        for (auto& [sql, stmt] : statements) sqlite3_finalize(stmt);
+        if (db) sqlite3_close(db);
+    }
+
+    void fail(const std::string& what) const {
+        throw std::runtime_error("Sample-Datenbank: " + what + ": " + sqlite3_errmsg(db));
+    }
+
+    void exec(const char* sql) {
+        char* errMsg = nullptr;
+        if (sqlite3_exec(db, sql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+            const std::string message = errMsg ? errMsg : "unbekannter Fehler";
+            sqlite3_free(errMsg);
+            throw std::runtime_error("Sample-Datenbank: " + message);
+        }
+    }
+
+    int queryInt(const char* sql) {
+        Statement query(*this, sql);
+        return sqlite3_step(query.stmt) == SQLITE_ROW ? sqlite3_column_int(query.stmt, 0) : 0;
+    }
+
+    // Statement aus dem Cache, beim Verlassen zurückgesetzt. Der Aufrufer
+    // hält mutex
+    struct Statement {
+        sqlite3_stmt* stmt;
+
+        Statement(const Impl& impl, const std::string& sql) {
+            auto it = impl.statements.find(sql);
+            if (it == impl.statements.end()) {
+                sqlite3_stmt* prepared = nullptr;
+                if (sqlite3_prepare_v3(impl.db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT,
+                                       &prepared, nullptr) != SQLITE_OK) {
+                    impl.fail("Statement nicht übersetzbar");
+                }
+                it = impl.statements.emplace(sql, prepared).first;
+            }
+            stmt = it->second;
+        }
+        ~Statement() {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+        Statement(const Statement&) = delete;
+        Statement& operator=(const Statement&) = delete;
+
+        void text(int index, const std::string& value) {
+            sqlite3_bind_text(stmt, index, value.c_str(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
+        }
+    };
+
+    void run(Statement& statement, const char* what) const {
+        if (sqlite3_step(statement.stmt) != SQLITE_DONE) fail(what);
+    }
+
+    static void bindMetadata(Statement& s, const SampleMetadata& m) {
+        int i = 3;
+        s.text(i++, m.description);
+        s.text(i++, m.source);
+        s.text(i++, m.license);
+        s.text(i++, m.format);
+        sqlite3_bind_double(s.stmt, i++, m.duration);
+        sqlite3_bind_double(s.stmt, i++, m.bpm);
+        s.text(i++, m.key);
+        s.text(i++, joinTags(m.tags));
+        sqlite3_bind_int(s.stmt, i++, m.isFree ? 1 : 0);
+        s.text(i++, m.downloadUrl);
+        s.text(i++, m.previewUrl);
+        s.text(i++, m.author);
+        s.text(i++, m.country);
+        s.text(i++, m.culture);
+        s.text(i++, m.instrument);
+        s.text(i++, m.technique);
+        s.text(i++, m.mood);
+        s.text(i++, m.genre);
+        s.text(i++, m.style);
+        s.text(i++, m.era);
+        s.text(i++, m.quality);
+        s.text(i++, m.bitDepth);
+        s.text(i++, m.sampleRate);
+        s.text(i++, m.channels);
+        s.text(i++, m.size);
+        s.text(i++, m.hash);
+        s.text(i++, m.version);
+        sqlite3_bind_int64(s.stmt, i++, std::chrono::system_clock::to_time_t(m.lastUpdated));
+    }
+
+    // Zeile aus "SELECT name, <selectColumns>"
+    static SampleMetadata readMetadata(sqlite3_stmt* stmt) {
+        SampleMetadata m;
+        int i = 0;
+        m.name = columnText(stmt, i++);
+        m.description = columnText(stmt, i++);
+        m.source = columnText(stmt, i++);
+        m.license = columnText(stmt, i++);
+        m.format = columnText(stmt, i++);
+        m.duration = static_cast<float>(sqlite3_column_double(stmt, i++));
+        m.bpm = static_cast<float>(sqlite3_column_double(stmt, i++));
+        m.key = columnText(stmt, i++);
+        m.tags = splitTags(columnText(stmt, i++));
+        m.isFree = sqlite3_column_int(stmt, i++) != 0;
+        m.downloadUrl = columnText(stmt, i++);
+        m.previewUrl = columnText(stmt, i++);
+        m.author = columnText(stmt, i++);
+        m.country = columnText(stmt, i++);
+        m.culture = columnText(stmt, i++);
+        m.instrument = columnText(stmt, i++);
+        m.technique = columnText(stmt, i++);
+        m.mood = columnText(stmt, i++);
+        m.genre = columnText(stmt, i++);
+        m.style = columnText(stmt, i++);
+        m.era = columnText(stmt, i++);
+        m.quality = columnText(stmt, i++);
+        m.bitDepth = columnText(stmt, i++);
+        m.sampleRate = columnText(stmt, i++);
+        m.channels = columnText(stmt, i++);
+        m.size = columnText(stmt, i++);
+        m.hash = columnText(stmt, i++);
+        m.version = columnText(stmt, i++);
+        m.lastUpdated = std::chrono::system_clock::from_time_t(
+            static_cast<std::time_t>(sqlite3_column_int64(stmt, i++)));
+        return m;
+    }
+
+    void createSchema() {
+        const int version = queryInt("PRAGMA user_version;");
+        if (version >= kSchemaVersion) return;
+
+        exec("BEGIN IMMEDIATE;");
+        try {
+            const bool legacy = version == 0
+                && queryInt("SELECT count(*) FROM pragma_table_info('samples') WHERE name = 'metadata';") > 0;
+            if (legacy) exec("ALTER TABLE samples RENAME TO samples_legacy;");
+            exec(kSchema);
+            if (legacy) exec(kMigrateLegacy);
+            exec(("PRAGMA user_version = " + std::to_string(kSchemaVersion) + ";").c_str());
+            exec("COMMIT;");
+        } catch (...) {
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+            throw;
+        }
+    }
+};
+
+SampleDatabase::SampleDatabase(const std::string& path)
+    : pImpl(std::make_unique<Impl>())
+{
+    Impl& impl = *pImpl;
+    if (sqlite3_open_v2(path.c_str(), &impl.db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+        impl.fail("Öffnen fehlgeschlagen (" + path + ")");
+    }
+
+    // WAL: Leser blockieren den Schreiber nicht, Commits sind sequenzielle
+    // Anhänge; synchronous=NORMAL reicht im WAL-Modus für Konsistenz
+    sqlite3_busy_timeout(impl.db, 5000);
+    impl.exec("PRAGMA journal_mode = WAL;"
+              "PRAGMA synchronous = NORMAL;"
+              "PRAGMA temp_store = MEMORY;"
+              "PRAGMA cache_size = -16384;"
+              "PRAGMA mmap_size = 268435456;");
+    impl.createSchema();
+
+    std::string columns;
+    std::string values;
+    std::string updates;
+    std::string assignments;
+    for (int i = 0; i < kColumnCount; ++i) {
+        const std::string column = kColumns[i];
+        const std::string parameter = "?" + std::to_string(i + 3);
+        columns += ", " + column;
+        values += ", " + parameter;
+        updates += ", " + column + " = excluded." + column;
+        assignments += (i == 0 ? "" : ", ") + column + " = " + parameter;
+    }
+    impl.selectColumns = columns;
+    // Upsert statt REPLACE: ID, Download-Zähler und Bewertung bleiben
+    impl.upsertSql = "INSERT INTO samples (name, path" + columns + ") VALUES (?1, ?2" + values
+                   + ") ON CONFLICT (name) DO UPDATE SET path = excluded.path" + updates + ";";
+    impl.updateSql = "UPDATE samples SET " + assignments + " WHERE name = ?1;";
+}
+
+SampleDatabase::~SampleDatabase() = default;
+
+void SampleDatabase::upsert(const std::string& path, const SampleMetadata& metadata) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    Impl::Statement statement(*pImpl, pImpl->upsertSql);
+    statement.text(1, metadata.name);
+    statement.text(2, path);
+    Impl::bindMetadata(statement, metadata);
+    pImpl->run(statement, "Sample nicht gespeichert");
+}
+
+bool SampleDatabase::update(const SampleMetadata& metadata) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    Impl::Statement statement(*pImpl, pImpl->updateSql);
+    statement.text(1, metadata.name);
+    Impl::bindMetadata(statement, metadata);
+    pImpl->run(statement, "Sample nicht aktualisiert");
+    return sqlite3_changes(pImpl->db) > 0;
+}
+
+void SampleDatabase::remove(const std::string& name) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    {
+        Impl::Statement statement(*pImpl, "DELETE FROM samples WHERE name = ?1;");
+        statement.text(1, name);
+        pImpl->run(statement, "Sample nicht gelöscht");
+    }
+    Impl::Statement statement(*pImpl, "DELETE FROM categories WHERE name = ?1;");
+    statement.text(1, name);
+    pImpl->run(statement, "Kategorien nicht gelöscht");
+}
+
+void SampleDatabase::recordUpdate(std::chrono::system_clock::time_point time,
+                                  const std::string& status, const std::string& details) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    Impl::Statement statement(*pImpl, "INSERT INTO updates (timestamp, status, details) VALUES (?1, ?2, ?3);");
+    sqlite3_bind_int64(statement.stmt, 1, std::chrono::system_clock::to_time_t(time));
+    statement.text(2, status);
+    statement.text(3, details);
+    pImpl->run(statement, "Update nicht protokolliert");
+}
+
+std::vector<SampleMetadata> SampleDatabase::search(const std::string& query, size_t limit) const {
+    std::vector<SampleMetadata> result;
+    const std::string match = buildMatch(query, false);
+    if (limit == 0) return result;
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto collect = [&](Impl::Statement& statement) {
+        int rc;
+        while (result.size() < limit && (rc = sqlite3_step(statement.stmt)) == SQLITE_ROW) {
+            SampleMetadata metadata = Impl::readMetadata(statement.stmt);
+            // Schon als Namenstreffer geliefert
+            if (std::any_of(result.begin(), result.end(),
+                            [&](const SampleMetadata& hit) { return hit.name == metadata.name; })) {
+                continue;
+            }
+            result.push_back(std::move(metadata));
+        }
+    };
+
+    if (match.empty()) {
+        Impl::Statement statement(*pImpl, "SELECT name" + pImpl->selectColumns + " FROM samples ORDER BY name LIMIT ?1;");
+        sqlite3_bind_int64(statement.stmt, 1, static_cast<sqlite3_int64>(limit));
+        collect(statement);
+        return result;
+    }
+
+    // Stufen statt bm25, das für jedes Wort dessen vollständige Trefferliste
+    // liest und bei häufigen Wörtern wie "loop" in großen Katalogen viel zu
+    // teuer ist: ganze Wörter im Namen, ganze Wörter überall, dann dasselbe
+    // mit dem letzten Wort als Präfix. Präfixe länger als der Präfixindex
+    // führen alle passenden Listen zusammen und laufen deshalb nur, wenn die
+    // ganzen Wörter nicht reichen. Jede Abfrage bricht nach limit Zeilen ab
+    const std::string hitsSql = "SELECT s.name" + pImpl->selectColumns + " FROM ("
+        "SELECT rowid FROM samples_fts WHERE samples_fts MATCH ?1 LIMIT ?2"
+        ") AS hits JOIN samples AS s ON s.id = hits.rowid;";
+    for (const std::string& expression : {match, buildMatch(query, true)}) {
+        for (const std::string& filtered : {"name : (" + expression + ")", expression}) {
+            if (result.size() >= limit) return result;
+            Impl::Statement statement(*pImpl, hitsSql);
+            statement.text(1, filtered);
+            sqlite3_bind_int64(statement.stmt, 2, static_cast<sqlite3_int64>(limit + result.size()));
+            collect(statement);
+        }
+    }
+    return result;
+}
+
+bool SampleDatabase::find(const std::string& name, SampleMetadata& metadata) const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    Impl::Statement statement(*pImpl, "SELECT name" + pImpl->selectColumns + " FROM samples WHERE name = ?1;");
+    statement.text(1, name);
+    if (sqlite3_step(statement.stmt) != SQLITE_ROW) return false;
+    metadata = Impl::readMetadata(statement.stmt);
+    return true;
+}
+
+size_t SampleDatabase::count() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    Impl::Statement statement(*pImpl, "SELECT count(*) FROM samples;");
+    return sqlite3_step(statement.stmt) == SQLITE_ROW
+        ? static_cast<size_t>(sqlite3_column_int64(statement.stmt, 0)) : 0;
+}
+
+SampleDatabase::Batch::Batch(SampleDatabase& database)
+    : database(database)
+{
+    std::lock_guard<std::mutex> lock(database.pImpl->mutex);
+    if (database.pImpl->batchDepth == 0) database.pImpl->exec("BEGIN IMMEDIATE;");
+    ++database.pImpl->batchDepth;
+}
+
+SampleDatabase::Batch::~Batch() {
+    std::lock_guard<std::mutex> lock(database.pImpl->mutex);
+    if (--database.pImpl->batchDepth > 0) return;
+    // Aus dem Destruktor darf nichts fliegen; scheitert der Commit, wird
+    // zurückgerollt statt die Transaktion offen zu lassen
+    if (sqlite3_exec(database.pImpl->db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        sqlite3_exec(database.pImpl->db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VR_DAW {
+
+// Sample-Metadaten, wie sie die Bank verwaltet und die Datenbank speichert
+struct SampleMetadata {
+    std::string name;
+    std::string description;
+    std::string source;
+    std::string license;
+    std::string format;
+    float duration;
+    float bpm;
+    std::string key;
+    std::vector<std::string> tags;
+    std::chrono::system_clock::time_point lastUpdated;
+    bool isFree;
+    std::string downloadUrl;
+    std::string previewUrl;
+    std::string author;
+    std::string country;
+    std::string culture;
+    std::string instrument;
+    std::string technique;
+    std::string mood;
+    std::string genre;
+    std::string style;
+    std::string era;
+    std::string quality;
+    std::string bitDepth;
+    std::string sampleRate;
+    std::string channels;
+    std::string size;
+    std::string hash;
+    std::string version;
+};
+
+// Persistenter Sample-Katalog auf SQLite. Eine Verbindung für die ganze
+// Lebensdauer im WAL-Modus, vorbereitete Statements werden zwischengespeichert.
+// Metadaten liegen in eigenen Spalten; Name, Tags, Instrument, Genre und
+// Stimmung sind zusätzlich in einem FTS5-Index, über den gesucht wird.
+//
+// Datenbanken im alten Schema (Metadaten als JSON-Text) werden beim Öffnen
+// einmalig umgezogen. Alle Methoden sind thread-sicher.
+class SampleDatabase {
+public:
+    // Wirft std::runtime_error, wenn die Datenbank nicht geöffnet oder das
+    // Schema nicht angelegt werden kann
+    explicit SampleDatabase(const std::string& path);
+    ~SampleDatabase();
+
+    SampleDatabase(const SampleDatabase&) = delete;
+    SampleDatabase& operator=(const SampleDatabase&) = delete;
+
+    // Fügt ein oder ersetzt es (Schlüssel ist der Name)
+    void upsert(const std::string& path, const SampleMetadata& metadata);
+    // Nur Metadaten, Pfad bleibt; false, wenn der Name unbekannt ist
+    bool update(const SampleMetadata& metadata);
+    void remove(const std::string& name);
+    void recordUpdate(std::chrono::system_clock::time_point time,
+                      const std::string& status, const std::string& details);
+
+    // Volltextsuche; jedes Wort der Anfrage muss vorkommen, das letzte darf
+    // ein Wortanfang sein. Treffer im Namen kommen zuerst. Eine leere Anfrage
+    // liefert die ersten limit Samples nach Namen
+    std::vector<SampleMetadata> search(const std::string& query, size_t limit = 200) const;
+    bool find(const std::string& name, SampleMetadata& metadata) const;
+    size_t count() const;
+
+    // Bündelt alle Schreibzugriffe im Scope in eine Transaktion; beim
+    // Verlassen wird committet. Verschachtelte Batches laufen in der äußeren
+    class Batch {
+    public:
+        explicit Batch(SampleDatabase& database);
+        ~Batch();
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+    private:
+        SampleDatabase& database;
+    };
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,741 @@
+#include "SampleStreamer.hpp"
+#include "../dsp/kernels/DSPKernels.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VRDAW_HAVE_MMAP 1
+#endif
+
+namespace VR_DAW {
+
+namespace {
+
+// Blende bei Aussetzern, in Frames
+constexpr size_t kFadeFrames = 64;
+// Schlafende I/O-Threads werden per notify geweckt; der Timeout fängt nur
+// ein verlorenes notify ohne Lock ab und ist kurz gegen die Ringlänge
+constexpr std::chrono::milliseconds kWakeTimeout(10);
+
+// SampleId: Generation in den oberen, Slot-Index in den unteren 16 Bit.
+// Index 0xffff wird nie vergeben, daher ist keine ID kInvalidSample
+constexpr uint32_t kSlotBits = 16;
+constexpr uint32_t kSlotMask = (1u << kSlotBits) - 1;
+
+inline uint32_t makeSampleId(uint32_t generation, size_t slot) {
+    return ((generation & 0xffffu) << kSlotBits) | static_cast<uint32_t>(slot);
+}
+
+enum VoiceState : uint32_t {
+    kIdle,
+    kPlaying,
+    // Vom Audio-Thread beendet; erst der I/O-Thread gibt die Stimme frei,
+    // damit er nie in einen Ring schreibt, den eine neue Stimme schon liest
+    kReleasing
+};
+
+enum class Encoding : uint8_t { Int16, Int24, Int32, Float32 };
+
+// Generation und Block-Index; 0 ist ein leerer Slot
+inline uint64_t makeTag(uint32_t generation, size_t chunk) {
+    return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(chunk + 1);
+}
+
+inline uint16_t readU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+inline uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+         | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Nur lesend gemappte Datei; ohne mmap wird sie vollständig gelesen
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+#if defined(VRDAW_HAVE_MMAP)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) return false;
+        bytes = static_cast<const uint8_t*>(mapping);
+        length = static_cast<size_t>(info.st_size);
+        return true;
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        bytes = contents.data();
+        length = contents.size();
+        return length > 0;
+#endif
+    }
+
+    void close() {
+#if defined(VRDAW_HAVE_MMAP)
+        if (bytes) munmap(const_cast<uint8_t*>(bytes), length);
+#else
+        std::vector<uint8_t>().swap(contents);
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    // Asynchrones Read-ahead des Kernels anstoßen
+    void prefetch(size_t offset, size_t count) const {
+#if defined(VRDAW_HAVE_MMAP)
+        if (!bytes || offset >= length) return;
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t begin = offset / page * page;
+        const size_t end = std::min(length, offset + count);
+        madvise(const_cast<uint8_t*>(bytes) + begin, end - begin, MADV_WILLNEED);
+#else
+        (void)offset;
+        (void)count;
+#endif
+    }
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+#if !defined(VRDAW_HAVE_MMAP)
+    std::vector<uint8_t> contents;
+#endif
+};
+
+} // namespace
+
+struct SampleStreamer::Impl {
+    struct Sample {
+        std::string path;
+        MappedFile file;
+        const uint8_t* pcm = nullptr;
+        size_t frames = 0;
+        uint32_t channels = 0;
+        uint32_t bytesPerSample = 0;
+        Encoding encoding = Encoding::Int16;
+        float sampleRate = 0.0f;
+        // Planar: residentFrames links, dann rechts
+        std::vector<float> head;
+        size_t residentFrames = 0;
+
+        // Slots werden wiederverwendet: startVoice() prüft nach dem Eintragen
+        // als Nutzer removed und id. Unveröffentlicht gilt ein Slot als entfernt
+        std::atomic<uint32_t> id{kInvalidSample};
+        std::atomic<uint32_t> users{0};
+        std::atomic<bool> removed{true};
+        uint32_t generation = 0; // unter mutex
+
+        size_t frameBytes() const { return static_cast<size_t>(channels) * bytesPerSample; }
+
+        float decode(const uint8_t* p) const {
+            switch (encoding) {
+                case Encoding::Int16:
+                    return static_cast<float>(static_cast<int16_t>(readU16(p))) * (1.0f / 32768.0f);
+                case Encoding::Int24: {
+                    const uint32_t bits = static_cast<uint32_t>(p[0]) << 8 | static_cast<uint32_t>(p[1]) << 16
+                                        | static_cast<uint32_t>(p[2]) << 24;
+                    return static_cast<float>(static_cast<int32_t>(bits) >> 8) * (1.0f / 8388608.0f);
+                }
+                case Encoding::Int32:
+                    return static_cast<float>(static_cast<int32_t>(readU32(p))) * (1.0f / 2147483648.0f);
+                case Encoding::Float32: {
+                    float value;
+                    std::memcpy(&value, p, sizeof(value));
+                    return value;
+                }
+            }
+            return 0.0f;
+        }
+
+        // count Frames ab first planar nach left/right
+        void read(size_t first, size_t count, float* left, float* right) const {
+            const size_t stride = frameBytes();
+            const uint8_t* p = pcm + first * stride;
+            const size_t rightOffset = channels > 1 ? bytesPerSample : 0;
+            for (size_t i = 0; i < count; ++i, p += stride) {
+                left[i] = decode(p);
+                right[i] = decode(p + rightOffset);
+            }
+        }
+    };
+
+    struct Voice {
+        std::atomic<uint32_t> state{kIdle};
+        std::atomic<uint32_t> generation{0};
+        std::atomic<Sample*> sample{nullptr};
+        std::atomic<size_t> streamBase{0};
+        // Vom Audio-Thread nach jedem render() veröffentlicht
+        std::atomic<size_t> consumed{0};
+        size_t position = 0; // nur Audio-Thread
+        // chunksPerVoice Slots, je chunkFrames links, dann rechts. Vom
+        // zuständigen I/O-Thread beim ersten Block angelegt; der Audio-Thread
+        // liest erst nach passendem Tag
+        std::unique_ptr<float[]> ring;
+
+        // Blenden bei Aussetzern, nur Audio-Thread
+        bool starved = false;
+        size_t fadeOut = 0;
+        size_t fadeIn = 0;
+        float lastLeft = 0.0f;
+        float lastRight = 0.0f;
+
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> missedFrames{0};
+        std::atomic<uint64_t> streamedFrames{0};
+    };
+
+    Config config;
+    std::unique_ptr<std::atomic<Sample*>[]> sampleTable;
+    // Besitz, unter mutex; ein Slot behält seine Sample-Struktur für immer
+    std::vector<std::unique_ptr<Sample>> samples;
+    std::vector<uint32_t> freeSlots;  // unter mutex
+    size_t liveSamples = 0;           // unter mutex
+    std::unique_ptr<Voice[]> voices;
+    std::unique_ptr<std::atomic<uint64_t>[]> tags;
+
+    std::atomic<size_t> residentBytes{0};
+    std::atomic<size_t> mappedBytes{0};
+    // Summen über alle Stimmen; die Zähler einer Stimme beginnen bei jedem
+    // startVoice() neu
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> missedFrames{0};
+    std::atomic<uint64_t> streamedFrames{0};
+
+    std::vector<std::thread> ioThreads;
+    std::mutex mutex;
+    std::vector<Sample*> pendingRemovals;
+    std::atomic<bool> running{true};
+    std::atomic<bool> paused{false};
+
+    // Aufwecken wie im AudioWorkerPool: Epoche zählen, nur bei Schläfern notify
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<uint64_t> workEpoch{0};
+    std::atomic<uint32_t> sleepingThreads{0};
+
+    void notifyIO() {
+        workEpoch.fetch_add(1);
+        if (sleepingThreads.load() > 0) wake.notify_all();
+    }
+
+    float* ring(size_t voice, size_t slot) {
+        return voices[voice].ring.get() + slot * config.chunkFrames * 2;
+    }
+    std::atomic<uint64_t>& tag(size_t voice, size_t slot) {
+        return tags[voice * config.chunksPerVoice + slot];
+    }
+    const std::atomic<uint64_t>& tag(size_t voice, size_t slot) const {
+        return tags[voice * config.chunksPerVoice + slot];
+    }
+
+    Sample* findSample(SampleId id) const {
+        const size_t slot = id & kSlotMask;
+        if (slot >= config.maxSamples) return nullptr;
+        Sample* sample = sampleTable[slot].load(std::memory_order_acquire);
+        return sample && sample->id.load() == id ? sample : nullptr;
+    }
+
+    // Wählt einen freien Slot und zählt seine Generation hoch
+    Sample* reserveSlot(const std::string& path);
+    void returnSlot(Sample* sample);
+
+    static void parseWav(Sample& sample);
+
+    // I/O-Thread: Stimme freigeben oder den nächsten fehlenden Block
+    // lesen; true, wenn gelesen wurde
+    bool service(size_t index);
+    void releaseRemovedSamples();
+    void ioLoop(size_t thread);
+
+    // Audio-Thread
+    void mix(Voice& voice, const float* srcLeft, const float* srcRight,
+             float* left, float* right, size_t count, float gain);
+    void starve(Voice& voice, float* left, float* right, size_t count, float gain);
+};
+
+void SampleStreamer::Impl::parseWav(Sample& sample) {
+    const uint8_t* data = sample.file.data();
+    const size_t size = sample.file.size();
+    if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+        throw std::runtime_error("Kein WAV: " + sample.path);
+    }
+
+    uint16_t format = 0;
+    uint16_t bits = 0;
+    bool haveFormat = false;
+    for (size_t offset = 12; offset + 8 <= size;) {
+        const uint8_t* chunk = data + offset;
+        const size_t length = readU32(chunk + 4);
+        const uint8_t* body = chunk + 8;
+        const size_t bodyLength = std::min(length, size - offset - 8);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && bodyLength >= 16) {
+            format = readU16(body);
+            sample.channels = readU16(body + 2);
+            sample.sampleRate = static_cast<float>(readU32(body + 4));
+            bits = readU16(body + 14);
+            // WAVE_FORMAT_EXTENSIBLE: Format steht am Anfang der Sub-GUID
+            if (format == 0xfffe && bodyLength >= 26) format = readU16(body + 24);
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0 && haveFormat) {
+            if (format == 1 && bits == 16) sample.encoding = Encoding::Int16;
+            else if (format == 1 && bits == 24) sample.encoding = Encoding::Int24;
+            else if (format == 1 && bits == 32) sample.encoding = Encoding::Int32;
+            else if (format == 3 && bits == 32) sample.encoding = Encoding::Float32;
+            else throw std::runtime_error("WAV-Format nicht unterstützt: " + sample.path);
+            if (sample.channels == 0) throw std::runtime_error("WAV ohne Kanäle: " + sample.path);
+
+            sample.bytesPerSample = bits / 8;
+            sample.pcm = body;
+            sample.frames = bodyLength / sample.frameBytes();
+            return;
+        }
+        offset += 8 + length + (length & 1);
+    }
+    throw std::runtime_error("WAV ohne Daten: " + sample.path);
+}
+
+bool SampleStreamer::Impl::service(size_t index) {
+    Voice& voice = voices[index];
+    const uint32_t state = voice.state.load(std::memory_order_acquire);
+    if (state == kReleasing) {
+        Sample* sample = voice.sample.load(std::memory_order_relaxed);
+        voice.state.store(kIdle, std::memory_order_release);
+        // Letzte Stimme eines entfernten Samples: Thread 0 gibt es frei
+        if (sample->users.fetch_sub(1) == 1 && sample->removed.load()) notifyIO();
+        return false;
+    }
+    if (state != kPlaying || paused.load(std::memory_order_relaxed)) return false;
+
+    const Sample& sample = *voice.sample.load(std::memory_order_relaxed);
+    const uint32_t generation = voice.generation.load(std::memory_order_relaxed);
+    const size_t base = voice.streamBase.load(std::memory_order_relaxed);
+    const size_t consumed = voice.consumed.load(std::memory_order_acquire);
+    const size_t first = consumed <= base ? 0 : (consumed - base) / config.chunkFrames;
+
+    // Nur Blöcke ab dem gerade gelesenen: deren Slots liest der Audio-Thread
+    // nicht mehr, und ein fertiger Slot wird nie überschrieben
+    for (size_t k = first; k < first + config.chunksPerVoice; ++k) {
+        const size_t frame = base + k * config.chunkFrames;
+        if (frame >= sample.frames) break;
+        const size_t slot = k % config.chunksPerVoice;
+        const uint64_t expected = makeTag(generation, k);
+        if (tag(index, slot).load(std::memory_order_relaxed) == expected) continue;
+
+        if (!voice.ring) {
+            const size_t ringFloats = config.chunksPerVoice * config.chunkFrames * 2;
+            voice.ring = std::make_unique<float[]>(ringFloats);
+            residentBytes.fetch_add(ringFloats * sizeof(float), std::memory_order_relaxed);
+        }
+        const size_t count = std::min(config.chunkFrames, sample.frames - frame);
+        float* target = ring(index, slot);
+        sample.read(frame, count, target, target + config.chunkFrames);
+        tag(index, slot).store(expected, std::memory_order_release);
+        voice.streamedFrames.fetch_add(count, std::memory_order_relaxed);
+        streamedFrames.fetch_add(count, std::memory_order_relaxed);
+
+        // Den Block hinter dem Ring schon vom Kernel holen lassen
+        const size_t ahead = frame + config.chunksPerVoice * config.chunkFrames;
+        sample.file.prefetch(static_cast<size_t>(sample.pcm - sample.file.data()) + ahead * sample.frameBytes(),
+                             config.chunkFrames * sample.frameBytes());
+        return true;
+    }
+    return false;
+}
+
+void SampleStreamer::Impl::releaseRemovedSamples() {
+    std::vector<Sample*> release;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = pendingRemovals.begin(); it != pendingRemovals.end();) {
+            if ((*it)->users.load() == 0) {
+                release.push_back(*it);
+                it = pendingRemovals.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (release.empty()) return;
+
+    // Unmap außerhalb des Locks; die Sample-Struktur bleibt im Slot, damit
+    // ein gleichzeitiges startVoice() nur removed und die alte id sieht
+    for (Sample* sample : release) {
+        residentBytes.fetch_sub(sample->head.size() * sizeof(float), std::memory_order_relaxed);
+        mappedBytes.fetch_sub(sample->file.size(), std::memory_order_relaxed);
+        std::vector<float>().swap(sample->head);
+        sample->file.close();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Sample* sample : release) {
+        freeSlots.push_back(sample->id.load() & kSlotMask);
+        --liveSamples;
+    }
+}
+
+void SampleStreamer::Impl::ioLoop(size_t thread) {
+    while (running.load(std::memory_order_acquire)) {
+        const uint64_t seen = workEpoch.load();
+        if (thread == 0) releaseRemovedSamples();
+
+        // Breitensuche: pro Durchgang höchstens ein Block je Stimme, damit
+        // die knappsten Stimmen nicht hinter einer vollen warten
+        bool worked = false;
+        for (size_t v = thread; v < config.maxVoices; v += config.ioThreads) {
+            worked = service(v) || worked;
+        }
+        if (worked) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingThreads.fetch_add(1);
+        while (workEpoch.load() == seen) {
+            wake.wait_for(lock, kWakeTimeout);
+        }
+        sleepingThreads.fetch_sub(1);
+    }
+}
+
+SampleStreamer::Impl::Sample* SampleStreamer::Impl::reserveSlot(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Sample* sample;
+    if (!freeSlots.empty()) {
+        sample = samples[freeSlots.back()].get();
+        freeSlots.pop_back();
+    } else if (samples.size() < config.maxSamples) {
+        samples.push_back(std::make_unique<Sample>());
+        sample = samples.back().get();
+        sample->id.store(makeSampleId(0, samples.size() - 1));
+        sampleTable[samples.size() - 1].store(sample, std::memory_order_release);
+    } else {
+        throw std::runtime_error("Zu viele Samples: " + path);
+    }
+    ++sample->generation;
+    return sample;
+}
+
+void SampleStreamer::Impl::returnSlot(Sample* sample) {
+    sample->file.close();
+    std::vector<float>().swap(sample->head);
+    std::lock_guard<std::mutex> lock(mutex);
+    freeSlots.push_back(sample->id.load() & kSlotMask);
+}
+
+void SampleStreamer::Impl::mix(Voice& voice, const float* srcLeft, const float* srcRight,
+                               float* left, float* right, size_t count, float gain) {
+    size_t i = 0;
+    if (voice.starved) {
+        voice.starved = false;
+        voice.fadeIn = kFadeFrames;
+    }
+    for (; i < count && voice.fadeIn > 0; ++i, --voice.fadeIn) {
+        const float fade = gain * (1.0f - static_cast<float>(voice.fadeIn) / kFadeFrames);
+        left[i] += srcLeft[i] * fade;
+        right[i] += srcRight[i] * fade;
+    }
+    if (i < count) {
+        dsp::multiplyAdd(left + i, srcLeft + i, count - i, gain);
+        dsp::multiplyAdd(right + i, srcRight + i, count - i, gain);
+    }
+    voice.lastLeft = srcLeft[count - 1];
+    voice.lastRight = srcRight[count - 1];
+}
+
+void SampleStreamer::Impl::starve(Voice& voice, float* left, float* right, size_t count, float gain) {
+    if (!voice.starved) {
+        voice.starved = true;
+        voice.fadeOut = kFadeFrames;
+        voice.fadeIn = 0;
+    }
+    // Letzten Wert ausblenden statt hart auf 0
+    for (size_t i = 0; i < count && voice.fadeOut > 0; ++i, --voice.fadeOut) {
+        const float fade = gain * static_cast<float>(voice.fadeOut - 1) / kFadeFrames;
+        left[i] += voice.lastLeft * fade;
+        right[i] += voice.lastRight * fade;
+    }
+}
+
+SampleStreamer::SampleStreamer()
+    : SampleStreamer(Config())
+{
+}
+
+SampleStreamer::SampleStreamer(const Config& config)
+    : pImpl(std::make_unique<Impl>())
+{
+    Impl& impl = *pImpl;
+    impl.config = config;
+    impl.config.maxVoices = std::max<size_t>(1, config.maxVoices);
+    impl.config.chunkFrames = std::max<size_t>(1, config.chunkFrames);
+    impl.config.chunksPerVoice = std::max<size_t>(2, config.chunksPerVoice);
+    impl.config.ioThreads = std::max<size_t>(1, config.ioThreads);
+    impl.config.maxSamples = std::min<size_t>(config.maxSamples, kSlotMask);
+
+    impl.sampleTable = std::make_unique<std::atomic<Impl::Sample*>[]>(impl.config.maxSamples);
+    for (size_t i = 0; i < impl.config.maxSamples; ++i) impl.sampleTable[i].store(nullptr);
+    impl.voices = std::make_unique<Impl::Voice[]>(impl.config.maxVoices);
+
+    const size_t slots = impl.config.maxVoices * impl.config.chunksPerVoice;
+    impl.tags = std::make_unique<std::atomic<uint64_t>[]>(slots);
+    for (size_t i = 0; i < slots; ++i) impl.tags[i].store(0);
+
+    for (size_t t = 0; t < impl.config.ioThreads; ++t) {
+        impl.ioThreads.emplace_back([this, t] { pImpl->ioLoop(t); });
+    }
+}
+
+SampleStreamer::~SampleStreamer() {
+    pImpl->running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(pImpl->sleepMutex);
+        pImpl->workEpoch.fetch_add(1);
+    }
+    pImpl->wake.notify_all();
+    for (auto& thread : pImpl->ioThreads) thread.join();
+}
+
+SampleStreamer::SampleId SampleStreamer::addSample(const std::string& path) {
+    Impl& impl = *pImpl;
+    // Der Slot ist bis zur Veröffentlichung entfernt und mit alter id
+    // unsichtbar; Datei und Kopf werden außerhalb des Locks geladen
+    Impl::Sample* sample = impl.reserveSlot(path);
+    try {
+        sample->path = path;
+        if (!sample->file.open(path)) throw std::runtime_error("Datei nicht lesbar: " + path);
+        Impl::parseWav(*sample);
+
+        const size_t resident = std::min(sample->frames, impl.config.headFrames);
+        sample->residentFrames = resident;
+        sample->head.resize(resident * 2);
+        sample->read(0, resident, sample->head.data(), sample->head.data() + resident);
+    } catch (...) {
+        impl.returnSlot(sample);
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(impl.mutex);
+    const SampleId id = makeSampleId(sample->generation, sample->id.load() & kSlotMask);
+    impl.residentBytes.fetch_add(sample->head.size() * sizeof(float), std::memory_order_relaxed);
+    impl.mappedBytes.fetch_add(sample->file.size(), std::memory_order_relaxed);
+    ++impl.liveSamples;
+    // Erst die neue id, dann removed löschen: startVoice() prüft umgekehrt
+    sample->id.store(id);
+    sample->removed.store(false);
+    return id;
+}
+
+void SampleStreamer::removeSample(SampleId id) {
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        Impl::Sample* sample = pImpl->findSample(id);
+        if (!sample || sample->removed.exchange(true)) return;
+        pImpl->pendingRemovals.push_back(sample);
+    }
+    pImpl->notifyIO();
+}
+
+SampleStreamer::SampleInfo SampleStreamer::getSampleInfo(SampleId id) const {
+    SampleInfo info;
+    const Impl::Sample* sample = pImpl->findSample(id);
+    if (!sample || sample->removed.load()) return info;
+    info.frames = sample->frames;
+    info.channels = sample->channels;
+    info.sampleRate = sample->sampleRate;
+    info.residentFrames = sample->residentFrames;
+    return info;
+}
+
+SampleStreamer::VoiceId SampleStreamer::startVoice(SampleId id, size_t startFrame) {
+    Impl& impl = *pImpl;
+    Impl::Sample* sample = impl.findSample(id);
+    if (!sample || startFrame >= sample->frames) return kInvalidVoice;
+
+    // Erst als Nutzer eintragen, dann removed und id prüfen; das Freigeben
+    // prüft in umgekehrter Reihenfolge (alles seq_cst). Die id fängt einen
+    // inzwischen wiederverwendeten Slot ab
+    sample->users.fetch_add(1);
+    if (sample->removed.load() || sample->id.load() != id) {
+        sample->users.fetch_sub(1);
+        return kInvalidVoice;
+    }
+
+    // Kleinster freier Index, damit nur so viele Ringe entstehen, wie
+    // Stimmen gleichzeitig klingen
+    for (size_t index = 0; index < impl.config.maxVoices; ++index) {
+        Impl::Voice& voice = impl.voices[index];
+        if (voice.state.load(std::memory_order_acquire) != kIdle) continue;
+
+        voice.sample.store(sample, std::memory_order_relaxed);
+        voice.generation.store(voice.generation.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        voice.streamBase.store(std::max(startFrame, sample->residentFrames), std::memory_order_relaxed);
+        voice.position = startFrame;
+        voice.consumed.store(startFrame, std::memory_order_relaxed);
+        voice.starved = false;
+        voice.fadeOut = 0;
+        voice.fadeIn = 0;
+        voice.lastLeft = 0.0f;
+        voice.lastRight = 0.0f;
+        voice.misses.store(0, std::memory_order_relaxed);
+        voice.missedFrames.store(0, std::memory_order_relaxed);
+        voice.streamedFrames.store(0, std::memory_order_relaxed);
+        voice.state.store(kPlaying, std::memory_order_release);
+        impl.notifyIO();
+        return static_cast<VoiceId>(index);
+    }
+
+    sample->users.fetch_sub(1);
+    return kInvalidVoice;
+}
+
+size_t SampleStreamer::render(VoiceId id, float* left, float* right, size_t numFrames, float gain) {
+    Impl& impl = *pImpl;
+    if (id >= impl.config.maxVoices) return 0;
+    Impl::Voice& voice = impl.voices[id];
+    if (voice.state.load(std::memory_order_relaxed) != kPlaying) return 0;
+
+    const Impl::Sample& sample = *voice.sample.load(std::memory_order_relaxed);
+    const uint32_t generation = voice.generation.load(std::memory_order_relaxed);
+    const size_t base = voice.streamBase.load(std::memory_order_relaxed);
+    const size_t chunkFrames = impl.config.chunkFrames;
+    const size_t available = sample.frames > voice.position ? std::min(numFrames, sample.frames - voice.position) : 0;
+
+    size_t missing = 0;
+    for (size_t i = 0; i < available;) {
+        const size_t frame = voice.position + i;
+        size_t run;
+        if (frame < base) {
+            // Kopf; liegt immer im Speicher
+            run = std::min(available - i, base - frame);
+            const float* head = sample.head.data();
+            impl.mix(voice, head + frame, head + sample.residentFrames + frame, left + i, right + i, run, gain);
+        } else {
+            const size_t k = (frame - base) / chunkFrames;
+            const size_t offset = (frame - base) % chunkFrames;
+            const size_t slot = k % impl.config.chunksPerVoice;
+            run = std::min(available - i, chunkFrames - offset);
+            if (impl.tag(id, slot).load(std::memory_order_acquire) == makeTag(generation, k)) {
+                const float* chunk = impl.ring(id, slot);
+                impl.mix(voice, chunk + offset, chunk + chunkFrames + offset, left + i, right + i, run, gain);
+            } else {
+                impl.starve(voice, left + i, right + i, run, gain);
+                missing += run;
+            }
+        }
+        i += run;
+    }
+
+    if (missing > 0) {
+        voice.misses.fetch_add(1, std::memory_order_relaxed);
+        voice.missedFrames.fetch_add(missing, std::memory_order_relaxed);
+        impl.misses.fetch_add(1, std::memory_order_relaxed);
+        impl.missedFrames.fetch_add(missing, std::memory_order_relaxed);
+    }
+
+    // Zeitlich weiterlaufen, auch über Aussetzer hinweg. Erster noch
+    // gebrauchter Block wie in service()
+    const auto firstChunk = [base, chunkFrames](size_t position) {
+        return position <= base ? 0 : (position - base) / chunkFrames;
+    };
+    const size_t previous = voice.position;
+    voice.position += numFrames;
+    voice.consumed.store(voice.position, std::memory_order_release);
+    if (voice.position >= sample.frames) {
+        voice.state.store(kReleasing, std::memory_order_release);
+        impl.notifyIO();
+    } else if (firstChunk(voice.position) != firstChunk(previous)) {
+        // Ein Block ist verbraucht, sein Slot kann nachgeladen werden
+        impl.notifyIO();
+    }
+    return available;
+}
+
+void SampleStreamer::stopVoice(VoiceId id) {
+    if (id >= pImpl->config.maxVoices) return;
+    uint32_t expected = kPlaying;
+    if (pImpl->voices[id].state.compare_exchange_strong(expected, kReleasing, std::memory_order_acq_rel)) {
+        pImpl->notifyIO();
+    }
+}
+
+bool SampleStreamer::isPlaying(VoiceId id) const {
+    return id < pImpl->config.maxVoices
+        && pImpl->voices[id].state.load(std::memory_order_acquire) == kPlaying;
+}
+
+size_t SampleStreamer::getBufferedFrames(VoiceId id) const {
+    const Impl& impl = *pImpl;
+    if (!isPlaying(id)) return 0;
+    const Impl::Voice& voice = impl.voices[id];
+    const Impl::Sample* sample = voice.sample.load(std::memory_order_relaxed);
+    const uint32_t generation = voice.generation.load(std::memory_order_relaxed);
+    const size_t base = voice.streamBase.load(std::memory_order_relaxed);
+    const size_t position = voice.consumed.load(std::memory_order_acquire);
+    if (position >= sample->frames) return 0;
+
+    size_t end = std::max(position, base);
+    for (size_t k = (end - base) / impl.config.chunkFrames; end < sample->frames; ++k) {
+        const size_t slot = k % impl.config.chunksPerVoice;
+        if (impl.tag(id, slot).load(std::memory_order_acquire) != makeTag(generation, k)) break;
+        end = std::min(sample->frames, base + (k + 1) * impl.config.chunkFrames);
+    }
+    return end - position;
+}
+
+SampleStreamer::VoiceStats SampleStreamer::getVoiceStats(VoiceId id) const {
+    VoiceStats stats;
+    if (id >= pImpl->config.maxVoices) return stats;
+    const Impl::Voice& voice = pImpl->voices[id];
+    stats.misses = voice.misses.load(std::memory_order_relaxed);
+    stats.missedFrames = voice.missedFrames.load(std::memory_order_relaxed);
+    stats.streamedFrames = voice.streamedFrames.load(std::memory_order_relaxed);
+    return stats;
+}
+
+SampleStreamer::Stats SampleStreamer::getStats() const {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        stats.samples = pImpl->liveSamples;
+    }
+    for (size_t v = 0; v < pImpl->config.maxVoices; ++v) {
+        if (pImpl->voices[v].state.load(std::memory_order_relaxed) == kPlaying) ++stats.activeVoices;
+    }
+    stats.misses = pImpl->misses.load(std::memory_order_relaxed);
+    stats.missedFrames = pImpl->missedFrames.load(std::memory_order_relaxed);
+    stats.streamedFrames = pImpl->streamedFrames.load(std::memory_order_relaxed);
+    stats.residentBytes = pImpl->residentBytes.load(std::memory_order_relaxed);
+    stats.mappedBytes = pImpl->mappedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SampleStreamer::setIOPaused(bool paused) {
+    pImpl->paused.store(paused, std::memory_order_relaxed);
+    pImpl->notifyIO();
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace VR_DAW {
+
+// Disk-Streaming für große Sample-Bibliotheken. Von jedem Sample liegt nur
+// der Kopf (headFrames) dekodiert im Speicher; der Rest bleibt in der
+// gemappten Datei und wird von I/O-Threads blockweise in einen kleinen Ring
+// je Stimme vorausgelesen. Seitenfehler und Plattenzugriffe passieren so
+// nur auf den I/O-Threads, nie im Audio-Thread. Ein Ring wird erst beim
+// ersten Block seiner Stimme angelegt; Stimmen werden von unten vergeben,
+// der Speicher folgt so der höchsten gleichzeitigen Stimmenzahl. Ohne
+// Arbeit schlafen die I/O-Threads, bis der Audio-Thread einen Block
+// verbraucht oder eine Stimme startet oder beendet.
+//
+// Kommen Daten nicht rechtzeitig, spielt die Stimme an der Stelle Stille
+// (mit kurzer Blende statt Knacken), läuft zeitlich aber weiter und setzt
+// wieder ein, sobald der Ring aufgeholt hat. Fehlstellen werden je Stimme
+// gezählt.
+//
+// Unterstützt unkomprimiertes WAV (PCM 16/24/32 Bit, Float 32 Bit), Mono
+// wird auf beide Seiten gelegt, ab dem dritten Kanal wird verworfen.
+class SampleStreamer {
+public:
+    using SampleId = uint32_t;
+    using VoiceId = uint32_t;
+    static constexpr SampleId kInvalidSample = 0xffffffffu;
+    static constexpr VoiceId kInvalidVoice = 0xffffffffu;
+
+    struct Config {
+        size_t maxVoices = 1024;
+        // Höchstens 65535: die oberen 16 Bit einer SampleId sind die
+        // Generation ihres Slots
+        size_t maxSamples = 65535;
+        // Resident je Sample; muss die Zeit bis zum ersten gestreamten
+        // Block überbrücken
+        size_t headFrames = 8192;
+        // Lese-Einheit der I/O-Threads und Read-ahead je Stimme
+        size_t chunkFrames = 1024;
+        size_t chunksPerVoice = 8;
+        size_t ioThreads = 2;
+    };
+
+    struct SampleInfo {
+        size_t frames = 0;
+        uint32_t channels = 0;  // in der Datei
+        float sampleRate = 0.0f;
+        size_t residentFrames = 0;
+    };
+
+    // Zähler einer Stimme, bleiben bis zum nächsten startVoice() erhalten
+    struct VoiceStats {
+        uint64_t misses = 0;         // render()-Aufrufe mit fehlenden Daten
+        uint64_t missedFrames = 0;   // durch Stille ersetzte Frames
+        uint64_t streamedFrames = 0; // von der Platte gelesene Frames
+    };
+
+    struct Stats {
+        size_t samples = 0;
+        size_t activeVoices = 0;
+        uint64_t misses = 0;
+        uint64_t missedFrames = 0;
+        uint64_t streamedFrames = 0;
+        size_t residentBytes = 0;  // Köpfe und angelegte Ringe
+        size_t mappedBytes = 0;
+    };
+
+    SampleStreamer();
+    explicit SampleStreamer(const Config& config);
+    ~SampleStreamer();
+
+    SampleStreamer(const SampleStreamer&) = delete;
+    SampleStreamer& operator=(const SampleStreamer&) = delete;
+
+    // Kontroll-Thread. addSample() mappt die Datei und dekodiert den Kopf;
+    // wirft std::runtime_error bei unlesbaren oder nicht unterstützten Dateien
+    SampleId addSample(const std::string& path);
+    // Speicher wird freigegeben, sobald keine Stimme das Sample mehr spielt;
+    // danach wird der Slot mit neuer Generation wiederverwendet, die alte
+    // ID bleibt ungültig
+    void removeSample(SampleId sample);
+    SampleInfo getSampleInfo(SampleId sample) const;
+
+    // Audio-Thread (genau einer). startVoice() liefert kInvalidVoice, wenn
+    // alle Stimmen belegt sind
+    VoiceId startVoice(SampleId sample, size_t startFrame = 0);
+    // Addiert numFrames mit gain auf left/right; liefert die Zahl der Frames
+    // bis zum Sample-Ende. Am Ende wird die Stimme freigegeben
+    size_t render(VoiceId voice, float* left, float* right, size_t numFrames, float gain = 1.0f);
+    void stopVoice(VoiceId voice);
+
+    // Beliebiger Thread
+    bool isPlaying(VoiceId voice) const;
+    // Lückenlos lesbare Frames ab der aktuellen Position (Kopf und Ring)
+    size_t getBufferedFrames(VoiceId voice) const;
+    VoiceStats getVoiceStats(VoiceId voice) const;
+    Stats getStats() const;
+
+    // Hält die I/O-Threads an, z.B. um Aushungern zu testen
+    void setIOPaused(bool paused);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -4,12 +4,13 @@
 #include <curl/curl.h>
 #include <zip.h>
 #include <openssl/sha.h>
-#include <sqlite3.h>
 #include <nlohmann/json.hpp>
 
 namespace VR_DAW {
 
-SoundSampleBank::SoundSampleBank() {
+SoundSampleBank::SoundSampleBank()
+    : streamer(std::make_unique<SampleStreamer>())
+{
     initialize();
 }
 
@@ -21,43 +22,8 @@ void SoundSampleBank::initialize() {
     // CURL initialisieren
     curl_global_init(CURL_GLOBAL_ALL);
     
-    // Datenbank initialisieren
-    sqlite3* db;
-    sqlite3_open("samples.db", &db);
-    
-    // Tabellen erstellen
-    const char* sql = R"(
-        CREATE TABLE IF NOT EXISTS samples (
-            name TEXT PRIMARY KEY,
-            path TEXT,
-            metadata TEXT,
-            last_updated TIMESTAMP,
-            is_free BOOLEAN,
-            download_count INTEGER,
-            rating FLOAT
-        );
-        
-        CREATE TABLE IF NOT EXISTS categories (
-            name TEXT,
-            category TEXT,
-            PRIMARY KEY (name, category)
-        );
-        
-        CREATE TABLE IF NOT EXISTS updates (
-            id INTEGER PRIMARY KEY,
-            timestamp TIMESTAMP,
-            status TEXT,
-            details TEXT
-        );
-    )";
-    
-    char* errMsg = nullptr;
-    sqlite3_exec(db, sql, nullptr, nullptr, &errMsg);
-    if (errMsg) {
-        sqlite3_free(errMsg);
-    }
-    
-    sqlite3_close(db);
+    // Datenbank öffnen; Verbindung und Statements bleiben bis zum Ende
+    database = std::make_unique<SampleDatabase>("samples.db");
     
     // Update-Zeitplan initialisieren
     nextUpdateTime = std::chrono::system_clock::now() + std::chrono::hours(24 * 60); // 2 Monate
@@ -74,14 +40,23 @@ void SoundSampleBank::shutdown() {
 }
 
 void SoundSampleBank::addSample(const std::string& path, const SampleMetadata& metadata) {
-    // Sample laden
-    loadSample(path);
+    // Sample laden; nur der Kopf wird dekodiert
+    SampleStreamer::SampleId stream;
+    try {
+        stream = loadSample(path);
+    } catch (const std::exception& e) {
+        logActivity(std::string("Sample nicht geladen: ") + e.what());
+        return;
+    }
     
     // Metadaten validieren
     validateSampleMetadata(metadata);
     
-    // Sample speichern
+    // Sample speichern; ein ersetztes Sample wird freigegeben
+    auto existing = samples.find(metadata.name);
+    if (existing != samples.end()) streamer->removeSample(existing->second.stream);
     SampleData data;
+    data.stream = stream;
     data.metadata = metadata;
     data.isPlaying = false;
     data.volume = 1.0f;
@@ -97,52 +72,7 @@ void SoundSampleBank::addSample(const std::string& path, const SampleMetadata& m
     }
     
     // Datenbank aktualisieren
-    sqlite3* db;
-    sqlite3_open("samples.db", &db);
-    
-    nlohmann::json metadataJson = {
-        {"description", metadata.description},
-        {"source", metadata.source},
-        {"license", metadata.license},
-        {"format", metadata.format},
-        {"duration", metadata.duration},
-        {"bpm", metadata.bpm},
-        {"key", metadata.key},
-        {"tags", metadata.tags},
-        {"isFree", metadata.isFree},
-        {"downloadUrl", metadata.downloadUrl},
-        {"previewUrl", metadata.previewUrl},
-        {"author", metadata.author},
-        {"country", metadata.country},
-        {"culture", metadata.culture},
-        {"instrument", metadata.instrument},
-        {"technique", metadata.technique},
-        {"mood", metadata.mood},
-        {"genre", metadata.genre},
-        {"style", metadata.style},
-        {"era", metadata.era},
-        {"quality", metadata.quality},
-        {"bitDepth", metadata.bitDepth},
-        {"sampleRate", metadata.sampleRate},
-        {"channels", metadata.channels},
-        {"size", metadata.size},
-        {"hash", metadata.hash},
-        {"version", metadata.version}
-    };
-    
-    const char* sql = "INSERT OR REPLACE INTO samples (name, path, metadata, last_updated, is_free) VALUES (?, ?, ?, ?, ?);";
-    sqlite3_stmt* stmt;
-    sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    
-    sqlite3_bind_text(stmt, 1, metadata.name.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, path.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 3, metadataJson.dump().c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int64(stmt, 4, std::chrono::system_clock::to_time_t(metadata.lastUpdated));
-    sqlite3_bind_int(stmt, 5, metadata.isFree ? 1 : 0);
-    
-    sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    sqlite3_close(db);
+    database->upsert(path, metadata);
     
     // Aktivität protokollieren
     logActivity("Sample hinzugefügt: " + metadata.name);
@@ -159,27 +89,13 @@ void SoundSampleBank::removeSample(const std::string& name) {
             removeFromCategoryIndex(name, static_cast<SampleCategory>(std::stoi(category)));
         }
         
-        // Aus Speicher entfernen
+        // Aus Speicher entfernen; der Streamer gibt Kopf und Mapping frei,
+        // sobald keine Stimme es mehr spielt
+        streamer->removeSample(it->second.stream);
         samples.erase(it);
         
         // Aus Datenbank entfernen
-        sqlite3* db;
-        sqlite3_open("samples.db", &db);
-        
-        const char* sql = "DELETE FROM samples WHERE name = ?;";
-        sqlite3_stmt* stmt;
-        sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-        
-        sql = "DELETE FROM categories WHERE name = ?;";
-        sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-        
-        sqlite3_close(db);
+        database->remove(name);
         
         // Aktivität protokollieren
         logActivity("Sample entfernt: " + name);
@@ -202,51 +118,10 @@ void SoundSampleBank::updateSample(const std::string& name, const SampleMetadata
             updateCategoryIndex(name, static_cast<SampleCategory>(std::stoi(category)));
         }
         
-        // Datenbank aktualisieren
-        sqlite3* db;
-        sqlite3_open("samples.db", &db);
-        
-        nlohmann::json metadataJson = {
-            {"description", metadata.description},
-            {"source", metadata.source},
-            {"license", metadata.license},
-            {"format", metadata.format},
-            {"duration", metadata.duration},
-            {"bpm", metadata.bpm},
-            {"key", metadata.key},
-            {"tags", metadata.tags},
-            {"isFree", metadata.isFree},
-            {"downloadUrl", metadata.downloadUrl},
-            {"previewUrl", metadata.previewUrl},
-            {"author", metadata.author},
-            {"country", metadata.country},
-            {"culture", metadata.culture},
-            {"instrument", metadata.instrument},
-            {"technique", metadata.technique},
-            {"mood", metadata.mood},
-            {"genre", metadata.genre},
-            {"style", metadata.style},
-            {"era", metadata.era},
-            {"quality", metadata.quality},
-            {"bitDepth", metadata.bitDepth},
-            {"sampleRate", metadata.sampleRate},
-            {"channels", metadata.channels},
-            {"size", metadata.size},
-            {"hash", metadata.hash},
-            {"version", metadata.version}
-        };
-        
-        const char* sql = "UPDATE samples SET metadata = ?, last_updated = ? WHERE name = ?;";
-        sqlite3_stmt* stmt;
-        sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-        
-        sqlite3_bind_text(stmt, 1, metadataJson.dump().c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int64(stmt, 2, std::chrono::system_clock::to_time_t(metadata.lastUpdated));
-        sqlite3_bind_text(stmt, 3, name.c_str(), -1, SQLITE_STATIC);
-        
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-        sqlite3_close(db);
+        // Datenbank aktualisieren; Schlüssel ist der bisherige Name
+        SampleMetadata stored = metadata;
+        stored.name = name;
+        database->update(stored);
         
         // Aktivität protokollieren
         logActivity("Sample aktualisiert: " + name);
@@ -269,60 +144,9 @@ std::vector<SampleMetadata> SoundSampleBank::getSamplesByCategory(SampleCategory
     return result;
 }
 
-std::vector<SampleMetadata> SoundSampleBank::searchSamples(const std::string& query) {
-    std::vector<SampleMetadata> result;
-    
-    // Datenbank durchsuchen
-    sqlite3* db;
-    sqlite3_open("samples.db", &db);
-    
-    const char* sql = "SELECT metadata FROM samples WHERE metadata LIKE ?;";
-    sqlite3_stmt* stmt;
-    sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    
-    std::string searchPattern = "%" + query + "%";
-    sqlite3_bind_text(stmt, 1, searchPattern.c_str(), -1, SQLITE_STATIC);
-    
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        const char* metadataJson = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-        nlohmann::json json = nlohmann::json::parse(metadataJson);
-        
-        SampleMetadata metadata;
-        metadata.description = json["description"];
-        metadata.source = json["source"];
-        metadata.license = json["license"];
-        metadata.format = json["format"];
-        metadata.duration = json["duration"];
-        metadata.bpm = json["bpm"];
-        metadata.key = json["key"];
-        metadata.tags = json["tags"].get<std::vector<std::string>>();
-        metadata.isFree = json["isFree"];
-        metadata.downloadUrl = json["downloadUrl"];
-        metadata.previewUrl = json["previewUrl"];
-        metadata.author = json["author"];
-        metadata.country = json["country"];
-        metadata.culture = json["culture"];
-        metadata.instrument = json["instrument"];
-        metadata.technique = json["technique"];
-        metadata.mood = json["mood"];
-        metadata.genre = json["genre"];
-        metadata.style = json["style"];
-        metadata.era = json["era"];
-        metadata.quality = json["quality"];
-        metadata.bitDepth = json["bitDepth"];
-        metadata.sampleRate = json["sampleRate"];
-        metadata.channels = json["channels"];
-        metadata.size = json["size"];
-        metadata.hash = json["hash"];
-        metadata.version = json["version"];
-        
-        result.push_back(metadata);
-    }
-    
-    sqlite3_finalize(stmt);
-    sqlite3_close(db);
-    
-    return result;
+std::vector<SampleMetadata> SoundSampleBank::searchSamples(const std::string& query, size_t limit) {
+    // Volltextindex statt LIKE über den ganzen Katalog
+    return database->search(query, limit);
 }
 
 void SoundSampleBank::playSample(const std::string& name) {
@@ -330,14 +154,9 @@ void SoundSampleBank::playSample(const std::string& name) {
     if (it != samples.end()) {
         it->second.isPlaying = true;
         
-        // Audio-Engine starten
-        juce::AudioDeviceManager deviceManager;
-        deviceManager.initialise(2, 2, nullptr, true);
-        
-        // Sample abspielen
-        juce::AudioSourcePlayer player;
-        player.setSource(&it->second.buffer);
-        deviceManager.addAudioCallback(&player);
+        // Nur der Zustand: die Bank hängt an keinem Audio-Callback. Wer sie
+        // in den Render-Pfad einbindet, startet und rendert die Stimmen im
+        // Audio-Thread über getStreamer() und getSampleStream()
         
         // Aktivität protokollieren
         logActivity("Sample abgespielt: " + name);
@@ -369,20 +188,7 @@ void SoundSampleBank::checkForUpdates() {
         nextUpdateTime = now + std::chrono::hours(24 * 60); // 2 Monate
         
         // Update protokollieren
-        sqlite3* db;
-        sqlite3_open("samples.db", &db);
-        
-        const char* sql = "INSERT INTO updates (timestamp, status, details) VALUES (?, ?, ?);";
-        sqlite3_stmt* stmt;
-        sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-        
-        sqlite3_bind_int64(stmt, 1, std::chrono::system_clock::to_time_t(now));
-        sqlite3_bind_text(stmt, 2, "completed", -1, SQLITE_STATIC);
-        sqlite3_bind_text(stmt, 3, "Automatic update", -1, SQLITE_STATIC);
-        
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-        sqlite3_close(db);
+        database->recordUpdate(now, "completed", "Automatic update");
         
         // Benachrichtigung senden
         notifyUpdateAvailable();
@@ -407,6 +213,9 @@ void SoundSampleBank::updateSamples() {
     // CURL-Handle erstellen
     CURL* curl = curl_easy_init();
     
+    // Import als eine Transaktion statt eines Commits je Sample
+    SampleDatabase::Batch batch(*database);
+    
     for (const auto& source : sources) {
         // API-Anfrage senden
         curl_easy_setopt(curl, CURLOPT_URL, source.c_str());
@@ -575,11 +384,21 @@ void SoundSampleBank::cleanupOldSamples() {
     
     // Älteste 20% der Samples löschen
     size_t numToDelete = accessTimes.size() * 0.2;
+    SampleDatabase::Batch batch(*database);
     for (size_t i = 0; i < numToDelete; i++) {
         removeSample(accessTimes[i].first);
     }
 }
 
+SampleStreamer::SampleId SoundSampleBank::getSampleStream(const std::string& name) const {
+    auto it = samples.find(name);
+    return it != samples.end() ? it->second.stream : SampleStreamer::kInvalidSample;
+}
+
+SampleStreamer::SampleId SoundSampleBank::loadSample(const std::string& path) {
+    return streamer->addSample(path);
+}
+
 void SoundSampleBank::logActivity(const std::string& activity) {
     // Aktivität in Log-Datei schreiben
     std::ofstream logFile("sample_bank.log", std::ios::app);
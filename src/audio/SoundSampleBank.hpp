@@ -8,6 +8,8 @@
 #include <chrono>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
+#include "SampleDatabase.hpp"
+#include "SampleStreamer.hpp"
 
 namespace VR_DAW {
 
@@ -53,45 +55,15 @@ public:
         Custom          // Benutzerdefinierte Kategorien
     };
     
-    // Sample-Metadaten
-    struct SampleMetadata {
-        std::string name;
-        std::string description;
-        std::string source;
-        std::string license;
-        std::string format;
-        float duration;
-        float bpm;
-        std::string key;
-        std::vector<std::string> tags;
-        std::chrono::system_clock::time_point lastUpdated;
-        bool isFree;
-        std::string downloadUrl;
-        std::string previewUrl;
-        std::string author;
-        std::string country;
-        std::string culture;
-        std::string instrument;
-        std::string technique;
-        std::string mood;
-        std::string genre;
-        std::string style;
-        std::string era;
-        std::string quality;
-        std::string bitDepth;
-        std::string sampleRate;
-        std::string channels;
-        std::string size;
-        std::string hash;
-        std::string version;
-    };
+    // Sample-Metadaten (SampleDatabase.hpp)
+    using SampleMetadata = VR_DAW::SampleMetadata;
     
     // Sample-Verwaltung
     void addSample(const std::string& path, const SampleMetadata& metadata);
     void removeSample(const std::string& name);
     void updateSample(const std::string& name, const SampleMetadata& metadata);
     std::vector<SampleMetadata> getSamplesByCategory(SampleCategory category);
-    std::vector<SampleMetadata> searchSamples(const std::string& query);
+    std::vector<SampleMetadata> searchSamples(const std::string& query, size_t limit = 200);
     std::vector<SampleMetadata> getNewSamples();
     std::vector<SampleMetadata> getUpdatedSamples();
     std::vector<SampleMetadata> getPopularSamples();
@@ -145,11 +117,18 @@ public:
     std::map<SampleCategory, size_t> getCategoryDistribution() const;
     std::map<std::string, size_t> getFormatDistribution() const;
     std::map<std::string, size_t> getLicenseDistribution() const;
+
+    // Wiedergabe: ein Audio-Thread startet und rendert Stimmen direkt am
+    // Streamer, mit der Stream-ID des Samples (kInvalidSample, wenn unbekannt).
+    // Bisher ruft noch kein Render-Pfad die Bank auf
+    SampleStreamer& getStreamer() { return *streamer; }
+    SampleStreamer::SampleId getSampleStream(const std::string& name) const;
     
 private:
     // Interne Strukturen
     struct SampleData {
-        juce::AudioBuffer<float> buffer;
+        // Nur der Kopf ist dekodiert, der Rest wird von der Platte gestreamt
+        SampleStreamer::SampleId stream = SampleStreamer::kInvalidSample;
         SampleMetadata metadata;
         bool isPlaying;
         float volume;
@@ -162,9 +141,11 @@ private:
     std::unordered_map<std::string, SampleData> samples;
     std::map<SampleCategory, std::vector<std::string>> categoryIndex;
     std::chrono::system_clock::time_point nextUpdateTime;
+    std::unique_ptr<SampleStreamer> streamer;
+    std::unique_ptr<SampleDatabase> database;
     
     // Hilfsfunktionen
-    void loadSample(const std::string& path);
+    SampleStreamer::SampleId loadSample(const std::string& path);
     void saveSample(const std::string& name, const std::string& path);
     void updateCategoryIndex(const std::string& name, SampleCategory category);
     void removeFromCategoryIndex(const std::string& name, SampleCategory category);
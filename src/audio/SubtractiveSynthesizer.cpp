@@ -1,35 +1,67 @@
 #include "SubtractiveSynthesizer.hpp"
+#include "OscillatorTables.hpp"
 #include <algorithm>
 #include <cmath>
-#include <random>
 
 namespace VR_DAW {
 
 SubtractiveSynthesizer::SubtractiveSynthesizer()
     : oscillatorType(OscillatorType::Sine)
+    , oscillatorMode(OscillatorMode::PolyBLEP)
     , oscillatorMix(1.0f)
     , oscillatorDetune(0.0f)
     , oscillatorPhase(0.0f)
-    , filterType("lowpass")
+    , filterType(FilterType::Lowpass)
     , filterDrive(1.0f)
     , filterEnvelopeAmount(0.0f)
     , filterEnvelopeAttack(0.1f)
     , filterEnvelopeDecay(0.1f)
-    , lfoWaveform("sine")
-    , lfoDestination("filter")
-    , filterEnvelope(0.0f)
+    , lfoWaveform(LFOWaveform::Sine)
+    , lfoDestination(LFODestination::Filter)
+    , renderer(kDefaultMaxVoices)
+    , noiseState(0x2545F491u)
 {
-    filterState.fill(0.0f);
+    renderer.setSampleRate(sampleRate);
 }
 
 SubtractiveSynthesizer::~SubtractiveSynthesizer() {
 }
 
+void SubtractiveSynthesizer::setMaxVoices(size_t maxVoices) {
+    Synthesizer::setMaxVoices(maxVoices);
+    std::lock_guard<std::mutex> lock(mutex);
+    renderer.setMaxVoices(voices.size());
+}
+
+void SubtractiveSynthesizer::setSampleRate(float rate) {
+    Synthesizer::setSampleRate(rate);
+    std::lock_guard<std::mutex> lock(mutex);
+    renderer.setSampleRate(sampleRate);
+}
+
+void SubtractiveSynthesizer::resetVoices() {
+    Synthesizer::resetVoices();
+    renderer.reset();
+}
+
 void SubtractiveSynthesizer::setOscillatorType(OscillatorType type) {
     std::lock_guard<std::mutex> lock(mutex);
     oscillatorType = type;
 }
 
+void SubtractiveSynthesizer::setOscillatorType(const std::string& type) {
+    setOscillatorType(parseVoiceOscillator(type));
+}
+
+void SubtractiveSynthesizer::setOscillatorMode(OscillatorMode mode) {
+    std::lock_guard<std::mutex> lock(mutex);
+    oscillatorMode = mode;
+}
+
+void SubtractiveSynthesizer::setOscillatorMode(const std::string& mode) {
+    setOscillatorMode(parseOscillatorMode(mode));
+}
+
 void SubtractiveSynthesizer::setOscillatorMix(float mix) {
     std::lock_guard<std::mutex> lock(mutex);
     oscillatorMix = std::max(0.0f, std::min(1.0f, mix));
@@ -45,11 +77,15 @@ void SubtractiveSynthesizer::setOscillatorPhase(float phase) {
     oscillatorPhase = std::max(0.0f, std::min(1.0f, phase));
 }
 
-void SubtractiveSynthesizer::setFilterType(const std::string& type) {
+void SubtractiveSynthesizer::setFilterType(FilterType type) {
     std::lock_guard<std::mutex> lock(mutex);
     filterType = type;
 }
 
+void SubtractiveSynthesizer::setFilterType(const std::string& type) {
+    setFilterType(parseVoiceFilterType(type));
+}
+
 void SubtractiveSynthesizer::setFilterDrive(float drive) {
     std::lock_guard<std::mutex> lock(mutex);
     filterDrive = std::max(1.0f, std::min(10.0f, drive));
@@ -70,49 +106,80 @@ void SubtractiveSynthesizer::setFilterEnvelopeDecay(float decay) {
     filterEnvelopeDecay = std::max(0.001f, decay);
 }
 
-void SubtractiveSynthesizer::setLFOWaveform(const std::string& waveform) {
+void SubtractiveSynthesizer::setLFOWaveform(LFOWaveform waveform) {
     std::lock_guard<std::mutex> lock(mutex);
     lfoWaveform = waveform;
 }
 
-void SubtractiveSynthesizer::setLFODestination(const std::string& destination) {
+void SubtractiveSynthesizer::setLFOWaveform(const std::string& waveform) {
+    setLFOWaveform(parseLFOWaveform(waveform));
+}
+
+void SubtractiveSynthesizer::setLFODestination(LFODestination destination) {
     std::lock_guard<std::mutex> lock(mutex);
     lfoDestination = destination;
 }
 
-void SubtractiveSynthesizer::processBlock(float* output, size_t numSamples) {
-    std::lock_guard<std::mutex> lock(mutex);
+void SubtractiveSynthesizer::setLFODestination(const std::string& destination) {
+    setLFODestination(parseLFODestination(destination));
+}
 
-    for (size_t i = 0; i < numSamples; i += 2) {
-        float leftSample = 0.0f;
-        float rightSample = 0.0f;
-
-        // Alle aktiven Stimmen verarbeiten
-        for (auto& voice : voices) {
-            if (voice.active) {
-                float sample = generateSample(voice);
-                updateEnvelope(voice);
-                applyFilter(sample);
-                applyLFO(sample);
-                applyVolume(sample);
-
-                // Stereopanning anwenden
-                float leftGain = 1.0f - std::max(0.0f, pan);
-                float rightGain = 1.0f + std::min(0.0f, pan);
-                leftSample += sample * leftGain;
-                rightSample += sample * rightGain;
-            }
-        }
-
-        // Ausgabe schreiben
-        output[i] = leftSample;
-        output[i + 1] = rightSample;
-    }
+void SubtractiveSynthesizer::renderVoices(float* output, size_t numFrames) {
+    // Parameter einmal pro Aufruf einsammeln; der Renderer arbeitet alle
+    // klingenden Stimmen gemeinsam in SIMD-Lanes ab
+    renderer.render(output, numFrames, currentParameters());
+}
+
+void SubtractiveSynthesizer::voiceStarted(size_t index, bool retriggered) {
+    const Voice& voice = voices[index];
+    renderer.startVoice(index, voice.frequency, voice.velocity, oscillatorPhase, retriggered);
+}
+
+void SubtractiveSynthesizer::voiceReleased(size_t index) {
+    renderer.setGate(index, false);
+}
+
+void SubtractiveSynthesizer::voiceFrequencyChanged(size_t index) {
+    renderer.setFrequency(index, voices[index].frequency);
+}
+
+bool SubtractiveSynthesizer::isVoiceSounding(size_t index) const {
+    return renderer.isSounding(index);
+}
+
+float SubtractiveSynthesizer::getVoiceLevel(size_t index) const {
+    return renderer.getLevel(index);
+}
+
+VoiceLaneRenderer::Parameters SubtractiveSynthesizer::currentParameters() const {
+    VoiceLaneRenderer::Parameters params;
+    params.oscillator = oscillatorType;
+    params.oscillatorMode = oscillatorMode;
+    params.filterType = filterType;
+    params.lfoWaveform = lfoWaveform;
+    params.lfoDestination = lfoDestination;
+    params.detune = oscillatorDetune;
+    params.filterCutoff = filterCutoff;
+    params.filterResonance = filterResonance;
+    params.filterDrive = filterDrive;
+    params.filterEnvelopeAmount = filterEnvelopeAmount;
+    params.filterEnvelopeAttack = filterEnvelopeAttack;
+    params.filterEnvelopeDecay = filterEnvelopeDecay;
+    params.attack = envelope.attack;
+    params.decay = envelope.decay;
+    params.sustain = envelope.sustain;
+    params.release = envelope.release;
+    params.lfoRate = lfoRate;
+    params.lfoDepth = lfoDepth;
+    params.volume = volume;
+    params.pan = pan;
+    return params;
 }
 
 float SubtractiveSynthesizer::generateSample(const Voice& voice) {
     float sample = 0.0f;
-    float phase = voice.phase;
+    const float phase = voice.phase;
+    const float dt = voice.frequency / sampleRate;
 
     // Oszillator-Typ auswählen
     switch (oscillatorType) {
@@ -120,13 +187,13 @@ float SubtractiveSynthesizer::generateSample(const Voice& voice) {
             sample = generateSineWave(phase);
             break;
         case OscillatorType::Square:
-            sample = generateSquareWave(phase);
+            sample = generateSquareWave(phase, dt);
             break;
         case OscillatorType::Saw:
-            sample = generateSawWave(phase);
+            sample = generateSawWave(phase, dt);
             break;
         case OscillatorType::Triangle:
-            sample = generateTriangleWave(phase);
+            sample = generateTriangleWave(phase, dt);
             break;
         case OscillatorType::Noise:
             sample = generateNoise();
@@ -139,114 +206,24 @@ float SubtractiveSynthesizer::generateSample(const Voice& voice) {
     return sample;
 }
 
-void SubtractiveSynthesizer::updateEnvelope(Voice& voice) {
-    Synthesizer::updateEnvelope(voice);
-    updateFilterEnvelope();
-}
-
-void SubtractiveSynthesizer::applyFilter(float& sample) {
-    // Filter-Typ auswählen
-    if (filterType == "lowpass") {
-        // Tiefpassfilter
-        float cutoff = filterCutoff * (1.0f + filterEnvelope * filterEnvelopeAmount);
-        float resonance = filterResonance;
-        float drive = filterDrive;
-
-        // Moog-ähnlicher Tiefpassfilter
-        float input = sample * drive;
-        float feedback = filterState[3] * resonance;
-
-        filterState[0] = input - feedback;
-        filterState[0] = std::tanh(filterState[0]);
-        filterState[1] = filterState[0] + filterState[1];
-        filterState[1] = std::tanh(filterState[1]);
-        filterState[2] = filterState[1] + filterState[2];
-        filterState[2] = std::tanh(filterState[2]);
-        filterState[3] = filterState[2] + filterState[3];
-        filterState[3] = std::tanh(filterState[3]);
-
-        sample = filterState[3];
-    } else if (filterType == "highpass") {
-        // Hochpassfilter
-        float cutoff = filterCutoff * (1.0f + filterEnvelope * filterEnvelopeAmount);
-        float resonance = filterResonance;
-
-        float input = sample;
-        float feedback = filterState[3] * resonance;
-
-        filterState[0] = input - feedback;
-        filterState[1] = filterState[0] - filterState[1];
-        filterState[2] = filterState[1] - filterState[2];
-        filterState[3] = filterState[2] - filterState[3];
-
-        sample = filterState[3];
-    }
-}
-
-void SubtractiveSynthesizer::applyLFO(float& sample) {
-    float lfoValue = generateLFO(0.0f); // Phase wird intern verwaltet
-
-    if (lfoDestination == "filter") {
-        filterCutoff *= (1.0f + lfoValue * lfoDepth);
-    } else if (lfoDestination == "amplitude") {
-        sample *= (1.0f + lfoValue * lfoDepth);
-    } else if (lfoDestination == "pitch") {
-        sample *= std::pow(2.0f, lfoValue * lfoDepth);
-    }
-}
-
 float SubtractiveSynthesizer::generateSineWave(float phase) {
-    return std::sin(2.0f * M_PI * phase);
+    return OscillatorTables::get().lookupSine(phase);
 }
 
-float SubtractiveSynthesizer::generateSquareWave(float phase) {
-    return phase < 0.5f ? 1.0f : -1.0f;
+float SubtractiveSynthesizer::generateSquareWave(float phase, float dt) {
+    return osc::blepSquare(phase, dt);
 }
 
-float SubtractiveSynthesizer::generateSawWave(float phase) {
-    return 2.0f * phase - 1.0f;
+float SubtractiveSynthesizer::generateSawWave(float phase, float dt) {
+    return osc::blepSaw(phase, dt);
 }
 
-float SubtractiveSynthesizer::generateTriangleWave(float phase) {
-    if (phase < 0.5f) {
-        return 4.0f * phase - 1.0f;
-    } else {
-        return 3.0f - 4.0f * phase;
-    }
+float SubtractiveSynthesizer::generateTriangleWave(float phase, float dt) {
+    return osc::blampTriangle(phase, dt);
 }
 
 float SubtractiveSynthesizer::generateNoise() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
-    return dist(gen);
-}
-
-float SubtractiveSynthesizer::generateLFO(float phase) {
-    if (lfoWaveform == "sine") {
-        return std::sin(2.0f * M_PI * phase);
-    } else if (lfoWaveform == "square") {
-        return phase < 0.5f ? 1.0f : -1.0f;
-    } else if (lfoWaveform == "saw") {
-        return 2.0f * phase - 1.0f;
-    } else if (lfoWaveform == "triangle") {
-        if (phase < 0.5f) {
-            return 4.0f * phase - 1.0f;
-        } else {
-            return 3.0f - 4.0f * phase;
-        }
-    }
-    return 0.0f;
-}
-
-void SubtractiveSynthesizer::updateFilterEnvelope() {
-    // Filter-Hüllkurve aktualisieren
-    if (filterEnvelope < 1.0f) {
-        filterEnvelope += filterEnvelopeAttack;
-    } else {
-        filterEnvelope -= filterEnvelopeDecay;
-    }
-    filterEnvelope = std::max(0.0f, std::min(1.0f, filterEnvelope));
+    return osc::xorshiftNoise(noiseState);
 }
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -1,30 +1,32 @@
 #pragma once
 
 #include "Synthesizer.hpp"
-#include <array>
+#include "VoiceLaneRenderer.hpp"
 
 namespace VR_DAW {
 
 class SubtractiveSynthesizer : public Synthesizer {
 public:
-    enum class OscillatorType {
-        Sine,
-        Square,
-        Saw,
-        Triangle,
-        Noise
-    };
+    using OscillatorType = VoiceOscillator;
+    using FilterType = VoiceFilterType;
 
     SubtractiveSynthesizer();
     ~SubtractiveSynthesizer() override;
 
+    void setMaxVoices(size_t maxVoices) override;
+    void setSampleRate(float rate) override;
+
     // Oszillator-Einstellungen
     void setOscillatorType(OscillatorType type);
+    void setOscillatorType(const std::string& type) override;
+    void setOscillatorMode(OscillatorMode mode);
+    void setOscillatorMode(const std::string& mode);
     void setOscillatorMix(float mix);
     void setOscillatorDetune(float detune);
     void setOscillatorPhase(float phase);
 
     // Filter-Einstellungen
+    void setFilterType(FilterType type);
     void setFilterType(const std::string& type);
     void setFilterDrive(float drive);
     void setFilterEnvelopeAmount(float amount);
@@ -32,48 +34,53 @@ public:
     void setFilterEnvelopeDecay(float decay);
 
     // LFO-Einstellungen
+    void setLFOWaveform(LFOWaveform waveform);
     void setLFOWaveform(const std::string& waveform);
+    void setLFODestination(LFODestination destination);
     void setLFODestination(const std::string& destination);
 
-    // Audio-Verarbeitung
-    void processBlock(float* output, size_t numSamples) override;
-
 protected:
+    void renderVoices(float* output, size_t numFrames) override;
+    void resetVoices() override;
+    void voiceStarted(size_t index, bool retriggered) override;
+    void voiceReleased(size_t index) override;
+    void voiceFrequencyChanged(size_t index) override;
+    bool isVoiceSounding(size_t index) const override;
+    float getVoiceLevel(size_t index) const override;
     float generateSample(const Voice& voice) override;
-    void updateEnvelope(Voice& voice) override;
-    void applyFilter(float& sample) override;
-    void applyLFO(float& sample) override;
 
 private:
     // Oszillator-Parameter
     OscillatorType oscillatorType;
+    OscillatorMode oscillatorMode;
     float oscillatorMix;
     float oscillatorDetune;
     float oscillatorPhase;
 
     // Filter-Parameter
-    std::string filterType;
+    FilterType filterType;
     float filterDrive;
     float filterEnvelopeAmount;
     float filterEnvelopeAttack;
     float filterEnvelopeDecay;
 
     // LFO-Parameter
-    std::string lfoWaveform;
-    std::string lfoDestination;
+    LFOWaveform lfoWaveform;
+    LFODestination lfoDestination;
+
+    // Stimmen-Zustand im SoA-Layout, gleiche Indizes wie voices
+    VoiceLaneRenderer renderer;
 
-    // Filter-Status
-    std::array<float, 4> filterState;
-    float filterEnvelope;
+    // Rauschgenerator für den skalaren Pfad, eigener Zustand pro Instanz
+    uint32_t noiseState;
 
-    // Hilfsfunktionen
+    // Hilfsfunktionen (skalar, Phaseninkrement dt für die Kantenkorrektur)
     float generateSineWave(float phase);
-    float generateSquareWave(float phase);
-    float generateSawWave(float phase);
-    float generateTriangleWave(float phase);
+    float generateSquareWave(float phase, float dt);
+    float generateSawWave(float phase, float dt);
+    float generateTriangleWave(float phase, float dt);
     float generateNoise();
-    float generateLFO(float phase);
-    void updateFilterEnvelope();
+    VoiceLaneRenderer::Parameters currentParameters() const;
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
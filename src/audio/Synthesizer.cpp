@@ -21,61 +21,115 @@ Synthesizer::Synthesizer()
     envelope.sustain = 0.7f;
     envelope.release = 0.2f;
 
-    // 16 Stimmen initialisieren
-    voices.resize(16);
-    for (auto& voice : voices) {
-        voice.frequency = 0.0f;
-        voice.velocity = 0.0f;
-        voice.phase = 0.0f;
-        voice.amplitude = 0.0f;
-        voice.active = false;
-        voice.note = 0;
-        voice.channel = 0;
-    }
+    voices.resize(kDefaultMaxVoices, Voice{});
+    voicePool.resize(kDefaultMaxVoices);
 }
 
 Synthesizer::~Synthesizer() {
 }
 
-void Synthesizer::noteOn(uint8_t note, uint8_t velocity, uint8_t channel) {
+void Synthesizer::setMaxVoices(size_t maxVoices) {
     std::lock_guard<std::mutex> lock(mutex);
+    voices.assign(std::max<size_t>(1, maxVoices), Voice{});
+    voicePool.resize(voices.size());
+    active = false;
+}
 
-    // Freie Stimme suchen
-    auto it = std::find_if(voices.begin(), voices.end(),
-        [](const Voice& v) { return !v.active; });
+size_t Synthesizer::getMaxVoices() const {
+    return voices.size();
+}
 
-    if (it != voices.end()) {
-        // MIDI-Note in Frequenz umrechnen
-        float frequency = 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+void Synthesizer::setVoiceStealPolicy(VoicePool::StealPolicy policy) {
+    voicePool.setStealPolicy(policy);
+}
 
-        it->frequency = frequency;
-        it->velocity = velocity / 127.0f;
-        it->phase = 0.0f;
-        it->amplitude = 0.0f;
-        it->active = true;
-        it->note = note;
-        it->channel = channel;
+void Synthesizer::setVoiceStealPolicy(const std::string& policy) {
+    setVoiceStealPolicy(parseStealPolicy(policy));
+}
 
-        active = true;
+VoicePool::StealPolicy Synthesizer::getVoiceStealPolicy() const {
+    return voicePool.getStealPolicy();
+}
+
+void Synthesizer::setSampleRate(float rate) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (rate > 0.0f) {
+        sampleRate = rate;
     }
 }
 
+void Synthesizer::noteOn(uint8_t note, uint8_t velocity, uint8_t channel) {
+    enqueueCommand(0x90 | (channel & 0x0F), note & 0x7F, velocity & 0x7F);
+}
+
 void Synthesizer::noteOff(uint8_t note, uint8_t velocity, uint8_t channel) {
-    std::lock_guard<std::mutex> lock(mutex);
+    enqueueCommand(0x80 | (channel & 0x0F), note & 0x7F, velocity & 0x7F);
+}
+
+void Synthesizer::enqueueCommand(uint8_t status, uint8_t data1, uint8_t data2) {
+    // Ist die Queue voll, wird verworfen und gezählt (wie bei MIDI-Eingängen)
+    std::lock_guard<std::mutex> lock(commandMutex);
+    commands.push({0, status, data1, data2});
+}
+
+void Synthesizer::applyCommands() {
+    TimedMIDIEvent command;
+    while (commands.pop(command)) {
+        handleMIDIEvent(command.status, command.data1, command.data2);
+    }
+}
+
+void Synthesizer::startVoice(uint8_t note, uint8_t velocity, uint8_t channel) {
+    // Erneuter Anschlag einer gehaltenen Note: die alte Stimme klingt aus,
+    // außer SameNote schlägt genau sie neu an
+    if (voicePool.getStealPolicy() != VoicePool::StealPolicy::SameNote) {
+        releaseVoice(note, channel);
+    }
 
-    // Stimme mit entsprechender Note finden
-    auto it = std::find_if(voices.begin(), voices.end(),
-        [note, channel](const Voice& v) {
-            return v.active && v.note == note && v.channel == channel;
-        });
+    const auto level = [](const void* context, size_t index) {
+        return static_cast<const Synthesizer*>(context)->getVoiceLevel(index);
+    };
+    const VoicePool::Allocation allocation = voicePool.allocate(note, channel, level, this);
+    if (allocation.index == VoicePool::kNone) {
+        return;
+    }
+
+    // MIDI-Note in Frequenz umrechnen
+    const float frequency = 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+
+    Voice& voice = voices[allocation.index];
+    voice.frequency = frequency;
+    voice.baseFrequency = frequency;
+    voice.velocity = velocity / 127.0f;
+    voice.phase = 0.0f;
+    voice.amplitude = 0.0f;
+    voice.active = true;
+    voice.note = note;
+    voice.channel = channel;
+    voiceStarted(static_cast<size_t>(allocation.index), allocation.stolen);
+
+    active = true;
+}
 
-    if (it != voices.end()) {
-        it->active = false;
+void Synthesizer::releaseVoice(uint8_t note, uint8_t channel) {
+    // Direkter Zugriff über die Notentabelle statt Suche
+    const int32_t index = voicePool.release(note, channel);
+    if (index != VoicePool::kNone) {
+        voices[index].active = false;
+        voiceReleased(static_cast<size_t>(index));
     }
+}
 
-    // Prüfen, ob noch aktive Stimmen vorhanden sind
-    active = std::any_of(voices.begin(), voices.end(),
-        [](const Voice& v) { return v.active; });
+void Synthesizer::reclaimVoices() {
+    int32_t index = voicePool.first(VoicePool::State::Released);
+    while (index != VoicePool::kNone) {
+        const int32_t next = voicePool.next(static_cast<size_t>(index));
+        if (!isVoiceSounding(static_cast<size_t>(index))) {
+            voicePool.free(static_cast<size_t>(index));
+        }
+        index = next;
+    }
+    active = voicePool.getHeldCount() + voicePool.getReleasedCount() > 0;
 }
 
 void Synthesizer::setController(uint8_t controller, uint8_t value, uint8_t channel) {
@@ -101,17 +155,24 @@ void Synthesizer::setController(uint8_t controller, uint8_t value, uint8_t chann
 }
 
 void Synthesizer::setPitchBend(float value, uint8_t channel) {
-    std::lock_guard<std::mutex> lock(mutex);
+    const long bend = std::lround(std::max(-1.0f, std::min(1.0f, value)) * 8192.0f) + 8192;
+    const uint16_t data = static_cast<uint16_t>(std::min(16383L, bend));
+    enqueueCommand(0xE0 | (channel & 0x0F), data & 0x7F, (data >> 7) & 0x7F);
+}
 
-    // Pitch Bend auf alle Stimmen des Kanals anwenden
-    for (auto& voice : voices) {
+void Synthesizer::applyPitchBend(float value, uint8_t channel) {
+    // Pitch Bend relativ zur Grundfrequenz, nicht kumulativ
+    const float ratio = std::pow(2.0f, value);
+    for (size_t i = 0; i < voices.size(); ++i) {
+        Voice& voice = voices[i];
         if (voice.active && voice.channel == channel) {
-            voice.frequency *= std::pow(2.0f, value);
+            voice.frequency = voice.baseFrequency * ratio;
+            voiceFrequencyChanged(i);
         }
     }
 }
 
-void Synthesizer::setModulation(float value, uint8_t channel) {
+void Synthesizer::setModulation(float value, uint8_t /*channel*/) {
     std::lock_guard<std::mutex> lock(mutex);
     lfoDepth = value;
 }
@@ -156,15 +217,82 @@ void Synthesizer::setLFODepth(float depth) {
     lfoDepth = std::max(0.0f, std::min(1.0f, depth));
 }
 
-void Synthesizer::reset() {
+void Synthesizer::processBlock(float* output, size_t numSamples) {
     std::lock_guard<std::mutex> lock(mutex);
-    
+    applyCommands();
+    renderVoices(output, numSamples / 2);
+    reclaimVoices();
+}
+
+void Synthesizer::renderBlock(float* output, size_t numFrames,
+                              const MIDIBlockEvents& events, uint32_t firstFrame) {
+    applyCommands();
+
+    // Block an den Event-Grenzen teilen: rendern bis zum Event, Event anwenden
+    size_t position = 0;
+    for (const auto& event : events) {
+        if (event.sampleOffset < firstFrame) continue;
+        const size_t offset = event.sampleOffset - firstFrame;
+        if (offset >= numFrames) break;
+
+        if (offset > position) {
+            renderVoices(output + position * 2, offset - position);
+            position = offset;
+        }
+        handleMIDIEvent(event.status, event.data1, event.data2);
+    }
+
+    if (position < numFrames) {
+        renderVoices(output + position * 2, numFrames - position);
+    }
+    reclaimVoices();
+}
+
+void Synthesizer::handleMIDIEvent(uint8_t status, uint8_t data1, uint8_t data2) {
+    const uint8_t channel = status & 0x0F;
+    switch (status & 0xF0) {
+        case 0x90:
+            // Note-On mit Velocity 0 ist ein Note-Off
+            if (data2 > 0) {
+                startVoice(data1, data2, channel);
+            } else {
+                releaseVoice(data1, channel);
+            }
+            break;
+        case 0x80:
+            releaseVoice(data1, channel);
+            break;
+        case 0xB0:
+            // Direkt setzen: setController würde den Mutex nehmen
+            switch (data1) {
+                case 1: lfoDepth = data2 / 127.0f; break;
+                case 7: volume = data2 / 127.0f; break;
+                case 10: pan = (data2 / 127.0f) * 2.0f - 1.0f; break;
+                case 71: filterCutoff = std::max(20.0f, data2 * 20.0f); break;
+                case 74: filterResonance = data2 / 127.0f; break;
+                case 120: resetVoices(); break; // All Sound Off
+            }
+            break;
+        case 0xE0:
+            applyPitchBend((((data2 << 7) | data1) - 8192) / 8192.0f, channel);
+            break;
+        default:
+            break;
+    }
+}
+
+void Synthesizer::reset() {
+    enqueueCommand(0xB0, 120, 0);
+}
+
+void Synthesizer::resetVoices() {
     for (auto& voice : voices) {
         voice.active = false;
         voice.amplitude = 0.0f;
         voice.phase = 0.0f;
     }
-    
+    voicePool.reset();
+
     active = false;
 }
 
@@ -173,8 +301,7 @@ bool Synthesizer::isActive() const {
 }
 
 size_t Synthesizer::getActiveVoiceCount() const {
-    return std::count_if(voices.begin(), voices.end(),
-        [](const Voice& v) { return v.active; });
+    return voicePool.getHeldCount();
 }
 
 float Synthesizer::getCurrentVolume() const {
@@ -7,6 +7,8 @@
 #include <mutex>
 #include <map>
 #include <functional>
+#include "../midi/MIDIEventQueue.hpp"
+#include "VoicePool.hpp"
 
 namespace VR_DAW {
 
@@ -14,6 +16,7 @@ class Synthesizer {
 public:
     struct Voice {
         float frequency;
+        float baseFrequency; // ohne Pitch Bend
         float velocity;
         float phase;
         float amplitude;
@@ -29,13 +32,29 @@ public:
         float release;
     };
 
+    static constexpr size_t kDefaultMaxVoices = 16;
+
     Synthesizer();
     virtual ~Synthesizer();
 
-    // Synthesizer-Steuerung
+    // Polyphonie und Samplerate; alloziert, daher nur im Kontroll-Thread und
+    // bevor die Instanz im Render-Snapshot veröffentlicht wird
+    virtual void setMaxVoices(size_t maxVoices);
+    size_t getMaxVoices() const;
+    virtual void setSampleRate(float rate);
+    // Verhalten, wenn alle Stimmen belegt sind; pro Instanz, atomar und
+    // daher auch nach der Veröffentlichung setzbar
+    void setVoiceStealPolicy(VoicePool::StealPolicy policy);
+    void setVoiceStealPolicy(const std::string& policy);
+    VoicePool::StealPolicy getVoiceStealPolicy() const;
+
+    // Synthesizer-Steuerung. noteOn/noteOff/setPitchBend/reset reihen nur
+    // in die Befehls-Queue ein; die Stimmen ändert erst der nächste
+    // renderBlock()/processBlock() am Blockanfang. Von jedem Nicht-Audio-Thread
     virtual void noteOn(uint8_t note, uint8_t velocity, uint8_t channel = 0);
     virtual void noteOff(uint8_t note, uint8_t velocity, uint8_t channel = 0);
     virtual void setController(uint8_t controller, uint8_t value, uint8_t channel = 0);
+    // value in [-1, 1] Oktaven, übertragen mit 14 Bit wie MIDI-Pitch-Bend
     virtual void setPitchBend(float value, uint8_t channel = 0);
     virtual void setModulation(float value, uint8_t channel = 0);
     virtual void setVolume(float volume);
@@ -49,10 +68,18 @@ public:
     virtual void setLFORate(float rate);
     virtual void setLFODepth(float depth);
 
-    // Audio-Verarbeitung
-    virtual void processBlock(float* output, size_t numSamples) = 0;
+    // Audio-Verarbeitung (interleavtes Stereo, numSamples = Frames * 2)
+    virtual void processBlock(float* output, size_t numSamples);
+    // Alle Stimmen sofort stumm (All Sound Off)
     virtual void reset();
 
+    // Audio-Thread: rendert numFrames Frames und teilt den Block an den
+    // Sample-Offsets der Events aus [firstFrame, firstFrame + numFrames).
+    // Ohne Lock; die Stimmen gehören dabei allein dem Audio-Thread.
+    void renderBlock(float* output, size_t numFrames,
+                     const MIDIBlockEvents& events, uint32_t firstFrame = 0);
+    void handleMIDIEvent(uint8_t status, uint8_t data1, uint8_t data2);
+
     // Status-Abfragen
     virtual bool isActive() const;
     virtual size_t getActiveVoiceCount() const;
@@ -62,6 +89,7 @@ public:
 protected:
     // Synthesizer-Komponenten
     std::vector<Voice> voices;
+    VoicePool voicePool; // gleiche Indizes wie voices
     Envelope envelope;
     std::string oscillatorType;
     float filterCutoff;
@@ -74,7 +102,31 @@ protected:
     std::atomic<bool> active;
     std::mutex mutex;
 
+    // Befehle anderer Threads an die Stimmen (SPSC: commandMutex macht aus
+    // mehreren Aufrufern einen Producer, Consumer ist der rendernde Thread)
+    MIDIEventQueue commands;
+    std::mutex commandMutex;
+
     // Hilfsfunktionen
+    virtual void renderVoices(float* output, size_t numFrames) = 0;
+    void enqueueCommand(uint8_t status, uint8_t data1, uint8_t data2);
+    // Rendernder Thread: Befehls-Queue leeren, vor dem ersten Sample des Blocks
+    void applyCommands();
+    // Rendernder Thread; Unterklassen setzen hier ihren Stimmen-Zustand zurück
+    virtual void resetVoices();
+    void startVoice(uint8_t note, uint8_t velocity, uint8_t channel);
+    void releaseVoice(uint8_t note, uint8_t channel);
+    void applyPitchBend(float value, uint8_t channel);
+    // Ausgeklungene Stimmen nach dem Rendern in die Freiliste zurückgeben
+    void reclaimVoices();
+    // Benachrichtigungen an den Renderer der Unterklasse (Index in voices);
+    // retriggered: die Stimme klang noch (gestohlen oder neu angeschlagen)
+    virtual void voiceStarted(size_t /*index*/, bool /*retriggered*/) {}
+    virtual void voiceReleased(size_t /*index*/) {}
+    virtual void voiceFrequencyChanged(size_t /*index*/) {}
+    // Klingt die Stimme noch (Release-Ausklang)? Pegel für StealPolicy::Quietest
+    virtual bool isVoiceSounding(size_t /*index*/) const { return false; }
+    virtual float getVoiceLevel(size_t index) const { return voices[index].amplitude; }
     virtual float generateSample(const Voice& voice) = 0;
     virtual void updateEnvelope(Voice& voice);
     virtual void applyFilter(float& sample);
@@ -13,6 +13,7 @@ struct SynthesizerConfig {
     float defaultPan;
     bool enableEffects;
     int maxVoices;
+    std::string voiceStealing;  // "oldest", "quietest", "same-note", "none"
 
     // Oszillator-Einstellungen
     struct OscillatorConfig {
@@ -69,7 +70,8 @@ struct SynthesizerConfig {
         defaultVolume(0.7f),
         defaultPan(0.0f),
         enableEffects(true),
-        maxVoices(16)
+        maxVoices(16),
+        voiceStealing("oldest")
     {
         // Standard-Oszillator
         OscillatorConfig osc;
@@ -18,25 +18,25 @@ SynthesizerController::~SynthesizerController() {
 
 void SynthesizerController::initializeParameterMapping() {
     // Oszillator-Parameter
-    parameterMapping["oscillator_type"] = "oscillator_type";
-    parameterMapping["oscillator_mix"] = "oscillator_mix";
-    parameterMapping["oscillator_detune"] = "oscillator_detune";
+    parameterMapping["oscillator_type"] = AudioTrack::kOscillatorType;
+    parameterMapping["oscillator_mix"] = AudioTrack::kOscillatorMix;
+    parameterMapping["oscillator_detune"] = AudioTrack::kOscillatorDetune;
 
     // Filter-Parameter
-    parameterMapping["filter_type"] = "filter_type";
-    parameterMapping["filter_cutoff"] = "filter_cutoff";
-    parameterMapping["filter_resonance"] = "filter_resonance";
+    parameterMapping["filter_type"] = AudioTrack::kFilterType;
+    parameterMapping["filter_cutoff"] = AudioTrack::kFilterCutoff;
+    parameterMapping["filter_resonance"] = AudioTrack::kFilterResonance;
 
     // Envelope-Parameter
-    parameterMapping["envelope_attack"] = "envelope_attack";
-    parameterMapping["envelope_decay"] = "envelope_decay";
-    parameterMapping["envelope_sustain"] = "envelope_sustain";
-    parameterMapping["envelope_release"] = "envelope_release";
+    parameterMapping["envelope_attack"] = AudioTrack::kEnvelopeAttack;
+    parameterMapping["envelope_decay"] = AudioTrack::kEnvelopeDecay;
+    parameterMapping["envelope_sustain"] = AudioTrack::kEnvelopeSustain;
+    parameterMapping["envelope_release"] = AudioTrack::kEnvelopeRelease;
 
     // LFO-Parameter
-    parameterMapping["lfo_rate"] = "lfo_rate";
-    parameterMapping["lfo_depth"] = "lfo_depth";
-    parameterMapping["lfo_waveform"] = "lfo_waveform";
+    parameterMapping["lfo_rate"] = AudioTrack::kLfoRate;
+    parameterMapping["lfo_depth"] = AudioTrack::kLfoDepth;
+    parameterMapping["lfo_waveform"] = AudioTrack::kLfoWaveform;
 }
 
 void SynthesizerController::createUI() {
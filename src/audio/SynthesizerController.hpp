@@ -22,7 +22,8 @@ private:
     std::shared_ptr<AudioTrack> track;
     VRUI* ui;
     VRUI::SynthesizerView* view;
-    std::map<std::string, std::string> parameterMapping;
+    // UI-Name -> Parameter-ID der Spur, einmal beim Erzeugen aufgelöst
+    std::map<std::string, ParameterId> parameterMapping;
 
     void initializeParameterMapping();
     void updateParameter(const std::string& paramId, float value);
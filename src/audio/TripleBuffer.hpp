@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace VR_DAW {
+
+// Lock-freier Dreifachpuffer für genau einen Schreiber und einen Leser.
+// Der Schreiber füllt seinen Puffer und veröffentlicht ihn mit publish();
+// der Leser holt mit read() immer den neuesten veröffentlichten Stand.
+// Keiner wartet auf den anderen, Zwischenstände dürfen verloren gehen.
+//
+// Nach publish() gehört dem Schreiber ein älterer Puffer; wer inkrementell
+// ändert, hält den vollständigen Stand selbst und kopiert ihn vor publish()
+// nach write()
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) : buffers{initial, initial, initial} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Schreiber
+    T& write() { return buffers[back]; }
+
+    void publish() {
+        back = middle.exchange(static_cast<uint8_t>(back | kFresh), std::memory_order_acq_rel) & kIndex;
+    }
+
+    // Leser
+    const T& read() {
+        if (middle.load(std::memory_order_relaxed) & kFresh) {
+            front = middle.exchange(front, std::memory_order_acq_rel) & kIndex;
+        }
+        return buffers[front];
+    }
+
+    // Nur für Initialisierung, wenn kein anderer Thread zugreift
+    void reset(const T& value) {
+        for (T& buffer : buffers) buffer = value;
+        back = 0;
+        middle.store(1, std::memory_order_relaxed);
+        front = 2;
+    }
+
+private:
+    static constexpr uint8_t kIndex = 0x3;
+    static constexpr uint8_t kFresh = 0x4;
+
+    T buffers[3];
+    uint8_t back = 0;
+    alignas(64) std::atomic<uint8_t> middle{1};
+    alignas(64) uint8_t front = 2;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,569 @@
+#include "VoiceLaneRenderer.hpp"
+#include "OscillatorTables.hpp"
+#include "../dsp/kernels/DSPKernels.hpp"
+#include "../dsp/kernels/Lanes.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Lanes werden nur zwischen geinlineten Funktionen übergeben
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VRDAW_VOICE_LANES_AVX2 1
+#endif
+
+namespace VR_DAW {
+
+using dsp::Lanes;
+using dsp::LaneBits;
+using dsp::LaneMask;
+using dsp::kLaneWidth;
+
+VoiceFilterType parseVoiceFilterType(const std::string& name) {
+    if (name == "lowpass") return VoiceFilterType::Lowpass;
+    if (name == "highpass") return VoiceFilterType::Highpass;
+    return VoiceFilterType::Bypass;
+}
+
+LFOWaveform parseLFOWaveform(const std::string& name) {
+    if (name == "square") return LFOWaveform::Square;
+    if (name == "saw") return LFOWaveform::Saw;
+    if (name == "triangle") return LFOWaveform::Triangle;
+    return LFOWaveform::Sine;
+}
+
+LFODestination parseLFODestination(const std::string& name) {
+    if (name == "filter") return LFODestination::Filter;
+    if (name == "amplitude") return LFODestination::Amplitude;
+    if (name == "pitch") return LFODestination::Pitch;
+    return LFODestination::None;
+}
+
+VoiceOscillator parseVoiceOscillator(const std::string& name) {
+    if (name == "square") return VoiceOscillator::Square;
+    if (name == "saw") return VoiceOscillator::Saw;
+    if (name == "triangle") return VoiceOscillator::Triangle;
+    if (name == "noise") return VoiceOscillator::Noise;
+    return VoiceOscillator::Sine;
+}
+
+OscillatorMode parseOscillatorMode(const std::string& name) {
+    return name == "wavetable" ? OscillatorMode::Wavetable : OscillatorMode::PolyBLEP;
+}
+
+namespace {
+
+// Hüllkurven-Stufen als Float-Lanes, damit sie direkt vergleichbar sind
+constexpr float kStageAttack = 0.0f;
+constexpr float kStageDecay = 1.0f;
+constexpr float kStageRelease = 2.0f;
+constexpr float kStageIdle = 3.0f;
+
+// Ab hier gilt eine Stimme im Release als verklungen (-80 dB)
+constexpr float kSilenceThreshold = 1e-4f;
+constexpr float kLogSilence = -9.2103404f; // ln(1e-4)
+
+constexpr float kTwoPi = 6.28318530718f;
+
+// Acht Stimmen, Feld für Feld nebeneinander (AoSoA)
+struct LaneGroup {
+    Lanes phase;
+    Lanes frequency;
+    Lanes velocity;
+    Lanes amplitude;
+    Lanes stage;
+    Lanes z0, z1, z2, z3;
+    Lanes filterEnvelope;
+    Lanes filterStage;
+    LaneBits noise;
+};
+
+// Pro Teilblock konstante Werte, gemeinsam für alle Gruppen
+struct ControlState {
+    const OscillatorTables* tables;
+    float incrementScale;   // Frequenz -> Phaseninkrement inkl. Detune/Pitch-LFO
+    float cutoffScale;      // 2π/sr * Cutoff * Filter-LFO
+    float filterEnvAmount;
+    float filterEnvStep;
+    float filterEnvDecay;
+    float drive;
+    float feedback;
+    float attackStep;
+    float decayCoefficient;
+    float sustain;
+    float releaseCoefficient;
+};
+
+// Oszillator-Varianten nach Auflösung von Wellenform und Modus
+enum class OscKernel {
+    Sine,
+    BlepSaw,
+    BlepSquare,
+    BlampTriangle,
+    TableSaw,
+    TableSquare,
+    TableTriangle,
+    Noise
+};
+
+constexpr float kTableScale = static_cast<float>(OscillatorTables::kTableSize);
+
+// Linear interpolierter Tabellenzugriff, eine Zeile (Mip-Stufe) pro Lane
+VRDAW_LANES_INLINE Lanes lookupLanes(const float* const* rows, const Lanes& phase) {
+    const Lanes position = phase * kTableScale;
+    Lanes result;
+    for (size_t lane = 0; lane < kLaneWidth; ++lane) {
+        const size_t index = static_cast<size_t>(position[lane]) & OscillatorTables::kTableMask;
+        const float frac = position[lane] - static_cast<float>(index);
+        const float* row = rows[lane];
+        result[lane] = row[index] + frac * (row[index + 1] - row[index]);
+    }
+    return result;
+}
+
+VRDAW_LANES_INLINE Lanes lookupLanes(const float* table, const Lanes& phase) {
+    const Lanes position = phase * kTableScale;
+    Lanes result;
+    for (size_t lane = 0; lane < kLaneWidth; ++lane) {
+        const size_t index = static_cast<size_t>(position[lane]) & OscillatorTables::kTableMask;
+        const float frac = position[lane] - static_cast<float>(index);
+        result[lane] = table[index] + frac * (table[index + 1] - table[index]);
+    }
+    return result;
+}
+
+// Lane-Versionen von osc::polyBlep / osc::polyBlamp (invDt = 1 / dt)
+VRDAW_LANES_INLINE Lanes polyBlepLanes(const Lanes& t, const Lanes& dt, const Lanes& invDt) {
+    const Lanes a = t * invDt;
+    const Lanes b = (t - 1.0f) * invDt;
+    const Lanes head = a + a - a * a - 1.0f;
+    const Lanes tail = b * b + b + b + 1.0f;
+    return dsp::select(t < dt, head, dsp::select(t > 1.0f - dt, tail, Lanes{}));
+}
+
+VRDAW_LANES_INLINE Lanes polyBlampLanes(const Lanes& t, const Lanes& dt, const Lanes& invDt) {
+    const Lanes a = t * invDt - 1.0f;
+    const Lanes b = (t - 1.0f) * invDt + 1.0f;
+    const Lanes head = a * a * a * (-1.0f / 3.0f);
+    const Lanes tail = b * b * b * (1.0f / 3.0f);
+    return dsp::select(t < dt, head, dsp::select(t > 1.0f - dt, tail, Lanes{}));
+}
+
+VRDAW_LANES_INLINE Lanes noiseLanes(LaneBits& state) {
+    // xorshift32 je Lane
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return __builtin_convertvector((LaneMask)state, Lanes) * (1.0f / 2147483648.0f);
+}
+
+struct OscillatorState {
+    Lanes increment;
+    Lanes invIncrement;
+    const float* rows[kLaneWidth];
+    const float* sine;
+};
+
+template<OscKernel Osc>
+VRDAW_LANES_INLINE Lanes oscillate(const Lanes& phase, const OscillatorState& osc, LaneBits& noise) {
+    switch (Osc) {
+        case OscKernel::Sine:
+            return lookupLanes(osc.sine, phase);
+        case OscKernel::BlepSaw:
+            return 2.0f * phase - 1.0f - polyBlepLanes(phase, osc.increment, osc.invIncrement);
+        case OscKernel::BlepSquare: {
+            const Lanes shifted = dsp::wrapPhase(phase + 0.5f);
+            return dsp::select(phase < 0.5f, dsp::splat(1.0f), dsp::splat(-1.0f))
+                 + polyBlepLanes(phase, osc.increment, osc.invIncrement)
+                 - polyBlepLanes(shifted, osc.increment, osc.invIncrement);
+        }
+        case OscKernel::BlampTriangle: {
+            const Lanes shifted = dsp::wrapPhase(phase + 0.5f);
+            const Lanes naive = dsp::select(phase < 0.5f, 4.0f * phase - 1.0f, 3.0f - 4.0f * phase);
+            return naive + 8.0f * osc.increment * (polyBlampLanes(phase, osc.increment, osc.invIncrement)
+                                                   - polyBlampLanes(shifted, osc.increment, osc.invIncrement));
+        }
+        case OscKernel::TableSaw:
+        case OscKernel::TableSquare:
+        case OscKernel::TableTriangle:
+            return lookupLanes(osc.rows, phase);
+        case OscKernel::Noise:
+            return noiseLanes(noise);
+    }
+    return Lanes{};
+}
+
+constexpr bool usesMipTable(OscKernel osc) {
+    return osc == OscKernel::TableSaw || osc == OscKernel::TableSquare || osc == OscKernel::TableTriangle;
+}
+
+constexpr OscillatorTables::Waveform tableWaveform(OscKernel osc) {
+    return osc == OscKernel::TableSquare ? OscillatorTables::Waveform::Square
+         : osc == OscKernel::TableTriangle ? OscillatorTables::Waveform::Triangle
+         : OscillatorTables::Waveform::Saw;
+}
+
+template<OscKernel Osc, VoiceFilterType Filter>
+VRDAW_LANES_INLINE void renderGroup(LaneGroup& group, Lanes* mix, size_t numFrames,
+                                    const ControlState& control) {
+    // Kontrollrate: Filter-Hüllkurve und Koeffizienten einmal pro Teilblock
+    Lanes filterEnv = group.filterEnvelope;
+    const LaneMask rising = group.filterStage == kStageAttack;
+    const Lanes risen = dsp::minLanes(filterEnv + control.filterEnvStep, dsp::splat(1.0f));
+    filterEnv = dsp::select(rising, risen, filterEnv * control.filterEnvDecay);
+    group.filterStage = dsp::select(rising & (risen >= 1.0f), dsp::splat(kStageDecay), group.filterStage);
+    group.filterEnvelope = filterEnv;
+
+    // g = w / (1 + w): stabile Näherung von 1 - e^-w, ohne exp pro Lane
+    const Lanes w = dsp::minLanes(control.cutoffScale * (1.0f + filterEnv * control.filterEnvAmount),
+                                  dsp::splat(kTwoPi * 0.45f));
+    const Lanes g = w / (1.0f + w);
+    OscillatorState osc;
+    osc.increment = group.frequency * control.incrementScale;
+    osc.invIncrement = 1.0f / dsp::maxLanes(osc.increment, dsp::splat(1e-9f));
+    osc.sine = control.tables->sine();
+    if (usesMipTable(Osc)) {
+        // Mip-Stufe pro Lane nach Tonhöhe, damit keine Harmonische über Nyquist liegt
+        for (size_t lane = 0; lane < kLaneWidth; ++lane) {
+            const size_t level = OscillatorTables::levelForIncrement(osc.increment[lane]);
+            osc.rows[lane] = control.tables->table(tableWaveform(Osc), level);
+        }
+    }
+
+    const Lanes velocity = group.velocity;
+    const Lanes attackStep = velocity * control.attackStep;
+    const Lanes sustainLevel = velocity * control.sustain;
+
+    Lanes phase = group.phase;
+    Lanes amplitude = group.amplitude;
+    Lanes stage = group.stage;
+    Lanes z0 = group.z0, z1 = group.z1, z2 = group.z2, z3 = group.z3;
+    LaneBits noise = group.noise;
+
+    for (size_t i = 0; i < numFrames; ++i) {
+        Lanes sample = oscillate<Osc>(phase, osc, noise);
+        phase = dsp::wrapPhase(phase + osc.increment);
+
+        if (Filter != VoiceFilterType::Bypass) {
+            // Ladder: eine Sättigung am Eingang, vier lineare Pole
+            const Lanes x = dsp::fastTanh(sample * control.drive - control.feedback * z3);
+            z0 += g * (x - z0);
+            z1 += g * (z0 - z1);
+            z2 += g * (z1 - z2);
+            z3 += g * (z2 - z3);
+            if (Filter == VoiceFilterType::Lowpass) {
+                sample = z3;
+            } else {
+                // Binomiale Mischung der Stufen ergibt den 4-Pol-Hochpass
+                sample = x - 4.0f * z0 + 6.0f * z1 - 4.0f * z2 + z3;
+            }
+        }
+
+        // ADSR: alle Stufen rechnen, per Maske auswählen
+        const LaneMask inAttack = stage == kStageAttack;
+        const LaneMask inDecay = stage == kStageDecay;
+        const Lanes attacked = amplitude + attackStep;
+        const Lanes decayed = amplitude + (sustainLevel - amplitude) * control.decayCoefficient;
+        const Lanes released = amplitude * control.releaseCoefficient;
+        amplitude = dsp::select(inAttack, dsp::minLanes(attacked, velocity),
+                                dsp::select(inDecay, decayed, released));
+        stage = dsp::select(inAttack & (attacked >= velocity), dsp::splat(kStageDecay), stage);
+
+        mix[i] += sample * amplitude;
+    }
+
+    // Verklungene Release-Stimmen stilllegen
+    const LaneMask silent = (stage == kStageRelease) & (amplitude < kSilenceThreshold);
+    group.stage = dsp::select(silent, dsp::splat(kStageIdle), stage);
+    group.amplitude = dsp::select(silent, Lanes{}, amplitude);
+    group.phase = phase;
+    group.z0 = z0; group.z1 = z1; group.z2 = z2; group.z3 = z3;
+    group.noise = noise;
+}
+
+template<OscKernel Osc>
+VRDAW_LANES_INLINE void renderGroupFiltered(VoiceFilterType filter, LaneGroup& group, Lanes* mix,
+                                            size_t numFrames, const ControlState& control) {
+    switch (filter) {
+        case VoiceFilterType::Lowpass:
+            renderGroup<Osc, VoiceFilterType::Lowpass>(group, mix, numFrames, control);
+            break;
+        case VoiceFilterType::Highpass:
+            renderGroup<Osc, VoiceFilterType::Highpass>(group, mix, numFrames, control);
+            break;
+        case VoiceFilterType::Bypass:
+            renderGroup<Osc, VoiceFilterType::Bypass>(group, mix, numFrames, control);
+            break;
+    }
+}
+
+OscKernel resolveKernel(VoiceOscillator oscillator, OscillatorMode mode) {
+    const bool table = mode == OscillatorMode::Wavetable;
+    switch (oscillator) {
+        case VoiceOscillator::Sine: return OscKernel::Sine;
+        case VoiceOscillator::Saw: return table ? OscKernel::TableSaw : OscKernel::BlepSaw;
+        case VoiceOscillator::Square: return table ? OscKernel::TableSquare : OscKernel::BlepSquare;
+        case VoiceOscillator::Triangle: return table ? OscKernel::TableTriangle : OscKernel::BlampTriangle;
+        case VoiceOscillator::Noise: return OscKernel::Noise;
+    }
+    return OscKernel::Sine;
+}
+
+float lfoValue(LFOWaveform waveform, float phase) {
+    switch (waveform) {
+        case LFOWaveform::Sine:
+            return OscillatorTables::get().lookupSine(phase);
+        case LFOWaveform::Square:
+            return phase < 0.5f ? 1.0f : -1.0f;
+        case LFOWaveform::Saw:
+            return 2.0f * phase - 1.0f;
+        case LFOWaveform::Triangle:
+            return phase < 0.5f ? 4.0f * phase - 1.0f : 3.0f - 4.0f * phase;
+    }
+    return 0.0f;
+}
+
+} // namespace
+
+struct VoiceLaneRenderer::Impl {
+    std::vector<LaneGroup> groups;
+    std::vector<uint8_t> groupSounding;
+    Lanes mix[kSubBlock];
+    size_t maxVoices = 0;
+    float sampleRate = 44100.0f;
+    float lfoPhase = 0.0f;
+    float lastAmplitudeGain = 1.0f;
+    bool useAVX2 = false;
+    // Gemeinsame, nur lesend genutzte Tabellen aller Instanzen
+    const OscillatorTables* tables = &OscillatorTables::get();
+
+    void allocate(size_t voiceCount) {
+        maxVoices = voiceCount;
+        const size_t groupCount = (voiceCount + kLaneWidth - 1) / kLaneWidth;
+        groups.assign(groupCount, LaneGroup{});
+        groupSounding.assign(groupCount, 0);
+        for (size_t g = 0; g < groupCount; ++g) {
+            for (size_t lane = 0; lane < kLaneWidth; ++lane) {
+                groups[g].stage[lane] = kStageIdle;
+                // Unterschiedliche, nie nullwertige Seeds je Stimme
+                groups[g].noise[lane] = 0x9E3779B9u * static_cast<uint32_t>(g * kLaneWidth + lane + 1);
+            }
+        }
+    }
+
+    void renderBlock(float* output, size_t numFrames, const Parameters& params);
+
+    // Derselbe Code zweimal übersetzt; AVX2 nur, wenn CPUID es meldet
+    void renderPortable(float* output, size_t numFrames, const Parameters& params);
+#ifdef VRDAW_VOICE_LANES_AVX2
+    __attribute__((target("avx2,fma")))
+    void renderAVX2(float* output, size_t numFrames, const Parameters& params);
+#endif
+};
+
+namespace {
+
+bool anySounding(const Lanes& stage) {
+    for (size_t lane = 0; lane < kLaneWidth; ++lane) {
+        if (stage[lane] != kStageIdle) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+VRDAW_LANES_INLINE void VoiceLaneRenderer::Impl::renderBlock(float* output, size_t numFrames,
+                                                             const Parameters& params) {
+    Impl& impl = *this;
+    const size_t subBlock = VoiceLaneRenderer::kSubBlock;
+
+    // Block-konstante Werte einmal auflösen
+    ControlState control;
+    control.tables = impl.tables;
+    control.filterEnvAmount = params.filterEnvelopeAmount;
+    control.filterEnvStep = subBlock / (std::max(0.001f, params.filterEnvelopeAttack) * sampleRate);
+    control.filterEnvDecay = std::exp(kLogSilence * subBlock /
+                                      (std::max(0.001f, params.filterEnvelopeDecay) * sampleRate));
+    control.drive = params.filterDrive;
+    control.feedback = 3.6f * params.filterResonance;
+    control.attackStep = 1.0f / (std::max(0.0005f, params.attack) * sampleRate);
+    control.decayCoefficient = 1.0f - std::exp(-5.0f / (std::max(0.001f, params.decay) * sampleRate));
+    control.sustain = params.sustain;
+    // Release erreicht die Stilleschwelle genau nach params.release Sekunden
+    control.releaseCoefficient = std::exp(kLogSilence / (std::max(0.001f, params.release) * sampleRate));
+
+    const OscKernel kernel = resolveKernel(params.oscillator, params.oscillatorMode);
+    const float detuneRatio = std::exp2(params.detune / 12.0f);
+    const float lfoIncrement = params.lfoRate / sampleRate;
+
+    // Balance-Pan wie im AudioTrack, einmal pro Block
+    const float leftGain = params.volume * (1.0f - std::max(0.0f, params.pan));
+    const float rightGain = params.volume * (1.0f + std::min(0.0f, params.pan));
+
+    Lanes* mix = impl.mix;
+    const size_t groupCount = impl.groups.size();
+
+    for (size_t offset = 0; offset < numFrames; offset += subBlock) {
+        const size_t frames = std::min(subBlock, numFrames - offset);
+
+        const float lfo = lfoValue(params.lfoWaveform, impl.lfoPhase) * params.lfoDepth;
+        impl.lfoPhase += lfoIncrement * frames;
+        impl.lfoPhase -= std::floor(impl.lfoPhase);
+
+        const float pitchScale = params.lfoDestination == LFODestination::Pitch ? std::exp2(lfo) : 1.0f;
+        const float cutoffScale = params.lfoDestination == LFODestination::Filter ? 1.0f + lfo : 1.0f;
+        const float amplitudeGain = params.lfoDestination == LFODestination::Amplitude ? 1.0f + lfo : 1.0f;
+        control.incrementScale = detuneRatio * pitchScale / sampleRate;
+        control.cutoffScale = kTwoPi * params.filterCutoff * cutoffScale / sampleRate;
+
+        for (size_t i = 0; i < frames; ++i) mix[i] = Lanes{};
+
+        for (size_t g = 0; g < groupCount; ++g) {
+            if (!impl.groupSounding[g]) continue;
+            LaneGroup& group = impl.groups[g];
+            switch (kernel) {
+#define VRDAW_RENDER_KERNEL(K) \
+                case OscKernel::K: \
+                    renderGroupFiltered<OscKernel::K>(params.filterType, group, mix, frames, control); \
+                    break;
+                VRDAW_RENDER_KERNEL(Sine)
+                VRDAW_RENDER_KERNEL(BlepSaw)
+                VRDAW_RENDER_KERNEL(BlepSquare)
+                VRDAW_RENDER_KERNEL(BlampTriangle)
+                VRDAW_RENDER_KERNEL(TableSaw)
+                VRDAW_RENDER_KERNEL(TableSquare)
+                VRDAW_RENDER_KERNEL(TableTriangle)
+                VRDAW_RENDER_KERNEL(Noise)
+#undef VRDAW_RENDER_KERNEL
+            }
+        }
+
+        // Eine horizontale Summe pro Sample statt einer pro Stimme und Sample;
+        // der Amplituden-LFO wird über den Teilblock interpoliert
+        const float gainStep = (amplitudeGain - impl.lastAmplitudeGain) / frames;
+        float gain = impl.lastAmplitudeGain;
+        float* out = output + offset * 2;
+        for (size_t i = 0; i < frames; ++i) {
+            gain += gainStep;
+            const float sample = dsp::horizontalSum(mix[i]) * gain;
+            out[i * 2] = sample * leftGain;
+            out[i * 2 + 1] = sample * rightGain;
+        }
+        impl.lastAmplitudeGain = amplitudeGain;
+    }
+
+    for (size_t g = 0; g < groupCount; ++g) {
+        if (!impl.groupSounding[g]) continue;
+        impl.groupSounding[g] = anySounding(impl.groups[g].stage);
+    }
+}
+
+void VoiceLaneRenderer::Impl::renderPortable(float* output, size_t numFrames, const Parameters& params) {
+    renderBlock(output, numFrames, params);
+}
+
+#ifdef VRDAW_VOICE_LANES_AVX2
+void VoiceLaneRenderer::Impl::renderAVX2(float* output, size_t numFrames, const Parameters& params) {
+    renderBlock(output, numFrames, params);
+}
+#endif
+
+VoiceLaneRenderer::VoiceLaneRenderer(size_t maxVoices)
+    : pImpl(std::make_unique<Impl>())
+{
+    pImpl->allocate(std::max<size_t>(1, maxVoices));
+#ifdef VRDAW_VOICE_LANES_AVX2
+    pImpl->useAVX2 = dsp::getKernels().variant >= dsp::KernelVariant::AVX2;
+#endif
+}
+
+VoiceLaneRenderer::~VoiceLaneRenderer() = default;
+
+void VoiceLaneRenderer::setMaxVoices(size_t maxVoices) {
+    pImpl->allocate(std::max<size_t>(1, maxVoices));
+}
+
+size_t VoiceLaneRenderer::getMaxVoices() const {
+    return pImpl->maxVoices;
+}
+
+void VoiceLaneRenderer::setSampleRate(float sampleRate) {
+    pImpl->sampleRate = std::max(1.0f, sampleRate);
+}
+
+void VoiceLaneRenderer::startVoice(size_t index, float frequency, float velocity, float startPhase,
+                                   bool retrigger) {
+    if (index >= pImpl->maxVoices) return;
+    LaneGroup& group = pImpl->groups[index / kLaneWidth];
+    const size_t lane = index % kLaneWidth;
+
+    group.frequency[lane] = frequency;
+    group.velocity[lane] = velocity;
+    group.stage[lane] = kStageAttack;
+    group.filterEnvelope[lane] = 0.0f;
+    group.filterStage[lane] = kStageAttack;
+    pImpl->groupSounding[index / kLaneWidth] = 1;
+    if (retrigger && group.amplitude[lane] > 0.0f) {
+        return;
+    }
+
+    group.phase[lane] = startPhase - std::floor(startPhase);
+    group.amplitude[lane] = 0.0f;
+    group.z0[lane] = 0.0f;
+    group.z1[lane] = 0.0f;
+    group.z2[lane] = 0.0f;
+    group.z3[lane] = 0.0f;
+}
+
+void VoiceLaneRenderer::setGate(size_t index, bool gate) {
+    if (gate || index >= pImpl->maxVoices) return;
+    LaneGroup& group = pImpl->groups[index / kLaneWidth];
+    const size_t lane = index % kLaneWidth;
+    if (group.stage[lane] < kStageRelease) {
+        group.stage[lane] = kStageRelease;
+    }
+}
+
+void VoiceLaneRenderer::setFrequency(size_t index, float frequency) {
+    if (index >= pImpl->maxVoices) return;
+    pImpl->groups[index / kLaneWidth].frequency[index % kLaneWidth] = frequency;
+}
+
+void VoiceLaneRenderer::reset() {
+    pImpl->allocate(pImpl->maxVoices);
+    pImpl->lfoPhase = 0.0f;
+    pImpl->lastAmplitudeGain = 1.0f;
+}
+
+void VoiceLaneRenderer::render(float* output, size_t numFrames, const Parameters& params) {
+#ifdef VRDAW_VOICE_LANES_AVX2
+    if (pImpl->useAVX2) {
+        pImpl->renderAVX2(output, numFrames, params);
+        return;
+    }
+#endif
+    pImpl->renderPortable(output, numFrames, params);
+}
+
+bool VoiceLaneRenderer::isSounding(size_t index) const {
+    if (index >= pImpl->maxVoices) return false;
+    return pImpl->groups[index / kLaneWidth].stage[index % kLaneWidth] != kStageIdle;
+}
+
+float VoiceLaneRenderer::getLevel(size_t index) const {
+    if (index >= pImpl->maxVoices) return 0.0f;
+    return pImpl->groups[index / kLaneWidth].amplitude[index % kLaneWidth];
+}
+
+size_t VoiceLaneRenderer::getSoundingVoiceCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < pImpl->maxVoices; ++i) {
+        if (isSounding(i)) ++count;
+    }
+    return count;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace VR_DAW {
+
+// Parameter-Enums des Subtraktiv-Synthesizers. Strings werden nur an der
+// API-Grenze einmal aufgelöst, nie im Audio-Pfad verglichen.
+enum class VoiceOscillator : uint8_t {
+    Sine,
+    Square,
+    Saw,
+    Triangle,
+    Noise
+};
+
+// PolyBLEP/PolyBLAMP: analytisch korrigierte Kanten, günstig und ohne
+// Speicherzugriffe. Wavetable: bandbegrenzte Mip-Map-Tabellen, sauberer in
+// den Höhen. Sinus und Rauschen sind von der Wahl unabhängig.
+enum class OscillatorMode : uint8_t {
+    PolyBLEP,
+    Wavetable
+};
+
+enum class VoiceFilterType : uint8_t {
+    Lowpass,
+    Highpass,
+    Bypass
+};
+
+enum class LFOWaveform : uint8_t {
+    Sine,
+    Square,
+    Saw,
+    Triangle
+};
+
+enum class LFODestination : uint8_t {
+    Filter,
+    Amplitude,
+    Pitch,
+    None
+};
+
+VoiceFilterType parseVoiceFilterType(const std::string& name);
+LFOWaveform parseLFOWaveform(const std::string& name);
+LFODestination parseLFODestination(const std::string& name);
+VoiceOscillator parseVoiceOscillator(const std::string& name);
+OscillatorMode parseOscillatorMode(const std::string& name);
+
+// Rendert alle Stimmen eines Synthesizers blockweise im SoA-Layout:
+// je acht Stimmen liegen in den Lanes eines SIMD-Vektors und werden Sample
+// für Sample gemeinsam durch Oszillator, Ladder-Filter und Hüllkurve
+// geschoben. Stumme Achtergruppen werden übersprungen, Filter-Koeffizienten,
+// Filter-Hüllkurve und LFO laufen mit Kontrollrate (alle kSubBlock Frames).
+class VoiceLaneRenderer {
+public:
+    static constexpr size_t kSubBlock = 32;
+
+    struct Parameters {
+        VoiceOscillator oscillator = VoiceOscillator::Sine;
+        OscillatorMode oscillatorMode = OscillatorMode::PolyBLEP;
+        VoiceFilterType filterType = VoiceFilterType::Lowpass;
+        LFOWaveform lfoWaveform = LFOWaveform::Sine;
+        LFODestination lfoDestination = LFODestination::Filter;
+
+        float detune = 0.0f;           // Halbtöne
+        float filterCutoff = 1000.0f;  // Hz
+        float filterResonance = 0.7f;  // 0..1
+        float filterDrive = 1.0f;
+        float filterEnvelopeAmount = 0.0f;
+        float filterEnvelopeAttack = 0.1f; // Sekunden
+        float filterEnvelopeDecay = 0.1f;  // Sekunden
+
+        float attack = 0.1f;  // Sekunden
+        float decay = 0.1f;   // Sekunden
+        float sustain = 0.7f; // 0..1
+        float release = 0.2f; // Sekunden
+
+        float lfoRate = 5.0f; // Hz
+        float lfoDepth = 0.1f;
+        float volume = 1.0f;
+        float pan = 0.0f;
+    };
+
+    explicit VoiceLaneRenderer(size_t maxVoices = 16);
+    ~VoiceLaneRenderer();
+
+    // Nicht aus dem Audio-Thread aufrufen (alloziert)
+    void setMaxVoices(size_t maxVoices);
+    size_t getMaxVoices() const;
+    void setSampleRate(float sampleRate);
+
+    // Audio-Thread, nach der Stimmenvergabe des Synthesizers. Bei retrigger
+    // startet die Attack vom aktuellen Pegel aus, Phase und Filter laufen
+    // weiter (kein Knacken beim Stehlen oder Neuanschlag)
+    void startVoice(size_t index, float frequency, float velocity, float startPhase, bool retrigger = false);
+    void setGate(size_t index, bool gate);
+    void setFrequency(size_t index, float frequency);
+    void reset();
+
+    // Überschreibt numFrames Frames interleavtes Stereo
+    void render(float* output, size_t numFrames, const Parameters& params);
+
+    bool isSounding(size_t index) const;
+    float getLevel(size_t index) const;
+    size_t getSoundingVoiceCount() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,158 @@
+#include "VoicePool.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace VR_DAW {
+
+VoicePool::VoicePool(size_t capacity)
+    : stealPolicy(StealPolicy::Oldest)
+{
+    resize(capacity);
+}
+
+void VoicePool::resize(size_t capacity) {
+    links.assign(std::max<size_t>(1, capacity), Link{kNone, kNone, State::Free, 0, 0});
+    noteTable.assign(kChannels * kNotes, kNone);
+    reset();
+}
+
+void VoicePool::reset() {
+    for (auto& list : lists) {
+        list = List{kNone, kNone, 0};
+    }
+    std::fill(noteTable.begin(), noteTable.end(), kNone);
+    for (size_t i = 0; i < links.size(); ++i) {
+        links[i].prev = kNone;
+        links[i].next = kNone;
+        append(i, State::Free);
+    }
+}
+
+VoicePool::Allocation VoicePool::allocate(uint8_t note, uint8_t channel,
+                                          LevelCallback levelOf, const void* context) {
+    const size_t slot = noteSlot(note, channel);
+    const int32_t existing = noteTable[slot];
+    const StealPolicy policy = stealPolicy.load(std::memory_order_relaxed);
+
+    if (existing != kNone) {
+        if (policy == StealPolicy::SameNote) {
+            // Dieselbe Stimme neu anschlagen, ans Ende der Altersreihenfolge
+            unlink(static_cast<size_t>(existing));
+            append(static_cast<size_t>(existing), State::Held);
+            return {existing, true};
+        }
+        // Eine Taste kann nicht zweimal gehalten sein: alte Stimme ausklingen lassen
+        if (links[existing].state == State::Held) {
+            unlink(static_cast<size_t>(existing));
+            append(static_cast<size_t>(existing), State::Released);
+        }
+    }
+
+    int32_t index = lists[static_cast<size_t>(State::Free)].head;
+    bool stolen = false;
+    if (index == kNone) {
+        if (policy == StealPolicy::None) {
+            return {kNone, false};
+        }
+        index = pickVictim(policy, levelOf, context);
+        if (index == kNone) {
+            return {kNone, false};
+        }
+        stolen = true;
+    }
+
+    unlink(static_cast<size_t>(index));
+    clearNote(static_cast<size_t>(index));
+    links[index].note = note;
+    links[index].channel = channel;
+    append(static_cast<size_t>(index), State::Held);
+    noteTable[slot] = index;
+    return {index, stolen};
+}
+
+int32_t VoicePool::release(uint8_t note, uint8_t channel) {
+    const int32_t index = noteTable[noteSlot(note, channel)];
+    if (index == kNone || links[index].state != State::Held) {
+        return kNone;
+    }
+    // Der Tabelleneintrag bleibt, damit SameNote die ausklingende Stimme findet
+    unlink(static_cast<size_t>(index));
+    append(static_cast<size_t>(index), State::Released);
+    return index;
+}
+
+void VoicePool::free(size_t index) {
+    if (index >= links.size() || links[index].state == State::Free) return;
+    unlink(index);
+    clearNote(index);
+    append(index, State::Free);
+}
+
+int32_t VoicePool::findHeld(uint8_t note, uint8_t channel) const {
+    const int32_t index = noteTable[noteSlot(note, channel)];
+    return index != kNone && links[index].state == State::Held ? index : kNone;
+}
+
+void VoicePool::unlink(size_t index) {
+    Link& link = links[index];
+    List& list = lists[static_cast<size_t>(link.state)];
+    if (link.prev != kNone) links[link.prev].next = link.next; else list.head = link.next;
+    if (link.next != kNone) links[link.next].prev = link.prev; else list.tail = link.prev;
+    link.prev = kNone;
+    link.next = kNone;
+    --list.count;
+}
+
+void VoicePool::append(size_t index, State state) {
+    Link& link = links[index];
+    List& list = lists[static_cast<size_t>(state)];
+    link.state = state;
+    link.prev = list.tail;
+    link.next = kNone;
+    if (list.tail != kNone) links[list.tail].next = static_cast<int32_t>(index); else list.head = static_cast<int32_t>(index);
+    list.tail = static_cast<int32_t>(index);
+    ++list.count;
+}
+
+size_t VoicePool::noteSlot(uint8_t note, uint8_t channel) const {
+    return (channel & 0x0F) * kNotes + (note & 0x7F);
+}
+
+void VoicePool::clearNote(size_t index) {
+    const size_t slot = noteSlot(links[index].note, links[index].channel);
+    if (noteTable[slot] == static_cast<int32_t>(index)) {
+        noteTable[slot] = kNone;
+    }
+}
+
+int32_t VoicePool::pickVictim(StealPolicy policy, LevelCallback levelOf, const void* context) const {
+    const int32_t oldestReleased = lists[static_cast<size_t>(State::Released)].head;
+    const int32_t oldestHeld = lists[static_cast<size_t>(State::Held)].head;
+
+    if (policy != StealPolicy::Quietest || !levelOf) {
+        return oldestReleased != kNone ? oldestReleased : oldestHeld;
+    }
+
+    // Leiseste Stimme; ausklingende bei Gleichstand zuerst, da zuerst geprüft
+    int32_t quietest = kNone;
+    float lowest = std::numeric_limits<float>::max();
+    for (State state : {State::Released, State::Held}) {
+        for (int32_t i = lists[static_cast<size_t>(state)].head; i != kNone; i = links[i].next) {
+            const float level = levelOf(context, static_cast<size_t>(i));
+            if (level < lowest) {
+                lowest = level;
+                quietest = i;
+            }
+        }
+    }
+    return quietest;
+}
+
+VoicePool::StealPolicy parseStealPolicy(const std::string& name) {
+    if (name == "quietest") return VoicePool::StealPolicy::Quietest;
+    if (name == "same-note" || name == "samenote") return VoicePool::StealPolicy::SameNote;
+    if (name == "none") return VoicePool::StealPolicy::None;
+    return VoicePool::StealPolicy::Oldest;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VR_DAW {
+
+// Stimmenvergabe mit fester Kapazität. Freie, gehaltene und ausklingende
+// Stimmen liegen in intrusiven Listen (Indizes statt Zeiger), eine Tabelle
+// pro Kanal und Note findet die Stimme für Note-Off direkt. Note-On,
+// Note-Off und Freigabe sind O(1); nur das Stehlen nach Lautstärke
+// durchsucht die klingenden Stimmen. Keine Allokation außer in resize().
+class VoicePool {
+public:
+    enum class StealPolicy : uint8_t {
+        Oldest,   // älteste ausklingende, sonst älteste gehaltene Stimme
+        Quietest, // leiseste klingende Stimme (Pegel über Callback)
+        SameNote, // Stimme derselben Note neu anschlagen, sonst Oldest
+        None      // keine Stimme frei: Note verwerfen
+    };
+
+    enum class State : uint8_t {
+        Free,
+        Held,
+        Released
+    };
+
+    struct Allocation {
+        int32_t index;   // -1, wenn keine Stimme vergeben wurde
+        bool stolen;     // Stimme klang noch (Neuanschlag oder gestohlen)
+    };
+
+    static constexpr int32_t kNone = -1;
+
+    explicit VoicePool(size_t capacity = 16);
+
+    // Kontroll-Thread; gibt alle Stimmen frei
+    void resize(size_t capacity);
+    size_t capacity() const { return links.size(); }
+
+    // Jeder Thread; allocate() liest die Strategie einmal pro Aufruf
+    void setStealPolicy(StealPolicy policy) { stealPolicy.store(policy, std::memory_order_relaxed); }
+    StealPolicy getStealPolicy() const { return stealPolicy.load(std::memory_order_relaxed); }
+
+    // levelOf(context, index) liefert den aktuellen Pegel für Quietest
+    using LevelCallback = float (*)(const void* context, size_t index);
+
+    Allocation allocate(uint8_t note, uint8_t channel,
+                        LevelCallback levelOf = nullptr, const void* context = nullptr);
+    // Gehaltene Stimme der Note in den Release schicken; Index oder kNone
+    int32_t release(uint8_t note, uint8_t channel);
+    // Ausgeklungene Stimme zurück in die Freiliste
+    void free(size_t index);
+    void reset();
+
+    State getState(size_t index) const { return links[index].state; }
+    int32_t findHeld(uint8_t note, uint8_t channel) const;
+    size_t getHeldCount() const { return lists[static_cast<size_t>(State::Held)].count; }
+    size_t getReleasedCount() const { return lists[static_cast<size_t>(State::Released)].count; }
+
+    // Iteration über eine Liste in Anschlagsreihenfolge (älteste zuerst)
+    int32_t first(State state) const { return lists[static_cast<size_t>(state)].head; }
+    int32_t next(size_t index) const { return links[index].next; }
+
+private:
+    struct Link {
+        int32_t prev;
+        int32_t next;
+        State state;
+        uint8_t note;
+        uint8_t channel;
+    };
+
+    struct List {
+        int32_t head;
+        int32_t tail;
+        size_t count;
+    };
+
+    static constexpr size_t kChannels = 16;
+    static constexpr size_t kNotes = 128;
+
+    std::vector<Link> links;
+    List lists[3];
+    // Letzte Stimme je Kanal/Note (gehalten oder ausklingend), sonst kNone
+    std::vector<int32_t> noteTable;
+    // Vom Kontroll-Thread gesetzt, vom Audio-Thread in allocate() gelesen
+    std::atomic<StealPolicy> stealPolicy;
+
+    void unlink(size_t index);
+    void append(size_t index, State state);
+    size_t noteSlot(uint8_t note, uint8_t channel) const;
+    void clearNote(size_t index);
+    int32_t pickVictim(StealPolicy policy, LevelCallback levelOf, const void* context) const;
+};
+
+VoicePool::StealPolicy parseStealPolicy(const std::string& name);
+
+} // namespace VR_DAW
@@ -0,0 +1,470 @@
+#include "VoiceProcessor.hpp"
+#include "../dsp/FFT.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace VR_DAW {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr size_t kBlock = VoiceProcessor::kBlockSize;
+constexpr size_t kFFTSize = 2 * kBlock;
+constexpr size_t kBins = kBlock + 1;
+
+// Echokompensation
+constexpr float kStepSize = 0.5f;
+// Glättung der Fern-Leistung je Bin
+constexpr float kPowerSmoothing = 0.8f;
+// Geigel auf Blockleistung statt Spitzen: Nahsignal über der Hälfte der
+// stärksten Fernleistung gilt als Gegensprechen; setzt mindestens 3 dB
+// Kopplungsdämpfung Lautsprecher -> Mikrofon voraus
+constexpr float kGeigelThreshold = 0.5f;
+constexpr size_t kDoubleTalkHoldBlocks = 8;
+// Unter dieser Leistung (etwa -70 dBFS) wird nicht adaptiert
+constexpr float kFarActivityPower = 1e-7f;
+// Ab hier wird das Fernsignal im Puffer als veraltet verworfen
+constexpr size_t kFarBufferBlocks = 16;
+
+// Rauschunterdrückung
+constexpr float kSpectrumSmoothing = 0.7f;
+constexpr float kNoiseFall = 0.1f;          // Anteil je Block, wenn unter der Schätzung
+constexpr float kNoiseRise = 5.0f;          // dB pro Sekunde
+constexpr float kDecisionDirected = 0.98f;
+
+// Pegelregelung
+constexpr float kAttack = 60.0f;            // dB pro Sekunde abwärts
+constexpr float kRelease = 6.0f;            // dB pro Sekunde aufwärts
+constexpr float kSpeechGate = -50.0f;       // dBFS; darunter bleibt die Verstärkung stehen
+
+inline float toDb(float power) {
+    return 10.0f * std::log10(power + 1e-12f);
+}
+
+} // namespace
+
+bool VoiceProcessor::Parameters::operator==(const Parameters& other) const {
+    return echoCancellation == other.echoCancellation && noiseSuppression == other.noiseSuppression
+        && automaticGainControl == other.automaticGainControl && echoTail == other.echoTail
+        && noiseReduction == other.noiseReduction && targetLevel == other.targetLevel
+        && maxGain == other.maxGain;
+}
+
+struct VoiceProcessor::Impl {
+    Parameters parameters;
+    float sampleRate = 48000.0f;
+    bool prepared = false;
+
+    dsp::RealFFT fft{kFFTSize};
+
+    // Blockpuffer: processNearEnd() tauscht Sample für Sample ein und aus
+    std::vector<float> inputBlock, outputBlock;
+    size_t blockPosition = 0;
+
+    // Fernsignal-Ring
+    std::vector<float> farRing;
+    size_t farRead = 0, farWrite = 0, farCount = 0;
+
+    // --- Echokompensation ---
+    size_t maxPartitions = 0;
+    size_t partitions = 0;
+    std::vector<float> farFrame;                 // [vorheriger Block | aktueller Block]
+    std::vector<float> farRe, farIm;             // maxPartitions Spektren, Ring
+    size_t farNewest = 0;
+    std::vector<float> weightRe, weightIm;       // maxPartitions Filterspektren
+    std::vector<float> farPower;
+    std::vector<float> farPowers;                // Leistung je Block für Geigel
+    size_t constrainIndex = 0;
+    size_t doubleTalkHold = 0;
+    std::vector<float> echoRe, echoIm, errorRe, errorIm;
+    std::vector<float> time;
+    std::vector<float> farBlock, error;
+    float nearPowerSmoothed = 0.0f, errorPowerSmoothed = 0.0f;
+
+    // --- Rauschunterdrückung ---
+    std::vector<float> window;
+    std::vector<float> nsPrevious, nsOverlap, nsFrame;
+    std::vector<float> nsRe, nsIm;
+    std::vector<float> smoothedPower, noisePower, previousGain, previousPost;
+    size_t nsBlocks = 0;
+    float noiseRiseFactor = 1.0f;
+
+    // --- Pegelregelung ---
+    float gainDb = 0.0f;
+    float appliedGain = 1.0f;
+
+    Stats stats;
+
+    void allocate(float rate, float maxEchoTail) {
+        sampleRate = rate;
+        maxPartitions = std::max<size_t>(1, static_cast<size_t>(std::ceil(maxEchoTail * rate / kBlock)));
+
+        inputBlock.assign(kBlock, 0.0f);
+        outputBlock.assign(kBlock, 0.0f);
+        farRing.assign(kFarBufferBlocks * kBlock, 0.0f);
+
+        farFrame.assign(kFFTSize, 0.0f);
+        farRe.assign(maxPartitions * kBins, 0.0f);
+        farIm.assign(maxPartitions * kBins, 0.0f);
+        weightRe.assign(maxPartitions * kBins, 0.0f);
+        weightIm.assign(maxPartitions * kBins, 0.0f);
+        farPower.assign(kBins, 0.0f);
+        farPowers.assign(maxPartitions, 0.0f);
+        echoRe.assign(kBins, 0.0f);
+        echoIm.assign(kBins, 0.0f);
+        errorRe.assign(kBins, 0.0f);
+        errorIm.assign(kBins, 0.0f);
+        time.assign(kFFTSize, 0.0f);
+        farBlock.assign(kBlock, 0.0f);
+        error.assign(kBlock, 0.0f);
+
+        // Periodisches Wurzel-Hann: w²[n] + w²[n + kBlock] = 1
+        window.resize(kFFTSize);
+        for (size_t n = 0; n < kFFTSize; ++n) {
+            window[n] = static_cast<float>(std::sqrt(0.5 - 0.5 * std::cos(2.0 * kPi * n / kFFTSize)));
+        }
+        nsPrevious.assign(kBlock, 0.0f);
+        nsOverlap.assign(kBlock, 0.0f);
+        nsFrame.assign(kFFTSize, 0.0f);
+        nsRe.assign(kBins, 0.0f);
+        nsIm.assign(kBins, 0.0f);
+        smoothedPower.assign(kBins, 0.0f);
+        noisePower.assign(kBins, 0.0f);
+        previousGain.assign(kBins, 1.0f);
+        previousPost.assign(kBins, 1.0f);
+        noiseRiseFactor = std::pow(10.0f, kNoiseRise / 10.0f * kBlock / rate);
+
+        prepared = true;
+        updatePartitions();
+        clear();
+    }
+
+    void updatePartitions() {
+        const size_t wanted = static_cast<size_t>(std::ceil(parameters.echoTail * sampleRate / kBlock));
+        partitions = std::clamp<size_t>(wanted, 1, maxPartitions);
+    }
+
+    void clear() {
+        std::fill(inputBlock.begin(), inputBlock.end(), 0.0f);
+        std::fill(outputBlock.begin(), outputBlock.end(), 0.0f);
+        blockPosition = 0;
+        farRead = farWrite = farCount = 0;
+
+        std::fill(farFrame.begin(), farFrame.end(), 0.0f);
+        std::fill(farRe.begin(), farRe.end(), 0.0f);
+        std::fill(farIm.begin(), farIm.end(), 0.0f);
+        std::fill(weightRe.begin(), weightRe.end(), 0.0f);
+        std::fill(weightIm.begin(), weightIm.end(), 0.0f);
+        std::fill(farPower.begin(), farPower.end(), 0.0f);
+        std::fill(farPowers.begin(), farPowers.end(), 0.0f);
+        farNewest = 0;
+        constrainIndex = 0;
+        doubleTalkHold = 0;
+        nearPowerSmoothed = errorPowerSmoothed = 0.0f;
+
+        std::fill(nsPrevious.begin(), nsPrevious.end(), 0.0f);
+        std::fill(nsOverlap.begin(), nsOverlap.end(), 0.0f);
+        std::fill(smoothedPower.begin(), smoothedPower.end(), 0.0f);
+        std::fill(noisePower.begin(), noisePower.end(), 0.0f);
+        std::fill(previousGain.begin(), previousGain.end(), 1.0f);
+        std::fill(previousPost.begin(), previousPost.end(), 1.0f);
+        nsBlocks = 0;
+
+        gainDb = 0.0f;
+        appliedGain = 1.0f;
+        stats = Stats();
+    }
+
+    void popFarBlock() {
+        const size_t capacity = farRing.size();
+        const size_t available = std::min(farCount, kBlock);
+        for (size_t i = 0; i < available; ++i) {
+            farBlock[i] = farRing[farRead];
+            farRead = (farRead + 1) % capacity;
+        }
+        std::fill(farBlock.begin() + available, farBlock.end(), 0.0f);
+        farCount -= available;
+    }
+
+    // near: kBlockSize Samples Mikrofon; Ergebnis in error
+    void cancelEcho(const float* near) {
+        popFarBlock();
+
+        // Fern-Spektrum des neuesten Blocks (mit Vorgänger, Overlap-Save)
+        std::memmove(farFrame.data(), farFrame.data() + kBlock, kBlock * sizeof(float));
+        std::memcpy(farFrame.data() + kBlock, farBlock.data(), kBlock * sizeof(float));
+        farNewest = (farNewest + 1) % maxPartitions;
+        float* xRe = farRe.data() + farNewest * kBins;
+        float* xIm = farIm.data() + farNewest * kBins;
+        fft.forward(farFrame.data(), xRe, xIm);
+
+        float farBlockPower = 0.0f, nearPower = 0.0f;
+        for (size_t i = 0; i < kBlock; ++i) {
+            farBlockPower += farBlock[i] * farBlock[i];
+            nearPower += near[i] * near[i];
+        }
+        farBlockPower /= kBlock;
+        nearPower /= kBlock;
+        farPowers[farNewest] = farBlockPower;
+
+        // Echo-Schätzung: Summe über die Partitionen, älteste Fernblöcke
+        // gegen die späten Filterteile
+        std::fill(echoRe.begin(), echoRe.end(), 0.0f);
+        std::fill(echoIm.begin(), echoIm.end(), 0.0f);
+        for (size_t k = 0; k < partitions; ++k) {
+            const size_t slot = (farNewest + maxPartitions - k) % maxPartitions;
+            dsp::complexMultiplyAccumulate(echoRe.data(), echoIm.data(),
+                                           weightRe.data() + k * kBins, weightIm.data() + k * kBins,
+                                           farRe.data() + slot * kBins, farIm.data() + slot * kBins,
+                                           kBins);
+        }
+        fft.inverse(echoRe.data(), echoIm.data(), time.data());
+
+        const float scale = 1.0f / kFFTSize;
+        float errorPower = 0.0f;
+        for (size_t i = 0; i < kBlock; ++i) {
+            error[i] = near[i] - time[kBlock + i] * scale;
+            errorPower += error[i] * error[i];
+        }
+        errorPower /= kBlock;
+
+        // Gegensprechen nach Geigel über die Filterlänge
+        float farPowerSpan = 0.0f;
+        for (size_t k = 0; k < partitions; ++k) {
+            farPowerSpan = std::max(farPowerSpan, farPowers[(farNewest + maxPartitions - k) % maxPartitions]);
+        }
+        if (nearPower > kGeigelThreshold * farPowerSpan) {
+            doubleTalkHold = kDoubleTalkHoldBlocks;
+        } else if (doubleTalkHold > 0) {
+            --doubleTalkHold;
+        }
+        const bool farActive = farBlockPower > kFarActivityPower;
+        stats.doubleTalk = doubleTalkHold > 0 && farActive;
+
+        // Divergiert: Filter verstärkt das Signal, neu beginnen
+        if (farActive && errorPower > 4.0f * nearPower + 1e-9f) {
+            std::fill(weightRe.begin(), weightRe.end(), 0.0f);
+            std::fill(weightIm.begin(), weightIm.end(), 0.0f);
+            std::memcpy(error.data(), near, kBlock * sizeof(float));
+            errorPower = nearPower;
+        }
+
+        if (farActive && doubleTalkHold == 0) {
+            nearPowerSmoothed = 0.9f * nearPowerSmoothed + 0.1f * nearPower;
+            errorPowerSmoothed = 0.9f * errorPowerSmoothed + 0.1f * errorPower;
+            stats.echoReturnLossEnhancement = toDb(nearPowerSmoothed) - toDb(errorPowerSmoothed);
+            adapt(xRe, xIm);
+        }
+    }
+
+    void adapt(const float* xRe, const float* xIm) {
+        // Fehlerspektrum: [Nullen | Fehlerblock]
+        std::fill(time.begin(), time.begin() + kBlock, 0.0f);
+        std::memcpy(time.data() + kBlock, error.data(), kBlock * sizeof(float));
+        fft.forward(time.data(), errorRe.data(), errorIm.data());
+
+        // Normierter Schritt je Bin: mu * E / (K * P + delta), einmal je Block
+        const float regularization = static_cast<float>(kFFTSize) * kBlock * 1e-7f;
+        const float normalization = static_cast<float>(partitions);
+        for (size_t b = 0; b < kBins; ++b) {
+            const float power = xRe[b] * xRe[b] + xIm[b] * xIm[b];
+            farPower[b] = kPowerSmoothing * farPower[b] + (1.0f - kPowerSmoothing) * power;
+            const float step = kStepSize / (normalization * farPower[b] + regularization);
+            errorRe[b] *= step;
+            errorIm[b] *= step;
+        }
+
+        // W_k += conj(X_k) * G
+        for (size_t k = 0; k < partitions; ++k) {
+            const size_t slot = (farNewest + maxPartitions - k) % maxPartitions;
+            const float* aRe = farRe.data() + slot * kBins;
+            const float* aIm = farIm.data() + slot * kBins;
+            float* wRe = weightRe.data() + k * kBins;
+            float* wIm = weightIm.data() + k * kBins;
+            for (size_t b = 0; b < kBins; ++b) {
+                wRe[b] += aRe[b] * errorRe[b] + aIm[b] * errorIm[b];
+                wIm[b] += aRe[b] * errorIm[b] - aIm[b] * errorRe[b];
+            }
+        }
+
+        // Gradienten-Beschränkung reihum: zweite Hälfte der Impulsantwort auf null
+        constrainIndex = (constrainIndex + 1) % partitions;
+        float* wRe = weightRe.data() + constrainIndex * kBins;
+        float* wIm = weightIm.data() + constrainIndex * kBins;
+        fft.inverse(wRe, wIm, time.data());
+        const float scale = 1.0f / kFFTSize;
+        for (size_t i = 0; i < kBlock; ++i) time[i] *= scale;
+        std::fill(time.begin() + kBlock, time.end(), 0.0f);
+        fft.forward(time.data(), wRe, wIm);
+    }
+
+    // Blockweise STFT: Ausgabe ist der vorherige Block (Latenz kBlockSize)
+    void suppressNoise(float* block) {
+        for (size_t i = 0; i < kBlock; ++i) {
+            nsFrame[i] = nsPrevious[i] * window[i];
+            nsFrame[kBlock + i] = block[i] * window[kBlock + i];
+        }
+        std::memcpy(nsPrevious.data(), block, kBlock * sizeof(float));
+        fft.forward(nsFrame.data(), nsRe.data(), nsIm.data());
+
+        const float minimumGain = std::pow(10.0f, -parameters.noiseReduction / 20.0f);
+        const bool initializing = nsBlocks < 8;
+        ++nsBlocks;
+        float noiseSum = 0.0f;
+
+        for (size_t b = 0; b < kBins; ++b) {
+            const float power = nsRe[b] * nsRe[b] + nsIm[b] * nsIm[b];
+            smoothedPower[b] = kSpectrumSmoothing * smoothedPower[b] + (1.0f - kSpectrumSmoothing) * power;
+
+            // Minimum-Tracking: schnell fallen, langsam steigen
+            if (initializing) {
+                noisePower[b] = smoothedPower[b];
+            } else if (smoothedPower[b] < noisePower[b]) {
+                noisePower[b] += kNoiseFall * (smoothedPower[b] - noisePower[b]);
+            } else {
+                noisePower[b] *= noiseRiseFactor;
+            }
+            const float noise = noisePower[b] + 1e-12f;
+            noiseSum += noise;
+
+            const float post = power / noise;
+            const float prior = kDecisionDirected * previousGain[b] * previousGain[b] * previousPost[b]
+                              + (1.0f - kDecisionDirected) * std::max(post - 1.0f, 0.0f);
+            const float gain = std::max(minimumGain, prior / (1.0f + prior));
+            previousGain[b] = gain;
+            previousPost[b] = post;
+            nsRe[b] *= gain;
+            nsIm[b] *= gain;
+        }
+
+        fft.inverse(nsRe.data(), nsIm.data(), nsFrame.data());
+        const float scale = 1.0f / kFFTSize;
+        for (size_t i = 0; i < kBlock; ++i) {
+            block[i] = nsOverlap[i] + nsFrame[i] * window[i] * scale;
+            nsOverlap[i] = nsFrame[kBlock + i] * window[kBlock + i] * scale;
+        }
+
+        // Mittlere Rauschleistung je Sample: Bins summiert, FFT- und
+        // Fenster-Energie (Summe w² = kBlock) herausgerechnet
+        stats.noiseFloor = toDb(noiseSum * 2.0f / (static_cast<float>(kFFTSize) * kBlock));
+    }
+
+    void controlGain(float* block) {
+        float power = 0.0f, peak = 0.0f;
+        for (size_t i = 0; i < kBlock; ++i) {
+            power += block[i] * block[i];
+            peak = std::max(peak, std::abs(block[i]));
+        }
+        const float levelDb = toDb(power / kBlock);
+        const float blockSeconds = kBlock / sampleRate;
+
+        if (levelDb > kSpeechGate) {
+            const float desired = std::min(parameters.targetLevel - levelDb, parameters.maxGain);
+            if (desired < gainDb) {
+                gainDb = std::max(desired, gainDb - kAttack * blockSeconds);
+            } else {
+                gainDb = std::min(desired, gainDb + kRelease * blockSeconds);
+            }
+        }
+
+        float target = std::pow(10.0f, gainDb / 20.0f);
+        if (peak * target > kPeakCeiling) {
+            target = kPeakCeiling / peak;
+        }
+
+        // Rampe vom bisherigen Wert, die Spitze darf dabei die Decke nicht reißen
+        const float start = std::min(appliedGain, peak > 0.0f ? kPeakCeiling / peak : appliedGain);
+        const float step = (target - start) / kBlock;
+        for (size_t i = 0; i < kBlock; ++i) {
+            block[i] *= start + step * static_cast<float>(i + 1);
+        }
+        appliedGain = target;
+        stats.gain = 20.0f * std::log10(target);
+    }
+
+    void processBlock() {
+        float* block = outputBlock.data();
+        if (parameters.echoCancellation) {
+            cancelEcho(inputBlock.data());
+            std::memcpy(block, error.data(), kBlock * sizeof(float));
+        } else {
+            popFarBlock();
+            std::memcpy(block, inputBlock.data(), kBlock * sizeof(float));
+        }
+        if (parameters.noiseSuppression) {
+            suppressNoise(block);
+        }
+        if (parameters.automaticGainControl) {
+            controlGain(block);
+        }
+    }
+};
+
+VoiceProcessor::VoiceProcessor()
+    : pImpl(std::make_unique<Impl>())
+{
+    pImpl->allocate(48000.0f, 0.25f);
+}
+
+VoiceProcessor::~VoiceProcessor() = default;
+
+void VoiceProcessor::prepare(float sampleRate, float maxEchoTail) {
+    pImpl->allocate(sampleRate, maxEchoTail);
+}
+
+void VoiceProcessor::setParameters(const Parameters& parameters) {
+    if (parameters == pImpl->parameters) return;
+    const bool nsChanged = parameters.noiseSuppression != pImpl->parameters.noiseSuppression;
+    pImpl->parameters = parameters;
+    pImpl->updatePartitions();
+    if (nsChanged) {
+        std::fill(pImpl->nsOverlap.begin(), pImpl->nsOverlap.end(), 0.0f);
+        std::fill(pImpl->nsPrevious.begin(), pImpl->nsPrevious.end(), 0.0f);
+    }
+}
+
+const VoiceProcessor::Parameters& VoiceProcessor::getParameters() const {
+    return pImpl->parameters;
+}
+
+void VoiceProcessor::processFarEnd(const float* samples, size_t numFrames) {
+    Impl& s = *pImpl;
+    const size_t capacity = s.farRing.size();
+    for (size_t i = 0; i < numFrames; ++i) {
+        s.farRing[s.farWrite] = samples[i];
+        s.farWrite = (s.farWrite + 1) % capacity;
+        if (s.farCount == capacity) {
+            s.farRead = (s.farRead + 1) % capacity;  // ältestes verwerfen
+        } else {
+            ++s.farCount;
+        }
+    }
+}
+
+void VoiceProcessor::processNearEnd(float* samples, size_t numFrames) {
+    Impl& s = *pImpl;
+    for (size_t i = 0; i < numFrames; ++i) {
+        s.inputBlock[s.blockPosition] = samples[i];
+        samples[i] = s.outputBlock[s.blockPosition];
+        if (++s.blockPosition == kBlock) {
+            s.processBlock();
+            s.blockPosition = 0;
+        }
+    }
+}
+
+void VoiceProcessor::reset() {
+    pImpl->clear();
+}
+
+size_t VoiceProcessor::getLatency() const {
+    return kBlock + (pImpl->parameters.noiseSuppression ? kBlock : 0);
+}
+
+VoiceProcessor::Stats VoiceProcessor::getStats() const {
+    return pImpl->stats;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace VR_DAW {
+
+// Sprachverarbeitung für den Voice-Chat zwischen Kollaborateuren, mono, in
+// Blöcken zu kBlockSize Samples:
+//
+//  1. Echokompensation gegen das Fernsignal (was über die Lautsprecher
+//     läuft): MDF, also NLMS im Frequenzbereich mit partitioniertem Filter
+//     (Blocklänge kBlockSize, FFT 2 * kBlockSize). Die Gradienten-Beschränkung
+//     läuft reihum für eine Partition je Block. Während Gegensprechen
+//     (Geigel-Detektor auf Blockleistung) und ohne Fernsignal wird nicht adaptiert.
+//  2. Rauschunterdrückung per STFT (Wurzel-Hann, 50 % Überlappung):
+//     Rauschschätzung durch Minimum-Tracking, Wiener-Gain mit
+//     Decision-Directed-SNR und Untergrenze.
+//  3. Pegelregelung im Blocktakt: ein log10 und ein pow je Block, Rampe
+//     über den Block, Spitzen werden auf kPeakCeiling begrenzt.
+//
+// Latenz: ein Block, mit Rauschunterdrückung zwei. Nach prepare() wird
+// nicht mehr alloziert; Fern- und Nahseite dürfen nicht gleichzeitig laufen.
+class VoiceProcessor {
+public:
+    static constexpr size_t kBlockSize = 256;
+    static constexpr float kPeakCeiling = 0.95f;
+
+    struct Parameters {
+        bool echoCancellation = true;
+        bool noiseSuppression = true;
+        bool automaticGainControl = true;
+        float echoTail = 0.128f;          // Sekunden, höchstens maxEchoTail aus prepare()
+        float noiseReduction = 20.0f;     // dB, maximale Absenkung
+        float targetLevel = -23.0f;       // dBFS RMS
+        float maxGain = 24.0f;            // dB
+
+        bool operator==(const Parameters& other) const;
+        bool operator!=(const Parameters& other) const { return !(*this == other); }
+    };
+
+    struct Stats {
+        float echoReturnLossEnhancement = 0.0f;  // dB, Echo-Dämpfung durch den Filter
+        bool doubleTalk = false;
+        float noiseFloor = -120.0f;               // dBFS
+        float gain = 0.0f;                        // dB, aktuelle AGC-Verstärkung
+    };
+
+    VoiceProcessor();
+    ~VoiceProcessor();
+
+    // Alloziert Filter und Puffer, nicht im Audio-Thread aufrufen
+    void prepare(float sampleRate, float maxEchoTail = 0.25f);
+    void setParameters(const Parameters& parameters);
+    const Parameters& getParameters() const;
+
+    // Fernsignal vor der Wiedergabe; wird bis zum nächsten Nahblock gepuffert
+    void processFarEnd(const float* samples, size_t numFrames);
+    // Mikrofonsignal, in-place
+    void processNearEnd(float* samples, size_t numFrames);
+    void reset();
+
+    size_t getLatency() const;
+    Stats getStats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -1365,71 +1365,125 @@ std::vector<std::string> VoiceVocoderBank::getAvailablePresets() const {
     return presetNames;
 }
 
+const ParameterRegistry& VoiceVocoderBank::getParameterRegistry() {
+    static const ParameterRegistry registry = [] {
+        ParameterRegistry r;
+        // Allgemeine Parameter
+        r.add({"carrier_level", 0.0f, 2.0f, 1.0f, ParameterUnit::Ratio, 0.02f});
+        r.add({"modulator_level", 0.0f, 2.0f, 1.0f, ParameterUnit::Ratio, 0.02f});
+        r.add({"dry_wet", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent, 0.02f});
+        // Modus-spezifische Parameter
+        r.add({"num_bands", 1.0f, 64.0f, 16.0f, ParameterUnit::None, 0.0f, true, false});
+        r.add({"bandwidth", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"attack", 0.0001f, 1.0f, 0.01f, ParameterUnit::Seconds});
+        r.add({"release", 0.001f, 5.0f, 0.1f, ParameterUnit::Seconds});
+        r.add({"pitch_shift", -24.0f, 24.0f, 0.0f, ParameterUnit::Semitones});
+        r.add({"formant_shift", -12.0f, 12.0f, 0.0f, ParameterUnit::Semitones});
+        r.add({"metallic_amount", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"num_voices", 1.0f, 16.0f, 4.0f, ParameterUnit::None, 0.0f, true, false});
+        r.add({"detune", 0.0f, 1.0f, 0.1f, ParameterUnit::Percent});
+        r.add({"spread", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"blend", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"pitch_tracking", 0.0f, 1.0f, 0.8f, ParameterUnit::Percent});
+        r.add({"formant_scale", 0.25f, 4.0f, 1.0f, ParameterUnit::Ratio});
+        r.add({"formant_preserve", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"grain_size", 0.001f, 1.0f, 0.1f, ParameterUnit::Seconds});
+        r.add({"density", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"pitch", -24.0f, 24.0f, 0.0f, ParameterUnit::Semitones});
+        r.add({"spectral_shift", -1.0f, 1.0f, 0.0f, ParameterUnit::None});
+        r.add({"spectral_scale", 0.25f, 4.0f, 1.0f, ParameterUnit::Ratio});
+        r.add({"spectral_preserve", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"time_stretch", 0.25f, 4.0f, 1.0f, ParameterUnit::Ratio});
+        r.add({"phase_preserve", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"morph_amount", 0.0f, 1.0f, 0.0f, ParameterUnit::Percent});
+        // Früher ebenfalls "formant_preserve" und damit unerreichbar
+        r.add({"morph_formant_preserve", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"style_strength", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        r.add({"creativity", 0.0f, 1.0f, 0.5f, ParameterUnit::Percent});
+        return r;
+    }();
+    return registry;
+}
+
+void VoiceVocoderBank::setParameter(ParameterId id, float value) {
+    const ParameterRegistry& registry = getParameterRegistry();
+    if (!registry.contains(id)) return;
+    value = registry.clamp(id, value);
+
+    switch (id) {
+        case kCarrierLevel: parameters.carrierLevel = value; break;
+        case kModulatorLevel: parameters.modulatorLevel = value; break;
+        case kDryWet: parameters.dryWet = value; break;
+        case kNumBands: parameters.classic.numBands = static_cast<int>(value); break;
+        case kBandwidth: parameters.classic.bandwidth = value; break;
+        case kAttack: parameters.classic.attack = value; break;
+        case kRelease: parameters.classic.release = value; break;
+        case kPitchShift: parameters.robot.pitchShift = value; break;
+        case kFormantShift: parameters.robot.formantShift = value; break;
+        case kMetallicAmount: parameters.robot.metallicAmount = value; break;
+        case kNumVoices: parameters.choir.numVoices = static_cast<int>(value); break;
+        case kDetune: parameters.choir.detune = value; break;
+        case kSpread: parameters.choir.spread = value; break;
+        case kBlend: parameters.harmony.blend = value; break;
+        case kPitchTracking: parameters.harmony.pitchTracking = value; break;
+        case kFormantScale: parameters.formant.formantScale = value; break;
+        case kFormantPreserve: parameters.formant.formantPreserve = value; break;
+        case kGrainSize: parameters.granular.grainSize = value; break;
+        case kDensity: parameters.granular.density = value; break;
+        case kPitch: parameters.granular.pitch = value; break;
+        case kSpectralShift: parameters.spectral.spectralShift = value; break;
+        case kSpectralScale: parameters.spectral.spectralScale = value; break;
+        case kSpectralPreserve: parameters.spectral.spectralPreserve = value; break;
+        case kTimeStretch: parameters.phase.timeStretch = value; break;
+        case kPhasePreserve: parameters.phase.phasePreserve = value; break;
+        case kMorphAmount: parameters.morphing.morphAmount = value; break;
+        case kMorphFormantPreserve: parameters.morphing.formantPreserve = value; break;
+        case kStyleStrength: parameters.neural.styleStrength = value; break;
+        case kCreativity: parameters.neural.creativity = value; break;
+    }
+}
+
+float VoiceVocoderBank::getParameter(ParameterId id) const {
+    switch (id) {
+        case kCarrierLevel: return parameters.carrierLevel;
+        case kModulatorLevel: return parameters.modulatorLevel;
+        case kDryWet: return parameters.dryWet;
+        case kNumBands: return static_cast<float>(parameters.classic.numBands);
+        case kBandwidth: return parameters.classic.bandwidth;
+        case kAttack: return parameters.classic.attack;
+        case kRelease: return parameters.classic.release;
+        case kPitchShift: return parameters.robot.pitchShift;
+        case kFormantShift: return parameters.robot.formantShift;
+        case kMetallicAmount: return parameters.robot.metallicAmount;
+        case kNumVoices: return static_cast<float>(parameters.choir.numVoices);
+        case kDetune: return parameters.choir.detune;
+        case kSpread: return parameters.choir.spread;
+        case kBlend: return parameters.harmony.blend;
+        case kPitchTracking: return parameters.harmony.pitchTracking;
+        case kFormantScale: return parameters.formant.formantScale;
+        case kFormantPreserve: return parameters.formant.formantPreserve;
+        case kGrainSize: return parameters.granular.grainSize;
+        case kDensity: return parameters.granular.density;
+        case kPitch: return parameters.granular.pitch;
+        case kSpectralShift: return parameters.spectral.spectralShift;
+        case kSpectralScale: return parameters.spectral.spectralScale;
+        case kSpectralPreserve: return parameters.spectral.spectralPreserve;
+        case kTimeStretch: return parameters.phase.timeStretch;
+        case kPhasePreserve: return parameters.phase.phasePreserve;
+        case kMorphAmount: return parameters.morphing.morphAmount;
+        case kMorphFormantPreserve: return parameters.morphing.formantPreserve;
+        case kStyleStrength: return parameters.neural.styleStrength;
+        case kCreativity: return parameters.neural.creativity;
+    }
+    return 0.0f;
+}
+
 void VoiceVocoderBank::setParameter(const std::string& name, float value) {
-    if (name == "carrier_level") parameters.carrierLevel = value;
-    else if (name == "modulator_level") parameters.modulatorLevel = value;
-    else if (name == "dry_wet") parameters.dryWet = value;
-    // Modus-spezifische Parameter
-    else if (name == "num_bands") parameters.classic.numBands = static_cast<int>(value);
-    else if (name == "bandwidth") parameters.classic.bandwidth = value;
-    else if (name == "attack") parameters.classic.attack = value;
-    else if (name == "release") parameters.classic.release = value;
-    else if (name == "pitch_shift") parameters.robot.pitchShift = value;
-    else if (name == "formant_shift") parameters.robot.formantShift = value;
-    else if (name == "metallic_amount") parameters.robot.metallicAmount = value;
-    else if (name == "num_voices") parameters.choir.numVoices = static_cast<int>(value);
-    else if (name == "detune") parameters.choir.detune = value;
-    else if (name == "spread") parameters.choir.spread = value;
-    else if (name == "blend") parameters.harmony.blend = value;
-    else if (name == "pitch_tracking") parameters.harmony.pitchTracking = value;
-    else if (name == "formant_scale") parameters.formant.formantScale = value;
-    else if (name == "formant_preserve") parameters.formant.formantPreserve = value;
-    else if (name == "grain_size") parameters.granular.grainSize = value;
-    else if (name == "density") parameters.granular.density = value;
-    else if (name == "pitch") parameters.granular.pitch = value;
-    else if (name == "spectral_shift") parameters.spectral.spectralShift = value;
-    else if (name == "spectral_scale") parameters.spectral.spectralScale = value;
-    else if (name == "spectral_preserve") parameters.spectral.spectralPreserve = value;
-    else if (name == "time_stretch") parameters.phase.timeStretch = value;
-    else if (name == "phase_preserve") parameters.phase.phasePreserve = value;
-    else if (name == "morph_amount") parameters.morphing.morphAmount = value;
-    else if (name == "formant_preserve") parameters.morphing.formantPreserve = value;
-    else if (name == "style_strength") parameters.neural.styleStrength = value;
-    else if (name == "creativity") parameters.neural.creativity = value;
+    setParameter(getParameterRegistry().find(name), value);
 }
 
 float VoiceVocoderBank::getParameter(const std::string& name) const {
-    if (name == "carrier_level") return parameters.carrierLevel;
-    else if (name == "modulator_level") return parameters.modulatorLevel;
-    else if (name == "dry_wet") return parameters.dryWet;
-    // Modus-spezifische Parameter
-    else if (name == "num_bands") return static_cast<float>(parameters.classic.numBands);
-    else if (name == "bandwidth") return parameters.classic.bandwidth;
-    else if (name == "attack") return parameters.classic.attack;
-    else if (name == "release") return parameters.classic.release;
-    else if (name == "pitch_shift") return parameters.robot.pitchShift;
-    else if (name == "formant_shift") return parameters.robot.formantShift;
-    else if (name == "metallic_amount") return parameters.robot.metallicAmount;
-    else if (name == "num_voices") return static_cast<float>(parameters.choir.numVoices);
-    else if (name == "detune") return parameters.choir.detune;
-    else if (name == "spread") return parameters.choir.spread;
-    else if (name == "blend") return parameters.harmony.blend;
-    else if (name == "pitch_tracking") return parameters.harmony.pitchTracking;
-    else if (name == "formant_scale") return parameters.formant.formantScale;
-    else if (name == "formant_preserve") return parameters.formant.formantPreserve;
-    else if (name == "grain_size") return parameters.granular.grainSize;
-    else if (name == "density") return parameters.granular.density;
-    else if (name == "pitch") return parameters.granular.pitch;
-    else if (name == "spectral_shift") return parameters.spectral.spectralShift;
-    else if (name == "spectral_scale") return parameters.spectral.spectralScale;
-    else if (name == "spectral_preserve") return parameters.spectral.spectralPreserve;
-    else if (name == "time_stretch") return parameters.phase.timeStretch;
-    else if (name == "phase_preserve") return parameters.phase.phasePreserve;
-    else if (name == "morph_amount") return parameters.morphing.morphAmount;
-    else if (name == "formant_preserve") return parameters.morphing.formantPreserve;
-    else if (name == "style_strength") return parameters.neural.styleStrength;
-    else if (name == "creativity") return parameters.neural.creativity;
-    return 0.0f;
+    return getParameter(getParameterRegistry().find(name));
 }
 
 } // namespace VR_DAW 
\ No newline at end of file
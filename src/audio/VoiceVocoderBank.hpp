@@ -6,6 +6,7 @@
 #include <map>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
+#include "ParameterRegistry.hpp"
 
 namespace VR_DAW {
 
@@ -63,9 +64,28 @@ public:
     void addCustomMode(const std::string& name, const std::vector<float>& parameters);
     void removeCustomMode(const std::string& name);
     
-    // Parameter-Steuerung
+    // Parameter-IDs, Reihenfolge wie in getParameterRegistry()
+    enum Parameter : ParameterId {
+        kCarrierLevel, kModulatorLevel, kDryWet,
+        kNumBands, kBandwidth, kAttack, kRelease,
+        kPitchShift, kFormantShift, kMetallicAmount,
+        kNumVoices, kDetune, kSpread,
+        kBlend, kPitchTracking,
+        kFormantScale, kFormantPreserve,
+        kGrainSize, kDensity, kPitch,
+        kSpectralShift, kSpectralScale, kSpectralPreserve,
+        kTimeStretch, kPhasePreserve,
+        kMorphAmount, kMorphFormantPreserve,
+        kStyleStrength, kCreativity
+    };
+
+    // Parameter-Steuerung; Werte werden auf den Bereich begrenzt
+    void setParameter(ParameterId id, float value);
+    float getParameter(ParameterId id) const;
+    // Namens-Varianten für UI und Presets
     void setParameter(const std::string& name, float value);
     float getParameter(const std::string& name) const;
+    static const ParameterRegistry& getParameterRegistry();
     
     // Audio-Verarbeitung
     void processBlock(juce::AudioBuffer<float>& buffer);
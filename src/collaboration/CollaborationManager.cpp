@@ -1,10 +1,22 @@
 #include "CollaborationManager.hpp"
 #include <json/json.h>
+#include <algorithm>
 #include <chrono>
+#include <random>
 #include <thread>
 
 namespace VR_DAW {
 
+namespace {
+
+// Binäre Dokument-Nachrichten: u8 Art, u64 Absender (little-endian),
+// u8 Länge + Projekt-ID, dann der Inhalt
+constexpr uint8_t kDocumentVersion = 1;    // Versionsvektor des Absenders
+constexpr uint8_t kDocumentChanges = 2;    // Operationen oder Snapshot
+constexpr size_t kDocumentHeaderSize = 10;
+
+} // namespace
+
 CollaborationManager& CollaborationManager::getInstance() {
     static CollaborationManager instance;
     return instance;
@@ -24,9 +36,27 @@ void CollaborationManager::initialize() {
     wsServer->set_access_channels(websocketpp::log::alevel::connect);
     wsServer->set_access_channels(websocketpp::log::alevel::disconnect);
     wsServer->set_access_channels(websocketpp::log::alevel::app);
+    
+    // Replik-ID für die Projektdokumente; 0 ist für die Wurzel reserviert
+    std::random_device device;
+    replicaId = (static_cast<uint64_t>(device()) << 32) | device();
+    if (replicaId == 0) replicaId = 1;
+    
+    // Kompaktierung der Dokumente im Hintergrund
+    compactorRunning = true;
+    compactorThread = std::thread(&CollaborationManager::compactorLoop, this);
 }
 
 void CollaborationManager::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(documentMutex);
+        compactorRunning = false;
+    }
+    compactorCondition.notify_all();
+    if (compactorThread.joinable()) {
+        compactorThread.join();
+    }
+    
     disconnect();
     wsClient.reset();
     wsServer.reset();
@@ -34,19 +64,40 @@ void CollaborationManager::shutdown() {
 
 void CollaborationManager::connect(const std::string& serverUrl) {
     if (connected) return;
+    // Abgebrochener oder fehlgeschlagener Versuch: Client-Thread aufräumen
+    disconnect();
     
     try {
-        wsClient->init_asio();
+        if (!clientInitialized) {
+            wsClient->init_asio();
+            clientInitialized = true;
+        }
         
         wsClient->set_message_handler([this](websocketpp::connection_hdl hdl, websocketpp::config::asio::message_type::ptr msg) {
-            handleWebSocketMessage(msg->get_payload());
+            if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
+                handleDocumentMessage(msg->get_payload());
+            } else {
+                handleWebSocketMessage(msg->get_payload());
+            }
         });
         
         wsClient->set_open_handler([this](websocketpp::connection_hdl hdl) {
+            {
+                std::lock_guard<std::mutex> lock(connectionMutex);
+                connection = hdl;
+            }
+            connected = true;
             handleWebSocketConnection(hdl.lock()->get_remote_endpoint());
+            
+            // Stand des aktuellen Projekts ankündigen, Verpasstes kommt zurück
+            std::lock_guard<std::mutex> lock(documentMutex);
+            if (!currentProjectId.empty()) {
+                syncProjectData(currentProjectId);
+            }
         });
         
         wsClient->set_close_handler([this](websocketpp::connection_hdl hdl) {
+            connected = false;
             handleWebSocketDisconnection(hdl.lock()->get_remote_endpoint());
         });
         
@@ -58,9 +109,12 @@ void CollaborationManager::connect(const std::string& serverUrl) {
         }
         
         wsClient->connect(con);
-        wsClient->run();
         
-        connected = true;
+        // run() blockiert bis zum Verbindungsende; connected setzt der Open-Handler
+        clientThread = std::thread([this] {
+            wsClient->run();
+            connected = false;
+        });
     }
     catch (const std::exception& e) {
         // Fehlerbehandlung
@@ -69,15 +123,18 @@ void CollaborationManager::connect(const std::string& serverUrl) {
 }
 
 void CollaborationManager::disconnect() {
-    if (!connected) return;
+    if (!clientThread.joinable()) return;
     
     try {
         wsClient->stop();
-        connected = false;
     }
     catch (const std::exception& e) {
         // Fehlerbehandlung
     }
+    clientThread.join();
+    // Für ein erneutes run()
+    wsClient->reset();
+    connected = false;
 }
 
 bool CollaborationManager::isConnected() const {
@@ -88,7 +145,11 @@ void CollaborationManager::createProject(const std::string& name) {
     Project project;
     project.id = generateUniqueId();
     project.name = name;
-    projects[project.id] = project;
+    project.document = std::make_shared<ProjectDocument>(replicaId);
+    {
+        std::lock_guard<std::mutex> lock(documentMutex);
+        projects[project.id] = project;
+    }
     
     CollaborationEvent event;
     event.type = "project_created";
@@ -98,8 +159,14 @@ void CollaborationManager::createProject(const std::string& name) {
 }
 
 void CollaborationManager::joinProject(const std::string& projectId) {
-    auto it = projects.find(projectId);
-    if (it == projects.end()) return;
+    std::lock_guard<std::mutex> lock(documentMutex);
+    
+    // Fremdes Projekt: leeres Dokument, der Inhalt kommt per Synchronisation
+    Project& project = projects[projectId];
+    project.id = projectId;
+    if (!project.document) {
+        project.document = std::make_shared<ProjectDocument>(replicaId);
+    }
     
     currentProjectId = projectId;
     
@@ -108,6 +175,8 @@ void CollaborationManager::joinProject(const std::string& projectId) {
     event.projectId = projectId;
     event.timestamp = std::chrono::system_clock::now();
     broadcastEvent(event);
+    
+    syncProjectData(projectId);
 }
 
 void CollaborationManager::leaveProject(const std::string& projectId) {
@@ -119,6 +188,7 @@ void CollaborationManager::leaveProject(const std::string& projectId) {
     event.timestamp = std::chrono::system_clock::now();
     broadcastEvent(event);
     
+    std::lock_guard<std::mutex> lock(documentMutex);
     currentProjectId.clear();
 }
 
@@ -159,7 +229,10 @@ void CollaborationManager::stopCollaboration(const std::string& projectId) {
 void CollaborationManager::syncProject(const std::string& projectId) {
     if (currentProjectId != projectId) return;
     
-    syncProjectData(projectId);
+    {
+        std::lock_guard<std::mutex> lock(documentMutex);
+        syncProjectData(projectId);
+    }
     
     CollaborationEvent event;
     event.type = "project_synced";
@@ -252,6 +325,12 @@ void CollaborationManager::createVersion(const std::string& projectId, const std
     
     std::string versionId = generateUniqueId();
     it->second.versions.push_back(versionId);
+    {
+        std::lock_guard<std::mutex> lock(documentMutex);
+        if (it->second.document) {
+            it->second.versionVectors[versionId] = it->second.document->getVersion();
+        }
+    }
     
     CollaborationEvent event;
     event.type = "version_created";
@@ -276,10 +355,31 @@ void CollaborationManager::restoreVersion(const std::string& projectId, const st
 void CollaborationManager::compareVersions(const std::string& versionId1, const std::string& versionId2) {
     if (currentProjectId.empty()) return;
     
+    // Versionen sind Versionsvektoren: vorher, nachher, gleich oder
+    // nebenläufig (beide enthalten Änderungen, die der anderen fehlen)
+    std::string relation = "unknown";
+    {
+        std::lock_guard<std::mutex> lock(documentMutex);
+        auto it = projects.find(currentProjectId);
+        if (it != projects.end()) {
+            const auto& vectors = it->second.versionVectors;
+            auto first = vectors.find(versionId1);
+            auto second = vectors.find(versionId2);
+            if (first != vectors.end() && second != vectors.end()) {
+                switch (ProjectDocument::compare(first->second, second->second)) {
+                    case ProjectDocument::Order::Equal: relation = "equal"; break;
+                    case ProjectDocument::Order::Before: relation = "before"; break;
+                    case ProjectDocument::Order::After: relation = "after"; break;
+                    case ProjectDocument::Order::Concurrent: relation = "concurrent"; break;
+                }
+            }
+        }
+    }
+    
     CollaborationEvent event;
     event.type = "versions_compared";
     event.projectId = currentProjectId;
-    event.data = versionId1 + ":" + versionId2;
+    event.data = versionId1 + ":" + versionId2 + ":" + relation;
     event.timestamp = std::chrono::system_clock::now();
     broadcastEvent(event);
 }
@@ -414,9 +514,19 @@ void CollaborationManager::broadcastEvent(const CollaborationEvent& event) {
     Json::FastWriter writer;
     std::string message = writer.write(root);
     
-    if (wsClient) {
-        wsClient->send(message, websocketpp::frame::opcode::text);
+    sendFrame(message.data(), message.size(), websocketpp::frame::opcode::text);
+}
+
+void CollaborationManager::sendFrame(const void* data, size_t size, websocketpp::frame::opcode::value opcode) {
+    if (!wsClient || !connected) return;
+    
+    websocketpp::connection_hdl target;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        target = connection;
     }
+    websocketpp::lib::error_code ec;
+    wsClient->send(target, data, size, opcode, ec);
 }
 
 void CollaborationManager::processEvent(const CollaborationEvent& event) {
@@ -430,15 +540,153 @@ void CollaborationManager::processEvent(const CollaborationEvent& event) {
 
 void CollaborationManager::syncProjectData(const std::string& projectId) {
     auto it = projects.find(projectId);
-    if (it == projects.end()) return;
+    if (it == projects.end() || !it->second.document) return;
     
-    // Projekt-Daten synchronisieren
-    // Hier würde die Implementierung der Daten-Synchronisation folgen
+    // Nur den eigenen Versionsvektor schicken: wer mehr hat, antwortet mit
+    // genau dem, was fehlt. Dient zugleich als Bestätigung für die
+    // Kompaktierung der anderen
+    std::vector<uint8_t> version;
+    ProjectDocument::encodeVersion(it->second.document->getVersion(), version);
+    sendDocumentMessage(kDocumentVersion, projectId, version);
 }
 
 void CollaborationManager::handleVersionConflict(const std::string& projectId) {
-    // Versionskonflikte behandeln
-    // Hier würde die Implementierung der Konfliktbehandlung folgen
+    // Gleichzeitige Änderungen führt das Dokument selbst zusammen. Übrig
+    // bleiben unlesbare Nachrichten: den eigenen Stand neu anfragen
+    syncProjectData(projectId);
+}
+
+void CollaborationManager::editProject(const std::string& projectId,
+                                       const std::function<void(ProjectDocument&)>& edit) {
+    std::lock_guard<std::mutex> lock(documentMutex);
+    auto it = projects.find(projectId);
+    if (it == projects.end() || !it->second.document) return;
+    
+    edit(*it->second.document);
+    publishChanges(projectId, it->second);
+}
+
+void CollaborationManager::readProject(const std::string& projectId,
+                                       const std::function<void(const ProjectDocument&)>& read) const {
+    std::lock_guard<std::mutex> lock(documentMutex);
+    auto it = projects.find(projectId);
+    if (it == projects.end() || !it->second.document) return;
+    
+    read(*it->second.document);
+}
+
+void CollaborationManager::publishChanges(const std::string& projectId, Project& project) {
+    ProjectDocument& document = *project.document;
+    
+    // Nur eigene, noch nicht verschickte Operationen
+    ProjectDocument::VersionVector since = document.getVersion();
+    since[replicaId] = project.publishedSeq;
+    if (!document.hasChangesSince(since)) return;
+    
+    std::vector<uint8_t> changes;
+    document.encodeChanges(since, changes);
+    sendDocumentMessage(kDocumentChanges, projectId, changes);
+    project.publishedSeq = document.getVersion()[replicaId];
+}
+
+void CollaborationManager::sendDocumentMessage(uint8_t kind, const std::string& projectId,
+                                               const std::vector<uint8_t>& body) {
+    if (!connected || projectId.size() > 255) return;
+    
+    std::vector<uint8_t> message;
+    message.reserve(kDocumentHeaderSize + projectId.size() + body.size());
+    message.push_back(kind);
+    for (int i = 0; i < 8; ++i) {
+        message.push_back(static_cast<uint8_t>(replicaId >> (8 * i)));
+    }
+    message.push_back(static_cast<uint8_t>(projectId.size()));
+    message.insert(message.end(), projectId.begin(), projectId.end());
+    message.insert(message.end(), body.begin(), body.end());
+    
+    sendFrame(message.data(), message.size(), websocketpp::frame::opcode::binary);
+}
+
+void CollaborationManager::handleDocumentMessage(const std::string& payload) {
+    const auto* data = reinterpret_cast<const uint8_t*>(payload.data());
+    if (payload.size() < kDocumentHeaderSize) return;
+    
+    const uint8_t kind = data[0];
+    ProjectDocument::ReplicaId sender = 0;
+    for (int i = 7; i >= 0; --i) {
+        sender = (sender << 8) | data[1 + i];
+    }
+    const size_t idLength = data[9];
+    if (sender == replicaId || payload.size() < kDocumentHeaderSize + idLength) return;
+    
+    const std::string projectId(payload, kDocumentHeaderSize, idLength);
+    const uint8_t* body = data + kDocumentHeaderSize + idLength;
+    const size_t bodySize = payload.size() - kDocumentHeaderSize - idLength;
+    
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(documentMutex);
+        auto it = projects.find(projectId);
+        if (it == projects.end() || !it->second.document) return;
+        
+        Project& project = it->second;
+        ProjectDocument& document = *project.document;
+        project.peersSeen[sender] = std::chrono::steady_clock::now();
+        
+        if (kind == kDocumentVersion) {
+            ProjectDocument::VersionVector version;
+            if (!ProjectDocument::decodeVersion(body, bodySize, version)) return;
+            document.setPeerVersion(sender, version);
+            if (document.hasChangesSince(version)) {
+                std::vector<uint8_t> changes;
+                document.encodeChanges(version, changes);
+                sendDocumentMessage(kDocumentChanges, projectId, changes);
+            }
+        } else if (kind == kDocumentChanges) {
+            if (document.applyChanges(body, bodySize)) {
+                changed = true;
+            } else {
+                handleVersionConflict(projectId);
+            }
+        }
+    }
+    
+    if (changed) {
+        CollaborationEvent event;
+        event.type = "project_changed";
+        event.projectId = projectId;
+        event.timestamp = std::chrono::system_clock::now();
+        processEvent(event);
+    }
+}
+
+void CollaborationManager::compactorLoop() {
+    std::unique_lock<std::mutex> lock(documentMutex);
+    while (compactorRunning) {
+        compactorCondition.wait_for(lock, kCompactionInterval, [this] { return !compactorRunning; });
+        if (!compactorRunning) break;
+        
+        const auto now = std::chrono::steady_clock::now();
+        for (auto& [id, project] : projects) {
+            if (!project.document) continue;
+            
+            // Verschwundene Peers halten den Verlauf nicht länger fest;
+            // kommen sie wieder, bekommen sie einen Snapshot
+            for (auto peer = project.peersSeen.begin(); peer != project.peersSeen.end();) {
+                if (now - peer->second > kPeerTimeout) {
+                    project.document->removePeer(peer->first);
+                    peer = project.peersSeen.erase(peer);
+                } else {
+                    ++peer;
+                }
+            }
+            project.document->compact();
+        }
+        
+        // Eigenen Stand verteilen: bestätigt Empfangenes, holt Verpasstes nach
+        if (!currentProjectId.empty()) {
+            syncProjectData(currentProjectId);
+        }
+    }
 }
 
 std::string CollaborationManager::generateUniqueId() {
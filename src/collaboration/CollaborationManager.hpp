@@ -1,11 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <string>
 #include <map>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <websocketpp/client.hpp>
 #include <websocketpp/server.hpp>
+#include "ProjectDocument.hpp"
 
 namespace VR_DAW {
 
@@ -17,7 +24,8 @@ public:
     void initialize();
     void shutdown();
     
-    // Verbindungs-Management
+    // Verbindungs-Management. connect() kehrt sofort zurück, der Client
+    // läuft auf einem eigenen Thread; isConnected() wird mit dem Öffnen wahr
     void connect(const std::string& serverUrl);
     void disconnect();
     bool isConnected() const;
@@ -33,6 +41,12 @@ public:
     void stopCollaboration(const std::string& projectId);
     void syncProject(const std::string& projectId);
     
+    // Projektinhalt (Spuren, Clips, Automation, Plugins, Routing) als CRDT.
+    // edit läuft unter der Dokumentsperre; die dabei entstandenen
+    // Operationen gehen danach binär an alle Teilnehmer
+    void editProject(const std::string& projectId, const std::function<void(ProjectDocument&)>& edit);
+    void readProject(const std::string& projectId, const std::function<void(const ProjectDocument&)>& read) const;
+    
     // Benutzer-Management
     void inviteUser(const std::string& userId);
     void removeUser(const std::string& userId);
@@ -79,13 +93,27 @@ private:
     CollaborationManager& operator=(const CollaborationManager&) = delete;
     
     // Interne Zustandsvariablen
-    bool connected = false;
+    std::atomic<bool> connected{false};
     std::string currentProjectId;
     std::map<std::string, std::vector<EventCallback>> eventCallbacks;
     
     // WebSocket-Komponenten
     std::unique_ptr<websocketpp::client<websocketpp::config::asio>> wsClient;
     std::unique_ptr<websocketpp::server<websocketpp::config::asio>> wsServer;
+    std::thread clientThread;          // wsClient->run() bis zum Verbindungsende
+    bool clientInitialized = false;
+    std::mutex connectionMutex;        // schützt connection
+    websocketpp::connection_hdl connection;
+    
+    // Projektdokumente: eigene Replik, Sperre für Dokumente und projects,
+    // Hintergrund-Kompaktierung
+    static constexpr std::chrono::seconds kCompactionInterval{5};
+    static constexpr std::chrono::seconds kPeerTimeout{60};
+    ProjectDocument::ReplicaId replicaId = 0;
+    mutable std::mutex documentMutex;
+    std::condition_variable compactorCondition;
+    std::thread compactorThread;
+    bool compactorRunning = false;
     
     // Projekt-Daten
     struct Project {
@@ -95,6 +123,11 @@ private:
         std::map<std::string, std::string> userRoles;
         std::map<std::string, std::vector<std::string>> permissions;
         std::vector<std::string> versions;
+        
+        std::shared_ptr<ProjectDocument> document;
+        uint64_t publishedSeq = 0;      // eigene Operationen bis hier verschickt
+        std::map<ProjectDocument::ReplicaId, std::chrono::steady_clock::time_point> peersSeen;
+        std::map<std::string, ProjectDocument::VersionVector> versionVectors;
     };
     
     std::map<std::string, Project> projects;
@@ -104,9 +137,19 @@ private:
     void handleWebSocketConnection(const std::string& connectionId);
     void handleWebSocketDisconnection(const std::string& connectionId);
     void broadcastEvent(const CollaborationEvent& event);
+    // Beliebiger Thread; verwirft ohne offene Verbindung
+    void sendFrame(const void* data, size_t size, websocketpp::frame::opcode::value opcode);
     void processEvent(const CollaborationEvent& event);
+    std::string generateUniqueId();
+    
+    // Dokument-Synchronisation. Bis auf handleDocumentMessage und
+    // compactorLoop setzen alle documentMutex voraus
     void syncProjectData(const std::string& projectId);
     void handleVersionConflict(const std::string& projectId);
+    void handleDocumentMessage(const std::string& payload);
+    void sendDocumentMessage(uint8_t kind, const std::string& projectId, const std::vector<uint8_t>& body);
+    void publishChanges(const std::string& projectId, Project& project);
+    void compactorLoop();
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
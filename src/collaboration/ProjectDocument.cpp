@@ -0,0 +1,865 @@
+#include "ProjectDocument.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace VR_DAW {
+
+namespace {
+
+using ObjectId = ProjectDocument::ObjectId;
+using ObjectType = ProjectDocument::ObjectType;
+using ReplicaId = ProjectDocument::ReplicaId;
+using Key = ProjectDocument::Key;
+using Value = ProjectDocument::Value;
+using VersionVector = ProjectDocument::VersionVector;
+
+// Nachrichten, alle Zahlen als Varint (7 Bit je Byte, little-endian):
+//
+//  Delta:    u8 kDeltaMessage, Replikanzahl, je Replik: Replik,
+//            Operationsanzahl, je Operation: Abstand der Nummer zur
+//            vorigen, Abstand der Lamport-Zeit zur vorigen,
+//            u8 Art | Typ << 2, dann
+//              Create: Ref Elternteil
+//              Set:    Ref Ziel, Key, Wert
+//              Delete: Ref Ziel
+//  Snapshot: u8 kSnapshotMessage, Versionsvektor, Lamport-Uhr,
+//            Objektanzahl, je Objekt: Replik, Zähler,
+//            u8 Flags | Typ << 3, [Replik und Nummer der Löschung],
+//            Registeranzahl, je Register: Key, Lamport-Zeit, Replik, Wert
+//
+//  Ref:  Zähler << 1 | 1, wenn die Replik von der des Kontexts abweicht,
+//        dann die Replik
+//  Wert: u8 Typ, dann Int zigzag, Number 8 Byte IEEE, Text Länge + Bytes,
+//        Ref
+constexpr uint8_t kDeltaMessage = 1;
+constexpr uint8_t kSnapshotMessage = 2;
+
+enum class OpKind : uint8_t {
+    Create = 1,
+    Set = 2,
+    Delete = 3
+};
+
+enum SnapshotFlags : uint8_t {
+    kCreated = 1,
+    kDeleted = 2,
+    kCollected = 4
+};
+
+constexpr uint8_t kLastType = static_cast<uint8_t>(ObjectType::Connection);
+constexpr uint8_t kLastValueType = static_cast<uint8_t>(Value::Type::Ref);
+
+// Zulässige Elternteile. Jeder Typ liegt strikt tiefer als sein
+// Elternteil, der Weg zur Wurzel endet also immer.
+bool acceptsChild(ObjectType parent, ObjectType child) {
+    switch (child) {
+        case ObjectType::Track:
+        case ObjectType::Connection:
+            return parent == ObjectType::Root;
+        case ObjectType::Plugin:
+        case ObjectType::Clip:
+            return parent == ObjectType::Track;
+        case ObjectType::AutomationLane:
+            return parent == ObjectType::Track || parent == ObjectType::Plugin;
+        case ObjectType::AutomationPoint:
+            return parent == ObjectType::AutomationLane;
+        default:
+            return false;
+    }
+}
+
+inline uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+inline int64_t unzigzag(uint64_t v) { return static_cast<int64_t>((v >> 1) ^ (0ull - (v & 1))); }
+
+inline void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+inline void putRef(std::vector<uint8_t>& out, const ObjectId& id, ReplicaId context) {
+    const bool foreign = id.replica != context;
+    putVarint(out, (id.counter << 1) | (foreign ? 1 : 0));
+    if (foreign) putVarint(out, id.replica);
+}
+
+void putValue(std::vector<uint8_t>& out, const Value& value, ReplicaId context) {
+    out.push_back(static_cast<uint8_t>(value.type));
+    switch (value.type) {
+        case Value::Type::Int:
+            putVarint(out, zigzag(value.integer));
+            break;
+        case Value::Type::Number: {
+            uint64_t bits;
+            std::memcpy(&bits, &value.number, sizeof(bits));
+            for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+            break;
+        }
+        case Value::Type::Text:
+            putVarint(out, value.text.size());
+            out.insert(out.end(), value.text.begin(), value.text.end());
+            break;
+        case Value::Type::Ref:
+            putRef(out, value.ref, context);
+            break;
+        default:
+            break;
+    }
+}
+
+// Liest bis zum ersten Fehler; danach bleibt ok false
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    Reader(const uint8_t* data, size_t size) : p(data), end(data + size) {}
+
+    bool atEnd() const { return p == end; }
+
+    uint8_t byte() {
+        if (!ok || p == end) {
+            ok = false;
+            return 0;
+        }
+        return *p++;
+    }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; ok && shift < 64; shift += 7) {
+            if (p == end) break;
+            const uint8_t b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+
+    // Anzahl, die höchstens so groß sein kann wie der Rest der Nachricht
+    size_t count() {
+        const uint64_t v = varint();
+        if (v > static_cast<uint64_t>(end - p)) ok = false;
+        return ok ? static_cast<size_t>(v) : 0;
+    }
+
+    ObjectId ref(ReplicaId context) {
+        ObjectId id;
+        const uint64_t v = varint();
+        id.counter = v >> 1;
+        id.replica = (v & 1) ? varint() : context;
+        return id;
+    }
+
+    Value value(ReplicaId context) {
+        Value value;
+        const uint8_t type = byte();
+        if (type > kLastValueType) {
+            ok = false;
+            return value;
+        }
+        value.type = static_cast<Value::Type>(type);
+        switch (value.type) {
+            case Value::Type::Int:
+                value.integer = unzigzag(varint());
+                break;
+            case Value::Type::Number: {
+                uint64_t bits = 0;
+                for (int i = 0; i < 8; ++i) bits |= static_cast<uint64_t>(byte()) << (8 * i);
+                std::memcpy(&value.number, &bits, sizeof(bits));
+                break;
+            }
+            case Value::Type::Text: {
+                const size_t length = count();
+                if (ok) {
+                    value.text.assign(reinterpret_cast<const char*>(p), length);
+                    p += length;
+                }
+                break;
+            }
+            case Value::Type::Ref:
+                value.ref = ref(context);
+                break;
+            default:
+                break;
+        }
+        return value;
+    }
+
+    ObjectType objectType(uint8_t raw) {
+        if (raw > kLastType) ok = false;
+        return static_cast<ObjectType>(ok ? raw : 0);
+    }
+};
+
+void putVersion(std::vector<uint8_t>& out, const VersionVector& version) {
+    putVarint(out, version.size());
+    for (const auto& [replica, seq] : version) {
+        putVarint(out, replica);
+        putVarint(out, seq);
+    }
+}
+
+void readVersion(Reader& reader, VersionVector& version) {
+    version.clear();
+    const size_t entries = reader.count();
+    for (size_t i = 0; i < entries && reader.ok; ++i) {
+        const ReplicaId replica = reader.varint();
+        const uint64_t seq = reader.varint();
+        if (seq > 0) version[replica] = seq;
+    }
+}
+
+inline uint64_t versionOf(const VersionVector& version, ReplicaId replica) {
+    const auto it = version.find(replica);
+    return it != version.end() ? it->second : 0;
+}
+
+struct ObjectIdHash {
+    size_t operator()(const ObjectId& id) const {
+        return static_cast<size_t>((id.replica * 0x9E3779B97F4A7C15ull) ^ (id.counter + (id.counter << 17)));
+    }
+};
+
+} // namespace
+
+const ProjectDocument::ObjectId ProjectDocument::kRoot{};
+
+ProjectDocument::Value ProjectDocument::Value::fromInt(int64_t v) {
+    Value value;
+    value.type = Type::Int;
+    value.integer = v;
+    return value;
+}
+
+ProjectDocument::Value ProjectDocument::Value::fromNumber(double v) {
+    Value value;
+    value.type = Type::Number;
+    value.number = v;
+    return value;
+}
+
+ProjectDocument::Value ProjectDocument::Value::fromText(const std::string& v) {
+    Value value;
+    value.type = Type::Text;
+    value.text = v;
+    return value;
+}
+
+ProjectDocument::Value ProjectDocument::Value::fromRef(const ObjectId& v) {
+    Value value;
+    value.type = Type::Ref;
+    value.ref = v;
+    return value;
+}
+
+bool ProjectDocument::Value::operator==(const Value& other) const {
+    if (type != other.type) return false;
+    switch (type) {
+        case Type::Int: return integer == other.integer;
+        // Bitweise, damit auch NaN mit sich selbst gleich ist
+        case Type::Number: return std::memcmp(&number, &other.number, sizeof(number)) == 0;
+        case Type::Text: return text == other.text;
+        case Type::Ref: return ref == other.ref;
+        default: return true;
+    }
+}
+
+struct ProjectDocument::Impl {
+    struct Stamp {
+        uint64_t lamport = 0;
+        ReplicaId replica = 0;
+
+        bool newerThan(const Stamp& other) const {
+            return lamport != other.lamport ? lamport > other.lamport : replica > other.replica;
+        }
+    };
+
+    struct Register {
+        Key key = 0;
+        Stamp stamp;
+        Value value;
+    };
+
+    struct Object {
+        ObjectType type = ObjectType::Root;
+        bool created = false;
+        bool deleted = false;
+        bool collected = false;
+        bool linked = false;            // steht in children[parent]
+        ObjectId parent;                // Wert des gewinnenden kParent-Registers
+        ReplicaId deletedBy = 0;
+        uint64_t deletedSeq = 0;
+        std::vector<Register> registers;    // nach key sortiert
+    };
+
+    struct Operation {
+        OpKind kind = OpKind::Set;
+        ObjectType type = ObjectType::Root;
+        uint64_t seq = 0;
+        uint64_t lamport = 0;
+        ObjectId target;                // Create: Elternteil
+        Key key = 0;
+        Value value;
+    };
+
+    struct ReplicaLog {
+        uint64_t contiguous = 0;        // alle Operationen bis hier angewendet
+        uint64_t compacted = 0;         // bis hier nicht mehr im Verlauf
+        std::map<uint64_t, Operation> operations;
+    };
+
+    ReplicaId replica;
+    uint64_t clock = 0;
+    std::unordered_map<ObjectId, Object, ObjectIdHash> objects;
+    std::unordered_map<ObjectId, std::vector<ObjectId>, ObjectIdHash> children;
+    std::map<ReplicaId, ReplicaLog> logs;
+    std::map<ReplicaId, VersionVector> peers;
+    Stats stats;
+
+    // Dekodierte Nachrichten, bleiben für die nächste erhalten
+    std::vector<std::pair<ReplicaId, Operation>> incoming;
+    struct SnapshotObject {
+        ObjectId id;
+        Object object;
+    };
+    std::vector<SnapshotObject> incomingObjects;
+
+    explicit Impl(ReplicaId id) : replica(id) {}
+
+    const Object* find(const ObjectId& id) const {
+        const auto it = objects.find(id);
+        return it != objects.end() ? &it->second : nullptr;
+    }
+
+    bool live(const ObjectId& id) const {
+        ObjectId current = id;
+        while (true) {
+            const Object* object = find(current);
+            if (!object || !object->created || object->deleted || object->collected) return false;
+            if (object->parent == kRoot) return acceptsChild(ObjectType::Root, object->type);
+            const Object* parent = find(object->parent);
+            if (!parent || !acceptsChild(parent->type, object->type)) return false;
+            current = object->parent;
+        }
+    }
+
+    // Darf id (Typ type) unter parent hängen?
+    bool validParent(const ObjectId& parent, ObjectType type) const {
+        if (parent == kRoot) return acceptsChild(ObjectType::Root, type);
+        return live(parent) && acceptsChild(find(parent)->type, type);
+    }
+
+    void unlink(const ObjectId& id, Object& object) {
+        if (!object.linked) return;
+        auto it = children.find(object.parent);
+        if (it != children.end()) {
+            auto& list = it->second;
+            list.erase(std::remove(list.begin(), list.end(), id), list.end());
+            if (list.empty()) children.erase(it);
+        }
+        object.linked = false;
+    }
+
+    void mergeRegister(const ObjectId& id, Object& object, Key key, const Stamp& stamp, const Value& value) {
+        if (object.collected) return;
+        auto it = std::lower_bound(object.registers.begin(), object.registers.end(), key,
+                                   [](const Register& r, Key k) { return r.key < k; });
+        if (it != object.registers.end() && it->key == key) {
+            if (!stamp.newerThan(it->stamp)) return;
+            it->stamp = stamp;
+            it->value = value;
+        } else {
+            object.registers.insert(it, Register{key, stamp, value});
+        }
+
+        if (key == kParent) {
+            const ObjectId parent = value.type == Value::Type::Ref ? value.ref : kRoot;
+            if (object.linked && parent == object.parent) return;
+            unlink(id, object);
+            object.parent = parent;
+            children[parent].push_back(id);
+            object.linked = true;
+        }
+    }
+
+    void collect(const ObjectId& id, Object& object) {
+        unlink(id, object);
+        object.registers.clear();
+        object.registers.shrink_to_fit();
+        object.collected = true;
+        object.deleted = true;
+    }
+
+    void apply(ReplicaId author, const Operation& op) {
+        const Stamp stamp{op.lamport, author};
+        switch (op.kind) {
+            case OpKind::Create: {
+                const ObjectId id{author, op.seq};
+                Object& object = objects[id];
+                if (object.created) break;
+                object.created = true;
+                object.type = op.type;
+                mergeRegister(id, object, kParent, stamp, Value::fromRef(op.target));
+                break;
+            }
+            case OpKind::Set:
+                mergeRegister(op.target, objects[op.target], op.key, stamp, op.value);
+                break;
+            case OpKind::Delete: {
+                Object& object = objects[op.target];
+                if (!object.deleted) {
+                    object.deleted = true;
+                    object.deletedBy = author;
+                    object.deletedSeq = op.seq;
+                }
+                break;
+            }
+        }
+        clock = std::max(clock, op.lamport);
+    }
+
+    static void advance(ReplicaLog& log) {
+        auto it = log.operations.upper_bound(log.contiguous);
+        while (it != log.operations.end() && it->first == log.contiguous + 1) {
+            ++log.contiguous;
+            ++it;
+        }
+    }
+
+    void receive(ReplicaId author, Operation&& op) {
+        ReplicaLog& log = logs[author];
+        if (op.seq <= log.contiguous || log.operations.count(op.seq)) {
+            ++stats.duplicateOperations;
+            return;
+        }
+        apply(author, op);
+        const uint64_t seq = op.seq;
+        log.operations.emplace(seq, std::move(op));
+        advance(log);
+        ++stats.appliedOperations;
+    }
+
+    void local(Operation&& op) {
+        op.seq = logs[replica].contiguous + 1;
+        op.lamport = clock + 1;
+        receive(replica, std::move(op));
+    }
+
+    bool needsSnapshot(const VersionVector& since) const {
+        for (const auto& [author, log] : logs) {
+            if (log.compacted > versionOf(since, author)) return true;
+        }
+        return false;
+    }
+
+    void encodeDelta(const VersionVector& since, std::vector<uint8_t>& out) const {
+        size_t replicas = 0;
+        for (const auto& [author, log] : logs) {
+            if (log.operations.upper_bound(versionOf(since, author)) != log.operations.end()) ++replicas;
+        }
+        out.push_back(kDeltaMessage);
+        putVarint(out, replicas);
+
+        for (const auto& [author, log] : logs) {
+            auto it = log.operations.upper_bound(versionOf(since, author));
+            if (it == log.operations.end()) continue;
+            putVarint(out, author);
+            putVarint(out, static_cast<uint64_t>(std::distance(it, log.operations.end())));
+
+            uint64_t previousSeq = 0, previousLamport = 0;
+            for (; it != log.operations.end(); ++it) {
+                const Operation& op = it->second;
+                putVarint(out, op.seq - previousSeq);
+                putVarint(out, op.lamport - previousLamport);
+                previousSeq = op.seq;
+                previousLamport = op.lamport;
+
+                out.push_back(static_cast<uint8_t>(static_cast<uint8_t>(op.kind)
+                                                   | (static_cast<uint8_t>(op.type) << 2)));
+                putRef(out, op.target, author);
+                if (op.kind == OpKind::Set) {
+                    putVarint(out, op.key);
+                    putValue(out, op.value, author);
+                }
+            }
+        }
+    }
+
+    void encodeSnapshot(std::vector<uint8_t>& out) const {
+        VersionVector version;
+        for (const auto& [author, log] : logs) {
+            if (log.contiguous > 0) version[author] = log.contiguous;
+        }
+        out.push_back(kSnapshotMessage);
+        putVersion(out, version);
+        putVarint(out, clock);
+        putVarint(out, objects.size());
+
+        for (const auto& [id, object] : objects) {
+            putVarint(out, id.replica);
+            putVarint(out, id.counter);
+            uint8_t flags = 0;
+            if (object.created) flags |= kCreated;
+            if (object.deleted) flags |= kDeleted;
+            if (object.collected) flags |= kCollected;
+            out.push_back(static_cast<uint8_t>(flags | (static_cast<uint8_t>(object.type) << 3)));
+            if (object.deleted) {
+                putVarint(out, object.deletedBy);
+                putVarint(out, object.deletedSeq);
+            }
+            putVarint(out, object.registers.size());
+            for (const Register& r : object.registers) {
+                putVarint(out, r.key);
+                putVarint(out, r.stamp.lamport);
+                putVarint(out, r.stamp.replica);
+                putValue(out, r.value, id.replica);
+            }
+        }
+    }
+
+    bool decodeDelta(Reader& reader) {
+        incoming.clear();
+        const size_t replicas = reader.count();
+        for (size_t r = 0; r < replicas && reader.ok; ++r) {
+            const ReplicaId author = reader.varint();
+            const size_t count = reader.count();
+            uint64_t seq = 0, lamport = 0;
+            for (size_t i = 0; i < count && reader.ok; ++i) {
+                Operation op;
+                const uint64_t seqStep = reader.varint();
+                if (seqStep == 0 || seqStep > ~seq) return false;
+                seq += seqStep;
+                lamport += reader.varint();
+                op.seq = seq;
+                op.lamport = lamport;
+
+                const uint8_t head = reader.byte();
+                const uint8_t kind = head & 3;
+                if (kind < static_cast<uint8_t>(OpKind::Create) || kind > static_cast<uint8_t>(OpKind::Delete)) {
+                    return false;
+                }
+                op.kind = static_cast<OpKind>(kind);
+                op.type = reader.objectType(head >> 2);
+                if (op.kind == OpKind::Create && op.type == ObjectType::Root) return false;
+                op.target = reader.ref(author);
+                if (op.kind == OpKind::Set) {
+                    const uint64_t key = reader.varint();
+                    if (key > 0xffffffffull) return false;
+                    op.key = static_cast<Key>(key);
+                    op.value = reader.value(author);
+                }
+                incoming.emplace_back(author, std::move(op));
+            }
+        }
+        return reader.ok && reader.atEnd();
+    }
+
+    bool decodeSnapshot(Reader& reader, VersionVector& version, uint64_t& snapshotClock) {
+        incomingObjects.clear();
+        readVersion(reader, version);
+        snapshotClock = reader.varint();
+        const size_t count = reader.count();
+        for (size_t i = 0; i < count && reader.ok; ++i) {
+            SnapshotObject entry;
+            entry.id.replica = reader.varint();
+            entry.id.counter = reader.varint();
+            const uint8_t head = reader.byte();
+            Object& object = entry.object;
+            object.type = reader.objectType(head >> 3);
+            object.created = (head & kCreated) != 0;
+            object.deleted = (head & kDeleted) != 0;
+            object.collected = (head & kCollected) != 0;
+            if (object.deleted) {
+                object.deletedBy = reader.varint();
+                object.deletedSeq = reader.varint();
+            }
+            const size_t registers = reader.count();
+            Key previous = 0;
+            for (size_t j = 0; j < registers && reader.ok; ++j) {
+                Register r;
+                const uint64_t key = reader.varint();
+                if (key > 0xffffffffull || (j > 0 && key <= previous)) return false;
+                r.key = previous = static_cast<Key>(key);
+                r.stamp.lamport = reader.varint();
+                r.stamp.replica = reader.varint();
+                r.value = reader.value(entry.id.replica);
+                object.registers.push_back(std::move(r));
+            }
+            incomingObjects.push_back(std::move(entry));
+        }
+        return reader.ok && reader.atEnd();
+    }
+
+    void mergeSnapshot(const VersionVector& version, uint64_t snapshotClock) {
+        for (SnapshotObject& entry : incomingObjects) {
+            Object& object = objects[entry.id];
+            if (entry.object.created && !object.created) {
+                object.created = true;
+                object.type = entry.object.type;
+            }
+            if (entry.object.deleted && !object.deleted) {
+                object.deleted = true;
+                object.deletedBy = entry.object.deletedBy;
+                object.deletedSeq = entry.object.deletedSeq;
+            }
+            for (const Register& r : entry.object.registers) {
+                mergeRegister(entry.id, object, r.key, r.stamp, r.value);
+            }
+            if (entry.object.collected && !object.collected) collect(entry.id, object);
+        }
+        // Der Snapshot enthält alle Operationen bis version; der eigene
+        // Verlauf hat sie nicht und muss Nachzüglern ebenfalls einen
+        // Snapshot schicken
+        for (const auto& [author, seq] : version) {
+            ReplicaLog& log = logs[author];
+            log.contiguous = std::max(log.contiguous, seq);
+            log.compacted = std::max(log.compacted, seq);
+            advance(log);
+        }
+        clock = std::max(clock, snapshotClock);
+    }
+};
+
+ProjectDocument::Order ProjectDocument::compare(const VersionVector& a, const VersionVector& b) {
+    bool less = false, greater = false;
+    auto ia = a.begin();
+    auto ib = b.begin();
+    while (ia != a.end() || ib != b.end()) {
+        uint64_t va = 0, vb = 0;
+        if (ib == b.end() || (ia != a.end() && ia->first < ib->first)) {
+            va = (ia++)->second;
+        } else if (ia == a.end() || ib->first < ia->first) {
+            vb = (ib++)->second;
+        } else {
+            va = (ia++)->second;
+            vb = (ib++)->second;
+        }
+        less |= va < vb;
+        greater |= va > vb;
+    }
+    if (less && greater) return Order::Concurrent;
+    if (less) return Order::Before;
+    if (greater) return Order::After;
+    return Order::Equal;
+}
+
+void ProjectDocument::encodeVersion(const VersionVector& version, std::vector<uint8_t>& out) {
+    putVersion(out, version);
+}
+
+bool ProjectDocument::decodeVersion(const uint8_t* data, size_t size, VersionVector& version) {
+    Reader reader(data, size);
+    readVersion(reader, version);
+    return reader.ok && reader.atEnd();
+}
+
+ProjectDocument::ProjectDocument(ReplicaId replica) : pImpl(std::make_unique<Impl>(replica)) {}
+
+ProjectDocument::~ProjectDocument() = default;
+
+ProjectDocument::ReplicaId ProjectDocument::getReplica() const {
+    return pImpl->replica;
+}
+
+ProjectDocument::ObjectId ProjectDocument::createObject(ObjectType type, const ObjectId& parent) {
+    if (type == ObjectType::Root || !pImpl->validParent(parent, type)) return kRoot;
+    Impl::Operation op;
+    op.kind = OpKind::Create;
+    op.type = type;
+    op.target = parent;
+    pImpl->local(std::move(op));
+    return ObjectId{pImpl->replica, pImpl->logs[pImpl->replica].contiguous};
+}
+
+bool ProjectDocument::set(const ObjectId& id, Key key, const Value& value) {
+    if (!pImpl->live(id)) return false;
+    const Impl::Object& object = *pImpl->find(id);
+    if (key == kParent) {
+        if (value.type != Value::Type::Ref || value.ref == id || !pImpl->validParent(value.ref, object.type)) {
+            return false;
+        }
+    }
+    // Unveränderte Werte kosten keine Operation
+    if (get(id, key) == value) return true;
+
+    Impl::Operation op;
+    op.kind = OpKind::Set;
+    op.target = id;
+    op.key = key;
+    op.value = value;
+    pImpl->local(std::move(op));
+    return true;
+}
+
+bool ProjectDocument::remove(const ObjectId& id) {
+    if (!pImpl->live(id)) return false;
+    Impl::Operation op;
+    op.kind = OpKind::Delete;
+    op.target = id;
+    pImpl->local(std::move(op));
+    return true;
+}
+
+bool ProjectDocument::exists(const ObjectId& id) const {
+    return pImpl->live(id);
+}
+
+ProjectDocument::ObjectType ProjectDocument::getType(const ObjectId& id) const {
+    if (id == kRoot) return ObjectType::Root;
+    const Impl::Object* object = pImpl->find(id);
+    return object ? object->type : ObjectType::Root;
+}
+
+ProjectDocument::ObjectId ProjectDocument::getParent(const ObjectId& id) const {
+    const Impl::Object* object = pImpl->find(id);
+    return object ? object->parent : kRoot;
+}
+
+ProjectDocument::Value ProjectDocument::get(const ObjectId& id, Key key) const {
+    const Impl::Object* object = pImpl->find(id);
+    if (!object) return Value();
+    auto it = std::lower_bound(object->registers.begin(), object->registers.end(), key,
+                               [](const Impl::Register& r, Key k) { return r.key < k; });
+    return it != object->registers.end() && it->key == key ? it->value : Value();
+}
+
+std::vector<ProjectDocument::ObjectId> ProjectDocument::getChildren(const ObjectId& parent, ObjectType type) const {
+    std::vector<ObjectId> result;
+    if (parent != kRoot && !pImpl->live(parent)) return result;
+    const auto it = pImpl->children.find(parent);
+    if (it == pImpl->children.end()) return result;
+
+    if (!acceptsChild(getType(parent), type)) return result;
+
+    std::vector<std::pair<double, ObjectId>> ordered;
+    for (const ObjectId& child : it->second) {
+        const Impl::Object* object = pImpl->find(child);
+        if (object->type != type || !object->created || object->deleted) continue;
+        const Value order = get(child, kOrder);
+        ordered.emplace_back(order.type == Value::Type::Number ? order.number : 0.0, child);
+    }
+    std::sort(ordered.begin(), ordered.end());
+    result.reserve(ordered.size());
+    for (const auto& entry : ordered) result.push_back(entry.second);
+    return result;
+}
+
+ProjectDocument::VersionVector ProjectDocument::getVersion() const {
+    VersionVector version;
+    for (const auto& [author, log] : pImpl->logs) {
+        if (log.contiguous > 0) version[author] = log.contiguous;
+    }
+    return version;
+}
+
+bool ProjectDocument::hasChangesSince(const VersionVector& since) const {
+    for (const auto& [author, log] : pImpl->logs) {
+        const uint64_t seen = versionOf(since, author);
+        if (log.compacted > seen || log.operations.upper_bound(seen) != log.operations.end()) return true;
+    }
+    return false;
+}
+
+size_t ProjectDocument::encodeChanges(const VersionVector& since, std::vector<uint8_t>& out) {
+    const size_t start = out.size();
+    if (pImpl->needsSnapshot(since)) {
+        pImpl->encodeSnapshot(out);
+        ++pImpl->stats.snapshotsEncoded;
+    } else {
+        pImpl->encodeDelta(since, out);
+        ++pImpl->stats.deltasEncoded;
+    }
+    pImpl->stats.bytesEncoded += out.size() - start;
+    return out.size() - start;
+}
+
+bool ProjectDocument::applyChanges(const uint8_t* data, size_t size) {
+    Reader reader(data, size);
+    const uint8_t kind = reader.byte();
+
+    if (kind == kDeltaMessage) {
+        if (!pImpl->decodeDelta(reader)) {
+            ++pImpl->stats.rejectedMessages;
+            return false;
+        }
+        for (auto& [author, op] : pImpl->incoming) pImpl->receive(author, std::move(op));
+        return true;
+    }
+    if (kind == kSnapshotMessage) {
+        VersionVector version;
+        uint64_t snapshotClock = 0;
+        if (!pImpl->decodeSnapshot(reader, version, snapshotClock)) {
+            ++pImpl->stats.rejectedMessages;
+            return false;
+        }
+        pImpl->mergeSnapshot(version, snapshotClock);
+        return true;
+    }
+    ++pImpl->stats.rejectedMessages;
+    return false;
+}
+
+void ProjectDocument::setPeerVersion(ReplicaId peer, const VersionVector& version) {
+    if (peer == pImpl->replica) return;
+    VersionVector& known = pImpl->peers[peer];
+    for (const auto& [author, seq] : version) {
+        uint64_t& entry = known[author];
+        entry = std::max(entry, seq);
+    }
+}
+
+void ProjectDocument::removePeer(ReplicaId peer) {
+    pImpl->peers.erase(peer);
+}
+
+size_t ProjectDocument::compact() {
+    // Stabil ist, was jeder bekannte Peer schon hat
+    VersionVector horizon;
+    size_t removed = 0;
+    for (auto& [author, log] : pImpl->logs) {
+        uint64_t stable = log.contiguous;
+        for (const auto& [peer, version] : pImpl->peers) {
+            stable = std::min(stable, versionOf(version, author));
+        }
+        horizon[author] = stable;
+        if (stable <= log.compacted) continue;
+
+        const auto end = log.operations.upper_bound(stable);
+        removed += static_cast<size_t>(std::distance(log.operations.begin(), end));
+        log.operations.erase(log.operations.begin(), end);
+        log.compacted = stable;
+    }
+
+    // Stabil gelöschte Objekte brauchen keine Register mehr: jede spätere
+    // Änderung daran verliert ohnehin. Ihre Kinder bleiben, eine
+    // gleichzeitige Verschiebung kann sie noch an einen anderen Ort retten
+    for (auto& [id, object] : pImpl->objects) {
+        if (object.deleted && !object.collected && object.deletedSeq <= versionOf(horizon, object.deletedBy)) {
+            pImpl->collect(id, object);
+        }
+    }
+
+    pImpl->stats.compactedOperations += removed;
+    return removed;
+}
+
+ProjectDocument::Stats ProjectDocument::getStats() const {
+    Stats stats = pImpl->stats;
+    stats.objects = pImpl->objects.size();
+    stats.tombstones = 0;
+    stats.collected = 0;
+    for (const auto& [id, object] : pImpl->objects) {
+        if (object.deleted) ++stats.tombstones;
+        if (object.collected) ++stats.collected;
+    }
+    stats.loggedOperations = 0;
+    for (const auto& [author, log] : pImpl->logs) stats.loggedOperations += log.operations.size();
+    return stats;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VR_DAW {
+
+// Projektmodell (Spuren, Clips, Automation, Plugin-Parameter, Routing) als
+// CRDT. Jeder Teilnehmer hält eine Kopie und ändert sie lokal ohne
+// Rückfrage; die Kopien laufen zusammen, sobald jeder alle Operationen
+// gesehen hat, egal in welcher Reihenfolge und wie oft.
+//
+// Datenmodell: ein Baum typisierter Objekte unter kRoot. Jedes Objekt ist
+// eine Abbildung Key -> Wert aus Last-Writer-Wins-Registern, geordnet nach
+// (Lamport-Zeit, Replik). Der Elternverweis ist selbst ein Register
+// (kParent), Verschieben eines Clips auf eine andere Spur ist also ein
+// einfaches set(). Löschen gewinnt gegen gleichzeitiges Ändern. Welche
+// Typen unter welchen liegen dürfen, ist fest vorgegeben; dadurch können
+// auch gleichzeitige Verschiebungen keine Zyklen bilden. Die Reihenfolge
+// von Geschwistern kommt aus kOrder (Gleitkomma, zum Einfügen dazwischen
+// den Mittelwert nehmen), bei Gleichstand aus der ID.
+//
+// Synchronisation: Operationen tragen je Replik fortlaufende Nummern, der
+// Stand einer Kopie ist ihr Versionsvektor. Ein Peer schickt seinen Vektor,
+// die Gegenseite antwortet mit genau den fehlenden Operationen
+// (encodeChanges), binär mit Varints. Ein Wiederverbinden kostet damit so
+// viel wie die verpassten Änderungen, nicht so viel wie das Projekt.
+//
+// Kompaktierung: Operationen, die alle bekannten Peers bestätigt haben
+// (setPeerVersion), fliegen mit compact() aus dem Verlauf; stabil gelöschte
+// Objekte verlieren dabei ihre Register. Wer hinter diesem Stand liegt,
+// bekommt statt der Operationen einen Snapshot des Zustands.
+//
+// Nicht thread-sicher.
+class ProjectDocument {
+public:
+    using ReplicaId = uint64_t;
+    using Key = uint32_t;
+    // Replik -> höchste lückenlos bekannte Operationsnummer
+    using VersionVector = std::map<ReplicaId, uint64_t>;
+
+    struct ObjectId {
+        ReplicaId replica = 0;
+        uint64_t counter = 0;      // Nummer der erzeugenden Operation
+
+        bool operator==(const ObjectId& other) const { return replica == other.replica && counter == other.counter; }
+        bool operator!=(const ObjectId& other) const { return !(*this == other); }
+        bool operator<(const ObjectId& other) const {
+            return replica != other.replica ? replica < other.replica : counter < other.counter;
+        }
+    };
+    static const ObjectId kRoot;    // {0, 0}
+
+    enum class ObjectType : uint8_t {
+        Root = 0,
+        Track,              // unter Root
+        Plugin,             // unter Track
+        Clip,               // unter Track
+        AutomationLane,     // unter Track oder Plugin
+        AutomationPoint,    // unter AutomationLane
+        Connection          // unter Root, kSource/kTarget verweisen auf Spuren
+    };
+
+    enum Property : Key {
+        kParent = 0,
+        kName,
+        kOrder,
+        kColor,
+        kGain,
+        kPan,
+        kMute,
+        kSolo,
+        kStart,
+        kLength,
+        kOffset,
+        kSample,
+        kTime,
+        kValue,
+        kCurve,
+        kPluginId,
+        kBypass,
+        kParameter,         // Parameterindex einer AutomationLane
+        kSource,
+        kTarget,
+        kParameterBase = 1024   // Plugin-Parameter i: kParameterBase + i
+    };
+
+    struct Value {
+        enum class Type : uint8_t {
+            Null = 0,
+            Int,
+            Number,
+            Text,
+            Ref
+        };
+
+        Type type = Type::Null;
+        int64_t integer = 0;
+        double number = 0.0;
+        std::string text;
+        ObjectId ref;
+
+        static Value fromInt(int64_t v);
+        static Value fromNumber(double v);
+        static Value fromText(const std::string& v);
+        static Value fromRef(const ObjectId& v);
+        bool operator==(const Value& other) const;
+        bool operator!=(const Value& other) const { return !(*this == other); }
+    };
+
+    enum class Order {
+        Equal,
+        Before,
+        After,
+        Concurrent
+    };
+
+    struct Stats {
+        size_t objects = 0;             // inklusive gelöschter
+        size_t tombstones = 0;
+        size_t collected = 0;           // gelöscht und ohne Register
+        size_t loggedOperations = 0;    // noch nicht kompaktiert
+        uint64_t compactedOperations = 0;
+        uint64_t appliedOperations = 0;
+        uint64_t duplicateOperations = 0;
+        uint64_t deltasEncoded = 0;
+        uint64_t snapshotsEncoded = 0;
+        uint64_t bytesEncoded = 0;
+        uint64_t rejectedMessages = 0;
+    };
+
+    static Order compare(const VersionVector& a, const VersionVector& b);
+    static void encodeVersion(const VersionVector& version, std::vector<uint8_t>& out);
+    static bool decodeVersion(const uint8_t* data, size_t size, VersionVector& version);
+
+    // replica: eindeutig je Teilnehmer und Sitzung, nicht 0
+    explicit ProjectDocument(ReplicaId replica);
+    ~ProjectDocument();
+
+    ProjectDocument(const ProjectDocument&) = delete;
+    ProjectDocument& operator=(const ProjectDocument&) = delete;
+
+    ReplicaId getReplica() const;
+
+    // --- Lokale Änderungen ---
+    // Liefert kRoot, wenn parent nicht existiert oder den Typ nicht aufnimmt
+    ObjectId createObject(ObjectType type, const ObjectId& parent = kRoot);
+    // false bei unbekanntem Objekt oder unzulässigem neuen Elternteil
+    bool set(const ObjectId& id, Key key, const Value& value);
+    bool remove(const ObjectId& id);
+
+    // --- Lesen ---
+    // Existiert, ist nicht gelöscht und hängt an einem existierenden Elternteil
+    bool exists(const ObjectId& id) const;
+    ObjectType getType(const ObjectId& id) const;
+    ObjectId getParent(const ObjectId& id) const;
+    // Type::Null, wenn nicht gesetzt
+    Value get(const ObjectId& id, Key key) const;
+    // Existierende Kinder eines Typs, nach kOrder und ID sortiert
+    std::vector<ObjectId> getChildren(const ObjectId& parent, ObjectType type) const;
+
+    // --- Synchronisation ---
+    VersionVector getVersion() const;
+    bool hasChangesSince(const VersionVector& since) const;
+    // Hängt die Operationen seit since an out an, oder einen Snapshot, wenn
+    // since hinter dem kompaktierten Stand liegt. Liefert die Byteanzahl
+    size_t encodeChanges(const VersionVector& since, std::vector<uint8_t>& out);
+    // false bei kaputter Nachricht; dann wurde nichts übernommen
+    bool applyChanges(const uint8_t* data, size_t size);
+
+    // --- Kompaktierung ---
+    void setPeerVersion(ReplicaId peer, const VersionVector& version);
+    void removePeer(ReplicaId peer);
+    // Verwirft den von allen Peers bestätigten Verlauf, liefert die Zahl
+    // der entfernten Operationen
+    size_t compact();
+
+    Stats getStats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
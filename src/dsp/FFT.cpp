@@ -0,0 +1,191 @@
+#include "FFT.hpp"
+#include "kernels/DSPKernels.hpp"
+#include "kernels/Lanes.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+// Lanes werden nur zwischen geinlineten Funktionen übergeben
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VRDAW_SPECTRAL_AVX2 1
+#endif
+
+namespace VR_DAW {
+namespace dsp {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+bool isPowerOfTwo(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+VRDAW_LANES_INLINE void complexMultiplyAccumulateBody(float* accRe, float* accIm,
+                                                      const float* aRe, const float* aIm,
+                                                      const float* bRe, const float* bIm,
+                                                      size_t numBins, float gain) {
+    size_t i = 0;
+    for (; i + kLaneWidth <= numBins; i += kLaneWidth) {
+        const Lanes ar = loadLanes(aRe + i) * gain, ai = loadLanes(aIm + i) * gain;
+        const Lanes br = loadLanes(bRe + i), bi = loadLanes(bIm + i);
+        storeLanes(accRe + i, loadLanes(accRe + i) + ar * br - ai * bi);
+        storeLanes(accIm + i, loadLanes(accIm + i) + ar * bi + ai * br);
+    }
+    for (; i < numBins; ++i) {
+        const float ar = aRe[i] * gain, ai = aIm[i] * gain;
+        accRe[i] += ar * bRe[i] - ai * bIm[i];
+        accIm[i] += ar * bIm[i] + ai * bRe[i];
+    }
+}
+
+using ComplexMultiplyAccumulate = void (*)(float*, float*, const float*, const float*,
+                                           const float*, const float*, size_t, float);
+
+void complexMultiplyAccumulatePortable(float* accRe, float* accIm, const float* aRe, const float* aIm,
+                                       const float* bRe, const float* bIm, size_t numBins, float gain) {
+    complexMultiplyAccumulateBody(accRe, accIm, aRe, aIm, bRe, bIm, numBins, gain);
+}
+
+#ifdef VRDAW_SPECTRAL_AVX2
+__attribute__((target("avx2,fma")))
+void complexMultiplyAccumulateAVX2(float* accRe, float* accIm, const float* aRe, const float* aIm,
+                                   const float* bRe, const float* bIm, size_t numBins, float gain) {
+    complexMultiplyAccumulateBody(accRe, accIm, aRe, aIm, bRe, bIm, numBins, gain);
+}
+#endif
+
+ComplexMultiplyAccumulate selectMultiplyAccumulate() {
+#ifdef VRDAW_SPECTRAL_AVX2
+    if (getKernels().variant >= KernelVariant::AVX2) {
+        return complexMultiplyAccumulateAVX2;
+    }
+#endif
+    return complexMultiplyAccumulatePortable;
+}
+
+} // namespace
+
+void complexMultiplyAccumulate(float* accRe, float* accIm, const float* aRe, const float* aIm,
+                               const float* bRe, const float* bIm, size_t numBins, float gain) {
+    // Auswahl einmalig, danach nur noch ein indirekter Aufruf
+    static const ComplexMultiplyAccumulate kernel = selectMultiplyAccumulate();
+    kernel(accRe, accIm, aRe, aIm, bRe, bIm, numBins, gain);
+}
+
+RealFFT::RealFFT(size_t size)
+    : size(size)
+    , half(size / 2)
+{
+    if (size < 4 || !isPowerOfTwo(size)) {
+        throw std::invalid_argument("FFT-Größe muss eine Zweierpotenz >= 4 sein");
+    }
+
+    size_t bits = 0;
+    while ((size_t{1} << bits) < half) ++bits;
+    bitReverse.resize(half);
+    for (size_t i = 0; i < half; ++i) {
+        size_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            if (i & (size_t{1} << b)) reversed |= size_t{1} << (bits - 1 - b);
+        }
+        bitReverse[i] = reversed;
+    }
+
+    twiddleRe.resize(half / 2);
+    twiddleIm.resize(half / 2);
+    for (size_t k = 0; k < half / 2; ++k) {
+        const double angle = -2.0 * kPi * static_cast<double>(k) / static_cast<double>(half);
+        twiddleRe[k] = static_cast<float>(std::cos(angle));
+        twiddleIm[k] = static_cast<float>(std::sin(angle));
+    }
+
+    splitRe.resize(half + 1);
+    splitIm.resize(half + 1);
+    for (size_t k = 0; k <= half; ++k) {
+        const double angle = -2.0 * kPi * static_cast<double>(k) / static_cast<double>(size);
+        splitRe[k] = static_cast<float>(std::cos(angle));
+        splitIm[k] = static_cast<float>(std::sin(angle));
+    }
+
+    workRe.resize(half);
+    workIm.resize(half);
+}
+
+void RealFFT::transform(float* re, float* im, bool inverse) const {
+    for (size_t i = 0; i < half; ++i) {
+        const size_t j = bitReverse[i];
+        if (j > i) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    const float sign = inverse ? -1.0f : 1.0f;
+    for (size_t length = 2; length <= half; length <<= 1) {
+        const size_t halfLength = length / 2;
+        const size_t stride = half / length;
+        for (size_t start = 0; start < half; start += length) {
+            for (size_t k = 0; k < halfLength; ++k) {
+                const float wr = twiddleRe[k * stride];
+                const float wi = sign * twiddleIm[k * stride];
+                const size_t a = start + k;
+                const size_t b = a + halfLength;
+                const float tr = re[b] * wr - im[b] * wi;
+                const float ti = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+void RealFFT::forward(const float* input, float* re, float* im) {
+    // Gerade Samples als Real-, ungerade als Imaginärteil
+    for (size_t n = 0; n < half; ++n) {
+        workRe[n] = input[2 * n];
+        workIm[n] = input[2 * n + 1];
+    }
+    transform(workRe.data(), workIm.data(), false);
+
+    // X[k] = E[k] + W^k O[k] mit E, O aus Z[k] und conj(Z[half - k])
+    for (size_t k = 0; k <= half; ++k) {
+        const size_t a = k == half ? 0 : k;
+        const size_t b = k == 0 ? 0 : half - k;
+        const float zr = workRe[a], zi = workIm[a];
+        const float cr = workRe[b], ci = -workIm[b];
+        const float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+        const float orr = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);
+        re[k] = er + splitRe[k] * orr - splitIm[k] * oi;
+        im[k] = ei + splitRe[k] * oi + splitIm[k] * orr;
+    }
+}
+
+void RealFFT::inverse(const float* re, const float* im, float* output) {
+    for (size_t k = 0; k < half; ++k) {
+        const float xr = re[k], xi = im[k];
+        const float cr = re[half - k], ci = -im[half - k];
+        const float er = xr + cr, ei = xi + ci;
+        // (X[k] - conj(X[half - k])) * W^-k
+        const float dr = xr - cr, di = xi - ci;
+        const float orr = dr * splitRe[k] + di * splitIm[k];
+        const float oi = di * splitRe[k] - dr * splitIm[k];
+        workRe[k] = er - oi;
+        workIm[k] = ei + orr;
+    }
+    transform(workRe.data(), workIm.data(), true);
+
+    for (size_t n = 0; n < half; ++n) {
+        output[2 * n] = workRe[n];
+        output[2 * n + 1] = workIm[n];
+    }
+}
+
+} // namespace dsp
+} // namespace VR_DAW
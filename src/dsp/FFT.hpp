@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace VR_DAW {
+namespace dsp {
+
+// Reelle FFT für Zweierpotenz-Größen, gerechnet als komplexe FFT halber
+// Länge (Radix-2, iterativ) mit anschließender Entflechtung. Spektren liegen
+// getrennt als Real- und Imaginärteil vor (size/2 + 1 Bins), damit Faltung
+// und Filter die Bins ohne Shuffles vektorisiert multiplizieren können.
+// Twiddles und Bitumkehr werden im Konstruktor berechnet; forward() und
+// inverse() allozieren nicht und sind für den Audio-Thread geeignet.
+class RealFFT {
+public:
+    explicit RealFFT(size_t size);
+
+    size_t getSize() const { return size; }
+    size_t getNumBins() const { return size / 2 + 1; }
+
+    // input: size Samples; re/im: getNumBins() Werte
+    void forward(const float* input, float* re, float* im);
+    // Unnormiert: liefert size * x. Die Skalierung 1/size gehört in eines
+    // der Spektren (z.B. einmalig in die Impulsantwort), nicht in jeden Block
+    void inverse(const float* re, const float* im, float* output);
+
+private:
+    size_t size;
+    size_t half;
+    std::vector<size_t> bitReverse;
+    // Twiddles der komplexen FFT (half/2) und der Entflechtung (half)
+    std::vector<float> twiddleRe, twiddleIm;
+    std::vector<float> splitRe, splitIm;
+    std::vector<float> workRe, workIm;
+
+    void transform(float* re, float* im, bool inverse) const;
+};
+
+// acc += gain * a * b über getrennte Real-/Imaginärteile (Faltung im
+// Frequenzbereich). AVX2/FMA-Variante, wenn die Kernel-Erkennung sie meldet
+void complexMultiplyAccumulate(float* accRe, float* accIm,
+                               const float* aRe, const float* aIm,
+                               const float* bRe, const float* bIm,
+                               size_t numBins, float gain = 1.0f);
+
+} // namespace dsp
+} // namespace VR_DAW
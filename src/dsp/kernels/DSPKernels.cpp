@@ -0,0 +1,255 @@
+#include "KernelVariants.hpp"
+#include <algorithm>
+
+#ifdef VRDAW_KERNELS_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace VR_DAW {
+namespace dsp {
+
+// ---------------------------------------------------------------------------
+// Skalare Referenz-Implementierung (auch für Rest-Samples der SIMD-Varianten)
+
+namespace scalar {
+
+void applyGain(float* data, size_t numSamples, float gain) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        data[i] *= gain;
+    }
+}
+
+void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain) {
+    if (numSamples == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        data[i] *= startGain + step * static_cast<float>(i);
+    }
+}
+
+void applyStereoGain(float* interleaved, size_t numFrames, float leftGain, float rightGain) {
+    for (size_t i = 0; i < numFrames; ++i) {
+        interleaved[i * 2] *= leftGain;
+        interleaved[i * 2 + 1] *= rightGain;
+    }
+}
+
+void applyStereoGainRamp(float* interleaved, size_t numFrames, float startLeft, float endLeft,
+                         float startRight, float endRight) {
+    if (numFrames == 0) return;
+    const float stepLeft = (endLeft - startLeft) / static_cast<float>(numFrames);
+    const float stepRight = (endRight - startRight) / static_cast<float>(numFrames);
+    for (size_t i = 0; i < numFrames; ++i) {
+        interleaved[i * 2] *= startLeft + stepLeft * static_cast<float>(i);
+        interleaved[i * 2 + 1] *= startRight + stepRight * static_cast<float>(i);
+    }
+}
+
+void multiplyAdd(float* dst, const float* src, size_t numSamples, float gain) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+void multiplyAddRamp(float* dst, const float* src, size_t numSamples, float startGain, float endGain) {
+    if (numSamples == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        dst[i] += src[i] * (startGain + step * static_cast<float>(i));
+    }
+}
+
+void multiplyAddStereo(float* dst, const float* src, size_t numFrames, float leftGain, float rightGain) {
+    for (size_t i = 0; i < numFrames; ++i) {
+        dst[i * 2] += src[i * 2] * leftGain;
+        dst[i * 2 + 1] += src[i * 2 + 1] * rightGain;
+    }
+}
+
+void interleave(const float* left, const float* right, float* interleaved, size_t numFrames) {
+    for (size_t i = 0; i < numFrames; ++i) {
+        interleaved[i * 2] = left[i];
+        interleaved[i * 2 + 1] = right[i];
+    }
+}
+
+void deinterleave(const float* interleaved, float* left, float* right, size_t numFrames) {
+    for (size_t i = 0; i < numFrames; ++i) {
+        left[i] = interleaved[i * 2];
+        right[i] = interleaved[i * 2 + 1];
+    }
+}
+
+float peak(const float* data, size_t numSamples) {
+    float result = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        result = std::max(result, std::fabs(data[i]));
+    }
+    return result;
+}
+
+float sumOfSquares(const float* data, size_t numSamples) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        sum += data[i] * data[i];
+    }
+    return sum;
+}
+
+} // namespace scalar
+
+const KernelTable& getScalarKernels() {
+    static const KernelTable table = {
+        KernelVariant::Scalar,
+        "Scalar",
+        scalar::applyGain,
+        scalar::applyGainRamp,
+        scalar::applyStereoGain,
+        scalar::applyStereoGainRamp,
+        scalar::multiplyAdd,
+        scalar::multiplyAddRamp,
+        scalar::multiplyAddStereo,
+        scalar::interleave,
+        scalar::deinterleave,
+        scalar::peak,
+        scalar::sumOfSquares
+    };
+    return table;
+}
+
+// ---------------------------------------------------------------------------
+// CPU-Erkennung
+
+namespace {
+
+struct CPUFeatures {
+    bool sse2 = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool avx512f = false;
+};
+
+#ifdef VRDAW_KERNELS_X86
+void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned int>(info[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+unsigned long long readXCR0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+CPUFeatures detectCPUFeatures() {
+    CPUFeatures features;
+#ifdef VRDAW_KERNELS_X86
+    unsigned int regs[4] = {0, 0, 0, 0};
+    cpuid(0, 0, regs);
+    const unsigned int maxLeaf = regs[0];
+
+    cpuid(1, 0, regs);
+    features.sse2 = (regs[3] & (1u << 26)) != 0;
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool avx = (regs[2] & (1u << 28)) != 0;
+    features.fma = (regs[2] & (1u << 12)) != 0;
+
+    // Das Betriebssystem muss die YMM/ZMM-Register sichern,
+    // sonst führen AVX-Instruktionen trotz CPU-Support zu Fehlern
+    bool osYMM = false;
+    bool osZMM = false;
+    if (osxsave && avx) {
+        const unsigned long long xcr0 = readXCR0();
+        osYMM = (xcr0 & 0x6) == 0x6;
+        osZMM = (xcr0 & 0xE6) == 0xE6;
+    }
+
+    if (maxLeaf >= 7) {
+        cpuid(7, 0, regs);
+        features.avx2 = osYMM && (regs[1] & (1u << 5)) != 0 && features.fma;
+        features.avx512f = osZMM && (regs[1] & (1u << 16)) != 0;
+    }
+#endif
+    return features;
+}
+
+const CPUFeatures& getCPUFeatures() {
+    static const CPUFeatures features = detectCPUFeatures();
+    return features;
+}
+
+const KernelTable& selectBestKernels() {
+#ifdef VRDAW_KERNELS_X86
+    const CPUFeatures& features = getCPUFeatures();
+    if (features.avx512f) return getAVX512Kernels();
+    if (features.avx2) return getAVX2Kernels();
+    if (features.sse2) return getSSE2Kernels();
+#endif
+    return getScalarKernels();
+}
+
+} // namespace
+
+void initializeKernels() {
+    getKernels();
+}
+
+const KernelTable& getKernels() {
+    static const KernelTable& kernels = selectBestKernels();
+    return kernels;
+}
+
+const KernelTable* getKernelVariant(KernelVariant variant) {
+    switch (variant) {
+        case KernelVariant::Scalar:
+            return &getScalarKernels();
+#ifdef VRDAW_KERNELS_X86
+        case KernelVariant::SSE2:
+            return getCPUFeatures().sse2 ? &getSSE2Kernels() : nullptr;
+        case KernelVariant::AVX2:
+            return getCPUFeatures().avx2 ? &getAVX2Kernels() : nullptr;
+        case KernelVariant::AVX512:
+            return getCPUFeatures().avx512f ? &getAVX512Kernels() : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+std::vector<KernelVariant> getAvailableVariants() {
+    std::vector<KernelVariant> variants;
+    for (KernelVariant v : {KernelVariant::Scalar, KernelVariant::SSE2,
+                            KernelVariant::AVX2, KernelVariant::AVX512}) {
+        if (getKernelVariant(v)) {
+            variants.push_back(v);
+        }
+    }
+    return variants;
+}
+
+const char* getVariantName(KernelVariant variant) {
+    switch (variant) {
+        case KernelVariant::Scalar: return "Scalar";
+        case KernelVariant::SSE2: return "SSE2";
+        case KernelVariant::AVX2: return "AVX2";
+        case KernelVariant::AVX512: return "AVX-512";
+    }
+    return "Unknown";
+}
+
+} // namespace dsp
+} // namespace VR_DAW
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace VR_DAW {
+namespace dsp {
+
+// Laufzeit-dispatchte SIMD-Kernels für Gain, Pan, Mix und Summen.
+// Die passende Variante (Scalar, SSE2, AVX2, AVX-512) wird einmalig per
+// CPUID ermittelt; alle Kernels sind allokations- und lockfrei und
+// dürfen im Audio-Thread verwendet werden.
+enum class KernelVariant {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+struct KernelTable {
+    KernelVariant variant;
+    const char* name;
+
+    // data[i] *= gain
+    void (*applyGain)(float* data, size_t numSamples, float gain);
+    // Linearer Gain-Verlauf von startGain (Sample 0) Richtung endGain
+    void (*applyGainRamp)(float* data, size_t numSamples, float startGain, float endGain);
+    // Interleaved Stereo: L *= leftGain, R *= rightGain
+    void (*applyStereoGain)(float* interleaved, size_t numFrames, float leftGain, float rightGain);
+    // Interleaved Stereo mit je einem linearen Verlauf pro Kanal (geglättete Pan/Volume)
+    void (*applyStereoGainRamp)(float* interleaved, size_t numFrames, float startLeft, float endLeft,
+                                float startRight, float endRight);
+
+    // Bus-Summierung: dst[i] += src[i] * gain
+    void (*multiplyAdd)(float* dst, const float* src, size_t numSamples, float gain);
+    void (*multiplyAddRamp)(float* dst, const float* src, size_t numSamples, float startGain, float endGain);
+    // Interleaved Stereo mit getrennten Kanal-Gains (Pan + Volume)
+    void (*multiplyAddStereo)(float* dst, const float* src, size_t numFrames, float leftGain, float rightGain);
+
+    void (*interleave)(const float* left, const float* right, float* interleaved, size_t numFrames);
+    void (*deinterleave)(const float* interleaved, float* left, float* right, size_t numFrames);
+
+    // Pegelmessung
+    float (*peak)(const float* data, size_t numSamples);
+    float (*sumOfSquares)(const float* data, size_t numSamples);
+};
+
+// Einmalige CPU-Erkennung; Aufruf beim Start empfohlen, damit die Auswahl
+// nicht im ersten Audio-Callback passiert
+void initializeKernels();
+
+const KernelTable& getKernels();
+// nullptr, wenn die Variante auf dieser CPU nicht verfügbar ist
+const KernelTable* getKernelVariant(KernelVariant variant);
+std::vector<KernelVariant> getAvailableVariants();
+const char* getVariantName(KernelVariant variant);
+
+// Constant-Power-Pan: pan in [-1, 1], Summe der Leistungen = 1
+inline void constantPowerPanGains(float pan, float& leftGain, float& rightGain) {
+    const float angle = (pan + 1.0f) * 0.25f * 3.14159265358979f;
+    leftGain = std::cos(angle);
+    rightGain = std::sin(angle);
+}
+
+inline void applyGain(float* data, size_t numSamples, float gain) {
+    getKernels().applyGain(data, numSamples, gain);
+}
+
+inline void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain) {
+    getKernels().applyGainRamp(data, numSamples, startGain, endGain);
+}
+
+inline void applyStereoGain(float* interleaved, size_t numFrames, float leftGain, float rightGain) {
+    getKernels().applyStereoGain(interleaved, numFrames, leftGain, rightGain);
+}
+
+inline void applyStereoGainRamp(float* interleaved, size_t numFrames, float startLeft, float endLeft,
+                                float startRight, float endRight) {
+    getKernels().applyStereoGainRamp(interleaved, numFrames, startLeft, endLeft, startRight, endRight);
+}
+
+inline void multiplyAdd(float* dst, const float* src, size_t numSamples, float gain) {
+    getKernels().multiplyAdd(dst, src, numSamples, gain);
+}
+
+inline void multiplyAddRamp(float* dst, const float* src, size_t numSamples, float startGain, float endGain) {
+    getKernels().multiplyAddRamp(dst, src, numSamples, startGain, endGain);
+}
+
+inline void multiplyAddStereo(float* dst, const float* src, size_t numFrames, float leftGain, float rightGain) {
+    getKernels().multiplyAddStereo(dst, src, numFrames, leftGain, rightGain);
+}
+
+inline void interleave(const float* left, const float* right, float* interleaved, size_t numFrames) {
+    getKernels().interleave(left, right, interleaved, numFrames);
+}
+
+inline void deinterleave(const float* interleaved, float* left, float* right, size_t numFrames) {
+    getKernels().deinterleave(interleaved, left, right, numFrames);
+}
+
+inline float peak(const float* data, size_t numSamples) {
+    return getKernels().peak(data, numSamples);
+}
+
+inline float rms(const float* data, size_t numSamples) {
+    if (numSamples == 0) return 0.0f;
+    return std::sqrt(getKernels().sumOfSquares(data, numSamples) / static_cast<float>(numSamples));
+}
+
+} // namespace dsp
+} // namespace VR_DAW
@@ -0,0 +1,216 @@
+#include "KernelVariants.hpp"
+
+#ifdef VRDAW_KERNELS_X86
+#include <immintrin.h>
+#include <algorithm>
+
+namespace VR_DAW {
+namespace dsp {
+
+namespace {
+
+#define VRDAW_AVX2 VRDAW_TARGET("avx2,fma")
+
+VRDAW_AVX2
+void applyGainAVX2(float* data, size_t numSamples, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), g));
+        _mm256_storeu_ps(data + i + 8, _mm256_mul_ps(_mm256_loadu_ps(data + i + 8), g));
+    }
+    for (; i + 8 <= numSamples; i += 8) {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), g));
+    }
+    scalar::applyGain(data + i, numSamples - i, gain);
+}
+
+VRDAW_AVX2
+void applyGainRampAVX2(float* data, size_t numSamples, float startGain, float endGain) {
+    if (numSamples == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    const __m256 laneSteps = _mm256_mul_ps(_mm256_set1_ps(step),
+        _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f));
+    size_t i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 g = _mm256_add_ps(_mm256_set1_ps(startGain + step * static_cast<float>(i)), laneSteps);
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), g));
+    }
+    for (; i < numSamples; ++i) {
+        data[i] *= startGain + step * static_cast<float>(i);
+    }
+}
+
+VRDAW_AVX2
+void applyStereoGainAVX2(float* interleaved, size_t numFrames, float leftGain, float rightGain) {
+    const __m256 g = _mm256_set_ps(rightGain, leftGain, rightGain, leftGain,
+                                   rightGain, leftGain, rightGain, leftGain);
+    const size_t numSamples = numFrames * 2;
+    size_t i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        _mm256_storeu_ps(interleaved + i, _mm256_mul_ps(_mm256_loadu_ps(interleaved + i), g));
+    }
+    scalar::applyStereoGain(interleaved + i, (numSamples - i) / 2, leftGain, rightGain);
+}
+
+VRDAW_AVX2
+void applyStereoGainRampAVX2(float* interleaved, size_t numFrames, float startLeft, float endLeft,
+                             float startRight, float endRight) {
+    if (numFrames == 0) return;
+    const float stepLeft = (endLeft - startLeft) / static_cast<float>(numFrames);
+    const float stepRight = (endRight - startRight) / static_cast<float>(numFrames);
+    const __m256 start = _mm256_set_ps(startRight, startLeft, startRight, startLeft,
+                                       startRight, startLeft, startRight, startLeft);
+    const __m256 steps = _mm256_set_ps(stepRight, stepLeft, stepRight, stepLeft,
+                                       stepRight, stepLeft, stepRight, stepLeft);
+    const __m256 laneSteps = _mm256_mul_ps(steps, _mm256_set_ps(3.0f, 3.0f, 2.0f, 2.0f, 1.0f, 1.0f, 0.0f, 0.0f));
+    size_t frame = 0;
+    for (; frame + 4 <= numFrames; frame += 4) {
+        const __m256 g = _mm256_add_ps(_mm256_fmadd_ps(steps, _mm256_set1_ps(static_cast<float>(frame)), start),
+                                       laneSteps);
+        float* data = interleaved + frame * 2;
+        _mm256_storeu_ps(data, _mm256_mul_ps(_mm256_loadu_ps(data), g));
+    }
+    for (; frame < numFrames; ++frame) {
+        interleaved[frame * 2] *= startLeft + stepLeft * static_cast<float>(frame);
+        interleaved[frame * 2 + 1] *= startRight + stepRight * static_cast<float>(frame);
+    }
+}
+
+VRDAW_AVX2
+void multiplyAddAVX2(float* dst, const float* src, size_t numSamples, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), g, _mm256_loadu_ps(dst + i)));
+        _mm256_storeu_ps(dst + i + 8, _mm256_fmadd_ps(_mm256_loadu_ps(src + i + 8), g, _mm256_loadu_ps(dst + i + 8)));
+    }
+    for (; i + 8 <= numSamples; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), g, _mm256_loadu_ps(dst + i)));
+    }
+    scalar::multiplyAdd(dst + i, src + i, numSamples - i, gain);
+}
+
+VRDAW_AVX2
+void multiplyAddRampAVX2(float* dst, const float* src, size_t numSamples, float startGain, float endGain) {
+    if (numSamples == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    const __m256 laneSteps = _mm256_mul_ps(_mm256_set1_ps(step),
+        _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f));
+    size_t i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 g = _mm256_add_ps(_mm256_set1_ps(startGain + step * static_cast<float>(i)), laneSteps);
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), g, _mm256_loadu_ps(dst + i)));
+    }
+    for (; i < numSamples; ++i) {
+        dst[i] += src[i] * (startGain + step * static_cast<float>(i));
+    }
+}
+
+VRDAW_AVX2
+void multiplyAddStereoAVX2(float* dst, const float* src, size_t numFrames, float leftGain, float rightGain) {
+    const __m256 g = _mm256_set_ps(rightGain, leftGain, rightGain, leftGain,
+                                   rightGain, leftGain, rightGain, leftGain);
+    const size_t numSamples = numFrames * 2;
+    size_t i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), g, _mm256_loadu_ps(dst + i)));
+    }
+    scalar::multiplyAddStereo(dst + i, src + i, (numSamples - i) / 2, leftGain, rightGain);
+}
+
+VRDAW_AVX2
+void interleaveAVX2(const float* left, const float* right, float* interleaved, size_t numFrames) {
+    size_t i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+        const __m256 l = _mm256_loadu_ps(left + i);
+        const __m256 r = _mm256_loadu_ps(right + i);
+        // unpack arbeitet pro 128-Bit-Lane, danach Lanes zusammensetzen
+        const __m256 lo = _mm256_unpacklo_ps(l, r); // l0 r0 l1 r1 | l4 r4 l5 r5
+        const __m256 hi = _mm256_unpackhi_ps(l, r); // l2 r2 l3 r3 | l6 r6 l7 r7
+        _mm256_storeu_ps(interleaved + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(interleaved + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    scalar::interleave(left + i, right + i, interleaved + i * 2, numFrames - i);
+}
+
+VRDAW_AVX2
+void deinterleaveAVX2(const float* interleaved, float* left, float* right, size_t numFrames) {
+    size_t i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+        const __m256 a = _mm256_loadu_ps(interleaved + i * 2);
+        const __m256 b = _mm256_loadu_ps(interleaved + i * 2 + 8);
+        // l0 l1 l4 l5 | l2 l3 l6 l7 -> 64-Bit-Blöcke in Reihenfolge bringen
+        const __m256 even = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 odd = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm256_storeu_ps(left + i, _mm256_castpd_ps(
+            _mm256_permute4x64_pd(_mm256_castps_pd(even), _MM_SHUFFLE(3, 1, 2, 0))));
+        _mm256_storeu_ps(right + i, _mm256_castpd_ps(
+            _mm256_permute4x64_pd(_mm256_castps_pd(odd), _MM_SHUFFLE(3, 1, 2, 0))));
+    }
+    scalar::deinterleave(interleaved + i * 2, left + i, right + i, numFrames - i);
+}
+
+VRDAW_AVX2
+float peakAVX2(const float* data, size_t numSamples) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 maxValue = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        maxValue = _mm256_max_ps(maxValue, _mm256_and_ps(_mm256_loadu_ps(data + i), absMask));
+    }
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(maxValue), _mm256_extractf128_ps(maxValue, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return std::max(_mm_cvtss_f32(m), scalar::peak(data + i, numSamples - i));
+}
+
+VRDAW_AVX2
+float sumOfSquaresAVX2(const float* data, size_t numSamples) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        const __m256 x0 = _mm256_loadu_ps(data + i);
+        const __m256 x1 = _mm256_loadu_ps(data + i + 8);
+        sum0 = _mm256_fmadd_ps(x0, x0, sum0);
+        sum1 = _mm256_fmadd_ps(x1, x1, sum1);
+    }
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 x = _mm256_loadu_ps(data + i);
+        sum0 = _mm256_fmadd_ps(x, x, sum0);
+    }
+    const __m256 sum = _mm256_add_ps(sum0, sum1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s) + scalar::sumOfSquares(data + i, numSamples - i);
+}
+
+#undef VRDAW_AVX2
+
+} // namespace
+
+const KernelTable& getAVX2Kernels() {
+    static const KernelTable table = {
+        KernelVariant::AVX2,
+        "AVX2",
+        applyGainAVX2,
+        applyGainRampAVX2,
+        applyStereoGainAVX2,
+        applyStereoGainRampAVX2,
+        multiplyAddAVX2,
+        multiplyAddRampAVX2,
+        multiplyAddStereoAVX2,
+        interleaveAVX2,
+        deinterleaveAVX2,
+        peakAVX2,
+        sumOfSquaresAVX2
+    };
+    return table;
+}
+
+} // namespace dsp
+} // namespace VR_DAW
+
+#endif // VRDAW_KERNELS_X86
@@ -0,0 +1,201 @@
+#include "KernelVariants.hpp"
+
+#ifdef VRDAW_KERNELS_X86
+#include <immintrin.h>
+
+namespace VR_DAW {
+namespace dsp {
+
+namespace {
+
+#define VRDAW_AVX512 VRDAW_TARGET("avx512f")
+
+// Rest-Samples werden mit Masken statt skalar verarbeitet
+inline __mmask16 tailMask(size_t remaining) {
+    return static_cast<__mmask16>((1u << remaining) - 1u);
+}
+
+VRDAW_AVX512
+void applyGainAVX512(float* data, size_t numSamples, float gain) {
+    const __m512 g = _mm512_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        _mm512_storeu_ps(data + i, _mm512_mul_ps(_mm512_loadu_ps(data + i), g));
+    }
+    if (i < numSamples) {
+        const __mmask16 m = tailMask(numSamples - i);
+        _mm512_mask_storeu_ps(data + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, data + i), g));
+    }
+}
+
+VRDAW_AVX512
+void applyGainRampAVX512(float* data, size_t numSamples, float startGain, float endGain) {
+    if (numSamples == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    const __m512 laneSteps = _mm512_mul_ps(_mm512_set1_ps(step),
+        _mm512_set_ps(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    size_t i = 0;
+    for (; i < numSamples; i += 16) {
+        const __m512 g = _mm512_add_ps(_mm512_set1_ps(startGain + step * static_cast<float>(i)), laneSteps);
+        const __mmask16 m = numSamples - i >= 16 ? static_cast<__mmask16>(0xFFFF) : tailMask(numSamples - i);
+        _mm512_mask_storeu_ps(data + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, data + i), g));
+    }
+}
+
+VRDAW_AVX512
+void applyStereoGainAVX512(float* interleaved, size_t numFrames, float leftGain, float rightGain) {
+    const __m512 g = _mm512_set_ps(rightGain, leftGain, rightGain, leftGain,
+                                   rightGain, leftGain, rightGain, leftGain,
+                                   rightGain, leftGain, rightGain, leftGain,
+                                   rightGain, leftGain, rightGain, leftGain);
+    const size_t numSamples = numFrames * 2;
+    size_t i = 0;
+    for (; i < numSamples; i += 16) {
+        const __mmask16 m = numSamples - i >= 16 ? static_cast<__mmask16>(0xFFFF) : tailMask(numSamples - i);
+        _mm512_mask_storeu_ps(interleaved + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, interleaved + i), g));
+    }
+}
+
+VRDAW_AVX512
+void applyStereoGainRampAVX512(float* interleaved, size_t numFrames, float startLeft, float endLeft,
+                               float startRight, float endRight) {
+    if (numFrames == 0) return;
+    const float stepLeft = (endLeft - startLeft) / static_cast<float>(numFrames);
+    const float stepRight = (endRight - startRight) / static_cast<float>(numFrames);
+    const __m512 start = _mm512_set_ps(startRight, startLeft, startRight, startLeft,
+                                       startRight, startLeft, startRight, startLeft,
+                                       startRight, startLeft, startRight, startLeft,
+                                       startRight, startLeft, startRight, startLeft);
+    const __m512 steps = _mm512_set_ps(stepRight, stepLeft, stepRight, stepLeft,
+                                       stepRight, stepLeft, stepRight, stepLeft,
+                                       stepRight, stepLeft, stepRight, stepLeft,
+                                       stepRight, stepLeft, stepRight, stepLeft);
+    const __m512 laneSteps = _mm512_mul_ps(steps, _mm512_set_ps(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0));
+    const size_t numSamples = numFrames * 2;
+    for (size_t i = 0; i < numSamples; i += 16) {
+        const __m512 g = _mm512_add_ps(_mm512_fmadd_ps(steps, _mm512_set1_ps(static_cast<float>(i / 2)), start),
+                                       laneSteps);
+        const __mmask16 m = numSamples - i >= 16 ? static_cast<__mmask16>(0xFFFF) : tailMask(numSamples - i);
+        _mm512_mask_storeu_ps(interleaved + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, interleaved + i), g));
+    }
+}
+
+VRDAW_AVX512
+void multiplyAddAVX512(float* dst, const float* src, size_t numSamples, float gain) {
+    const __m512 g = _mm512_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 32 <= numSamples; i += 32) {
+        _mm512_storeu_ps(dst + i, _mm512_fmadd_ps(_mm512_loadu_ps(src + i), g, _mm512_loadu_ps(dst + i)));
+        _mm512_storeu_ps(dst + i + 16, _mm512_fmadd_ps(_mm512_loadu_ps(src + i + 16), g, _mm512_loadu_ps(dst + i + 16)));
+    }
+    for (; i < numSamples; i += 16) {
+        const __mmask16 m = numSamples - i >= 16 ? static_cast<__mmask16>(0xFFFF) : tailMask(numSamples - i);
+        _mm512_mask_storeu_ps(dst + i, m, _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, src + i), g,
+                                                          _mm512_maskz_loadu_ps(m, dst + i)));
+    }
+}
+
+VRDAW_AVX512
+void multiplyAddRampAVX512(float* dst, const float* src, size_t numSamples, float startGain, float endGain) {
+    if (numSamples == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    const __m512 laneSteps = _mm512_mul_ps(_mm512_set1_ps(step),
+        _mm512_set_ps(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    for (size_t i = 0; i < numSamples; i += 16) {
+        const __m512 g = _mm512_add_ps(_mm512_set1_ps(startGain + step * static_cast<float>(i)), laneSteps);
+        const __mmask16 m = numSamples - i >= 16 ? static_cast<__mmask16>(0xFFFF) : tailMask(numSamples - i);
+        _mm512_mask_storeu_ps(dst + i, m, _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, src + i), g,
+                                                          _mm512_maskz_loadu_ps(m, dst + i)));
+    }
+}
+
+VRDAW_AVX512
+void multiplyAddStereoAVX512(float* dst, const float* src, size_t numFrames, float leftGain, float rightGain) {
+    const __m512 g = _mm512_set_ps(rightGain, leftGain, rightGain, leftGain,
+                                   rightGain, leftGain, rightGain, leftGain,
+                                   rightGain, leftGain, rightGain, leftGain,
+                                   rightGain, leftGain, rightGain, leftGain);
+    const size_t numSamples = numFrames * 2;
+    for (size_t i = 0; i < numSamples; i += 16) {
+        const __mmask16 m = numSamples - i >= 16 ? static_cast<__mmask16>(0xFFFF) : tailMask(numSamples - i);
+        _mm512_mask_storeu_ps(dst + i, m, _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, src + i), g,
+                                                          _mm512_maskz_loadu_ps(m, dst + i)));
+    }
+}
+
+VRDAW_AVX512
+void interleaveAVX512(const float* left, const float* right, float* interleaved, size_t numFrames) {
+    const __m512i loIndex = _mm512_set_epi32(23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0);
+    const __m512i hiIndex = _mm512_set_epi32(31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8);
+    size_t i = 0;
+    for (; i + 16 <= numFrames; i += 16) {
+        const __m512 l = _mm512_loadu_ps(left + i);
+        const __m512 r = _mm512_loadu_ps(right + i);
+        _mm512_storeu_ps(interleaved + i * 2, _mm512_permutex2var_ps(l, loIndex, r));
+        _mm512_storeu_ps(interleaved + i * 2 + 16, _mm512_permutex2var_ps(l, hiIndex, r));
+    }
+    scalar::interleave(left + i, right + i, interleaved + i * 2, numFrames - i);
+}
+
+VRDAW_AVX512
+void deinterleaveAVX512(const float* interleaved, float* left, float* right, size_t numFrames) {
+    const __m512i evenIndex = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+    const __m512i oddIndex = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+    size_t i = 0;
+    for (; i + 16 <= numFrames; i += 16) {
+        const __m512 a = _mm512_loadu_ps(interleaved + i * 2);
+        const __m512 b = _mm512_loadu_ps(interleaved + i * 2 + 16);
+        _mm512_storeu_ps(left + i, _mm512_permutex2var_ps(a, evenIndex, b));
+        _mm512_storeu_ps(right + i, _mm512_permutex2var_ps(a, oddIndex, b));
+    }
+    scalar::deinterleave(interleaved + i * 2, left + i, right + i, numFrames - i);
+}
+
+VRDAW_AVX512
+float peakAVX512(const float* data, size_t numSamples) {
+    __m512 maxValue = _mm512_setzero_ps();
+    for (size_t i = 0; i < numSamples; i += 16) {
+        const __mmask16 m = numSamples - i >= 16 ? static_cast<__mmask16>(0xFFFF) : tailMask(numSamples - i);
+        maxValue = _mm512_max_ps(maxValue, _mm512_abs_ps(_mm512_maskz_loadu_ps(m, data + i)));
+    }
+    return _mm512_reduce_max_ps(maxValue);
+}
+
+VRDAW_AVX512
+float sumOfSquaresAVX512(const float* data, size_t numSamples) {
+    __m512 sum = _mm512_setzero_ps();
+    for (size_t i = 0; i < numSamples; i += 16) {
+        const __mmask16 m = numSamples - i >= 16 ? static_cast<__mmask16>(0xFFFF) : tailMask(numSamples - i);
+        const __m512 x = _mm512_maskz_loadu_ps(m, data + i);
+        sum = _mm512_fmadd_ps(x, x, sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+#undef VRDAW_AVX512
+
+} // namespace
+
+const KernelTable& getAVX512Kernels() {
+    static const KernelTable table = {
+        KernelVariant::AVX512,
+        "AVX-512",
+        applyGainAVX512,
+        applyGainRampAVX512,
+        applyStereoGainAVX512,
+        applyStereoGainRampAVX512,
+        multiplyAddAVX512,
+        multiplyAddRampAVX512,
+        multiplyAddStereoAVX512,
+        interleaveAVX512,
+        deinterleaveAVX512,
+        peakAVX512,
+        sumOfSquaresAVX512
+    };
+    return table;
+}
+
+} // namespace dsp
+} // namespace VR_DAW
+
+#endif // VRDAW_KERNELS_X86
@@ -0,0 +1,186 @@
+#include "KernelVariants.hpp"
+
+#ifdef VRDAW_KERNELS_X86
+#include <emmintrin.h>
+#include <algorithm>
+
+namespace VR_DAW {
+namespace dsp {
+
+namespace {
+
+VRDAW_TARGET("sse2")
+void applyGainSSE2(float* data, size_t numSamples, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), g));
+    }
+    scalar::applyGain(data + i, numSamples - i, gain);
+}
+
+VRDAW_TARGET("sse2")
+void applyGainRampSSE2(float* data, size_t numSamples, float startGain, float endGain) {
+    if (numSamples == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    const __m128 laneSteps = _mm_set_ps(3.0f * step, 2.0f * step, step, 0.0f);
+    size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        // Gain aus dem Index berechnen statt aufzuaddieren: keine Drift
+        const __m128 g = _mm_add_ps(_mm_set1_ps(startGain + step * static_cast<float>(i)), laneSteps);
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), g));
+    }
+    for (; i < numSamples; ++i) {
+        data[i] *= startGain + step * static_cast<float>(i);
+    }
+}
+
+VRDAW_TARGET("sse2")
+void applyStereoGainSSE2(float* interleaved, size_t numFrames, float leftGain, float rightGain) {
+    const __m128 g = _mm_set_ps(rightGain, leftGain, rightGain, leftGain);
+    const size_t numSamples = numFrames * 2;
+    size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        _mm_storeu_ps(interleaved + i, _mm_mul_ps(_mm_loadu_ps(interleaved + i), g));
+    }
+    scalar::applyStereoGain(interleaved + i, (numSamples - i) / 2, leftGain, rightGain);
+}
+
+VRDAW_TARGET("sse2")
+void applyStereoGainRampSSE2(float* interleaved, size_t numFrames, float startLeft, float endLeft,
+                             float startRight, float endRight) {
+    if (numFrames == 0) return;
+    const float stepLeft = (endLeft - startLeft) / static_cast<float>(numFrames);
+    const float stepRight = (endRight - startRight) / static_cast<float>(numFrames);
+    // Zwei Frames pro Vektor: L0 R0 L1 R1
+    const __m128 start = _mm_set_ps(startRight, startLeft, startRight, startLeft);
+    const __m128 steps = _mm_set_ps(stepRight, stepLeft, stepRight, stepLeft);
+    const __m128 laneSteps = _mm_mul_ps(steps, _mm_set_ps(1.0f, 1.0f, 0.0f, 0.0f));
+    size_t frame = 0;
+    for (; frame + 2 <= numFrames; frame += 2) {
+        const __m128 g = _mm_add_ps(_mm_add_ps(start, _mm_mul_ps(steps, _mm_set1_ps(static_cast<float>(frame)))),
+                                    laneSteps);
+        float* data = interleaved + frame * 2;
+        _mm_storeu_ps(data, _mm_mul_ps(_mm_loadu_ps(data), g));
+    }
+    for (; frame < numFrames; ++frame) {
+        interleaved[frame * 2] *= startLeft + stepLeft * static_cast<float>(frame);
+        interleaved[frame * 2 + 1] *= startRight + stepRight * static_cast<float>(frame);
+    }
+}
+
+VRDAW_TARGET("sse2")
+void multiplyAddSSE2(float* dst, const float* src, size_t numSamples, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 sum = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g));
+        _mm_storeu_ps(dst + i, sum);
+    }
+    scalar::multiplyAdd(dst + i, src + i, numSamples - i, gain);
+}
+
+VRDAW_TARGET("sse2")
+void multiplyAddRampSSE2(float* dst, const float* src, size_t numSamples, float startGain, float endGain) {
+    if (numSamples == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    const __m128 laneSteps = _mm_set_ps(3.0f * step, 2.0f * step, step, 0.0f);
+    size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 g = _mm_add_ps(_mm_set1_ps(startGain + step * static_cast<float>(i)), laneSteps);
+        const __m128 sum = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g));
+        _mm_storeu_ps(dst + i, sum);
+    }
+    for (; i < numSamples; ++i) {
+        dst[i] += src[i] * (startGain + step * static_cast<float>(i));
+    }
+}
+
+VRDAW_TARGET("sse2")
+void multiplyAddStereoSSE2(float* dst, const float* src, size_t numFrames, float leftGain, float rightGain) {
+    const __m128 g = _mm_set_ps(rightGain, leftGain, rightGain, leftGain);
+    const size_t numSamples = numFrames * 2;
+    size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 sum = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g));
+        _mm_storeu_ps(dst + i, sum);
+    }
+    scalar::multiplyAddStereo(dst + i, src + i, (numSamples - i) / 2, leftGain, rightGain);
+}
+
+VRDAW_TARGET("sse2")
+void interleaveSSE2(const float* left, const float* right, float* interleaved, size_t numFrames) {
+    size_t i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m128 l = _mm_loadu_ps(left + i);
+        const __m128 r = _mm_loadu_ps(right + i);
+        _mm_storeu_ps(interleaved + i * 2, _mm_unpacklo_ps(l, r));
+        _mm_storeu_ps(interleaved + i * 2 + 4, _mm_unpackhi_ps(l, r));
+    }
+    scalar::interleave(left + i, right + i, interleaved + i * 2, numFrames - i);
+}
+
+VRDAW_TARGET("sse2")
+void deinterleaveSSE2(const float* interleaved, float* left, float* right, size_t numFrames) {
+    size_t i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m128 a = _mm_loadu_ps(interleaved + i * 2);
+        const __m128 b = _mm_loadu_ps(interleaved + i * 2 + 4);
+        _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    scalar::deinterleave(interleaved + i * 2, left + i, right + i, numFrames - i);
+}
+
+VRDAW_TARGET("sse2")
+float peakSSE2(const float* data, size_t numSamples) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 maxValue = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        maxValue = _mm_max_ps(maxValue, _mm_and_ps(_mm_loadu_ps(data + i), absMask));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, maxValue);
+    float result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    return std::max(result, scalar::peak(data + i, numSamples - i));
+}
+
+VRDAW_TARGET("sse2")
+float sumOfSquaresSSE2(const float* data, size_t numSamples) {
+    __m128 sum = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 x = _mm_loadu_ps(data + i);
+        sum = _mm_add_ps(sum, _mm_mul_ps(x, x));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sumOfSquares(data + i, numSamples - i);
+}
+
+} // namespace
+
+const KernelTable& getSSE2Kernels() {
+    static const KernelTable table = {
+        KernelVariant::SSE2,
+        "SSE2",
+        applyGainSSE2,
+        applyGainRampSSE2,
+        applyStereoGainSSE2,
+        applyStereoGainRampSSE2,
+        multiplyAddSSE2,
+        multiplyAddRampSSE2,
+        multiplyAddStereoSSE2,
+        interleaveSSE2,
+        deinterleaveSSE2,
+        peakSSE2,
+        sumOfSquaresSSE2
+    };
+    return table;
+}
+
+} // namespace dsp
+} // namespace VR_DAW
+
+#endif // VRDAW_KERNELS_X86
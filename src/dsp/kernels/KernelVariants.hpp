@@ -0,0 +1,48 @@
+#pragma once
+
+#include "DSPKernels.hpp"
+
+// Interne Deklarationen der einzelnen Kernel-Varianten. Nur von den
+// Kernel-Übersetzungseinheiten und dem Dispatcher einzubinden.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define VRDAW_KERNELS_X86 1
+#endif
+
+// Funktionen einzeln für eine ISA übersetzen, ohne globale Compiler-Flags;
+// der Dispatcher ruft sie nur auf, wenn CPUID die Erweiterung meldet
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VRDAW_TARGET(isa)
+#else
+#define VRDAW_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace VR_DAW {
+namespace dsp {
+namespace scalar {
+
+void applyGain(float* data, size_t numSamples, float gain);
+void applyGainRamp(float* data, size_t numSamples, float startGain, float endGain);
+void applyStereoGain(float* interleaved, size_t numFrames, float leftGain, float rightGain);
+void applyStereoGainRamp(float* interleaved, size_t numFrames, float startLeft, float endLeft,
+                         float startRight, float endRight);
+void multiplyAdd(float* dst, const float* src, size_t numSamples, float gain);
+void multiplyAddRamp(float* dst, const float* src, size_t numSamples, float startGain, float endGain);
+void multiplyAddStereo(float* dst, const float* src, size_t numFrames, float leftGain, float rightGain);
+void interleave(const float* left, const float* right, float* interleaved, size_t numFrames);
+void deinterleave(const float* interleaved, float* left, float* right, size_t numFrames);
+float peak(const float* data, size_t numSamples);
+float sumOfSquares(const float* data, size_t numSamples);
+
+} // namespace scalar
+
+const KernelTable& getScalarKernels();
+
+#ifdef VRDAW_KERNELS_X86
+const KernelTable& getSSE2Kernels();
+const KernelTable& getAVX2Kernels();
+const KernelTable& getAVX512Kernels();
+#endif
+
+} // namespace dsp
+} // namespace VR_DAW
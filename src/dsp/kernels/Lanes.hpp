@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// Portable SIMD-Lanes über GCC/Clang-Vektorerweiterungen. Acht Floats pro
+// Vektor: mit AVX ein Register, mit SSE2/NEON zwei. Gedacht für SoA-Code,
+// in dem eine Lane eine Stimme/Quelle ist und der Block seriell läuft.
+
+// Die Helfer werden immer geinlined und nehmen Vektoren per Referenz; die
+// psABI-Hinweise zu 32-Byte-Vektoren betreffen keine echte Aufrufgrenze
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#define VRDAW_LANES_INLINE inline __attribute__((always_inline))
+
+namespace VR_DAW {
+namespace dsp {
+
+constexpr size_t kLaneWidth = 8;
+
+// Ausrichtung explizit: ohne -mavx setzt GCC sie sonst auf 16 Byte herab,
+// per target("avx2") übersetzte Funktionen erwarten aber 32
+#define VRDAW_LANE_TYPE(T) T __attribute__((vector_size(kLaneWidth * sizeof(T)), aligned(kLaneWidth * sizeof(T))))
+typedef VRDAW_LANE_TYPE(float) Lanes;
+typedef VRDAW_LANE_TYPE(int32_t) LaneMask;
+typedef VRDAW_LANE_TYPE(uint32_t) LaneBits;
+#undef VRDAW_LANE_TYPE
+
+VRDAW_LANES_INLINE Lanes splat(float value) {
+    return Lanes{} + value;
+}
+
+VRDAW_LANES_INLINE Lanes loadLanes(const float* data) {
+    Lanes result;
+    std::memcpy(&result, data, sizeof(Lanes));
+    return result;
+}
+
+VRDAW_LANES_INLINE void storeLanes(float* data, const Lanes& value) {
+    std::memcpy(data, &value, sizeof(Lanes));
+}
+
+// mask ? a : b, lane-weise (Maske aus einem Vektorvergleich)
+VRDAW_LANES_INLINE Lanes select(const LaneMask& mask, const Lanes& a, const Lanes& b) {
+    return (Lanes)((mask & (LaneMask)a) | (~mask & (LaneMask)b));
+}
+
+VRDAW_LANES_INLINE Lanes minLanes(const Lanes& a, const Lanes& b) { return select(a < b, a, b); }
+VRDAW_LANES_INLINE Lanes maxLanes(const Lanes& a, const Lanes& b) { return select(a > b, a, b); }
+VRDAW_LANES_INLINE Lanes absLanes(const Lanes& a) { return (Lanes)((LaneMask)a & 0x7fffffff); }
+
+VRDAW_LANES_INLINE Lanes clampLanes(const Lanes& x, float low, float high) {
+    return minLanes(maxLanes(x, splat(low)), splat(high));
+}
+
+// Phase in [0, 1) halten, solange das Inkrement kleiner als 1 ist
+VRDAW_LANES_INLINE Lanes wrapPhase(const Lanes& phase) {
+    return select(phase >= 1.0f, phase - 1.0f, phase);
+}
+
+// Rationale tanh-Näherung (Padé), |Fehler| < 0.05 in [-3, 3], danach gesättigt
+VRDAW_LANES_INLINE Lanes fastTanh(const Lanes& input) {
+    const Lanes x = clampLanes(input, -3.0f, 3.0f);
+    const Lanes x2 = x * x;
+    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+}
+
+// log2 über Exponent plus Polynom auf der Mantisse, |Fehler| < 7.3e-4
+// (0.005 dB). Eingaben <= 0 müssen vorher begrenzt werden
+VRDAW_LANES_INLINE Lanes fastLog2(const Lanes& x) {
+    const LaneMask bits = (LaneMask)x;
+    const Lanes exponent = __builtin_convertvector(((bits >> 23) & 0xff) - 127, Lanes);
+    const Lanes t = (Lanes)((bits & 0x007fffff) | 0x3f800000) - 1.0f;
+    const Lanes q = ((-0.10661331f * t + 0.36337747f) * t - 0.69918064f) * t + 1.44168694f;
+    return exponent + t * q;
+}
+
+// 2^x über Ganzzahlteil im Exponenten und Polynom, relativer Fehler < 1.4e-5
+VRDAW_LANES_INLINE Lanes fastExp2(const Lanes& input) {
+    const Lanes x = clampLanes(input, -126.0f, 126.0f);
+    LaneMask whole = __builtin_convertvector(x, LaneMask);
+    // Abschneiden Richtung Null zu floor korrigieren (Maske ist -1)
+    whole += (LaneMask)(__builtin_convertvector(whole, Lanes) > x);
+    const Lanes f = x - __builtin_convertvector(whole, Lanes);
+    const Lanes p = 1.0f + f * (((0.01276890f * f + 0.05336850f) * f + 0.24071376f) * f + 0.69312243f);
+    return (Lanes)((LaneMask)p + (whole << 23));
+}
+
+// Pegel <-> Dezibel; gainToDecibels begrenzt bei -200 dB statt -inf
+VRDAW_LANES_INLINE Lanes gainToDecibels(const Lanes& gain) {
+    return 6.02059991f * fastLog2(maxLanes(gain, splat(1e-10f)));
+}
+
+VRDAW_LANES_INLINE Lanes decibelsToGain(const Lanes& decibels) {
+    return fastExp2(decibels * 0.16609640f);
+}
+
+// 1/sqrt(x) über Bit-Schätzung und zwei Newton-Schritte, relativer Fehler
+// < 5e-6. Eingaben müssen > 0 sein
+VRDAW_LANES_INLINE Lanes fastInverseSqrt(const Lanes& x) {
+    Lanes y = (Lanes)(0x5f375a86 - ((LaneMask)x >> 1));
+    const Lanes half = 0.5f * x;
+    y = y * (1.5f - half * y * y);
+    return y * (1.5f - half * y * y);
+}
+
+VRDAW_LANES_INLINE float horizontalSum(const Lanes& value) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < kLaneWidth; ++i) sum += value[i];
+    return sum;
+}
+
+} // namespace dsp
+} // namespace VR_DAW
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -1,6 +1,8 @@
 #include "MIDIEngine.hpp"
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <deque>
 #include <thread>
 
 namespace VR_DAW {
@@ -9,8 +11,23 @@ struct MIDIEngine::Impl {
     std::vector<MIDIDevice> devices;
     std::map<int, std::unique_ptr<RtMidiIn>> midiInputs;
     std::map<int, std::unique_ptr<RtMidiOut>> midiOutputs;
-    std::queue<MIDIMessage> messageQueue;
-    std::mutex queueMutex;
+
+    // RtMidi-Callback -> userData; jeder Eingang bekommt einen festen Slot
+    struct InputSlot {
+        MIDIEngine* engine = nullptr;
+        size_t port = 0;
+        int deviceId = -1;
+    };
+    std::array<InputSlot, kMaxInputPorts> inputSlots;
+
+    // Pro Eingang je ein SPSC-Ring zum Audio-Thread und zum Kontroll-Thread
+    std::vector<std::shared_ptr<MIDIEventQueue>> audioQueues;
+    std::vector<std::unique_ptr<MIDIEventQueue>> controlQueues;
+    // Von processMessages() geleerte Nachrichten für getPendingMessages();
+    // begrenzt, die ältesten fallen zuerst heraus
+    static constexpr size_t kMaxPendingMessages = 4096;
+    std::deque<MIDIMessage> pendingMessages;
+    std::mutex pendingMutex;
     std::atomic<bool> isClockRunning;
     double tempo;
     std::function<void(const MIDIMessage&)> messageCallback;
@@ -27,6 +44,12 @@ MIDIEngine::MIDIEngine()
     , tempo(120.0)
     , isRecordingActive(false)
 {
+    for (size_t port = 0; port < kMaxInputPorts; ++port) {
+        pImpl->inputSlots[port].engine = this;
+        pImpl->inputSlots[port].port = port;
+        pImpl->audioQueues.push_back(std::make_shared<MIDIEventQueue>());
+        pImpl->controlQueues.push_back(std::make_unique<MIDIEventQueue>());
+    }
 }
 
 MIDIEngine::~MIDIEngine() {
@@ -120,11 +143,14 @@ bool MIDIEngine::openDevice(int deviceId) {
 
     try {
         if (it->isInput) {
+            auto slot = std::find_if(pImpl->inputSlots.begin(), pImpl->inputSlots.end(),
+                [](const Impl::InputSlot& s) { return s.deviceId < 0; });
+            if (slot == pImpl->inputSlots.end()) return false;
+
             auto midiIn = std::make_unique<RtMidiIn>();
             midiIn->openPort(deviceId);
-            midiIn->setCallback([this](double timeStamp, std::vector<unsigned char>* message, void* userData) {
-                handleMIDIInput(timeStamp, message);
-            });
+            slot->deviceId = deviceId;
+            midiIn->setCallback(&MIDIEngine::inputCallback, &(*slot));
             pImpl->midiInputs[deviceId] = std::move(midiIn);
         } else {
             auto midiOut = std::make_unique<RtMidiOut>();
@@ -144,6 +170,10 @@ void MIDIEngine::closeDevice(int deviceId) {
     if (pImpl->midiInputs.count(deviceId) > 0) {
         pImpl->midiInputs[deviceId]->closePort();
         pImpl->midiInputs.erase(deviceId);
+
+        for (auto& slot : pImpl->inputSlots) {
+            if (slot.deviceId == deviceId) slot.deviceId = -1;
+        }
     }
 
     if (pImpl->midiOutputs.count(deviceId) > 0) {
@@ -253,32 +283,58 @@ void MIDIEngine::setMessageCallback(std::function<void(const MIDIMessage&)> call
     pImpl->messageCallback = callback;
 }
 
+namespace {
+
+MIDIEngine::MIDIMessage toMessage(const TimedMIDIEvent& event) {
+    MIDIEngine::MIDIMessage message;
+    message.type = static_cast<MIDIEngine::MIDIMessage::Type>(event.status & 0xF0);
+    message.channel = event.status & 0x0F;
+    message.data1 = event.data1;
+    message.data2 = event.data2;
+    message.timestamp = event.timestamp / 1.0e9;
+    return message;
+}
+
+} // namespace
+
+// Nur aus dem Kontroll-Thread aufrufen (einziger Consumer der Kontroll-Ringe)
 void MIDIEngine::processMessages() {
-    std::lock_guard<std::mutex> lock(pImpl->queueMutex);
-    while (!pImpl->messageQueue.empty()) {
-        MIDIMessage message = pImpl->messageQueue.front();
-        pImpl->messageQueue.pop();
+    TimedMIDIEvent event;
+    for (auto& queue : pImpl->controlQueues) {
+        while (queue->pop(event)) {
+            MIDIMessage message = toMessage(event);
+
+            {
+                std::lock_guard<std::mutex> lock(pImpl->pendingMutex);
+                if (pImpl->pendingMessages.size() == Impl::kMaxPendingMessages) {
+                    pImpl->pendingMessages.pop_front();
+                }
+                pImpl->pendingMessages.push_back(message);
+            }
 
-        if (pImpl->messageCallback) {
-            pImpl->messageCallback(message);
-        }
+            if (pImpl->messageCallback) {
+                pImpl->messageCallback(message);
+            }
 
-        if (pImpl->isRecordingActive) {
-            recordMessage(message);
+            if (pImpl->isRecordingActive) {
+                recordMessage(message);
+            }
         }
     }
 }
 
+// Liest nur, was processMessages() schon aus den Ringen geholt hat
 std::vector<MIDIEngine::MIDIMessage> MIDIEngine::getPendingMessages() {
-    std::lock_guard<std::mutex> lock(pImpl->queueMutex);
-    std::vector<MIDIMessage> messages;
-    while (!pImpl->messageQueue.empty()) {
-        messages.push_back(pImpl->messageQueue.front());
-        pImpl->messageQueue.pop();
-    }
+    std::lock_guard<std::mutex> lock(pImpl->pendingMutex);
+    std::vector<MIDIMessage> messages(pImpl->pendingMessages.begin(), pImpl->pendingMessages.end());
+    pImpl->pendingMessages.clear();
     return messages;
 }
 
+const std::vector<std::shared_ptr<MIDIEventQueue>>& MIDIEngine::getAudioQueues() const {
+    return pImpl->audioQueues;
+}
+
 void MIDIEngine::startClock() {
     if (pImpl->isClockRunning) return;
 
@@ -339,21 +395,28 @@ void MIDIEngine::clearRecording() {
     pImpl->recordedMessages.clear();
 }
 
-void MIDIEngine::handleMIDIInput(double timeStamp, std::vector<unsigned char>* message) {
-    if (!message || message->empty()) return;
+void MIDIEngine::inputCallback(double timeStamp, std::vector<unsigned char>* message, void* userData) {
+    auto* slot = static_cast<Impl::InputSlot*>(userData);
+    slot->engine->handleMIDIInput(slot->port, timeStamp, message);
+}
 
-    MIDIMessage midiMessage;
-    midiMessage.timestamp = timeStamp;
+void MIDIEngine::handleMIDIInput(size_t port, double timeStamp, std::vector<unsigned char>* message) {
+    if (!message || message->empty()) return;
 
-    uint8_t status = message->at(0);
-    midiMessage.channel = status & 0x0F;
-    midiMessage.type = static_cast<MIDIMessage::Type>(status & 0xF0);
+    // Nur Kanalnachrichten; SysEx und System-Realtime gehen nicht an den Audio-Thread
+    const uint8_t status = message->at(0);
+    if (status < 0x80 || status >= 0xF0) return;
 
-    if (message->size() > 1) midiMessage.data1 = message->at(1);
-    if (message->size() > 2) midiMessage.data2 = message->at(2);
+    // RtMidi liefert nur Deltas; für die Blockplatzierung zählt der Empfangszeitpunkt
+    TimedMIDIEvent event;
+    event.timestamp = MIDIEventQueue::now();
+    event.status = status;
+    event.data1 = message->size() > 1 ? message->at(1) : 0;
+    event.data2 = message->size() > 2 ? message->at(2) : 0;
 
-    std::lock_guard<std::mutex> lock(pImpl->queueMutex);
-    pImpl->messageQueue.push(midiMessage);
+    // Kein Lock: Audio-Thread und Kontroll-Thread haben je einen eigenen Ring
+    pImpl->audioQueues[port]->push(event);
+    pImpl->controlQueues[port]->push(event);
 }
 
 void MIDIEngine::recordMessage(const MIDIMessage& message) {
@@ -1,6 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+#include <RtMidi.h>
+#include "MIDIEventQueue.hpp"
 
 namespace VR_DAW {
 
@@ -21,4 +31,100 @@ struct MIDIMessage {
     uint8_t value2;
 };
 
-} // namespace VR_DAW 
\ No newline at end of file
+class MIDIEngine {
+public:
+    // Typwerte entsprechen dem Status-Nibble
+    struct MIDIMessage {
+        enum class Type : uint8_t {
+            NoteOff = 0x80,
+            NoteOn = 0x90,
+            PolyAftertouch = 0xA0,
+            ControlChange = 0xB0,
+            ProgramChange = 0xC0,
+            Aftertouch = 0xD0,
+            PitchBend = 0xE0
+        };
+
+        Type type;
+        uint8_t channel;
+        uint8_t data1;
+        uint8_t data2;
+        double timestamp;
+    };
+
+    struct MIDIDevice {
+        std::string name;
+        int id;
+        bool isInput;
+        bool isOutput;
+        bool isOpen;
+    };
+
+    // Ein SPSC-Ring pro gleichzeitig geöffnetem Eingang
+    static constexpr size_t kMaxInputPorts = 16;
+
+    MIDIEngine();
+    ~MIDIEngine();
+
+    void initialize();
+    void shutdown();
+
+    // Geräte
+    void scanDevices();
+    std::vector<MIDIDevice> getAvailableDevices() const;
+    bool openDevice(int deviceId);
+    void closeDevice(int deviceId);
+    bool isDeviceOpen(int deviceId) const;
+
+    // Senden
+    void sendMessage(const MIDIMessage& message);
+    void sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity);
+    void sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity);
+    void sendControlChange(uint8_t channel, uint8_t controller, uint8_t value);
+    void sendProgramChange(uint8_t channel, uint8_t program);
+    void sendPitchBend(uint8_t channel, uint16_t value);
+    void sendAftertouch(uint8_t channel, uint8_t value);
+
+    // Empfang im Kontroll-Thread (UI, Aufnahme)
+    void setMessageCallback(std::function<void(const MIDIMessage&)> callback);
+    // Einziger Consumer der Kontroll-Ringe
+    void processMessages();
+    // Seit dem letzten Aufruf von processMessages() geleerte Nachrichten
+    std::vector<MIDIMessage> getPendingMessages();
+
+    // Empfang im Audio-Thread: lock-freie, zeitgestempelte Ringe
+    const std::vector<std::shared_ptr<MIDIEventQueue>>& getAudioQueues() const;
+
+    // Clock
+    void startClock();
+    void stopClock();
+    void setTempo(double bpm);
+    double getTempo() const;
+    void setClockCallback(std::function<void(double)> callback);
+
+    // Aufnahme
+    void startRecording();
+    void stopRecording();
+    void pauseRecording();
+    bool isRecording() const;
+    std::vector<MIDIMessage> getRecordedMessages() const;
+    void clearRecording();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+
+    bool initialized;
+    std::atomic<bool> isClockRunning;
+    double tempo;
+    std::atomic<bool> isRecordingActive;
+
+    static void inputCallback(double timeStamp, std::vector<unsigned char>* message, void* userData);
+    void handleMIDIInput(size_t port, double timeStamp, std::vector<unsigned char>* message);
+    void recordMessage(const MIDIMessage& message);
+    void processMIDIEvent(const MIDIMessage& message);
+    bool validateMIDIMessage(const MIDIMessage& message);
+    void reinitializeDevice(int deviceId);
+};
+
+} // namespace VR_DAW
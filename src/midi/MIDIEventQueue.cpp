@@ -0,0 +1,110 @@
+#include "MIDIEventQueue.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace VR_DAW {
+
+MIDIEventQueue::MIDIEventQueue(size_t capacity)
+    : mask(0)
+    , head(0)
+    , tail(0)
+    , dropped(0)
+{
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    events = std::make_unique<TimedMIDIEvent[]>(size);
+    mask = size - 1;
+}
+
+bool MIDIEventQueue::push(const TimedMIDIEvent& event) {
+    const size_t currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail - head.load(std::memory_order_acquire) > mask) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    events[currentTail & mask] = event;
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+}
+
+bool MIDIEventQueue::peek(TimedMIDIEvent& event) const {
+    const size_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == tail.load(std::memory_order_acquire)) return false;
+
+    event = events[currentHead & mask];
+    return true;
+}
+
+bool MIDIEventQueue::pop(TimedMIDIEvent& event) {
+    const size_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == tail.load(std::memory_order_acquire)) return false;
+
+    event = events[currentHead & mask];
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+}
+
+bool MIDIEventQueue::empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
+
+size_t MIDIEventQueue::size() const {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+uint64_t MIDIEventQueue::getDroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t MIDIEventQueue::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+MIDIBlockEvents::MIDIBlockEvents()
+    : count(0)
+    , dropped(0)
+{
+}
+
+bool MIDIBlockEvents::add(uint32_t sampleOffset, uint8_t status, uint8_t data1, uint8_t data2) {
+    if (count == kCapacity) {
+        ++dropped;
+        return false;
+    }
+
+    // Von hinten einsortieren: Events kommen fast immer schon geordnet an
+    size_t position = count;
+    while (position > 0 && events[position - 1].sampleOffset > sampleOffset) {
+        events[position] = events[position - 1];
+        --position;
+    }
+    events[position] = {sampleOffset, status, data1, data2};
+    ++count;
+    return true;
+}
+
+void MIDIBlockEvents::collect(MIDIEventQueue& queue, uint64_t blockEndTime,
+                              uint32_t numFrames, double sampleRate) {
+    if (numFrames == 0 || sampleRate <= 0.0) return;
+
+    const double nanosecondsPerFrame = 1.0e9 / sampleRate;
+    const uint64_t blockDuration = static_cast<uint64_t>(numFrames * nanosecondsPerFrame);
+    const uint64_t blockStartTime = blockEndTime > blockDuration ? blockEndTime - blockDuration : 0;
+
+    TimedMIDIEvent event;
+    while (queue.peek(event) && event.timestamp <= blockEndTime) {
+        queue.pop(event);
+
+        // Verspätete Events (z.B. nach einem Xrun) landen am Blockanfang
+        uint32_t offset = 0;
+        if (event.timestamp > blockStartTime) {
+            offset = static_cast<uint32_t>((event.timestamp - blockStartTime) / nanosecondsPerFrame);
+            offset = std::min(offset, numFrames - 1);
+        }
+        add(offset, event.status, event.data1, event.data2);
+    }
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace VR_DAW {
+
+// Roh-MIDI-Event mit Empfangszeitpunkt (steady_clock, Nanosekunden)
+struct TimedMIDIEvent {
+    uint64_t timestamp;
+    uint8_t status;
+    uint8_t data1;
+    uint8_t data2;
+};
+
+// Wait-freier Single-Producer/Single-Consumer-Ring vom RtMidi-Thread
+// zum Audio-Thread. Pro MIDI-Eingang ein Ring, da jeder Eingang seinen
+// eigenen RtMidi-Thread hat. Ist der Ring voll, wird verworfen und gezählt.
+class MIDIEventQueue {
+public:
+    explicit MIDIEventQueue(size_t capacity = 1024);
+
+    // Producer
+    bool push(const TimedMIDIEvent& event);
+
+    // Consumer
+    bool peek(TimedMIDIEvent& event) const;
+    bool pop(TimedMIDIEvent& event);
+    bool empty() const;
+
+    size_t size() const;
+    uint64_t getDroppedCount() const;
+
+    // Gemeinsame Zeitbasis für Producer und Audio-Thread
+    static uint64_t now();
+
+private:
+    std::unique_ptr<TimedMIDIEvent[]> events;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head; // nur Consumer schreibt
+    alignas(64) std::atomic<size_t> tail; // nur Producer schreibt
+    std::atomic<uint64_t> dropped;
+};
+
+// MIDI-Events eines Render-Blocks, stabil nach Sample-Offset sortiert.
+// Feste Kapazität, damit der Audio-Thread nicht alloziert.
+class MIDIBlockEvents {
+public:
+    struct Event {
+        uint32_t sampleOffset;
+        uint8_t status;
+        uint8_t data1;
+        uint8_t data2;
+    };
+
+    static constexpr size_t kCapacity = 512;
+
+    MIDIBlockEvents();
+
+    void clear() { count = 0; }
+    // Sortiert einfügen; Events mit gleichem Offset behalten ihre Reihenfolge
+    bool add(uint32_t sampleOffset, uint8_t status, uint8_t data1, uint8_t data2);
+
+    // Übernimmt alle Events aus 'queue', die bis 'blockEndTime' empfangen
+    // wurden. Events werden um genau einen Block verzögert auf Offsets
+    // abgebildet, damit der Jitter unabhängig vom Callback-Zeitpunkt ist.
+    void collect(MIDIEventQueue& queue, uint64_t blockEndTime,
+                 uint32_t numFrames, double sampleRate);
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Event& operator[](size_t index) const { return events[index]; }
+    const Event* begin() const { return events.data(); }
+    const Event* end() const { return events.data() + count; }
+
+    uint64_t getDroppedCount() const { return dropped; }
+
+private:
+    std::array<Event, kCapacity> events;
+    size_t count;
+    uint64_t dropped;
+};
+
+} // namespace VR_DAW
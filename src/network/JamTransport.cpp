@@ -0,0 +1,1010 @@
+#include "JamTransport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace VR_DAW {
+
+namespace {
+
+// Sequenzabstand mit Überlauf
+inline int32_t sequenceDelta(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b);
+}
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// Kubische Hermite-Interpolation zwischen y1 und y2
+inline float hermite(float y0, float y1, float y2, float y3, float t) {
+    const float c1 = 0.5f * (y2 - y0);
+    const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+    const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+    return ((c3 * t + c2) * t + c1) * t + y1;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// JamJitterBuffer
+// ---------------------------------------------------------------------------
+
+struct JamJitterBuffer::Impl {
+    // Überblendung an Paketgrenzen mit PLC, in Frames
+    static constexpr size_t kCrossfadeFrames = 32;
+    // Gewicht der gleitenden Laufzeitstatistik je Paket
+    static constexpr double kTransitAlpha = 1.0 / 32.0;
+    // So lange muss die kleinere Zielgröße anliegen, bevor geschrumpft wird
+    static constexpr double kShrinkHoldSeconds = 2.0;
+    // PI-Regler für das Resampling-Verhältnis (Fehler in Paketen)
+    static constexpr double kProportionalGain = 0.002;
+    static constexpr double kIntegralGain = 0.001;    // je Sekunde
+    // Glättung des Füllstands, damit Jitter nicht als Tonhöhe hörbar wird
+    static constexpr double kFillSmoothingSeconds = 0.5;
+    static constexpr float kConcealDecay = 0.7f;
+    static constexpr float kConcealFirstGain = 0.9f;
+
+    Config config;
+    size_t packetSamples = 0;
+    double frameDuration = 0.0;
+
+    // Paket-Slots, Index = Sequenz & slotMask
+    size_t slotCount = 0;
+    size_t slotMask = 0;
+    std::vector<float> slotData;
+    std::vector<uint32_t> slotSequence;
+    std::vector<uint8_t> slotValid;
+    size_t bufferedPackets = 0;
+
+    bool started = false;
+    bool prefilling = true;
+    uint32_t firstSequence = 0;
+    uint32_t nextSequence = 0;
+    uint32_t highestSequence = 0;
+    uint64_t uniqueReceived = 0;
+    uint64_t previousLost = 0;  // aus früheren Streams
+
+    // Laufzeit = Ankunft - Medienzeit; Mittel und Varianz gleitend
+    bool haveTransit = false;
+    double transitMean = 0.0;
+    double transitVariance = 0.0;
+    uint32_t targetDepth = 1;
+    double shrinkHold = 0.0;
+
+    // Dekodierte Frames vor dem Resampler; Frame 0 ist Vorgeschichte
+    std::vector<float> fifo;
+    size_t fifoFrames = 0;
+    double readPosition = 1.0;
+
+    // PLC
+    std::vector<float> lastGood;
+    bool haveLastGood = false;
+    size_t concealRun = 0;
+    float currentGain = 1.0f;
+    bool lastWasConcealed = false;
+    std::vector<float> lastFrame;
+
+    // Regler
+    double ratio = 1.0;
+    double integral = 0.0;
+    double smoothedError = 0.0;
+
+    Stats stats;
+
+    explicit Impl(const Config& c) : config(c) {
+        config.channels = std::max<uint32_t>(1, config.channels);
+        config.frameSize = std::max<uint32_t>(1, config.frameSize);
+        config.minDepth = std::max<uint32_t>(1, config.minDepth);
+        config.maxDepth = std::max(config.minDepth, config.maxDepth);
+        packetSamples = static_cast<size_t>(config.channels) * config.frameSize;
+        frameDuration = config.frameSize / config.sampleRate;
+
+        slotCount = nextPowerOfTwo(static_cast<size_t>(config.maxDepth) * 2 + 16);
+        slotMask = slotCount - 1;
+        slotData.assign(slotCount * packetSamples, 0.0f);
+        slotSequence.assign(slotCount, 0);
+        slotValid.assign(slotCount, 0);
+
+        // Vorgeschichte + zwei Pakete + Interpolationsrand
+        fifo.assign((2 * config.frameSize + 8) * config.channels, 0.0f);
+        lastGood.assign(packetSamples, 0.0f);
+        lastFrame.assign(config.channels, 0.0f);
+        reset();
+    }
+
+    void reset() {
+        std::fill(slotValid.begin(), slotValid.end(), 0);
+        bufferedPackets = 0;
+        started = false;
+        prefilling = true;
+        uniqueReceived = 0;
+        previousLost = 0;
+        haveTransit = false;
+        transitMean = transitVariance = 0.0;
+        targetDepth = config.minDepth;
+        shrinkHold = 0.0;
+        std::fill(fifo.begin(), fifo.end(), 0.0f);
+        fifoFrames = 1;
+        readPosition = 1.0;
+        haveLastGood = false;
+        concealRun = 0;
+        currentGain = 1.0f;
+        lastWasConcealed = false;
+        std::fill(lastFrame.begin(), lastFrame.end(), 0.0f);
+        ratio = 1.0;
+        integral = 0.0;
+        smoothedError = 0.0;
+        stats = Stats();
+        stats.targetDepth = targetDepth;
+    }
+
+    void clearSlots() {
+        std::fill(slotValid.begin(), slotValid.end(), 0);
+        bufferedPackets = 0;
+    }
+
+    void startStream(uint32_t sequence) {
+        clearSlots();
+        started = true;
+        prefilling = true;
+        firstSequence = nextSequence = highestSequence = sequence;
+        uniqueReceived = 0;
+        haveTransit = false;
+    }
+
+    void updateTransit(uint32_t sequence, double arrivalTime) {
+        const double mediaTime = static_cast<double>(sequence - firstSequence) * frameDuration;
+        const double transit = arrivalTime - mediaTime;
+        if (!haveTransit) {
+            transitMean = transit;
+            transitVariance = 0.0;
+            haveTransit = true;
+        } else {
+            const double delta = transit - transitMean;
+            transitMean += kTransitAlpha * delta;
+            transitVariance = (1.0 - kTransitAlpha) * (transitVariance + kTransitAlpha * delta * delta);
+        }
+
+        const double deviation = std::sqrt(transitVariance);
+        const double wanted = std::ceil(config.safety * deviation / frameDuration) + 1.0;
+        const uint32_t depth = static_cast<uint32_t>(std::clamp(
+            wanted, static_cast<double>(config.minDepth), static_cast<double>(config.maxDepth)));
+
+        if (depth > targetDepth) {
+            targetDepth = depth;
+            shrinkHold = 0.0;
+        } else if (depth < targetDepth) {
+            shrinkHold += frameDuration;
+            if (shrinkHold >= kShrinkHoldSeconds) {
+                --targetDepth;
+                shrinkHold = 0.0;
+            }
+        } else {
+            shrinkHold = 0.0;
+        }
+        stats.jitterMs = deviation * 1000.0;
+        stats.targetDepth = targetDepth;
+    }
+
+    void insert(uint32_t sequence, double arrivalTime, const float* samples) {
+        if (!started) {
+            startStream(sequence);
+        }
+
+        int32_t delta = sequenceDelta(sequence, nextSequence);
+        // Weit außerhalb des Fensters: neuer Stream (z.B. Sender neu gestartet)
+        if (delta >= static_cast<int32_t>(slotCount) || delta < -static_cast<int32_t>(4 * slotCount)) {
+            previousLost += lostSoFar();
+            startStream(sequence);
+            delta = 0;
+        }
+
+        if (delta < 0) {
+            ++stats.late;
+            ++uniqueReceived;
+            return;
+        }
+
+        const size_t slot = sequence & slotMask;
+        if (slotValid[slot] && slotSequence[slot] == sequence) {
+            return;  // Duplikat
+        }
+        std::memcpy(slotData.data() + slot * packetSamples, samples, packetSamples * sizeof(float));
+        slotSequence[slot] = sequence;
+        slotValid[slot] = 1;
+        ++bufferedPackets;
+        ++uniqueReceived;
+        ++stats.received;
+
+        if (sequenceDelta(sequence, highestSequence) > 0) {
+            highestSequence = sequence;
+        }
+        updateTransit(sequence, arrivalTime);
+    }
+
+    uint64_t lostSoFar() const {
+        if (!started) return 0;
+        const uint64_t expected = static_cast<uint64_t>(highestSequence - firstSequence) + 1;
+        return expected > uniqueReceived ? expected - uniqueReceived : 0;
+    }
+
+    // Hängt ein Paket an den FIFO; Verstärkung rampt von currentGain auf
+    // gain, bei crossfade wird vom letzten ausgegebenen Frame übergeblendet
+    void append(const float* source, float gain, bool crossfade) {
+        const uint32_t channels = config.channels;
+        float* out = fifo.data() + fifoFrames * channels;
+        const float startGain = currentGain;
+        const float step = (gain - startGain) / static_cast<float>(config.frameSize);
+
+        for (size_t frame = 0; frame < config.frameSize; ++frame) {
+            const float g = startGain + step * static_cast<float>(frame + 1);
+            const bool blend = crossfade && frame < kCrossfadeFrames;
+            const float w = blend ? static_cast<float>(frame + 1) / (kCrossfadeFrames + 1) : 1.0f;
+            for (uint32_t ch = 0; ch < channels; ++ch) {
+                float value = source ? source[frame * channels + ch] * g : 0.0f;
+                if (blend) {
+                    value = w * value + (1.0f - w) * lastFrame[ch];
+                }
+                out[frame * channels + ch] = value;
+            }
+        }
+        std::memcpy(lastFrame.data(), out + (config.frameSize - 1) * channels, channels * sizeof(float));
+        fifoFrames += config.frameSize;
+        currentGain = gain;
+    }
+
+    void conceal() {
+        ++concealRun;
+        ++stats.concealed;
+        float gain = 0.0f;
+        if (haveLastGood && concealRun <= kMaxConcealedPackets) {
+            gain = kConcealFirstGain * std::pow(kConcealDecay, static_cast<float>(concealRun - 1));
+        }
+        append(haveLastGood ? lastGood.data() : nullptr, gain, true);
+        lastWasConcealed = true;
+    }
+
+    bool findEarliestBuffered() {
+        for (size_t i = 0; i < slotCount; ++i) {
+            const uint32_t sequence = nextSequence + static_cast<uint32_t>(i);
+            const size_t slot = sequence & slotMask;
+            if (slotValid[slot] && slotSequence[slot] == sequence) {
+                nextSequence = sequence;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void dropOldest() {
+        const size_t slot = nextSequence & slotMask;
+        if (slotValid[slot] && slotSequence[slot] == nextSequence) {
+            slotValid[slot] = 0;
+            --bufferedPackets;
+        }
+        ++nextSequence;
+    }
+
+    // Holt das nächste Paket (echt oder verdeckt) in den FIFO
+    void fetchPacket() {
+        if (prefilling) {
+            if (!started || bufferedPackets < targetDepth || !findEarliestBuffered()) {
+                conceal();
+                return;
+            }
+            prefilling = false;
+        }
+
+        // Harte Grenze, falls der Regler nicht hinterherkommt
+        while (bufferedPackets > config.maxDepth + 1) {
+            dropOldest();
+        }
+
+        const size_t slot = nextSequence & slotMask;
+        if (slotValid[slot] && slotSequence[slot] == nextSequence) {
+            const float* data = slotData.data() + slot * packetSamples;
+            append(data, 1.0f, lastWasConcealed);
+            std::memcpy(lastGood.data(), data, packetSamples * sizeof(float));
+            haveLastGood = true;
+            concealRun = 0;
+            lastWasConcealed = false;
+            slotValid[slot] = 0;
+            --bufferedPackets;
+            ++nextSequence;
+        } else if (bufferedPackets > 0) {
+            // Verloren oder noch unterwegs, aber spätere Pakete sind da
+            conceal();
+            ++nextSequence;
+        } else {
+            // Leergelaufen: verdecken und neu vorpuffern, ohne Sequenzen zu verwerfen
+            ++stats.underruns;
+            prefilling = true;
+            conceal();
+        }
+    }
+
+    void compact() {
+        const size_t base = static_cast<size_t>(readPosition);
+        if (base <= 1) return;
+        const size_t drop = base - 1;
+        const uint32_t channels = config.channels;
+        std::memmove(fifo.data(), fifo.data() + drop * channels,
+                     (fifoFrames - drop) * channels * sizeof(float));
+        fifoFrames -= drop;
+        readPosition -= static_cast<double>(drop);
+    }
+
+    void updateRatio(size_t frames) {
+        if (prefilling) {
+            smoothedError = 0.0;
+            ratio = 1.0;
+            return;
+        }
+        const double fifoPackets = (static_cast<double>(fifoFrames) - readPosition) / config.frameSize;
+        const double fill = static_cast<double>(bufferedPackets) + fifoPackets;
+        const double error = fill - static_cast<double>(targetDepth);
+        const double seconds = frames / config.sampleRate;
+        smoothedError += std::min(1.0, seconds / kFillSmoothingSeconds) * (error - smoothedError);
+
+        // Große Abweichungen (neue Zielgröße) regelt der P-Anteil aus; nur die
+        // bleibende kleine Abweichung durch Taktdrift wird aufintegriert
+        if (std::abs(smoothedError) < 0.5) {
+            integral = std::clamp(integral + kIntegralGain * smoothedError * seconds,
+                                  -kMaxRatioDeviation, kMaxRatioDeviation);
+        }
+        ratio = 1.0 + std::clamp(kProportionalGain * smoothedError + integral,
+                                 -kMaxRatioDeviation, kMaxRatioDeviation);
+
+        stats.bufferedMs = fill * frameDuration * 1000.0;
+    }
+
+    void read(float* output, size_t frames) {
+        const uint32_t channels = config.channels;
+        for (size_t i = 0; i < frames; ++i) {
+            size_t base = static_cast<size_t>(readPosition);
+            while (base + 3 > fifoFrames) {
+                compact();
+                fetchPacket();
+                base = static_cast<size_t>(readPosition);
+            }
+            const float t = static_cast<float>(readPosition - static_cast<double>(base));
+            const float* p = fifo.data() + (base - 1) * channels;
+            for (uint32_t ch = 0; ch < channels; ++ch) {
+                output[i * channels + ch] = hermite(p[ch], p[channels + ch],
+                                                    p[2 * channels + ch], p[3 * channels + ch], t);
+            }
+            readPosition += ratio;
+        }
+        compact();
+        updateRatio(frames);
+
+        stats.lost = previousLost + lostSoFar();
+        stats.ratio = ratio;
+    }
+};
+
+JamJitterBuffer::JamJitterBuffer()
+    : JamJitterBuffer(Config())
+{
+}
+
+JamJitterBuffer::JamJitterBuffer(const Config& config)
+    : pImpl(std::make_unique<Impl>(config))
+{
+}
+
+JamJitterBuffer::~JamJitterBuffer() = default;
+
+void JamJitterBuffer::insert(uint32_t sequence, double arrivalTime, const float* samples) {
+    pImpl->insert(sequence, arrivalTime, samples);
+}
+
+void JamJitterBuffer::read(float* output, size_t frames) {
+    pImpl->read(output, frames);
+}
+
+void JamJitterBuffer::reset() {
+    pImpl->reset();
+}
+
+JamJitterBuffer::Stats JamJitterBuffer::getStats() const {
+    return pImpl->stats;
+}
+
+const JamJitterBuffer::Config& JamJitterBuffer::getConfig() const {
+    return pImpl->config;
+}
+
+// ---------------------------------------------------------------------------
+// JamTransport
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// Paketkopf, little-endian:
+//  0 u32 Magic  4 u8 Version  5 u8 Typ  6 u8 Codec  7 u8 Kanäle
+//  8 u16 Frames  10 u16 reserviert  12 u32 Sequenz  16 u64 Zeitstempel
+// Audio: Zeitstempel = Sample-Position; Ping/Pong: Sendezeit in ns
+constexpr uint32_t kMagic = 0x544a5256;  // "VRJT"
+constexpr uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = 24;
+constexpr size_t kMaxDatagram = JamTransport::kMaxDatagramSize;
+constexpr size_t kRingCapacity = 512;
+constexpr size_t kMaxQueuedMessages = 1024;
+
+enum class PacketType : uint8_t {
+    Audio = 1,
+    Ping = 2,
+    Pong = 3,
+    Message = 4
+};
+
+inline void put16(uint8_t* p, uint16_t v) { p[0] = v & 0xff; p[1] = v >> 8; }
+inline void put32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (v >> (8 * i)) & 0xff; }
+inline void put64(uint8_t* p, uint64_t v) { for (int i = 0; i < 8; ++i) p[i] = (v >> (8 * i)) & 0xff; }
+inline uint16_t get16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+inline uint32_t get32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+inline uint64_t get64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+void writeHeader(uint8_t* p, PacketType type, uint8_t codec, uint8_t channels,
+                 uint16_t frames, uint32_t sequence, uint64_t timestamp) {
+    put32(p, kMagic);
+    p[4] = kVersion;
+    p[5] = static_cast<uint8_t>(type);
+    p[6] = codec;
+    p[7] = channels;
+    put16(p + 8, frames);
+    put16(p + 10, 0);
+    put32(p + 12, sequence);
+    put64(p + 16, timestamp);
+}
+
+size_t bytesPerSample(JamTransport::Codec codec) {
+    return codec == JamTransport::Codec::Float32 ? 4 : 2;
+}
+
+} // namespace
+
+struct JamTransport::Impl {
+    struct RingSlot {
+        uint32_t sequence;
+        double arrival;
+    };
+
+    struct DelayedPacket {
+        double release;
+        std::vector<uint8_t> data;
+    };
+
+    Config config;
+    size_t packetSamples = 0;
+    size_t datagramSize = 0;
+    std::chrono::steady_clock::time_point epoch;
+
+    std::atomic<int> socket{-1};
+    uint16_t localPort = 0;
+    // Adresse und Port der Gegenstelle in einem Wort (0 = unbekannt), damit
+    // Audio-, Empfangs- und Kontroll-Thread sie ohne Lock teilen
+    std::atomic<uint64_t> peer{0};
+    // Per setPeer() festgelegt: dann wird keine Gegenstelle gelernt
+    std::atomic<bool> peerFixed{false};
+    std::thread receiver;
+    std::atomic<bool> running{false};
+
+    // Senden (Audio-Thread)
+    std::vector<float> pending;
+    size_t pendingFrames = 0;
+    uint32_t sequence = 0;
+    uint64_t samplePosition = 0;
+    std::vector<uint8_t> sendBuffer;
+
+    // Ring vom Empfangs-Thread zum Audio-Thread
+    std::unique_ptr<RingSlot[]> ringSlots;
+    std::vector<float> ringSamples;
+    alignas(64) std::atomic<size_t> ringHead{0};  // nur Consumer schreibt
+    alignas(64) std::atomic<size_t> ringTail{0};  // nur Producer schreibt
+
+    JamJitterBuffer jitter;
+
+    // Empfangs-Thread
+    std::vector<uint8_t> receiveBuffer;
+    std::mt19937 random;
+    std::vector<DelayedPacket> delayed;
+    double nextPing = 0.0;
+
+    std::mutex messageMutex;
+    std::deque<std::pair<std::string, std::vector<uint8_t>>> messages;
+
+    // Für den Kontroll-Thread veröffentlicht
+    std::atomic<uint64_t> packetsSent{0};
+    std::atomic<uint64_t> packetsReceived{0};
+    std::atomic<uint64_t> packetsLost{0};
+    std::atomic<uint64_t> packetsLate{0};
+    std::atomic<uint64_t> packetsConcealed{0};
+    std::atomic<uint64_t> underruns{0};
+    std::atomic<uint64_t> decodeErrors{0};
+    std::atomic<uint64_t> ringOverflows{0};
+    std::atomic<double> roundTripMs{-1.0};
+    std::atomic<double> jitterMs{0.0};
+    std::atomic<double> bufferedMs{0.0};
+    std::atomic<uint32_t> targetDepth{0};
+    std::atomic<double> resampleRatio{1.0};
+
+    static JamJitterBuffer::Config jitterConfig(const Config& c) {
+        JamJitterBuffer::Config jc;
+        jc.channels = c.channels;
+        jc.frameSize = c.frameSize;
+        jc.sampleRate = c.sampleRate;
+        jc.minDepth = c.minBufferDepth;
+        jc.maxDepth = c.maxBufferDepth;
+        jc.safety = c.jitterSafety;
+        return jc;
+    }
+
+    explicit Impl(const Config& c)
+        : config(c)
+        , epoch(std::chrono::steady_clock::now())
+        , jitter(jitterConfig(c))
+        , random(c.injectionSeed)
+    {
+        if (config.channels == 0 || config.channels > 255 || config.frameSize == 0 || config.frameSize > 65535) {
+            throw std::invalid_argument("JamTransport: ungültige Kanal- oder Paketgröße");
+        }
+        packetSamples = static_cast<size_t>(config.channels) * config.frameSize;
+        datagramSize = kHeaderSize + packetSamples * bytesPerSample(config.codec);
+        if (datagramSize > kMaxDatagram) {
+            throw std::invalid_argument("JamTransport: Paket passt nicht in ein UDP-Datagramm");
+        }
+
+        pending.assign(packetSamples, 0.0f);
+        sendBuffer.assign(datagramSize, 0);
+        ringSlots = std::make_unique<RingSlot[]>(kRingCapacity);
+        ringSamples.assign(kRingCapacity * packetSamples, 0.0f);
+        receiveBuffer.assign(kMaxDatagram, 0);
+    }
+
+    double now() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    static uint64_t packEndpoint(const sockaddr_in& address) {
+        return (uint64_t{1} << 48) | (static_cast<uint64_t>(address.sin_addr.s_addr) << 16) | address.sin_port;
+    }
+
+    static sockaddr_in unpackEndpoint(uint64_t endpoint) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = static_cast<uint32_t>(endpoint >> 16);
+        address.sin_port = static_cast<uint16_t>(endpoint);
+        return address;
+    }
+
+    void sendDatagram(const uint8_t* data, size_t size) {
+        const int fd = socket.load(std::memory_order_acquire);
+        const uint64_t endpoint = peer.load(std::memory_order_acquire);
+        if (fd < 0 || endpoint == 0) return;
+        const sockaddr_in address = unpackEndpoint(endpoint);
+        ::sendto(fd, data, size, MSG_DONTWAIT, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    }
+
+    void sendPing() {
+        uint8_t packet[kHeaderSize];
+        const uint64_t timestamp = static_cast<uint64_t>(now() * 1e9);
+        writeHeader(packet, PacketType::Ping, 0, 0, 0, 0, timestamp);
+        sendDatagram(packet, sizeof(packet));
+    }
+
+    void encodeAndSend() {
+        uint8_t* p = sendBuffer.data();
+        writeHeader(p, PacketType::Audio, static_cast<uint8_t>(config.codec),
+                    static_cast<uint8_t>(config.channels), static_cast<uint16_t>(config.frameSize),
+                    sequence, samplePosition);
+        uint8_t* payload = p + kHeaderSize;
+
+        if (config.codec == Codec::Float32) {
+            for (size_t i = 0; i < packetSamples; ++i) {
+                uint32_t bits;
+                std::memcpy(&bits, &pending[i], sizeof(bits));
+                put32(payload + 4 * i, bits);
+            }
+        } else {
+            for (size_t i = 0; i < packetSamples; ++i) {
+                const float s = std::clamp(pending[i], -1.0f, 1.0f);
+                put16(payload + 2 * i, static_cast<uint16_t>(static_cast<int16_t>(std::lrint(s * 32767.0f))));
+            }
+        }
+
+        sendDatagram(p, datagramSize);
+        packetsSent.fetch_add(1, std::memory_order_relaxed);
+        ++sequence;
+        samplePosition += config.frameSize;
+    }
+
+    void pushAudio(const uint8_t* data, size_t size, double arrival) {
+        const uint8_t codec = data[6];
+        const uint8_t channels = data[7];
+        const uint16_t frames = get16(data + 8);
+        if (codec != static_cast<uint8_t>(config.codec) || channels != config.channels ||
+            frames != config.frameSize || size != datagramSize) {
+            decodeErrors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const size_t tail = ringTail.load(std::memory_order_relaxed);
+        if (tail - ringHead.load(std::memory_order_acquire) >= kRingCapacity) {
+            ringOverflows.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const size_t index = tail & (kRingCapacity - 1);
+        float* out = ringSamples.data() + index * packetSamples;
+        const uint8_t* payload = data + kHeaderSize;
+        if (config.codec == Codec::Float32) {
+            for (size_t i = 0; i < packetSamples; ++i) {
+                const uint32_t bits = get32(payload + 4 * i);
+                std::memcpy(&out[i], &bits, sizeof(float));
+            }
+        } else {
+            for (size_t i = 0; i < packetSamples; ++i) {
+                out[i] = static_cast<int16_t>(get16(payload + 2 * i)) / 32767.0f;
+            }
+        }
+        ringSlots[index] = {get32(data + 12), arrival};
+        ringTail.store(tail + 1, std::memory_order_release);
+    }
+
+    void handleDatagram(const uint8_t* data, size_t size, double arrival) {
+        if (size < kHeaderSize || get32(data) != kMagic || data[4] != kVersion) {
+            decodeErrors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        switch (static_cast<PacketType>(data[5])) {
+            case PacketType::Audio:
+                pushAudio(data, size, arrival);
+                break;
+            case PacketType::Ping: {
+                uint8_t reply[kHeaderSize];
+                std::memcpy(reply, data, kHeaderSize);
+                reply[5] = static_cast<uint8_t>(PacketType::Pong);
+                sendDatagram(reply, sizeof(reply));
+                break;
+            }
+            case PacketType::Pong: {
+                const double sent = static_cast<double>(get64(data + 16)) * 1e-9;
+                const double rtt = std::max(0.0, now() - sent) * 1000.0;
+                const double previous = roundTripMs.load(std::memory_order_relaxed);
+                roundTripMs.store(previous < 0.0 ? rtt : previous + 0.125 * (rtt - previous),
+                                  std::memory_order_relaxed);
+                break;
+            }
+            case PacketType::Message: {
+                if (size < kHeaderSize + 1) break;
+                const size_t nameLength = data[kHeaderSize];
+                if (size < kHeaderSize + 1 + nameLength) {
+                    decodeErrors.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                const uint8_t* name = data + kHeaderSize + 1;
+                std::lock_guard<std::mutex> lock(messageMutex);
+                if (messages.size() < kMaxQueuedMessages) {
+                    messages.emplace_back(std::string(reinterpret_cast<const char*>(name), nameLength),
+                                          std::vector<uint8_t>(name + nameLength, data + size));
+                }
+                break;
+            }
+            default:
+                decodeErrors.fetch_add(1, std::memory_order_relaxed);
+                break;
+        }
+    }
+
+    void receiveLoop() {
+        const int fd = socket.load();
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        while (running.load(std::memory_order_acquire)) {
+            // Höchstens 5 ms warten, damit verzögerte Pakete pünktlich kommen
+            double wait = 0.005;
+            if (!delayed.empty()) {
+                wait = std::min(wait, std::max(0.0, delayed.front().release - now()));
+            }
+            pollfd descriptor{fd, POLLIN, 0};
+            const int ready = ::poll(&descriptor, 1, static_cast<int>(std::ceil(wait * 1000.0)));
+
+            if (ready > 0 && (descriptor.revents & POLLIN)) {
+                for (;;) {
+                    sockaddr_in source{};
+                    socklen_t sourceLength = sizeof(source);
+                    const ssize_t received = ::recvfrom(fd, receiveBuffer.data(), receiveBuffer.size(),
+                                                        MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&source),
+                                                        &sourceLength);
+                    if (received <= 0) break;
+                    const double arrival = now();
+
+                    // Nur die Gegenstelle zählt; ohne setPeer() ist das der
+                    // Absender des ersten Pakets
+                    const uint64_t endpoint = packEndpoint(source);
+                    uint64_t known = peer.load(std::memory_order_acquire);
+                    if (known == 0 && !peerFixed.load(std::memory_order_acquire)) {
+                        peer.compare_exchange_strong(known, endpoint, std::memory_order_acq_rel);
+                        known = peer.load(std::memory_order_acquire);
+                    }
+                    if (known != endpoint) continue;
+
+                    const size_t size = static_cast<size_t>(received);
+                    const bool audio = size >= kHeaderSize && receiveBuffer[5] == static_cast<uint8_t>(PacketType::Audio);
+                    if (audio && config.injectedLoss > 0.0 && uniform(random) < config.injectedLoss) {
+                        continue;
+                    }
+                    if (audio && config.injectedJitterMs > 0.0) {
+                        const double release = arrival + uniform(random) * config.injectedJitterMs * 0.001;
+                        DelayedPacket packet{release, std::vector<uint8_t>(receiveBuffer.begin(), receiveBuffer.begin() + size)};
+                        auto it = std::upper_bound(delayed.begin(), delayed.end(), release,
+                                                   [](double r, const DelayedPacket& d) { return r < d.release; });
+                        delayed.insert(it, std::move(packet));
+                        continue;
+                    }
+                    handleDatagram(receiveBuffer.data(), size, arrival);
+                }
+            }
+
+            const double current = now();
+            size_t released = 0;
+            while (released < delayed.size() && delayed[released].release <= current) {
+                handleDatagram(delayed[released].data.data(), delayed[released].data.size(),
+                               delayed[released].release);
+                ++released;
+            }
+            delayed.erase(delayed.begin(), delayed.begin() + released);
+
+            if (peer.load(std::memory_order_acquire) != 0 && current >= nextPing) {
+                sendPing();
+                nextPing = current + config.pingIntervalMs * 0.001;
+            }
+        }
+    }
+
+    void publish() {
+        const JamJitterBuffer::Stats stats = jitter.getStats();
+        packetsReceived.store(stats.received + stats.late, std::memory_order_relaxed);
+        packetsLost.store(stats.lost, std::memory_order_relaxed);
+        packetsLate.store(stats.late, std::memory_order_relaxed);
+        packetsConcealed.store(stats.concealed, std::memory_order_relaxed);
+        underruns.store(stats.underruns, std::memory_order_relaxed);
+        jitterMs.store(stats.jitterMs, std::memory_order_relaxed);
+        bufferedMs.store(stats.bufferedMs, std::memory_order_relaxed);
+        targetDepth.store(stats.targetDepth, std::memory_order_relaxed);
+        resampleRatio.store(stats.ratio, std::memory_order_relaxed);
+    }
+};
+
+JamTransport::JamTransport()
+    : JamTransport(Config())
+{
+}
+
+JamTransport::JamTransport(const Config& config)
+    : pImpl(std::make_unique<Impl>(config))
+{
+}
+
+JamTransport::~JamTransport() {
+    close();
+}
+
+bool JamTransport::open(uint16_t port) {
+    if (isOpen()) return false;
+
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return false;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    pImpl->localPort = ntohs(address.sin_port);
+
+    // Stream-Zustand zurücksetzen; Audio-Threads dürfen hier nicht laufen
+    pImpl->jitter.reset();
+    pImpl->pendingFrames = 0;
+    pImpl->sequence = 0;
+    pImpl->samplePosition = 0;
+    pImpl->ringHead.store(0);
+    pImpl->ringTail.store(0);
+    pImpl->delayed.clear();
+    pImpl->nextPing = 0.0;
+    pImpl->roundTripMs.store(-1.0);
+    pImpl->packetsSent.store(0);
+    pImpl->decodeErrors.store(0);
+    pImpl->ringOverflows.store(0);
+    pImpl->publish();
+
+    pImpl->socket.store(fd, std::memory_order_release);
+    pImpl->running.store(true, std::memory_order_release);
+    pImpl->receiver = std::thread([this] { pImpl->receiveLoop(); });
+    return true;
+}
+
+void JamTransport::close() {
+    if (!isOpen()) return;
+
+    pImpl->running.store(false, std::memory_order_release);
+    if (pImpl->receiver.joinable()) {
+        pImpl->receiver.join();
+    }
+    const int fd = pImpl->socket.exchange(-1);
+    ::close(fd);
+    pImpl->peer.store(0, std::memory_order_release);
+    pImpl->peerFixed.store(false, std::memory_order_release);
+    pImpl->localPort = 0;
+}
+
+bool JamTransport::isOpen() const {
+    return pImpl->socket.load(std::memory_order_acquire) >= 0;
+}
+
+uint16_t JamTransport::getLocalPort() const {
+    return pImpl->localPort;
+}
+
+bool JamTransport::setPeer(const std::string& address, uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    if (::getaddrinfo(address.c_str(), nullptr, &hints, &result) != 0 || !result) {
+        return false;
+    }
+
+    sockaddr_in peer{};
+    std::memcpy(&peer, result->ai_addr, sizeof(peer));
+    ::freeaddrinfo(result);
+    peer.sin_port = htons(port);
+
+    // Erst festlegen, dann setzen: der Empfangs-Thread lernt ab jetzt nichts mehr
+    pImpl->peerFixed.store(true, std::memory_order_release);
+    pImpl->peer.store(Impl::packEndpoint(peer), std::memory_order_release);
+    return true;
+}
+
+bool JamTransport::hasPeer() const {
+    return pImpl->peer.load(std::memory_order_acquire) != 0;
+}
+
+void JamTransport::send(const float* interleaved, size_t frames) {
+    const size_t channels = pImpl->config.channels;
+    const size_t frameSize = pImpl->config.frameSize;
+    while (frames > 0) {
+        const size_t count = std::min(frames, frameSize - pImpl->pendingFrames);
+        std::memcpy(pImpl->pending.data() + pImpl->pendingFrames * channels, interleaved,
+                    count * channels * sizeof(float));
+        pImpl->pendingFrames += count;
+        interleaved += count * channels;
+        frames -= count;
+
+        if (pImpl->pendingFrames == frameSize) {
+            pImpl->encodeAndSend();
+            pImpl->pendingFrames = 0;
+        }
+    }
+}
+
+void JamTransport::receive(float* interleaved, size_t frames) {
+    size_t head = pImpl->ringHead.load(std::memory_order_relaxed);
+    const size_t tail = pImpl->ringTail.load(std::memory_order_acquire);
+    while (head != tail) {
+        const size_t index = head & (kRingCapacity - 1);
+        const Impl::RingSlot& slot = pImpl->ringSlots[index];
+        pImpl->jitter.insert(slot.sequence, slot.arrival,
+                             pImpl->ringSamples.data() + index * pImpl->packetSamples);
+        ++head;
+    }
+    pImpl->ringHead.store(head, std::memory_order_release);
+
+    pImpl->jitter.read(interleaved, frames);
+    pImpl->publish();
+}
+
+void JamTransport::sendMessage(const std::string& channel, const void* data, size_t size) {
+    const size_t headroom = getMessageHeadroom(channel);
+    if (headroom + size > kMaxDatagram) return;
+
+    std::vector<uint8_t> packet(headroom + size);
+    if (size > 0) {
+        std::memcpy(packet.data() + headroom, data, size);
+    }
+    sendMessageInPlace(channel, packet.data(), size);
+}
+
+size_t JamTransport::getMessageHeadroom(const std::string& channel) const {
+    return kHeaderSize + 1 + std::min<size_t>(channel.size(), 255);
+}
+
+void JamTransport::sendMessageInPlace(const std::string& channel, uint8_t* packet, size_t payloadSize) {
+    const size_t nameLength = std::min<size_t>(channel.size(), 255);
+    const size_t total = kHeaderSize + 1 + nameLength + payloadSize;
+    if (total > kMaxDatagram) return;
+
+    writeHeader(packet, PacketType::Message, 0, 0, 0, 0, 0);
+    packet[kHeaderSize] = static_cast<uint8_t>(nameLength);
+    std::memcpy(packet + kHeaderSize + 1, channel.data(), nameLength);
+    pImpl->sendDatagram(packet, total);
+}
+
+bool JamTransport::pollMessage(std::string& channel, std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> lock(pImpl->messageMutex);
+    if (pImpl->messages.empty()) return false;
+    channel = std::move(pImpl->messages.front().first);
+    data = std::move(pImpl->messages.front().second);
+    pImpl->messages.pop_front();
+    return true;
+}
+
+float JamTransport::getLatency() const {
+    const double roundTrip = std::max(0.0, pImpl->roundTripMs.load(std::memory_order_relaxed));
+    const double packetization = 1000.0 * pImpl->config.frameSize / pImpl->config.sampleRate;
+    return static_cast<float>(roundTrip * 0.5 + packetization +
+                              pImpl->bufferedMs.load(std::memory_order_relaxed));
+}
+
+float JamTransport::getPacketLoss() const {
+    const double lost = static_cast<double>(pImpl->packetsLost.load(std::memory_order_relaxed));
+    const double received = static_cast<double>(pImpl->packetsReceived.load(std::memory_order_relaxed));
+    return lost + received > 0.0 ? static_cast<float>(lost / (lost + received)) : 0.0f;
+}
+
+JamTransport::Stats JamTransport::getStats() const {
+    Stats stats;
+    stats.packetsSent = pImpl->packetsSent.load(std::memory_order_relaxed);
+    stats.packetsReceived = pImpl->packetsReceived.load(std::memory_order_relaxed);
+    stats.packetsLost = pImpl->packetsLost.load(std::memory_order_relaxed);
+    stats.packetsLate = pImpl->packetsLate.load(std::memory_order_relaxed);
+    stats.packetsConcealed = pImpl->packetsConcealed.load(std::memory_order_relaxed);
+    stats.underruns = pImpl->underruns.load(std::memory_order_relaxed);
+    stats.decodeErrors = pImpl->decodeErrors.load(std::memory_order_relaxed);
+    stats.ringOverflows = pImpl->ringOverflows.load(std::memory_order_relaxed);
+    stats.roundTripMs = std::max(0.0, pImpl->roundTripMs.load(std::memory_order_relaxed));
+    stats.jitterMs = pImpl->jitterMs.load(std::memory_order_relaxed);
+    stats.bufferedMs = pImpl->bufferedMs.load(std::memory_order_relaxed);
+    stats.targetDepth = pImpl->targetDepth.load(std::memory_order_relaxed);
+    stats.resampleRatio = pImpl->resampleRatio.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const JamTransport::Config& JamTransport::getConfig() const {
+    return pImpl->config;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VR_DAW {
+
+// Adaptiver Jitter-Puffer für einen Audio-Stream aus festen Paketen.
+//
+// Die Zielgröße richtet sich nach der gemessenen Streuung der Laufzeit
+// (Ankunft minus Medienzeit des Pakets): Ziel = safety * Standardabweichung
+// plus ein Paket. Steigt die Streuung, wächst der Puffer sofort; fällt sie,
+// schrumpft er langsam.
+//
+// Fehlende Pakete werden verdeckt (PLC): das letzte gute Paket wird mit
+// abnehmendem Pegel wiederholt, Übergänge werden kurz überblendet. Nach
+// kMaxConcealedPackets Verlusten in Folge bleibt es still.
+//
+// Gegen Taktdrift zwischen Sender und Empfänger wird asynchron resampelt
+// (kubische Hermite-Interpolation). Ein PI-Regler hält den Füllstand auf
+// dem Ziel, die Abweichung vom Verhältnis 1 ist auf kMaxRatioDeviation
+// begrenzt.
+//
+// Nicht thread-sicher; gehört dem Audio-Thread und alloziert nach der
+// Konstruktion nicht mehr.
+class JamJitterBuffer {
+public:
+    static constexpr size_t kMaxConcealedPackets = 8;
+    static constexpr double kMaxRatioDeviation = 0.002;
+
+    struct Config {
+        uint32_t channels = 2;
+        uint32_t frameSize = 128;      // Frames je Paket
+        double sampleRate = 48000.0;
+        uint32_t minDepth = 1;         // Pakete
+        uint32_t maxDepth = 32;
+        double safety = 3.0;
+    };
+
+    struct Stats {
+        uint64_t received = 0;     // eingefügte Pakete
+        uint64_t lost = 0;         // nie angekommen (laut Sequenznummern)
+        uint64_t late = 0;         // nach ihrem Abspielzeitpunkt angekommen
+        uint64_t concealed = 0;    // durch PLC ersetzte Pakete
+        uint64_t underruns = 0;    // Puffer leergelaufen
+        double jitterMs = 0.0;     // Standardabweichung der Laufzeit
+        uint32_t targetDepth = 0;  // Pakete
+        double bufferedMs = 0.0;   // gepuffert inklusive Resampler-FIFO
+        double ratio = 1.0;        // Eingangs- je Ausgangs-Frame
+    };
+
+    JamJitterBuffer();
+    explicit JamJitterBuffer(const Config& config);
+    ~JamJitterBuffer();
+
+    JamJitterBuffer(const JamJitterBuffer&) = delete;
+    JamJitterBuffer& operator=(const JamJitterBuffer&) = delete;
+
+    // arrivalTime in Sekunden auf der Uhr des Empfängers; samples hat
+    // channels * frameSize Werte, interleaved
+    void insert(uint32_t sequence, double arrivalTime, const float* samples);
+
+    // Füllt immer genau frames Frames (interleaved), notfalls mit PLC oder Stille
+    void read(float* output, size_t frames);
+
+    void reset();
+    Stats getStats() const;
+    const Config& getConfig() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+// UDP-Transport für Jam-Sessions: ein mehrkanaliger PCM-Stream je Richtung
+// plus unzuverlässige Kontrollnachrichten, ohne externe Abhängigkeiten.
+//
+// send() paketiert in Pakete zu frameSize Frames mit Sequenznummer und
+// schickt sie nicht-blockierend direkt aus dem Audio-Thread. Ein
+// Empfangs-Thread dekodiert eingehende Pakete und reicht sie über einen
+// wait-freien Ring an receive() weiter, das sie in einen JamJitterBuffer
+// einsortiert. Die Umlaufzeit wird per Ping/Pong gemessen.
+//
+// Für Tests lassen sich auf der Empfangsseite Verlust und zusätzlicher
+// Jitter einspeisen. Nur IPv4.
+class JamTransport {
+public:
+    static constexpr size_t kMaxDatagramSize = 65507;
+
+    // Opus ist vorgesehen, aber noch nicht eingebunden
+    enum class Codec : uint8_t {
+        Pcm16 = 1,
+        Float32 = 2
+    };
+
+    struct Config {
+        double sampleRate = 48000.0;
+        uint32_t channels = 2;
+        uint32_t frameSize = 128;
+        Codec codec = Codec::Pcm16;
+        uint32_t minBufferDepth = 1;
+        uint32_t maxBufferDepth = 32;
+        double jitterSafety = 3.0;
+        double pingIntervalMs = 250.0;
+
+        // Künstliche Störungen beim Empfang (nur für Tests)
+        double injectedLoss = 0.0;       // Wahrscheinlichkeit 0..1
+        double injectedJitterMs = 0.0;   // gleichverteilte Zusatzverzögerung
+        uint32_t injectionSeed = 1;
+    };
+
+    struct Stats {
+        uint64_t packetsSent = 0;
+        uint64_t packetsReceived = 0;
+        uint64_t packetsLost = 0;
+        uint64_t packetsLate = 0;
+        uint64_t packetsConcealed = 0;
+        uint64_t underruns = 0;
+        uint64_t decodeErrors = 0;   // ungültige oder unpassende Pakete
+        uint64_t ringOverflows = 0;  // receive() wurde zu selten aufgerufen
+        double roundTripMs = 0.0;
+        double jitterMs = 0.0;
+        double bufferedMs = 0.0;
+        uint32_t targetDepth = 0;
+        double resampleRatio = 1.0;
+    };
+
+    JamTransport();
+    // Wirft std::invalid_argument, wenn ein Paket nicht in ein Datagramm passt
+    explicit JamTransport(const Config& config);
+    ~JamTransport();
+
+    JamTransport(const JamTransport&) = delete;
+    JamTransport& operator=(const JamTransport&) = delete;
+
+    // Kontroll-Thread. Port 0 wählt einen freien Port. Ohne setPeer()
+    // antwortet der Transport dem Absender des ersten Pakets (Host).
+    // Datagramme anderer Absender werden verworfen
+    bool open(uint16_t port);
+    void close();
+    bool isOpen() const;
+    uint16_t getLocalPort() const;
+    // Vor dem ersten send() aufrufen
+    bool setPeer(const std::string& address, uint16_t port);
+    bool hasPeer() const;
+
+    // Audio-Thread (je einer für Senden und Empfangen). Interleaved float;
+    // send() puffert Reste bis zum nächsten vollen Paket
+    void send(const float* interleaved, size_t frames);
+    void receive(float* interleaved, size_t frames);
+
+    // Beliebiger Thread; Nachrichten können verloren gehen
+    void sendMessage(const std::string& channel, const void* data, size_t size);
+    // Ohne Kopie: der Aufrufer schreibt die Nutzlast ab Offset
+    // getMessageHeadroom(channel) in seinen eigenen Puffer, sendMessageInPlace()
+    // füllt den Kopf davor
+    size_t getMessageHeadroom(const std::string& channel) const;
+    void sendMessageInPlace(const std::string& channel, uint8_t* packet, size_t payloadSize);
+    bool pollMessage(std::string& channel, std::vector<uint8_t>& data);
+
+    // Geschätzte Ende-zu-Ende-Latenz in ms: halbe Umlaufzeit, Paketierung
+    // und Jitter-Puffer
+    float getLatency() const;
+    // Anteil verlorener Pakete seit open(), 0..1
+    float getPacketLoss() const;
+    Stats getStats() const;
+    const Config& getConfig() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,696 @@
+#include "PayloadCompression.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace VR_DAW {
+
+namespace {
+
+// Rahmen:
+//  u8 Codec (| kEmbeddedDictionary)  u8 Wörterbuch-ID (0: keins)
+//  varint Originalgröße  [varint Wörterbuchgröße + Wörterbuch]  Nutzlast
+constexpr uint8_t kEmbeddedDictionary = 0x80;
+constexpr size_t kFrameHeaderMax = 2 + 5;
+
+// LZ4-Blockformat
+constexpr uint32_t kHashLog = 14;
+constexpr size_t kHashSize = size_t(1) << kHashLog;
+constexpr size_t kMinMatch = 4;
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr size_t kMaxDictionary = 65536;
+
+// Erkennung unkomprimierbarer Nutzlast
+constexpr size_t kMinCompressSize = 32;
+constexpr size_t kEntropySample = 1024;
+constexpr size_t kEntropyMinSample = 256;
+constexpr double kEntropyLimit = 7.5;          // Bit je Byte
+constexpr size_t kIncompressibleRun = 8;
+constexpr size_t kIncompressibleBackoff = 64;
+
+// Wörterbuch-Training
+constexpr size_t kKmer = 8;
+constexpr size_t kSegment = 64;
+constexpr uint32_t kKmerLog = 16;
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - kHashLog);
+}
+
+inline size_t lz4Bound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+inline uint8_t* putVarint(uint8_t* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = static_cast<uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = static_cast<uint8_t>(v);
+    return p;
+}
+
+inline const uint8_t* getVarint(const uint8_t* p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return p;
+    }
+    return nullptr;
+}
+
+inline size_t varintSize(uint64_t v) {
+    size_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        ++n;
+    }
+    return n;
+}
+
+// Hash-Tabelle und Ketten über alle Positionen eines Wörterbuchs; einmal je
+// Wörterbuch aufgebaut und während einer Kompression nur vorübergehend erweitert
+struct Lz4Index {
+    std::vector<uint32_t> table;   // Position + 1, 0: leer
+    std::vector<uint32_t> chain;   // Vorgänger je Wörterbuchposition
+
+    void build(const uint8_t* dictionary, size_t size) {
+        table.assign(kHashSize, 0);
+        chain.assign(size, 0);
+        for (size_t p = 0; p + kMinMatch <= size; ++p) {
+            const uint32_t h = hash4(read32(dictionary + p));
+            chain[p] = table[h];
+            table[h] = static_cast<uint32_t>(p + 1);
+        }
+    }
+};
+
+bool writeSequence(uint8_t*& op, const uint8_t* end, const uint8_t* literals, size_t literalLength,
+                   size_t offset, size_t matchLength) {
+    const size_t need = 1 + literalLength / 255 + 1 + literalLength
+                      + (matchLength ? 2 + (matchLength - kMinMatch) / 255 + 1 : 0);
+    if (static_cast<size_t>(end - op) < need) return false;
+
+    uint8_t* token = op++;
+    if (literalLength >= 15) {
+        *token = 15 << 4;
+        size_t rest = literalLength - 15;
+        for (; rest >= 255; rest -= 255) *op++ = 255;
+        *op++ = static_cast<uint8_t>(rest);
+    } else {
+        *token = static_cast<uint8_t>(literalLength << 4);
+    }
+    std::memcpy(op, literals, literalLength);
+    op += literalLength;
+    if (matchLength == 0) return true;
+
+    *op++ = static_cast<uint8_t>(offset & 0xff);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    size_t rest = matchLength - kMinMatch;
+    if (rest >= 15) {
+        *token |= 15;
+        for (rest -= 15; rest >= 255; rest -= 255) *op++ = 255;
+        *op++ = static_cast<uint8_t>(rest);
+    } else {
+        *token |= static_cast<uint8_t>(rest);
+    }
+    return true;
+}
+
+// LZ4-Block mit externem Wörterbuch. window fasst [Wörterbuch | Eingabe],
+// chain eine Position je Eingabebyte. Liefert 0, wenn capacity nicht reicht
+size_t lz4Compress(const uint8_t* dictionary, size_t dictionarySize, Lz4Index& index,
+                   const uint8_t* input, size_t size, uint8_t* dst, size_t capacity,
+                   uint32_t attempts, uint8_t* window, uint32_t* chain) {
+    if (dictionarySize > 0) std::memcpy(window, dictionary, dictionarySize);
+    std::memcpy(window + dictionarySize, input, size);
+
+    const size_t base = dictionarySize;
+    const size_t end = base + size;
+    uint32_t* table = index.table.data();
+    uint8_t* op = dst;
+    const uint8_t* const opEnd = dst + capacity;
+    size_t anchor = base;
+    size_t inserted = base;
+    bool ok = true;
+
+    auto previous = [&](size_t position) {
+        return position < base ? index.chain[position] : chain[position - base];
+    };
+
+    if (size > kMatchFindLimit) {
+        const size_t matchLimit = end - kLastLiterals;
+        const size_t findLimit = end - kMatchFindLimit;
+        size_t ip = base;
+        while (ip < findLimit) {
+            for (; inserted < ip; ++inserted) {
+                const uint32_t h = hash4(read32(window + inserted));
+                chain[inserted - base] = table[h];
+                table[h] = static_cast<uint32_t>(inserted + 1);
+            }
+
+            const uint32_t sequence = read32(window + ip);
+            uint32_t candidate = table[hash4(sequence)];
+            size_t best = 0, bestLength = 0;
+            for (uint32_t a = 0; candidate != 0 && a < attempts; ++a) {
+                const size_t c = candidate - 1;
+                if (ip - c > kMaxOffset) break;
+                if (read32(window + c) == sequence) {
+                    size_t length = kMinMatch;
+                    while (ip + length < matchLimit && window[c + length] == window[ip + length]) ++length;
+                    if (length > bestLength) {
+                        bestLength = length;
+                        best = c;
+                        if (ip + length == matchLimit) break;
+                    }
+                }
+                candidate = previous(c);
+            }
+            if (bestLength < kMinMatch) {
+                ++ip;
+                continue;
+            }
+
+            // Rückwärts in die Literale verlängern
+            while (ip > anchor && best > 0 && window[ip - 1] == window[best - 1]) {
+                --ip;
+                --best;
+                ++bestLength;
+            }
+            if (!writeSequence(op, opEnd, window + anchor, ip - anchor, ip - best, bestLength)) {
+                ok = false;
+                break;
+            }
+            ip += bestLength;
+            anchor = ip;
+        }
+    }
+    if (ok) ok = writeSequence(op, opEnd, window + anchor, end - anchor, 0, 0);
+
+    // Eingabepositionen rückwärts wieder austragen: chain hält den alten Slot-Wert
+    while (inserted > base) {
+        --inserted;
+        table[hash4(read32(window + inserted))] = chain[inserted - base];
+    }
+    return ok ? static_cast<size_t>(op - dst) : 0;
+}
+
+bool lz4Decompress(const uint8_t* dictionary, size_t dictionarySize,
+                   const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* const end = src + srcSize;
+    size_t op = 0;
+
+    auto readLength = [&](size_t& length) {
+        uint8_t byte;
+        do {
+            if (ip >= end) return false;
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (ip < end) {
+        const uint8_t token = *ip++;
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(literalLength)) return false;
+        if (static_cast<size_t>(end - ip) < literalLength || dstSize - op < literalLength) return false;
+        std::memcpy(dst + op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == end) break;   // letzte Sequenz: nur Literale
+
+        if (end - ip < 2) return false;
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        size_t matchLength = (token & 15) + kMinMatch;
+        if ((token & 15) == 15 && !readLength(matchLength)) return false;
+        if (offset == 0 || offset > op + dictionarySize || dstSize - op < matchLength) return false;
+
+        if (offset > op) {
+            // Beginnt im Wörterbuch und läuft gegebenenfalls in die Ausgabe weiter
+            size_t from = dictionarySize - (offset - op);
+            const size_t fromDictionary = std::min(matchLength, dictionarySize - from);
+            std::memcpy(dst + op, dictionary + from, fromDictionary);
+            op += fromDictionary;
+            matchLength -= fromDictionary;
+            for (size_t s = 0; matchLength > 0; --matchLength) dst[op++] = dst[s++];
+        } else if (offset >= matchLength) {
+            std::memcpy(dst + op, dst + op - offset, matchLength);
+            op += matchLength;
+        } else {
+            // Überlappend: byteweise, damit sich Muster wiederholen
+            for (size_t s = op - offset; matchLength > 0; --matchLength) dst[op++] = dst[s++];
+        }
+    }
+    return op == dstSize;
+}
+
+// Vereinfachtes COVER: Proben in Epochen teilen, je Epoche das Segment mit
+// der größten Summe an k-mer-Häufigkeiten nehmen und dessen k-mere danach
+// nicht mehr zählen. Die besten Segmente landen am Ende (kürzeste Abstände)
+std::vector<uint8_t> trainDictionary(const uint8_t* samples, size_t size, size_t capacity) {
+    std::vector<uint8_t> dictionary;
+    if (size < 2 * kSegment || capacity < kSegment) return dictionary;
+
+    const size_t positions = size - kKmer + 1;
+    std::vector<uint32_t> hashes(positions);
+    std::vector<uint16_t> counts(size_t(1) << kKmerLog, 0);
+    for (size_t p = 0; p < positions; ++p) {
+        uint64_t v;
+        std::memcpy(&v, samples + p, kKmer);
+        hashes[p] = static_cast<uint32_t>((v * 0x9E3779B97F4A7C15ull) >> (64 - kKmerLog));
+        uint16_t& count = counts[hashes[p]];
+        if (count < 0xffff) ++count;
+    }
+
+    struct Pick {
+        size_t start;
+        uint64_t score;
+    };
+    std::vector<Pick> picks;
+    const size_t kmersPerSegment = kSegment - kKmer + 1;
+    const size_t epoch = std::max(kSegment, size / (capacity / kSegment));
+
+    for (size_t epochStart = 0; epochStart + kSegment <= size; epochStart += epoch) {
+        const size_t lastStart = std::min(size, epochStart + epoch) - kSegment;
+        uint64_t score = 0;
+        for (size_t k = 0; k < kmersPerSegment; ++k) score += counts[hashes[epochStart + k]];
+        Pick best{epochStart, score};
+        for (size_t s = epochStart + 1; s <= lastStart; ++s) {
+            score -= counts[hashes[s - 1]];
+            score += counts[hashes[s + kmersPerSegment - 1]];
+            if (score > best.score) best = {s, score};
+        }
+        // Nur Segmente, deren k-mere im Mittel mehr als einmal vorkommen
+        if (best.score <= kmersPerSegment) continue;
+        picks.push_back(best);
+        for (size_t k = 0; k < kmersPerSegment; ++k) counts[hashes[best.start + k]] = 0;
+    }
+
+    std::sort(picks.begin(), picks.end(), [](const Pick& a, const Pick& b) { return a.score < b.score; });
+    const size_t keep = std::min(picks.size(), capacity / kSegment);
+    dictionary.reserve(keep * kSegment);
+    for (size_t i = picks.size() - keep; i < picks.size(); ++i) {
+        dictionary.insert(dictionary.end(), samples + picks[i].start, samples + picks[i].start + kSegment);
+    }
+    return dictionary;
+}
+
+bool looksCompressed(const uint8_t* p, size_t size) {
+    if (size >= 4) {
+        if (std::memcmp(p, "OggS", 4) == 0 || std::memcmp(p, "fLaC", 4) == 0) return true;
+        if (p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f && p[3] == 0xfd) return true;   // zstd
+        if (p[0] == 0x89 && std::memcmp(p + 1, "PNG", 3) == 0) return true;
+    }
+    if (size >= 3) {
+        if (std::memcmp(p, "ID3", 3) == 0) return true;                                 // MP3
+        if (p[0] == 0xff && p[1] == 0xd8 && p[2] == 0xff) return true;                  // JPEG
+    }
+    if (size >= 2) {
+        if (p[0] == 0x1f && p[1] == 0x8b) return true;                                  // gzip
+        if (p[0] == 0xff && (p[1] & 0xf0) == 0xf0) return true;                         // MPEG/AAC-Frame
+    }
+
+    const size_t n = std::min(size, kEntropySample);
+    if (n < kEntropyMinSample) return false;
+    uint32_t histogram[256] = {};
+    for (size_t i = 0; i < n; ++i) ++histogram[p[i]];
+    double entropy = 0.0;
+    for (uint32_t count : histogram) {
+        if (count == 0) continue;
+        const double probability = static_cast<double>(count) / n;
+        entropy -= probability * std::log2(probability);
+    }
+    return entropy > kEntropyLimit;
+}
+
+inline uint32_t lz4Attempts(int level) {
+    return 1u << std::min(2 * (std::max(level, 1) - 1), 8);
+}
+
+} // namespace
+
+struct PayloadCompressor::Impl {
+    Config config;
+    int level = 1;
+    uint8_t nextDictionaryId = 1;
+
+    std::vector<uint8_t> window;
+    std::vector<uint32_t> chain;
+    Lz4Index plainIndex;   // ohne Wörterbuch
+
+#ifdef USE_ZSTD
+    ZSTD_CCtx* zstdCompress = nullptr;
+    ZSTD_DCtx* zstdDecompress = nullptr;
+#endif
+
+    struct Channel {
+        ChannelStats stats;
+
+        // Senden
+        std::vector<uint8_t> training;
+        bool trained = false;
+        std::vector<uint8_t> dictionary;
+        uint8_t dictionaryId = 0;
+        Lz4Index index;
+        size_t framesWithDictionary = 0;
+        size_t incompressibleRun = 0;
+        size_t skipRemaining = 0;
+
+        // Empfangen
+        std::vector<uint8_t> remoteDictionary;
+        uint8_t remoteDictionaryId = 0;
+
+#ifdef USE_ZSTD
+        ZSTD_CDict* compressDictionary = nullptr;
+        int compressDictionaryLevel = 0;
+        ZSTD_DDict* decompressDictionary = nullptr;
+
+        ~Channel() {
+            ZSTD_freeCDict(compressDictionary);
+            ZSTD_freeDDict(decompressDictionary);
+        }
+#endif
+    };
+    std::unordered_map<std::string, std::unique_ptr<Channel>> channels;
+
+    explicit Impl(const Config& cfg) : config(cfg) {
+        config.dictionarySize = std::min(config.dictionarySize, kMaxDictionary);
+        level = std::clamp(config.level, 0, 9);
+        window.resize(config.dictionarySize + config.maxMessageSize);
+        chain.resize(config.maxMessageSize);
+        plainIndex.build(nullptr, 0);
+#ifdef USE_ZSTD
+        zstdCompress = ZSTD_createCCtx();
+        zstdDecompress = ZSTD_createDCtx();
+#endif
+    }
+
+    ~Impl() {
+#ifdef USE_ZSTD
+        ZSTD_freeCCtx(zstdCompress);
+        ZSTD_freeDCtx(zstdDecompress);
+#endif
+    }
+
+    Channel& channelFor(const std::string& name) {
+        auto it = channels.find(name);
+        if (it != channels.end()) return *it->second;
+        auto channel = std::make_unique<Channel>();
+        channel->stats.channel = name;
+        return *channels.emplace(name, std::move(channel)).first->second;
+    }
+
+    Codec codecForLevel() const {
+        if (level == 0) return Codec::None;
+        if (level >= 4 && isAvailable(Codec::Zstd)) return Codec::Zstd;
+        return Codec::LZ4;
+    }
+
+    void train(Channel& channel, const uint8_t* data, size_t size) {
+        const size_t take = std::min(size, config.trainingBytes - channel.training.size());
+        channel.training.insert(channel.training.end(), data, data + take);
+        if (channel.training.size() < config.trainingBytes) return;
+
+        channel.trained = true;
+        channel.dictionary = trainDictionary(channel.training.data(), channel.training.size(),
+                                             config.dictionarySize);
+        std::vector<uint8_t>().swap(channel.training);
+        if (channel.dictionary.size() < kSegment) {
+            channel.dictionary.clear();
+            return;
+        }
+        channel.index.build(channel.dictionary.data(), channel.dictionary.size());
+        channel.dictionaryId = nextDictionaryId;
+        nextDictionaryId = nextDictionaryId == 255 ? 1 : nextDictionaryId + 1;
+        channel.framesWithDictionary = 0;
+        channel.stats.dictionaryId = channel.dictionaryId;
+        channel.stats.dictionarySize = channel.dictionary.size();
+    }
+
+    size_t compressPayload(Channel& channel, Codec codec, bool useDictionary,
+                           const uint8_t* input, size_t size, uint8_t* dst, size_t capacity) {
+        const uint8_t* dictionary = useDictionary ? channel.dictionary.data() : nullptr;
+        const size_t dictionarySize = useDictionary ? channel.dictionary.size() : 0;
+        if (codec == Codec::LZ4) {
+            return lz4Compress(dictionary, dictionarySize, useDictionary ? channel.index : plainIndex,
+                               input, size, dst, capacity, lz4Attempts(level), window.data(), chain.data());
+        }
+#ifdef USE_ZSTD
+        if (codec == Codec::Zstd) {
+            const int zstdLevel = (level - 3) * 3;   // Stufen 4..9 -> zstd 3..18
+            size_t result;
+            if (useDictionary) {
+                if (!channel.compressDictionary || channel.compressDictionaryLevel != zstdLevel) {
+                    ZSTD_freeCDict(channel.compressDictionary);
+                    channel.compressDictionary = ZSTD_createCDict(dictionary, dictionarySize, zstdLevel);
+                    channel.compressDictionaryLevel = zstdLevel;
+                }
+                result = ZSTD_compress_usingCDict(zstdCompress, dst, capacity, input, size,
+                                                  channel.compressDictionary);
+            } else {
+                result = ZSTD_compressCCtx(zstdCompress, dst, capacity, input, size, zstdLevel);
+            }
+            return ZSTD_isError(result) ? 0 : result;
+        }
+#endif
+        return 0;
+    }
+
+    size_t compress(const std::string& name, const uint8_t* input, size_t size,
+                    uint8_t* frame, size_t capacity) {
+        if (size > config.maxMessageSize) return 0;
+        const auto start = std::chrono::steady_clock::now();
+        Channel& channel = channelFor(name);
+
+        Codec codec = codecForLevel();
+        bool skipped = false;
+        if (codec != Codec::None) {
+            if (looksCompressed(input, size)) {
+                skipped = true;
+            } else if (config.dictionaries && !channel.trained) {
+                // Einzeln komprimieren kurze Nachrichten schlecht; das Urteil
+                // über den Kanal fällt erst mit Wörterbuch
+                train(channel, input, size);
+            } else if (channel.skipRemaining > 0) {
+                --channel.skipRemaining;
+                skipped = true;
+            }
+            if (skipped || size < kMinCompressSize) codec = Codec::None;
+        }
+
+        const size_t rawSize = 2 + varintSize(size) + size;
+        size_t frameSize = 0;
+        if (codec != Codec::None) {
+            const bool useDictionary = !channel.dictionary.empty();
+            const bool embed = useDictionary
+                && (channel.framesWithDictionary < kDictionaryRepeats
+                    || channel.framesWithDictionary % kDictionaryInterval == 0);
+
+            uint8_t* p = frame;
+            if (capacity >= kFrameHeaderMax + (embed ? 5 + channel.dictionary.size() : 0)) {
+                *p++ = static_cast<uint8_t>(codec) | (embed ? kEmbeddedDictionary : 0);
+                *p++ = useDictionary ? channel.dictionaryId : 0;
+                p = putVarint(p, size);
+                const size_t headerSize = static_cast<size_t>(p - frame);
+                if (embed) {
+                    p = putVarint(p, channel.dictionary.size());
+                    std::memcpy(p, channel.dictionary.data(), channel.dictionary.size());
+                    p += channel.dictionary.size();
+                }
+                const size_t payload = compressPayload(channel, codec, useDictionary, input, size, p,
+                                                       capacity - static_cast<size_t>(p - frame));
+
+                // Das mitgeschickte Wörterbuch zählt nicht: es muss irgendwann raus
+                if (payload > 0 && headerSize + payload < rawSize) {
+                    frameSize = static_cast<size_t>(p - frame) + payload;
+                    if (useDictionary) ++channel.framesWithDictionary;
+                }
+                const bool judged = channel.trained || !config.dictionaries;
+                if (payload == 0 || payload * 32 >= size * 31) {
+                    if (judged && ++channel.incompressibleRun >= kIncompressibleRun) {
+                        channel.skipRemaining = kIncompressibleBackoff;
+                        channel.incompressibleRun = 0;
+                    }
+                } else {
+                    channel.incompressibleRun = 0;
+                }
+            }
+            if (frameSize == 0) skipped = true;
+        }
+
+        if (frameSize == 0) {
+            if (capacity < rawSize) return 0;
+            frame[0] = static_cast<uint8_t>(Codec::None);
+            frame[1] = 0;
+            uint8_t* p = putVarint(frame + 2, size);
+            if (size > 0) std::memcpy(p, input, size);
+            frameSize = rawSize;
+            codec = Codec::None;
+        }
+
+        ChannelStats& stats = channel.stats;
+        ++stats.messagesOut;
+        if (skipped) ++stats.skipped;
+        stats.bytesIn += size;
+        stats.bytesOut += frameSize;
+        if (codec != Codec::None) stats.codec = codec;
+        stats.compressNanoseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        return frameSize;
+    }
+
+    bool decompress(const std::string& name, const uint8_t* frame, size_t frameSize,
+                    uint8_t* data, size_t capacity, size_t& size) {
+        const auto start = std::chrono::steady_clock::now();
+        Channel& channel = channelFor(name);
+        ChannelStats& stats = channel.stats;
+        const bool ok = decode(channel, frame, frameSize, data, capacity, size);
+        if (ok) {
+            ++stats.messagesIn;
+            stats.bytesReceived += frameSize;
+            stats.bytesDecoded += size;
+        } else {
+            ++stats.decodeErrors;
+        }
+        stats.decompressNanoseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        return ok;
+    }
+
+    bool decode(Channel& channel, const uint8_t* frame, size_t frameSize,
+                uint8_t* data, size_t capacity, size_t& size) {
+        if (frameSize < 3) return false;
+        const uint8_t* const end = frame + frameSize;
+        const Codec codec = static_cast<Codec>(frame[0] & ~kEmbeddedDictionary);
+        const bool embedded = (frame[0] & kEmbeddedDictionary) != 0;
+        const uint8_t dictionaryId = frame[1];
+
+        uint64_t original = 0;
+        const uint8_t* p = getVarint(frame + 2, end, original);
+        if (!p || original > capacity || original > config.maxMessageSize) return false;
+
+        if (embedded) {
+            uint64_t dictionarySize = 0;
+            p = getVarint(p, end, dictionarySize);
+            if (!p || dictionaryId == 0 || dictionarySize > kMaxDictionary
+                || dictionarySize > static_cast<uint64_t>(end - p)) {
+                return false;
+            }
+            if (dictionaryId != channel.remoteDictionaryId || dictionarySize != channel.remoteDictionary.size()) {
+                channel.remoteDictionary.assign(p, p + dictionarySize);
+                channel.remoteDictionaryId = dictionaryId;
+#ifdef USE_ZSTD
+                ZSTD_freeDDict(channel.decompressDictionary);
+                channel.decompressDictionary = ZSTD_createDDict(p, dictionarySize);
+#endif
+            }
+            p += dictionarySize;
+        }
+        // Wörterbuch verpasst: erst der nächste Rahmen mit eingebettetem hilft
+        if (dictionaryId != 0 && dictionaryId != channel.remoteDictionaryId) return false;
+
+        const size_t payload = static_cast<size_t>(end - p);
+        size = static_cast<size_t>(original);
+        switch (codec) {
+        case Codec::None:
+            if (payload != size) return false;
+            if (size > 0) std::memcpy(data, p, size);
+            return true;
+        case Codec::LZ4:
+            return dictionaryId != 0
+                ? lz4Decompress(channel.remoteDictionary.data(), channel.remoteDictionary.size(), p, payload, data, size)
+                : lz4Decompress(nullptr, 0, p, payload, data, size);
+        case Codec::Zstd: {
+#ifdef USE_ZSTD
+            const size_t result = dictionaryId != 0
+                ? ZSTD_decompress_usingDDict(zstdDecompress, data, size, p, payload, channel.decompressDictionary)
+                : ZSTD_decompressDCtx(zstdDecompress, data, size, p, payload);
+            return !ZSTD_isError(result) && result == size;
+#else
+            return false;
+#endif
+        }
+        }
+        return false;
+    }
+};
+
+bool PayloadCompressor::isAvailable(Codec codec) {
+#ifdef USE_ZSTD
+    return true;
+#else
+    return codec != Codec::Zstd;
+#endif
+}
+
+size_t PayloadCompressor::getMaxFrameSize(size_t size) {
+    size_t bound = lz4Bound(size);
+#ifdef USE_ZSTD
+    bound = std::max(bound, ZSTD_compressBound(size));
+#endif
+    return kFrameHeaderMax + bound;
+}
+
+PayloadCompressor::PayloadCompressor()
+    : PayloadCompressor(Config())
+{
+}
+
+PayloadCompressor::PayloadCompressor(const Config& config)
+    : pImpl(std::make_unique<Impl>(config))
+{
+}
+
+PayloadCompressor::~PayloadCompressor() = default;
+
+void PayloadCompressor::setLevel(int level) {
+    pImpl->level = std::clamp(level, 0, 9);
+}
+
+int PayloadCompressor::getLevel() const {
+    return pImpl->level;
+}
+
+size_t PayloadCompressor::compress(const std::string& channel, const void* data, size_t size,
+                                   uint8_t* frame, size_t capacity) {
+    return pImpl->compress(channel, static_cast<const uint8_t*>(data), size, frame, capacity);
+}
+
+bool PayloadCompressor::decompress(const std::string& channel, const uint8_t* frame, size_t frameSize,
+                                   uint8_t* data, size_t capacity, size_t& size) {
+    return pImpl->decompress(channel, frame, frameSize, data, capacity, size);
+}
+
+std::vector<PayloadCompressor::ChannelStats> PayloadCompressor::getStats() const {
+    std::vector<ChannelStats> result;
+    result.reserve(pImpl->channels.size());
+    for (const auto& entry : pImpl->channels) result.push_back(entry.second->stats);
+    std::sort(result.begin(), result.end(), [](const ChannelStats& a, const ChannelStats& b) {
+        return a.channel < b.channel;
+    });
+    return result;
+}
+
+void PayloadCompressor::reset() {
+    pImpl->channels.clear();
+}
+
+} // namespace VR_DAW
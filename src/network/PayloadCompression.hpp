@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VR_DAW {
+
+// Kompression für Nachrichten auf benannten Kanälen (Projekt-Sync, Events;
+// meist kurze JSON-Texte).
+//
+// Jede Nachricht wird zu einem eigenständigen Rahmen, weil der
+// Nachrichtenweg Pakete verlieren und vertauschen darf. Damit kleine
+// Nachrichten trotzdem gut komprimieren, lernt jeder Kanal aus seinen
+// ersten trainingBytes ein Wörterbuch (Segmente mit den häufigsten
+// 8-Byte-Folgen). Das Wörterbuch reist in den ersten Rahmen danach und
+// später in jedem kDictionaryInterval-ten Rahmen mit. Ein Empfänger, der
+// es verpasst hat, erholt sich so von selbst.
+//
+// Codecs:
+//  - LZ4: eingebaut, Blockformat mit externem Wörterbuch. Die Stufen 1-3
+//    unterscheiden sich in der Suchtiefe der Hash-Ketten.
+//  - zstd: nur mit USE_ZSTD, für die Stufen 4-9. Ohne zstd laufen diese
+//    Stufen als LZ4 mit tieferer Suche.
+// Stufe 0 schickt Rohdaten.
+//
+// Bereits komprimierte Nutzlast (Opus/Ogg, FLAC, MP3, gzip, zstd, PNG,
+// JPEG oder allgemein hohe Entropie) geht roh durch. Bleibt ein Kanal
+// mehrfach in Folge unkomprimierbar, wird er eine Weile gar nicht erst
+// versucht.
+//
+// Nicht thread-sicher. Arbeitspuffer werden bei der Konstruktion angelegt.
+// Danach alloziert nur das erste Auftreten eines Kanals und das Training.
+class PayloadCompressor {
+public:
+    enum class Codec : uint8_t {
+        None = 0,
+        LZ4 = 1,
+        Zstd = 2
+    };
+
+    static constexpr size_t kDictionaryRepeats = 3;
+    static constexpr size_t kDictionaryInterval = 512;
+
+    struct Config {
+        int level = 1;                       // 0..9
+        bool dictionaries = true;
+        size_t dictionarySize = 8 * 1024;    // höchstens 64 KB (LZ4-Fenster)
+        size_t trainingBytes = 32 * 1024;
+        size_t maxMessageSize = 256 * 1024;  // unkomprimiert
+    };
+
+    struct ChannelStats {
+        std::string channel;
+        Codec codec = Codec::None;
+        uint8_t dictionaryId = 0;          // 0: (noch) keins
+        size_t dictionarySize = 0;
+        // Senden
+        uint64_t messagesOut = 0;
+        uint64_t skipped = 0;              // roh gesendet, weil unkomprimierbar
+        uint64_t bytesIn = 0;              // Nutzlast vor Kompression
+        uint64_t bytesOut = 0;             // Rahmen inklusive Kopf und Wörterbuch
+        uint64_t compressNanoseconds = 0;
+        // Empfangen
+        uint64_t messagesIn = 0;
+        uint64_t bytesReceived = 0;
+        uint64_t bytesDecoded = 0;
+        uint64_t decompressNanoseconds = 0;
+        uint64_t decodeErrors = 0;         // kaputt oder Wörterbuch fehlt
+
+        double getRatio() const { return bytesOut > 0 ? static_cast<double>(bytesIn) / bytesOut : 1.0; }
+    };
+
+    static bool isAvailable(Codec codec);
+    // Obergrenze für einen Rahmen mit size Bytes Nutzlast, ohne Wörterbuch
+    static size_t getMaxFrameSize(size_t size);
+
+    PayloadCompressor();
+    explicit PayloadCompressor(const Config& config);
+    ~PayloadCompressor();
+
+    PayloadCompressor(const PayloadCompressor&) = delete;
+    PayloadCompressor& operator=(const PayloadCompressor&) = delete;
+
+    void setLevel(int level);
+    int getLevel() const;
+
+    // Schreibt den Rahmen nach frame und liefert seine Größe; 0, wenn
+    // capacity nicht reicht oder die Nachricht zu groß ist
+    size_t compress(const std::string& channel, const void* data, size_t size,
+                    uint8_t* frame, size_t capacity);
+    // size: Länge der Nachricht; false bei kaputtem Rahmen, fehlendem
+    // Wörterbuch oder zu kleinem capacity
+    bool decompress(const std::string& channel, const uint8_t* frame, size_t frameSize,
+                    uint8_t* data, size_t capacity, size_t& size);
+
+    std::vector<ChannelStats> getStats() const;
+    void reset();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,636 @@
+#include "StateReplication.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace VR_DAW {
+
+namespace {
+
+// Paket, little-endian:
+//  0 u8 Version  1 u32 Tick  5 u32 bestätigter Tick  9 u32 Bestätigungs-Bits
+//  13 3 x i32 Betrachterposition  25 u16 Objektzahl, dann je Objekt:
+//  varint ID, u8 Flags, [u8 Alter der Basis], [u8 Länge + Name],
+//  [3 x zigzag-varint Position], [u32 Rotation | 3 x zigzag-varint Delta]
+constexpr uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = 27;
+constexpr size_t kMaxObjectSize = 3 + 1 + 1 + 1 + 255 + 3 * 5 + 3 * 5;
+
+enum ObjectFlags : uint8_t {
+    kHasPosition = 1,
+    kHasRotation = 2,
+    kHasBaseline = 4,
+    kHasName = 8,
+    kRotationFull = 16
+};
+
+constexpr uint32_t kRotationBits = 10;
+constexpr uint32_t kRotationMask = (1u << kRotationBits) - 1;
+constexpr float kRotationRange = 0.70710678f;   // |kleine Komponenten| <= 1/sqrt(2)
+
+// Weiter voraus liegende Ticks gelten als kaputtes Paket, nicht als Verlust
+constexpr uint32_t kMaxTickAdvance = 1u << 16;
+
+// Nähere Objekte sammeln bis zu (1 + kNearBoost)-mal schneller Priorität
+constexpr float kNearBoost = 4.0f;
+
+struct QuantizedState {
+    int32_t position[3] = {0, 0, 0};
+    uint32_t rotation = 3u << 30;   // Identität: w ist die größte Komponente
+
+    bool operator==(const QuantizedState& other) const {
+        return position[0] == other.position[0] && position[1] == other.position[1]
+            && position[2] == other.position[2] && rotation == other.rotation;
+    }
+    bool operator!=(const QuantizedState& other) const { return !(*this == other); }
+};
+
+inline void put32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (v >> (8 * i)) & 0xff; }
+inline uint32_t get32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+inline uint32_t zigzag(int32_t v) { return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31); }
+inline int32_t unzigzag(uint32_t v) { return static_cast<int32_t>((v >> 1) ^ (0u - (v & 1))); }
+
+inline uint8_t* putVarint(uint8_t* p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = static_cast<uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = static_cast<uint8_t>(v);
+    return p;
+}
+
+// Liefert nullptr bei Überlauf oder abgeschnittenem Wert
+inline const uint8_t* getVarint(const uint8_t* p, const uint8_t* end, uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        v |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return p;
+    }
+    return nullptr;
+}
+
+inline int32_t quantizePosition(float v) {
+    const float limit = 2147483000.0f / StateReplicator::kPositionScale;
+    return static_cast<int32_t>(std::lround(std::clamp(v, -limit, limit) * StateReplicator::kPositionScale));
+}
+
+uint32_t quantizeRotation(const glm::quat& q) {
+    float c[4] = {q.x, q.y, q.z, q.w};
+    const float length = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2] + c[3] * c[3]);
+    if (!(length > 1e-6f)) return 3u << 30;
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::abs(c[i]) > std::abs(c[largest])) largest = i;
+    }
+    // q und -q sind dieselbe Rotation: größte Komponente positiv machen
+    const float sign = c[largest] < 0.0f ? -1.0f / length : 1.0f / length;
+
+    uint32_t packed = largest << 30;
+    uint32_t shift = 2 * kRotationBits;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float unit = std::clamp(c[i] * sign / kRotationRange * 0.5f + 0.5f, 0.0f, 1.0f);
+        packed |= static_cast<uint32_t>(std::lround(unit * kRotationMask)) << shift;
+        shift -= kRotationBits;
+    }
+    return packed;
+}
+
+glm::quat dequantizeRotation(uint32_t packed) {
+    const uint32_t largest = packed >> 30;
+    float c[4];
+    float sum = 0.0f;
+    uint32_t shift = 2 * kRotationBits;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float unit = static_cast<float>((packed >> shift) & kRotationMask) / kRotationMask;
+        c[i] = (unit - 0.5f) * 2.0f * kRotationRange;
+        sum += c[i] * c[i];
+        shift -= kRotationBits;
+    }
+    c[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+    return glm::quat(c[3], c[0], c[1], c[2]);
+}
+
+inline uint32_t rotationComponent(uint32_t packed, int index) {
+    return (packed >> (kRotationBits * (2 - index))) & kRotationMask;
+}
+
+} // namespace
+
+struct StateReplicator::Impl {
+    Config config;
+    Stats stats;
+
+    // --- Senden ---
+    struct LocalObject {
+        std::string name;
+        QuantizedState state;
+        QuantizedState acked;
+        uint32_t ackedTick = 0;
+        bool hasAck = false;
+        float priority = 0.0f;
+    };
+    struct SentEntry {
+        ObjectId id;
+        QuantizedState state;
+    };
+    struct SentRecord {
+        uint32_t tick = 0;
+        bool acknowledged = false;
+        std::vector<SentEntry> entries;
+    };
+
+    std::vector<LocalObject> objects;
+    std::unordered_map<std::string, ObjectId> objectIds;
+    std::vector<SentRecord> sent;           // kHistoryTicks, nach tick % kHistoryTicks
+    std::vector<ObjectId> candidates;
+    uint32_t tick = 0;
+    int32_t viewer[3] = {0, 0, 0};
+    float remoteViewer[3] = {0.0f, 0.0f, 0.0f};
+
+    // --- Empfangen ---
+    struct Snapshot {
+        uint32_t tick = 0;
+        bool valid = false;
+        QuantizedState state;
+    };
+    struct RemoteObject {
+        std::string name;
+        Snapshot history[kHistoryTicks];
+    };
+
+    std::vector<RemoteObject> remote;
+    std::vector<int32_t> remoteSlots;       // entfernte ID -> Index in remote
+    std::unordered_map<std::string, size_t> remoteNames;
+    uint32_t receivedTick = 0;
+    uint32_t receivedBits = 0;
+    double playoutTick = 0.0;
+    bool playoutStarted = false;
+
+    explicit Impl(const Config& cfg) : config(cfg) {
+        config.maxObjects = std::clamp<size_t>(config.maxObjects, 1, kInvalidObject);
+        config.packetBudget = std::max(config.packetBudget, kHeaderSize + kMaxObjectSize);
+        config.tickRate = std::max(config.tickRate, 1.0);
+
+        objects.reserve(config.maxObjects);
+        candidates.reserve(config.maxObjects);
+        remote.reserve(config.maxObjects);
+        remoteSlots.assign(config.maxObjects, -1);
+
+        // Jedes Objekt kostet mindestens ID, Flags und ein Byte Nutzlast
+        sent.resize(kHistoryTicks);
+        for (auto& record : sent) record.entries.reserve(config.packetBudget / 3);
+    }
+
+    static int32_t age(uint32_t newer, uint32_t older) {
+        return static_cast<int32_t>(newer - older);
+    }
+
+    void acknowledge(uint32_t ackedTick) {
+        if (ackedTick == 0) return;
+        SentRecord& record = sent[ackedTick % kHistoryTicks];
+        if (record.tick != ackedTick || record.acknowledged) return;
+        record.acknowledged = true;
+        for (const SentEntry& entry : record.entries) {
+            LocalObject& object = objects[entry.id];
+            if (!object.hasAck || age(ackedTick, object.ackedTick) > 0) {
+                object.acked = entry.state;
+                object.ackedTick = ackedTick;
+                object.hasAck = true;
+            }
+        }
+    }
+
+    uint8_t* encodeObject(uint8_t* p, ObjectId id, LocalObject& object) {
+        const bool baseline = object.hasAck && age(tick, object.ackedTick) < static_cast<int32_t>(kHistoryTicks);
+        const QuantizedState& base = baseline ? object.acked : QuantizedState();
+        const QuantizedState& state = object.state;
+
+        uint8_t flags = 0;
+        if (!baseline || state.position[0] != base.position[0] || state.position[1] != base.position[1]
+            || state.position[2] != base.position[2]) {
+            flags |= kHasPosition;
+        }
+        if (!baseline || state.rotation != base.rotation) {
+            flags |= kHasRotation;
+            if (!baseline || (state.rotation >> 30) != (base.rotation >> 30)) flags |= kRotationFull;
+        }
+        if (baseline) flags |= kHasBaseline;
+        if (!object.hasAck) flags |= kHasName;
+
+        p = putVarint(p, id);
+        *p++ = flags;
+        if (flags & kHasBaseline) *p++ = static_cast<uint8_t>(age(tick, object.ackedTick));
+        if (flags & kHasName) {
+            const size_t length = std::min<size_t>(object.name.size(), 255);
+            *p++ = static_cast<uint8_t>(length);
+            std::memcpy(p, object.name.data(), length);
+            p += length;
+        }
+        if (flags & kHasPosition) {
+            for (int i = 0; i < 3; ++i) {
+                p = putVarint(p, zigzag(static_cast<int32_t>(
+                    static_cast<uint32_t>(state.position[i]) - static_cast<uint32_t>(base.position[i]))));
+            }
+        }
+        if (flags & kRotationFull) {
+            put32(p, state.rotation);
+            p += 4;
+        } else if (flags & kHasRotation) {
+            for (int i = 0; i < 3; ++i) {
+                p = putVarint(p, zigzag(static_cast<int32_t>(rotationComponent(state.rotation, i))
+                                        - static_cast<int32_t>(rotationComponent(base.rotation, i))));
+            }
+        }
+        return p;
+    }
+
+    size_t write(uint8_t* data, size_t capacity) {
+        const size_t budget = std::min(capacity, config.packetBudget);
+        if (budget < kHeaderSize) return 0;
+
+        ++tick;
+        SentRecord& record = sent[tick % kHistoryTicks];
+        record.tick = tick;
+        record.acknowledged = false;
+        record.entries.clear();
+
+        data[0] = kVersion;
+        put32(data + 1, tick);
+        put32(data + 5, receivedTick);
+        put32(data + 9, receivedBits);
+        for (int i = 0; i < 3; ++i) put32(data + 13 + 4 * i, static_cast<uint32_t>(viewer[i]));
+
+        // Kandidaten: geändert gegenüber der Bestätigung und im Interesse der Gegenseite
+        candidates.clear();
+        const float radius = std::max(config.interestRadius, 1e-3f);
+        for (size_t i = 0; i < objects.size(); ++i) {
+            LocalObject& object = objects[i];
+            if (object.hasAck && object.state == object.acked) {
+                object.priority = 0.0f;
+                continue;
+            }
+            float distanceSquared = 0.0f;
+            for (int a = 0; a < 3; ++a) {
+                const float d = object.state.position[a] / kPositionScale - remoteViewer[a];
+                distanceSquared += d * d;
+            }
+            const float distance = std::sqrt(distanceSquared);
+            if (distance > radius) continue;
+            object.priority += 1.0f + kNearBoost * (1.0f - distance / radius);
+            candidates.push_back(static_cast<ObjectId>(i));
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](ObjectId a, ObjectId b) {
+            return objects[a].priority > objects[b].priority;
+        });
+
+        uint8_t scratch[kMaxObjectSize];
+        uint8_t* p = data + kHeaderSize;
+        uint32_t count = 0, deferred = 0;
+        for (ObjectId id : candidates) {
+            if (count == 0xffff || record.entries.size() == record.entries.capacity()) {
+                ++deferred;
+                continue;
+            }
+            LocalObject& object = objects[id];
+            const size_t size = static_cast<size_t>(encodeObject(scratch, id, object) - scratch);
+            if (static_cast<size_t>(p - data) + size > budget) {
+                ++deferred;
+                continue;
+            }
+            std::memcpy(p, scratch, size);
+            p += size;
+            ++count;
+            object.priority = 0.0f;
+            record.entries.push_back({id, object.state});
+        }
+        data[25] = static_cast<uint8_t>(count & 0xff);
+        data[26] = static_cast<uint8_t>(count >> 8);
+
+        const size_t size = static_cast<size_t>(p - data);
+        ++stats.packetsWritten;
+        stats.bytesWritten += size;
+        stats.lastPacketSize = static_cast<uint32_t>(size);
+        stats.lastObjectsSent = count;
+        stats.lastObjectsDeferred = deferred;
+        stats.tick = tick;
+        return size;
+    }
+
+    RemoteObject* remoteObject(uint32_t id, const char* name, size_t nameLength) {
+        if (id >= remoteSlots.size()) return nullptr;
+        if (remoteSlots[id] >= 0) return &remote[static_cast<size_t>(remoteSlots[id])];
+        if (!name || remote.size() == config.maxObjects) return nullptr;
+
+        remote.emplace_back();
+        remote.back().name.assign(name, nameLength);
+        remoteSlots[id] = static_cast<int32_t>(remote.size() - 1);
+        remoteNames[remote.back().name] = remote.size() - 1;
+        stats.remoteObjects = static_cast<uint32_t>(remote.size());
+        return &remote.back();
+    }
+
+    struct DecodedObject {
+        uint32_t id = 0;
+        int32_t slot = -1;          // Index in remote, -1 für ein neues Objekt
+        const char* name = nullptr;
+        size_t nameLength = 0;
+        QuantizedState state;
+    };
+
+    // Liest ein Objekt, ohne etwas zu verändern; nullptr bei kaputtem Eintrag
+    const uint8_t* decodeObject(const uint8_t* p, const uint8_t* end, uint32_t packetTick,
+                                DecodedObject& object) const {
+        if (!(p = getVarint(p, end, object.id)) || p >= end) return nullptr;
+        if (object.id >= remoteSlots.size()) return nullptr;
+        const uint8_t flags = *p++;
+
+        uint32_t baseAge = 0;
+        if (flags & kHasBaseline) {
+            if (p >= end) return nullptr;
+            baseAge = *p++;
+            // Der Sender nimmt nur Basen aus der Historie, ein Alter von 0 gibt es nicht
+            if (baseAge == 0 || baseAge >= kHistoryTicks) return nullptr;
+        }
+        object.name = nullptr;
+        object.nameLength = 0;
+        if (flags & kHasName) {
+            if (p >= end || static_cast<size_t>(end - p) < 1u + *p) return nullptr;
+            object.nameLength = *p++;
+            object.name = reinterpret_cast<const char*>(p);
+            p += object.nameLength;
+        }
+        object.slot = remoteSlots[object.id];
+        if (object.slot < 0 && !object.name) return nullptr;
+
+        QuantizedState& state = object.state;
+        state = QuantizedState();
+        if (flags & kHasBaseline) {
+            if (object.slot < 0) return nullptr;
+            const uint32_t baseTick = packetTick - baseAge;
+            const Snapshot& base = remote[static_cast<size_t>(object.slot)].history[baseTick % kHistoryTicks];
+            if (!base.valid || base.tick != baseTick) return nullptr;
+            state = base.state;
+        }
+        if (flags & kHasPosition) {
+            for (int i = 0; i < 3; ++i) {
+                uint32_t v = 0;
+                if (!(p = getVarint(p, end, v))) return nullptr;
+                state.position[i] = static_cast<int32_t>(static_cast<uint32_t>(state.position[i])
+                                                         + static_cast<uint32_t>(unzigzag(v)));
+            }
+        }
+        if (flags & kRotationFull) {
+            if (end - p < 4) return nullptr;
+            state.rotation = get32(p);
+            p += 4;
+        } else if (flags & kHasRotation) {
+            uint32_t packed = state.rotation & (3u << 30);
+            for (int i = 0; i < 3; ++i) {
+                uint32_t v = 0;
+                if (!(p = getVarint(p, end, v))) return nullptr;
+                const int64_t component = static_cast<int64_t>(rotationComponent(state.rotation, i)) + unzigzag(v);
+                if (component < 0 || component > kRotationMask) return nullptr;
+                packed |= static_cast<uint32_t>(component) << (kRotationBits * (2 - i));
+            }
+            state.rotation = packed;
+        }
+        return p;
+    }
+
+    bool read(const uint8_t* data, size_t size) {
+        if (size < kHeaderSize || data[0] != kVersion) return false;
+        const uint32_t packetTick = get32(data + 1);
+        if (packetTick == 0) return false;
+        // Abstände vorzeichenlos: genau einer von beiden ist klein
+        const uint32_t ahead = packetTick - receivedTick;
+        const uint32_t behind = receivedTick - packetTick;
+        if (receivedTick != 0 && behind >= kHistoryTicks && ahead > kMaxTickAdvance) {
+            return false;   // zu alt für die Basis-Historie oder unplausibel weit voraus
+        }
+
+        // Erst das ganze Paket prüfen, dann übernehmen: ein kaputter Rest darf
+        // weder Bestätigungen noch Snapshots hinterlassen
+        const uint32_t count = data[25] | (data[26] << 8);
+        const uint8_t* end = data + size;
+        const uint8_t* p = data + kHeaderSize;
+        DecodedObject object;
+        size_t added = 0;
+        for (uint32_t n = 0; n < count; ++n) {
+            if (!(p = decodeObject(p, end, packetTick, object))) return false;
+            if (object.slot < 0) ++added;
+        }
+        if (remote.size() + added > config.maxObjects) return false;
+
+        const uint32_t ackTick = get32(data + 5);
+        const uint32_t ackBits = get32(data + 9);
+        acknowledge(ackTick);
+        for (uint32_t i = 0; i < 32; ++i) {
+            if (ackBits & (1u << i)) acknowledge(ackTick - 1 - i);
+        }
+        for (int i = 0; i < 3; ++i) {
+            remoteViewer[i] = static_cast<int32_t>(get32(data + 13 + 4 * i)) / kPositionScale;
+        }
+
+        // Zweiter Durchlauf liest dieselben Basen und kann nicht mehr scheitern:
+        // jedes Objekt schreibt nur den Slot von packetTick, Basen liegen 1..31 Ticks davor
+        p = data + kHeaderSize;
+        for (uint32_t n = 0; n < count; ++n) {
+            p = decodeObject(p, end, packetTick, object);
+            RemoteObject* target = remoteObject(object.id, object.name, object.nameLength);
+            Snapshot& slot = target->history[packetTick % kHistoryTicks];
+            slot.tick = packetTick;
+            slot.valid = true;
+            slot.state = object.state;
+        }
+
+        // Empfang für die Bestätigung in der Gegenrichtung vermerken
+        if (receivedTick == 0) {
+            receivedTick = packetTick;
+            receivedBits = 0;
+        } else if (ahead != 0 && ahead <= kMaxTickAdvance) {
+            receivedBits = ahead >= 32 ? 0 : (receivedBits << ahead);
+            if (ahead <= 32) receivedBits |= 1u << (ahead - 1);
+            receivedTick = packetTick;
+        } else if (behind != 0) {
+            receivedBits |= 1u << (behind - 1);   // behind < kHistoryTicks, oben geprüft
+        }
+        if (!playoutStarted) {
+            playoutTick = static_cast<double>(receivedTick) - config.interpolationDelay;
+            playoutStarted = true;
+        }
+        ++stats.packetsRead;
+        return true;
+    }
+
+    void advance(double seconds) {
+        if (!playoutStarted) return;
+        playoutTick += seconds * config.tickRate;
+        // Sanft auf "neuester Tick minus Verzögerung" ziehen, bei großem Abstand springen
+        const double target = static_cast<double>(receivedTick) - config.interpolationDelay;
+        const double error = target - playoutTick;
+        if (std::abs(error) > 2.0 * config.interpolationDelay + 2.0) {
+            playoutTick = target;
+        } else {
+            playoutTick += error * std::min(1.0, seconds * 2.0);
+        }
+    }
+
+    bool sample(const RemoteObject& object, glm::vec3& position, glm::quat& rotation) const {
+        // Umschließende Snapshots um die Abspielzeit; ohne jüngeren den neuesten halten
+        const Snapshot* before = nullptr;
+        const Snapshot* after = nullptr;
+        const Snapshot* newest = nullptr;
+        for (const Snapshot& s : object.history) {
+            if (!s.valid) continue;
+            const double t = static_cast<double>(s.tick);
+            if (!newest || age(s.tick, newest->tick) > 0) newest = &s;
+            if (t <= playoutTick) {
+                if (!before || age(s.tick, before->tick) > 0) before = &s;
+            } else if (!after || age(s.tick, after->tick) < 0) {
+                after = &s;
+            }
+        }
+        if (!newest) return false;
+        if (!before) before = after;
+        if (!after) after = before;
+
+        float t = 0.0f;
+        if (after->tick != before->tick) {
+            t = static_cast<float>((playoutTick - before->tick) / static_cast<double>(after->tick - before->tick));
+            t = std::clamp(t, 0.0f, 1.0f);
+        }
+        const float p0[3] = {before->state.position[0] / kPositionScale,
+                             before->state.position[1] / kPositionScale,
+                             before->state.position[2] / kPositionScale};
+        const float p1[3] = {after->state.position[0] / kPositionScale,
+                             after->state.position[1] / kPositionScale,
+                             after->state.position[2] / kPositionScale};
+        position = glm::vec3(p0[0] + (p1[0] - p0[0]) * t,
+                             p0[1] + (p1[1] - p0[1]) * t,
+                             p0[2] + (p1[2] - p0[2]) * t);
+
+        // Normiertes lerp über den kürzeren Bogen; zwischen nahen Snapshots reicht das
+        const glm::quat q0 = dequantizeRotation(before->state.rotation);
+        glm::quat q1 = dequantizeRotation(after->state.rotation);
+        const float dot = q0.w * q1.w + q0.x * q1.x + q0.y * q1.y + q0.z * q1.z;
+        const float s1 = dot < 0.0f ? -t : t;
+        const float w = q0.w * (1.0f - t) + q1.w * s1;
+        const float x = q0.x * (1.0f - t) + q1.x * s1;
+        const float y = q0.y * (1.0f - t) + q1.y * s1;
+        const float z = q0.z * (1.0f - t) + q1.z * s1;
+        const float length = std::sqrt(w * w + x * x + y * y + z * z);
+        rotation = length > 1e-6f ? glm::quat(w / length, x / length, y / length, z / length) : q0;
+        return true;
+    }
+
+    void clear() {
+        for (LocalObject& object : objects) {
+            object.hasAck = false;
+            object.ackedTick = 0;
+            object.priority = 0.0f;
+        }
+        for (SentRecord& record : sent) {
+            record.tick = 0;
+            record.acknowledged = false;
+            record.entries.clear();
+        }
+        tick = 0;
+        remote.clear();
+        remoteNames.clear();
+        std::fill(remoteSlots.begin(), remoteSlots.end(), -1);
+        receivedTick = 0;
+        receivedBits = 0;
+        playoutTick = 0.0;
+        playoutStarted = false;
+        stats = Stats();
+    }
+};
+
+StateReplicator::StateReplicator()
+    : StateReplicator(Config())
+{
+}
+
+StateReplicator::StateReplicator(const Config& config)
+    : pImpl(std::make_unique<Impl>(config))
+{
+}
+
+StateReplicator::~StateReplicator() = default;
+
+StateReplicator::ObjectId StateReplicator::registerObject(const std::string& name) {
+    auto it = pImpl->objectIds.find(name);
+    if (it != pImpl->objectIds.end()) return it->second;
+    if (pImpl->objects.size() >= pImpl->config.maxObjects) return kInvalidObject;
+
+    const ObjectId id = static_cast<ObjectId>(pImpl->objects.size());
+    pImpl->objects.emplace_back();
+    pImpl->objects.back().name = name;
+    pImpl->objectIds.emplace(name, id);
+    return id;
+}
+
+StateReplicator::ObjectId StateReplicator::findObject(const std::string& name) const {
+    auto it = pImpl->objectIds.find(name);
+    return it != pImpl->objectIds.end() ? it->second : kInvalidObject;
+}
+
+void StateReplicator::setTransform(ObjectId id, const glm::vec3& position, const glm::quat& rotation) {
+    if (id >= pImpl->objects.size()) return;
+    QuantizedState& state = pImpl->objects[id].state;
+    state.position[0] = quantizePosition(position.x);
+    state.position[1] = quantizePosition(position.y);
+    state.position[2] = quantizePosition(position.z);
+    state.rotation = quantizeRotation(rotation);
+}
+
+void StateReplicator::setViewer(const glm::vec3& position) {
+    pImpl->viewer[0] = quantizePosition(position.x);
+    pImpl->viewer[1] = quantizePosition(position.y);
+    pImpl->viewer[2] = quantizePosition(position.z);
+}
+
+size_t StateReplicator::writePacket(uint8_t* data, size_t capacity) {
+    return pImpl->write(data, capacity);
+}
+
+bool StateReplicator::readPacket(const uint8_t* data, size_t size) {
+    if (pImpl->read(data, size)) return true;
+    ++pImpl->stats.packetsRejected;
+    return false;
+}
+
+void StateReplicator::advance(double seconds) {
+    pImpl->advance(seconds);
+}
+
+bool StateReplicator::getRemoteTransform(const std::string& name, glm::vec3& position, glm::quat& rotation) const {
+    auto it = pImpl->remoteNames.find(name);
+    if (it == pImpl->remoteNames.end()) return false;
+    return pImpl->sample(pImpl->remote[it->second], position, rotation);
+}
+
+void StateReplicator::reset() {
+    pImpl->clear();
+}
+
+StateReplicator::Stats StateReplicator::getStats() const {
+    return pImpl->stats;
+}
+
+const StateReplicator::Config& StateReplicator::getConfig() const {
+    return pImpl->config;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace VR_DAW {
+
+// Replikation von Transformationen (Köpfe, Controller, gegriffene Regler)
+// zwischen zwei Peers, je Richtung ein StateReplicator auf jeder Seite.
+//
+// Objekte bekommen lokale Integer-IDs; der Name geht nur mit, bis die
+// Gegenseite das Objekt einmal bestätigt hat. Jeder Tick schreibt genau
+// ein Paket von höchstens packetBudget Bytes: Position auf 1/1024 m
+// quantisiert, Rotation als "smallest three" (2 + 3 * 10 Bit), beides als
+// Delta gegen den zuletzt bestätigten Zustand des Objekts. Unveränderte
+// Objekte kosten nichts.
+//
+// Interest-Management: jedes Paket trägt die Betrachterposition seines
+// Absenders. Objekte außerhalb von interestRadius um den Betrachter der
+// Gegenseite werden nicht gesendet; die übrigen sammeln Priorität nach
+// Nähe an und werden in dieser Reihenfolge bis zum Budget verpackt. Die
+// Bandbreite je Benutzer hängt damit nur vom Budget und der Tickrate ab,
+// nicht von der Objektzahl.
+//
+// Bestätigungen laufen in den Paketen der Gegenrichtung mit (letzter Tick
+// plus 32 Bit Historie). Auf der Empfangsseite wird zwischen den
+// empfangenen Snapshots interpoliert, interpolationDelay Ticks hinter dem
+// neuesten.
+//
+// Nicht thread-sicher. Nach der Konstruktion alloziert nur
+// registerObject() und das erste Auftauchen eines entfernten Objekts.
+class StateReplicator {
+public:
+    using ObjectId = uint16_t;
+    static constexpr ObjectId kInvalidObject = 0xffff;
+    static constexpr float kPositionScale = 1024.0f;    // Schritte je Meter
+    static constexpr uint32_t kHistoryTicks = 32;
+
+    struct Config {
+        double tickRate = 30.0;            // Pakete je Sekunde
+        size_t packetBudget = 1152;        // Bytes Nutzlast je Tick
+        size_t maxObjects = 4096;          // je Richtung
+        float interestRadius = 50.0f;      // Meter
+        double interpolationDelay = 3.0;   // Ticks
+    };
+
+    struct Stats {
+        uint32_t tick = 0;
+        uint64_t packetsWritten = 0;
+        uint64_t packetsRead = 0;
+        uint64_t packetsRejected = 0;   // kaputt oder veraltet
+        uint64_t bytesWritten = 0;
+        uint32_t lastPacketSize = 0;
+        uint32_t lastObjectsSent = 0;
+        uint32_t lastObjectsDeferred = 0;  // geändert, aber über dem Budget
+        uint32_t remoteObjects = 0;
+    };
+
+    StateReplicator();
+    explicit StateReplicator(const Config& config);
+    ~StateReplicator();
+
+    StateReplicator(const StateReplicator&) = delete;
+    StateReplicator& operator=(const StateReplicator&) = delete;
+
+    // Lokale Objekte. Liefert kInvalidObject, wenn maxObjects erreicht ist
+    ObjectId registerObject(const std::string& name);
+    ObjectId findObject(const std::string& name) const;
+    void setTransform(ObjectId id, const glm::vec3& position, const glm::quat& rotation);
+    // Eigene Betrachterposition, wird der Gegenseite mitgeteilt
+    void setViewer(const glm::vec3& position);
+
+    // Ein Tick: schreibt das nächste Paket, liefert seine Größe
+    size_t writePacket(uint8_t* data, size_t capacity);
+    // Paket der Gegenseite; false, wenn es verworfen wurde. Verworfene Pakete
+    // (kaputt, abgeschnitten, zu alt oder unplausibel weit voraus) ändern nichts
+    bool readPacket(const uint8_t* data, size_t size);
+
+    // Spielt die entfernten Snapshots um seconds weiter ab
+    void advance(double seconds);
+    // Interpolierte Transformation eines entfernten Objekts
+    bool getRemoteTransform(const std::string& name, glm::vec3& position, glm::quat& rotation) const;
+
+    void reset();
+    Stats getStats() const;
+    const Config& getConfig() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -1,4 +1,7 @@
 #include "WebRTCManager.hpp"
+#include "../audio/VoiceProcessor.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <map>
 #include <thread>
@@ -149,14 +152,16 @@ public:
 
     void OnData(const void* audio_data, int bits_per_sample, int sample_rate,
                 size_t number_of_channels, size_t number_of_frames) override {
+        AudioEvent event;
+        event.type = AudioEvent::Type::AudioData;
+        event.audioData = static_cast<const float*>(audio_data);
+        event.numFrames = number_of_frames;
+        event.numChannels = number_of_channels;
+        event.sampleRate = sample_rate;
+        // Referenz für die Echokompensation, auch ohne registrierten Callback
+        manager->processFarEndAudio(event);
         // Audio-Daten an den Audio-Engine weiterleiten
         if (manager->audioCallback) {
-            AudioEvent event;
-            event.type = AudioEvent::Type::AudioData;
-            event.audioData = static_cast<const float*>(audio_data);
-            event.numFrames = number_of_frames;
-            event.numChannels = number_of_channels;
-            event.sampleRate = sample_rate;
             manager->audioCallback(event);
         }
     }
@@ -175,136 +180,99 @@ public:
         config.gainControlLevel = 1.0f;
         config.sampleRate = 48000;
         config.numChannels = 2;
-        
-        // Initialisiere adaptive Filter
-        echoFilter.resize(1024, 0.0f);
-        noiseFilter.resize(1024, 0.0f);
-        learningRate = 0.01f;
+
+        voice.prepare(static_cast<float>(config.sampleRate));
+        applyConfig();
+        reserve(kInitialFrames, static_cast<size_t>(config.numChannels));
     }
 
+    // Mikrofonsignal: auf mono gemischt, verarbeitet und auf alle Kanäle
+    // verteilt. Das Ergebnis liegt in einem eigenen Puffer, event.audioData
+    // zeigt danach dorthin; gültig bis zum nächsten Aufruf
     void processAudio(AudioEvent& event) {
-        if (!enabled) return;
+        if (!enabled || event.numFrames == 0 || event.numChannels == 0) return;
 
         try {
-            // Rauschunterdrückung
-            if (config.noiseSuppression) {
-                applyNoiseSuppression(event);
-            }
-
-            // Echounterdrückung
-            if (config.echoCancellation) {
-                applyEchoCancellation(event);
+            const size_t channels = event.numChannels;
+            reserve(event.numFrames, channels);
+
+            const float scale = 1.0f / static_cast<float>(channels);
+            for (size_t i = 0; i < event.numFrames; ++i) {
+                float sum = 0.0f;
+                for (size_t c = 0; c < channels; ++c) sum += event.audioData[i * channels + c];
+                mono[i] = sum * scale;
             }
-
-            // Automatische Verstärkungsregelung
-            if (config.automaticGainControl) {
-                applyAutomaticGainControl(event);
+            voice.processNearEnd(mono.data(), event.numFrames);
+            for (size_t i = 0; i < event.numFrames; ++i) {
+                for (size_t c = 0; c < channels; ++c) output[i * channels + c] = mono[i];
             }
+            event.audioData = output.data();
         } catch (const std::exception& e) {
             throw WebRTCError(WebRTCError::ErrorCode::AudioProcessingError,
                             "Fehler bei der Audio-Verarbeitung: " + std::string(e.what()));
         }
     }
 
-    void setEnabled(bool value) { enabled = value; }
-    void setConfig(const AudioProcessingConfig& newConfig) { config = newConfig; }
+    // Fernsignal der Peers (was über die Lautsprecher läuft), Referenz der Echokompensation
+    void processFarEnd(const AudioEvent& event) {
+        if (!enabled || !config.echoCancellation || event.numFrames == 0 || event.numChannels == 0) return;
 
-private:
-    void applyNoiseSuppression(AudioEvent& event) {
-        // Spektrale Subtraktion für Rauschunterdrückung
-        std::vector<float> spectrum(event.numFrames);
-        std::vector<float> noiseFloor(event.numFrames);
-        
-        // FFT der Eingabedaten
-        for (size_t i = 0; i < event.numFrames; ++i) {
-            spectrum[i] = event.audioData[i];
-        }
-        
-        // Rauschschätzung
+        const size_t channels = event.numChannels;
+        reserve(event.numFrames, channels);
+        const float scale = 1.0f / static_cast<float>(channels);
         for (size_t i = 0; i < event.numFrames; ++i) {
-            noiseFloor[i] = std::min(noiseFloor[i], std::abs(spectrum[i]));
+            float sum = 0.0f;
+            for (size_t c = 0; c < channels; ++c) sum += event.audioData[i * channels + c];
+            farMono[i] = sum * scale;
         }
-        
-        // Spektrale Subtraktion
-        for (size_t i = 0; i < event.numFrames; ++i) {
-            float magnitude = std::abs(spectrum[i]);
-            float phase = std::arg(std::complex<float>(spectrum[i], 0.0f));
-            float denoisedMagnitude = std::max(0.0f, magnitude - noiseFloor[i]);
-            spectrum[i] = denoisedMagnitude * std::cos(phase);
-        }
-        
-        // Rücktransformation
-        for (size_t i = 0; i < event.numFrames; ++i) {
-            const_cast<float*>(event.audioData)[i] = spectrum[i];
+        voice.processFarEnd(farMono.data(), event.numFrames);
+    }
+
+    void setEnabled(bool value) {
+        if (value && !enabled) voice.reset();
+        enabled = value;
+    }
+
+    void setConfig(const AudioProcessingConfig& newConfig) {
+        const bool rateChanged = newConfig.sampleRate != config.sampleRate;
+        config = newConfig;
+        if (rateChanged && config.sampleRate > 0) {
+            voice.prepare(static_cast<float>(config.sampleRate));
         }
+        applyConfig();
+        reserve(kInitialFrames, static_cast<size_t>(std::max(config.numChannels, 1)));
     }
 
-    void applyEchoCancellation(AudioEvent& event) {
-        // Adaptiver Filter für Echounterdrückung
-        std::vector<float> output(event.numFrames * event.numChannels);
-        
-        for (size_t i = 0; i < event.numFrames * event.numChannels; ++i) {
-            float input = event.audioData[i];
-            float echoEstimate = 0.0f;
-            
-            // Filter-Operation
-            for (size_t j = 0; j < echoFilter.size(); ++j) {
-                if (i >= j) {
-                    echoEstimate += echoFilter[j] * event.audioData[i - j];
-                }
-            }
-            
-            // Fehlerberechnung und Filter-Update
-            float error = input - echoEstimate;
-            for (size_t j = 0; j < echoFilter.size(); ++j) {
-                if (i >= j) {
-                    echoFilter[j] += learningRate * error * event.audioData[i - j];
-                }
-            }
-            
-            output[i] = error;
+    size_t getLatency() const { return voice.getLatency(); }
+
+private:
+    // WebRTC liefert 10-ms-Blöcke; größere Blöcke vergrößern die Puffer einmalig
+    static constexpr size_t kInitialFrames = 4096;
+
+    void applyConfig() {
+        VoiceProcessor::Parameters params;
+        params.echoCancellation = config.echoCancellation;
+        params.noiseSuppression = config.noiseSuppression;
+        params.automaticGainControl = config.automaticGainControl;
+        // gainControlLevel ist linear relativ zum Standardziel von -23 dBFS
+        params.targetLevel += 20.0f * std::log10(std::max(config.gainControlLevel, 1e-3f));
+        voice.setParameters(params);
+    }
+
+    void reserve(size_t frames, size_t channels) {
+        if (mono.size() < frames) {
+            mono.resize(frames);
+            farMono.resize(frames);
         }
-        
-        // Ergebnis zurückkopieren
-        std::copy(output.begin(), output.end(), const_cast<float*>(event.audioData));
-    }
-
-    void applyAutomaticGainControl(AudioEvent& event) {
-        // Dynamische Verstärkungsregelung
-        float targetLevel = -23.0f; // dBFS
-        float compressionRatio = 4.0f;
-        float attackTime = 0.01f; // Sekunden
-        float releaseTime = 0.1f; // Sekunden
-        
-        float attackGain = std::exp(-1.0f / (attackTime * config.sampleRate));
-        float releaseGain = std::exp(-1.0f / (releaseTime * config.sampleRate));
-        
-        float currentGain = 1.0f;
-        float envelope = 0.0f;
-        
-        for (size_t i = 0; i < event.numFrames * event.numChannels; ++i) {
-            float input = event.audioData[i];
-            float inputLevel = 20.0f * std::log10(std::abs(input) + 1e-10f);
-            
-            // Hüllkurvenberechnung
-            float targetGain = std::pow(10.0f, (targetLevel - inputLevel) / 20.0f);
-            targetGain = std::min(1.0f, targetGain);
-            
-            // Dynamische Verstärkungsanpassung
-            if (targetGain < currentGain) {
-                currentGain = attackGain * currentGain + (1.0f - attackGain) * targetGain;
-            } else {
-                currentGain = releaseGain * currentGain + (1.0f - releaseGain) * targetGain;
-            }
-            
-            // Verstärkung anwenden
-            const_cast<float*>(event.audioData)[i] = input * currentGain;
+        if (output.size() < frames * channels) {
+            output.resize(frames * channels);
         }
     }
 
-    std::vector<float> echoFilter;
-    std::vector<float> noiseFilter;
-    float learningRate;
+    VoiceProcessor voice;
+    std::vector<float> mono;
+    std::vector<float> farMono;
+    std::vector<float> output;
     bool enabled;
     AudioProcessingConfig config;
 };
@@ -312,7 +280,10 @@ private:
 void WebRTCManager::processAudioData(const AudioEvent& event) {
     if (audioProcessor) {
         AudioEvent processedEvent = event;
-        audioProcessor->processAudio(processedEvent);
+        {
+            std::lock_guard<std::mutex> lock(audioProcessorMutex);
+            audioProcessor->processAudio(processedEvent);
+        }
         if (audioCallback) {
             audioCallback(processedEvent);
         }
@@ -321,13 +292,22 @@ void WebRTCManager::processAudioData(const AudioEvent& event) {
     }
 }
 
+void WebRTCManager::processFarEndAudio(const AudioEvent& event) {
+    std::lock_guard<std::mutex> lock(audioProcessorMutex);
+    if (audioProcessor) {
+        audioProcessor->processFarEnd(event);
+    }
+}
+
 void WebRTCManager::setAudioProcessingEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(audioProcessorMutex);
     if (audioProcessor) {
         audioProcessor->setEnabled(enabled);
     }
 }
 
 void WebRTCManager::setAudioProcessingConfig(const AudioProcessingConfig& config) {
+    std::lock_guard<std::mutex> lock(audioProcessorMutex);
     if (audioProcessor) {
         audioProcessor->setConfig(config);
     }
@@ -96,6 +96,8 @@ public:
 
     // Audio-Verarbeitung
     void processAudioData(const AudioEvent& event);
+    // Empfangenes Peer-Audio als Referenz für die Echokompensation
+    void processFarEndAudio(const AudioEvent& event);
     void setAudioProcessingEnabled(bool enabled);
     void setAudioProcessingConfig(const AudioProcessingConfig& config);
 
@@ -161,6 +161,7 @@ void Config::updateFromJson(const nlohmann::json& json) {
         synthConfig.defaultPan = synth.value("defaultPan", synthConfig.defaultPan);
         synthConfig.enableEffects = synth.value("enableEffects", synthConfig.enableEffects);
         synthConfig.maxVoices = synth.value("maxVoices", synthConfig.maxVoices);
+        synthConfig.voiceStealing = synth.value("voiceStealing", synthConfig.voiceStealing);
     }
 }
 
@@ -216,7 +217,8 @@ nlohmann::json Config::toJson() const {
         {"defaultVolume", synthConfig.defaultVolume},
         {"defaultPan", synthConfig.defaultPan},
         {"enableEffects", synthConfig.enableEffects},
-        {"maxVoices", synthConfig.maxVoices}
+        {"maxVoices", synthConfig.maxVoices},
+        {"voiceStealing", synthConfig.voiceStealing}
     };
 
     return json;
@@ -55,6 +55,7 @@ public:
         float defaultPan = 0.0f;
         bool enableEffects = true;
         int maxVoices = 16;
+        std::string voiceStealing = "oldest";
     };
 
     // Getter und Setter
@@ -0,0 +1,73 @@
+#include "UIBatcher.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace VR_DAW {
+
+void UIBatcher::clear() {
+    pending.clear();
+    keys.clear();
+    waveforms.clear();
+}
+
+void UIBatcher::add(MeshType mesh, uint32_t material, const glm::mat4& model,
+                    const glm::vec4& color, float value, float highlight) {
+    const uint32_t index = static_cast<uint32_t>(pending.size());
+    pending.push_back({model, color, glm::vec4(std::clamp(value, 0.0f, 1.0f), highlight, 0.0f, 0.0f)});
+
+    // Mesh in den obersten 8 Bit, dann Material, dann Reihenfolge (24 Bit).
+    // Ein eindeutiger Schlüssel macht die Sortierung stabil
+    const uint64_t sortKey = (static_cast<uint64_t>(mesh) << 56)
+                           | (static_cast<uint64_t>(material) << 24)
+                           | (index & 0xFFFFFFu);
+    keys.push_back({sortKey, index});
+}
+
+void UIBatcher::addWaveform(const glm::mat4& model, const glm::vec4& color,
+                            const float* samples, size_t numSamples, float highlight) {
+    const size_t row = getWaveformCount();
+    waveforms.resize(waveforms.size() + kWaveformResolution, 0.0f);
+    float* out = waveforms.data() + row * kWaveformResolution;
+
+    // Spitzenwert je Punkt mit Vorzeichen, damit Transienten sichtbar bleiben
+    if (samples && numSamples > 0) {
+        for (size_t i = 0; i < kWaveformResolution; ++i) {
+            const size_t begin = i * numSamples / kWaveformResolution;
+            const size_t end = std::max(begin + 1, (i + 1) * numSamples / kWaveformResolution);
+            float peak = 0.0f;
+            for (size_t s = begin; s < end && s < numSamples; ++s) {
+                if (std::abs(samples[s]) > std::abs(peak)) {
+                    peak = samples[s];
+                }
+            }
+            out[i] = std::clamp(peak, -1.0f, 1.0f);
+        }
+    }
+
+    add(MeshType::Waveform, 0, model, color, 0.0f, highlight);
+    pending.back().params.z = static_cast<float>(row);
+}
+
+void UIBatcher::build() {
+    std::sort(keys.begin(), keys.end(),
+              [](const Key& a, const Key& b) { return a.sortKey < b.sortKey; });
+
+    sorted.clear();
+    sorted.reserve(keys.size());
+    batches.clear();
+
+    for (const Key& key : keys) {
+        const MeshType mesh = static_cast<MeshType>(key.sortKey >> 56);
+        const uint32_t material = static_cast<uint32_t>(key.sortKey >> 24);
+
+        if (batches.empty() || batches.back().mesh != mesh || batches.back().material != material) {
+            batches.push_back({mesh, material, static_cast<uint32_t>(sorted.size()), 0});
+        }
+        sorted.push_back(pending[key.index]);
+        ++batches.back().instanceCount;
+    }
+
+    ++generation;
+}
+
+} // namespace VR_DAW
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace VR_DAW {
+
+// Sammelt die UI-Elemente eines Frames und gruppiert sie nach Mesh und
+// Material. Jede Gruppe wird zu einem instanzierten Draw (UIInstanceRenderer);
+// Transformation, Farbe und Wert jedes Elements liegen in den Instanzdaten.
+// Reine CPU-Seite ohne GL-Aufrufe.
+class UIBatcher {
+public:
+    // Gemeinsame Meshes aus UIMeshGenerator, in Einheitsgröße; die Größe
+    // des Elements steckt in der Modellmatrix
+    enum class MeshType : uint8_t {
+        Panel,      // Hintergrund von Track-, Plugin- und Synthesizer-Views
+        Button,
+        Slider,
+        Knob,
+        Waveform
+    };
+    static constexpr size_t kMeshTypeCount = 5;
+
+    // Punkte je Wellenform; Samples werden auf Spitzenwerte je Punkt reduziert
+    static constexpr size_t kWaveformResolution = 256;
+
+    // Layout entspricht den Instanz-Attributen im Shader (4 x vec4 Matrix,
+    // Farbe, Parameter)
+    struct Instance {
+        glm::mat4 model;
+        glm::vec4 color;
+        // x: Wert 0..1 (Slider-Füllung, Knopf-Stellung), y: Hervorhebung,
+        // z: Zeile in der Wellenform-Textur
+        glm::vec4 params;
+    };
+
+    struct Batch {
+        MeshType mesh;
+        uint32_t material;       // Textur-ID, 0 = ohne Textur
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+    };
+
+    void clear();
+
+    void add(MeshType mesh, uint32_t material, const glm::mat4& model,
+             const glm::vec4& color, float value = 0.0f, float highlight = 0.0f);
+    void addWaveform(const glm::mat4& model, const glm::vec4& color,
+                     const float* samples, size_t numSamples, float highlight = 0.0f);
+
+    // Sortiert nach (Mesh, Material) und bildet die Batches. Innerhalb eines
+    // Batches bleibt die Reihenfolge des Hinzufügens erhalten
+    void build();
+
+    const std::vector<Instance>& getInstances() const { return sorted; }
+    const std::vector<Batch>& getBatches() const { return batches; }
+    // kWaveformResolution Werte je Zeile, Zeile = params.z der Instanz
+    const std::vector<float>& getWaveforms() const { return waveforms; }
+    size_t getWaveformCount() const { return waveforms.size() / kWaveformResolution; }
+
+    // Zählt bei jedem build() hoch; der Renderer lädt Instanzdaten nur neu,
+    // wenn sie sich geändert haben (z.B. nicht für das zweite Auge)
+    uint64_t getGeneration() const { return generation; }
+
+private:
+    struct Key {
+        uint64_t sortKey;  // Mesh, Material, Reihenfolge
+        uint32_t index;
+    };
+
+    std::vector<Instance> pending;
+    std::vector<Key> keys;
+    std::vector<Instance> sorted;
+    std::vector<Batch> batches;
+    std::vector<float> waveforms;
+    uint64_t generation = 0;
+};
+
+} // namespace VR_DAW
@@ -0,0 +1,424 @@
+#include "UIInstanceRenderer.hpp"
+#include "UIMeshGenerator.hpp"
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace VR_DAW {
+
+namespace {
+
+// Instanz-Attribute: 3..6 Modellmatrix, 7 Farbe, 8 Parameter
+constexpr GLuint kModelAttribute = 3;
+constexpr GLuint kColorAttribute = 7;
+constexpr GLuint kParamsAttribute = 8;
+
+// Anzahl der Buffer-Regionen, damit die CPU nie in Daten schreibt, die die
+// GPU noch liest
+constexpr size_t kRegionCount = 3;
+
+// Shader-Modus je Mesh
+constexpr GLint kModePlain = 0;
+constexpr GLint kModeValue = 1;     // Slider und Knopf: Anteil bis zum Wert hell
+constexpr GLint kModeWaveform = 2;
+
+const char* kVertexShader = R"(
+    #version 410 core
+    layout (location = 0) in vec3 aPos;
+    layout (location = 1) in vec2 aTexCoord;
+    layout (location = 2) in vec3 aNormal;
+    layout (location = 3) in mat4 aModel;
+    layout (location = 7) in vec4 aColor;
+    layout (location = 8) in vec4 aParams;
+
+    out vec2 TexCoord;
+    out vec3 Normal;
+    out vec4 Color;
+    out vec4 Params;
+
+    uniform mat4 view;
+    uniform mat4 projection;
+    uniform int mode;
+    uniform sampler2D waveform;
+
+    void main() {
+        vec3 pos = aPos;
+        // Sample-Vertices (v = 0.5) mit dem Wert aus der Wellenform-Zeile skalieren
+        if (mode == 2 && aTexCoord.y > 0.25) {
+            int column = int(aTexCoord.x * float(textureSize(waveform, 0).x - 1) + 0.5);
+            pos.y *= texelFetch(waveform, ivec2(column, int(aParams.z)), 0).r;
+        }
+        Normal = mat3(aModel) * aNormal;
+        TexCoord = aTexCoord;
+        Color = aColor;
+        Params = aParams;
+        gl_Position = projection * view * aModel * vec4(pos, 1.0);
+    }
+)";
+
+const char* kFragmentShader = R"(
+    #version 410 core
+    in vec2 TexCoord;
+    in vec3 Normal;
+    in vec4 Color;
+    in vec4 Params;
+
+    out vec4 FragColor;
+
+    uniform int mode;
+    uniform bool hasMaterial;
+    uniform sampler2D material;
+
+    void main() {
+        vec4 color = Color;
+        if (hasMaterial) {
+            color *= texture(material, TexCoord);
+        }
+        if (mode == 1 && TexCoord.x > Params.x) {
+            color.rgb *= 0.35;
+        }
+        color.rgb = mix(color.rgb, vec3(1.0), Params.y * 0.3);
+
+        float light = 0.6 + 0.4 * max(dot(normalize(Normal), vec3(0.0, 0.0, 1.0)), 0.0);
+        FragColor = vec4(color.rgb * light, color.a);
+    }
+)";
+
+GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "Fehler beim Kompilieren des UI-Instanz-Shaders: " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+} // namespace
+
+struct UIInstanceRenderer::Impl {
+    bool initialized = false;
+    size_t maxInstances = 0;
+    size_t maxWaveforms = 0;
+
+    std::array<VRRenderer::Mesh, UIBatcher::kMeshTypeCount> meshes{};
+
+    GLuint program = 0;
+    GLint viewLocation = -1;
+    GLint projectionLocation = -1;
+    GLint modeLocation = -1;
+    GLint hasMaterialLocation = -1;
+
+    GLuint instanceBuffer = 0;
+    GLuint waveformTexture = 0;
+
+    // Dauerhaft gemappter Buffer: kRegionCount Regionen mit je einem Fence
+    bool persistent = false;
+    unsigned char* mapped = nullptr;
+    size_t regionSize = 0;
+    size_t region = 0;
+    std::array<GLsync, kRegionCount> fences{};
+
+    uint64_t uploadedGeneration = 0;
+    size_t uploadedInstances = 0;
+
+    void createMeshes();
+    void setupInstanceAttributes(const VRRenderer::Mesh& mesh);
+    bool createInstanceBuffer();
+    void waitForRegion(size_t index);
+    void upload(const UIBatcher& batcher);
+};
+
+void UIInstanceRenderer::Impl::createMeshes() {
+    // Einheitsgrößen; Größe und Lage kommen aus der Modellmatrix der Instanz.
+    // Die Meshes gehören dem VRRenderer und werden dort freigegeben
+    meshes[static_cast<size_t>(UIBatcher::MeshType::Panel)] = UIMeshGenerator::createQuad(1.0f, 1.0f);
+    meshes[static_cast<size_t>(UIBatcher::MeshType::Button)] = UIMeshGenerator::createButton(1.0f, 1.0f, 1.0f);
+    meshes[static_cast<size_t>(UIBatcher::MeshType::Slider)] = UIMeshGenerator::createSlider(1.0f, 1.0f, 1.0f);
+    meshes[static_cast<size_t>(UIBatcher::MeshType::Knob)] = UIMeshGenerator::createKnob(0.5f, 1.0f, 32);
+    // Sample-Vertices auf voller Höhe; der Shader skaliert sie je Instanz
+    meshes[static_cast<size_t>(UIBatcher::MeshType::Waveform)] = UIMeshGenerator::createWaveform(
+        1.0f, 1.0f, 0.0f, std::vector<float>(UIBatcher::kWaveformResolution, 1.0f));
+}
+
+void UIInstanceRenderer::Impl::setupInstanceAttributes(const VRRenderer::Mesh& mesh) {
+    glBindVertexArray(mesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (GLuint i = 0; i < 4; ++i) {
+        glEnableVertexAttribArray(kModelAttribute + i);
+        glVertexAttribDivisor(kModelAttribute + i, 1);
+    }
+    glEnableVertexAttribArray(kColorAttribute);
+    glVertexAttribDivisor(kColorAttribute, 1);
+    glEnableVertexAttribArray(kParamsAttribute);
+    glVertexAttribDivisor(kParamsAttribute, 1);
+    glBindVertexArray(0);
+}
+
+bool UIInstanceRenderer::Impl::createInstanceBuffer() {
+    regionSize = maxInstances * sizeof(UIBatcher::Instance);
+
+    glGenBuffers(1, &instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+#ifdef GL_MAP_PERSISTENT_BIT
+    if (glBufferStorage != nullptr) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, regionSize * kRegionCount, nullptr, flags);
+        mapped = static_cast<unsigned char*>(
+            glMapBufferRange(GL_ARRAY_BUFFER, 0, regionSize * kRegionCount, flags));
+        persistent = mapped != nullptr;
+    }
+#endif
+
+    if (!persistent) {
+        glBufferData(GL_ARRAY_BUFFER, regionSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return glGetError() == GL_NO_ERROR;
+}
+
+void UIInstanceRenderer::Impl::waitForRegion(size_t index) {
+    GLsync& fence = fences[index];
+    if (!fence) return;
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    while (result == GL_TIMEOUT_EXPIRED) {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void UIInstanceRenderer::Impl::upload(const UIBatcher& batcher) {
+    const auto& instances = batcher.getInstances();
+    uploadedInstances = std::min(instances.size(), maxInstances);
+    const size_t bytes = uploadedInstances * sizeof(UIBatcher::Instance);
+
+    if (persistent) {
+        region = (region + 1) % kRegionCount;
+        waitForRegion(region);
+        if (bytes > 0) {
+            std::memcpy(mapped + region * regionSize, instances.data(), bytes);
+        }
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        // Verwaisen statt auf die GPU zu warten
+        glBufferData(GL_ARRAY_BUFFER, regionSize, nullptr, GL_STREAM_DRAW);
+        if (bytes > 0) {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    const size_t rows = std::min(batcher.getWaveformCount(), maxWaveforms);
+    if (rows > 0) {
+        glBindTexture(GL_TEXTURE_2D, waveformTexture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
+                        static_cast<GLsizei>(UIBatcher::kWaveformResolution),
+                        static_cast<GLsizei>(rows), GL_RED, GL_FLOAT,
+                        batcher.getWaveforms().data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    uploadedGeneration = batcher.getGeneration();
+}
+
+UIInstanceRenderer::UIInstanceRenderer()
+    : pImpl(std::make_unique<Impl>())
+{
+}
+
+UIInstanceRenderer::~UIInstanceRenderer() {
+    shutdown();
+}
+
+bool UIInstanceRenderer::initialize(size_t maxInstances, size_t maxWaveforms) {
+    if (pImpl->initialized) return true;
+
+    pImpl->maxInstances = std::max<size_t>(1, maxInstances);
+    pImpl->maxWaveforms = std::max<size_t>(1, maxWaveforms);
+
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, kVertexShader);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+    if (!vertexShader || !fragmentShader) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return false;
+    }
+
+    pImpl->program = glCreateProgram();
+    glAttachShader(pImpl->program, vertexShader);
+    glAttachShader(pImpl->program, fragmentShader);
+    glLinkProgram(pImpl->program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(pImpl->program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        std::cerr << "Fehler beim Linken des UI-Instanz-Shaders" << std::endl;
+        glDeleteProgram(pImpl->program);
+        pImpl->program = 0;
+        return false;
+    }
+
+    pImpl->viewLocation = glGetUniformLocation(pImpl->program, "view");
+    pImpl->projectionLocation = glGetUniformLocation(pImpl->program, "projection");
+    pImpl->modeLocation = glGetUniformLocation(pImpl->program, "mode");
+    pImpl->hasMaterialLocation = glGetUniformLocation(pImpl->program, "hasMaterial");
+    glUseProgram(pImpl->program);
+    glUniform1i(glGetUniformLocation(pImpl->program, "waveform"), 0);
+    glUniform1i(glGetUniformLocation(pImpl->program, "material"), 1);
+    glUseProgram(0);
+
+    // Wellenform-Textur, eine Zeile je Wellenform-Instanz
+    glGenTextures(1, &pImpl->waveformTexture);
+    glBindTexture(GL_TEXTURE_2D, pImpl->waveformTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F,
+                 static_cast<GLsizei>(UIBatcher::kWaveformResolution),
+                 static_cast<GLsizei>(pImpl->maxWaveforms), 0, GL_RED, GL_FLOAT, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (!pImpl->createInstanceBuffer()) {
+        std::cerr << "Fehler beim Anlegen des UI-Instanz-Buffers" << std::endl;
+        pImpl->initialized = true;
+        shutdown();
+        return false;
+    }
+
+    pImpl->createMeshes();
+    for (const auto& mesh : pImpl->meshes) {
+        pImpl->setupInstanceAttributes(mesh);
+    }
+
+    pImpl->initialized = true;
+    return true;
+}
+
+void UIInstanceRenderer::shutdown() {
+    if (!pImpl || !pImpl->initialized) return;
+
+    for (size_t i = 0; i < kRegionCount; ++i) {
+        if (pImpl->fences[i]) {
+            glDeleteSync(pImpl->fences[i]);
+            pImpl->fences[i] = nullptr;
+        }
+    }
+    if (pImpl->mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, pImpl->instanceBuffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        pImpl->mapped = nullptr;
+    }
+    glDeleteBuffers(1, &pImpl->instanceBuffer);
+    glDeleteTextures(1, &pImpl->waveformTexture);
+    glDeleteProgram(pImpl->program);
+
+    pImpl->instanceBuffer = 0;
+    pImpl->waveformTexture = 0;
+    pImpl->program = 0;
+    pImpl->persistent = false;
+    pImpl->uploadedGeneration = 0;
+    pImpl->uploadedInstances = 0;
+    pImpl->initialized = false;
+}
+
+bool UIInstanceRenderer::isInitialized() const {
+    return pImpl->initialized;
+}
+
+bool UIInstanceRenderer::isPersistentlyMapped() const {
+    return pImpl->persistent;
+}
+
+size_t UIInstanceRenderer::render(const UIBatcher& batcher, const glm::mat4& viewMatrix,
+                                  const glm::mat4& projectionMatrix) {
+    if (!pImpl->initialized) return 0;
+
+    if (batcher.getGeneration() != pImpl->uploadedGeneration) {
+        pImpl->upload(batcher);
+    }
+    if (pImpl->uploadedInstances == 0) return 0;
+
+    glUseProgram(pImpl->program);
+    glUniformMatrix4fv(pImpl->viewLocation, 1, GL_FALSE, glm::value_ptr(viewMatrix));
+    glUniformMatrix4fv(pImpl->projectionLocation, 1, GL_FALSE, glm::value_ptr(projectionMatrix));
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, pImpl->waveformTexture);
+    glBindBuffer(GL_ARRAY_BUFFER, pImpl->instanceBuffer);
+
+    const GLsizei stride = sizeof(UIBatcher::Instance);
+    const size_t regionOffset = pImpl->persistent ? pImpl->region * pImpl->regionSize : 0;
+    size_t drawCalls = 0;
+
+    for (const auto& batch : batcher.getBatches()) {
+        if (batch.firstInstance >= pImpl->uploadedInstances) break;
+        const size_t count = std::min<size_t>(batch.instanceCount,
+                                              pImpl->uploadedInstances - batch.firstInstance);
+
+        const VRRenderer::Mesh& mesh = pImpl->meshes[static_cast<size_t>(batch.mesh)];
+        glBindVertexArray(mesh.vao);
+
+        // GL 4.1 kennt kein BaseInstance; stattdessen zeigen die
+        // Instanz-Attribute direkt auf die erste Instanz des Batches
+        const size_t base = regionOffset + batch.firstInstance * sizeof(UIBatcher::Instance);
+        for (GLuint i = 0; i < 4; ++i) {
+            glVertexAttribPointer(kModelAttribute + i, 4, GL_FLOAT, GL_FALSE, stride,
+                                  (void*)(base + offsetof(UIBatcher::Instance, model) + i * sizeof(glm::vec4)));
+        }
+        glVertexAttribPointer(kColorAttribute, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(UIBatcher::Instance, color)));
+        glVertexAttribPointer(kParamsAttribute, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(UIBatcher::Instance, params)));
+
+        GLint mode = kModePlain;
+        if (batch.mesh == UIBatcher::MeshType::Slider || batch.mesh == UIBatcher::MeshType::Knob) {
+            mode = kModeValue;
+        } else if (batch.mesh == UIBatcher::MeshType::Waveform) {
+            mode = kModeWaveform;
+        }
+        glUniform1i(pImpl->modeLocation, mode);
+        glUniform1i(pImpl->hasMaterialLocation, batch.material != 0);
+        if (batch.material != 0) {
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, batch.material);
+            glActiveTexture(GL_TEXTURE0);
+        }
+
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(mesh.indexCount),
+                                GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(count));
+        ++drawCalls;
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Fence hinter allen Draws, die diese Region lesen (auch das zweite Auge)
+    if (pImpl->persistent) {
+        GLsync& fence = pImpl->fences[pImpl->region];
+        if (fence) glDeleteSync(fence);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    return drawCalls;
+}
+
+} // namespace VR_DAW
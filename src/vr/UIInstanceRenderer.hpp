@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <glm/glm.hpp>
+#include "UIBatcher.hpp"
+
+namespace VR_DAW {
+
+// Zeichnet die Batches eines UIBatcher mit einem instanzierten Draw je
+// (Mesh, Material). Die Instanzdaten liegen in einem dauerhaft gemappten,
+// dreifach gepufferten Buffer (glBufferStorage, GL 4.4 bzw.
+// ARB_buffer_storage); ohne diese Erweiterung wird der Buffer je Frame
+// neu angelegt und mit glBufferSubData befüllt.
+//
+// Wellenformen stehen zeilenweise in einer R32F-Textur; der Shader skaliert
+// die Sample-Vertices des gemeinsamen Wellenform-Meshes mit diesen Werten.
+// Alle Methoden müssen im Thread mit dem aktiven GL-Kontext laufen.
+class UIInstanceRenderer {
+public:
+    UIInstanceRenderer();
+    ~UIInstanceRenderer();
+
+    UIInstanceRenderer(const UIInstanceRenderer&) = delete;
+    UIInstanceRenderer& operator=(const UIInstanceRenderer&) = delete;
+
+    bool initialize(size_t maxInstances = 16384, size_t maxWaveforms = 512);
+    void shutdown();
+    bool isInitialized() const;
+
+    // Lädt Instanzen und Wellenformen nur hoch, wenn der Batcher seit dem
+    // letzten Aufruf neu gebaut wurde; ein zweiter Aufruf mit der Matrix des
+    // anderen Auges zeichnet nur. Liefert die Zahl der Draw-Calls
+    size_t render(const UIBatcher& batcher, const glm::mat4& viewMatrix,
+                  const glm::mat4& projectionMatrix);
+
+    // true, wenn der Instanz-Buffer dauerhaft gemappt ist
+    bool isPersistentlyMapped() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace VR_DAW
@@ -1,14 +1,271 @@
 #include "VRAudio.hpp"
+#include "../audio/AcousticPropagation.hpp"
+#include "../audio/Ambisonics.hpp"
+#include "../audio/BinauralRenderer.hpp"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace VR_DAW {
 
 struct VRAudio::Impl {
-    // Implementierungsdetails hier
+    static constexpr size_t kMaxSources = 256;
+    // Hinter den Quellen je ein Slot für die Reflexionen einer Wand
+    static constexpr size_t kMaxSlots = kMaxSources + AcousticPropagation::kNumWalls;
+    static constexpr float kDefaultSampleRate = 48000.0f;
+    // Zeitkonstante, mit der die Kopfdrehung zwischen Tracking-Updates
+    // blockweise nachgeführt wird
+    static constexpr float kOrientationSmoothing = 0.005f;
+    // Längste Fortschreibung der Hörerposition mit der Geschwindigkeit
+    static constexpr float kMaxExtrapolation = 0.1f;
+    // Grundmaße des Raums in Metern, skaliert mit roomSize
+    static constexpr float kRoomWidth = 8.0f;
+    static constexpr float kRoomHeight = 3.0f;
+    static constexpr float kRoomDepth = 10.0f;
+
+    using SampleBuffer = std::shared_ptr<const std::vector<float>>;
+
+    // Steuerseite, nur unter mutex
+    struct Slot {
+        int sourceId = -1;
+        SampleBuffer samples;
+        float sampleRate = kDefaultSampleRate;
+        bool playing = false;
+        bool rewind = false;
+    };
+
+    // Kopie für den Audio-Thread, bei jedem erfolgreichen try_lock
+    // abgeglichen. Nur die Felder, die das Rendern braucht (ohne Strings)
+    struct Voice {
+        int sourceId = -1;
+        SampleBuffer samples;
+        float sampleRate = kDefaultSampleRate;
+        bool playing = false;
+        bool ended = false;
+        double position = 0.0;
+        glm::vec3 location = glm::vec3(0.0f);
+        float volume = 1.0f;
+        float pitch = 1.0f;
+        float minDistance = 1.0f;
+        float maxDistance = 100.0f;
+        float rolloff = 1.0f;
+        DistanceModel distanceModel = DistanceModel::Inverse;
+        bool loop = false;
+        bool spatial = true;
+        bool doppler = true;
+    };
+
+    // Alles, was an HRTF, Abtastrate und Ordnung hängt; wird als Ganzes
+    // getauscht. Jede Quelle läuft zuerst durch die Ausbreitung. Ordnung 0:
+    // dann direkt über den BinauralRenderer, sonst Kodieren in den Bus,
+    // Drehen, einmal binaural dekodieren
+    struct Spatializer {
+        std::unique_ptr<AcousticPropagation> propagation;
+        std::unique_ptr<BinauralRenderer> renderer;
+        std::unique_ptr<AmbisonicEncoder> encoder;
+        std::unique_ptr<AmbisonicBus> bus;
+        std::unique_ptr<AmbisonicRotator> rotator;
+        std::unique_ptr<AmbisonicBinauralDecoder> decoder;
+
+        size_t getLatency() const {
+            return renderer ? renderer->getLatency() : decoder->getLatency();
+        }
+
+        void resetSource(size_t slot) {
+            propagation->resetSource(slot);
+            if (renderer) renderer->resetSource(slot);
+            if (encoder) encoder->resetSource(slot);
+        }
+    };
+
+    std::mutex mutex;
+    float sampleRate = kDefaultSampleRate;
+    int ambisonicOrder = 0;
+    std::shared_ptr<const HRTFSet> hrtf;
+    AcousticPropagation::Room room;
+    bool roomChanged = true;
+    std::vector<Slot> slots;
+    std::unordered_map<int, size_t> slotOfSource;
+    // Puffer, die der Audio-Thread noch halten kann; update() gibt sie frei
+    std::vector<SampleBuffer> retired;
+    // Neuer Spatializer (HRTF/Abtastrate/Ordnung), vom Audio-Thread
+    // eingetauscht; danach liegt hier der alte und wird in update() freigegeben
+    std::unique_ptr<Spatializer> pendingSpatializer;
+    bool spatializerPending = false;
+
+    // Audio-Thread
+    std::unique_ptr<Spatializer> spatializer;
+    std::vector<Voice> voices;
+    std::vector<std::vector<float>> scratch;
+    std::vector<const float*> inputs;
+    // Ausbreitung: Parameter je Quelle, Ausgänge je Quelle und je Wand.
+    // rendered: Eingänge des Spatializers für alle kMaxSlots
+    std::vector<AcousticPropagation::Source> propagationSources;
+    std::vector<std::vector<float>> propagated;
+    std::vector<std::vector<float>> reflections;
+    std::vector<float*> propagatedOutputs, reflectionOutputs;
+    std::vector<const float*> rendered;
+    std::vector<BinauralRenderer::SourceState> states;
+    // Bus-Pfad: weltbezogene Richtungen und Pegel je Slot (SoA)
+    std::vector<float> directionX, directionY, directionZ, gains;
+    float renderRate = kDefaultSampleRate;
+    // Gemeldete Hörerposition und -geschwindigkeit; listenerPosition ist
+    // die seit dem letzten Update mit der Geschwindigkeit fortgeschriebene
+    glm::vec3 listenerReported = glm::vec3(0.0f);
+    glm::vec3 listenerVelocity = glm::vec3(0.0f);
+    float listenerAge = 0.0f;
+    glm::vec3 listenerPosition = glm::vec3(0.0f);
+    glm::quat listenerTarget = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::quat listenerSmoothed = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+    Impl()
+        : slots(kMaxSources)
+        , voices(kMaxSources)
+        , inputs(kMaxSources, nullptr)
+        , propagationSources(kMaxSources)
+        , rendered(kMaxSlots, nullptr)
+        , states(kMaxSlots)
+        , directionX(kMaxSlots, 0.0f)
+        , directionY(kMaxSlots, 0.0f)
+        , directionZ(kMaxSlots, -1.0f)
+        , gains(kMaxSlots, 1.0f)
+    {
+    }
+
+    // Steuerseite: Spatializer für HRTF-Satz und Ordnung vorbereiten
+    static std::unique_ptr<Spatializer> createSpatializer(std::shared_ptr<const HRTFSet> hrtf, int order) {
+        auto spatializer = std::make_unique<Spatializer>();
+        const size_t blockSize = hrtf->getBlockSize();
+        spatializer->propagation = std::make_unique<AcousticPropagation>(kMaxSources, hrtf->getSampleRate(), blockSize);
+        if (order == 0) {
+            spatializer->renderer = std::make_unique<BinauralRenderer>(std::move(hrtf), kMaxSlots);
+            return spatializer;
+        }
+        spatializer->encoder = std::make_unique<AmbisonicEncoder>(order, kMaxSlots);
+        spatializer->bus = std::make_unique<AmbisonicBus>(order, blockSize);
+        spatializer->rotator = std::make_unique<AmbisonicRotator>(order);
+        spatializer->decoder = std::make_unique<AmbisonicBinauralDecoder>(order, std::move(hrtf));
+        return spatializer;
+    }
+
+    // Steuerseite, mutex gehalten: zum Eintauschen bereitstellen. Ein noch
+    // nicht übernommener Vorgänger wird zurückgegeben und außerhalb freigegeben
+    std::unique_ptr<Spatializer> schedule(std::unique_ptr<Spatializer> next) {
+        std::unique_ptr<Spatializer> previous = std::move(pendingSpatializer);
+        pendingSpatializer = std::move(next);
+        spatializerPending = true;
+        return previous;
+    }
+
+    void retire(SampleBuffer& buffer) {
+        if (buffer) retired.push_back(std::move(buffer));
+        buffer.reset();
+    }
+
+    // Audio-Thread, mutex gehalten: Steuerzustand in die Voices übernehmen
+    void synchronize(const std::map<int, AudioSource>& sources, const glm::vec3& position,
+                     const glm::quat& orientation, const glm::vec3& velocity) {
+        if (spatializerPending) {
+            std::swap(spatializer, pendingSpatializer);
+            spatializerPending = false;
+            renderRate = sampleRate;
+            roomChanged = true;
+            for (auto& voice : voices) voice.sourceId = -1;
+        }
+        if (roomChanged && spatializer) {
+            spatializer->propagation->setRoom(room);
+            roomChanged = false;
+        }
+        if (position != listenerReported) {
+            listenerReported = position;
+            listenerAge = 0.0f;
+        }
+        listenerVelocity = velocity;
+        listenerTarget = orientation;
+
+        for (size_t i = 0; i < kMaxSources; ++i) {
+            Slot& slot = slots[i];
+            Voice& voice = voices[i];
+            if (voice.ended) {
+                slot.playing = false;
+                slot.rewind = true;
+                voice.ended = false;
+            }
+            if (voice.sourceId != slot.sourceId) {
+                // Neu belegt; der alte Puffer liegt in retired
+                voice = Voice();
+                voice.sourceId = slot.sourceId;
+                if (spatializer) spatializer->resetSource(i);
+            }
+            if (slot.sourceId < 0) continue;
+
+            if (slot.rewind) {
+                voice.position = 0.0;
+                slot.rewind = false;
+            }
+            voice.playing = slot.playing;
+            voice.samples = slot.samples;
+            voice.sampleRate = slot.sampleRate;
+
+            auto it = sources.find(slot.sourceId);
+            if (it == sources.end()) continue;
+            const AudioSource& source = it->second;
+            voice.location = source.position;
+            voice.volume = source.volume;
+            voice.pitch = source.pitch;
+            voice.minDistance = source.minDistance;
+            voice.maxDistance = source.maxDistance;
+            voice.rolloff = source.rolloff;
+            voice.distanceModel = source.distanceModel;
+            voice.loop = source.loop;
+            voice.spatial = source.spatial;
+            voice.doppler = source.doppler;
+        }
+    }
+
+    // Audio-Thread: frames Samples der Quelle mit Tonhöhe nach target
+    void readVoice(Voice& voice, float* target, size_t frames) {
+        const std::vector<float>& samples = *voice.samples;
+        const size_t length = samples.size();
+        const double step = static_cast<double>(voice.sampleRate) / renderRate * std::max(voice.pitch, 0.0f);
+
+        for (size_t n = 0; n < frames; ++n) {
+            if (voice.position >= length) {
+                if (voice.loop && length > 0) {
+                    voice.position = std::fmod(voice.position, static_cast<double>(length));
+                } else {
+                    std::fill(target + n, target + frames, 0.0f);
+                    voice.playing = false;
+                    voice.ended = true;
+                    return;
+                }
+            }
+            const size_t index = static_cast<size_t>(voice.position);
+            const float fraction = static_cast<float>(voice.position - index);
+            const size_t next = index + 1 < length ? index + 1 : (voice.loop ? 0 : index);
+            target[n] = samples[index] + fraction * (samples[next] - samples[index]);
+            voice.position += step;
+        }
+    }
+
+    // Audio-Thread: Parameter der Ausbreitung aus der Voice
+    static void describe(const Voice& voice, AcousticPropagation::Source& source) {
+        source.x = voice.location.x;
+        source.y = voice.location.y;
+        source.z = voice.location.z;
+        source.gain = voice.volume;
+        source.minDistance = voice.minDistance;
+        source.maxDistance = voice.maxDistance;
+        source.rolloff = voice.rolloff;
+        source.model = voice.distanceModel;
+        source.spatial = voice.spatial;
+        source.doppler = voice.doppler;
+    }
 };
 
 VRAudio::VRAudio()
@@ -24,10 +281,9 @@ VRAudio::VRAudio()
     , reverbGain(0.32f)
     , reverbGainHF(0.89f)
 {
-    listener.position = glm::vec3(0.0f);
-    listener.rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-    listener.volume = 1.0f;
-    listener.spatialBlend = 1.0f;
+    listenerPosition = glm::vec3(0.0f);
+    listenerOrientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    listenerVelocity = glm::vec3(0.0f);
 }
 
 VRAudio::~VRAudio() {
@@ -39,11 +295,7 @@ bool VRAudio::initialize() {
         return true;
     }
 
-    // Initialisierung des Audio-Systems
-    // TODO: Implementierung der Audio-System-Initialisierung
-    // - Initialisierung der Audio-API
-    // - Erstellung der Audio-Pipeline
-    // - Konfiguration der 3D-Audio-Einstellungen
+    initializeAudio();
 
     initialized = true;
     return true;
@@ -55,6 +307,7 @@ void VRAudio::shutdown() {
     }
 
     // Aufräumen des Audio-Systems
+    shutdownAudio();
     sources.clear();
     streams.clear();
     recorders.clear();
@@ -100,7 +353,18 @@ int VRAudio::createSource(const std::string& name, const AudioSource& source) {
 
     static int nextId = 0;
     int sourceId = nextId++;
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     sources[sourceId] = source;
+    // Ohne freien Slot bleibt die Quelle stumm
+    for (size_t i = 0; i < pImpl->slots.size(); ++i) {
+        if (pImpl->slots[i].sourceId < 0) {
+            pImpl->slots[i] = Impl::Slot();
+            pImpl->slots[i].sourceId = sourceId;
+            pImpl->slotOfSource[sourceId] = i;
+            break;
+        }
+    }
     return sourceId;
 }
 
@@ -109,7 +373,15 @@ void VRAudio::destroySource(int sourceId) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     sources.erase(sourceId);
+    auto it = pImpl->slotOfSource.find(sourceId);
+    if (it != pImpl->slotOfSource.end()) {
+        Impl::Slot& slot = pImpl->slots[it->second];
+        pImpl->retire(slot.samples);
+        slot = Impl::Slot();
+        pImpl->slotOfSource.erase(it);
+    }
 }
 
 void VRAudio::updateSource(int sourceId, const AudioSource& source) {
@@ -117,6 +389,7 @@ void VRAudio::updateSource(int sourceId, const AudioSource& source) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = sources.find(sourceId);
     if (it != sources.end()) {
         it->second = source;
@@ -128,6 +401,7 @@ VRAudio::AudioSource VRAudio::getSource(int sourceId) const {
         return AudioSource();
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = sources.find(sourceId);
     if (it != sources.end()) {
         return it->second;
@@ -140,7 +414,12 @@ void VRAudio::playSource(int sourceId) {
         return;
     }
 
-    // TODO: Implementierung der Audio-Quellen-Wiedergabe
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->slotOfSource.find(sourceId);
+    if (it != pImpl->slotOfSource.end()) {
+        pImpl->slots[it->second].playing = true;
+        playing = true;
+    }
 }
 
 void VRAudio::pauseSource(int sourceId) {
@@ -148,7 +427,11 @@ void VRAudio::pauseSource(int sourceId) {
         return;
     }
 
-    // TODO: Implementierung der Audio-Quellen-Pause
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->slotOfSource.find(sourceId);
+    if (it != pImpl->slotOfSource.end()) {
+        pImpl->slots[it->second].playing = false;
+    }
 }
 
 void VRAudio::stopSource(int sourceId) {
@@ -156,7 +439,12 @@ void VRAudio::stopSource(int sourceId) {
         return;
     }
 
-    // TODO: Implementierung der Audio-Quellen-Stopp
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->slotOfSource.find(sourceId);
+    if (it != pImpl->slotOfSource.end()) {
+        pImpl->slots[it->second].playing = false;
+        pImpl->slots[it->second].rewind = true;
+    }
 }
 
 bool VRAudio::isSourcePlaying(int sourceId) const {
@@ -164,8 +452,13 @@ bool VRAudio::isSourcePlaying(int sourceId) const {
         return false;
     }
 
-    // TODO: Implementierung der Audio-Quellen-Status-Prüfung
-    return false;
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->slotOfSource.find(sourceId);
+    if (it == pImpl->slotOfSource.end()) {
+        return false;
+    }
+    // Ende ohne Loop meldet der Audio-Thread beim nächsten Abgleich
+    return pImpl->slots[it->second].playing;
 }
 
 void VRAudio::setSourceVolume(int sourceId, float volume) {
@@ -173,6 +466,7 @@ void VRAudio::setSourceVolume(int sourceId, float volume) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = sources.find(sourceId);
     if (it != sources.end()) {
         it->second.volume = volume;
@@ -184,6 +478,7 @@ void VRAudio::setSourcePitch(int sourceId, float pitch) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = sources.find(sourceId);
     if (it != sources.end()) {
         it->second.pitch = pitch;
@@ -195,6 +490,7 @@ void VRAudio::setSourcePosition(int sourceId, const glm::vec3& position) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = sources.find(sourceId);
     if (it != sources.end()) {
         it->second.position = position;
@@ -206,12 +502,222 @@ void VRAudio::setSourceDirection(int sourceId, const glm::vec3& direction) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     auto it = sources.find(sourceId);
     if (it != sources.end()) {
         it->second.direction = direction;
     }
 }
 
+void VRAudio::setSourceBuffer(int sourceId, std::vector<float> samples, float sampleRate) {
+    if (!initialized) {
+        return;
+    }
+
+    auto buffer = std::make_shared<const std::vector<float>>(std::move(samples));
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->slotOfSource.find(sourceId);
+    if (it != pImpl->slotOfSource.end()) {
+        Impl::Slot& slot = pImpl->slots[it->second];
+        pImpl->retire(slot.samples);
+        slot.samples = std::move(buffer);
+        slot.sampleRate = sampleRate > 0.0f ? sampleRate : pImpl->sampleRate;
+        slot.rewind = true;
+    }
+}
+
+void VRAudio::setSampleRate(float sampleRate) {
+    if (!(sampleRate > 0.0f)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        if (sampleRate == pImpl->sampleRate) {
+            return;
+        }
+        pImpl->sampleRate = sampleRate;
+        if (!initialized) {
+            return;
+        }
+    }
+
+    // Geladene Sätze gelten nur für ihre Abtastrate; sonst Kugelkopf
+    std::shared_ptr<const HRTFSet> hrtf = HRTFSet::createSphericalHead(sampleRate);
+    auto spatializer = Impl::createSpatializer(hrtf, getAmbisonicOrder());
+    std::unique_ptr<Impl::Spatializer> previous;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->hrtf = std::move(hrtf);
+        previous = pImpl->schedule(std::move(spatializer));
+    }
+}
+
+float VRAudio::getSampleRate() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->sampleRate;
+}
+
+bool VRAudio::loadHRTF(const std::string& path) {
+    if (!initialized) {
+        return false;
+    }
+
+    std::shared_ptr<const HRTFSet> hrtf;
+    try {
+        hrtf = HRTFSet::loadRaw(path);
+    } catch (const std::exception&) {
+        return false;
+    }
+    if (hrtf->getSampleRate() != getSampleRate()) {
+        return false;
+    }
+
+    auto spatializer = Impl::createSpatializer(hrtf, getAmbisonicOrder());
+    std::unique_ptr<Impl::Spatializer> previous;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->hrtf = std::move(hrtf);
+        previous = pImpl->schedule(std::move(spatializer));
+    }
+    return true;
+}
+
+void VRAudio::setAmbisonicOrder(int order) {
+    order = std::clamp(order, 0, ambisonics::kMaxOrder);
+    std::shared_ptr<const HRTFSet> hrtf;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        if (order == pImpl->ambisonicOrder) {
+            return;
+        }
+        pImpl->ambisonicOrder = order;
+        if (!initialized || !pImpl->hrtf) {
+            return;
+        }
+        hrtf = pImpl->hrtf;
+    }
+
+    auto spatializer = Impl::createSpatializer(std::move(hrtf), order);
+    std::unique_ptr<Impl::Spatializer> previous;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        previous = pImpl->schedule(std::move(spatializer));
+    }
+}
+
+int VRAudio::getAmbisonicOrder() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->ambisonicOrder;
+}
+
+size_t VRAudio::getRenderLatency() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    const auto& spatializer = pImpl->spatializerPending ? pImpl->pendingSpatializer : pImpl->spatializer;
+    return spatializer ? spatializer->getLatency() : 0;
+}
+
+void VRAudio::renderAudio(float* left, float* right, size_t numFrames) {
+    Impl& impl = *pImpl;
+    size_t done = 0;
+    while (done < numFrames) {
+        {
+            std::unique_lock<std::mutex> lock(impl.mutex, std::try_to_lock);
+            if (lock.owns_lock()) {
+                impl.synchronize(sources, listenerPosition, listenerOrientation, listenerVelocity);
+            }
+        }
+        if (!impl.spatializer) {
+            std::fill(left + done, left + numFrames, 0.0f);
+            std::fill(right + done, right + numFrames, 0.0f);
+            return;
+        }
+        Impl::Spatializer& spatializer = *impl.spatializer;
+        AcousticPropagation& propagation = *spatializer.propagation;
+
+        // Pro HRTF-Block: Kopfdrehung ein Stück nachführen, Hörerposition
+        // fortschreiben, Ausbreitung und Richtungen neu bestimmen, Renderer
+        // über genau eine Blockgrenze führen
+        const size_t block = spatializer.getLatency();
+        const size_t chunk = std::min(block, numFrames - done);
+        const float seconds = static_cast<float>(chunk) / impl.renderRate;
+        const float amount = 1.0f - std::exp(-seconds / Impl::kOrientationSmoothing);
+        impl.listenerSmoothed = glm::slerp(impl.listenerSmoothed, impl.listenerTarget, amount);
+        const glm::quat toHead = glm::inverse(impl.listenerSmoothed);
+        impl.listenerPosition = impl.listenerReported
+            + impl.listenerVelocity * std::min(impl.listenerAge, Impl::kMaxExtrapolation);
+        impl.listenerAge += seconds;
+
+        for (size_t i = 0; i < Impl::kMaxSources; ++i) {
+            Impl::Voice& voice = impl.voices[i];
+            Impl::describe(voice, impl.propagationSources[i]);
+            if (!voice.playing || !voice.samples) {
+                impl.inputs[i] = nullptr;
+                continue;
+            }
+            std::vector<float>& scratch = impl.scratch[i];
+            impl.readVoice(voice, scratch.data(), chunk);
+            impl.inputs[i] = scratch.data();
+        }
+
+        // Abstand, Laufzeit, Luft und Reflexionen für alle Quellen auf
+        // einmal; pausierte Quellen klingen über ihre Laufzeit aus
+        const glm::vec3 listener = impl.listenerPosition;
+        propagation.process(impl.inputs.data(), impl.propagationSources.data(), Impl::kMaxSources,
+                            listener.x, listener.y, listener.z, impl.propagatedOutputs.data(),
+                            impl.rendered.data(), impl.reflectionOutputs.data(), chunk);
+        const bool reflections = propagation.hasReflections();
+
+        for (size_t i = 0; i < Impl::kMaxSlots; ++i) {
+            glm::vec3 offset;
+            bool spatial = true;
+            if (i < Impl::kMaxSources) {
+                if (!impl.rendered[i]) continue;
+                offset = impl.voices[i].location - listener;
+                spatial = impl.voices[i].spatial;
+            } else {
+                // Reflexionen einer Wand kommen aus deren Richtung
+                impl.rendered[i] = reflections ? impl.reflectionOutputs[i - Impl::kMaxSources] : nullptr;
+                if (!reflections) continue;
+                propagation.getWallDirection(i - Impl::kMaxSources, listener.x, listener.y, listener.z,
+                                             offset.x, offset.y, offset.z);
+            }
+            // Pegel steckt schon im Signal
+            if (spatializer.renderer) {
+                const glm::vec3 relative = toHead * offset;
+                BinauralRenderer::SourceState& state = impl.states[i];
+                state.x = relative.x;
+                state.y = relative.y;
+                state.z = relative.z;
+                state.gain = 1.0f;
+                state.spatial = spatial;
+            } else {
+                // Der Bus bleibt weltbezogen, die Kopfdrehung übernimmt der
+                // Rotator. Nicht-räumliche Quellen kopffest vorne
+                const glm::vec3 direction = spatial ? offset : impl.listenerSmoothed * glm::vec3(0.0f, 0.0f, -1.0f);
+                impl.directionX[i] = direction.x;
+                impl.directionY[i] = direction.y;
+                impl.directionZ[i] = direction.z;
+            }
+        }
+
+        if (spatializer.renderer) {
+            spatializer.renderer->process(impl.rendered.data(), impl.states.data(), Impl::kMaxSlots,
+                                          left + done, right + done, chunk);
+        } else {
+            AmbisonicBus& bus = *spatializer.bus;
+            bus.clear(chunk);
+            spatializer.encoder->process(impl.rendered.data(), impl.directionX.data(), impl.directionY.data(),
+                                         impl.directionZ.data(), impl.gains.data(), Impl::kMaxSlots,
+                                         bus, chunk);
+            spatializer.rotator->setRotation(toHead.w, toHead.x, toHead.y, toHead.z);
+            spatializer.rotator->process(bus, chunk);
+            spatializer.decoder->process(bus, left + done, right + done, chunk);
+        }
+        done += chunk;
+    }
+}
+
 void VRAudio::addEffect(int sourceId, const AudioEffect& effect) {
     if (!initialized) {
         return;
@@ -250,7 +756,8 @@ void VRAudio::setListenerPosition(const glm::vec3& position) {
         return;
     }
 
-    listener.position = position;
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    listenerPosition = position;
 }
 
 void VRAudio::setListenerOrientation(const glm::quat& orientation) {
@@ -258,7 +765,8 @@ void VRAudio::setListenerOrientation(const glm::quat& orientation) {
         return;
     }
 
-    listener.rotation = orientation;
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    listenerOrientation = glm::normalize(orientation);
 }
 
 void VRAudio::setListenerVelocity(const glm::vec3& velocity) {
@@ -266,7 +774,8 @@ void VRAudio::setListenerVelocity(const glm::vec3& velocity) {
         return;
     }
 
-    // TODO: Implementierung der Listener-Geschwindigkeit
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    listenerVelocity = velocity;
 }
 
 void VRAudio::setRoomProperties(float size, float damping, float reflection) {
@@ -274,9 +783,16 @@ void VRAudio::setRoomProperties(float size, float damping, float reflection) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     roomSize = size;
     roomDamping = damping;
     roomReflection = reflection;
+    pImpl->room.width = Impl::kRoomWidth * std::max(size, 0.0f);
+    pImpl->room.height = Impl::kRoomHeight * std::max(size, 0.0f);
+    pImpl->room.depth = Impl::kRoomDepth * std::max(size, 0.0f);
+    pImpl->room.damping = std::clamp(damping, 0.0f, 1.0f);
+    pImpl->room.reflection = std::clamp(reflection, 0.0f, 1.0f);
+    pImpl->roomChanged = true;
 }
 
 void VRAudio::setReverbProperties(float density, float diffusion, float gain, float gainHF) {
@@ -284,10 +800,14 @@ void VRAudio::setReverbProperties(float density, float diffusion, float gain, fl
         return;
     }
 
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
     reverbDensity = density;
     reverbDiffusion = diffusion;
     reverbGain = gain;
     reverbGainHF = gainHF;
+    pImpl->room.gain = std::max(gain, 0.0f);
+    pImpl->room.gainHF = std::clamp(gainHF, 0.0f, 1.0f);
+    pImpl->roomChanged = true;
 }
 
 int VRAudio::createStream(const std::string& name, const AudioStream& stream) {
@@ -475,15 +995,52 @@ void VRAudio::renderDebugShapes() {
 }
 
 void VRAudio::initializeAudio() {
-    // TODO: Implementierung der Audio-Initialisierung
+    // Kugelkopf-Satz als Vorgabe; Slot-Puffer einmalig für die größte
+    // Blockgröße, damit der Audio-Thread nie alloziert
+    pImpl->hrtf = HRTFSet::createSphericalHead(pImpl->sampleRate);
+    pImpl->spatializer = Impl::createSpatializer(pImpl->hrtf, pImpl->ambisonicOrder);
+    pImpl->renderRate = pImpl->sampleRate;
+    pImpl->scratch.assign(Impl::kMaxSources, std::vector<float>(HRTFSet::kMaxFilterLength));
+    pImpl->propagated.assign(Impl::kMaxSources, std::vector<float>(HRTFSet::kMaxFilterLength));
+    pImpl->reflections.assign(AcousticPropagation::kNumWalls, std::vector<float>(HRTFSet::kMaxFilterLength));
+    pImpl->propagatedOutputs.clear();
+    for (auto& buffer : pImpl->propagated) pImpl->propagatedOutputs.push_back(buffer.data());
+    pImpl->reflectionOutputs.clear();
+    for (auto& buffer : pImpl->reflections) pImpl->reflectionOutputs.push_back(buffer.data());
 }
 
 void VRAudio::shutdownAudio() {
-    // TODO: Implementierung des Audio-Shutdowns
+    // Audio-Callback muss vorher gestoppt sein
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->spatializer.reset();
+    pImpl->pendingSpatializer.reset();
+    pImpl->spatializerPending = false;
+    for (auto& slot : pImpl->slots) slot = Impl::Slot();
+    for (auto& voice : pImpl->voices) voice = Impl::Voice();
+    pImpl->slotOfSource.clear();
+    pImpl->retired.clear();
 }
 
 void VRAudio::updateAudio() {
-    // TODO: Implementierung der Audio-Aktualisierung
+    // Vom Audio-Thread nicht mehr gehaltene Puffer und den ausgetauschten
+    // Spatializer hier freigeben, nicht im Audio-Thread
+    std::vector<Impl::SampleBuffer> released;
+    std::unique_ptr<Impl::Spatializer> replaced;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        auto& retired = pImpl->retired;
+        for (auto it = retired.begin(); it != retired.end();) {
+            if (it->use_count() == 1) {
+                released.push_back(std::move(*it));
+                it = retired.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (!pImpl->spatializerPending) {
+            replaced = std::move(pImpl->pendingSpatializer);
+        }
+    }
 }
 
 void VRAudio::renderDebugInfo() {
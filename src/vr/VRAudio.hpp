@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include <string>
 #include <map>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "../audio/AcousticPropagation.hpp"
 
 namespace VR_DAW {
 
@@ -34,6 +37,11 @@ public:
         float maxDistance;
         bool loop;
         bool spatial;
+        // Ausbreitung; die Vorgaben entsprechen min / r zwischen
+        // minDistance und maxDistance. doppler = false: ohne Laufzeit
+        DistanceModel distanceModel = DistanceModel::Inverse;
+        float rolloff = 1.0f;
+        bool doppler = true;
     };
 
     int createSource(const std::string& name, const AudioSource& source);
@@ -50,6 +58,25 @@ public:
     void setSourcePitch(int sourceId, float pitch);
     void setSourcePosition(int sourceId, const glm::vec3& position);
     void setSourceDirection(int sourceId, const glm::vec3& direction);
+    // Mono-Samples der Quelle; werden per pitch auf die Ausgaberate umgerechnet
+    void setSourceBuffer(int sourceId, std::vector<float> samples, float sampleRate);
+
+    // Binaurale Wiedergabe (HRTF). Ohne loadHRTF gilt der eingebaute
+    // Kugelkopf-Satz. Abtastrate und HRTF dürfen bei laufendem Audio
+    // gewechselt werden; der Audio-Thread übernimmt sie am nächsten Block
+    void setSampleRate(float sampleRate);
+    float getSampleRate() const;
+    bool loadHRTF(const std::string& path);
+    size_t getRenderLatency() const;
+    // 0: jede Quelle direkt mit ihrer HRTF (Vorgabe). 1-3: alle Quellen in
+    // einen Ambisonics-Bus dieser Ordnung, Kopfdrehung als Bus-Rotation und
+    // ein binauraler Dekoder; lohnt sich bei vielen Quellen
+    void setAmbisonicOrder(int order);
+    int getAmbisonicOrder() const;
+
+    // Audio-Thread: rendert alle spielenden Quellen, überschreibt left/right.
+    // Blockiert nie; ist der Zustand gerade gesperrt, gilt der des Vorblocks
+    void renderAudio(float* left, float* right, size_t numFrames);
 
     // Audio-Effekte
     struct AudioEffect {
@@ -63,7 +90,12 @@ public:
     void updateEffect(int sourceId, const AudioEffect& effect);
     AudioEffect getEffect(int sourceId, const std::string& effectName) const;
 
-    // 3D-Audio
+    // 3D-Audio. Jede Quelle läuft über Abstandsdämpfung, Laufzeit (Doppler)
+    // und Luftabsorption; die Geschwindigkeit führt die Hörerposition
+    // zwischen Tracking-Updates fort. Raum: Quader 8 x 3 x 10 m mal roomSize
+    // um den Ursprung, Boden bei y = 0, mit frühen Reflexionen (roomSize <= 0
+    // oder roomReflection = 0 schaltet sie ab). Vom Nachhall wirken gain und
+    // gainHF auf die Reflexionen; density und diffusion sind noch ohne Wirkung
     void setListenerPosition(const glm::vec3& position);
     void setListenerOrientation(const glm::quat& orientation);
     void setListenerVelocity(const glm::vec3& velocity);
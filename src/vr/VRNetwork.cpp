@@ -1,11 +1,112 @@
 #include "VRNetwork.hpp"
+#include "network/JamTransport.hpp"
+#include "network/StateReplication.hpp"
+#include "network/PayloadCompression.hpp"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <thread>
 
 namespace VR_DAW {
 
+namespace {
+
+// Kanal der Zustandsreplikation auf dem Nachrichtenweg von JamTransport
+const std::string kStateChannel = "vr.state";
+
+} // namespace
+
+struct VRNetwork::Impl {
+    JamTransport::Config audioConfig;
+    // Gehört dem Kontroll-Thread; der Audio-Thread sieht ihn nur über
+    // audioTransport und hält ihn höchstens für die Dauer eines Aufrufs
+    std::unique_ptr<JamTransport> transport;
+    std::atomic<JamTransport*> audioTransport{nullptr};
+    // Je Audio-Seite (Senden, Empfangen) eine Epoche wie beim
+    // RenderSnapshotManager: ungerade = Aufruf läuft
+    std::atomic<uint64_t> sendEpoch{0};
+    std::atomic<uint64_t> receiveEpoch{0};
+    std::string channel;
+    std::vector<uint8_t> message;
+
+    StateReplicator replicator;
+    std::vector<uint8_t> statePacket;
+    std::chrono::steady_clock::time_point lastUpdate;
+    double tickAccumulator = 0.0;
+
+    // Nachrichten werden direkt hinter den Transportkopf komprimiert
+    PayloadCompressor compressor;
+    std::vector<uint8_t> sendBuffer;
+    std::vector<uint8_t> receiveBuffer;
+
+    Impl()
+        : statePacket(replicator.getConfig().packetBudget)
+        , sendBuffer(JamTransport::kMaxDatagramSize)
+        , receiveBuffer(PayloadCompressor::Config().maxMessageSize)
+    {
+    }
+
+    bool open(int port, int qualityLevel) {
+        // Höchste Qualitätsstufe überträgt Float, sonst 16 Bit
+        audioConfig.codec = qualityLevel >= 3 ? JamTransport::Codec::Float32 : JamTransport::Codec::Pcm16;
+        transport = std::make_unique<JamTransport>(audioConfig);
+        if (!transport->open(static_cast<uint16_t>(port))) {
+            transport.reset();
+            return false;
+        }
+        // Neue Verbindung: Gegenseite kennt weder Namen, Basiszustände noch Wörterbücher
+        replicator.reset();
+        compressor.reset();
+        lastUpdate = std::chrono::steady_clock::now();
+        tickAccumulator = 0.0;
+        return true;
+    }
+
+    // Audio-Thread: enterAudio()/leaveAudio() klammern jede Benutzung
+    JamTransport* enterAudio(std::atomic<uint64_t>& epoch) {
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        return audioTransport.load(std::memory_order_seq_cst);
+    }
+
+    void leaveAudio(std::atomic<uint64_t>& epoch) {
+        epoch.fetch_add(1, std::memory_order_release);
+    }
+
+    // Kontroll-Thread: Transport dem Audio-Thread entziehen und warten, bis
+    // kein Aufruf mehr den alten Zeiger halten kann; danach darf er weg
+    void closeTransport() {
+        audioTransport.store(nullptr, std::memory_order_seq_cst);
+        for (const std::atomic<uint64_t>* epoch : {&sendEpoch, &receiveEpoch}) {
+            const uint64_t seen = epoch->load(std::memory_order_seq_cst);
+            if ((seen & 1) == 0) continue;
+            while (epoch->load(std::memory_order_acquire) == seen) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        transport.reset();
+    }
+
+    void replicate() {
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - lastUpdate).count();
+        lastUpdate = now;
+        replicator.advance(elapsed);
+
+        // Höchstens ein Paket je update(), nach Aussetzern nicht nachholen
+        const double interval = 1.0 / replicator.getConfig().tickRate;
+        tickAccumulator = std::min(tickAccumulator + elapsed, 2.0 * interval);
+        if (tickAccumulator < interval) return;
+        tickAccumulator -= interval;
+
+        const size_t size = replicator.writePacket(statePacket.data(), statePacket.size());
+        transport->sendMessage(kStateChannel, statePacket.data(), size);
+    }
+};
+
 VRNetwork::VRNetwork()
-    : initialized(false)
+    : pImpl(std::make_unique<Impl>())
+    , initialized(false)
     , debugEnabled(false)
     , connected(false)
     , isHosting(false)
@@ -46,6 +147,9 @@ void VRNetwork::update() {
     if (!initialized) return;
 
     processIncomingData();
+    if (connected) {
+        pImpl->replicate();
+    }
     updateNetworkStats();
     handleConnectionEvents();
 }
@@ -71,8 +175,9 @@ std::string VRNetwork::getConnectionStatus() const {
 bool VRNetwork::startHost(int port) {
     if (!initialized || connected) return false;
 
-    // Hier würde das Starten des Hosts erfolgen
-    // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
+    // Der Host antwortet dem ersten Client, der ihm Pakete schickt
+    if (!pImpl->open(port, qualityLevel)) return false;
+    pImpl->audioTransport.store(pImpl->transport.get(), std::memory_order_release);
     
     isHosting = true;
     connected = true;
@@ -82,8 +187,12 @@ bool VRNetwork::startHost(int port) {
 bool VRNetwork::connectToHost(const std::string& address, int port) {
     if (!initialized || connected) return false;
 
-    // Hier würde die Verbindung zum Host erfolgen
-    // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
+    if (!pImpl->open(0, qualityLevel)) return false;
+    if (!pImpl->transport->setPeer(address, static_cast<uint16_t>(port))) {
+        pImpl->transport.reset();
+        return false;
+    }
+    pImpl->audioTransport.store(pImpl->transport.get(), std::memory_order_release);
     
     connected = true;
     return true;
@@ -92,10 +201,8 @@ bool VRNetwork::connectToHost(const std::string& address, int port) {
 void VRNetwork::disconnect() {
     if (!initialized || !connected) return;
 
-    // Hier würde das Trennen der Verbindung erfolgen
-    // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
-    
     connected = false;
+    pImpl->closeTransport();
     isHosting = false;
 }
 
@@ -106,15 +213,16 @@ void VRNetwork::setMaxConnections(int max) {
 void VRNetwork::sendData(const std::string& channel, const void* data, size_t size) {
     if (!initialized || !connected) return;
 
-    // Hier würde das Senden der Daten erfolgen
-    // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
+    std::vector<uint8_t>& buffer = pImpl->sendBuffer;
+    const size_t headroom = pImpl->transport->getMessageHeadroom(channel);
+    size_t compressedSize = buffer.size() - headroom;
+    if (!compressData(channel, data, size, buffer.data() + headroom, compressedSize)) return;
+    pImpl->transport->sendMessageInPlace(channel, buffer.data(), compressedSize);
 }
 
 void VRNetwork::broadcastData(const std::string& channel, const void* data, size_t size) {
-    if (!initialized || !connected) return;
-
-    // Hier würde das Broadcasten der Daten erfolgen
-    // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
+    // Punkt-zu-Punkt: der einzige Peer ist das ganze Publikum
+    sendData(channel, data, size);
 }
 
 void VRNetwork::registerDataHandler(const std::string& channel, std::function<void(const void*, size_t)> handler) {
@@ -124,15 +232,44 @@ void VRNetwork::registerDataHandler(const std::string& channel, std::function<vo
 void VRNetwork::syncTransform(const std::string& objectId, const glm::vec3& position, const glm::quat& rotation) {
     if (!initialized || !connected) return;
 
-    // Hier würde die Synchronisation der Transformation erfolgen
-    // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
+    StateReplicator& replicator = pImpl->replicator;
+    StateReplicator::ObjectId id = replicator.findObject(objectId);
+    if (id == StateReplicator::kInvalidObject) {
+        id = replicator.registerObject(objectId);
+    }
+    replicator.setTransform(id, position, rotation);
+}
+
+bool VRNetwork::getRemoteTransform(const std::string& objectId, glm::vec3& position, glm::quat& rotation) const {
+    return pImpl->replicator.getRemoteTransform(objectId, position, rotation);
+}
+
+void VRNetwork::setViewerPosition(const glm::vec3& position) {
+    pImpl->replicator.setViewer(position);
 }
 
 void VRNetwork::syncAudio(const std::string& audioId, const void* audioData, size_t size) {
-    if (!initialized || !connected) return;
+    const size_t frameBytes = sizeof(float) * pImpl->audioConfig.channels;
+    if (JamTransport* transport = pImpl->enterAudio(pImpl->sendEpoch)) {
+        transport->send(static_cast<const float*>(audioData), size / frameBytes);
+    }
+    pImpl->leaveAudio(pImpl->sendEpoch);
+}
 
-    // Hier würde die Synchronisation der Audio-Daten erfolgen
-    // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
+void VRNetwork::receiveAudio(void* audioData, size_t size) {
+    const size_t frameBytes = sizeof(float) * pImpl->audioConfig.channels;
+    if (JamTransport* transport = pImpl->enterAudio(pImpl->receiveEpoch)) {
+        transport->receive(static_cast<float*>(audioData), size / frameBytes);
+    } else {
+        std::fill_n(static_cast<float*>(audioData), size / sizeof(float), 0.0f);
+    }
+    pImpl->leaveAudio(pImpl->receiveEpoch);
+}
+
+void VRNetwork::setAudioFormat(double sampleRate, int channels, int frameSize) {
+    pImpl->audioConfig.sampleRate = sampleRate;
+    pImpl->audioConfig.channels = static_cast<uint32_t>(std::max(1, channels));
+    pImpl->audioConfig.frameSize = static_cast<uint32_t>(std::max(1, frameSize));
 }
 
 void VRNetwork::syncEvent(const std::string& eventType, const void* eventData, size_t size) {
@@ -143,13 +280,11 @@ void VRNetwork::syncEvent(const std::string& eventType, const void* eventData, s
 }
 
 float VRNetwork::getLatency() const {
-    // Hier würde die Latenz zurückgegeben werden
-    return 0.0f;
+    return pImpl->transport ? pImpl->transport->getLatency() : 0.0f;
 }
 
 float VRNetwork::getPacketLoss() const {
-    // Hier würde der Paketverlust zurückgegeben werden
-    return 0.0f;
+    return pImpl->transport ? pImpl->transport->getPacketLoss() : 0.0f;
 }
 
 void VRNetwork::setQualitySettings(int quality) {
@@ -158,6 +293,7 @@ void VRNetwork::setQualitySettings(int quality) {
 
 void VRNetwork::setCompressionLevel(int level) {
     compressionLevel = std::max(0, std::min(9, level));
+    pImpl->compressor.setLevel(compressionLevel);
 }
 
 std::vector<VRNetwork::User> VRNetwork::getConnectedUsers() const {
@@ -186,14 +322,46 @@ void VRNetwork::enableDebugLogging(bool enable) {
 void VRNetwork::showNetworkStats() {
     if (!initialized || !debugEnabled) return;
 
-    // Hier würden die Netzwerk-Statistiken angezeigt werden
+    std::printf("Netzwerk: %s, Latenz %.1f ms, Verlust %.1f %%\n", getConnectionStatus().c_str(),
+                getLatency(), 100.0f * getPacketLoss());
+    std::printf("%-20s %6s %8s %8s %8s %7s %10s %10s %6s\n", "Kanal", "Codec", "gesendet", "roh",
+                "empfangen", "Ratio", "us/Komp.", "us/Dekomp.", "Fehler");
+    static const char* codecNames[] = {"roh", "LZ4", "zstd"};
+    for (const auto& stats : pImpl->compressor.getStats()) {
+        const double compressUs = stats.messagesOut > 0
+            ? stats.compressNanoseconds * 1e-3 / stats.messagesOut : 0.0;
+        const double decompressUs = stats.messagesIn > 0
+            ? stats.decompressNanoseconds * 1e-3 / stats.messagesIn : 0.0;
+        std::printf("%-20s %6s %8llu %8llu %8llu %7.2f %10.2f %10.2f %6llu\n", stats.channel.c_str(),
+                    codecNames[static_cast<int>(stats.codec)],
+                    static_cast<unsigned long long>(stats.messagesOut),
+                    static_cast<unsigned long long>(stats.skipped),
+                    static_cast<unsigned long long>(stats.messagesIn),
+                    stats.getRatio(), compressUs, decompressUs,
+                    static_cast<unsigned long long>(stats.decodeErrors));
+    }
 }
 
 void VRNetwork::processIncomingData() {
     if (!initialized || !connected) return;
 
-    // Hier würde die Verarbeitung der eingehenden Daten erfolgen
-    // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
+    while (pImpl->transport->pollMessage(pImpl->channel, pImpl->message)) {
+        if (pImpl->channel == kStateChannel) {
+            pImpl->replicator.readPacket(pImpl->message.data(), pImpl->message.size());
+            continue;
+        }
+        // Auch ohne Handler dekodieren: der Rahmen kann ein Wörterbuch tragen
+        size_t size = pImpl->receiveBuffer.size();
+        if (!decompressData(pImpl->channel, pImpl->message.data(), pImpl->message.size(),
+                            pImpl->receiveBuffer.data(), size)) {
+            continue;
+        }
+        auto it = dataHandlers.find(pImpl->channel);
+        if (it == dataHandlers.end()) continue;
+        for (const auto& handler : it->second) {
+            handler(pImpl->receiveBuffer.data(), size);
+        }
+    }
 }
 
 void VRNetwork::updateNetworkStats() {
@@ -209,14 +377,17 @@ void VRNetwork::handleConnectionEvents() {
     // z.B. mit ENet, RakNet oder anderen Netzwerk-Bibliotheken
 }
 
-void VRNetwork::compressData(const void* data, size_t size, void* compressed, size_t& compressedSize) {
-    // Hier würde die Komprimierung der Daten erfolgen
-    // z.B. mit zlib, LZ4 oder anderen Komprimierungs-Bibliotheken
+bool VRNetwork::compressData(const std::string& channel, const void* data, size_t size,
+                             void* compressed, size_t& compressedSize) {
+    compressedSize = pImpl->compressor.compress(channel, data, size, static_cast<uint8_t*>(compressed),
+                                                compressedSize);
+    return compressedSize > 0;
 }
 
-void VRNetwork::decompressData(const void* compressed, size_t compressedSize, void* data, size_t& size) {
-    // Hier würde die Dekomprimierung der Daten erfolgen
-    // z.B. mit zlib, LZ4 oder anderen Komprimierungs-Bibliotheken
+bool VRNetwork::decompressData(const std::string& channel, const void* compressed, size_t compressedSize,
+                               void* data, size_t& size) {
+    return pImpl->compressor.decompress(channel, static_cast<const uint8_t*>(compressed), compressedSize,
+                                        static_cast<uint8_t*>(data), size, size);
 }
 
 } // namespace VR_DAW 
\ No newline at end of file
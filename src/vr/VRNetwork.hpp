@@ -1,10 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <string>
+#include <map>
 #include <functional>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace VR_DAW {
 
@@ -36,14 +39,30 @@ public:
     void registerDataHandler(const std::string& channel, std::function<void(const void*, size_t)> handler);
 
     // Synchronisation
+    // Transformationen werden je Tick als Delta gegen den bestätigten Stand
+    // repliziert (StateReplicator); Objekte außerhalb des Interessenradius
+    // der Gegenseite werden nicht gesendet
     void syncTransform(const std::string& objectId, const glm::vec3& position, const glm::quat& rotation);
+    // Interpolierte Transformation eines Objekts der Gegenseite
+    bool getRemoteTransform(const std::string& objectId, glm::vec3& position, glm::quat& rotation) const;
+    // Eigene Kopfposition für das Interest-Management der Gegenseite
+    void setViewerPosition(const glm::vec3& position);
+    // Audio läuft über JamTransport: interleaved float im Format von
+    // setAudioFormat(), ein Stream je Verbindung (audioId wird nicht übertragen)
     void syncAudio(const std::string& audioId, const void* audioData, size_t size);
+    // Füllt size Bytes mit dem empfangenen Stream (Jitter-Puffer, PLC).
+    // syncAudio()/receiveAudio() laufen lock-frei neben disconnect(): der
+    // Transport wird erst freigegeben, wenn kein Aufruf ihn mehr hält
+    void receiveAudio(void* audioData, size_t size);
+    // Vor startHost()/connectToHost() setzen
+    void setAudioFormat(double sampleRate, int channels, int frameSize);
     void syncEvent(const std::string& eventType, const void* eventData, size_t size);
 
     // Latenz und Qualität
     float getLatency() const;
     float getPacketLoss() const;
     void setQualitySettings(int quality);
+    // 0: aus, 1-3: LZ4, 4-9: zstd (falls eingebaut, sonst LZ4 mit tieferer Suche)
     void setCompressionLevel(int level);
 
     // Benutzer-Management
@@ -68,8 +87,8 @@ private:
     bool initialized;
     bool debugEnabled;
     
-    // Netzwerk-Status
-    bool connected;
+    // Netzwerk-Status; connected wird auch außerhalb des Kontroll-Threads gelesen
+    std::atomic<bool> connected;
     bool isHosting;
     int maxConnections;
     
@@ -83,8 +102,9 @@ private:
     void processIncomingData();
     void updateNetworkStats();
     void handleConnectionEvents();
-    void compressData(const void* data, size_t size, void* compressed, size_t& compressedSize);
-    void decompressData(const void* compressed, size_t compressedSize, void* data, size_t& size);
+    // compressedSize/size: Kapazität hinein, Ergebnisgröße heraus
+    bool compressData(const std::string& channel, const void* data, size_t size, void* compressed, size_t& compressedSize);
+    bool decompressData(const std::string& channel, const void* compressed, size_t compressedSize, void* data, size_t& size);
 };
 
 } // namespace VR_DAW 
\ No newline at end of file
@@ -1,5 +1,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include "VRUI.hpp"
+#include "UIBatcher.hpp"
+#include "UIInstanceRenderer.hpp"
 #include <algorithm>
 #include <cmath>
 #include <glm/gtc/type_ptr.hpp>
@@ -29,6 +31,14 @@ struct VRUI::Impl {
     float uiScale;
     glm::vec3 defaultPosition;
     std::function<void(const AudioEvent&)> audioCallback;
+
+    // Instanziertes Rendering: render() sammelt alle Elemente im Batcher,
+    // gezeichnet wird ein Draw je Mesh und Material
+    UIBatcher batcher;
+    UIInstanceRenderer instanceRenderer;
+    std::map<std::string, std::vector<float>> waveformData;
+    glm::mat4 viewMatrix{1.0f};
+    glm::mat4 projectionMatrix{1.0f};
     
 #ifdef USE_JACK
     jack_client_t* jackClient;
@@ -114,6 +124,9 @@ void VRUI::shutdown() {
     pImpl->renderScale = 1.0f;
     pImpl->renderQuality = 1;
     pImpl->synthesizerViews.clear();
+    pImpl->waveformData.clear();
+    pImpl->batcher.clear();
+    pImpl->instanceRenderer.shutdown();
 }
 
 void VRUI::update() {
@@ -153,28 +166,31 @@ void VRUI::render() {
     pImpl->metrics.drawCalls = 0;
     
     try {
+        if (!pImpl->instanceRenderer.isInitialized() && !pImpl->instanceRenderer.initialize()) {
+            logError("Instanz-Renderer konnte nicht initialisiert werden");
+        }
+
+        // Alle Views und Elemente sammeln; Text wird weiterhin direkt gezeichnet
+        pImpl->batcher.clear();
+
         // Track-Views rendern
         for (const auto& view : pImpl->trackViews) {
             renderTrackView(view);
-            pImpl->metrics.drawCalls++;
         }
 
         // Plugin-Views rendern
         for (const auto& view : pImpl->pluginViews) {
             renderPluginView(view);
-            pImpl->metrics.drawCalls++;
         }
 
         // Synthesizer-Views rendern
         for (const auto& view : pImpl->synthesizerViews) {
             renderSynthesizerView(view);
-            pImpl->metrics.drawCalls++;
         }
 
         // WebRTC-Views rendern
         for (const auto& view : pImpl->webRTCViews) {
             renderWebRTCView(view);
-            pImpl->metrics.drawCalls++;
         }
 
         // UI-Elemente rendern
@@ -183,10 +199,13 @@ void VRUI::render() {
             if (element.visible) {
                 renderElement(element);
                 pImpl->metrics.activeElements++;
-                pImpl->metrics.drawCalls++;
             }
         }
 
+        pImpl->batcher.build();
+        pImpl->metrics.drawCalls = pImpl->instanceRenderer.render(
+            pImpl->batcher, pImpl->viewMatrix, pImpl->projectionMatrix);
+
         if (pImpl->debugEnabled) {
             renderDebugInfo();
         }
@@ -198,6 +217,19 @@ void VRUI::render() {
     }
 }
 
+void VRUI::renderEye(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    if (!initialized) return;
+
+    // Die Batches des letzten render() werden ohne erneutes Hochladen gezeichnet
+    pImpl->metrics.drawCalls += pImpl->instanceRenderer.render(
+        pImpl->batcher, viewMatrix, projectionMatrix);
+}
+
+void VRUI::setViewProjection(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    pImpl->viewMatrix = viewMatrix;
+    pImpl->projectionMatrix = projectionMatrix;
+}
+
 VRUI::UIElement* VRUI::createButton(const std::string& id, const glm::vec3& position, const glm::vec3& scale) {
     UIElement element;
     element.type = UIElement::Type::Button;
@@ -425,20 +457,29 @@ void VRUI::focusElement(const std::string& elementId) {
 
 void VRUI::renderElement(const UIElement& element) {
     glm::mat4 modelMatrix = calculateModelMatrix(element);
+    const float highlight = (&element == pImpl->focusedElement) ? 1.0f : 0.0f;
     
     switch (element.type) {
         case UIElement::Type::Button:
-            renderButton(element, modelMatrix);
+            pImpl->batcher.add(UIBatcher::MeshType::Button, 0, modelMatrix,
+                               glm::vec4(0.25f, 0.45f, 0.85f, 1.0f), element.value, highlight);
             break;
         case UIElement::Type::Slider:
-            renderSlider(element, modelMatrix);
+            pImpl->batcher.add(UIBatcher::MeshType::Slider, 0, modelMatrix,
+                               glm::vec4(0.3f, 0.75f, 0.4f, 1.0f), element.value, highlight);
             break;
         case UIElement::Type::Knob:
-            renderKnob(element, modelMatrix);
+            pImpl->batcher.add(UIBatcher::MeshType::Knob, 0, modelMatrix,
+                               glm::vec4(0.85f, 0.6f, 0.2f, 1.0f), element.value, highlight);
             break;
-        case UIElement::Type::Waveform:
-            renderWaveform(element, modelMatrix);
+        case UIElement::Type::Waveform: {
+            auto it = pImpl->waveformData.find(element.id);
+            const float* samples = it != pImpl->waveformData.end() ? it->second.data() : nullptr;
+            const size_t numSamples = it != pImpl->waveformData.end() ? it->second.size() : 0;
+            pImpl->batcher.addWaveform(modelMatrix, glm::vec4(0.4f, 0.8f, 0.95f, 1.0f),
+                                       samples, numSamples, highlight);
             break;
+        }
         case UIElement::Type::Text:
             renderText(TextElement{element.text, element.position, element.scale});
             break;
@@ -451,6 +492,7 @@ void VRUI::renderTrackView(const TrackView& view) {
     // Track-Hintergrund rendern
     glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), view.position);
     modelMatrix = glm::scale(modelMatrix, view.size);
+    pImpl->batcher.add(UIBatcher::MeshType::Panel, 0, modelMatrix, glm::vec4(0.12f, 0.12f, 0.15f, 0.9f));
     
     // Track-Name rendern
     // TODO: Text-Rendering implementieren
@@ -465,6 +507,7 @@ void VRUI::renderPluginView(const PluginView& view) {
     // Plugin-Hintergrund rendern
     glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), view.position);
     modelMatrix = glm::scale(modelMatrix, view.size);
+    pImpl->batcher.add(UIBatcher::MeshType::Panel, 0, modelMatrix, glm::vec4(0.12f, 0.12f, 0.15f, 0.9f));
     
     // Plugin-Name rendern
     // TODO: Text-Rendering implementieren
@@ -663,7 +706,8 @@ glm::vec2 VRUI::calculateTextBounds(const TextElement& text) {
 }
 
 void VRUI::setWaveformData(const std::string& elementId, const std::vector<float>& data) {
-    // Dummy: Hier könnte die Waveform-Daten für ein UI-Element gespeichert werden
+    // Wird beim nächsten render() auf kWaveformResolution Punkte reduziert
+    pImpl->waveformData[elementId] = data;
 }
 
 void VRUI::updateElementTransforms() {
@@ -1221,6 +1265,7 @@ void VRUI::renderSynthesizerView(const SynthesizerView& view) {
     // Synthesizer-Hintergrund rendern
     glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), view.position);
     modelMatrix = glm::scale(modelMatrix, view.size);
+    pImpl->batcher.add(UIBatcher::MeshType::Panel, 0, modelMatrix, glm::vec4(0.12f, 0.12f, 0.15f, 0.9f));
     
     // Synthesizer-Name rendern
     for (const auto& control : view.controls) {
@@ -1870,6 +1915,7 @@ void VRUI::renderWebRTCView(const WebRTCView& view) {
     // WebRTC-View-Hintergrund rendern
     glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), view.position);
     modelMatrix = glm::scale(modelMatrix, view.size);
+    pImpl->batcher.add(UIBatcher::MeshType::Panel, 0, modelMatrix, glm::vec4(0.12f, 0.12f, 0.15f, 0.9f));
     
     // Peer-ID rendern
     auto* peerIdText = createText(view.peerId, view.position + glm::vec3(0.0f, 0.15f, 0.0f), 0.05f);
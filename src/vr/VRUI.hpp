@@ -167,6 +167,9 @@ public:
     void shutdown();
     void update();
     void render();
+    // Zeichnet die in render() gesammelten Batches für das zweite Auge
+    void renderEye(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+    void setViewProjection(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
 
     UIElement* createButton(const std::string& id, const glm::vec3& position, const glm::vec3& scale);
     UIElement* createSlider(const std::string& id, const glm::vec3& position, const glm::vec3& scale);
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include "../src/audio/Ambisonics.hpp"
+#include "../src/audio/BinauralRenderer.hpp"
+#include "../src/dsp/kernels/DSPKernels.hpp"
+
+// Benchmark für den Ambisonics-Bus: bewegte Objekte (jeden Block neue
+// Richtung) in 3. Ordnung kodieren, Bus drehen und einmal dekodieren, je
+// Ausgabeformat. Zum Vergleich dieselben Objekte direkt über den
+// BinauralRenderer. Ausgabe: Kern-Anteil bei 48 kHz.
+// Aufruf: AmbisonicsBenchmark [Objekte] [blockSize] [Sekunden]
+
+namespace {
+
+using namespace VR_DAW;
+
+constexpr float kSampleRate = 48000.0f;
+constexpr int kOrder = 3;
+
+volatile float sink = 0.0f;
+
+struct Scene {
+    std::vector<std::vector<float>> signals;
+    std::vector<const float*> inputs;
+    std::vector<float> x, y, z, gains;
+    float heading = 0.0f;
+
+    Scene(size_t objects, size_t blockSize)
+        : signals(objects, std::vector<float>(blockSize))
+        , inputs(objects)
+        , x(objects), y(objects), z(objects)
+        , gains(objects, 1.0f / objects)
+    {
+        uint32_t seed = 1;
+        for (size_t i = 0; i < objects; ++i) {
+            for (float& sample : signals[i]) {
+                seed = seed * 1664525u + 1013904223u;
+                sample = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+            }
+            inputs[i] = signals[i].data();
+        }
+    }
+
+    // Objekte kreisen mit 90 Grad/s auf verschiedenen Höhen
+    void advance(size_t blockSize) {
+        heading += 1.5707963f * blockSize / kSampleRate;
+        const size_t objects = inputs.size();
+        for (size_t i = 0; i < objects; ++i) {
+            const float angle = 6.2831853f * i / objects + heading;
+            const float height = std::sin(0.37f * i);
+            x[i] = std::sin(angle);
+            y[i] = height;
+            z[i] = -std::cos(angle);
+        }
+    }
+};
+
+double measureCoreShare(const std::function<void()>& block, size_t blockSize, double seconds) {
+    const size_t blocks = static_cast<size_t>(seconds * kSampleRate / blockSize);
+    for (size_t b = 0; b < blocks / 10 + 1; ++b) block();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < blocks; ++b) block();
+    const auto end = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(end - start).count();
+    return elapsed / (static_cast<double>(blocks * blockSize) / kSampleRate);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t objects = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 500;
+    const size_t blockSize = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 128;
+    const double seconds = argc > 3 ? std::atof(argv[3]) : 5.0;
+
+    dsp::initializeKernels();
+    auto hrtf = HRTFSet::createSphericalHead(kSampleRate);
+
+    std::printf("Ambisonics-Benchmark (48 kHz, %zu bewegte Objekte, Ordnung %d, Blockgröße %zu)\n",
+                objects, kOrder, blockSize);
+    std::printf("Kernel-Variante: %s\n\n", dsp::getKernels().name);
+    std::printf("%-28s %12s\n", "Pfad", "Kern-%");
+
+    Scene scene(objects, blockSize);
+    AmbisonicBus bus(kOrder, blockSize);
+    AmbisonicEncoder encoder(kOrder, objects);
+    AmbisonicRotator rotator(kOrder);
+    std::vector<float> left(blockSize), right(blockSize);
+
+    auto encodeAndRotate = [&] {
+        scene.advance(blockSize);
+        bus.clear(blockSize);
+        encoder.process(scene.inputs.data(), scene.x.data(), scene.y.data(), scene.z.data(),
+                        scene.gains.data(), objects, bus, blockSize);
+        const float half = 0.5f * scene.heading;
+        rotator.setRotation(std::cos(half), 0.0f, std::sin(half), 0.0f);
+        rotator.process(bus, blockSize);
+    };
+
+    const double encodeShare = measureCoreShare(encodeAndRotate, blockSize, seconds);
+    std::printf("%-28s %11.2f%%\n", "Kodieren + Drehen", 100.0 * encodeShare);
+
+    AmbisonicBinauralDecoder binaural(kOrder, hrtf);
+    const double binauralShare = measureCoreShare([&] {
+        encodeAndRotate();
+        binaural.process(bus, left.data(), right.data(), blockSize);
+        sink = left[0];
+    }, blockSize, seconds);
+    std::printf("%-28s %11.2f%%\n", "Bus -> Binaural", 100.0 * binauralShare);
+
+    for (const auto& [name, layout] : {std::make_pair("Bus -> Stereo", SpeakerLayout::stereo()),
+                                       std::make_pair("Bus -> 7.1.4", SpeakerLayout::surround714())}) {
+        AmbisonicDecoder decoder(kOrder, layout);
+        std::vector<std::vector<float>> speakers(decoder.getNumOutputs(), std::vector<float>(blockSize));
+        std::vector<float*> outputs;
+        for (auto& speaker : speakers) outputs.push_back(speaker.data());
+        const double share = measureCoreShare([&] {
+            encodeAndRotate();
+            decoder.process(bus, outputs.data(), blockSize);
+            sink = outputs[0][0];
+        }, blockSize, seconds);
+        std::printf("%-28s %11.2f%%\n", name, 100.0 * share);
+    }
+
+    BinauralRenderer renderer(hrtf, objects);
+    std::vector<BinauralRenderer::SourceState> states(objects);
+    const double directShare = measureCoreShare([&] {
+        scene.advance(blockSize);
+        for (size_t i = 0; i < objects; ++i) {
+            states[i].x = scene.x[i];
+            states[i].y = scene.y[i];
+            states[i].z = scene.z[i];
+            states[i].gain = scene.gains[i];
+        }
+        renderer.process(scene.inputs.data(), states.data(), objects, left.data(), right.data(), blockSize);
+        sink = left[0];
+    }, blockSize, seconds);
+    std::printf("%-28s %11.2f%%\n", "Direkt (BinauralRenderer)", 100.0 * directShare);
+
+    return 0;
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <thread>
 #include "../src/audio/AudioEngine.hpp"
+#include "../src/audio/RenderSnapshot.hpp"
+#include "../src/audio/RealtimeGuard.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -230,5 +235,102 @@ TEST_F(AudioEngineTest, ErrorHandling) {
     EXPECT_FALSE(engine->setThreadCount(0));
 }
 
+// Render-Snapshot Tests
+TEST(RenderSnapshotTest, RetiresOnlyAfterGracePeriod) {
+    RenderSnapshotManager manager;
+
+    // Audio-Thread befindet sich in einem Callback
+    const RenderSnapshot* seen = manager.acquire();
+    ASSERT_NE(seen, nullptr);
+
+    auto next = std::make_unique<RenderSnapshot>();
+    next->masterVolume = 0.5f;
+    manager.publish(std::move(next));
+
+    // Der alte Snapshot darf noch nicht freigegeben werden
+    EXPECT_EQ(manager.getRetiredCount(), 1u);
+
+    manager.release();
+    manager.collectRetired();
+    EXPECT_EQ(manager.getRetiredCount(), 0u);
+
+    const RenderSnapshot* current = manager.acquire();
+    EXPECT_FLOAT_EQ(current->masterVolume, 0.5f);
+    manager.release();
+}
+
+TEST(RenderSnapshotTest, SynchronizeWaitsForRunningCallback) {
+    RenderSnapshotManager manager;
+
+    // Ohne laufenden Callback kehrt synchronize() sofort zurück
+    manager.synchronize();
+
+    std::atomic<bool> entered{false};
+    std::atomic<bool> released{false};
+    std::thread audio([&]() {
+        manager.acquire();
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        released = true;
+        manager.release();
+    });
+
+    while (!entered) std::this_thread::yield();
+    manager.synchronize();
+    EXPECT_TRUE(released);
+    audio.join();
+}
+
+TEST(RenderSnapshotTest, SynthesizerLookup) {
+    RenderSnapshot snapshot;
+    snapshot.synthesizers.push_back({1, SynthesizerConfig()});
+    snapshot.synthesizers.push_back({4, SynthesizerConfig()});
+
+    EXPECT_NE(snapshot.findSynthesizer(4), nullptr);
+    EXPECT_EQ(snapshot.findSynthesizer(2), nullptr);
+}
+
+TEST_F(AudioEngineTest, RealtimeRenderPathDoesNotAllocate) {
+    engine->createTrack("Track 1");
+    engine->createTrack("Track 2");
+    engine->startPlayback();
+
+    std::vector<float> input(1024, 0.25f);
+    std::vector<float> output(1024, 0.0f);
+
+    RealtimeGuard::setAction(RealtimeGuard::Action::Count);
+    RealtimeGuard::resetViolations();
+
+    engine->process(input.data(), output.data(), 512);
+
+#ifdef VRDAW_REALTIME_CHECKS
+    EXPECT_EQ(RealtimeGuard::getAllocationViolations(), 0u);
+    EXPECT_EQ(RealtimeGuard::getLockViolations(), 0u);
+    EXPECT_EQ(RealtimeGuard::getNonRealtimeCallViolations(), 0u);
+#endif
+    engine->stopPlayback();
+}
+
+TEST_F(AudioEngineTest, PlanarRenderMatchesConstantPowerPan) {
+    engine->createTrack("Track 1");
+    engine->startPlayback();
+
+    // Interleavter Pfad läuft intern planar, Ergebnis muss gleich bleiben
+    std::vector<float> input(1024, 0.25f);
+    std::vector<float> output(1024, 0.0f);
+    engine->process(input.data(), output.data(), 512);
+
+    const float expected = 0.25f * std::cos(0.25f * static_cast<float>(M_PI));
+    for (size_t i = 0; i < output.size(); ++i) {
+        EXPECT_NEAR(output[i], expected, 1e-5f);
+    }
+    engine->stopPlayback();
+}
+
+TEST_F(AudioEngineTest, PerformanceMetricsStartWithoutUnderruns) {
+    auto metrics = engine->getPerformanceMetrics();
+    EXPECT_EQ(metrics.bufferUnderruns, 0);
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
@@ -1,6 +1,27 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
 #include "../src/VRDAW.hpp"
+#include "../src/dsp/kernels/DSPKernels.hpp"
+#include "../src/audio/SubtractiveSynthesizer.hpp"
+#include "../src/audio/OscillatorTables.hpp"
+#include "../src/audio/VoicePool.hpp"
+#include "../src/audio/ConvolutionEngine.hpp"
+#include "../src/audio/Effects.hpp"
+#include "../src/audio/DynamicsCore.hpp"
+#include "../src/audio/BinauralRenderer.hpp"
+#include "../src/audio/Ambisonics.hpp"
+#include "../src/audio/AtmosObjectStore.hpp"
+#include "../src/audio/AcousticPropagation.hpp"
+#include "../src/audio/AudioWorkerPool.hpp"
+#include "../src/audio/Mixer.hpp"
+#include "../src/audio/Automation.hpp"
+#include "../src/audio/ParameterRegistry.hpp"
+#include "../src/audio/AudioTrack.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -147,5 +168,843 @@ TEST_F(VRDAWAudioTest, AudioErrorHandling) {
     EXPECT_TRUE(daw->isAudioEngineActive());
 }
 
+// Alle verfügbaren SIMD-Varianten müssen (bis auf Rundung) dem Skalar-Pfad entsprechen,
+// auch bei Blockgrößen, die kein Vielfaches der Vektorbreite sind
+TEST(DSPKernelTest, VariantsMatchScalar) {
+    dsp::initializeKernels();
+    const dsp::KernelTable* scalar = dsp::getKernelVariant(dsp::KernelVariant::Scalar);
+    ASSERT_NE(scalar, nullptr);
+
+    for (size_t frames : {1u, 7u, 64u, 129u, 1031u}) {
+        std::vector<float> src(frames * 2);
+        for (size_t i = 0; i < src.size(); ++i) {
+            src[i] = std::sin(static_cast<float>(i) * 0.37f);
+        }
+
+        for (dsp::KernelVariant variant : dsp::getAvailableVariants()) {
+            const dsp::KernelTable* kernels = dsp::getKernelVariant(variant);
+            ASSERT_NE(kernels, nullptr);
+
+            std::vector<float> expected(frames * 2, 0.25f), actual(frames * 2, 0.25f);
+            scalar->multiplyAddStereo(expected.data(), src.data(), frames, 0.7f, 0.3f);
+            kernels->multiplyAddStereo(actual.data(), src.data(), frames, 0.7f, 0.3f);
+            for (size_t i = 0; i < expected.size(); ++i) {
+                EXPECT_NEAR(expected[i], actual[i], 1e-6f) << dsp::getVariantName(variant);
+            }
+
+            expected = src;
+            actual = src;
+            scalar->applyGainRamp(expected.data(), expected.size(), 1.0f, 0.0f);
+            kernels->applyGainRamp(actual.data(), actual.size(), 1.0f, 0.0f);
+            for (size_t i = 0; i < expected.size(); ++i) {
+                EXPECT_NEAR(expected[i], actual[i], 1e-5f) << dsp::getVariantName(variant);
+            }
+
+            expected = src;
+            actual = src;
+            scalar->applyStereoGainRamp(expected.data(), frames, 1.0f, 0.2f, 0.0f, 0.9f);
+            kernels->applyStereoGainRamp(actual.data(), frames, 1.0f, 0.2f, 0.0f, 0.9f);
+            for (size_t i = 0; i < expected.size(); ++i) {
+                EXPECT_NEAR(expected[i], actual[i], 1e-5f) << dsp::getVariantName(variant);
+            }
+
+            EXPECT_FLOAT_EQ(scalar->peak(src.data(), src.size()),
+                            kernels->peak(src.data(), src.size()));
+            EXPECT_NEAR(scalar->sumOfSquares(src.data(), src.size()),
+                        kernels->sumOfSquares(src.data(), src.size()), 1e-3f);
+        }
+    }
+}
+
+// Mehr als 16 Stimmen, SoA-Renderer mit Release-Ausklang bis zur Stille
+TEST(SynthVoiceRendererTest, ScalesPastSixteenVoicesAndReleasesToSilence) {
+    SubtractiveSynthesizer synth;
+    synth.setMaxVoices(64);
+    synth.setSampleRate(48000.0f);
+    synth.setFilterType("lowpass");
+    synth.setEnvelope({0.001f, 0.01f, 0.8f, 0.05f});
+
+    for (uint8_t note = 30; note < 70; ++note) {
+        synth.noteOn(note, 100);
+    }
+    EXPECT_EQ(synth.getMaxVoices(), 64u);
+
+    std::vector<float> output(480 * 2);
+    synth.processBlock(output.data(), output.size());
+    EXPECT_EQ(synth.getActiveVoiceCount(), 40u);
+    float peak = 0.0f;
+    for (float sample : output) peak = std::max(peak, std::abs(sample));
+    EXPECT_GT(peak, 0.0f);
+
+    for (uint8_t note = 30; note < 70; ++note) {
+        synth.noteOff(note, 0);
+    }
+
+    // Nach der Release-Zeit (50 ms) ist jede Stimme verklungen
+    for (int block = 0; block < 10; ++block) {
+        synth.processBlock(output.data(), output.size());
+    }
+    EXPECT_EQ(synth.getActiveVoiceCount(), 0u);
+    for (float sample : output) {
+        EXPECT_EQ(sample, 0.0f);
+    }
+}
+
+// Mip-Stufen bleiben unter Nyquist, PolyBLEP glättet den Sägezahn-Sprung
+TEST(OscillatorTablesTest, MipLevelsBandLimitAndBlepSmoothsEdges) {
+    const OscillatorTables& tables = OscillatorTables::get();
+    EXPECT_EQ(&tables, &OscillatorTables::get());
+
+    for (float increment = 1e-5f; increment < 0.5f; increment *= 1.1f) {
+        const size_t level = OscillatorTables::levelForIncrement(increment);
+        const size_t harmonics = (OscillatorTables::kTableSize / 2) >> level;
+        if (level + 1 < OscillatorTables::kMipLevels) {
+            EXPECT_LE(harmonics * increment, 0.5f) << "increment " << increment;
+        }
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        const float phase = i / 100.0f;
+        EXPECT_NEAR(tables.lookupSine(phase), std::sin(2.0f * 3.14159265f * phase), 1e-5f);
+    }
+
+    // Naiver Sägezahn springt um 2, der korrigierte verteilt den Sprung auf zwei Samples
+    const float dt = 0.01f;
+    const float beforeWrap = osc::blepSaw(1.0f - dt * 0.5f, dt);
+    const float afterWrap = osc::blepSaw(dt * 0.5f, dt);
+    EXPECT_LT(std::abs(beforeWrap - afterWrap), 1.5f);
+    EXPECT_FLOAT_EQ(osc::blepSaw(0.5f, dt), 0.0f);
+
+    // Rauschen mit eigenem Zustand: gleiche Seeds, gleiche Folge
+    uint32_t a = 12345u, b = 12345u;
+    for (int i = 0; i < 16; ++i) {
+        const float value = osc::xorshiftNoise(a);
+        EXPECT_EQ(value, osc::xorshiftNoise(b));
+        EXPECT_GE(value, -1.0f);
+        EXPECT_LT(value, 1.0f);
+    }
+}
+
+// O(1)-Vergabe mit Notentabelle und den Stealing-Strategien
+TEST(VoicePoolTest, AllocatesReleasesAndStealsByPolicy) {
+    VoicePool pool(3);
+    EXPECT_EQ(pool.allocate(60, 0).index, 0);
+    EXPECT_EQ(pool.allocate(62, 0).index, 1);
+    EXPECT_EQ(pool.allocate(64, 0).index, 2);
+    EXPECT_EQ(pool.getHeldCount(), 3u);
+
+    // Note-Off über die Tabelle, ausklingende Stimmen werden zuerst gestohlen
+    EXPECT_EQ(pool.release(62, 0), 1);
+    EXPECT_EQ(pool.release(62, 0), VoicePool::kNone);
+    VoicePool::Allocation stolen = pool.allocate(65, 0);
+    EXPECT_EQ(stolen.index, 1);
+    EXPECT_TRUE(stolen.stolen);
+    EXPECT_EQ(pool.findHeld(62, 0), VoicePool::kNone);
+
+    // Ohne ausklingende Stimme: die älteste gehaltene
+    EXPECT_EQ(pool.allocate(67, 0).index, 0);
+    EXPECT_EQ(pool.release(60, 0), VoicePool::kNone);
+
+    // Leiseste Stimme per Pegel-Callback
+    pool.setStealPolicy(VoicePool::StealPolicy::Quietest);
+    const float levels[3] = {0.8f, 0.9f, 0.1f};
+    const auto levelOf = [](const void* context, size_t index) {
+        return static_cast<const float*>(context)[index];
+    };
+    EXPECT_EQ(pool.allocate(69, 0, levelOf, levels).index, 2);
+
+    // Gleiche Note schlägt dieselbe Stimme neu an
+    pool.setStealPolicy(VoicePool::StealPolicy::SameNote);
+    const VoicePool::Allocation same = pool.allocate(69, 0);
+    EXPECT_EQ(same.index, 2);
+    EXPECT_TRUE(same.stolen);
+
+    pool.setStealPolicy(VoicePool::StealPolicy::None);
+    EXPECT_EQ(pool.allocate(71, 1).index, VoicePool::kNone);
+
+    pool.free(0);
+    EXPECT_EQ(pool.getState(0), VoicePool::State::Free);
+    EXPECT_EQ(pool.findHeld(67, 0), VoicePool::kNone);
+    EXPECT_EQ(pool.allocate(71, 1).index, 0);
+}
+
+// Volle Polyphonie: die 17. Note stiehlt, statt verworfen zu werden
+TEST(VoicePoolTest, SynthesizerStealsWhenAllVoicesAreBusy) {
+    SubtractiveSynthesizer synth;
+    std::vector<float> output(64 * 2);
+    for (uint8_t note = 40; note < 57; ++note) {
+        synth.noteOn(note, 100);
+    }
+    synth.processBlock(output.data(), output.size());
+    EXPECT_EQ(synth.getActiveVoiceCount(), Synthesizer::kDefaultMaxVoices);
+
+    synth.noteOff(56, 0);
+    synth.processBlock(output.data(), output.size());
+    EXPECT_EQ(synth.getActiveVoiceCount(), Synthesizer::kDefaultMaxVoices - 1);
+    // Die gestohlene erste Note ist nicht mehr gehalten
+    synth.noteOff(40, 0);
+    synth.processBlock(output.data(), output.size());
+    EXPECT_EQ(synth.getActiveVoiceCount(), Synthesizer::kDefaultMaxVoices - 1);
+}
+
+// Partitionierte Faltung gegen direkte Faltung, über Kopf- und Schwanzstufe
+// und mit unregelmäßigen Host-Blöcken
+TEST(ConvolutionEngineTest, MatchesDirectConvolutionAndSharesIR) {
+    constexpr size_t kBlock = 32;
+    uint32_t seed = 12345;
+    auto random = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+    };
+
+    std::vector<std::vector<float>> response(2, std::vector<float>(3000));
+    for (auto& channel : response) {
+        for (float& sample : channel) sample = random();
+    }
+    auto ir = ConvolutionIRCache::get().acquire("test:direct", kBlock, [&] { return response; });
+    ASSERT_GT(ir->getLength(), ir->getTailBlockSize());
+    EXPECT_EQ(ConvolutionIRCache::get().acquire("test:direct", kBlock, [&] { return response; }), ir);
+
+    ConvolutionEngine engine(ir);
+    const size_t latency = engine.getLatency();
+    const size_t length = 8000;
+    std::vector<float> left(length), right(length), outLeft(length), outRight(length);
+    for (size_t i = 0; i < length; ++i) {
+        left[i] = random();
+        right[i] = random();
+    }
+
+    const size_t chunks[] = {1, 7, 64, 33, 250, 5};
+    for (size_t done = 0, k = 0; done < length; ++k) {
+        const size_t chunk = std::min(chunks[k % 6], length - done);
+        engine.process(left.data() + done, right.data() + done, outLeft.data() + done, outRight.data() + done, chunk);
+        done += chunk;
+    }
+
+    float maxError = 0.0f;
+    for (size_t n = latency; n < length; n += 7) {
+        double expectedLeft = 0.0, expectedRight = 0.0;
+        const size_t t = n - latency;
+        for (size_t m = 0; m < response[0].size() && m <= t; ++m) {
+            expectedLeft += static_cast<double>(response[0][m]) * left[t - m];
+            expectedRight += static_cast<double>(response[1][m]) * right[t - m];
+        }
+        maxError = std::max(maxError, std::fabs(outLeft[n] - static_cast<float>(expectedLeft)));
+        maxError = std::max(maxError, std::fabs(outRight[n] - static_cast<float>(expectedRight)));
+    }
+    EXPECT_LT(maxError, 1e-3f);
+}
+
+TEST(ConvolutionEngineTest, ReverbEffectStaysFiniteAndDecays) {
+    ReverbEffect reverb;
+    reverb.setParameter("time", 0.5f);
+    reverb.setParameter("mix", 1.0f);
+    reverb.waitUntilLoaded();
+
+    std::vector<float> buffer(2 * 512, 0.0f);
+    buffer[0] = buffer[1] = 1.0f;
+    float early = 0.0f;
+    for (int block = 0; block < 10; ++block) {
+        reverb.process(buffer.data(), 512);
+        for (float sample : buffer) {
+            ASSERT_TRUE(std::isfinite(sample));
+            early = std::max(early, std::fabs(sample));
+        }
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+    }
+    EXPECT_GT(early, 0.0f);
+
+    // Nach mehr als der Nachhallzeit ist der Hall verklungen
+    for (int block = 0; block < 100; ++block) {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        reverb.process(buffer.data(), 512);
+    }
+    EXPECT_LT(dsp::peak(buffer.data(), buffer.size()), 1e-3f);
+}
+
+TEST(DynamicsCoreTest, CompressorCurveAndLimiterCeilings) {
+    DynamicsCore::Parameters compressor;
+    compressor.threshold = -20.0f;
+    compressor.ratio = 4.0f;
+    compressor.knee = 0.0f;
+    EXPECT_NEAR(DynamicsCore::computeGainReduction(-10.0f, compressor), -7.5f, 1e-4f);
+    EXPECT_EQ(DynamicsCore::computeGainReduction(-30.0f, compressor), 0.0f);
+
+    // Eingeschwungener Sinus mit -10 dBFS Spitze landet bei -17.5 dBFS
+    const float rate = 48000.0f;
+    DynamicsCore core;
+    core.prepare(rate);
+    compressor.attack = 0.001f;
+    compressor.release = 0.5f;
+    core.setParameters(compressor);
+    std::vector<float> left(4800), right(4800);
+    float peak = 0.0f;
+    for (int block = 0; block < 20; ++block) {
+        for (size_t i = 0; i < left.size(); ++i) {
+            left[i] = right[i] = 0.3162f * std::sin(2.0f * 3.14159265f * 100.0f * i / rate);
+        }
+        core.process(left.data(), right.data(), left.size());
+        peak = dsp::peak(left.data(), left.size());
+    }
+    EXPECT_NEAR(20.0f * std::log10(peak), -17.5f, 0.3f);
+
+    // Brickwall mit Lookahead: keine Spitze über der Decke, auch bei Sprüngen
+    DynamicsCore::Parameters limiter;
+    limiter.mode = DynamicsCore::Mode::Limiter;
+    limiter.threshold = -6.0f;
+    limiter.lookahead = 0.002f;
+    limiter.release = 0.05f;
+    core.setParameters(limiter);
+    core.reset();
+    uint32_t seed = 99;
+    float limitedPeak = 0.0f;
+    for (int block = 0; block < 20; ++block) {
+        for (size_t i = 0; i < left.size(); ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            const float burst = (i / 300) % 3 == 0 ? 2.0f : 0.2f;
+            left[i] = burst * (static_cast<float>(seed >> 8) / 8388608.0f - 1.0f);
+            right[i] = -left[i];
+        }
+        core.process(left.data(), right.data(), left.size());
+        limitedPeak = std::max(limitedPeak, dsp::peak(left.data(), left.size()));
+    }
+    EXPECT_LE(limitedPeak, std::pow(10.0f, -6.0f / 20.0f) * 1.001f);
+
+    // Sinus bei fs/4 um 45 Grad versetzt: Samples bei 0.707, echte Spitze 1.0.
+    // Nur die True-Peak-Erkennung zieht den Pegel unter -1 dBTP
+    limiter.threshold = -1.0f;
+    limiter.truePeak = true;
+    core.setParameters(limiter);
+    core.reset();
+    for (int block = 0; block < 5; ++block) {
+        for (size_t i = 0; i < left.size(); ++i) {
+            left[i] = right[i] = std::sin(3.14159265f * 0.5f * i + 0.25f * 3.14159265f);
+        }
+        core.process(left.data(), right.data(), left.size());
+    }
+    const float truePeak = dsp::peak(left.data(), left.size()) / 0.70711f;
+    EXPECT_LT(20.0f * std::log10(truePeak), -0.9f);
+    EXPECT_GT(20.0f * std::log10(truePeak), -1.5f);
+    EXPECT_EQ(core.getLatency(), static_cast<size_t>(0.002f * rate + 0.5f) + 6);
+}
+
+// Kugelkopf-HRIRs: Quelle links ist links lauter und früher. Der Renderer
+// entspricht bei fester Richtung der direkten Faltung mit der HRIR
+TEST(BinauralRendererTest, MatchesHRIRAndLateralizes) {
+    const float rate = 48000.0f;
+    auto hrtf = HRTFSet::createSphericalHead(rate);
+    const size_t left = hrtf->findNearest(-1.0f, 0.0f, 0.0f);
+    EXPECT_NEAR(hrtf->getAzimuth(left), 90.0f, 0.1f);
+    EXPECT_EQ(hrtf->findNearest(0.0f, 0.0f, -2.0f), hrtf->findNearest(0.0f, 0.0f, -0.5f));
+
+    auto energyAndOnset = [](const std::vector<float>& response, float& energy) {
+        energy = 0.0f;
+        size_t onset = 0;
+        for (size_t i = 0; i < response.size(); ++i) {
+            energy += response[i] * response[i];
+            if (std::fabs(response[i]) > std::fabs(response[onset])) onset = i;
+        }
+        return onset;
+    };
+    float nearEnergy, farEnergy;
+    const size_t nearOnset = energyAndOnset(hrtf->getImpulseResponse(left, 0), nearEnergy);
+    const size_t farOnset = energyAndOnset(hrtf->getImpulseResponse(left, 1), farEnergy);
+    EXPECT_GT(nearEnergy, farEnergy * 2.0f);
+    // Woodworth-ITD bei 90 Grad: (a/c)(1 + pi/2), gut 30 Samples bei 48 kHz
+    EXPECT_GT(farOnset, nearOnset + 25);
+    EXPECT_LT(farOnset, nearOnset + 36);
+
+    BinauralRenderer renderer(hrtf, 4);
+    BinauralRenderer::SourceState states[2];
+    states[0].x = -1.0f;
+    states[0].z = 0.0f;
+    states[0].gain = 0.5f;
+
+    const size_t length = 4000;
+    std::vector<float> input(length), outLeft(length), outRight(length);
+    uint32_t seed = 99;
+    for (float& sample : input) {
+        seed = seed * 1664525u + 1013904223u;
+        sample = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+    }
+    const size_t chunks[] = {1, 100, 31, 128, 500};
+    for (size_t done = 0, k = 0; done < length; ++k) {
+        const size_t chunk = std::min(chunks[k % 5], length - done);
+        const float* inputs[2] = {input.data() + done, nullptr};
+        renderer.process(inputs, states, 2, outLeft.data() + done, outRight.data() + done, chunk);
+        done += chunk;
+    }
+    EXPECT_EQ(renderer.getActiveSources(), 1u);
+
+    const size_t latency = renderer.getLatency();
+    float maxError = 0.0f;
+    for (size_t n = latency; n < length; n += 5) {
+        const size_t t = n - latency;
+        for (size_t ear = 0; ear < 2; ++ear) {
+            const auto& response = hrtf->getImpulseResponse(left, ear);
+            double expected = 0.0;
+            for (size_t m = 0; m < response.size() && m <= t; ++m) {
+                expected += 0.5 * response[m] * input[t - m];
+            }
+            const float actual = ear == 0 ? outLeft[n] : outRight[n];
+            maxError = std::max(maxError, std::fabs(actual - static_cast<float>(expected)));
+        }
+    }
+    EXPECT_LT(maxError, 1e-4f);
+
+    // Kopfdrehung während der Wiedergabe: Überblendung bleibt stetig
+    // (gemessen erst, wenn das Rauschen von oben ausgeklungen ist)
+    float maxJump = 0.0f, previous = 0.0f;
+    for (int block = 0; block < 200; ++block) {
+        const float angle = block * 0.05f;
+        states[0].x = -std::cos(angle);
+        states[0].z = -std::sin(angle);
+        std::vector<float> sine(64);
+        for (size_t i = 0; i < sine.size(); ++i) {
+            sine[i] = std::sin(0.02f * (block * 64 + i));
+        }
+        const float* inputs[2] = {sine.data(), nullptr};
+        renderer.process(inputs, states, 2, outLeft.data(), outRight.data(), sine.size());
+        for (size_t i = 0; i < sine.size(); ++i) {
+            if (block >= 8) maxJump = std::max(maxJump, std::fabs(outLeft[i] - previous));
+            previous = outLeft[i];
+        }
+    }
+    EXPECT_LT(maxJump, 0.05f);
+
+    // Rohformat: Schreiben und Laden ergibt denselben Satz
+    std::vector<HRTFSet::Measurement> measurements(2);
+    measurements[0].azimuth = 30.0f;
+    measurements[0].left = {1.0f, 0.5f};
+    measurements[0].right = {0.25f};
+    measurements[1].azimuth = -30.0f;
+    measurements[1].elevation = 10.0f;
+    measurements[1].left = {0.25f};
+    measurements[1].right = {1.0f, 0.5f};
+    const std::string path = ::testing::TempDir() + "hrir_roundtrip.bin";
+    HRTFSet::saveRaw(path, measurements, rate);
+    auto loaded = HRTFSet::loadRaw(path);
+    ASSERT_EQ(loaded->getNumDirections(), 2u);
+    EXPECT_FLOAT_EQ(loaded->getAzimuth(1), 330.0f);
+    EXPECT_EQ(loaded->getImpulseResponse(0, 1), (std::vector<float>{0.25f, 0.0f}));
+    EXPECT_EQ(loaded->findNearest(1.0f, 0.0f, -1.0f), 1u);
+    EXPECT_THROW(HRTFSet::loadRaw(path + ".missing"), std::runtime_error);
+}
+
+// Drehung auf dem Bus entspricht dem Kodieren der gedrehten Richtung;
+// Lautsprecher- und Binauraldekoder lokalisieren eine Quelle vorne links
+TEST(AmbisonicsTest, RotationAndDecoding) {
+    const int order = 3;
+    const size_t channels = ambisonics::channelsForOrder(order);
+    const size_t frames = 64;
+    auto encodeDirection = [&](float x, float y, float z) {
+        std::vector<float> coefficients(channels);
+        std::vector<float*> columns(channels);
+        for (size_t ch = 0; ch < channels; ++ch) columns[ch] = &coefficients[ch];
+        ambisonics::evaluate(order, &x, &y, &z, 1, columns.data());
+        return coefficients;
+    };
+
+    const float dx = 0.3f, dy = 0.5f, dz = -0.8f;
+    const float angle = 0.7f;
+    const auto original = encodeDirection(dx, dy, dz);
+    // Drehung um +y: x' = x cos + z sin, z' = -x sin + z cos
+    const auto rotated = encodeDirection(dx * std::cos(angle) + dz * std::sin(angle), dy,
+                                         -dx * std::sin(angle) + dz * std::cos(angle));
+    EXPECT_FLOAT_EQ(original[0], 1.0f);
+
+    AmbisonicBus bus(order, frames);
+    AmbisonicRotator rotator(order);
+    rotator.setRotation(std::cos(angle / 2), 0.0f, std::sin(angle / 2), 0.0f);
+    float maxError = 0.0f;
+    for (int block = 0; block < 2; ++block) {
+        for (size_t ch = 0; ch < channels; ++ch) {
+            std::fill(bus.getChannel(ch), bus.getChannel(ch) + frames, original[ch]);
+        }
+        rotator.process(bus, frames);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            // Erster Block gerampt: am Ende muss die Zielmatrix erreicht sein
+            maxError = std::max(maxError, std::fabs(bus.getChannel(ch)[frames - 1] - rotated[ch]));
+            if (block == 1) maxError = std::max(maxError, std::fabs(bus.getChannel(ch)[0] - rotated[ch]));
+        }
+    }
+    EXPECT_LT(maxError, 1e-3f);
+
+    // Quelle bei 30 Grad links, konstantes Signal
+    const float sx = -0.5f, sy = 0.0f, sz = -0.8660254f;
+    std::vector<float> input(frames, 1.0f);
+    const float* inputs[1] = {input.data()};
+    const float gain = 1.0f;
+    AmbisonicEncoder encoder(order, 1);
+    bus.clear(frames);
+    encoder.process(inputs, &sx, &sy, &sz, &gain, 1, bus, frames);
+    EXPECT_NEAR(bus.getChannel(1)[0], 0.5f, 1e-4f);
+
+    AmbisonicDecoder decoder(order, SpeakerLayout::surround714());
+    ASSERT_EQ(decoder.getNumOutputs(), 12u);
+    std::vector<std::vector<float>> speakers(12, std::vector<float>(frames));
+    std::vector<float*> outputs;
+    for (auto& speaker : speakers) outputs.push_back(speaker.data());
+    decoder.process(bus, outputs.data(), frames);
+    for (size_t s = 1; s < speakers.size(); ++s) {
+        EXPECT_GT(speakers[0][0], std::fabs(speakers[s][0])) << "Lautsprecher " << s;
+    }
+    EXPECT_EQ(speakers[3][0], 0.0f);
+
+    // Binaural: Rauschen vorne links ist links deutlich lauter
+    auto hrtf = HRTFSet::createSphericalHead(48000.0f);
+    AmbisonicBinauralDecoder binaural(order, hrtf);
+    const size_t length = 4096;
+    std::vector<float> noise(length), outLeft(length), outRight(length);
+    uint32_t seed = 5;
+    for (float& sample : noise) {
+        seed = seed * 1664525u + 1013904223u;
+        sample = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+    }
+    for (size_t done = 0; done < length; done += frames) {
+        const float* block[1] = {noise.data() + done};
+        bus.clear(frames);
+        encoder.process(block, &sx, &sy, &sz, &gain, 1, bus, frames);
+        binaural.process(bus, outLeft.data() + done, outRight.data() + done, frames);
+    }
+    double leftEnergy = 0.0, rightEnergy = 0.0;
+    for (size_t n = binaural.getLatency(); n < length; ++n) {
+        leftEnergy += outLeft[n] * outLeft[n];
+        rightEnergy += outRight[n] * outRight[n];
+    }
+    EXPECT_GT(leftEnergy, rightEnergy * 1.5);
+    EXPECT_GT(leftEnergy, 0.0);
+}
+
+// Handles bleiben dicht und erkennen Neubelegung; der Audio-Thread sieht
+// über den Dreifachpuffer immer einen vollständigen Stand
+TEST(AtmosObjectStoreTest, HandlesAndPublishing) {
+    AtmosObjectStore store(4, 64);
+    const auto a = store.create("a");
+    const auto b = store.create("b");
+    EXPECT_EQ(AtmosObjectStore::slotOf(a), 0u);
+    EXPECT_EQ(AtmosObjectStore::slotOf(b), 1u);
+    EXPECT_EQ(store.create("a"), AtmosObjectStore::kInvalidHandle);
+    EXPECT_EQ(store.find("b"), b);
+
+    EXPECT_TRUE(store.destroy(a));
+    EXPECT_FALSE(store.isValid(a));
+    const auto c = store.create("c");
+    EXPECT_EQ(AtmosObjectStore::slotOf(c), 0u);
+    EXPECT_NE(c, a);
+    store.setPosition(a, 5.0f, 5.0f, 5.0f);
+    EXPECT_EQ(store.getWorking().x[0], 0.0f);
+
+    // Vor commit() sieht der Leser den alten Stand
+    EXPECT_EQ(store.acquire().slotCount, 0u);
+    store.setPosition(c, 1.0f, 2.0f, 3.0f);
+    store.commit();
+    const auto& snapshot = store.acquire();
+    EXPECT_EQ(snapshot.slotCount, 2u);
+    EXPECT_EQ(snapshot.generation[0], AtmosObjectStore::generationOf(c));
+    EXPECT_EQ(snapshot.y[0], 2.0f);
+
+    store.setPosition(b, 0.0f, 0.0f, 0.0f);
+    store.commit();
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            const auto& state = store.acquire();
+            if (state.x[1] != state.y[1] || state.y[1] != state.z[1]) ++torn;
+        }
+    });
+    for (int i = 0; i < 20000; ++i) {
+        const float value = static_cast<float>(i);
+        store.setPosition(b, value, value, value);
+        store.commit();
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(store.acquire().x[1], 19999.0f);
+}
+
+// Laufzeit nach Entfernung, Doppler-Verschiebung einer nahenden Quelle,
+// Reflexionen nur mit Raum und Ausklingen nach dem Stoppen
+TEST(AcousticPropagationTest, DelayDopplerAndReflections) {
+    EXPECT_FLOAT_EQ(AcousticPropagation::distanceGain(DistanceModel::Inverse, 4.0f, 1.0f, 100.0f, 1.0f), 0.25f);
+    EXPECT_FLOAT_EQ(AcousticPropagation::distanceGain(DistanceModel::Linear, 50.5f, 1.0f, 100.0f, 1.0f), 0.5f);
+    EXPECT_FLOAT_EQ(AcousticPropagation::distanceGain(DistanceModel::Exponential, 4.0f, 1.0f, 100.0f, 0.5f), 0.5f);
+    EXPECT_FLOAT_EQ(AcousticPropagation::distanceGain(DistanceModel::Inverse, 0.2f, 1.0f, 100.0f, 1.0f), 1.0f);
+
+    constexpr float sampleRate = 48000.0f;
+    constexpr size_t block = 128;
+    AcousticPropagation propagation(2, sampleRate, block);
+    AcousticPropagation::Room room;
+    room.reflection = 0.0f;
+    propagation.setRoom(room);
+    EXPECT_FALSE(propagation.hasReflections());
+
+    std::vector<float> input(block, 0.0f), output(block * 2), walls(block * AcousticPropagation::kNumWalls);
+    float* outputs[2] = {output.data(), output.data() + block};
+    float* wallOutputs[AcousticPropagation::kNumWalls];
+    for (size_t w = 0; w < AcousticPropagation::kNumWalls; ++w) wallOutputs[w] = walls.data() + w * block;
+    const float* results[2];
+
+    // Impuls in 3,43 m: 10 ms = 480 Samples später, Pegel 1/3,43
+    AcousticPropagation::Source sources[2];
+    sources[0].z = -3.43f;
+    std::vector<float> response;
+    for (int b = 0; b < 8; ++b) {
+        std::fill(input.begin(), input.end(), 0.0f);
+        if (b == 0) input[0] = 1.0f;
+        const float* inputs[2] = {input.data(), nullptr};
+        propagation.process(inputs, sources, 2, 0.0f, 0.0f, 0.0f, outputs, results, wallOutputs, block);
+        ASSERT_EQ(results[0], outputs[0]);
+        EXPECT_EQ(results[1], nullptr);
+        response.insert(response.end(), output.begin(), output.begin() + block);
+    }
+    const size_t peak = std::max_element(response.begin(), response.end()) - response.begin();
+    EXPECT_NEAR(static_cast<double>(peak), 480.0, 1.0);
+    double sum = 0.0;
+    for (float value : response) sum += value;
+    EXPECT_NEAR(sum, 1.0 / 3.43, 0.01);
+
+    // Quelle nähert sich mit 0,1 c: Frequenz steigt um 1 / (1 - 0,1)
+    propagation.reset();
+    constexpr float frequency = 1000.0f;
+    constexpr float speed = 0.1f * AcousticPropagation::kSpeedOfSound;
+    size_t crossings = 0;
+    float previous = 0.0f;
+    size_t counted = 0;
+    for (size_t b = 0; b < 300; ++b) {
+        const float start = static_cast<float>(b * block) / sampleRate;
+        for (size_t n = 0; n < block; ++n) {
+            input[n] = std::sin(6.2831853f * frequency * (start + static_cast<float>(n) / sampleRate));
+        }
+        sources[0].z = -40.0f + speed * start;
+        const float* inputs[2] = {input.data(), nullptr};
+        propagation.process(inputs, sources, 2, 0.0f, 0.0f, 0.0f, outputs, results, wallOutputs, block);
+        if (b < 100) continue;
+        for (size_t n = 0; n < block; ++n) {
+            if (previous <= 0.0f && output[n] > 0.0f) ++crossings;
+            previous = output[n];
+        }
+        counted += block;
+    }
+    const double measured = crossings * sampleRate / counted;
+    EXPECT_NEAR(measured, frequency / 0.9, 15.0);
+
+    // Mit Raum: Reflexionen auf den Wandausgängen, nach dem Stoppen klingt
+    // die Quelle aus und ruht dann
+    room.reflection = 0.7f;
+    propagation.setRoom(room);
+    propagation.reset();
+    sources[0].x = 1.0f;
+    sources[0].y = 1.5f;
+    sources[0].z = -2.0f;
+    double wallEnergy = 0.0;
+    for (int b = 0; b < 20; ++b) {
+        const float* inputs[2] = {input.data(), nullptr};
+        propagation.process(inputs, sources, 2, 0.0f, 1.7f, 0.0f, outputs, results, wallOutputs, block);
+        for (float value : walls) wallEnergy += value * value;
+    }
+    EXPECT_GT(wallEnergy, 0.0);
+    size_t silentBlocks = 0;
+    for (int b = 0; b < 200 && results[0]; ++b) {
+        const float* inputs[2] = {nullptr, nullptr};
+        propagation.process(inputs, sources, 2, 0.0f, 1.7f, 0.0f, outputs, results, wallOutputs, block);
+        ++silentBlocks;
+    }
+    EXPECT_EQ(results[0], nullptr);
+    EXPECT_GT(silentBlocks, 10u);
+}
+
+// Routing-Graph des Mixers: Laufzeitausgleich, Zyklen, Solo/Mute, Sends,
+// Sidechains und gleiches Ergebnis auf dem Worker-Pool
+TEST(MixerTest, RoutingSoloAndLatencyCompensation) {
+    constexpr size_t frames = 256;
+    auto impulse = [](Track* track, size_t position) {
+        std::fill(track->buffer.begin(), track->buffer.end(), 0.0f);
+        track->buffer[position * 2] = 1.0f;
+        track->buffer[position * 2 + 1] = 1.0f;
+    };
+    auto settle = [](Mixer& m) {
+        // Stille, bis alle Pegelrampen am Ziel sind
+        for (auto& track : m.getTracks()) std::fill(track.buffer.begin(), track.buffer.end(), 0.0f);
+        std::vector<float> silence(4096);
+        m.process(silence.data(), 2048);
+    };
+    auto firstPeak = [](const std::vector<float>& output) {
+        for (size_t i = 0; i < output.size() / 2; ++i) {
+            if (std::fabs(output[i * 2]) > 1e-4f) return i;
+        }
+        return output.size();
+    };
+
+    // A direkt auf den Master, B über einen Bus mit 32 Samples Insert-Latenz:
+    // beide Impulse kommen gleichzeitig an
+    Mixer mixer;
+    const int a = mixer.createTrack("A");
+    const int b = mixer.createTrack("B");
+    const int bus = mixer.createBus("Bus");
+    ASSERT_TRUE(mixer.setOutput(b, bus));
+    mixer.setInsert(bus, [](float* left, float* right, const float*, const float*, size_t n) {
+        // Verzögerung um 32 Samples über statischen Zustand reicht für den Test
+        static std::vector<float> line(64, 0.0f);
+        static size_t position = 0;
+        for (size_t i = 0; i < n; ++i, ++position) {
+            line[position & 63] = left[i];
+            left[i] = right[i] = line[(position - 32) & 63];
+        }
+    }, 32);
+    EXPECT_EQ(mixer.getLatency(), 32u);
+    EXPECT_EQ(mixer.getCompensation(a), 32u);
+    EXPECT_EQ(mixer.getCompensation(bus), 0u);
+
+    std::vector<float> output(frames * 2);
+    impulse(mixer.getTrack(a), 0);
+    std::fill(mixer.getTrack(b)->buffer.begin(), mixer.getTrack(b)->buffer.end(), 0.0f);
+    mixer.process(output.data(), frames);
+    EXPECT_EQ(firstPeak(output), 32u);
+    const float gain = std::cos(0.25f * 3.14159265f);
+    EXPECT_NEAR(output[64], gain, 1e-4f);
+
+    // Zyklus Bus -> Bus2 -> Bus wird abgelehnt, der alte Plan bleibt
+    const int bus2 = mixer.createBus("Bus2");
+    ASSERT_TRUE(mixer.setOutput(bus, bus2));
+    EXPECT_FALSE(mixer.setOutput(bus2, bus));
+    EXPECT_EQ(mixer.getBus(bus2)->output, kMasterBusId);
+    EXPECT_EQ(mixer.addSend(bus2, bus), -1);
+    mixer.deleteBus(bus2);
+    EXPECT_EQ(mixer.getBus(bus)->output, kMasterBusId);
+
+    // Solo lässt muted unangetastet; Solo auf dem Bus hält seine Quelle hörbar
+    mixer.removeInsert(bus);
+    mixer.soloTrack(a);
+    EXPECT_FALSE(mixer.getTrack(b)->muted);
+    mixer.unsoloTrack(a);
+    mixer.soloBus(bus, true);
+    settle(mixer);
+    impulse(mixer.getTrack(a), 0);
+    impulse(mixer.getTrack(b), 4);
+    mixer.process(output.data(), frames);
+    EXPECT_NEAR(output[0], 0.0f, 1e-6f);
+    EXPECT_NEAR(output[8], gain * gain, 1e-4f);
+    mixer.soloBus(bus, false);
+
+    // Volume springt nicht, sondern fährt über 20 ms (882 Samples) auf 0
+    settle(mixer);
+    std::fill(mixer.getTrack(a)->buffer.begin(), mixer.getTrack(a)->buffer.end(), 1.0f);
+    mixer.setTrackVolume(a, 0.0f);
+    mixer.process(output.data(), frames);
+    EXPECT_NEAR(output[0], gain, 1e-4f);
+    EXPECT_NEAR(output[(frames - 1) * 2], gain * (1.0f - (frames - 1) / 882.0f), 1e-3f);
+
+    // Pre-Fader-Send läuft auch bei Volume 0; Sidechain erreicht den Insert
+    const int fx = mixer.createBus("FX");
+    ASSERT_GE(mixer.addSend(a, fx, 0.5f, true), 0);
+    ASSERT_GE(mixer.addSidechain(a, bus), 0);
+    settle(mixer);
+    float keyEnergy = 0.0f;
+    mixer.setInsert(bus, [&keyEnergy](float*, float*, const float* sideLeft, const float*, size_t n) {
+        ASSERT_NE(sideLeft, nullptr);
+        for (size_t i = 0; i < n; ++i) keyEnergy += sideLeft[i] * sideLeft[i];
+    });
+    std::fill(mixer.getTrack(b)->buffer.begin(), mixer.getTrack(b)->buffer.end(), 0.0f);
+    impulse(mixer.getTrack(a), 10);
+    mixer.process(output.data(), frames);
+    EXPECT_NEAR(output[20], 0.5f * gain, 1e-4f);
+    EXPECT_NEAR(keyEnergy, 1.0f, 1e-5f);
+
+    // Worker-Pool und kleine Blöcke liefern dasselbe wie seriell
+    std::vector<float> serial(output);
+    mixer.setInsert(bus, [](float* left, float* right, const float*, const float*, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            left[i] *= 0.5f;
+            right[i] *= 0.25f;
+        }
+    }, 0);
+    impulse(mixer.getTrack(b), 7);
+    mixer.process(serial.data(), frames);
+    AudioWorkerPool pool;
+    pool.start(2);
+    mixer.setWorkerPool(&pool);
+    mixer.setMaxBlockSize(64);
+    std::vector<float> parallel(frames * 2);
+    mixer.process(parallel.data(), frames);
+    for (size_t i = 0; i < serial.size(); ++i) EXPECT_NEAR(parallel[i], serial[i], 1e-6f);
+    mixer.setWorkerPool(nullptr);
+}
+
+// Parameter-IDs: Tabelle mit Metadaten, Queue zum Audio-Thread, Dispatch
+// in Effekten und auf dem AudioTrack
+TEST(ParameterRegistryTest, RegistryQueueAndEffectDispatch) {
+    ParameterRegistry registry;
+    const ParameterId bands = registry.add({"bands", 1.0f, 32.0f, 8.0f, ParameterUnit::None, 0.0f, true});
+    const ParameterId gain = registry.add({"gain", -24.0f, 24.0f, 0.0f, ParameterUnit::Decibels});
+    EXPECT_EQ(bands, 0u);
+    EXPECT_EQ(gain, 1u);
+    EXPECT_EQ(registry.find("gain"), gain);
+    EXPECT_EQ(registry.find("missing"), kInvalidParameterId);
+    EXPECT_FLOAT_EQ(registry.clamp(bands, 7.6f), 8.0f);
+    EXPECT_FLOAT_EQ(registry.clamp(gain, 40.0f), 24.0f);
+    EXPECT_THROW(registry.add({"gain"}), std::invalid_argument);
+
+    // Voll: verwerfen und zählen, Reihenfolge bleibt erhalten
+    ParameterChangeQueue queue(4);
+    for (int i = 0; i < 6; ++i) queue.push({0, gain, static_cast<float>(i)});
+    EXPECT_EQ(queue.getDroppedCount(), 2u);
+    ParameterChange change;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.pop(change));
+        EXPECT_FLOAT_EQ(change.value, static_cast<float>(i));
+    }
+    EXPECT_TRUE(queue.empty());
+
+    // Effekte: Namen nur an der Kante, Bereich aus den Metadaten
+    DelayEffect delay;
+    EXPECT_EQ(delay.getParameterNames(), (std::vector<std::string>{"time", "feedback", "mix"}));
+    EXPECT_EQ(delay.getParameterId("feedback"), DelayEffect::kFeedback);
+    delay.setParameter(DelayEffect::kFeedback, 2.0f);
+    EXPECT_FLOAT_EQ(delay.getParameter("feedback"), 0.99f);
+    delay.setParameter("unknown", 1.0f);
+    EXPECT_FLOAT_EQ(delay.getParameter("unknown"), 0.0f);
+
+    // Latenz folgt dem gesetzten Wert schon vor dem nächsten Block
+    LimiterEffect limiter;
+    limiter.setParameter(LimiterEffect::kTruePeak, 0.0f);
+    limiter.setParameter(LimiterEffect::kLookahead, 0.001f);
+    EXPECT_EQ(limiter.getLatency(), 44u);
+
+    // Mehr Änderungen als die Queue fasst: der letzte Wert kommt trotzdem an
+    CompressorEffect compressor;
+    for (int i = 0; i <= 300; ++i) {
+        compressor.setParameter(CompressorEffect::kMakeup, static_cast<float>(i % 7));
+    }
+    EXPECT_FLOAT_EQ(compressor.getParameter(CompressorEffect::kMakeup), 6.0f);
+    std::vector<float> quiet(8192, 0.01f);
+    compressor.process(quiet.data(), quiet.size() / 2);
+    EXPECT_NEAR(quiet.back(), 0.01f * std::pow(10.0f, 6.0f / 20.0f), 1e-4f);
+
+    // Zeit/Dämpfung brauchen eine neue Raumantwort: nicht automatisierbar
+    ReverbEffect reverb;
+    reverb.automateParameter(ReverbEffect::kTime, 5.0f);
+    reverb.automateParameter(ReverbEffect::kMix, 0.25f);
+    EXPECT_FLOAT_EQ(reverb.getParameter(ReverbEffect::kTime), 2.0f);
+    EXPECT_FLOAT_EQ(reverb.getParameter(ReverbEffect::kMix), 0.25f);
+
+    // Automation löst den Namen einmal auf und setzt über die ID
+    Automation automation;
+    automation.getLane("mix").addPoint(0, 0.0f);
+    automation.getLane("mix").addPoint(100, 1.0f);
+    automation.setPosition(25);
+    automation.apply(delay);
+    EXPECT_FLOAT_EQ(delay.getParameter(DelayEffect::kMix), 0.25f);
+
+    AudioTrack track;
+    EXPECT_EQ(AudioTrack::getSynthesizerParameters().find("lfo_rate"), AudioTrack::kLfoRate);
+    track.setSynthesizerParameter("filter_cutoff", 50000.0f);
+    EXPECT_FLOAT_EQ(track.getSynthesizerParameter(AudioTrack::kFilterCutoff), 20000.0f);
+    track.setSynthesizerParameter(AudioTrack::kOscillatorType, 2.4f);
+    EXPECT_FLOAT_EQ(track.getSynthesizerParameter("oscillator_type"), 2.0f);
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
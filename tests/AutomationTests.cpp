@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
+#include <vector>
 #include "../src/VRDAW.hpp"
+#include "../src/audio/Automation.hpp"
+#include "../src/audio/AudioTrack.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -181,5 +185,79 @@ TEST_F(VRDAWAutomationTest, AutomationIntegration) {
     EXPECT_LT(values.filter, 20000.0f);
 }
 
+// Automationsspur: Kurven, sampelgenaue Stützpunkte, Cursor; Glätter und
+// Volume-Automation auf dem AudioTrack
+TEST(AutomationTest, LaneRampsSmoothersAndTrackAutomation) {
+    AutomationLane lane;
+    lane.addPoint(100, 0.0f);
+    lane.addPoint(200, 1.0f, AutomationCurve::Exponential);
+    lane.addPoint(1200, 4.0f, AutomationCurve::Step);
+    lane.addPoint(1300, 0.5f);
+    EXPECT_FLOAT_EQ(lane.getValue(50), 0.0f);
+    EXPECT_FLOAT_EQ(lane.getValue(150), 0.5f);
+    EXPECT_NEAR(lane.getValue(700), 2.0f, 1e-5f);
+    EXPECT_FLOAT_EQ(lane.getValue(1299), 4.0f);
+    EXPECT_FLOAT_EQ(lane.getValue(1300), 0.5f);
+    EXPECT_FLOAT_EQ(lane.getValue(5000), 0.5f);
+
+    // Blockweise Rampen: enden an jedem Stützpunkt, gekrümmte Stücke sind
+    // kurz und folgen der Kurve
+    AutomationLane::Cursor cursor;
+    std::vector<int64_t> boundaries;
+    for (int64_t block = 0; block < 1536; block += 128) {
+        for (size_t done = 0; done < 128;) {
+            const int64_t position = block + static_cast<int64_t>(done);
+            const ParameterRamp ramp = lane.nextRamp(position, 128 - done, cursor);
+            ASSERT_GT(ramp.length, 0u);
+            if (position >= 200 && position < 1200) {
+                EXPECT_LE(ramp.length, AutomationLane::kMaxRampLength);
+            }
+            for (size_t i = 0; i < ramp.length; ++i) {
+                const float value = ramp.start + (ramp.end - ramp.start) * i / ramp.length;
+                ASSERT_NEAR(value, lane.getValue(position + static_cast<int64_t>(i)), 0.01f) << position + i;
+            }
+            done += ramp.length;
+            boundaries.push_back(block + static_cast<int64_t>(done));
+        }
+    }
+    for (int64_t point : {100, 200, 1200, 1300}) {
+        EXPECT_NE(std::find(boundaries.begin(), boundaries.end(), point), boundaries.end()) << point;
+    }
+    EXPECT_FLOAT_EQ(lane.getValue(150, cursor), 0.5f); // Rücksprung sucht neu
+
+    // Glätter: 10 Samples Rampe, über das Blockende gestreckt
+    ParameterSmoother smoother;
+    smoother.prepare(1000.0f, 0.01f);
+    smoother.setTarget(1.0f);
+    ParameterRamp ramp = smoother.next(4);
+    EXPECT_FLOAT_EQ(ramp.start, 0.0f);
+    EXPECT_FLOAT_EQ(ramp.end, 0.4f);
+    ramp = smoother.next(10);
+    EXPECT_FLOAT_EQ(ramp.end, 1.0f);
+    EXPECT_FALSE(smoother.isSmoothing());
+
+    // Track: Volume fällt sampelgenau bei Sample 20 auf 0; ohne Automation
+    // gleitet es zurück auf den manuellen Wert statt zu springen
+    AudioTrack track;
+    track.setSampleRate(1000.0f);
+    AutomationLane volume;
+    volume.addPoint(10, 1.0f, AutomationCurve::Step);
+    volume.addPoint(20, 0.0f);
+    track.setAutomation(AudioTrack::Parameter::Volume, volume);
+    MIDIBlockEvents events;
+    std::vector<float> output(64, 1.0f);
+    track.processBlock(output.data(), output.size(), events, 0);
+    for (size_t i = 0; i < 32; ++i) {
+        EXPECT_FLOAT_EQ(output[i * 2], i < 20 ? 1.0f : 0.0f) << i;
+        EXPECT_FLOAT_EQ(output[i * 2 + 1], i < 20 ? 1.0f : 0.0f) << i;
+    }
+    track.clearAutomation(AudioTrack::Parameter::Volume);
+    std::fill(output.begin(), output.end(), 1.0f);
+    track.processBlock(output.data(), output.size(), events, 32);
+    EXPECT_FLOAT_EQ(output[0], 0.0f);
+    EXPECT_GT(output[31 * 2], 0.9f);
+    for (size_t i = 1; i < 32; ++i) EXPECT_GE(output[i * 2], output[(i - 1) * 2]);
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../src/audio/BinauralRenderer.hpp"
+#include "../src/dsp/kernels/DSPKernels.hpp"
+
+// Benchmark für den binauralen Renderer: Kern-Anteil bei 48 kHz und daraus
+// hochgerechnete Quellen pro Kern. "Bewegt" dreht alle Quellen jeden Block
+// weiter (jede Quelle überblendet, ungünstigster Fall bei Kopfdrehung),
+// "Statisch" lässt Richtung und Pegel stehen.
+// Aufruf: BinauralBenchmark [blockSize] [Sekunden]
+
+namespace {
+
+using namespace VR_DAW;
+
+constexpr float kSampleRate = 48000.0f;
+
+volatile float sink = 0.0f;
+
+double measureCoreShare(const std::shared_ptr<const HRTFSet>& hrtf, size_t sources, bool moving,
+                        size_t blockSize, double seconds) {
+    BinauralRenderer renderer(hrtf, sources);
+    std::vector<BinauralRenderer::SourceState> states(sources);
+    std::vector<std::vector<float>> signals(sources, std::vector<float>(blockSize));
+    std::vector<const float*> inputs(sources);
+    uint32_t seed = 1;
+    for (size_t s = 0; s < sources; ++s) {
+        for (float& sample : signals[s]) {
+            seed = seed * 1664525u + 1013904223u;
+            sample = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+        }
+        inputs[s] = signals[s].data();
+        const float angle = 6.2831853f * s / sources;
+        states[s].x = std::sin(angle);
+        states[s].z = -std::cos(angle);
+        states[s].gain = 1.0f / sources;
+    }
+
+    std::vector<float> left(blockSize), right(blockSize);
+    const size_t blocks = static_cast<size_t>(seconds * kSampleRate / blockSize);
+    float heading = 0.0f;
+
+    auto run = [&](size_t count) {
+        for (size_t b = 0; b < count; ++b) {
+            if (moving) {
+                // 90 Grad/s Kopfdrehung plus leichte Pegeländerung
+                heading += 1.5707963f * blockSize / kSampleRate;
+                for (size_t s = 0; s < sources; ++s) {
+                    const float angle = 6.2831853f * s / sources + heading;
+                    states[s].x = std::sin(angle);
+                    states[s].z = -std::cos(angle);
+                    states[s].gain = (1.0f + 0.1f * std::sin(heading + s)) / sources;
+                }
+            }
+            renderer.process(inputs.data(), states.data(), sources, left.data(), right.data(), blockSize);
+            sink = left[0];
+        }
+    };
+
+    run(blocks / 10 + 1);
+    const auto start = std::chrono::steady_clock::now();
+    run(blocks);
+    const auto end = std::chrono::steady_clock::now();
+
+    const double elapsed = std::chrono::duration<double>(end - start).count();
+    return elapsed / (static_cast<double>(blocks * blockSize) / kSampleRate);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t blockSize = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 128;
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+
+    dsp::initializeKernels();
+    auto hrtf = HRTFSet::createSphericalHead(kSampleRate);
+
+    std::printf("Binaural-Benchmark (48 kHz, Blockgröße %zu, %.1f s Audio je Messung)\n",
+                blockSize, seconds);
+    std::printf("Kernel-Variante: %s, HRIR %zu Taps, %zu Richtungen\n\n", dsp::getKernels().name,
+                hrtf->getFilterLength(), hrtf->getNumDirections());
+    std::printf("%-10s %-10s %12s %18s\n", "Quellen", "Modus", "Kern-%", "Quellen/Kern");
+
+    for (size_t sources : {32, 128, 256, 512}) {
+        for (bool moving : {false, true}) {
+            const double share = measureCoreShare(hrtf, sources, moving, blockSize, seconds);
+            std::printf("%-10zu %-10s %11.2f%% %18.0f\n", sources, moving ? "Bewegt" : "Statisch",
+                        100.0 * share, sources / share);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "../src/audio/ConvolutionEngine.hpp"
+#include "../src/dsp/kernels/DSPKernels.hpp"
+
+// Benchmark für die partitionierte Faltung: CPU-Anteil eines Kerns je
+// Stereo-Instanz bei 48 kHz, abhängig von IR-Länge und Instanzzahl. Alle
+// Instanzen einer Messung teilen sich eine Impulsantwort aus dem Cache.
+// Aufruf: ConvolutionReverbBenchmark [blockSize] [Sekunden]
+
+namespace {
+
+using namespace VR_DAW;
+
+constexpr float kSampleRate = 48000.0f;
+
+volatile float sink = 0.0f;
+
+std::vector<std::vector<float>> makeNoiseResponse(size_t length) {
+    std::vector<std::vector<float>> channels(2, std::vector<float>(length));
+    uint32_t state = 0x12345678u;
+    for (auto& channel : channels) {
+        for (float& sample : channel) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            sample = (static_cast<float>(state) * (2.0f / 4294967296.0f) - 1.0f) * 0.01f;
+        }
+    }
+    return channels;
+}
+
+struct Result {
+    double corePercentPerInstance;
+    size_t sharedBytes;
+    size_t instanceBytes;
+};
+
+Result measure(double irSeconds, size_t instanceCount, size_t blockSize, double seconds) {
+    const size_t irLength = static_cast<size_t>(irSeconds * kSampleRate);
+    const std::string key = "benchmark:" + std::to_string(irLength);
+    auto ir = ConvolutionIRCache::get().acquire(key, ConvolutionIR::kDefaultBlockSize,
+                                                [irLength] { return makeNoiseResponse(irLength); });
+
+    std::vector<std::unique_ptr<ConvolutionEngine>> engines;
+    for (size_t i = 0; i < instanceCount; ++i) {
+        engines.push_back(std::make_unique<ConvolutionEngine>(ir));
+    }
+
+    std::vector<float> left(blockSize), right(blockSize);
+    for (size_t i = 0; i < blockSize; ++i) {
+        left[i] = (i % 64) < 32 ? 0.1f : -0.1f;
+        right[i] = -left[i];
+    }
+    std::vector<float> outLeft(blockSize), outRight(blockSize);
+
+    // Mindestens zwei große Blöcke, damit jede Stufe gemessen wird
+    const size_t blocks = static_cast<size_t>(seconds * kSampleRate / blockSize);
+    for (size_t i = 0; i < blocks / 10 + 1; ++i) {
+        for (auto& engine : engines) {
+            engine->process(left.data(), right.data(), outLeft.data(), outRight.data(), blockSize);
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < blocks; ++i) {
+        for (auto& engine : engines) {
+            engine->process(left.data(), right.data(), outLeft.data(), outRight.data(), blockSize);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    sink = outLeft[0];
+
+    const double cpuSeconds = std::chrono::duration<double>(end - start).count();
+    const double audioSeconds = static_cast<double>(blocks * blockSize) / kSampleRate;
+    return {100.0 * cpuSeconds / audioSeconds / instanceCount, ir->getMemoryBytes(), engines[0]->getMemoryBytes()};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t blockSize = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 128;
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+
+    dsp::initializeKernels();
+
+    std::printf("Faltungshall-Benchmark (48 kHz, Stereo, Host-Block %zu, Partition %zu/%zu, %.1f s Audio)\n",
+                blockSize, ConvolutionIR::kDefaultBlockSize,
+                ConvolutionIR::kDefaultBlockSize * ConvolutionIR::kTailRatio, seconds);
+    std::printf("Kernel-Variante: %s\n\n", dsp::getKernels().name);
+    std::printf("%8s %10s %16s %14s %14s\n", "IR (s)", "Instanzen", "Kern-% je Inst.", "IR geteilt", "je Instanz");
+
+    for (double irSeconds : {1.0, 2.0, 4.0, 8.0}) {
+        for (size_t instances : {1, 8, 32}) {
+            const Result r = measure(irSeconds, instances, blockSize, seconds);
+            std::printf("%8.1f %10zu %15.2f%% %11.1f MB %11.1f MB\n", irSeconds, instances,
+                        r.corePercentPerInstance, r.sharedBytes / 1048576.0, r.instanceBytes / 1048576.0);
+        }
+    }
+
+    return 0;
+}
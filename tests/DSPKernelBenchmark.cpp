@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../src/dsp/kernels/DSPKernels.hpp"
+
+// Microbenchmark für die DSP-Kernels: misst ns/Sample je Variante.
+// Aufruf: DSPKernelBenchmark [blockSize] [iterations]
+
+namespace {
+
+using namespace VR_DAW::dsp;
+
+volatile float sink = 0.0f;
+
+template<typename Fn>
+double measureNsPerSample(Fn&& fn, size_t samplesPerCall, int iterations) {
+    // Aufwärmen, damit Caches und Taktfrequenz stabil sind
+    for (int i = 0; i < iterations / 10 + 1; ++i) fn();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / (static_cast<double>(samplesPerCall) * iterations);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t blockSize = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 128;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> a(blockSize * 2), b(blockSize * 2), left(blockSize), right(blockSize);
+    for (auto& x : a) x = dist(rng);
+    for (auto& x : b) x = dist(rng);
+
+    std::printf("DSP-Kernel-Benchmark (Blockgröße %zu, %d Iterationen)\n", blockSize, iterations);
+    std::printf("Aktive Variante: %s\n\n", getKernels().name);
+    std::printf("%-10s %12s %12s %12s %12s %12s %12s %12s %12s\n", "Variante",
+                "gain", "gainRamp", "stereoGain", "mulAdd", "mulAddStereo",
+                "interleave", "deinterl.", "peak+rms");
+
+    for (KernelVariant variant : getAvailableVariants()) {
+        const KernelTable& k = *getKernelVariant(variant);
+        // In-Place-Kernels mit Gain 1, damit keine Denormals entstehen
+        const size_t n = blockSize;
+
+        const double gain = measureNsPerSample([&] { k.applyGain(a.data(), n, 1.0f); }, n, iterations);
+        const double ramp = measureNsPerSample([&] { k.applyGainRamp(a.data(), n, 1.0f, 1.0f); }, n, iterations);
+        const double stereo = measureNsPerSample([&] { k.applyStereoGain(a.data(), n / 2, 1.0f, 1.0f); }, n, iterations);
+        const double mac = measureNsPerSample([&] { k.multiplyAdd(a.data(), b.data(), n, 1e-6f); }, n, iterations);
+        const double macStereo = measureNsPerSample([&] { k.multiplyAddStereo(a.data(), b.data(), n / 2, 1e-6f, 1e-6f); }, n, iterations);
+        const double inter = measureNsPerSample([&] { k.interleave(left.data(), right.data(), a.data(), n); }, n * 2, iterations);
+        const double deinter = measureNsPerSample([&] { k.deinterleave(b.data(), left.data(), right.data(), n); }, n * 2, iterations);
+        const double levels = measureNsPerSample([&] {
+            sink = k.peak(b.data(), n) + k.sumOfSquares(b.data(), n);
+        }, n, iterations);
+
+        std::printf("%-10s %12.4f %12.4f %12.4f %12.4f %12.4f %12.4f %12.4f %12.4f\n", k.name,
+                    gain, ramp, stereo, mac, macStereo, inter, deinter, levels);
+    }
+
+    std::printf("\nWerte in ns/Sample\n");
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../src/audio/DynamicsCore.hpp"
+#include "../src/dsp/kernels/DSPKernels.hpp"
+
+// Benchmark für den Dynamik-Kern: ns pro Stereo-Frame und Kern-Anteil bei
+// 48 kHz für die Master-Bus-Konfigurationen. Parameter werden jeden Block
+// gesetzt (unverändert), wie es ein Host mit Automation tut.
+// Aufruf: DynamicsBenchmark [blockSize] [Sekunden]
+
+namespace {
+
+using namespace VR_DAW;
+
+constexpr float kSampleRate = 48000.0f;
+
+volatile float sink = 0.0f;
+
+double measureNanosecondsPerFrame(const std::vector<DynamicsCore::Parameters>& chain,
+                                  size_t blockSize, double seconds) {
+    std::vector<DynamicsCore> cores(chain.size());
+    for (size_t i = 0; i < chain.size(); ++i) {
+        cores[i].prepare(kSampleRate);
+        cores[i].setParameters(chain[i]);
+    }
+
+    std::vector<float> left(blockSize), right(blockSize);
+    const size_t blocks = static_cast<size_t>(seconds * kSampleRate / blockSize);
+    uint32_t seed = 1;
+
+    auto run = [&](size_t count) {
+        for (size_t b = 0; b < count; ++b) {
+            for (size_t i = 0; i < blockSize; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                left[i] = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+                right[i] = -left[i];
+            }
+            for (size_t c = 0; c < cores.size(); ++c) {
+                cores[c].setParameters(chain[c]);
+                cores[c].process(left.data(), right.data(), blockSize);
+            }
+        }
+    };
+
+    // Rauscherzeugung separat messen und abziehen
+    const auto noiseStart = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t i = 0; i < blockSize; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            left[i] = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+        }
+        sink = left[0];
+    }
+    const auto noiseEnd = std::chrono::steady_clock::now();
+
+    run(blocks / 10 + 1);
+    const auto start = std::chrono::steady_clock::now();
+    run(blocks);
+    const auto end = std::chrono::steady_clock::now();
+    sink = left[0];
+
+    const double total = std::chrono::duration<double, std::nano>(end - start).count()
+                       - std::chrono::duration<double, std::nano>(noiseEnd - noiseStart).count();
+    return std::max(0.0, total) / static_cast<double>(blocks * blockSize);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t blockSize = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 128;
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+
+    dsp::initializeKernels();
+
+    DynamicsCore::Parameters compressor;
+    DynamicsCore::Parameters compressorLookahead = compressor;
+    compressorLookahead.lookahead = 0.005f;
+
+    DynamicsCore::Parameters limiter;
+    limiter.mode = DynamicsCore::Mode::Limiter;
+    limiter.threshold = -1.0f;
+    limiter.release = 0.05f;
+    limiter.lookahead = 0.005f;
+    DynamicsCore::Parameters truePeakLimiter = limiter;
+    truePeakLimiter.truePeak = true;
+
+    struct Case {
+        const char* name;
+        std::vector<DynamicsCore::Parameters> chain;
+    };
+    const Case cases[] = {
+        {"Kompressor", {compressor}},
+        {"Kompressor + 5 ms Lookahead", {compressorLookahead}},
+        {"Limiter 5 ms", {limiter}},
+        {"Limiter 5 ms True-Peak", {truePeakLimiter}},
+        {"Master: Kompressor + TP-Limiter", {compressor, truePeakLimiter}},
+    };
+
+    std::printf("Dynamik-Benchmark (48 kHz, Stereo, Blockgröße %zu, %.1f s Audio je Messung)\n",
+                blockSize, seconds);
+    std::printf("Kernel-Variante: %s\n\n", dsp::getKernels().name);
+    std::printf("%-34s %12s %12s\n", "Kette", "ns/Frame", "Kern-%");
+
+    for (const auto& c : cases) {
+        const double ns = measureNanosecondsPerFrame(c.chain, blockSize, seconds);
+        std::printf("%-34s %12.2f %11.3f%%\n", c.name, ns, 100.0 * ns * kSampleRate * 1e-9);
+    }
+
+    return 0;
+}
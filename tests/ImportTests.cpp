@@ -1,6 +1,19 @@
 #include <gtest/gtest.h>
+#include <sqlite3.h>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "../src/VRDAW.hpp"
+#include "../src/audio/SampleDatabase.hpp"
+#include "../src/audio/SampleStreamer.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -184,5 +197,271 @@ TEST_F(VRDAWImportTest, ImportBatch) {
     }
 }
 
+// Disk-Streaming: Kopf resident, Rest über den Ring; Aussetzer bei
+// angehaltener I/O werden gezählt und ausgeblendet, danach geht es weiter
+TEST(SampleStreamerTest, StreamsHeadAndRingAndSurvivesStarvation) {
+    // WAV schreiben: Float stereo, links steigend, rechts negativ
+    auto writeWav = [](const std::string& path, const std::vector<float>& interleaved, uint16_t channels,
+                       uint16_t format, uint16_t bits) {
+        std::vector<uint8_t> pcm;
+        for (float value : interleaved) {
+            if (format == 3) {
+                uint8_t bytes[4];
+                std::memcpy(bytes, &value, 4);
+                pcm.insert(pcm.end(), bytes, bytes + 4);
+            } else {
+                const int16_t sample = static_cast<int16_t>(std::lround(value * 32767.0f));
+                pcm.push_back(static_cast<uint8_t>(sample & 0xff));
+                pcm.push_back(static_cast<uint8_t>((sample >> 8) & 0xff));
+            }
+        }
+        auto u32 = [](std::vector<uint8_t>& out, uint32_t v) {
+            for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+        };
+        auto u16 = [](std::vector<uint8_t>& out, uint16_t v) {
+            out.push_back(static_cast<uint8_t>(v));
+            out.push_back(static_cast<uint8_t>(v >> 8));
+        };
+        std::vector<uint8_t> file = {'R', 'I', 'F', 'F'};
+        u32(file, static_cast<uint32_t>(36 + pcm.size()));
+        for (char c : std::string("WAVEfmt ")) file.push_back(static_cast<uint8_t>(c));
+        u32(file, 16);
+        u16(file, format);
+        u16(file, channels);
+        u32(file, 48000);
+        u32(file, 48000u * channels * bits / 8);
+        u16(file, static_cast<uint16_t>(channels * bits / 8));
+        u16(file, bits);
+        for (char c : std::string("data")) file.push_back(static_cast<uint8_t>(c));
+        u32(file, static_cast<uint32_t>(pcm.size()));
+        file.insert(file.end(), pcm.begin(), pcm.end());
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(file.data()), file.size());
+    };
+    auto expected = [](size_t frame) { return static_cast<float>(frame % 1000) / 1000.0f; };
+
+    const size_t frames = 4000;
+    std::vector<float> stereo(frames * 2);
+    for (size_t i = 0; i < frames; ++i) {
+        stereo[i * 2] = expected(i);
+        stereo[i * 2 + 1] = -expected(i);
+    }
+    const std::string stereoPath = ::testing::TempDir() + "streamer_stereo.wav";
+    writeWav(stereoPath, stereo, 2, 3, 32);
+
+    SampleStreamer::Config config;
+    config.maxVoices = 1100;
+    config.headFrames = 256;
+    config.chunkFrames = 64;
+    config.chunksPerVoice = 4;
+    SampleStreamer streamer(config);
+    const SampleStreamer::SampleId sample = streamer.addSample(stereoPath);
+    const SampleStreamer::SampleInfo info = streamer.getSampleInfo(sample);
+    EXPECT_EQ(info.frames, frames);
+    EXPECT_EQ(info.residentFrames, 256u);
+    EXPECT_THROW(streamer.addSample(::testing::TempDir() + "missing.wav"), std::runtime_error);
+
+    auto waitBuffered = [&streamer](SampleStreamer::VoiceId voice, size_t needed) {
+        for (int i = 0; i < 2000 && streamer.getBufferedFrames(voice) < needed; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    // Ganzes Sample in kleinen Blöcken, jeweils nach dem Nachladen
+    constexpr size_t block = 48;
+    std::vector<float> left(block), right(block);
+    SampleStreamer::VoiceId voice = streamer.startVoice(sample);
+    ASSERT_NE(voice, SampleStreamer::kInvalidVoice);
+    for (size_t position = 0; position < frames; position += block) {
+        waitBuffered(voice, std::min(block, frames - position));
+        std::fill(left.begin(), left.end(), 0.0f);
+        std::fill(right.begin(), right.end(), 0.0f);
+        const size_t rendered = streamer.render(voice, left.data(), right.data(), block);
+        ASSERT_EQ(rendered, std::min(block, frames - position));
+        for (size_t i = 0; i < rendered; ++i) {
+            ASSERT_FLOAT_EQ(left[i], expected(position + i)) << position + i;
+            ASSERT_FLOAT_EQ(right[i], -expected(position + i)) << position + i;
+        }
+    }
+    EXPECT_FALSE(streamer.isPlaying(voice));
+    EXPECT_EQ(streamer.getVoiceStats(voice).misses, 0u);
+    EXPECT_EQ(streamer.getVoiceStats(voice).streamedFrames, frames - 256);
+    // Kopf plus der Ring der einen benutzten Stimme, nicht maxVoices Ringe
+    EXPECT_EQ(streamer.getStats().residentBytes, (256 * 2 + 4 * 64 * 2) * sizeof(float));
+
+    // I/O angehalten: der Kopf spielt, danach Stille mit Blende und Zählern;
+    // die Stimme läuft zeitlich weiter und setzt wieder ein
+    streamer.setIOPaused(true);
+    voice = streamer.startVoice(sample, 100);
+    ASSERT_NE(voice, SampleStreamer::kInvalidVoice);
+    std::vector<float> output(512 * 2, 0.0f);
+    streamer.render(voice, output.data(), output.data() + 512, 512);
+    for (size_t i = 0; i < 156; ++i) EXPECT_FLOAT_EQ(output[i], expected(100 + i));
+    EXPECT_LT(std::fabs(output[156 + 32]), std::fabs(output[155]));
+    for (size_t i = 156 + 64; i < 512; ++i) EXPECT_EQ(output[i], 0.0f);
+    SampleStreamer::VoiceStats stats = streamer.getVoiceStats(voice);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.missedFrames, 512u - 156u);
+    streamer.setIOPaused(false);
+    waitBuffered(voice, 200);
+    std::fill(output.begin(), output.end(), 0.0f);
+    streamer.render(voice, output.data(), output.data() + 512, 200);
+    for (size_t i = 64; i < 200; ++i) EXPECT_FLOAT_EQ(output[i], expected(612 + i));
+    streamer.stopVoice(voice);
+
+    // Mono 16 Bit: beide Seiten gleich
+    std::vector<float> mono(frames);
+    for (size_t i = 0; i < frames; ++i) mono[i] = expected(i) - 0.5f;
+    const std::string monoPath = ::testing::TempDir() + "streamer_mono.wav";
+    writeWav(monoPath, mono, 1, 1, 16);
+    const SampleStreamer::SampleId monoSample = streamer.addSample(monoPath);
+
+    // Über 1000 gleichzeitige Stimmen
+    std::vector<SampleStreamer::VoiceId> voices;
+    for (size_t v = 0; v < 1024; ++v) {
+        voices.push_back(streamer.startVoice(v % 2 ? monoSample : sample, (v * 7) % 200));
+        ASSERT_NE(voices.back(), SampleStreamer::kInvalidVoice);
+    }
+    EXPECT_EQ(streamer.getStats().activeVoices, 1024u);
+    for (size_t position = 0; position < 1024; position += block) {
+        for (size_t v = 0; v < voices.size(); ++v) {
+            waitBuffered(voices[v], block);
+            std::fill(left.begin(), left.end(), 0.0f);
+            std::fill(right.begin(), right.end(), 0.0f);
+            streamer.render(voices[v], left.data(), right.data(), block);
+            const size_t frame = (v * 7) % 200 + position;
+            const float value = v % 2 ? mono[frame] : expected(frame);
+            ASSERT_NEAR(left[0], value, 1e-4f) << v;
+            ASSERT_NEAR(right[0], v % 2 ? value : -value, 1e-4f) << v;
+        }
+    }
+    for (SampleStreamer::VoiceId v : voices) streamer.stopVoice(v);
+    EXPECT_EQ(streamer.getStats().misses, 1u);
+
+    // Entfernt: keine neuen Stimmen mehr
+    streamer.removeSample(monoSample);
+    EXPECT_EQ(streamer.startVoice(monoSample), SampleStreamer::kInvalidVoice);
+
+    // Nach der Freigabe wird der Slot mit neuer Generation wiederverwendet;
+    // die alte ID bleibt ungültig
+    for (int i = 0; i < 2000 && streamer.getStats().samples > 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(streamer.getStats().samples, 1u);
+    const SampleStreamer::SampleId reused = streamer.addSample(monoPath);
+    EXPECT_NE(reused, monoSample);
+    EXPECT_EQ(reused & 0xffff, monoSample & 0xffff);
+    EXPECT_EQ(streamer.getSampleInfo(monoSample).frames, 0u);
+    EXPECT_EQ(streamer.getSampleInfo(reused).frames, frames);
+    EXPECT_EQ(streamer.startVoice(monoSample), SampleStreamer::kInvalidVoice);
+    voice = streamer.startVoice(reused);
+    ASSERT_NE(voice, SampleStreamer::kInvalidVoice);
+    streamer.stopVoice(voice);
+    std::remove(stereoPath.c_str());
+    std::remove(monoPath.c_str());
+}
+
+// Sample-Katalog: Upsert im Batch, Volltextsuche mit Präfixen und Relevanz,
+// Aktualisieren, Löschen und Umzug aus dem alten JSON-Schema
+TEST(SampleDatabaseTest, SearchUpdateAndLegacyMigration) {
+    const std::string path = ::testing::TempDir() + "sample_database_test.db";
+    std::remove(path.c_str());
+
+    auto makeSample = [](const std::string& name, const std::string& instrument, const std::string& genre,
+                         const std::string& mood, std::vector<std::string> tags) {
+        SampleMetadata metadata{};
+        metadata.name = name;
+        metadata.instrument = instrument;
+        metadata.genre = genre;
+        metadata.mood = mood;
+        metadata.tags = std::move(tags);
+        metadata.bpm = 120.0f;
+        metadata.isFree = true;
+        metadata.lastUpdated = std::chrono::system_clock::from_time_t(1700000000);
+        return metadata;
+    };
+
+    {
+        SampleDatabase database(path);
+        {
+            SampleDatabase::Batch batch(database);
+            database.upsert("kick.wav", makeSample("Deep Kick", "Drums", "Techno", "dark", {"kick", "808"}));
+            database.upsert("pad.wav", makeSample("Warm Pad", "Synth", "Ambient", "calm", {"pad", "lush texture"}));
+            database.upsert("snare.wav", makeSample("Snare Crack", "Drums", "Hip Hop", "punchy", {"snare"}));
+            database.upsert("kalimba.wav", makeSample("Kalimba Loop", "Kalimba", "Afrobeat", "heiter", {"loop"}));
+        }
+        EXPECT_EQ(database.count(), 4u);
+
+        // Präfix, mehrere Wörter, Satzzeichen und Groß/Klein
+        std::vector<SampleMetadata> hits = database.search("dru");
+        EXPECT_EQ(hits.size(), 2u);
+        hits = database.search("drums TECHNO");
+        ASSERT_EQ(hits.size(), 1u);
+        EXPECT_EQ(hits[0].name, "Deep Kick");
+        EXPECT_EQ(hits[0].tags, (std::vector<std::string>{"kick", "808"}));
+        EXPECT_FLOAT_EQ(hits[0].bpm, 120.0f);
+        EXPECT_EQ(std::chrono::system_clock::to_time_t(hits[0].lastUpdated), 1700000000);
+        EXPECT_EQ(database.search("\"hip-hop\" (snare)")[0].name, "Snare Crack");
+        EXPECT_EQ(database.search("lush").size(), 1u);
+        EXPECT_TRUE(database.search("violin").empty());
+        EXPECT_EQ(database.search("").size(), 4u);
+        EXPECT_EQ(database.search("", 2).size(), 2u);
+
+        // Treffer im Namen vor Treffern im Instrument
+        hits = database.search("kalimba");
+        ASSERT_EQ(hits.size(), 1u);
+        database.upsert("thumb.wav", makeSample("Thumb Piano", "Kalimba", "Folk", "calm", {}));
+        hits = database.search("kalimba");
+        ASSERT_EQ(hits.size(), 2u);
+        EXPECT_EQ(hits[0].name, "Kalimba Loop");
+
+        // Aktualisieren hält den Index aktuell
+        SampleMetadata pad = makeSample("Warm Pad", "Strings", "Cinematic", "epic", {"pad"});
+        EXPECT_TRUE(database.update(pad));
+        EXPECT_TRUE(database.search("synth").empty());
+        EXPECT_EQ(database.search("cinematic")[0].name, "Warm Pad");
+        EXPECT_FALSE(database.update(makeSample("Unknown", "", "", "", {})));
+
+        database.remove("Snare Crack");
+        EXPECT_TRUE(database.search("snare").empty());
+        EXPECT_EQ(database.count(), 4u);
+    }
+
+    // Wieder öffnen: Daten und Index sind persistent
+    {
+        SampleDatabase database(path);
+        SampleMetadata found;
+        ASSERT_TRUE(database.find("Deep Kick", found));
+        EXPECT_EQ(found.genre, "Techno");
+        EXPECT_EQ(database.search("808").size(), 1u);
+    }
+    std::remove(path.c_str());
+
+    // Altes Schema mit JSON-Metadaten wird beim Öffnen übernommen
+    {
+        sqlite3* db = nullptr;
+        ASSERT_EQ(sqlite3_open(path.c_str(), &db), SQLITE_OK);
+        const char* legacy = R"(
+            CREATE TABLE samples (name TEXT PRIMARY KEY, path TEXT, metadata TEXT, last_updated TIMESTAMP,
+                                  is_free BOOLEAN, download_count INTEGER, rating FLOAT);
+            INSERT INTO samples VALUES ('Old Bass', 'bass.wav',
+                '{"description":"sub","instrument":"Bass","genre":"Dubstep","mood":"heavy","bpm":140,"tags":["wobble","sub"]}',
+                1600000000, 1, 7, 4.5);
+        )";
+        ASSERT_EQ(sqlite3_exec(db, legacy, nullptr, nullptr, nullptr), SQLITE_OK);
+        sqlite3_close(db);
+    }
+    {
+        SampleDatabase database(path);
+        std::vector<SampleMetadata> hits = database.search("wobble");
+        ASSERT_EQ(hits.size(), 1u);
+        EXPECT_EQ(hits[0].name, "Old Bass");
+        EXPECT_EQ(hits[0].description, "sub");
+        EXPECT_FLOAT_EQ(hits[0].bpm, 140.0f);
+        EXPECT_TRUE(hits[0].isFree);
+        EXPECT_EQ(hits[0].tags, (std::vector<std::string>{"wobble", "sub"}));
+    }
+    std::remove(path.c_str());
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
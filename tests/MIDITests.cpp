@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <chrono>
+#include <vector>
 #include "../src/VRDAW.hpp"
+#include "../src/midi/MIDIEventQueue.hpp"
+#include "../src/audio/SubtractiveSynthesizer.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -173,5 +176,86 @@ TEST_F(VRDAWMIDITest, MIDIIntegration) {
     EXPECT_EQ(notes[2].note, 67);
 }
 
+// SPSC-Ring: Reihenfolge bleibt erhalten, Überlauf wird gezählt statt zu blockieren
+TEST(MIDIEventQueueTest, PreservesOrderAndCountsOverflow) {
+    MIDIEventQueue queue(4);
+    for (uint8_t i = 0; i < 6; ++i) {
+        queue.push({i, 0x90, i, 100});
+    }
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_EQ(queue.getDroppedCount(), 2u);
+
+    TimedMIDIEvent event;
+    for (uint8_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.pop(event));
+        EXPECT_EQ(event.data1, i);
+    }
+    EXPECT_FALSE(queue.pop(event));
+}
+
+// Events werden einen Block verzögert auf Sample-Offsets abgebildet und sortiert
+TEST(MIDIEventQueueTest, BlockEventsAreSampleAccurateAndSorted) {
+    const double sampleRate = 48000.0;
+    const uint32_t frames = 480; // 10 ms
+    const uint64_t blockEnd = 1000000000ull;
+    const uint64_t blockStart = blockEnd - 10000000ull;
+
+    MIDIEventQueue first, second;
+    first.push({blockStart + 5000000ull, 0x90, 60, 100});  // Mitte -> 240
+    first.push({blockEnd + 1, 0x80, 60, 0});               // gehört zum nächsten Block
+    second.push({blockStart + 1000000ull, 0x90, 64, 100}); // 1 ms -> 48
+    second.push({blockStart - 1, 0x90, 67, 100});          // verspätet -> 0
+
+    MIDIBlockEvents events;
+    events.collect(first, blockEnd, frames, sampleRate);
+    events.collect(second, blockEnd, frames, sampleRate);
+
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].sampleOffset, 0u);
+    EXPECT_EQ(events[1].sampleOffset, 48u);
+    EXPECT_EQ(events[2].sampleOffset, 240u);
+    EXPECT_EQ(events[2].data1, 60);
+    EXPECT_EQ(first.size(), 1u);
+}
+
+// Der Synthesizer teilt den Block am Event: vor dem Note-On bleibt es still
+TEST(MIDIEventQueueTest, SynthesizerSplitsBlockAtEventOffset) {
+    SubtractiveSynthesizer synth;
+    MIDIBlockEvents events;
+    events.add(100, 0x90, 69, 127);
+
+    std::vector<float> output(256 * 2, 1.0f);
+    synth.renderBlock(output.data(), 256, events);
+
+    for (size_t i = 0; i < 100 * 2; ++i) {
+        EXPECT_EQ(output[i], 0.0f);
+    }
+    EXPECT_EQ(synth.getActiveVoiceCount(), 1u);
+}
+
+// Befehle anderer Threads landen in der Queue und wirken erst am nächsten
+// Blockanfang; reset() geht denselben Weg
+TEST(MIDIEventQueueTest, SynthesizerAppliesQueuedCommandsAtBlockStart) {
+    SubtractiveSynthesizer synth;
+    std::vector<float> output(64 * 2);
+
+    synth.noteOn(60, 100);
+    synth.noteOn(64, 100);
+    EXPECT_EQ(synth.getActiveVoiceCount(), 0u);
+    synth.renderBlock(output.data(), 64, MIDIBlockEvents());
+    EXPECT_EQ(synth.getActiveVoiceCount(), 2u);
+
+    synth.noteOff(60, 0);
+    synth.setPitchBend(0.5f);
+    synth.processBlock(output.data(), output.size());
+    EXPECT_EQ(synth.getActiveVoiceCount(), 1u);
+
+    synth.reset();
+    EXPECT_EQ(synth.getActiveVoiceCount(), 1u);
+    synth.processBlock(output.data(), output.size());
+    EXPECT_EQ(synth.getActiveVoiceCount(), 0u);
+    EXPECT_FALSE(synth.isActive());
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
@@ -1,6 +1,17 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 #include "../src/VRDAW.hpp"
+#include "../src/network/JamTransport.hpp"
+#include "../src/network/PayloadCompression.hpp"
+#include "../src/network/StateReplication.hpp"
+#include "../src/audio/VoiceProcessor.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -185,5 +196,619 @@ TEST_F(VRDAWNetworkTest, NetworkSecurity) {
     EXPECT_EQ(securityInfo.authenticatedClients, 1);
 }
 
+TEST(JamTransportTest, JitterBufferConcealsLossAndTracksDrift) {
+    JamJitterBuffer::Config config;
+    config.channels = 1;
+    config.frameSize = 64;
+    config.sampleRate = 48000.0;
+    config.maxDepth = 16;
+    JamJitterBuffer buffer(config);
+
+    const double frameDuration = config.frameSize / config.sampleRate;
+    const double drift = 1.0005;  // Sender läuft 500 ppm schneller
+    const double jitterSeconds = 0.004;
+    const uint32_t packets = 12000;
+
+    // Ankunftszeiten mit gleichverteiltem Jitter; jedes 50. Paket fehlt
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> jitter(0.0, jitterSeconds);
+    std::vector<std::pair<double, uint32_t>> arrivals;
+    for (uint32_t seq = 0; seq < packets; ++seq) {
+        if (seq % 50 == 25) continue;
+        arrivals.push_back({seq * frameDuration / drift + 0.005 + jitter(random), seq});
+    }
+    std::sort(arrivals.begin(), arrivals.end());
+
+    std::vector<float> packet(config.frameSize);
+    std::vector<float> output(config.frameSize);
+    size_t next = 0;
+    float previous = 0.0f;
+    float maxStep = 0.0f;
+    double time = 0.0;
+    const size_t blocks = static_cast<size_t>(packets * 0.98);
+    double ratioSum = 0.0;
+    size_t ratioCount = 0;
+
+    for (size_t block = 0; block < blocks; ++block) {
+        time += frameDuration;
+        for (; next < arrivals.size() && arrivals[next].first <= time; ++next) {
+            const uint32_t seq = arrivals[next].second;
+            for (uint32_t i = 0; i < config.frameSize; ++i) {
+                const double n = static_cast<double>(seq) * config.frameSize + i;
+                packet[i] = 0.5f * static_cast<float>(std::sin(2.0 * M_PI * 220.0 * n / config.sampleRate));
+            }
+            buffer.insert(seq, arrivals[next].first, packet.data());
+        }
+        buffer.read(output.data(), output.size());
+        if (block >= blocks / 2) {
+            ratioSum += buffer.getStats().ratio;
+            ++ratioCount;
+        }
+        for (float sample : output) {
+            ASSERT_TRUE(std::isfinite(sample));
+            ASSERT_LE(std::abs(sample), 0.6f);
+            if (block > 200) maxStep = std::max(maxStep, std::abs(sample - previous));
+            previous = sample;
+        }
+    }
+
+    JamJitterBuffer::Stats stats = buffer.getStats();
+    // Verluste werden erkannt und verdeckt, ohne harte Sprünge
+    EXPECT_GE(stats.lost, 235u);
+    EXPECT_GE(stats.concealed, stats.lost);
+    EXPECT_LT(maxStep, 0.15f);
+    // Puffer wächst mit dem Jitter, Drift wird durch schnelleres Lesen ausgeglichen
+    EXPECT_GT(stats.jitterMs, 0.5);
+    EXPECT_GE(stats.targetDepth, 2u);
+    EXPECT_LE(stats.targetDepth, 8u);
+    EXPECT_NEAR(ratioSum / ratioCount, drift, 0.0003);
+    EXPECT_LT(stats.bufferedMs, (stats.targetDepth + 3) * frameDuration * 1000.0);
+    EXPECT_LE(stats.underruns, 1u);
+}
+
+// Nur die Gegenstelle wird angehört, ob gelernt oder per setPeer() gesetzt
+TEST(JamTransportTest, IgnoresDatagramsFromOtherSenders) {
+    JamTransport host, client, stranger;
+    ASSERT_TRUE(host.open(0));
+    ASSERT_TRUE(client.open(0));
+    ASSERT_TRUE(stranger.open(0));
+    ASSERT_TRUE(client.setPeer("127.0.0.1", host.getLocalPort()));
+    ASSERT_TRUE(stranger.setPeer("127.0.0.1", host.getLocalPort()));
+
+    const uint8_t payload[] = {1};
+    auto waitFor = [](JamTransport& transport, const std::string& expected) {
+        std::string channel;
+        std::vector<uint8_t> message;
+        for (int i = 0; i < 200; ++i) {
+            while (transport.pollMessage(channel, message)) {
+                if (channel == expected) return true;
+                EXPECT_NE(channel, "stranger");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        return false;
+    };
+
+    // Der Host lernt den Client aus dessen erstem Paket
+    client.sendMessage("client", payload, sizeof(payload));
+    ASSERT_TRUE(waitFor(host, "client"));
+    stranger.sendMessage("stranger", payload, sizeof(payload));
+    client.sendMessage("after", payload, sizeof(payload));
+    EXPECT_TRUE(waitFor(host, "after"));
+
+    // Fest gesetzte Gegenstelle: auch das erste fremde Paket wird nicht gelernt
+    JamTransport fixed;
+    ASSERT_TRUE(fixed.open(0));
+    ASSERT_TRUE(fixed.setPeer("127.0.0.1", client.getLocalPort()));
+    ASSERT_TRUE(stranger.setPeer("127.0.0.1", fixed.getLocalPort()));
+    ASSERT_TRUE(client.setPeer("127.0.0.1", fixed.getLocalPort()));
+    stranger.sendMessage("stranger", payload, sizeof(payload));
+    client.sendMessage("client", payload, sizeof(payload));
+    EXPECT_TRUE(waitFor(fixed, "client"));
+}
+
+TEST(JamTransportTest, LoopbackWithInjectedLossAndJitter) {
+    JamTransport::Config config;
+    config.channels = 2;
+    config.frameSize = 128;
+    config.pingIntervalMs = 50.0;
+
+    JamTransport::Config impaired = config;
+    impaired.injectedLoss = 0.05;
+    impaired.injectedJitterMs = 4.0;
+
+    JamTransport host(impaired);
+    JamTransport client(config);
+    ASSERT_TRUE(host.open(0));
+    ASSERT_TRUE(client.open(0));
+    ASSERT_TRUE(client.setPeer("127.0.0.1", host.getLocalPort()));
+
+    // Echtzeit-Takt wie ein Audio-Callback: 128 Frames bei 48 kHz
+    const auto period = std::chrono::microseconds(2667);
+    std::vector<float> block(config.frameSize * config.channels);
+    std::vector<float> output(block.size());
+    double energy = 0.0;
+    auto deadline = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < 750; ++i) {
+        for (uint32_t f = 0; f < config.frameSize; ++f) {
+            const float s = 0.25f * std::sin(2.0f * static_cast<float>(M_PI) * 440.0f *
+                                             static_cast<float>(i * config.frameSize + f) / 48000.0f);
+            block[f * 2] = s;
+            block[f * 2 + 1] = -s;
+        }
+        client.send(block.data(), config.frameSize);
+        host.receive(output.data(), config.frameSize);
+        for (float sample : output) {
+            ASSERT_TRUE(std::isfinite(sample));
+            energy += sample * sample;
+        }
+        deadline += period;
+        std::this_thread::sleep_until(deadline);
+    }
+
+    const uint8_t payload[] = {1, 2, 3};
+    client.sendMessage("transport", payload, sizeof(payload));
+    std::string channel;
+    std::vector<uint8_t> message;
+    bool gotMessage = false;
+    for (int i = 0; i < 100 && !gotMessage; ++i) {
+        gotMessage = host.pollMessage(channel, message);
+        if (!gotMessage) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    JamTransport::Stats stats = host.getStats();
+    EXPECT_EQ(client.getStats().packetsSent, 750u);
+    EXPECT_GT(stats.packetsReceived, 600u);
+    EXPECT_GT(host.getPacketLoss(), 0.01f);
+    EXPECT_LT(host.getPacketLoss(), 0.12f);
+    EXPECT_GE(stats.packetsConcealed, stats.packetsLost);
+    EXPECT_GT(stats.jitterMs, 0.3);
+    EXPECT_GT(stats.roundTripMs, 0.0);
+    EXPECT_GT(host.getLatency(), 1000.0f * 128.0f / 48000.0f);
+    EXPECT_LT(host.getLatency(), 100.0f);
+    EXPECT_EQ(stats.decodeErrors, 0u);
+    EXPECT_GT(energy, 10.0);
+    ASSERT_TRUE(gotMessage);
+    EXPECT_EQ(channel, "transport");
+    EXPECT_EQ(message, std::vector<uint8_t>(payload, payload + 3));
+
+    client.close();
+    host.close();
+    EXPECT_FALSE(host.isOpen());
+}
+
+TEST(StateReplicationTest, DeltaSnapshotsConvergeUnderLossWithinBudget) {
+    StateReplicator::Config config;
+    const double dt = 1.0 / config.tickRate;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    std::vector<uint8_t> packet(2048);
+
+    auto transformAt = [](size_t i, uint32_t tick, glm::vec3& position, glm::quat& rotation) {
+        const float phase = 0.05f * static_cast<float>(tick) + 0.1f * static_cast<float>(i);
+        position = glm::vec3(std::cos(phase) + 0.01f * static_cast<float>(i), 1.5f, std::sin(phase));
+        const float half = 0.5f * phase;
+        rotation = glm::quat(std::cos(half), 0.0f, std::sin(half), 0.0f);
+    };
+
+    // Eine Richtung: a sendet Objekte, b bestätigt; 20 % Verlust in beide Richtungen
+    auto runSession = [&](size_t numObjects, uint32_t movingTicks, uint32_t settleTicks,
+                          StateReplicator& a, StateReplicator& b, double& meanBytes) {
+        std::vector<StateReplicator::ObjectId> ids;
+        for (size_t i = 0; i < numObjects; ++i) ids.push_back(a.registerObject("obj" + std::to_string(i)));
+        uint64_t bytes = 0;
+        for (uint32_t tick = 0; tick < movingTicks + settleTicks; ++tick) {
+            const uint32_t t = std::min(tick, movingTicks);
+            for (size_t i = 0; i < numObjects; ++i) {
+                glm::vec3 position;
+                glm::quat rotation;
+                transformAt(i, t, position, rotation);
+                a.setTransform(ids[i], position, rotation);
+            }
+            const size_t size = a.writePacket(packet.data(), packet.size());
+            EXPECT_LE(size, config.packetBudget);
+            bytes += size;
+            if (chance(rng) > 0.2f) {
+                EXPECT_TRUE(b.readPacket(packet.data(), size));
+            }
+            const size_t back = b.writePacket(packet.data(), packet.size());
+            if (chance(rng) > 0.2f) {
+                EXPECT_TRUE(a.readPacket(packet.data(), back));
+            }
+            b.advance(dt);
+        }
+        meanBytes = static_cast<double>(bytes) / (movingTicks + settleTicks);
+    };
+
+    // Bandbreite bleibt bei 1000 Objekten beim Budget, 50 bewegte Objekte passen komplett
+    {
+        StateReplicator a(config), b(config);
+        double meanBytes = 0.0;
+        runSession(1000, 200, 0, a, b, meanBytes);
+        EXPECT_LE(meanBytes, static_cast<double>(config.packetBudget));
+        EXPECT_GT(a.getStats().lastObjectsDeferred, 0u);
+        EXPECT_EQ(b.getStats().remoteObjects, 1000u);
+    }
+    {
+        StateReplicator a(config), b(config);
+        double meanBytes = 0.0;
+        runSession(50, 200, 0, a, b, meanBytes);
+        EXPECT_EQ(a.getStats().lastObjectsDeferred, 0u);
+        // Deltas gegen bestätigte Zustände: wenige Bytes je bewegtem Objekt
+        EXPECT_LT(meanBytes / 50.0, 14.0);
+    }
+
+    // Nach dem Anhalten konvergiert die Gegenseite trotz Verlust exakt auf die Quantisierung
+    {
+        StateReplicator a(config), b(config);
+        double meanBytes = 0.0;
+        runSession(300, 150, 90, a, b, meanBytes);
+        for (size_t i = 0; i < 300; ++i) {
+            glm::vec3 expected, position;
+            glm::quat expectedRotation, rotation;
+            transformAt(i, 150, expected, expectedRotation);
+            ASSERT_TRUE(b.getRemoteTransform("obj" + std::to_string(i), position, rotation));
+            EXPECT_NEAR(position.x, expected.x, 1.0f / StateReplicator::kPositionScale);
+            EXPECT_NEAR(position.y, expected.y, 1.0f / StateReplicator::kPositionScale);
+            EXPECT_NEAR(position.z, expected.z, 1.0f / StateReplicator::kPositionScale);
+            const float dot = rotation.w * expectedRotation.w + rotation.x * expectedRotation.x
+                            + rotation.y * expectedRotation.y + rotation.z * expectedRotation.z;
+            EXPECT_GT(std::abs(dot), 0.99999f);
+        }
+        // Alles bestätigt: Pakete bestehen nur noch aus dem Kopf
+        EXPECT_EQ(a.getStats().lastObjectsSent, 0u);
+    }
+
+    // Interest-Management und Interpolation zwischen Snapshots
+    {
+        StateReplicator a(config), b(config);
+        b.setViewer(glm::vec3(0.0f, 0.0f, 0.0f));
+        const auto near = a.registerObject("head");
+        const auto far = a.registerObject("distant");
+        a.setTransform(far, glm::vec3(config.interestRadius * 2.0f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        for (uint32_t tick = 1; tick <= 60; ++tick) {
+            a.setTransform(near, glm::vec3(0.1f * static_cast<float>(tick), 0.0f, 0.0f),
+                           glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+            const size_t size = a.writePacket(packet.data(), packet.size());
+            b.readPacket(packet.data(), size);
+            a.readPacket(packet.data(), b.writePacket(packet.data(), packet.size()));
+            b.advance(dt * 0.5);
+            b.advance(dt * 0.5);
+        }
+        glm::vec3 position;
+        glm::quat rotation;
+        EXPECT_FALSE(b.getRemoteTransform("distant", position, rotation));
+        ASSERT_TRUE(b.getRemoteTransform("head", position, rotation));
+        // interpolationDelay Ticks hinter dem neuesten (60), linear zwischen den Snapshots
+        EXPECT_NEAR(position.x, 0.1f * static_cast<float>(60.0 - config.interpolationDelay), 0.06f);
+        EXPECT_LT(position.x, 6.0f);
+    }
+
+    // Kaputte Pakete werden abgewiesen
+    {
+        StateReplicator b(config);
+        const uint8_t garbage[30] = {1, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0xff, 0xff, 0xff};
+        EXPECT_FALSE(b.readPacket(garbage, sizeof(garbage)));
+        EXPECT_FALSE(b.readPacket(garbage, 10));
+        EXPECT_EQ(b.getStats().packetsRejected, 2u);
+    }
+}
+
+TEST(StateReplicationTest, TruncatedAndFarFuturePacketsLeaveStateUntouched) {
+    StateReplicator a, b;
+    std::vector<uint8_t> packet(2048), reply(2048);
+    const glm::quat identity(1.0f, 0.0f, 0.0f, 0.0f);
+    a.setTransform(a.registerObject("head"), glm::vec3(0.5f, 1.6f, 0.0f), identity);
+    a.setTransform(a.registerObject("hand"), glm::vec3(0.3f, 1.2f, 0.2f), identity);
+    b.setTransform(b.registerObject("knob"), glm::vec3(1.0f, 1.0f, 1.0f), identity);
+    const size_t headerSize = 27;
+    uint64_t rejected = 0;
+
+    // An jeder Stelle hinter dem Kopf abgeschnitten: kein Objekt wird übernommen
+    const size_t size = a.writePacket(packet.data(), packet.size());
+    for (size_t cut = headerSize; cut < size; ++cut, ++rejected) {
+        EXPECT_FALSE(b.readPacket(packet.data(), cut)) << cut;
+    }
+    glm::vec3 position;
+    glm::quat rotation;
+    EXPECT_EQ(b.getStats().remoteObjects, 0u);
+    EXPECT_FALSE(b.getRemoteTransform("head", position, rotation));
+    ASSERT_TRUE(b.readPacket(packet.data(), size));
+    EXPECT_EQ(b.getStats().remoteObjects, 2u);
+
+    // Eine abgeschnittene Antwort bestätigt nichts: a sendet weiter beide Objekte
+    const size_t replySize = b.writePacket(reply.data(), reply.size());
+    for (size_t cut = headerSize; cut < replySize; ++cut) {
+        EXPECT_FALSE(a.readPacket(reply.data(), cut)) << cut;
+    }
+    a.writePacket(packet.data(), packet.size());
+    EXPECT_EQ(a.getStats().lastObjectsSent, 2u);
+    EXPECT_EQ(a.getStats().remoteObjects, 0u);
+    ASSERT_TRUE(a.readPacket(reply.data(), replySize));
+    EXPECT_EQ(a.getStats().remoteObjects, 1u);
+    const size_t headerOnly = a.writePacket(packet.data(), packet.size());
+    EXPECT_EQ(a.getStats().lastObjectsSent, 0u);
+
+    // Ticks weit voraus oder weit zurück werden verworfen und verschieben nichts
+    auto withTick = [&](uint32_t tick) {
+        std::vector<uint8_t> forged(packet.begin(), packet.begin() + headerOnly);
+        for (int i = 0; i < 4; ++i) forged[1 + i] = static_cast<uint8_t>(tick >> (8 * i));
+        return forged;
+    };
+    const uint32_t received = 1;
+    for (uint32_t tick : {received + 0x80000000u, received + 0x7fffffffu, received + (1u << 20), received - 40u}) {
+        const std::vector<uint8_t> forged = withTick(tick);
+        EXPECT_FALSE(b.readPacket(forged.data(), forged.size())) << tick;
+        ++rejected;
+    }
+
+    // Rotationsdelta außerhalb der 10 Bit eines neuen Objekts
+    std::vector<uint8_t> forged(packet.begin(), packet.begin() + headerOnly);
+    forged[25] = 1;
+    forged.insert(forged.end(), {5, 8 | 2, 1, 'x'});
+    for (int i = 0; i < 3; ++i) forged.insert(forged.end(), {0xfe, 0xff, 0xff, 0xff, 0x0f});
+    EXPECT_FALSE(b.readPacket(forged.data(), forged.size()));
+    ++rejected;
+    EXPECT_EQ(b.getStats().remoteObjects, 2u);
+
+    EXPECT_TRUE(b.readPacket(packet.data(), headerOnly));
+    EXPECT_EQ(b.getStats().packetsRejected, rejected);
+    b.advance(1.0);
+    ASSERT_TRUE(b.getRemoteTransform("head", position, rotation));
+    EXPECT_NEAR(position.x, 0.5f, 1.0f / StateReplicator::kPositionScale);
+}
+
+TEST(PayloadCompressionTest, DictionaryLz4RoundTripSkipsCompressedAndRecovers) {
+    PayloadCompressor::Config config;
+    config.trainingBytes = 16 * 1024;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> value(0, 999);
+
+    // Projekt-Sync-Nachrichten wie in NetworkManager: kurzes JSON mit wiederkehrenden Schlüsseln
+    auto makeMessage = [&](size_t i) {
+        return "{\"type\":" + std::to_string(i % 4) + ",\"senderId\":\"user-" + std::to_string(i % 3)
+             + "\",\"data\":\"{\\\"trackId\\\":" + std::to_string(value(rng) % 16)
+             + ",\\\"parameter\\\":\\\"volume\\\",\\\"value\\\":0." + std::to_string(value(rng))
+             + ",\\\"timestamp\\\":" + std::to_string(1700000000 + i) + "}\"}";
+    };
+
+    PayloadCompressor sender(config), receiver(config);
+    std::vector<uint8_t> frame(PayloadCompressor::getMaxFrameSize(config.maxMessageSize) + 70 * 1024);
+    std::vector<uint8_t> decoded(config.maxMessageSize);
+
+    uint64_t rawBytes = 0, frameBytes = 0;
+    for (size_t i = 0; i < 1200; ++i) {
+        const std::string message = makeMessage(i);
+        const size_t frameSize = sender.compress("project", message.data(), message.size(),
+                                                 frame.data(), frame.size());
+        ASSERT_GT(frameSize, 0u);
+        size_t size = 0;
+        ASSERT_TRUE(receiver.decompress("project", frame.data(), frameSize, decoded.data(), decoded.size(), size));
+        ASSERT_EQ(std::string(decoded.begin(), decoded.begin() + size), message);
+        if (i >= 600) {
+            rawBytes += message.size();
+            frameBytes += frameSize;
+        }
+    }
+    auto stats = sender.getStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_NE(stats[0].dictionaryId, 0);
+    EXPECT_EQ(stats[0].codec, PayloadCompressor::Codec::LZ4);
+    // Mit Wörterbuch schrumpfen auch Nachrichten um 150 Bytes deutlich
+    EXPECT_GT(static_cast<double>(rawBytes) / frameBytes, 2.0);
+    EXPECT_EQ(receiver.getStats()[0].decodeErrors, 0u);
+
+    // Ohne Wörterbuch ist die Einzelnachricht kaum kleiner
+    {
+        PayloadCompressor::Config plain = config;
+        plain.dictionaries = false;
+        PayloadCompressor plainSender(plain);
+        uint64_t plainRaw = 0, plainFrames = 0;
+        for (size_t i = 0; i < 200; ++i) {
+            const std::string message = makeMessage(i);
+            plainRaw += message.size();
+            plainFrames += plainSender.compress("project", message.data(), message.size(), frame.data(), frame.size());
+        }
+        EXPECT_LT(static_cast<double>(plainRaw) / plainFrames, static_cast<double>(rawBytes) / frameBytes);
+    }
+
+    // Große Nutzlast in beiden Richtungen über Wörterbuch- und Fenstergrenzen, alle Stufen
+    for (int level = 0; level <= 9; ++level) {
+        sender.setLevel(level);
+        std::string big;
+        for (size_t i = 0; big.size() < 100000; ++i) big += makeMessage(i);
+        const size_t frameSize = sender.compress("project", big.data(), big.size(), frame.data(), frame.size());
+        ASSERT_GT(frameSize, 0u);
+        if (level > 0) {
+            EXPECT_LT(frameSize, big.size() / 3);
+        }
+        size_t size = 0;
+        ASSERT_TRUE(receiver.decompress("project", frame.data(), frameSize, decoded.data(), decoded.size(), size));
+        ASSERT_EQ(std::string(decoded.begin(), decoded.begin() + size), big);
+    }
+    sender.setLevel(1);
+
+    // Bereits komprimiertes Audio (Ogg/Opus) und Rauschen gehen roh durch
+    std::vector<uint8_t> opus(4000);
+    for (auto& byte : opus) byte = static_cast<uint8_t>(rng());
+    std::memcpy(opus.data(), "OggS", 4);
+    std::vector<uint8_t> noise(4000);
+    for (auto& byte : noise) byte = static_cast<uint8_t>(rng());
+    for (const auto* payload : {&opus, &noise}) {
+        const size_t frameSize = sender.compress("audio", payload->data(), payload->size(), frame.data(), frame.size());
+        EXPECT_LE(frameSize, payload->size() + 5);
+        size_t size = 0;
+        ASSERT_TRUE(receiver.decompress("audio", frame.data(), frameSize, decoded.data(), decoded.size(), size));
+        ASSERT_EQ(size, payload->size());
+        EXPECT_EQ(std::memcmp(decoded.data(), payload->data(), size), 0);
+    }
+    for (const auto& s : sender.getStats()) {
+        if (s.channel == "audio") {
+            EXPECT_EQ(s.skipped, 2u);
+        }
+    }
+
+    // Empfänger, der die ersten Rahmen mit Wörterbuch verpasst, erholt sich beim nächsten
+    {
+        PayloadCompressor lateSender(config), lateReceiver(config);
+        size_t decodedCount = 0, failed = 0, firstSuccess = 0;
+        for (size_t i = 0; i < 1200; ++i) {
+            const std::string message = makeMessage(i);
+            const size_t frameSize = lateSender.compress("events", message.data(), message.size(),
+                                                         frame.data(), frame.size());
+            if (i < 400) continue;   // verloren
+            size_t size = 0;
+            if (lateReceiver.decompress("events", frame.data(), frameSize, decoded.data(), decoded.size(), size)) {
+                EXPECT_EQ(std::string(decoded.begin(), decoded.begin() + size), message);
+                if (decodedCount++ == 0) firstSuccess = i;
+            } else {
+                ++failed;
+            }
+        }
+        EXPECT_GT(failed, 0u);
+        EXPECT_LE(firstSuccess, 400 + PayloadCompressor::kDictionaryInterval);
+        EXPECT_GT(decodedCount, 1200 - 400 - PayloadCompressor::kDictionaryInterval);
+    }
+
+    // Kaputte Rahmen werden abgewiesen, ohne über Puffergrenzen zu lesen oder zu schreiben
+    {
+        const std::string message = makeMessage(7) + makeMessage(8) + makeMessage(9);
+        const size_t frameSize = sender.compress("project", message.data(), message.size(), frame.data(), frame.size());
+        std::vector<uint8_t> corrupt(frame.begin(), frame.begin() + frameSize);
+        size_t rejected = 0;
+        for (size_t i = 0; i < 2000; ++i) {
+            std::vector<uint8_t> mutated = corrupt;
+            mutated[rng() % mutated.size()] ^= static_cast<uint8_t>(1 + rng() % 255);
+            mutated.resize(mutated.size() - rng() % 3);
+            size_t size = 0;
+            std::vector<uint8_t> small(message.size());
+            if (!receiver.decompress("project", mutated.data(), mutated.size(), small.data(), small.size(), size)) {
+                ++rejected;
+            }
+        }
+        EXPECT_GT(rejected, 0u);
+    }
+}
+
+// Voice-Chat-Aufbereitung vor dem Versand: Echo, Rauschen und Pegel
+TEST(VoiceProcessorTest, CancelsEchoSuppressesNoiseAndLevelsGain) {
+    constexpr float sampleRate = 48000.0f;
+    constexpr size_t chunk = 480;   // bewusst kein Vielfaches der Blockgröße
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+    auto power = [](const std::vector<float>& x, size_t from, size_t to) {
+        double sum = 0.0;
+        for (size_t i = from; i < to; ++i) sum += double(x[i]) * x[i];
+        return sum / double(to - from);
+    };
+
+    // Echopfad: 40 Samples Verzögerung, dann 20 ms abklingender Nachhall
+    std::vector<float> path(40 + 960, 0.0f);
+    double pathEnergy = 0.0;
+    for (size_t i = 40; i < path.size(); ++i) {
+        path[i] = uniform(rng) * std::exp(-float(i - 40) / 200.0f);
+        pathEnergy += double(path[i]) * path[i];
+    }
+    for (float& tap : path) tap *= float(0.3 / std::sqrt(pathEnergy));
+
+    const size_t length = size_t(sampleRate) * 6;
+    std::vector<float> far(length), near(length, 0.0f);
+    for (float& x : far) x = 0.3f * uniform(rng);
+    for (size_t n = 0; n < length; ++n) {
+        float acc = 0.0f;
+        for (size_t k = 0; k < path.size() && k <= n; ++k) acc += path[k] * far[n - k];
+        near[n] = acc + 1e-4f * uniform(rng);
+    }
+
+    {
+        VoiceProcessor aec;
+        aec.prepare(sampleRate);
+        VoiceProcessor::Parameters params;
+        params.noiseSuppression = false;
+        params.automaticGainControl = false;
+        params.echoTail = 0.064f;
+        aec.setParameters(params);
+        EXPECT_EQ(aec.getLatency(), VoiceProcessor::kBlockSize);
+
+        std::vector<float> out = near;
+        for (size_t pos = 0; pos < length; pos += chunk) {
+            aec.processFarEnd(far.data() + pos, chunk);
+            aec.processNearEnd(out.data() + pos, chunk);
+        }
+        for (float x : out) ASSERT_TRUE(std::isfinite(x));
+        const double erle = 10.0 * std::log10(power(near, length - 48000, length)
+                                              / power(out, length - 48000, length));
+        EXPECT_GT(erle, 15.0);
+        EXPECT_GT(aec.getStats().echoReturnLossEnhancement, 15.0f);
+        EXPECT_FALSE(aec.getStats().doubleTalk);
+    }
+
+    // Rauschunterdrückung: stationäres Rauschen wird abgesenkt, ein Ton bleibt
+    {
+        VoiceProcessor ns;
+        ns.prepare(sampleRate);
+        VoiceProcessor::Parameters params;
+        params.echoCancellation = false;
+        params.automaticGainControl = false;
+        ns.setParameters(params);
+        EXPECT_EQ(ns.getLatency(), 2 * VoiceProcessor::kBlockSize);
+
+        std::vector<float> noise(length);
+        for (float& x : noise) x = 0.03f * uniform(rng);
+        std::vector<float> out = noise;
+        for (size_t pos = 0; pos < length; pos += chunk) ns.processNearEnd(out.data() + pos, chunk);
+        const double reduction = 10.0 * std::log10(power(noise, length - 48000, length)
+                                                   / power(out, length - 48000, length));
+        EXPECT_GT(reduction, 12.0);
+        EXPECT_LT(reduction, 21.0);   // Untergrenze noiseReduction = 20 dB
+        EXPECT_NEAR(ns.getStats().noiseFloor, 10.0f * std::log10(0.03f * 0.03f / 3.0f), 6.0f);
+
+        // Ein Dauerton wäre für das Minimum-Tracking selbst Rauschen, daher
+        // sprachähnlich getastet: 300 ms an, 300 ms aus
+        std::vector<float> tone(length, 0.0f), mixed(length);
+        for (size_t n = 0; n < length; ++n) {
+            if (n % 28800 < 14400) tone[n] = 0.3f * std::sin(2.0f * 3.14159265f * 440.0f * float(n) / sampleRate);
+            mixed[n] = tone[n] + noise[n];
+        }
+        out = mixed;
+        ns.reset();
+        for (size_t pos = 0; pos < length; pos += chunk) ns.processNearEnd(out.data() + pos, chunk);
+        const size_t latency = ns.getLatency();
+        const double toneLoss = 10.0 * std::log10(power(tone, length - 57600 - latency, length - latency)
+                                                  / power(out, length - 57600, length));
+        EXPECT_LT(std::abs(toneLoss), 1.0);
+    }
+
+    // Pegelregelung: leiser Ton wird auf den Zielpegel gezogen, lauter begrenzt
+    {
+        VoiceProcessor agc;
+        agc.prepare(sampleRate);
+        VoiceProcessor::Parameters params;
+        params.echoCancellation = false;
+        params.noiseSuppression = false;
+        agc.setParameters(params);
+
+        std::vector<float> quiet(length);
+        for (size_t n = 0; n < length; ++n) {
+            quiet[n] = 0.0141f * std::sin(2.0f * 3.14159265f * 300.0f * float(n) / sampleRate);
+        }
+        std::vector<float> out = quiet;
+        for (size_t pos = 0; pos < length; pos += chunk) agc.processNearEnd(out.data() + pos, chunk);
+        EXPECT_NEAR(10.0 * std::log10(power(out, length - 48000, length)), params.targetLevel, 1.5);
+        EXPECT_NEAR(agc.getStats().gain, params.targetLevel + 40.0f, 1.5f);
+
+        std::vector<float> loud(length);
+        for (size_t n = 0; n < length; ++n) {
+            loud[n] = (n % 9600 < 4800 ? 0.01f : 0.99f)
+                    * std::sin(2.0f * 3.14159265f * 300.0f * float(n) / sampleRate);
+        }
+        out = loud;
+        for (size_t pos = 0; pos < length; pos += chunk) agc.processNearEnd(out.data() + pos, chunk);
+        for (float x : out) ASSERT_LE(std::abs(x), VoiceProcessor::kPeakCeiling + 1e-4f);
+    }
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
+#include <atomic>
 #include <chrono>
 #include "../src/audio/AudioEngine.hpp"
 #include "../src/audio/DynamicsProcessor.hpp"
 #include "../src/vr/VRInterface.hpp"
 #include "../src/ui/VRControlPanel.hpp"
 #include "../src/VRDAW.hpp"
+#include "../src/audio/AudioWorkerPool.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -481,5 +483,56 @@ TEST_F(VRDAWPerformanceTest, GPUPerformance) {
     EXPECT_LT(failureRate, 0.01f); // Maximal 1% Fehlerrate
 }
 
+// Track-Graph-Scheduler: 200 Spuren auf 8 Bussen und Master. Laufzeiten
+// misst WorkerPoolBenchmark, hier zählt nur die Korrektheit
+TEST(AudioWorkerPoolPerformanceTest, TwoHundredTracksRunOncePerPeriodInOrder) {
+    const int numTracks = 200;
+    const int numBuses = 8;
+    const int numPeriods = 1000;
+
+    AudioTaskGraph graph;
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    const uint32_t master = graph.addNode(AudioTaskGraph::NodeType::Master, 0);
+    std::vector<uint32_t> buses;
+    for (int b = 0; b < numBuses; ++b) {
+        buses.push_back(graph.addNode(AudioTaskGraph::NodeType::Bus, b));
+        edges.push_back({buses.back(), master});
+    }
+    for (int t = 0; t < numTracks; ++t) {
+        const uint32_t track = graph.addNode(AudioTaskGraph::NodeType::Track, t);
+        edges.push_back({track, buses[t % numBuses]});
+    }
+    for (const auto& edge : edges) graph.addDependency(edge.first, edge.second);
+    ASSERT_TRUE(graph.compile());
+
+    // Je Knoten: Aufrufe insgesamt sowie Start- und Endmarke der Periode
+    std::vector<std::atomic<uint32_t>> runs(graph.size());
+    std::vector<std::atomic<uint64_t>> started(graph.size());
+    std::vector<std::atomic<uint64_t>> finished(graph.size());
+    std::atomic<uint64_t> clock{0};
+    auto processNode = [&](uint32_t node) {
+        started[node].store(++clock);
+        runs[node].fetch_add(1);
+        finished[node].store(++clock);
+    };
+
+    AudioWorkerPool pool;
+    pool.start(3);
+
+    int orderViolations = 0;
+    for (int period = 0; period < numPeriods; ++period) {
+        pool.execute(graph, processNode);
+        for (const auto& edge : edges) {
+            if (finished[edge.first].load() >= started[edge.second].load()) ++orderViolations;
+        }
+    }
+
+    for (size_t node = 0; node < graph.size(); ++node) {
+        EXPECT_EQ(runs[node].load(), static_cast<uint32_t>(numPeriods)) << node;
+    }
+    EXPECT_EQ(orderViolations, 0);
+    EXPECT_EQ(pool.getStatistics().periods, static_cast<uint64_t>(numPeriods));
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
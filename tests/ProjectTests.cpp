@@ -1,6 +1,17 @@
 #include <gtest/gtest.h>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/server.hpp>
 #include "../src/VRDAW.hpp"
+#include "../src/collaboration/CollaborationManager.hpp"
+#include "../src/collaboration/ProjectDocument.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -175,5 +186,302 @@ TEST_F(VRDAWProjectTest, ProjectErrorHandling) {
     EXPECT_FALSE(loadResult.success);
 }
 
+TEST(ProjectDocumentTest, ConcurrentEditsConvergeAndSyncIsProportionalToDiff) {
+    using Id = ProjectDocument::ObjectId;
+    using Type = ProjectDocument::ObjectType;
+    using Value = ProjectDocument::Value;
+
+    // Sichtbarer Zustand als Text, unabhängig von der internen Reihenfolge
+    std::function<void(const ProjectDocument&, const Id&, std::string&)> dump;
+    dump = [&](const ProjectDocument& doc, const Id& id, std::string& out) {
+        for (uint8_t t = 1; t <= static_cast<uint8_t>(Type::Connection); ++t) {
+            for (const Id& child : doc.getChildren(id, static_cast<Type>(t))) {
+                out += "(" + std::to_string(t) + ":" + std::to_string(child.replica) + "/"
+                     + std::to_string(child.counter);
+                for (ProjectDocument::Key key = ProjectDocument::kName; key <= ProjectDocument::kTarget + 64; ++key) {
+                    const ProjectDocument::Key k = key > ProjectDocument::kTarget
+                        ? ProjectDocument::kParameterBase + (key - ProjectDocument::kTarget - 1) : key;
+                    const Value v = doc.get(child, k);
+                    if (v.type == Value::Type::Null) continue;
+                    out += " " + std::to_string(k) + "=" + std::to_string(v.integer) + "," + std::to_string(v.number)
+                         + "," + v.text + "," + std::to_string(v.ref.replica) + "/" + std::to_string(v.ref.counter);
+                }
+                dump(doc, child, out);
+                out += ")";
+            }
+        }
+    };
+    auto state = [&](const ProjectDocument& doc) {
+        std::string out;
+        dump(doc, ProjectDocument::kRoot, out);
+        return out;
+    };
+    auto sync = [](ProjectDocument& from, ProjectDocument& to) {
+        std::vector<uint8_t> message;
+        from.encodeChanges(to.getVersion(), message);
+        return to.applyChanges(message.data(), message.size());
+    };
+
+    ProjectDocument a(1), b(2), c(3);
+
+    // Projekt: 16 Spuren mit Plugin (64 Parametern), 8 Clips und einer
+    // Automationsspur mit 32 Punkten, dazu Routing
+    std::vector<Id> tracks, plugins, clips;
+    for (int t = 0; t < 16; ++t) {
+        const Id track = a.createObject(Type::Track);
+        ASSERT_TRUE(a.exists(track));
+        a.set(track, ProjectDocument::kName, Value::fromText("Track " + std::to_string(t)));
+        a.set(track, ProjectDocument::kOrder, Value::fromNumber(t + 1.0));
+        a.set(track, ProjectDocument::kGain, Value::fromNumber(1.0));
+        tracks.push_back(track);
+
+        const Id plugin = a.createObject(Type::Plugin, track);
+        a.set(plugin, ProjectDocument::kPluginId, Value::fromText("vrdaw.reverb"));
+        for (uint32_t p = 0; p < 64; ++p) {
+            a.set(plugin, ProjectDocument::kParameterBase + p, Value::fromNumber(p / 64.0));
+        }
+        plugins.push_back(plugin);
+
+        for (int k = 0; k < 8; ++k) {
+            const Id clip = a.createObject(Type::Clip, track);
+            a.set(clip, ProjectDocument::kStart, Value::fromInt(k * 48000));
+            a.set(clip, ProjectDocument::kLength, Value::fromInt(44100));
+            a.set(clip, ProjectDocument::kSample, Value::fromText("samples/loop" + std::to_string(k) + ".wav"));
+            clips.push_back(clip);
+        }
+        const Id lane = a.createObject(Type::AutomationLane, plugin);
+        a.set(lane, ProjectDocument::kParameter, Value::fromInt(3));
+        for (int k = 0; k < 32; ++k) {
+            const Id point = a.createObject(Type::AutomationPoint, lane);
+            a.set(point, ProjectDocument::kTime, Value::fromNumber(k * 0.25));
+            a.set(point, ProjectDocument::kValue, Value::fromNumber(k / 32.0));
+        }
+    }
+    for (int t = 0; t + 1 < 16; t += 4) {
+        const Id connection = a.createObject(Type::Connection);
+        a.set(connection, ProjectDocument::kSource, Value::fromRef(tracks[t]));
+        a.set(connection, ProjectDocument::kTarget, Value::fromRef(tracks[t + 1]));
+    }
+
+    // Ungültige Struktur wird lokal abgewiesen
+    EXPECT_EQ(a.createObject(Type::Clip), ProjectDocument::kRoot);
+    EXPECT_EQ(a.createObject(Type::AutomationPoint, tracks[0]), ProjectDocument::kRoot);
+    EXPECT_FALSE(a.set(clips[0], ProjectDocument::kParent, Value::fromRef(plugins[0])));
+
+    std::vector<uint8_t> full;
+    const size_t fullSize = a.encodeChanges(b.getVersion(), full);
+    ASSERT_TRUE(b.applyChanges(full.data(), full.size()));
+    ASSERT_TRUE(sync(a, c));
+    const std::string initial = state(a);
+    EXPECT_EQ(state(b), initial);
+    EXPECT_EQ(state(c), initial);
+    EXPECT_EQ(ProjectDocument::compare(a.getVersion(), b.getVersion()), ProjectDocument::Order::Equal);
+
+    // Gleichzeitige Änderungen ohne Abstimmung
+    const auto before = a.getVersion();
+    const Id clip0 = clips[0], clip1 = clips[1], rescued = clips[5 * 8];
+    a.set(tracks[0], ProjectDocument::kGain, Value::fromNumber(0.5));
+    a.remove(tracks[2]);
+    const Id trackA = a.createObject(Type::Track);
+    a.remove(tracks[5]);
+    a.set(plugins[0], ProjectDocument::kParameterBase + 0, Value::fromNumber(0.1));
+
+    b.set(tracks[0], ProjectDocument::kGain, Value::fromNumber(0.8));
+    b.set(clip0, ProjectDocument::kParent, Value::fromRef(tracks[1]));
+    b.set(clip1, ProjectDocument::kParent, Value::fromRef(tracks[4]));
+    const Id trackB = b.createObject(Type::Track);
+    b.set(rescued, ProjectDocument::kParent, Value::fromRef(tracks[6]));
+    b.set(plugins[0], ProjectDocument::kParameterBase + 1, Value::fromNumber(0.2));
+
+    c.remove(clip0);
+    c.set(clip1, ProjectDocument::kParent, Value::fromRef(tracks[3]));
+    c.set(tracks[2], ProjectDocument::kName, Value::fromText("renamed"));
+    c.set(plugins[0], ProjectDocument::kParameterBase + 2, Value::fromNumber(0.3));
+
+    EXPECT_EQ(ProjectDocument::compare(before, a.getVersion()), ProjectDocument::Order::Before);
+    EXPECT_EQ(ProjectDocument::compare(a.getVersion(), b.getVersion()), ProjectDocument::Order::Concurrent);
+
+    // Austausch in unterschiedlicher Reihenfolge, teils doppelt
+    std::vector<uint8_t> fromC;
+    c.encodeChanges(before, fromC);
+    ASSERT_TRUE(b.applyChanges(fromC.data(), fromC.size()));
+    ASSERT_TRUE(sync(b, a));
+    ASSERT_TRUE(a.applyChanges(fromC.data(), fromC.size()));
+    ASSERT_TRUE(sync(a, c));
+    ASSERT_TRUE(sync(a, b));
+    ASSERT_TRUE(b.applyChanges(fromC.data(), fromC.size()));
+    EXPECT_GT(b.getStats().duplicateOperations, 0u);
+
+    const std::string merged = state(a);
+    EXPECT_EQ(state(b), merged);
+    EXPECT_EQ(state(c), merged);
+    EXPECT_EQ(a.getVersion(), c.getVersion());
+
+    // Gleiche Lamport-Zeit: die höhere Replik gewinnt
+    EXPECT_DOUBLE_EQ(a.get(tracks[0], ProjectDocument::kGain).number, 0.8);
+    // Löschen gewinnt gegen gleichzeitiges Verschieben und Umbenennen
+    EXPECT_FALSE(a.exists(clip0));
+    EXPECT_FALSE(a.exists(tracks[2]));
+    // Spätere Verschiebung gewinnt
+    EXPECT_EQ(a.getParent(clip1), tracks[4]);
+    // Aus der gelöschten Spur gerettet
+    EXPECT_TRUE(a.exists(rescued));
+    EXPECT_EQ(a.getParent(rescued), tracks[6]);
+    EXPECT_FALSE(a.exists(clips[5 * 8 + 1]));
+    EXPECT_TRUE(a.exists(trackA));
+    EXPECT_TRUE(a.exists(trackB));
+    EXPECT_EQ(a.getChildren(ProjectDocument::kRoot, Type::Track).size(), 16u);
+    EXPECT_EQ(a.getChildren(tracks[1], Type::Clip).size(), 8u);
+    EXPECT_EQ(a.getChildren(tracks[4], Type::Clip).size(), 9u);
+    for (uint32_t p = 0; p < 3; ++p) {
+        EXPECT_DOUBLE_EQ(c.get(plugins[0], ProjectDocument::kParameterBase + p).number, 0.1 * (p + 1));
+    }
+
+    // Wiederverbinden: B war weg, A und C haben weitergearbeitet
+    const auto offline = b.getVersion();
+    for (int k = 0; k < 5; ++k) {
+        a.set(plugins[3], ProjectDocument::kParameterBase + k, Value::fromNumber(0.5 + k));
+        c.set(tracks[7 + k], ProjectDocument::kPan, Value::fromNumber(-0.25 * k));
+    }
+    ASSERT_TRUE(sync(c, a));
+    std::vector<uint8_t> delta;
+    const size_t deltaSize = a.encodeChanges(offline, delta);
+    EXPECT_LT(deltaSize, 200u);
+    EXPECT_LT(deltaSize * 100, fullSize);
+    ASSERT_TRUE(b.applyChanges(delta.data(), delta.size()));
+    EXPECT_EQ(state(b), state(a));
+
+    // Kompaktierung: nur was alle bekannten Peers haben, verlässt den Verlauf
+    a.setPeerVersion(2, offline);
+    a.setPeerVersion(3, c.getVersion());
+    const size_t firstPass = a.compact();
+    EXPECT_GT(firstPass, 1000u);
+    EXPECT_EQ(a.getStats().loggedOperations, 10u);
+    std::vector<uint8_t> stillDelta;
+    a.encodeChanges(offline, stillDelta);
+    EXPECT_EQ(stillDelta, delta);
+
+    ASSERT_TRUE(sync(a, c));
+    a.setPeerVersion(2, b.getVersion());
+    a.setPeerVersion(3, c.getVersion());
+    a.compact();
+    auto stats = a.getStats();
+    EXPECT_EQ(stats.loggedOperations, 0u);
+    EXPECT_GE(stats.collected, 3u);
+    EXPECT_EQ(state(a), state(b));
+
+    // Neuer Teilnehmer bekommt einen Snapshot statt des Verlaufs
+    ProjectDocument d(4);
+    std::vector<uint8_t> snapshot;
+    const size_t snapshotSize = a.encodeChanges(d.getVersion(), snapshot);
+    EXPECT_EQ(a.getStats().snapshotsEncoded, 1u);
+    EXPECT_LT(snapshotSize, fullSize);
+    ASSERT_TRUE(d.applyChanges(snapshot.data(), snapshot.size()));
+    EXPECT_EQ(state(d), state(a));
+    EXPECT_EQ(d.getVersion(), a.getVersion());
+    EXPECT_FALSE(d.set(tracks[2], ProjectDocument::kName, Value::fromText("zombie")));
+
+    // Und arbeitet danach normal mit
+    d.set(tracks[0], ProjectDocument::kMute, Value::fromInt(1));
+    ASSERT_TRUE(sync(d, a));
+    ASSERT_TRUE(sync(a, b));
+    EXPECT_EQ(b.get(tracks[0], ProjectDocument::kMute).integer, 1);
+    EXPECT_EQ(state(b), state(d));
+
+    // Versionsvektor und kaputte Nachrichten
+    std::vector<uint8_t> encoded;
+    ProjectDocument::encodeVersion(a.getVersion(), encoded);
+    ProjectDocument::VersionVector decoded;
+    ASSERT_TRUE(ProjectDocument::decodeVersion(encoded.data(), encoded.size(), decoded));
+    EXPECT_EQ(decoded, a.getVersion());
+
+    std::mt19937 rng(25);
+    size_t rejected = 0;
+    for (const std::vector<uint8_t>* message : {&full, &snapshot}) {
+        for (int i = 0; i < 100; ++i) {
+            std::vector<uint8_t> mutated = *message;
+            mutated[rng() % mutated.size()] ^= static_cast<uint8_t>(1 + rng() % 255);
+            if (i % 2) mutated.resize(rng() % mutated.size());
+            ProjectDocument e(5);
+            if (!e.applyChanges(mutated.data(), mutated.size())) ++rejected;
+            state(e);
+        }
+    }
+    EXPECT_GT(rejected, 100u);
+}
+
+// Sendepfad gegen einen lokalen WebSocket-Server: connect() kehrt zurück,
+// der Versionsvektor geht beim Öffnen raus, Änderungen als Binär-Frame
+TEST(CollaborationManagerTest, ConnectReturnsAndEditsReachTheServer) {
+    using Server = websocketpp::server<websocketpp::config::asio>;
+    Server server;
+    server.clear_access_channels(websocketpp::log::alevel::all);
+    server.clear_error_channels(websocketpp::log::elevel::all);
+    server.init_asio();
+    server.set_reuse_addr(true);
+
+    std::mutex mutex;
+    std::condition_variable received;
+    std::vector<std::string> frames;
+    server.set_message_handler([&](websocketpp::connection_hdl, Server::message_ptr message) {
+        if (message->get_opcode() != websocketpp::frame::opcode::binary) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        frames.push_back(message->get_payload());
+        received.notify_all();
+    });
+    server.listen(websocketpp::lib::asio::ip::tcp::endpoint(websocketpp::lib::asio::ip::address_v4::loopback(), 0));
+    server.start_accept();
+    websocketpp::lib::asio::error_code ec;
+    const uint16_t port = server.get_local_endpoint(ec).port();
+    ASSERT_FALSE(ec);
+    std::thread serverThread([&server] { server.run(); });
+
+    CollaborationManager& manager = CollaborationManager::getInstance();
+    manager.initialize();
+    manager.joinProject("send-path");
+    manager.connect("ws://127.0.0.1:" + std::to_string(port));
+    for (int i = 0; i < 2000 && !manager.isConnected(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(manager.isConnected());
+
+    ProjectDocument::ObjectId track;
+    manager.editProject("send-path", [&track](ProjectDocument& document) {
+        track = document.createObject(ProjectDocument::ObjectType::Track);
+        document.set(track, ProjectDocument::kName, ProjectDocument::Value::fromText("Drums"));
+    });
+
+    // Kopf: u8 Art (1 Version, 2 Änderungen), u64 Absender, u8 Länge + Projekt-ID
+    auto kindOf = [](const std::string& frame) { return frame.size() > 10 ? frame[0] : 0; };
+    auto hasKind = [&](char kind) {
+        for (const std::string& frame : frames) {
+            if (kindOf(frame) == kind) return true;
+        }
+        return false;
+    };
+    ProjectDocument remote(7);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(received.wait_for(lock, std::chrono::seconds(2), [&] { return hasKind(1) && hasKind(2); }));
+        for (const std::string& frame : frames) {
+            const size_t idLength = static_cast<uint8_t>(frame[9]);
+            ASSERT_GE(frame.size(), 10 + idLength);
+            EXPECT_EQ(frame.substr(10, idLength), "send-path");
+            if (kindOf(frame) != 2) continue;
+            const auto* body = reinterpret_cast<const uint8_t*>(frame.data()) + 10 + idLength;
+            EXPECT_TRUE(remote.applyChanges(body, frame.size() - 10 - idLength));
+        }
+    }
+    ASSERT_TRUE(remote.exists(track));
+    EXPECT_EQ(remote.get(track, ProjectDocument::kName).text, "Drums");
+
+    manager.disconnect();
+    EXPECT_FALSE(manager.isConnected());
+    manager.shutdown();
+    server.stop_listening();
+    server.stop();
+    serverThread.join();
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include "../src/audio/AcousticPropagation.hpp"
+
+// Benchmark für die Ausbreitung: bewegte Quellen (jeden Block neue
+// Position, also Doppler) mit Abstandsdämpfung, Luftabsorption und frühen
+// Reflexionen im Standardraum, mit und ohne Raum. Ausgabe: Kern-Anteil
+// bei 48 kHz.
+// Aufruf: PropagationBenchmark [Quellen] [blockSize] [Sekunden]
+
+namespace {
+
+using namespace VR_DAW;
+
+constexpr float kSampleRate = 48000.0f;
+
+volatile float sink = 0.0f;
+
+struct Scene {
+    std::vector<std::vector<float>> signals;
+    std::vector<const float*> inputs;
+    std::vector<AcousticPropagation::Source> sources;
+    std::vector<std::vector<float>> outputs;
+    std::vector<float*> outputPointers;
+    std::vector<const float*> results;
+    std::vector<std::vector<float>> walls;
+    std::vector<float*> wallPointers;
+    float time = 0.0f;
+
+    Scene(size_t count, size_t blockSize)
+        : signals(count, std::vector<float>(blockSize))
+        , inputs(count)
+        , sources(count)
+        , outputs(count, std::vector<float>(blockSize))
+        , outputPointers(count)
+        , results(count)
+        , walls(AcousticPropagation::kNumWalls, std::vector<float>(blockSize))
+        , wallPointers(AcousticPropagation::kNumWalls)
+    {
+        uint32_t seed = 1;
+        for (size_t i = 0; i < count; ++i) {
+            for (float& sample : signals[i]) {
+                seed = seed * 1664525u + 1013904223u;
+                sample = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+            }
+            inputs[i] = signals[i].data();
+            outputPointers[i] = outputs[i].data();
+        }
+        for (size_t w = 0; w < walls.size(); ++w) wallPointers[w] = walls[w].data();
+    }
+
+    // Quellen kreisen mit bis zu 10 m/s in 1-4 m Abstand um den Hörer
+    void advance(size_t blockSize) {
+        time += static_cast<float>(blockSize) / kSampleRate;
+        const size_t count = sources.size();
+        for (size_t i = 0; i < count; ++i) {
+            const float radius = 1.0f + 3.0f * static_cast<float>(i) / count;
+            const float angle = 6.2831853f * i / count + time * (1.0f + static_cast<float>(i % 3));
+            sources[i].x = radius * std::sin(angle);
+            sources[i].y = 1.7f + 0.5f * std::sin(0.37f * i + time);
+            sources[i].z = -radius * std::cos(angle);
+        }
+    }
+
+    void process(AcousticPropagation& propagation, size_t blockSize) {
+        advance(blockSize);
+        propagation.process(inputs.data(), sources.data(), sources.size(), 0.0f, 1.7f, 0.0f,
+                            outputPointers.data(), results.data(), wallPointers.data(), blockSize);
+        sink = sink + outputs[0][0] + walls[0][0];
+    }
+};
+
+double measureCoreShare(const std::function<void()>& block, size_t blockSize, double seconds) {
+    const size_t blocks = static_cast<size_t>(seconds * kSampleRate / blockSize);
+    for (size_t b = 0; b < blocks / 10 + 1; ++b) block();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < blocks; ++b) block();
+    const auto end = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(end - start).count();
+    return elapsed / (static_cast<double>(blocks * blockSize) / kSampleRate);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 200;
+    const size_t blockSize = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 128;
+    const double seconds = argc > 3 ? std::atof(argv[3]) : 5.0;
+
+    std::printf("Ausbreitungs-Benchmark (48 kHz, %zu bewegte Quellen, Blockgröße %zu)\n", count, blockSize);
+    std::printf("%-28s %12s\n", "Variante", "Kern-Anteil");
+
+    Scene scene(count, blockSize);
+    AcousticPropagation withRoom(count, kSampleRate, blockSize);
+    const double roomShare = measureCoreShare([&] { scene.process(withRoom, blockSize); }, blockSize, seconds);
+    std::printf("%-28s %11.2f%%\n", "Direkt + 6 Reflexionen", 100.0 * roomShare);
+
+    AcousticPropagation free(count, kSampleRate, blockSize);
+    AcousticPropagation::Room room;
+    room.reflection = 0.0f;
+    free.setRoom(room);
+    const double freeShare = measureCoreShare([&] { scene.process(free, blockSize); }, blockSize, seconds);
+    std::printf("%-28s %11.2f%%\n", "Nur Direktschall", 100.0 * freeShare);
+    return 0;
+}
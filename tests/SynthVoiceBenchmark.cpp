@@ -0,0 +1,94 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../src/audio/SubtractiveSynthesizer.hpp"
+#include "../src/dsp/kernels/DSPKernels.hpp"
+
+// Benchmark für den Stimmen-Renderer: wie viele Stimmen ein Kern bei 48 kHz
+// in Echtzeit schafft. Aufruf: SynthVoiceBenchmark [blockSize] [Sekunden]
+
+namespace {
+
+using namespace VR_DAW;
+
+constexpr float kSampleRate = 48000.0f;
+
+volatile float sink = 0.0f;
+
+double measureVoicesPerCore(SubtractiveSynthesizer::OscillatorType oscillator,
+                            OscillatorMode mode,
+                            SubtractiveSynthesizer::FilterType filter,
+                            size_t voiceCount, size_t blockSize, double seconds) {
+    SubtractiveSynthesizer synth;
+    synth.setMaxVoices(voiceCount);
+    synth.setSampleRate(kSampleRate);
+    synth.setOscillatorType(oscillator);
+    synth.setOscillatorMode(mode);
+    synth.setFilterType(filter);
+    synth.setLFODestination(LFODestination::Filter);
+
+    // Lange Sustain-Phase, alle Stimmen klingen über die ganze Messung
+    Synthesizer::Envelope envelope{0.01f, 0.1f, 0.8f, 0.3f};
+    synth.setEnvelope(envelope);
+    for (size_t i = 0; i < voiceCount; ++i) {
+        synth.noteOn(static_cast<uint8_t>(24 + i % 96), 100, static_cast<uint8_t>(i / 96));
+    }
+
+    std::vector<float> output(blockSize * 2);
+    const size_t blocks = static_cast<size_t>(seconds * kSampleRate / blockSize);
+
+    // Aufwärmen
+    for (size_t i = 0; i < blocks / 10 + 1; ++i) synth.processBlock(output.data(), output.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < blocks; ++i) {
+        synth.processBlock(output.data(), output.size());
+    }
+    const auto end = std::chrono::steady_clock::now();
+    sink = output[0];
+
+    const double cpuSeconds = std::chrono::duration<double>(end - start).count();
+    const double audioSeconds = static_cast<double>(blocks * blockSize) / kSampleRate;
+    return voiceCount * audioSeconds / cpuSeconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t blockSize = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 128;
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+
+    dsp::initializeKernels();
+
+    std::printf("Synth-Stimmen-Benchmark (48 kHz, Blockgröße %zu, %.1f s Audio je Messung)\n",
+                blockSize, seconds);
+    std::printf("Kernel-Variante: %s\n\n", dsp::getKernels().name);
+    std::printf("%-8s %-10s %8s %16s\n", "Osz.", "Filter", "Stimmen", "Stimmen/Kern");
+
+    using Osc = SubtractiveSynthesizer::OscillatorType;
+    using Filter = SubtractiveSynthesizer::FilterType;
+    struct Case {
+        const char* oscName;
+        Osc oscillator;
+        OscillatorMode mode;
+        const char* filterName;
+        Filter filter;
+    };
+    const Case cases[] = {
+        {"sine", Osc::Sine, OscillatorMode::PolyBLEP, "bypass", Filter::Bypass},
+        {"saw", Osc::Saw, OscillatorMode::PolyBLEP, "lowpass", Filter::Lowpass},
+        {"saw-wt", Osc::Saw, OscillatorMode::Wavetable, "lowpass", Filter::Lowpass},
+        {"tri", Osc::Triangle, OscillatorMode::PolyBLEP, "lowpass", Filter::Lowpass},
+        {"noise", Osc::Noise, OscillatorMode::PolyBLEP, "highpass", Filter::Highpass},
+    };
+
+    for (const auto& c : cases) {
+        for (size_t voices : {16, 64, 128, 256}) {
+            const double perCore = measureVoicesPerCore(c.oscillator, c.mode, c.filter, voices, blockSize, seconds);
+            std::printf("%-8s %-10s %8zu %16.0f\n", c.oscName, c.filterName, voices, perCore);
+        }
+    }
+
+    return 0;
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
+#include <vector>
 #include "../src/VRDAW.hpp"
+#include "../src/vr/UIBatcher.hpp"
 
 namespace VR_DAW {
 namespace Tests {
@@ -206,5 +209,82 @@ TEST_F(VRDAWUITest, UIAccessibility) {
     EXPECT_EQ(componentInfo.tabOrder, 1);
 }
 
+TEST(UIBatcherTest, GroupsByMeshAndMaterialAndReducesWaveforms) {
+    using MeshType = UIBatcher::MeshType;
+    UIBatcher batcher;
+
+    auto modelAt = [](float x) {
+        glm::mat4 model(1.0f);
+        model[3][0] = x;
+        return model;
+    };
+    const glm::vec4 white(1.0f, 1.0f, 1.0f, 1.0f);
+
+    // Gemischte Reihenfolge, wie sie beim Durchlaufen der Views entsteht
+    batcher.add(MeshType::Knob, 0, modelAt(0.0f), white, 0.5f);
+    batcher.add(MeshType::Button, 7, modelAt(1.0f), white);
+    batcher.add(MeshType::Panel, 0, modelAt(2.0f), white);
+    batcher.add(MeshType::Knob, 0, modelAt(3.0f), white, 2.0f);
+    batcher.add(MeshType::Button, 0, modelAt(4.0f), white, 0.0f, 1.0f);
+    batcher.add(MeshType::Button, 7, modelAt(5.0f), white);
+
+    std::vector<float> samples(1000, 0.0f);
+    samples[500] = -0.8f;
+    samples[501] = 0.3f;
+    batcher.addWaveform(modelAt(6.0f), white, samples.data(), samples.size());
+    batcher.addWaveform(modelAt(7.0f), white, nullptr, 0);
+    batcher.build();
+
+    const auto& batches = batcher.getBatches();
+    const auto& instances = batcher.getInstances();
+    ASSERT_EQ(batches.size(), 5u);
+    ASSERT_EQ(instances.size(), 8u);
+
+    // Panel, Button ohne Material, Button mit Material, Knob, Waveform
+    EXPECT_EQ(batches[0].mesh, MeshType::Panel);
+    EXPECT_EQ(batches[1].mesh, MeshType::Button);
+    EXPECT_EQ(batches[1].material, 0u);
+    EXPECT_EQ(batches[2].mesh, MeshType::Button);
+    EXPECT_EQ(batches[2].material, 7u);
+    EXPECT_EQ(batches[2].instanceCount, 2u);
+    EXPECT_EQ(batches[3].mesh, MeshType::Knob);
+    EXPECT_EQ(batches[4].mesh, MeshType::Waveform);
+
+    uint32_t next = 0;
+    for (const auto& batch : batches) {
+        EXPECT_EQ(batch.firstInstance, next);
+        next += batch.instanceCount;
+    }
+    EXPECT_EQ(next, instances.size());
+
+    // Reihenfolge innerhalb eines Batches bleibt erhalten, Werte werden begrenzt
+    EXPECT_FLOAT_EQ(instances[batches[2].firstInstance].model[3][0], 1.0f);
+    EXPECT_FLOAT_EQ(instances[batches[2].firstInstance + 1].model[3][0], 5.0f);
+    EXPECT_FLOAT_EQ(instances[batches[1].firstInstance].params.y, 1.0f);
+    EXPECT_FLOAT_EQ(instances[batches[3].firstInstance].params.x, 0.5f);
+    EXPECT_FLOAT_EQ(instances[batches[3].firstInstance + 1].params.x, 1.0f);
+
+    // Spitzenwert mit Vorzeichen; Wellenform ohne Daten bleibt flach
+    ASSERT_EQ(batcher.getWaveformCount(), 2u);
+    const auto& rows = batcher.getWaveforms();
+    const auto& wave = instances[batches[4].firstInstance];
+    EXPECT_FLOAT_EQ(wave.params.z, 0.0f);
+    EXPECT_FLOAT_EQ(*std::min_element(rows.begin(), rows.begin() + UIBatcher::kWaveformResolution), -0.8f);
+    EXPECT_FLOAT_EQ(instances[batches[4].firstInstance + 1].params.z, 1.0f);
+    for (size_t i = 0; i < UIBatcher::kWaveformResolution; ++i) {
+        EXPECT_FLOAT_EQ(rows[UIBatcher::kWaveformResolution + i], 0.0f);
+    }
+
+    // Neuer Frame: Generation zählt weiter, alte Daten sind weg
+    const uint64_t generation = batcher.getGeneration();
+    batcher.clear();
+    batcher.add(MeshType::Slider, 0, modelAt(0.0f), white, 0.25f);
+    batcher.build();
+    EXPECT_EQ(batcher.getGeneration(), generation + 1);
+    ASSERT_EQ(batcher.getBatches().size(), 1u);
+    EXPECT_EQ(batcher.getInstances().size(), 1u);
+    EXPECT_EQ(batcher.getWaveformCount(), 0u);
+}
+
 } // namespace Tests
 } // namespace VR_DAW 
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../src/audio/AudioWorkerPool.hpp"
+
+// Benchmark für den Track-Graph-Scheduler: Spuren auf 8 Bussen und Master,
+// je Knoten etwas DSP-Last. Ausgabe je Worker-Anzahl: mittlere und längste
+// Periode gegen das Zeitbudget bei 48 kHz.
+// Aufruf: WorkerPoolBenchmark [Spuren] [blockSize] [Perioden]
+
+namespace {
+
+using namespace VR_DAW;
+
+constexpr double kSampleRate = 48000.0;
+constexpr int kBuses = 8;
+
+volatile float sink = 0.0f;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int numTracks = argc > 1 ? std::atoi(argv[1]) : 200;
+    const size_t blockSize = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 128;
+    const int numPeriods = argc > 3 ? std::atoi(argv[3]) : 10000;
+    const double budgetMicroseconds = blockSize / kSampleRate * 1e6;
+
+    AudioTaskGraph graph;
+    const uint32_t master = graph.addNode(AudioTaskGraph::NodeType::Master, 0);
+    std::vector<uint32_t> buses;
+    for (int b = 0; b < kBuses; ++b) {
+        buses.push_back(graph.addNode(AudioTaskGraph::NodeType::Bus, b));
+        graph.addDependency(buses.back(), master);
+    }
+    for (int t = 0; t < numTracks; ++t) {
+        graph.addDependency(graph.addNode(AudioTaskGraph::NodeType::Track, t), buses[t % kBuses]);
+    }
+    if (!graph.compile()) return 1;
+
+    std::vector<float> buffers(graph.size() * blockSize * 2, 0.1f);
+    auto processNode = [&](uint32_t node) {
+        float* data = buffers.data() + node * blockSize * 2;
+        for (size_t i = 0; i < blockSize * 2; ++i) {
+            data[i] = data[i] * 0.999f + 0.001f;
+        }
+    };
+
+    std::printf("Worker-Pool-Benchmark (%d Spuren, %d Busse, Blockgröße %zu, Budget %.1f us)\n\n",
+                numTracks, kBuses, blockSize, budgetMicroseconds);
+    std::printf("%8s %14s %14s %10s\n", "Worker", "Mittel (us)", "Maximum (us)", "Auslast.");
+
+    const size_t maxWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    for (size_t workers = 0; workers <= maxWorkers; ++workers) {
+        AudioWorkerPool pool;
+        pool.start(workers);
+
+        // Aufwärmen
+        for (int i = 0; i < numPeriods / 10 + 1; ++i) pool.execute(graph, processNode);
+
+        double total = 0.0;
+        double longest = 0.0;
+        for (int i = 0; i < numPeriods; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            pool.execute(graph, processNode);
+            const double elapsed = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+            total += elapsed;
+            longest = std::max(longest, elapsed);
+        }
+        sink = buffers[0];
+
+        const double mean = total / numPeriods;
+        std::printf("%8zu %14.1f %14.1f %9.0f%%\n", workers, mean, longest,
+                    100.0 * mean / budgetMicroseconds);
+    }
+
+    return 0;
+}